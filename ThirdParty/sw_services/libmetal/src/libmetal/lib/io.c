@@ -9,6 +9,97 @@
 #include <metal/io.h>
 #include <metal/sys.h>
 
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define METAL_IO_NEON
+#endif
+
+/* Bytes moved per iteration by the wide copies of METAL_IO_MEM_SHARED */
+#define METAL_IO_WIDE	(2 * sizeof(uint64_t))
+
+/*
+ * The wide copies keep the accesses to the region aligned, as required by
+ * device or non-cacheable mappings. The buffer side is normal memory and
+ * may stay unaligned, memcpy() of a fixed size compiles to plain loads and
+ * stores there.
+ */
+static void metal_io_wide_read(const unsigned char *ptr, unsigned char *dest,
+			       size_t len)
+{
+	uint64_t word[2];
+
+	for (; len && ((uintptr_t)ptr % sizeof(uint64_t)); ptr++, dest++, len--)
+		*dest = *ptr;
+	for (; len >= METAL_IO_WIDE; ptr += METAL_IO_WIDE,
+				     dest += METAL_IO_WIDE,
+				     len -= METAL_IO_WIDE) {
+#ifdef METAL_IO_NEON
+		vst1q_u8(dest, vreinterpretq_u8_u64(
+			vld1q_u64((const uint64_t *)ptr)));
+#else
+		word[0] = ((const uint64_t *)ptr)[0];
+		word[1] = ((const uint64_t *)ptr)[1];
+		memcpy(dest, word, sizeof(word));
+#endif
+	}
+	for (; len >= sizeof(uint64_t); ptr += sizeof(uint64_t),
+				       dest += sizeof(uint64_t),
+				       len -= sizeof(uint64_t)) {
+		word[0] = *(const uint64_t *)ptr;
+		memcpy(dest, word, sizeof(word[0]));
+	}
+	for (; len != 0; ptr++, dest++, len--)
+		*dest = *ptr;
+}
+
+static void metal_io_wide_write(unsigned char *ptr, const unsigned char *source,
+				size_t len)
+{
+	uint64_t word[2];
+
+	for (; len && ((uintptr_t)ptr % sizeof(uint64_t)); ptr++, source++, len--)
+		*ptr = *source;
+	for (; len >= METAL_IO_WIDE; ptr += METAL_IO_WIDE,
+				     source += METAL_IO_WIDE,
+				     len -= METAL_IO_WIDE) {
+#ifdef METAL_IO_NEON
+		vst1q_u64((uint64_t *)ptr, vreinterpretq_u64_u8(
+			vld1q_u8(source)));
+#else
+		memcpy(word, source, sizeof(word));
+		((uint64_t *)ptr)[0] = word[0];
+		((uint64_t *)ptr)[1] = word[1];
+#endif
+	}
+	for (; len >= sizeof(uint64_t); ptr += sizeof(uint64_t),
+				       source += sizeof(uint64_t),
+				       len -= sizeof(uint64_t)) {
+		memcpy(word, source, sizeof(word[0]));
+		*(uint64_t *)ptr = word[0];
+	}
+	for (; len != 0; ptr++, source++, len--)
+		*ptr = *source;
+}
+
+static void metal_io_wide_set(unsigned char *ptr, unsigned char value,
+			      size_t len)
+{
+	uint64_t word = value * (UINT64_MAX / UCHAR_MAX);
+
+	for (; len && ((uintptr_t)ptr % sizeof(uint64_t)); ptr++, len--)
+		*ptr = value;
+	for (; len >= METAL_IO_WIDE; ptr += METAL_IO_WIDE,
+				     len -= METAL_IO_WIDE) {
+		((uint64_t *)ptr)[0] = word;
+		((uint64_t *)ptr)[1] = word;
+	}
+	for (; len >= sizeof(uint64_t); ptr += sizeof(uint64_t),
+				       len -= sizeof(uint64_t))
+		*(uint64_t *)ptr = word;
+	for (; len != 0; ptr++, len--)
+		*ptr = value;
+}
+
 void metal_io_init(struct metal_io_region *io, void *virt,
 	      const metal_phys_addr_t *physmap, size_t size,
 	      unsigned int page_shift, unsigned int mem_flags,
@@ -28,6 +119,7 @@ void metal_io_init(struct metal_io_region *io, void *virt,
 	else
 		io->page_mask = (1UL << page_shift) - 1UL;
 	io->mem_flags = mem_flags;
+	io->mem_type = METAL_IO_MEM_DEVICE;
 	io->ops = ops ? *ops : nops;
 	metal_sys_io_mem_map(io);
 
@@ -50,6 +142,13 @@ int metal_io_block_read(struct metal_io_region *io, unsigned long offset,
 	if (io->ops.block_read) {
 		retlen = (*io->ops.block_read)(
 			io, offset, dst, memory_order_seq_cst, len);
+	} else if (io->mem_type != METAL_IO_MEM_DEVICE) {
+		/* Order the copy after the loads that found the data ready */
+		atomic_thread_fence(memory_order_acquire);
+		if (io->mem_type == METAL_IO_MEM_NORMAL)
+			memcpy(dest, ptr, len);
+		else
+			metal_io_wide_read(ptr, dest, len);
 	} else {
 		atomic_thread_fence(memory_order_seq_cst);
 		while ( len && (
@@ -87,6 +186,13 @@ int metal_io_block_write(struct metal_io_region *io, unsigned long offset,
 	if (io->ops.block_write) {
 		retlen = (*io->ops.block_write)(
 			io, offset, src, memory_order_seq_cst, len);
+	} else if (io->mem_type != METAL_IO_MEM_DEVICE) {
+		if (io->mem_type == METAL_IO_MEM_NORMAL)
+			memcpy(ptr, source, len);
+		else
+			metal_io_wide_write(ptr, source, len);
+		/* Order the copy before the stores that publish the data */
+		atomic_thread_fence(memory_order_release);
 	} else {
 		while ( len && (
 			((uintptr_t)ptr % sizeof(int)) ||
@@ -123,6 +229,12 @@ int metal_io_block_set(struct metal_io_region *io, unsigned long offset,
 	if (io->ops.block_set) {
 		(*io->ops.block_set)(
 			io, offset, value, memory_order_seq_cst, len);
+	} else if (io->mem_type != METAL_IO_MEM_DEVICE) {
+		if (io->mem_type == METAL_IO_MEM_NORMAL)
+			memset(ptr, value, len);
+		else
+			metal_io_wide_set(ptr, value, len);
+		atomic_thread_fence(memory_order_release);
 	} else {
 		unsigned int cint = value;
 		unsigned int i;
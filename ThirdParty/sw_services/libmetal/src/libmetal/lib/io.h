@@ -36,6 +36,21 @@ extern "C" {
 
 struct metal_io_region;
 
+/**
+ * Memory types of an I/O region, they select how the block operations
+ * access the region when it has no block operations of its own.
+ */
+/** Device memory, word accesses and sequentially consistent fences */
+#define METAL_IO_MEM_DEVICE	0x0U
+/**
+ * Memory mapped with device or non-cacheable attributes, such as shared
+ * memory mapped through UIO: aligned accesses up to 16 bytes wide and
+ * acquire/release fences
+ */
+#define METAL_IO_MEM_SHARED	0x1U
+/** Normal memory, C library copies and acquire/release fences */
+#define METAL_IO_MEM_NORMAL	0x2U
+
 /** Generic I/O operations. */
 struct metal_io_ops {
 	uint64_t	(*read)(struct metal_io_region *io,
@@ -80,6 +95,8 @@ struct metal_io_region {
 	metal_phys_addr_t	page_mask;  /**< page mask of I/O region */
 	unsigned int		mem_flags;  /**< memory attribute of the
 						 I/O region */
+	unsigned int		mem_type;   /**< memory type of the I/O
+						 region, METAL_IO_MEM_* */
 	struct metal_io_ops	ops;        /**< I/O region operations */
 	struct metal_list	list;       /**< linked list */
 };
@@ -112,6 +129,22 @@ static inline void metal_io_finish(struct metal_io_region *io)
 	memset(io, 0, sizeof(*io));
 }
 
+/**
+ * @brief	Set the memory type of an I/O region.
+ *
+ * Regions are device memory after metal_io_init(). A region that holds
+ * memory rather than registers can use wider accesses and lighter fences
+ * in the block operations.
+ *
+ * @param[in]	io	I/O region handle.
+ * @param[in]	type	Memory type, METAL_IO_MEM_*.
+ */
+static inline void metal_io_set_mem_type(struct metal_io_region *io,
+					 unsigned int type)
+{
+	io->mem_type = type;
+}
+
 /**
  * @brief	Get size of I/O region.
  *
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2022, Xilinx Inc. and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file	ring.c
+ * @brief	Shared memory ring buffer primitives for libmetal.
+ */
+
+#include <metal/cpu.h>
+#include <metal/errno.h>
+#include <metal/ring.h>
+#include <metal/utilities.h>
+
+#define METAL_RING_MAGIC	0x474e4952U	/* "RING" */
+
+static int metal_ring_setup(struct metal_ring *ring,
+			    struct metal_io_region *io, unsigned long offset,
+			    uint32_t elem_size, uint32_t num_elems,
+			    uint32_t flags)
+{
+	size_t size = metal_ring_mem_size(elem_size, num_elems);
+
+	if (!elem_size || !num_elems || (num_elems & (num_elems - 1)) ||
+	    offset > io->size || size > io->size - offset)
+		return -EINVAL;
+
+	ring->io = io;
+	ring->ctrl = metal_io_virt(io, offset);
+	ring->data = offset + sizeof(struct metal_ring_ctrl);
+	ring->mask = num_elems - 1;
+	ring->elem_size = elem_size;
+	ring->flags = flags;
+	ring->prod_cache = 0;
+	ring->cons_cache = 0;
+	ring->notify = NULL;
+	ring->notify_arg = NULL;
+
+	return ring->ctrl ? 0 : -EINVAL;
+}
+
+int metal_ring_init(struct metal_ring *ring, struct metal_io_region *io,
+		    unsigned long offset, uint32_t elem_size,
+		    uint32_t num_elems, uint32_t flags)
+{
+	struct metal_ring_ctrl *ctrl;
+	int error;
+
+	if (!ring || !io)
+		return -EINVAL;
+	error = metal_ring_setup(ring, io, offset, elem_size, num_elems,
+				 flags);
+	if (error)
+		return error;
+
+	ctrl = ring->ctrl;
+	ctrl->num_elems = num_elems;
+	ctrl->elem_size = elem_size;
+	ctrl->flags = flags;
+	atomic_store_explicit(&ctrl->prod_head, 0, memory_order_relaxed);
+	atomic_store_explicit(&ctrl->prod_tail, 0, memory_order_relaxed);
+	atomic_store_explicit(&ctrl->cons_tail, 0, memory_order_relaxed);
+	/* Publish the ring once it is set up */
+	atomic_thread_fence(memory_order_release);
+	ctrl->magic = METAL_RING_MAGIC;
+	atomic_thread_fence(memory_order_seq_cst);
+
+	return 0;
+}
+
+int metal_ring_attach(struct metal_ring *ring, struct metal_io_region *io,
+		      unsigned long offset)
+{
+	struct metal_ring_ctrl *ctrl;
+
+	if (!ring || !io)
+		return -EINVAL;
+	ctrl = metal_io_virt(io, offset);
+	if (!ctrl || offset + sizeof(*ctrl) > io->size)
+		return -EINVAL;
+	if (*(volatile uint32_t *)&ctrl->magic != METAL_RING_MAGIC)
+		return -EAGAIN;
+	atomic_thread_fence(memory_order_acquire);
+
+	return metal_ring_setup(ring, io, offset, ctrl->elem_size,
+				ctrl->num_elems, ctrl->flags);
+}
+
+/* Copies elements to or from the ring, wrapping around its end */
+static void metal_ring_copy(struct metal_ring *ring, uint32_t index,
+			    void *elems, unsigned int num, int write)
+{
+	unsigned char *buf = elems;
+	uint32_t first = (ring->mask + 1) - (index & ring->mask);
+	unsigned long offset = ring->data +
+			       (unsigned long)(index & ring->mask) *
+			       ring->elem_size;
+	int len;
+
+	first = metal_min(first, num);
+	len = first * ring->elem_size;
+	if (write)
+		metal_io_block_write(ring->io, offset, buf, len);
+	else
+		metal_io_block_read(ring->io, offset, buf, len);
+
+	if (num > first) {
+		buf += len;
+		len = (num - first) * ring->elem_size;
+		if (write)
+			metal_io_block_write(ring->io, ring->data, buf, len);
+		else
+			metal_io_block_read(ring->io, ring->data, buf, len);
+	}
+}
+
+unsigned int metal_ring_enqueue(struct metal_ring *ring, const void *elems,
+				unsigned int num)
+{
+	struct metal_ring_ctrl *ctrl = ring->ctrl;
+	uint32_t size = ring->mask + 1;
+	uint32_t head, free;
+
+	if (ring->flags & METAL_RING_MP)
+		head = atomic_load_explicit(&ctrl->prod_head,
+					    memory_order_relaxed);
+	else
+		head = atomic_load_explicit(&ctrl->prod_tail,
+					    memory_order_relaxed);
+	do {
+		/*
+		 * Only reload the consumer index when the cached one is short.
+		 * The other producers may have moved the head beyond the end
+		 * of the ring seen from the cached index.
+		 */
+		free = ring->cons_cache + size - head;
+		if (free < num || free > size) {
+			ring->cons_cache =
+				atomic_load_explicit(&ctrl->cons_tail,
+						     memory_order_acquire);
+			free = ring->cons_cache + size - head;
+		}
+		num = metal_min(num, free);
+		if (!num)
+			return 0;
+	} while ((ring->flags & METAL_RING_MP) &&
+		 !atomic_compare_exchange_weak_explicit(&ctrl->prod_head,
+							&head, head + num,
+							memory_order_relaxed,
+							memory_order_relaxed));
+
+	metal_ring_copy(ring, head, (void *)elems, num, 1);
+
+	/* Producers publish in the order they claimed their slots */
+	if (ring->flags & METAL_RING_MP) {
+		while (atomic_load_explicit(&ctrl->prod_tail,
+					    memory_order_relaxed) != head)
+			metal_cpu_yield();
+	}
+	atomic_store_explicit(&ctrl->prod_tail, head + num,
+			      memory_order_release);
+
+	/*
+	 * Notify when the consumer had drained the ring. The fence pairs with
+	 * the one of the consumer in metal_ring_dequeue(), one of the two
+	 * sides sees the index stored by the other one.
+	 */
+	if ((ring->flags & METAL_RING_NOTIFY) && ring->notify) {
+		atomic_thread_fence(memory_order_seq_cst);
+		if (atomic_load_explicit(&ctrl->cons_tail,
+					 memory_order_relaxed) == head)
+			ring->notify(ring, ring->notify_arg);
+	}
+
+	return num;
+}
+
+unsigned int metal_ring_dequeue(struct metal_ring *ring, void *elems,
+				unsigned int num)
+{
+	struct metal_ring_ctrl *ctrl = ring->ctrl;
+	uint32_t tail, avail;
+
+	tail = atomic_load_explicit(&ctrl->cons_tail, memory_order_relaxed);
+	/* Only reload the producer index when the cached one is short */
+	avail = ring->prod_cache - tail;
+	if (avail < num) {
+		if (ring->flags & METAL_RING_NOTIFY)
+			atomic_thread_fence(memory_order_seq_cst);
+		ring->prod_cache = atomic_load_explicit(&ctrl->prod_tail,
+							memory_order_acquire);
+		avail = ring->prod_cache - tail;
+	}
+	num = metal_min(num, avail);
+	if (!num)
+		return 0;
+
+	metal_ring_copy(ring, tail, elems, num, 0);
+	atomic_store_explicit(&ctrl->cons_tail, tail + num,
+			      memory_order_release);
+
+	return num;
+}
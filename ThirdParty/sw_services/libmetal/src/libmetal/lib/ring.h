@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2022, Xilinx Inc. and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * @file	ring.h
+ * @brief	Shared memory ring buffer primitives for libmetal.
+ */
+
+#ifndef __METAL_RING__H__
+#define __METAL_RING__H__
+
+#include <stdint.h>
+#include <metal/atomic.h>
+#include <metal/compiler.h>
+#include <metal/io.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \defgroup ring Shared Memory Ring Interfaces
+ *  @{
+ */
+
+/** Cache line size used to keep the ring indices apart */
+#ifndef METAL_RING_CACHE_LINE
+#define METAL_RING_CACHE_LINE	64
+#endif
+
+/** Ring flags */
+#define METAL_RING_MP		0x1U	/**< several producers */
+#define METAL_RING_NOTIFY	0x2U	/**< producers notify the consumer */
+
+/**
+ * Control block of a ring, at the start of its shared memory and followed
+ * by the elements. The indices run freely and are masked to address the
+ * elements, each one sits in its own cache line.
+ */
+struct metal_ring_ctrl {
+	uint32_t	magic;		/**< set once the ring is ready */
+	uint32_t	num_elems;	/**< number of elements, power of 2 */
+	uint32_t	elem_size;	/**< size of an element in bytes */
+	uint32_t	flags;		/**< METAL_RING_* flags */
+	/** next index claimed by a producer, METAL_RING_MP only */
+	atomic_uint	prod_head metal_align(METAL_RING_CACHE_LINE);
+	/** end of the published elements */
+	atomic_uint	prod_tail metal_align(METAL_RING_CACHE_LINE);
+	/** end of the consumed elements */
+	atomic_uint	cons_tail metal_align(METAL_RING_CACHE_LINE);
+};
+
+struct metal_ring;
+
+/** Ring notification handler, see metal_ring_set_notify() */
+typedef void (*metal_ring_notify)(struct metal_ring *ring, void *arg);
+
+/** Libmetal ring handle, local to each user of a ring. */
+struct metal_ring {
+	struct metal_io_region	*io;		/**< I/O region of the ring */
+	struct metal_ring_ctrl	*ctrl;		/**< shared control block */
+	unsigned long		data;		/**< offset of the elements */
+	uint32_t		mask;		/**< num_elems - 1 */
+	uint32_t		elem_size;	/**< size of an element */
+	uint32_t		flags;		/**< METAL_RING_* flags */
+	uint32_t		prod_cache;	/**< last prod_tail seen */
+	uint32_t		cons_cache;	/**< last cons_tail seen */
+	metal_ring_notify	notify;		/**< notification handler */
+	void			*notify_arg;	/**< notification argument */
+};
+
+/**
+ * @brief	Get the memory size of a ring.
+ *
+ * @param[in]	elem_size	Size of an element in bytes.
+ * @param[in]	num_elems	Number of elements.
+ * @return	Size in bytes of the control block and the elements.
+ */
+static inline size_t metal_ring_mem_size(uint32_t elem_size,
+					 uint32_t num_elems)
+{
+	return sizeof(struct metal_ring_ctrl) + (size_t)elem_size * num_elems;
+}
+
+/**
+ * @brief	Create a ring in an I/O region.
+ *
+ * Initializes the control block of the ring, the other users then attach
+ * to it with metal_ring_attach(). The offset should be aligned to
+ * METAL_RING_CACHE_LINE.
+ *
+ * @param[out]	ring		Ring handle.
+ * @param[in]	io		I/O region holding the ring.
+ * @param[in]	offset		Offset of the ring in the I/O region.
+ * @param[in]	elem_size	Size of an element in bytes.
+ * @param[in]	num_elems	Number of elements, power of 2.
+ * @param[in]	flags		METAL_RING_* flags.
+ * @return	0 on success, or -errno on failure.
+ */
+int metal_ring_init(struct metal_ring *ring, struct metal_io_region *io,
+		    unsigned long offset, uint32_t elem_size,
+		    uint32_t num_elems, uint32_t flags);
+
+/**
+ * @brief	Attach to a ring created by metal_ring_init().
+ *
+ * @param[out]	ring	Ring handle.
+ * @param[in]	io	I/O region holding the ring.
+ * @param[in]	offset	Offset of the ring in the I/O region.
+ * @return	0 on success, -EAGAIN if the ring is not created yet, or
+ *		-errno on failure.
+ */
+int metal_ring_attach(struct metal_ring *ring, struct metal_io_region *io,
+		      unsigned long offset);
+
+/**
+ * @brief	Set the notification handler of a producer.
+ *
+ * With METAL_RING_NOTIFY, a producer calls the handler when it publishes
+ * elements into an empty ring. The handler typically raises an interrupt
+ * of the consumer, whose handler registered with metal_irq_register()
+ * drains the ring until metal_ring_dequeue() returns 0.
+ *
+ * @param[in]	ring	Ring handle.
+ * @param[in]	notify	Notification handler, NULL for none.
+ * @param[in]	arg	Argument of the handler.
+ */
+static inline void metal_ring_set_notify(struct metal_ring *ring,
+					 metal_ring_notify notify, void *arg)
+{
+	ring->notify = notify;
+	ring->notify_arg = arg;
+}
+
+/**
+ * @brief	Enqueue elements into a ring.
+ *
+ * Copies up to num elements and publishes them at once. With METAL_RING_MP
+ * each producer thread needs its own handle.
+ *
+ * @param[in]	ring	Ring handle.
+ * @param[in]	elems	Elements to enqueue.
+ * @param[in]	num	Number of elements.
+ * @return	Number of elements enqueued, 0 if the ring is full.
+ */
+unsigned int metal_ring_enqueue(struct metal_ring *ring, const void *elems,
+				unsigned int num);
+
+/**
+ * @brief	Dequeue elements from a ring.
+ *
+ * Copies up to num elements and releases their slots at once. A ring has a
+ * single consumer.
+ *
+ * @param[in]	ring	Ring handle.
+ * @param[out]	elems	Buffer for the elements.
+ * @param[in]	num	Maximum number of elements.
+ * @return	Number of elements dequeued, 0 if the ring is empty.
+ */
+unsigned int metal_ring_dequeue(struct metal_ring *ring, void *elems,
+				unsigned int num);
+
+/**
+ * @brief	Get the number of elements in a ring.
+ *
+ * @param[in]	ring	Ring handle.
+ * @return	Number of published elements not consumed yet.
+ */
+static inline unsigned int metal_ring_count(struct metal_ring *ring)
+{
+	return atomic_load_explicit(&ring->ctrl->prod_tail,
+				    memory_order_acquire) -
+	       atomic_load_explicit(&ring->ctrl->cons_tail,
+				    memory_order_acquire);
+}
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __METAL_RING__H__ */
@@ -85,6 +85,8 @@ static int metal_shmem_try_map(struct metal_page_size *ps, int fd, size_t size,
 		metal_io_init(io, mem, phys, size, ps->page_shift, 0,
 			&metal_shmem_io_ops);
 	}
+	/* The shared memory segments are normal cacheable memory */
+	metal_io_set_mem_type(io, METAL_IO_MEM_NORMAL);
 	*result = io;
 
 	return 0;
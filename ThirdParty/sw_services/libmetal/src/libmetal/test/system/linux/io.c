@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2022, Xilinx Inc. and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "metal-test.h"
+#include <metal/io.h>
+#include <metal/log.h>
+#include <metal/sys.h>
+
+#define IO_TEST_SIZE	512	/* Region size of the functional test */
+#define IO_TEST_MAX_LEN	200	/* Longest block of the functional test */
+
+#define IO_PERF_SIZE	(256 * 1024)	/* Region size of the benchmark */
+#define IO_PERF_BYTES	(256 * 1024 * 1024) /* Bytes moved per measure */
+
+static const unsigned int io_mem_types[] = {
+	METAL_IO_MEM_DEVICE, METAL_IO_MEM_SHARED, METAL_IO_MEM_NORMAL,
+};
+
+static const char * const io_mem_names[] = {
+	"device", "shared", "normal",
+};
+
+#define IO_NUM_TYPES	(sizeof(io_mem_types) / sizeof(io_mem_types[0]))
+
+static void io_pattern(unsigned char *buf, size_t len, unsigned int seed)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++)
+		buf[i] = (unsigned char)(seed + i * 7);
+}
+
+/*
+ * Checks the block operations of each memory type against memcpy() and
+ * memset() for all the alignments of the region and of the buffer.
+ */
+static int io_block(void)
+{
+	static unsigned char region[IO_TEST_SIZE], ref[IO_TEST_SIZE];
+	static unsigned char buf[IO_TEST_MAX_LEN + 16], out[IO_TEST_MAX_LEN + 16];
+	metal_phys_addr_t phys = 0;
+	struct metal_io_region io;
+	unsigned int t, ofs, align;
+	int len, ret;
+
+	for (t = 0; t < IO_NUM_TYPES; t++) {
+		metal_io_init(&io, region, &phys, sizeof(region), -1, 0, NULL);
+		metal_io_set_mem_type(&io, io_mem_types[t]);
+		for (ofs = 0; ofs < 16; ofs++) {
+			for (align = 0; align < 16; align++) {
+				for (len = 0; len <= IO_TEST_MAX_LEN; len++) {
+					io_pattern(region, sizeof(region), ofs);
+					memcpy(ref, region, sizeof(region));
+
+					/* Write */
+					io_pattern(buf + align, len, len);
+					ret = metal_io_block_write(&io, ofs,
+								   buf + align,
+								   len);
+					memcpy(ref + ofs, buf + align, len);
+					if (ret != len ||
+					    memcmp(region, ref, sizeof(ref)))
+						goto fail;
+
+					/* Read back */
+					memset(out, 0, sizeof(out));
+					ret = metal_io_block_read(&io, ofs,
+								  out + align,
+								  len);
+					if (ret != len ||
+					    memcmp(out + align, buf + align,
+						   len))
+						goto fail;
+
+					/* Set */
+					ret = metal_io_block_set(&io, ofs,
+								 0xa5 + len,
+								 len);
+					memset(ref + ofs, 0xa5 + len, len);
+					if (ret != len ||
+					    memcmp(region, ref, sizeof(ref)))
+						goto fail;
+				}
+			}
+		}
+
+		/* Blocks are clipped at the end of the region */
+		ret = metal_io_block_write(&io, sizeof(region) - 3, buf, 16);
+		if (ret != 3)
+			goto fail;
+		metal_io_finish(&io);
+	}
+
+	return 0;
+
+fail:
+	metal_log(METAL_LOG_ERROR,
+		  "%s block mismatch, offset %u, align %u, len %d\n",
+		  io_mem_names[t], ofs, align, len);
+	metal_io_finish(&io);
+	return -EINVAL;
+}
+METAL_ADD_TEST(io_block);
+
+static double io_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+ * Measures the throughput of the block operations of each memory type for
+ * a few block sizes. The buffer is one byte off the region alignment, as
+ * for rpmsg payloads copied from or to application data.
+ */
+static int io_block_perf(void)
+{
+	static const int sizes[] = { 64, 512, 4096, 65536 };
+	metal_phys_addr_t phys = 0;
+	struct metal_io_region io;
+	unsigned char *region, *buf;
+	unsigned int t, s;
+	double start, rd, wr, set;
+	long n, count;
+	int len;
+
+	region = malloc(IO_PERF_SIZE);
+	buf = malloc(IO_PERF_SIZE + 1);
+	if (!region || !buf) {
+		free(region);
+		free(buf);
+		return -ENOMEM;
+	}
+	memset(region, 0, IO_PERF_SIZE);
+	memset(buf, 0, IO_PERF_SIZE + 1);
+
+	for (t = 0; t < IO_NUM_TYPES; t++) {
+		metal_io_init(&io, region, &phys, IO_PERF_SIZE, -1, 0, NULL);
+		metal_io_set_mem_type(&io, io_mem_types[t]);
+		for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+			len = sizes[s];
+			count = IO_PERF_BYTES / len;
+
+			start = io_now();
+			for (n = 0; n < count; n++)
+				metal_io_block_read(&io,
+						    (n * len) % IO_PERF_SIZE,
+						    buf + 1, len);
+			rd = io_now() - start;
+
+			start = io_now();
+			for (n = 0; n < count; n++)
+				metal_io_block_write(&io,
+						     (n * len) % IO_PERF_SIZE,
+						     buf + 1, len);
+			wr = io_now() - start;
+
+			start = io_now();
+			for (n = 0; n < count; n++)
+				metal_io_block_set(&io,
+						   (n * len) % IO_PERF_SIZE,
+						   (unsigned char)n, len);
+			set = io_now() - start;
+
+			metal_log(METAL_LOG_INFO,
+				  "%s %6d bytes: read %6.0f write %6.0f set %6.0f MB/s\n",
+				  io_mem_names[t], len,
+				  IO_PERF_BYTES / rd / (1024 * 1024),
+				  IO_PERF_BYTES / wr / (1024 * 1024),
+				  IO_PERF_BYTES / set / (1024 * 1024));
+		}
+		metal_io_finish(&io);
+	}
+
+	free(region);
+	free(buf);
+	return 0;
+}
+METAL_ADD_TEST(io_block_perf);
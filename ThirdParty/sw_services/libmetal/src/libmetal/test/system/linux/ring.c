@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2022, Xilinx Inc. and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "metal-test.h"
+#include <metal/irq.h>
+#include <metal/log.h>
+#include <metal/ring.h>
+#include <metal/shmem.h>
+#include <metal/softirq.h>
+#include <metal/sys.h>
+#include <metal/utilities.h>
+
+#define RING_SHMEM_NAME		"metal_test_ring"
+#define RING_SHMEM_SIZE		(1024 * 1024)
+#define RING_NUM_ELEMS		256
+#define RING_NUM_MSGS		(64 * 1024)	/* Messages per producer */
+#define RING_PRODUCERS		4
+#define RING_MAX_BURST		32
+#define RING_TIMEOUT		10.0	/* Seconds without progress */
+
+#define RING_PERF_MSGS		(16 * 1024 * 1024)
+#define RING_PERF_PINGS		(256 * 1024)
+
+/* Ring element of the tests, as a small rpmsg style descriptor */
+struct ring_msg {
+	uint32_t	src;
+	uint32_t	seq;
+	uint64_t	data;
+};
+
+struct ring_test {
+	struct metal_io_region	*io;
+	uint32_t		flags;
+	atomic_uint		next_src;
+	int			irq;
+	unsigned long		received;
+	int			error;
+	uint32_t		next_seq[RING_PRODUCERS];
+	struct metal_ring	ring;	/* consumer handle */
+};
+
+static double ring_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void ring_notify_irq(struct metal_ring *ring, void *arg)
+{
+	(void)ring;
+	metal_softirq_set((int)(uintptr_t)arg);
+}
+
+/* Producer thread, enqueues its messages in bursts of random sizes */
+static void *ring_producer(void *arg)
+{
+	struct ring_test *test = arg;
+	struct ring_msg msgs[RING_MAX_BURST];
+	struct metal_ring ring;
+	unsigned int seed, burst, done, i;
+	uint32_t src, seq = 0;
+	double last;
+	int error;
+
+	src = atomic_fetch_add(&test->next_src, 1);
+	seed = src + 1;
+	error = metal_ring_attach(&ring, test->io, 0);
+	if (error) {
+		test->error = error;
+		return NULL;
+	}
+	if (test->flags & METAL_RING_NOTIFY)
+		metal_ring_set_notify(&ring, ring_notify_irq,
+				      (void *)(uintptr_t)test->irq);
+
+	last = ring_now();
+	while (seq < RING_NUM_MSGS && !test->error) {
+		burst = rand_r(&seed) % RING_MAX_BURST + 1;
+		burst = metal_min(burst, RING_NUM_MSGS - seq);
+		for (i = 0; i < burst; i++) {
+			msgs[i].src = src;
+			msgs[i].seq = seq + i;
+			msgs[i].data = ~(uint64_t)(seq + i);
+		}
+		done = metal_ring_enqueue(&ring, msgs, burst);
+		seq += done;
+		if (done) {
+			last = ring_now();
+		} else if (ring_now() - last > RING_TIMEOUT) {
+			test->error = -ETIMEDOUT;
+			break;
+		} else {
+			sched_yield();
+		}
+	}
+
+	return NULL;
+}
+
+/* Dequeues the pending messages and checks their order and content */
+static unsigned int ring_drain(struct ring_test *test)
+{
+	struct ring_msg msgs[RING_MAX_BURST];
+	unsigned int num, total = 0, i;
+
+	while ((num = metal_ring_dequeue(&test->ring, msgs,
+					 RING_MAX_BURST)) != 0) {
+		for (i = 0; i < num; i++) {
+			if (msgs[i].src >= RING_PRODUCERS ||
+			    msgs[i].seq != test->next_seq[msgs[i].src] ||
+			    msgs[i].data != ~(uint64_t)msgs[i].seq) {
+				metal_log(METAL_LOG_ERROR,
+					  "bad message %u/%u after %lu\n",
+					  msgs[i].src, msgs[i].seq,
+					  test->received);
+				test->error = -EINVAL;
+				return total;
+			}
+			test->next_seq[msgs[i].src]++;
+		}
+		test->received += num;
+		total += num;
+	}
+
+	return total;
+}
+
+static int ring_irq_handler(int irq, void *arg)
+{
+	(void)irq;
+	ring_drain(arg);
+	return METAL_IRQ_HANDLED;
+}
+
+/*
+ * Runs producers against the consumer on this thread. With
+ * METAL_RING_NOTIFY the consumer only drains the ring from its soft
+ * interrupt handler, so a lost notification stalls the test.
+ */
+static int ring_run(struct ring_test *test, int producers)
+{
+	pthread_t tids[RING_PRODUCERS];
+	unsigned long expected = (unsigned long)producers * RING_NUM_MSGS;
+	unsigned long received;
+	int error, threads;
+	double last;
+
+	error = metal_ring_init(&test->ring, test->io, 0,
+				sizeof(struct ring_msg), RING_NUM_ELEMS,
+				test->flags);
+	if (error)
+		return error;
+	atomic_store(&test->next_src, 0);
+	test->received = 0;
+	test->error = 0;
+	memset(test->next_seq, 0, sizeof(test->next_seq));
+
+	error = metal_run_noblock(producers, ring_producer, test, tids,
+				  &threads);
+	if (error) {
+		metal_finish_threads(threads, tids);
+		return error;
+	}
+
+	last = ring_now();
+	while (test->received < expected && !test->error) {
+		received = test->received;
+		if (test->flags & METAL_RING_NOTIFY)
+			metal_softirq_dispatch();
+		else
+			ring_drain(test);
+		if (test->received != received)
+			last = ring_now();
+		else if (ring_now() - last > RING_TIMEOUT)
+			test->error = -ETIMEDOUT;
+	}
+	metal_finish_threads(threads, tids);
+
+	if (test->error)
+		metal_log(METAL_LOG_ERROR,
+			  "%d producers, flags %x: %lu of %lu messages, %d\n",
+			  producers, test->flags, test->received, expected,
+			  test->error);
+	else if (metal_ring_count(&test->ring))
+		test->error = -EINVAL;
+	return test->error;
+}
+
+static int ring(void)
+{
+	static struct ring_test test;
+	int error;
+
+	error = metal_shmem_open(RING_SHMEM_NAME, RING_SHMEM_SIZE, &test.io);
+	if (error) {
+		metal_log(METAL_LOG_ERROR, "Failed shmem_open: %d.\n", error);
+		return error;
+	}
+
+	/* Single producer */
+	test.flags = 0;
+	error = ring_run(&test, 1);
+	if (error)
+		goto out;
+
+	/* Multiple producers */
+	test.flags = METAL_RING_MP;
+	error = ring_run(&test, RING_PRODUCERS);
+	if (error)
+		goto out;
+
+	/* Multiple producers notifying the consumer */
+	error = metal_softirq_init();
+	if (!error) {
+		test.irq = metal_softirq_allocate(1);
+		error = test.irq < 0 ? test.irq : 0;
+	}
+	if (error)
+		goto out;
+	metal_irq_register(test.irq, ring_irq_handler, &test);
+	metal_irq_enable(test.irq);
+	test.flags = METAL_RING_MP | METAL_RING_NOTIFY;
+	error = ring_run(&test, RING_PRODUCERS);
+	metal_irq_disable(test.irq);
+	metal_irq_unregister(test.irq);
+
+out:
+	metal_io_finish(test.io);
+	return error;
+}
+METAL_ADD_TEST(ring);
+
+struct ring_perf {
+	struct metal_io_region	*io;
+	unsigned int		burst;
+	int			error;
+};
+
+/* Offsets of the two rings of the benchmark in the shared memory */
+#define RING_PERF_FWD		0
+#define RING_PERF_BACK		(RING_SHMEM_SIZE / 2)
+
+static void *ring_perf_producer(void *arg)
+{
+	struct ring_perf *perf = arg;
+	struct ring_msg msgs[RING_MAX_BURST] = { { 0 } };
+	struct metal_ring ring;
+	unsigned long sent = 0;
+	unsigned int num;
+
+	perf->error = metal_ring_attach(&ring, perf->io, RING_PERF_FWD);
+	while (!perf->error && sent < RING_PERF_MSGS) {
+		num = metal_min(perf->burst, RING_PERF_MSGS - sent);
+		num = metal_ring_enqueue(&ring, msgs, num);
+		if (!num)
+			sched_yield();
+		sent += num;
+	}
+
+	return NULL;
+}
+
+/* Echoes each message back to the sender */
+static void *ring_perf_echo(void *arg)
+{
+	struct ring_perf *perf = arg;
+	struct metal_ring fwd, back;
+	struct ring_msg msg;
+	unsigned long n;
+
+	perf->error = metal_ring_attach(&fwd, perf->io, RING_PERF_FWD);
+	if (!perf->error)
+		perf->error = metal_ring_attach(&back, perf->io,
+						RING_PERF_BACK);
+	for (n = 0; !perf->error && n < RING_PERF_PINGS; n++) {
+		while (!metal_ring_dequeue(&fwd, &msg, 1))
+			sched_yield();
+		while (!metal_ring_enqueue(&back, &msg, 1))
+			sched_yield();
+	}
+
+	return NULL;
+}
+
+/*
+ * Measures the throughput between two threads for a few burst sizes, then
+ * the round trip latency through a pair of rings.
+ */
+static int ring_perf(void)
+{
+	static const unsigned int bursts[] = { 1, 4, 32 };
+	struct ring_msg msgs[RING_MAX_BURST];
+	struct metal_ring fwd, back;
+	struct ring_perf perf;
+	pthread_t tid;
+	unsigned long received;
+	unsigned int b, num;
+	double start, elapsed;
+	int error, threads;
+
+	error = metal_shmem_open(RING_SHMEM_NAME, RING_SHMEM_SIZE, &perf.io);
+	if (error) {
+		metal_log(METAL_LOG_ERROR, "Failed shmem_open: %d.\n", error);
+		return error;
+	}
+
+	for (b = 0; b < sizeof(bursts) / sizeof(bursts[0]); b++) {
+		error = metal_ring_init(&fwd, perf.io, RING_PERF_FWD,
+					sizeof(struct ring_msg), RING_NUM_ELEMS,
+					0);
+		if (error)
+			goto out;
+		perf.burst = bursts[b];
+		perf.error = 0;
+		error = metal_run_noblock(1, ring_perf_producer, &perf, &tid,
+					  &threads);
+		if (error)
+			goto out;
+
+		start = ring_now();
+		for (received = 0; received < RING_PERF_MSGS && !perf.error;
+		     received += num) {
+			num = metal_ring_dequeue(&fwd, msgs, perf.burst);
+			if (!num)
+				sched_yield();
+		}
+		elapsed = ring_now() - start;
+		metal_finish_threads(threads, &tid);
+		error = perf.error;
+		if (error)
+			goto out;
+		metal_log(METAL_LOG_INFO,
+			  "burst %2u: %6.1f Mmsg/s, %6.0f MB/s\n",
+			  perf.burst, RING_PERF_MSGS / elapsed / 1e6,
+			  RING_PERF_MSGS * sizeof(struct ring_msg) /
+			  elapsed / (1024 * 1024));
+	}
+
+	error = metal_ring_init(&fwd, perf.io, RING_PERF_FWD,
+				sizeof(struct ring_msg), RING_NUM_ELEMS, 0);
+	if (!error)
+		error = metal_ring_init(&back, perf.io, RING_PERF_BACK,
+					sizeof(struct ring_msg),
+					RING_NUM_ELEMS, 0);
+	if (error)
+		goto out;
+	perf.error = 0;
+	error = metal_run_noblock(1, ring_perf_echo, &perf, &tid, &threads);
+	if (error)
+		goto out;
+	start = ring_now();
+	for (received = 0; received < RING_PERF_PINGS && !perf.error;
+	     received++) {
+		while (!metal_ring_enqueue(&fwd, msgs, 1))
+			sched_yield();
+		while (!metal_ring_dequeue(&back, msgs, 1) && !perf.error)
+			sched_yield();
+	}
+	elapsed = ring_now() - start;
+	metal_finish_threads(threads, &tid);
+	error = perf.error;
+	if (!error)
+		metal_log(METAL_LOG_INFO, "round trip: %.0f ns\n",
+			  elapsed / RING_PERF_PINGS * 1e9);
+
+out:
+	metal_io_finish(perf.io);
+	return error;
+}
+METAL_ADD_TEST(ring_perf);
@@ -1510,6 +1510,16 @@ proc generate_adapterconfig_include {libhandle} {
 		set ncoalesce [common::get_property CONFIG.n_rx_coalesce $libhandle]
 		puts $fd "\#define XLWIP_CONFIG_N_RX_COALESCE $ncoalesce"
 		puts $fd ""
+
+		if {$have_axi_ethernet_mcdma == 1} {
+			set rx_poll [common::get_property CONFIG.axieth_mcdma_rx_poll_mode $libhandle]
+			if {$rx_poll} {
+				puts $fd "\#define XLWIP_CONFIG_AXIETH_MCDMA_RX_POLL 1"
+			}
+			set rx_budget [common::get_property CONFIG.axieth_mcdma_rx_poll_budget $libhandle]
+			puts $fd "\#define XLWIP_CONFIG_AXIETH_MCDMA_RX_BUDGET $rx_budget"
+			puts $fd ""
+		}
 	}
 	if {$have_ps_ethernet == 1} {
 		set emacnum [common::get_property CONFIG.emac_number $libhandle]
@@ -1519,6 +1529,16 @@ proc generate_adapterconfig_include {libhandle} {
 		set ndesc [common::get_property CONFIG.n_rx_descriptors $libhandle]
 		puts $fd "\#define XLWIP_CONFIG_N_RX_DESC $ndesc"
 		puts $fd ""
+
+		set tx_batch [common::get_property CONFIG.emacps_tx_batch_mode $libhandle]
+		if {$tx_batch} {
+			puts $fd "\#define XLWIP_CONFIG_EMACPS_TX_BATCH 1"
+		}
+		set intr_mod [common::get_property CONFIG.emacps_tx_intr_moderation $libhandle]
+		puts $fd "\#define XLWIP_CONFIG_EMACPS_TX_INTR_MODERATION $intr_mod"
+		set rx_queues [common::get_property CONFIG.emacps_rx_queues $libhandle]
+		puts $fd "\#define XLWIP_CONFIG_EMACPS_NUM_RX_QUEUES $rx_queues"
+		puts $fd ""
 	}
 
 	puts $fd "\#endif"
@@ -65,6 +65,36 @@ extern "C" {
 #define INTC_DIST_BASE_ADDR     XPAR_SCUGIC_0_DIST_BASEADDR
 #endif
 
+#ifdef XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_MCDMA
+/* When set, a RX done interrupt harvests at most the channel weight in BDs
+ * (XLWIP_CONFIG_AXIETH_MCDMA_RX_BUDGET unless changed with
+ * xaxiemacif_set_rx_chan_weight()). A channel whose interrupt finds that
+ * many is busy: its completion interrupts are masked and it is polled from
+ * xaxiemacif_input() with the same budget per pass, until a pass finds
+ * fewer BDs. The RX coalescing count and delay decide how many BDs one
+ * interrupt sees, and so how soon a loaded channel switches to polling.
+ */
+#ifndef XLWIP_CONFIG_AXIETH_MCDMA_RX_POLL
+#define XLWIP_CONFIG_AXIETH_MCDMA_RX_POLL	0
+#endif
+#ifndef XLWIP_CONFIG_AXIETH_MCDMA_RX_BUDGET
+#define XLWIP_CONFIG_AXIETH_MCDMA_RX_BUDGET	64
+#endif
+
+#define XAXIEMACIF_MCDMA_MAX_CHANS	(XMCDMA_MAX_CHAN_PER_DEVICE / 2)
+
+/* per channel RX counters, see xaxiemacif_get_rx_chan_stats() */
+typedef struct {
+	u32_t interrupts;
+	u32_t irq_packets;	/* packets harvested by the interrupt */
+	u32_t poll_switches;	/* interrupts that switched to polling */
+	u32_t polls;
+	u32_t packets;		/* packets harvested by the poll passes */
+	u32_t budget_exhausted;
+	u32_t max_per_poll;
+} xaxiemacif_rx_chan_stats;
+#endif
+
 void 	xaxiemacif_setmac(u32_t index, u8_t *addr);
 u8_t*	xaxiemacif_getmac(u32_t index);
 err_t 	xaxiemacif_init(struct netif *netif);
@@ -98,6 +128,14 @@ typedef struct {
 	/* pointers to memory holding buffer descriptors (used only with SDMA) */
 	void *rx_bdspace;
 	void *tx_bdspace;
+
+#ifdef XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_MCDMA
+	/* bit (ChanId - 1) is set while RX channel ChanId is being polled */
+	volatile u32_t rx_poll_mask;
+	/* BDs harvested per interrupt or poll pass of each RX channel */
+	u32_t rx_weight[XAXIEMACIF_MCDMA_MAX_CHANS];
+	xaxiemacif_rx_chan_stats rx_stats[XAXIEMACIF_MCDMA_MAX_CHANS];
+#endif
 } xaxiemacif_s;
 
 extern xaxiemacif_s xaxiemacif;
@@ -116,6 +154,12 @@ s32_t process_sent_bds(XAxiDma_BdRing *txring);
 #ifdef XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_MCDMA
 XStatus init_axi_mcdma(struct xemac_s *xemac);
 XStatus axi_mcdma_sgsend(xaxiemacif_s *xaxiemacif, struct pbuf *p);
+u32_t axi_mcdma_rx_poll(struct xemac_s *xemac);
+s32_t xaxiemacif_get_rx_chan_stats(struct netif *netif, u32_t ChanId,
+				xaxiemacif_rx_chan_stats *stats);
+void xaxiemacif_reset_rx_chan_stats(struct netif *netif);
+s32_t xaxiemacif_set_rx_chan_weight(struct netif *netif, u32_t ChanId,
+				u32_t weight);
 #else
 XStatus init_axi_dma(struct xemac_s *xemac);
 #if LWIP_UDP_OPT_BLOCK_TX_TILL_COMPLETE
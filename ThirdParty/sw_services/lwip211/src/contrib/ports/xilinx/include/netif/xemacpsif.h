@@ -100,6 +100,46 @@ extern "C" {
 
 #define MAX_FRAME_SIZE_JUMBO (XEMACPS_MTU_JUMBO + XEMACPS_HDR_SIZE + XEMACPS_TRL_SIZE)
 
+/* TX batching options, generated into xlwipconfig.h when enabled */
+#ifndef XLWIP_CONFIG_EMACPS_TX_BATCH
+#define XLWIP_CONFIG_EMACPS_TX_BATCH 0
+#endif
+#ifndef XLWIP_CONFIG_EMACPS_TX_INTR_MODERATION
+#define XLWIP_CONFIG_EMACPS_TX_INTR_MODERATION 0
+#endif
+
+/* Number of receive queues, more than one needs GEM priority queues */
+#ifndef XLWIP_CONFIG_EMACPS_NUM_RX_QUEUES
+#define XLWIP_CONFIG_EMACPS_NUM_RX_QUEUES 1
+#endif
+
+#if defined (__aarch64__) || defined (ARMA53_32)
+#define XEMACPSIF_CACHE_LINE_SIZE	64
+#else
+#define XEMACPSIF_CACHE_LINE_SIZE	32
+#endif
+
+/* Free BD count below which the sender reclaims sent BDs itself */
+#if XLWIP_CONFIG_EMACPS_TX_BATCH
+#define XEMACPSIF_TX_RECLAIM_THRESHOLD	(XLWIP_CONFIG_N_TX_DESC / 4)
+#else
+#define XEMACPSIF_TX_RECLAIM_THRESHOLD	5
+#endif
+
+#define XEMACPSIF_MAX_QUEUES	2
+#define XEMACPSIF_ALL_RX_QUEUES	((1 << XEMACPSIF_MAX_QUEUES) - 1)
+
+/* per queue DMA counters, see xemacpsif_get_queue_stats() */
+typedef struct {
+	u32_t tx_interrupts;
+	u32_t tx_reclaim_passes;
+	u32_t tx_bds_reclaimed;
+	u32_t tx_bds_submitted;
+	u32_t tx_cache_flushes;
+	u32_t rx_interrupts;
+	u32_t rx_bds_processed;
+} xemacpsif_queue_stats;
+
 void 	xemacpsif_setmac(u32_t index, u8_t *addr);
 u8_t*	xemacpsif_getmac(u32_t index);
 err_t 	xemacpsif_init(struct netif *netif);
@@ -124,11 +164,34 @@ typedef struct {
 
 	unsigned int last_rx_frms_cntr;
 
+	/* queue used for transmit, 1 on GEM versions with priority queues */
+	u8_t txqueue;
+	xemacpsif_queue_stats qstats[XEMACPSIF_MAX_QUEUES];
+
+	/* receive queue 1 ring, and one lock free pbuf queue per receive
+	 * queue when more than one receive queue is in use. rx_consumers has
+	 * a bit per lock free queue being drained, claimed under
+	 * SYS_ARCH_PROTECT.
+	 */
+	u8_t num_rxqueues;
+	XEmacPs_BdRing rxq1_ring;
+	void *rxq1_bdspace;
+	pq_lf_queue_t *rx_lfq[XEMACPSIF_MAX_QUEUES];
+	u8_t rx_consumers;
+
 } xemacpsif_s;
 
 extern xemacpsif_s xemacpsif;
 
 s32_t	is_tx_space_available(xemacpsif_s *emac);
+s32_t	xemacpsif_get_queue_stats(struct netif *netif, u8_t queue,
+				xemacpsif_queue_stats *stats);
+void	xemacpsif_reset_queue_stats(struct netif *netif);
+s32_t	xemacpsif_input_queue(struct netif *netif, u8_t queue);
+s32_t	xemacpsif_steer_udp_port(struct netif *netif, u8_t rule, u8_t queue,
+				u16_t port);
+s32_t	xemacpsif_steer_ethtype(struct netif *netif, u8_t rule, u8_t queue,
+				u16_t ethtype);
 
 /* xemacpsif_dma.c */
 
@@ -145,6 +208,7 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p);
 void emacps_recv_handler(void *arg);
 void emacps_error_handler(void *arg,u8 Direction, u32 ErrorWord);
 void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring);
+XEmacPs_BdRing *xemacpsif_rx_ring(xemacpsif_s *xemacpsif, u8_t queue);
 void HandleTxErrors(struct xemac_s *xemac);
 void HandleEmacPsError(struct xemac_s *xemac);
 XEmacPs_Config *xemacps_lookup_config(unsigned mac_base);
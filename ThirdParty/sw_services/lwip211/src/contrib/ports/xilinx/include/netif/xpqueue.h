@@ -47,6 +47,27 @@ int 		pq_enqueue(pq_queue_t *q, void *p);
 void*		pq_dequeue(pq_queue_t *q);
 int		pq_qlength(pq_queue_t *q);
 
+/*
+ * Single producer / single consumer queue that needs no lock: head is only
+ * written by the producer and tail only by the consumer, so at most one
+ * context may enqueue and one may dequeue at a time. Size must be a power
+ * of two. The queues are only reserved when the GEM adapter is configured
+ * with more than one receive queue (XLWIP_CONFIG_EMACPS_NUM_RX_QUEUES),
+ * pq_lf_create_queue() returns NULL otherwise.
+ */
+#define PQ_LF_QUEUE_SIZE 1024
+
+typedef struct {
+	void *data[PQ_LF_QUEUE_SIZE];
+	volatile unsigned int head;
+	volatile unsigned int tail;
+} pq_lf_queue_t;
+
+pq_lf_queue_t*	pq_lf_create_queue();
+int		pq_lf_enqueue(pq_lf_queue_t *q, void *p);
+void*		pq_lf_dequeue(pq_lf_queue_t *q);
+int		pq_lf_qlength(pq_lf_queue_t *q);
+
 #ifdef __cplusplus
 }
 #endif
@@ -245,6 +245,13 @@ static struct pbuf *low_level_input(struct netif *netif)
 	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
 	struct pbuf *p;
 
+#if defined(XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_MCDMA) && \
+	XLWIP_CONFIG_AXIETH_MCDMA_RX_POLL
+	/* refill the receive q from the channels being polled */
+	if ((pq_qlength(xaxiemacif->recv_q) == 0) && xaxiemacif->rx_poll_mask)
+		axi_mcdma_rx_poll(xemac);
+#endif
+
 	/* see if there is data to process */
 	if (pq_qlength(xaxiemacif->recv_q) == 0)
 		return NULL;
@@ -345,6 +352,9 @@ static err_t low_level_init(struct netif *netif)
 	struct xemac_s *xemac;
 	xaxiemacif_s *xaxiemacif;
 	XAxiEthernet_Config *mac_config;
+#ifdef XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_MCDMA
+	u32_t i;
+#endif
 
 	xaxiemacif = mem_malloc(sizeof *xaxiemacif);
 	if (xaxiemacif == NULL) {
@@ -367,6 +377,13 @@ static err_t low_level_init(struct netif *netif)
 	if (!xaxiemacif->recv_q)
 		return ERR_MEM;
 
+#ifdef XLWIP_CONFIG_INCLUDE_AXI_ETHERNET_MCDMA
+	xaxiemacif->rx_poll_mask = 0;
+	for (i = 0; i < XAXIEMACIF_MCDMA_MAX_CHANS; i++)
+		xaxiemacif->rx_weight[i] = XLWIP_CONFIG_AXIETH_MCDMA_RX_BUDGET;
+	memset(xaxiemacif->rx_stats, 0, sizeof(xaxiemacif->rx_stats));
+#endif
+
 	/* maximum transfer unit */
 #ifdef USE_JUMBO_FRAMES
 	netif->mtu = XAE_JUMBO_MTU - XAE_HDR_SIZE;
@@ -28,6 +28,8 @@
  *
  */
 
+#include <string.h>
+
 #include "lwipopts.h"
 
 #if !NO_SYS
@@ -383,23 +385,21 @@ static void axi_mcdma_recv_error_handler(void *CallBackRef, u32 ChanId)
 	return;
 }
 
-static void axi_mcdma_recv_handler(void *CallBackRef, u32 ChanId)
+/*
+ * Harvest at most 'budget' completed BDs from an RX channel into the
+ * receive q and hand the BDs back to the hardware. Returns the number of
+ * BDs harvested.
+ */
+static u32_t axi_mcdma_rx_harvest(xaxiemacif_s *xaxiemacif,
+				  XMcdma_ChanCtrl *Rx_Chan, u32_t budget)
 {
 	struct pbuf *p;
 	u32 i, rx_bytes, ProcessedBdCnt;
 	XMcdma_Bd *rxbd, *rxbdset;
-	struct xemac_s *xemac = (struct xemac_s *)(CallBackRef);
-	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
-	XMcdma *McDmaInstPtr = &xaxiemacif->aximcdma;
-	XMcdma_ChanCtrl *Rx_Chan;
-
-#if !NO_SYS
-	xInsideISR++;
-#endif
 
-	Rx_Chan = XMcdma_GetMcdmaRxChan(McDmaInstPtr, ChanId);
-
-	ProcessedBdCnt = XMcdma_BdChainFromHW(Rx_Chan, XMCDMA_ALL_BDS, &rxbdset);
+	ProcessedBdCnt = XMcdma_BdChainFromHW(Rx_Chan, budget, &rxbdset);
+	if (ProcessedBdCnt == 0)
+		return 0;
 
 	for (i = 0, rxbd = rxbdset; i < ProcessedBdCnt; i++) {
 
@@ -437,12 +437,165 @@ static void axi_mcdma_recv_handler(void *CallBackRef, u32 ChanId)
 
 	/* return all the processed bd's back to the stack */
 	setup_rx_bds(Rx_Chan, Rx_Chan->BdCnt);
+
+	return ProcessedBdCnt;
+}
+
+static void axi_mcdma_recv_handler(void *CallBackRef, u32 ChanId)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(CallBackRef);
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+	XMcdma *McDmaInstPtr = &xaxiemacif->aximcdma;
+	XMcdma_ChanCtrl *Rx_Chan;
+#if XLWIP_CONFIG_AXIETH_MCDMA_RX_POLL
+	xaxiemacif_rx_chan_stats *stats = &xaxiemacif->rx_stats[ChanId - 1];
+	u32_t weight = xaxiemacif->rx_weight[ChanId - 1];
+	u32_t count;
+#endif
+
+#if !NO_SYS
+	xInsideISR++;
+#endif
+
+	Rx_Chan = XMcdma_GetMcdmaRxChan(McDmaInstPtr, ChanId);
+	xaxiemacif->rx_stats[ChanId - 1].interrupts++;
+
+#if XLWIP_CONFIG_AXIETH_MCDMA_RX_POLL
+	count = axi_mcdma_rx_harvest(xaxiemacif, Rx_Chan, weight);
+	stats->irq_packets += count;
+	if (count >= weight) {
+		/* More BDs are pending than one interrupt may take, mask the
+		 * completion interrupts and leave the channel to
+		 * axi_mcdma_rx_poll() until it has drained.
+		 */
+		XMcdma_IntrDisable(Rx_Chan, XMCDMA_IRQ_IOC_MASK |
+					    XMCDMA_IRQ_DELAY_MASK);
+		xaxiemacif->rx_poll_mask |= (1U << (ChanId - 1));
+		stats->poll_switches++;
+	}
+#else
+	axi_mcdma_rx_harvest(xaxiemacif, Rx_Chan, XMCDMA_ALL_BDS);
+#endif
+
 #if !NO_SYS
 	sys_sem_signal(&xemac->sem_rx_data_available);
 	xInsideISR--;
 #endif
 }
 
+/*
+ * axi_mcdma_rx_poll():
+ *
+ * Runs one pass over the RX channels that have been switched to polling by
+ * their done interrupt, harvesting at most the channel weight in BDs from
+ * each. A channel that yields fewer BDs than its weight has drained and goes
+ * back to interrupt mode. Must be called with interrupts disabled.
+ * Returns the number of BDs harvested.
+ */
+u32_t axi_mcdma_rx_poll(struct xemac_s *xemac)
+{
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+	xaxiemacif_rx_chan_stats *stats;
+	XMcdma_ChanCtrl *Rx_Chan;
+	u32_t ChanId, weight, count, total = 0;
+
+	for (ChanId = 1;
+		ChanId <= xaxiemacif->axi_ethernet.Config.AxiMcDmaChan_Cnt;
+								ChanId++) {
+		if (!(xaxiemacif->rx_poll_mask & (1U << (ChanId - 1))))
+			continue;
+
+		Rx_Chan = XMcdma_GetMcdmaRxChan(&xaxiemacif->aximcdma, ChanId);
+		weight = xaxiemacif->rx_weight[ChanId - 1];
+		count = axi_mcdma_rx_harvest(xaxiemacif, Rx_Chan, weight);
+
+		stats = &xaxiemacif->rx_stats[ChanId - 1];
+		stats->polls++;
+		stats->packets += count;
+		if (count > stats->max_per_poll)
+			stats->max_per_poll = count;
+
+		if (count >= weight) {
+			stats->budget_exhausted++;
+		} else {
+			/* BDs completing from here on latch IOC/DELAY in the
+			 * status register and raise the interrupt as soon as
+			 * it is unmasked, so none are missed.
+			 */
+			xaxiemacif->rx_poll_mask &= ~(1U << (ChanId - 1));
+			XMcdma_IntrEnable(Rx_Chan, XMCDMA_IRQ_IOC_MASK |
+						   XMCDMA_IRQ_DELAY_MASK);
+		}
+		total += count;
+	}
+
+	return total;
+}
+
+/*
+ * xaxiemacif_get_rx_chan_stats():
+ *
+ * Copies the RX counters of MCDMA channel ChanId (1 based). The average
+ * number of packets per poll pass is packets / polls. Returns -1 for an
+ * invalid channel.
+ */
+s32_t xaxiemacif_get_rx_chan_stats(struct netif *netif, u32_t ChanId,
+				xaxiemacif_rx_chan_stats *stats)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	if ((ChanId == 0) ||
+	    (ChanId > xaxiemacif->axi_ethernet.Config.AxiMcDmaChan_Cnt) ||
+	    (stats == NULL))
+		return -1;
+
+	SYS_ARCH_PROTECT(lev);
+	*stats = xaxiemacif->rx_stats[ChanId - 1];
+	SYS_ARCH_UNPROTECT(lev);
+
+	return 0;
+}
+
+void xaxiemacif_reset_rx_chan_stats(struct netif *netif)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	memset(xaxiemacif->rx_stats, 0, sizeof(xaxiemacif->rx_stats));
+	SYS_ARCH_UNPROTECT(lev);
+}
+
+/*
+ * xaxiemacif_set_rx_chan_weight():
+ *
+ * Sets the number of BDs harvested from RX channel ChanId (1 based) per
+ * interrupt or poll pass. A heavier channel gets a larger share of each
+ * xaxiemacif_input() pass and switches to polling later. Returns -1 for an
+ * invalid channel or a zero weight.
+ */
+s32_t xaxiemacif_set_rx_chan_weight(struct netif *netif, u32_t ChanId,
+				u32_t weight)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xaxiemacif_s *xaxiemacif = (xaxiemacif_s *)(xemac->state);
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	if ((ChanId == 0) ||
+	    (ChanId > xaxiemacif->axi_ethernet.Config.AxiMcDmaChan_Cnt) ||
+	    (weight == 0))
+		return -1;
+
+	SYS_ARCH_PROTECT(lev);
+	xaxiemacif->rx_weight[ChanId - 1] = weight;
+	SYS_ARCH_UNPROTECT(lev);
+
+	return 0;
+}
+
 s32_t is_tx_space_available(xaxiemacif_s *xaxiemacif)
 {
 	XMcdma_ChanCtrl *Tx_Chan;
@@ -160,7 +160,7 @@ static err_t low_level_output(struct netif *netif, struct pbuf *p)
 	SYS_ARCH_PROTECT(lev);
 	/* check if space is available to send */
     freecnt = is_tx_space_available(xemacpsif);
-    if (freecnt <= 5) {
+    if (freecnt <= XEMACPSIF_TX_RECLAIM_THRESHOLD) {
 	txring = &(XEmacPs_GetTxRing(&xemacpsif->emacps));
 		process_sent_bds(xemacpsif, txring);
 	}
@@ -242,6 +242,103 @@ static err_t xemacpsif_output(struct netif *netif, struct pbuf *p,
 	return etharp_output(netif, p, ipaddr);
 }
 
+/*
+ * xemacpsif_deliver():
+ *
+ * Hands a received frame to the TCP/IP stack, dropping frames that carry
+ * an unsupported ethertype.
+ *
+ */
+
+static void xemacpsif_deliver(struct netif *netif, struct pbuf *p)
+{
+	struct eth_hdr *ethhdr;
+
+	/* points to packet payload, which starts with an Ethernet header */
+	ethhdr = p->payload;
+
+#if LINK_STATS
+	lwip_stats.link.recv++;
+#endif /* LINK_STATS */
+
+	switch (htons(ethhdr->type)) {
+		/* IP or ARP packet? */
+		case ETHTYPE_IP:
+		case ETHTYPE_ARP:
+#if LWIP_IPV6
+		/*IPv6 Packet?*/
+		case ETHTYPE_IPV6:
+#endif
+#if PPPOE_SUPPORT
+			/* PPPoE packet? */
+		case ETHTYPE_PPPOEDISC:
+		case ETHTYPE_PPPOE:
+#endif /* PPPOE_SUPPORT */
+			/* full packet send to tcpip_thread to process */
+			if (netif->input(p, netif) != ERR_OK) {
+				LWIP_DEBUGF(NETIF_DEBUG, ("xemacpsif_input: IP input error\r\n"));
+				pbuf_free(p);
+			}
+			break;
+
+		default:
+			pbuf_free(p);
+			break;
+	}
+}
+
+/*
+ * xemacpsif_drain_rx():
+ *
+ * Hands the frames of the lock free receive queues in "mask" to the stack.
+ * Each lock free queue has a single consumer: the queues are claimed for
+ * the duration of the drain, and the call returns 0 without reading any
+ * frame if one of them is already being drained. Under NO_SYS,
+ * netif->input is not reentrant, so the whole interface is claimed
+ * whatever the mask.
+ *
+ * Returns the number of packets read.
+ *
+ */
+
+static s32_t xemacpsif_drain_rx(struct netif *netif, u8_t mask)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	struct pbuf *p;
+	s32_t count = 0;
+	u8_t claim = mask;
+	u8_t queue;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+#if NO_SYS
+	claim = XEMACPSIF_ALL_RX_QUEUES;
+#endif
+	SYS_ARCH_PROTECT(lev);
+	if (xemacpsif->rx_consumers & claim) {
+		SYS_ARCH_UNPROTECT(lev);
+		LWIP_DEBUGF(NETIF_DEBUG, ("xemacpsif_input: receive queue already being drained\r\n"));
+		return 0;
+	}
+	xemacpsif->rx_consumers |= claim;
+	SYS_ARCH_UNPROTECT(lev);
+
+	for (queue = 0; queue < xemacpsif->num_rxqueues; queue++) {
+		if (!(mask & (1 << queue)))
+			continue;
+		while ((p = (struct pbuf *)pq_lf_dequeue(xemacpsif->rx_lfq[queue])) != NULL) {
+			xemacpsif_deliver(netif, p);
+			count++;
+		}
+	}
+
+	SYS_ARCH_PROTECT(lev);
+	xemacpsif->rx_consumers &= ~claim;
+	SYS_ARCH_UNPROTECT(lev);
+
+	return count;
+}
+
 /*
  * xemacpsif_input():
  *
@@ -257,10 +354,15 @@ static err_t xemacpsif_output(struct netif *netif, struct pbuf *p,
 
 s32_t xemacpsif_input(struct netif *netif)
 {
-	struct eth_hdr *ethhdr;
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
 	struct pbuf *p;
 	SYS_ARCH_DECL_PROTECT(lev);
 
+	/* with several receive queues, drain all of them */
+	if (xemacpsif->num_rxqueues > 1)
+		return xemacpsif_drain_rx(netif, XEMACPSIF_ALL_RX_QUEUES);
+
 #if !NO_SYS
 	while (1)
 #endif
@@ -275,44 +377,85 @@ s32_t xemacpsif_input(struct netif *netif)
 			return 0;
 		}
 
-		/* points to packet payload, which starts with an Ethernet header */
-		ethhdr = p->payload;
-
-	#if LINK_STATS
-		lwip_stats.link.recv++;
-	#endif /* LINK_STATS */
-
-		switch (htons(ethhdr->type)) {
-			/* IP or ARP packet? */
-			case ETHTYPE_IP:
-			case ETHTYPE_ARP:
-	#if LWIP_IPV6
-			/*IPv6 Packet?*/
-			case ETHTYPE_IPV6:
-	#endif
-	#if PPPOE_SUPPORT
-				/* PPPoE packet? */
-			case ETHTYPE_PPPOEDISC:
-			case ETHTYPE_PPPOE:
-	#endif /* PPPOE_SUPPORT */
-				/* full packet send to tcpip_thread to process */
-				if (netif->input(p, netif) != ERR_OK) {
-					LWIP_DEBUGF(NETIF_DEBUG, ("xemacpsif_input: IP input error\r\n"));
-					pbuf_free(p);
-					p = NULL;
-				}
-				break;
-
-			default:
-				pbuf_free(p);
-				p = NULL;
-				break;
-		}
+		xemacpsif_deliver(netif, p);
 	}
 
 	return 1;
 }
 
+/*
+ * xemacpsif_input_queue():
+ *
+ * Same as xemacpsif_input() but only drains the given receive queue. Each
+ * per queue pbuf queue is lock free with a single consumer. With an OS,
+ * netif->input is tcpip_input(), so different tasks may each service their
+ * own queue; a call for a queue that another task is draining, or while
+ * xemacpsif_input() drains all of them, returns 0. Under NO_SYS the
+ * interface has a single consumer: call it from the main loop only, never
+ * from an interrupt handler, and a nested call returns 0.
+ *
+ * Returns the number of packets read.
+ *
+ */
+
+s32_t xemacpsif_input_queue(struct netif *netif, u8_t queue)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+
+	if ((xemacpsif->num_rxqueues <= 1) || (queue >= xemacpsif->num_rxqueues))
+		return xemacpsif_input(netif);
+
+	return xemacpsif_drain_rx(netif, (u8_t)(1 << queue));
+}
+
+/*
+ * xemacpsif_steer_udp_port():
+ *
+ * Steers received UDP frames with the given destination port to a receive
+ * queue using type 1 screener "rule". Returns -1 when the interface has a
+ * single receive queue.
+ *
+ */
+
+s32_t xemacpsif_steer_udp_port(struct netif *netif, u8_t rule, u8_t queue,
+				u16_t port)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+
+	if ((queue >= xemacpsif->num_rxqueues) || (rule >= XEMACPS_SCR_NUM))
+		return -1;
+
+	XEmacPs_SetScreenerT1(&xemacpsif->emacps, rule, queue, port);
+
+	return 0;
+}
+
+/*
+ * xemacpsif_steer_ethtype():
+ *
+ * Steers received frames with the given ethertype to a receive queue using
+ * type 2 screener "rule", which also claims ethertype register "rule".
+ * Returns -1 when the interface has a single receive queue.
+ *
+ */
+
+s32_t xemacpsif_steer_ethtype(struct netif *netif, u8_t rule, u8_t queue,
+				u16_t ethtype)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+
+	if ((queue >= xemacpsif->num_rxqueues) || (rule >= XEMACPS_SCRT2_ETHT_NUM))
+		return -1;
+
+	XEmacPs_SetScreenerT2(&xemacpsif->emacps, rule, queue, rule, ethtype,
+				XEMACPS_SCR_NONE);
+
+	return 0;
+}
+
 #if !NO_SYS
 #if defined(__arm__) && !defined(ARMR5)
 void vTimerCallback( TimerHandle_t pxTimer )
@@ -362,6 +505,22 @@ static err_t low_level_init(struct netif *netif)
 	if (!xemacpsif->recv_q)
 		return ERR_MEM;
 
+	xemacpsif->txqueue = 0;
+	memset(xemacpsif->qstats, 0, sizeof(xemacpsif->qstats));
+
+	xemacpsif->num_rxqueues = 1;
+	xemacpsif->rx_consumers = 0;
+	memset(xemacpsif->rx_lfq, 0, sizeof(xemacpsif->rx_lfq));
+	if (XLWIP_CONFIG_EMACPS_NUM_RX_QUEUES > 1) {
+		u8_t queue;
+
+		for (queue = 0; queue < XLWIP_CONFIG_EMACPS_NUM_RX_QUEUES; queue++) {
+			xemacpsif->rx_lfq[queue] = pq_lf_create_queue();
+			if (!xemacpsif->rx_lfq[queue])
+				return ERR_MEM;
+		}
+	}
+
 	/* maximum transfer unit */
 #ifdef ZYNQMP_USE_JUMBO
 	netif->mtu = XEMACPS_MTU_JUMBO - XEMACPS_HDR_SIZE;
@@ -552,7 +711,7 @@ static void xemacpsif_mld6_mac_hash_update (struct netif *netif, u8_t *ip_addr,
 	reset_dma(xemac);
 
 	/* Start Ethernet */
-	XEmacPs_Start(&xemacpsif->emacps);
+	start_emacps(xemacpsif);
 
 	SYS_ARCH_UNPROTECT(lev);
 }
@@ -659,7 +818,7 @@ static void xemacpsif_mac_hash_update (struct netif *netif, u8_t *ip_addr,
 	reset_dma(xemac);
 
 	/* Start Ethernet */
-	XEmacPs_Start(&xemacpsif->emacps);
+	start_emacps(xemacpsif);
 
 	SYS_ARCH_UNPROTECT(lev);
 }
@@ -793,3 +952,39 @@ void xemacpsif_resetrx_on_no_rxdata(struct netif *netif)
 
 	resetrx_on_no_rxdata(xemacpsif);
 }
+
+/*
+ * xemacpsif_get_queue_stats():
+ *
+ * Copies the DMA counters of the given queue, e.g. to compute the number
+ * of BDs reclaimed per TX interrupt. Returns -1 for an invalid queue.
+ *
+ */
+
+s32_t xemacpsif_get_queue_stats(struct netif *netif, u8_t queue,
+				xemacpsif_queue_stats *stats)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	if ((queue >= XEMACPSIF_MAX_QUEUES) || (stats == NULL))
+		return -1;
+
+	SYS_ARCH_PROTECT(lev);
+	*stats = xemacpsif->qstats[queue];
+	SYS_ARCH_UNPROTECT(lev);
+
+	return 0;
+}
+
+void xemacpsif_reset_queue_stats(struct netif *netif)
+{
+	struct xemac_s *xemac = (struct xemac_s *)(netif->state);
+	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	SYS_ARCH_PROTECT(lev);
+	memset(xemacpsif->qstats, 0, sizeof(xemacpsif->qstats));
+	SYS_ARCH_UNPROTECT(lev);
+}
@@ -63,7 +63,7 @@
 
 /* A max of 4 different ethernet interfaces are supported */
 static UINTPTR tx_pbufs_storage[4*XLWIP_CONFIG_N_TX_DESC];
-static UINTPTR rx_pbufs_storage[4*XLWIP_CONFIG_N_RX_DESC];
+static UINTPTR rx_pbufs_storage[4*XLWIP_CONFIG_N_RX_DESC*XLWIP_CONFIG_EMACPS_NUM_RX_QUEUES];
 
 static s32_t emac_intr_num;
 #if LWIP_UDP_OPT_BLOCK_TX_TILL_COMPLETE
@@ -223,6 +223,59 @@ u32_t get_base_index_rxpbufsstorage (xemacpsif_s *xemacpsif)
 	return index;
 }
 
+/* Each interface owns XLWIP_CONFIG_EMACPS_NUM_RX_QUEUES slices of storage */
+static inline
+u32_t get_base_index_rxq_pbufsstorage (xemacpsif_s *xemacpsif, u8_t queue)
+{
+	return (get_base_index_rxpbufsstorage(xemacpsif) *
+			XLWIP_CONFIG_EMACPS_NUM_RX_QUEUES) +
+			(queue * XLWIP_CONFIG_N_RX_DESC);
+}
+
+XEmacPs_BdRing *xemacpsif_rx_ring(xemacpsif_s *xemacpsif, u8_t queue)
+{
+	if (queue == 0) {
+		return &XEmacPs_GetRxRing(&xemacpsif->emacps);
+	}
+	return &xemacpsif->rxq1_ring;
+}
+
+static inline
+u8_t xemacpsif_rx_queue_of(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
+{
+	return (rxring == &xemacpsif->rxq1_ring) ? 1 : 0;
+}
+
+#if XLWIP_CONFIG_EMACPS_TX_BATCH
+/*
+ * tx_flush_coalesce():
+ *
+ * Accumulates the payload ranges of a pbuf chain so that fragments lying
+ * within a cache line of each other are cleaned with one flush. A range
+ * that cannot be merged flushes the pending one and starts a new range.
+ */
+static inline
+void tx_flush_coalesce(xemacpsif_s *xemacpsif, UINTPTR *start, UINTPTR *end,
+					UINTPTR addr, u32_t len)
+{
+	if ((*end != *start) && (addr <= *end + XEMACPSIF_CACHE_LINE_SIZE) &&
+		(addr + len + XEMACPSIF_CACHE_LINE_SIZE >= *start)) {
+		if (addr < *start)
+			*start = addr;
+		if (addr + len > *end)
+			*end = addr + len;
+		return;
+	}
+
+	if (*end != *start) {
+		Xil_DCacheFlushRange(*start, *end - *start);
+		xemacpsif->qstats[xemacpsif->txqueue].tx_cache_flushes++;
+	}
+	*start = addr;
+	*end = addr + len;
+}
+#endif
+
 void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 {
 	XEmacPs_Bd *txbdset;
@@ -250,6 +303,9 @@ void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 		if (n_bds == 0)  {
 			return;
 		}
+		xemacpsif->qstats[xemacpsif->txqueue].tx_reclaim_passes++;
+		xemacpsif->qstats[xemacpsif->txqueue].tx_bds_reclaimed += n_bds;
+
 		/* free the processed BD's */
 		n_pbufs_freed = n_bds;
 		curbdpntr = txbdset;
@@ -263,7 +319,9 @@ void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 			} else {
 				*temp = 0x80000000;
 			}
+#if !XLWIP_CONFIG_EMACPS_TX_BATCH
 			dsb();
+#endif
 			p = (struct pbuf *)tx_pbufs_storage[index + bdindex];
 			if (p != NULL) {
 				pbuf_free(p);
@@ -274,8 +332,14 @@ void process_sent_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *txring)
 			tx_pbufs_storage[index + bdindex] = 0;
 			curbdpntr = XEmacPs_BdRingNext(txring, curbdpntr);
 			n_pbufs_freed--;
+#if !XLWIP_CONFIG_EMACPS_TX_BATCH
 			dsb();
+#endif
 		}
+#if XLWIP_CONFIG_EMACPS_TX_BATCH
+		/* One barrier for the whole set of recycled BDs */
+		dsb();
+#endif
 
 		status = XEmacPs_BdRingFree(txring, n_bds, txbdset);
 		if (status != XST_SUCCESS) {
@@ -297,6 +361,7 @@ void emacps_send_handler(void *arg)
 	xemac = (struct xemac_s *)(arg);
 	xemacpsif = (xemacpsif_s *)(xemac->state);
 	txringptr = &(XEmacPs_GetTxRing(&xemacpsif->emacps));
+	xemacpsif->qstats[xemacpsif->txqueue].tx_interrupts++;
 	regval = XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress, XEMACPS_TXSR_OFFSET);
 	XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress,XEMACPS_TXSR_OFFSET, regval);
 
@@ -325,6 +390,10 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 #if LWIP_UDP_OPT_BLOCK_TX_TILL_COMPLETE
 	u32_t tx_task_notifier_index;
 #endif
+#if XLWIP_CONFIG_EMACPS_TX_BATCH
+	UINTPTR flush_start = 0;
+	UINTPTR flush_end = 0;
+#endif
 
 	txring = &(XEmacPs_GetTxRing(&xemacpsif->emacps));
 
@@ -355,7 +424,12 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 		   time. The size of the data in each pbuf is kept in the ->len
 		   variable. */
 		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
+#if XLWIP_CONFIG_EMACPS_TX_BATCH
+			tx_flush_coalesce(xemacpsif, &flush_start, &flush_end,
+					(UINTPTR)q->payload, q->len);
+#else
 			Xil_DCacheFlushRange((UINTPTR)q->payload, (UINTPTR)q->len);
+#endif
 		}
 
 		XEmacPs_BdSetAddressTx(txbd, (UINTPTR)q->payload);
@@ -377,6 +451,12 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 		XEmacPs_BdClearLast(txbd);
 		txbd = XEmacPs_BdRingNext(txring, txbd);
 	}
+#if XLWIP_CONFIG_EMACPS_TX_BATCH
+	if (flush_end != flush_start) {
+		Xil_DCacheFlushRange(flush_start, flush_end - flush_start);
+		xemacpsif->qstats[xemacpsif->txqueue].tx_cache_flushes++;
+	}
+#endif
 #if LWIP_UDP_OPT_BLOCK_TX_TILL_COMPLETE
     if (block_till_tx_complete == 1) {
 		notifyinfo[tx_task_notifier_index + bdindex] = 1;
@@ -404,6 +484,7 @@ XStatus emacps_sgsend(xemacpsif_s *xemacpsif, struct pbuf *p)
 		LWIP_DEBUGF(NETIF_DEBUG, ("sgsend: Error submitting TxBD\r\n"));
 		return XST_FAILURE;
 	}
+	xemacpsif->qstats[xemacpsif->txqueue].tx_bds_submitted += n_pbufs;
 	/* Start transmit */
 	XEmacPs_WriteReg((xemacpsif->emacps).Config.BaseAddress,
 	XEMACPS_NWCTRL_OFFSET,
@@ -422,7 +503,8 @@ void setup_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxring)
 	u32 *temp;
 	u32_t index;
 
-	index = get_base_index_rxpbufsstorage (xemacpsif);
+	index = get_base_index_rxq_pbufsstorage (xemacpsif,
+				xemacpsif_rx_queue_of(xemacpsif, rxring));
 
 	freebds = XEmacPs_BdRingGetFreeCnt (rxring);
 	while (freebds > 0) {
@@ -505,17 +587,17 @@ void emacps_recv_handler(void *arg)
 	u32_t regval;
 	u32_t index;
 	u32_t gigeversion;
+	u8_t queue;
+	s32_t status;
 
 	xemac = (struct xemac_s *)(arg);
 	xemacpsif = (xemacpsif_s *)(xemac->state);
-	rxring = &XEmacPs_GetRxRing(&xemacpsif->emacps);
 
 #if !NO_SYS
 	xInsideISR++;
 #endif
 
 	gigeversion = ((Xil_In32(xemacpsif->emacps.Config.BaseAddress + 0xFC)) >> 16) & 0xFFF;
-	index = get_base_index_rxpbufsstorage (xemacpsif);
 	/*
 	 * If Reception done interrupt is asserted, call RX call back function
 	 * to handle the processed BDs and then raise the according flag.
@@ -526,50 +608,66 @@ void emacps_recv_handler(void *arg)
 			resetrx_on_no_rxdata(xemacpsif);
 	}
 
-	while(1) {
-
-		bd_processed = XEmacPs_BdRingFromHwRx(rxring, XLWIP_CONFIG_N_RX_DESC, &rxbdset);
-		if (bd_processed <= 0) {
-			break;
+	/* One interrupt services every receive queue */
+	for (queue = 0; queue < xemacpsif->num_rxqueues; queue++) {
+		rxring = xemacpsif_rx_ring(xemacpsif, queue);
+		index = get_base_index_rxq_pbufsstorage (xemacpsif, queue);
+		if ((xemacpsif->emacps.RxQueueStatus &
+					XEMACPS_RXQ_STATUS(queue)) != 0U) {
+			xemacpsif->qstats[queue].rx_interrupts++;
 		}
 
-		for (k = 0, curbdptr=rxbdset; k < bd_processed; k++) {
+		while(1) {
 
-			bdindex = XEMACPS_BD_TO_INDEX(rxring, curbdptr);
-			p = (struct pbuf *)rx_pbufs_storage[index + bdindex];
+			bd_processed = XEmacPs_BdRingFromHwRx(rxring, XLWIP_CONFIG_N_RX_DESC, &rxbdset);
+			if (bd_processed <= 0) {
+				break;
+			}
+			xemacpsif->qstats[queue].rx_bds_processed += bd_processed;
 
-			/*
-			 * Adjust the buffer size to the actual number of bytes received.
-			 */
+			for (k = 0, curbdptr=rxbdset; k < bd_processed; k++) {
+
+				bdindex = XEMACPS_BD_TO_INDEX(rxring, curbdptr);
+				p = (struct pbuf *)rx_pbufs_storage[index + bdindex];
+
+				/*
+				 * Adjust the buffer size to the actual number of bytes received.
+				 */
 #ifdef ZYNQMP_USE_JUMBO
-			rx_bytes = XEmacPs_GetRxFrameSize(&xemacpsif->emacps, curbdptr);
+				rx_bytes = XEmacPs_GetRxFrameSize(&xemacpsif->emacps, curbdptr);
 #else
-			rx_bytes = XEmacPs_BdGetLength(curbdptr);
+				rx_bytes = XEmacPs_BdGetLength(curbdptr);
 #endif
-			pbuf_realloc(p, rx_bytes);
-
-			/* Invalidate RX frame before queuing to handle
-			 * L1 cache prefetch conditions on any architecture.
-			 */
-			if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-				Xil_DCacheInvalidateRange((UINTPTR)p->payload, rx_bytes);
-			}
-
-			/* store it in the receive queue,
-			 * where it'll be processed by a different handler
-			 */
-			if (pq_enqueue(xemacpsif->recv_q, (void*)p) < 0) {
+				pbuf_realloc(p, rx_bytes);
+
+				/* Invalidate RX frame before queuing to handle
+				 * L1 cache prefetch conditions on any architecture.
+				 */
+				if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
+					Xil_DCacheInvalidateRange((UINTPTR)p->payload, rx_bytes);
+				}
+
+				/* store it in the receive queue of this ring,
+				 * where it'll be processed by a different handler
+				 */
+				if (xemacpsif->num_rxqueues > 1) {
+					status = pq_lf_enqueue(xemacpsif->rx_lfq[queue], (void*)p);
+				} else {
+					status = pq_enqueue(xemacpsif->recv_q, (void*)p);
+				}
+				if (status < 0) {
 #if LINK_STATS
-				lwip_stats.link.memerr++;
-				lwip_stats.link.drop++;
+					lwip_stats.link.memerr++;
+					lwip_stats.link.drop++;
 #endif
-				pbuf_free(p);
+					pbuf_free(p);
+				}
+				curbdptr = XEmacPs_BdRingNext( rxring, curbdptr);
 			}
-			curbdptr = XEmacPs_BdRingNext( rxring, curbdptr);
+			/* free up the BD's */
+			XEmacPs_BdRingFree(rxring, bd_processed, rxbdset);
+			setup_rx_bds(xemacpsif, rxring);
 		}
-		/* free up the BD's */
-		XEmacPs_BdRingFree(rxring, bd_processed, rxbdset);
-		setup_rx_bds(xemacpsif, rxring);
 	}
 #if !NO_SYS
 	sys_sem_signal(&xemac->sem_rx_data_available);
@@ -599,27 +697,99 @@ void clean_dma_txdescs(struct xemac_s *xemac)
 	XEmacPs_BdRingClone(txringptr, &bdtemplate, XEMACPS_SEND);
 }
 
-XStatus init_dma(struct xemac_s *xemac)
+/*
+ * alloc_rx_bds():
+ *
+ * Allocates a pbuf for and commits every RxBD of a receive ring,
+ * 1 RxBD at a time.
+ */
+static XStatus alloc_rx_bds(xemacpsif_s *xemacpsif, XEmacPs_BdRing *rxringptr,
+							u32_t index)
 {
-	XEmacPs_Bd bdtemplate;
-	XEmacPs_BdRing *rxringptr, *txringptr;
 	XEmacPs_Bd *rxbd;
 	struct pbuf *p;
 	XStatus status;
 	s32_t i;
 	u32_t bdindex;
+	u32 *temp;
+
+	for (i = 0; i < XLWIP_CONFIG_N_RX_DESC; i++) {
+#ifdef ZYNQMP_USE_JUMBO
+		p = pbuf_alloc(PBUF_RAW, MAX_FRAME_SIZE_JUMBO, PBUF_POOL);
+#else
+		p = pbuf_alloc(PBUF_RAW, XEMACPS_MAX_FRAME_SIZE, PBUF_POOL);
+#endif
+		if (!p) {
+#if LINK_STATS
+			lwip_stats.link.memerr++;
+			lwip_stats.link.drop++;
+#endif
+			LWIP_DEBUGF(NETIF_DEBUG, ("init_dma: Error allocating pbuf\r\n"));
+			return XST_FAILURE;
+		}
+		status = XEmacPs_BdRingAlloc(rxringptr, 1, &rxbd);
+		if (status != XST_SUCCESS) {
+			LWIP_DEBUGF(NETIF_DEBUG, ("init_dma: Error allocating RxBD\r\n"));
+			pbuf_free(p);
+			return XST_FAILURE;
+		}
+		/* Enqueue to HW */
+		status = XEmacPs_BdRingToHw(rxringptr, 1, rxbd);
+		if (status != XST_SUCCESS) {
+			LWIP_DEBUGF(NETIF_DEBUG, ("Error: committing RxBD to HW\r\n"));
+			pbuf_free(p);
+			XEmacPs_BdRingUnAlloc(rxringptr, 1, rxbd);
+			return XST_FAILURE;
+		}
+
+		bdindex = XEMACPS_BD_TO_INDEX(rxringptr, rxbd);
+		temp = (u32 *)rxbd;
+		*temp = 0;
+		if (bdindex == (XLWIP_CONFIG_N_RX_DESC - 1)) {
+			*temp = 0x00000002;
+		}
+		temp++;
+		*temp = 0;
+		dsb();
+#ifdef ZYNQMP_USE_JUMBO
+		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
+			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)MAX_FRAME_SIZE_JUMBO);
+		}
+#else
+		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
+			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)XEMACPS_MAX_FRAME_SIZE);
+		}
+#endif
+		XEmacPs_BdSetAddressRx(rxbd, (UINTPTR)p->payload);
+
+		rx_pbufs_storage[index + bdindex] = (UINTPTR)p;
+	}
+
+	return XST_SUCCESS;
+}
+
+XStatus init_dma(struct xemac_s *xemac)
+{
+	XEmacPs_Bd bdtemplate;
+	XEmacPs_BdRing *rxringptr, *txringptr;
+	XStatus status;
 	volatile UINTPTR tempaddress;
-	u32_t index;
 	u32_t gigeversion;
+	u32_t rxbufsize;
+	u8_t queue;
 	XEmacPs_Bd *bdtxterminate = NULL;
 	XEmacPs_Bd *bdrxterminate = NULL;
-	u32 *temp;
 
 	xemacpsif_s *xemacpsif = (xemacpsif_s *)(xemac->state);
 	struct xtopology_t *xtopologyp = &xtopology[xemac->topology_index];
 
-	index = get_base_index_rxpbufsstorage (xemacpsif);
 	gigeversion = ((Xil_In32(xemacpsif->emacps.Config.BaseAddress + 0xFC)) >> 16) & 0xFFF;
+	/* Receive queues other than 0 need GEM priority queue support */
+	if (gigeversion > 2) {
+		xemacpsif->num_rxqueues = XLWIP_CONFIG_EMACPS_NUM_RX_QUEUES;
+	} else {
+		xemacpsif->num_rxqueues = 1;
+	}
 	/*
 	 * The BDs need to be allocated in uncached memory. Hence the 1 MB
 	 * address range allocated for Bd_Space is made uncached
@@ -660,6 +830,11 @@ XStatus init_dma(struct xemac_s *xemac)
 		bdtxterminate = (XEmacPs_Bd *)tempaddress;
 		bd_space_index += 0x10000;
 	}
+	if (xemacpsif->num_rxqueues > 1) {
+		tempaddress = (UINTPTR)&(bd_space[bd_space_index]);
+		xemacpsif->rxq1_bdspace = (void *)tempaddress;
+		bd_space_index += 0x10000;
+	}
 
 	LWIP_DEBUGF(NETIF_DEBUG, ("rx_bdspace: %p \r\n", xemacpsif->rx_bdspace));
 	LWIP_DEBUGF(NETIF_DEBUG, ("tx_bdspace: %p \r\n", xemacpsif->tx_bdspace));
@@ -697,6 +872,24 @@ XStatus init_dma(struct xemac_s *xemac)
 		return ERR_IF;
 	}
 
+	if (xemacpsif->num_rxqueues > 1) {
+		status = XEmacPs_BdRingCreate(&xemacpsif->rxq1_ring,
+					(UINTPTR) xemacpsif->rxq1_bdspace,
+					(UINTPTR) xemacpsif->rxq1_bdspace, BD_ALIGNMENT,
+					XLWIP_CONFIG_N_RX_DESC);
+		if (status != XST_SUCCESS) {
+			LWIP_DEBUGF(NETIF_DEBUG, ("Error setting up RxQ1 BD space\r\n"));
+			return ERR_IF;
+		}
+
+		status = XEmacPs_BdRingClone(&xemacpsif->rxq1_ring, &bdtemplate,
+					XEMACPS_RECV);
+		if (status != XST_SUCCESS) {
+			LWIP_DEBUGF(NETIF_DEBUG, ("Error initializing RxQ1 BD space\r\n"));
+			return ERR_IF;
+		}
+	}
+
 	XEmacPs_BdClear(&bdtemplate);
 	XEmacPs_BdSetStatus(&bdtemplate, XEMACPS_TXBUF_USED_MASK);
 	/*
@@ -717,65 +910,24 @@ XStatus init_dma(struct xemac_s *xemac)
 	}
 
 	/*
-	 * Allocate RX descriptors, 1 RxBD at a time.
+	 * Allocate RX descriptors for every receive queue.
 	 */
-	for (i = 0; i < XLWIP_CONFIG_N_RX_DESC; i++) {
-#ifdef ZYNQMP_USE_JUMBO
-		p = pbuf_alloc(PBUF_RAW, MAX_FRAME_SIZE_JUMBO, PBUF_POOL);
-#else
-		p = pbuf_alloc(PBUF_RAW, XEMACPS_MAX_FRAME_SIZE, PBUF_POOL);
-#endif
-		if (!p) {
-#if LINK_STATS
-			lwip_stats.link.memerr++;
-			lwip_stats.link.drop++;
-#endif
-			printf("unable to alloc pbuf in init_dma\r\n");
-			return ERR_IF;
-		}
-		status = XEmacPs_BdRingAlloc(rxringptr, 1, &rxbd);
-		if (status != XST_SUCCESS) {
-			LWIP_DEBUGF(NETIF_DEBUG, ("init_dma: Error allocating RxBD\r\n"));
-			pbuf_free(p);
-			return ERR_IF;
-		}
-		/* Enqueue to HW */
-		status = XEmacPs_BdRingToHw(rxringptr, 1, rxbd);
+	for (queue = 0; queue < xemacpsif->num_rxqueues; queue++) {
+		status = alloc_rx_bds(xemacpsif, xemacpsif_rx_ring(xemacpsif, queue),
+				get_base_index_rxq_pbufsstorage(xemacpsif, queue));
 		if (status != XST_SUCCESS) {
-			LWIP_DEBUGF(NETIF_DEBUG, ("Error: committing RxBD to HW\r\n"));
-			pbuf_free(p);
-			XEmacPs_BdRingUnAlloc(rxringptr, 1, rxbd);
 			return ERR_IF;
 		}
-
-		bdindex = XEMACPS_BD_TO_INDEX(rxringptr, rxbd);
-		temp = (u32 *)rxbd;
-		*temp = 0;
-		if (bdindex == (XLWIP_CONFIG_N_RX_DESC - 1)) {
-			*temp = 0x00000002;
-		}
-		temp++;
-		*temp = 0;
-		dsb();
-#ifdef ZYNQMP_USE_JUMBO
-		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)MAX_FRAME_SIZE_JUMBO);
-		}
-#else
-		if (xemacpsif->emacps.Config.IsCacheCoherent == 0) {
-			Xil_DCacheInvalidateRange((UINTPTR)p->payload, (UINTPTR)XEMACPS_MAX_FRAME_SIZE);
-		}
-#endif
-		XEmacPs_BdSetAddressRx(rxbd, (UINTPTR)p->payload);
-
-		rx_pbufs_storage[index + bdindex] = (UINTPTR)p;
 	}
+
 	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.RxBdRing.BaseBdAddr, 0, XEMACPS_RECV);
 	if (gigeversion > 2) {
-		XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.TxBdRing.BaseBdAddr, 1, XEMACPS_SEND);
-	}else {
-		XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.TxBdRing.BaseBdAddr, 0, XEMACPS_SEND);
+		xemacpsif->txqueue = 1;
+	} else {
+		xemacpsif->txqueue = 0;
 	}
+	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.TxBdRing.BaseBdAddr,
+				xemacpsif->txqueue, XEMACPS_SEND);
 	if (gigeversion > 2)
 	{
 		/*
@@ -786,16 +938,43 @@ XStatus init_dma(struct xemac_s *xemac)
 		 * the controller to malfunction by fetching the descriptors
 		 * from these queues.
 		 */
-		XEmacPs_BdClear(bdrxterminate);
-		XEmacPs_BdSetAddressRx(bdrxterminate, (XEMACPS_RXBUF_NEW_MASK |
-						XEMACPS_RXBUF_WRAP_MASK));
-		XEmacPs_Out32((xemacpsif->emacps.Config.BaseAddress + XEMACPS_RXQ1BASE_OFFSET),
-				   (UINTPTR)bdrxterminate);
+		if (xemacpsif->num_rxqueues > 1) {
+			/* Receive queue 1 uses the same buffer size as queue 0 */
+			rxbufsize = (XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress,
+						XEMACPS_DMACR_OFFSET) & XEMACPS_DMACR_RXBUF_MASK) >>
+						XEMACPS_DMACR_RXBUF_SHIFT;
+			XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress,
+						XEMACPS_RXQ1BUFSIZE_OFFSET, rxbufsize);
+			XEmacPs_SetQueuePtr(&(xemacpsif->emacps),
+						xemacpsif->rxq1_ring.BaseBdAddr, 1, XEMACPS_RECV);
+		} else {
+			XEmacPs_BdClear(bdrxterminate);
+			XEmacPs_BdSetAddressRx(bdrxterminate, (XEMACPS_RXBUF_NEW_MASK |
+							XEMACPS_RXBUF_WRAP_MASK));
+			XEmacPs_Out32((xemacpsif->emacps.Config.BaseAddress + XEMACPS_RXQ1BASE_OFFSET),
+					   (UINTPTR)bdrxterminate);
+		}
 		XEmacPs_BdClear(bdtxterminate);
 		XEmacPs_BdSetStatus(bdtxterminate, (XEMACPS_TXBUF_USED_MASK |
 						XEMACPS_TXBUF_WRAP_MASK));
 		XEmacPs_Out32((xemacpsif->emacps.Config.BaseAddress + XEMACPS_TXQBASE_OFFSET),
 				   (UINTPTR)bdtxterminate);
+
+		/*
+		 * Let the controller hold back TX complete interrupts so that
+		 * each one reclaims a batch of sent BDs.
+		 */
+		if (XLWIP_CONFIG_EMACPS_TX_INTR_MODERATION > 0) {
+			u32_t intmod;
+
+			intmod = XEmacPs_ReadReg(xemacpsif->emacps.Config.BaseAddress,
+						XEMACPS_INTMOD_OFFSET);
+			intmod &= ~XEMACPS_INTMOD_TX_MASK;
+			intmod |= ((u32_t)XLWIP_CONFIG_EMACPS_TX_INTR_MODERATION <<
+					XEMACPS_INTMOD_TX_SHIFT) & XEMACPS_INTMOD_TX_MASK;
+			XEmacPs_WriteReg(xemacpsif->emacps.Config.BaseAddress,
+						XEMACPS_INTMOD_OFFSET, intmod);
+		}
 	}
 #if !NO_SYS
 	xPortInstallInterruptHandler(xtopologyp->scugic_emac_intr,
@@ -872,8 +1051,9 @@ void free_txrx_pbufs(xemacpsif_s *xemacpsif)
 		}
 	}
 
-	index1 = get_base_index_rxpbufsstorage(xemacpsif);
-	for (index = index1; index < (index1 + XLWIP_CONFIG_N_RX_DESC); index++) {
+	index1 = get_base_index_rxq_pbufsstorage(xemacpsif, 0);
+	for (index = index1; index < (index1 +
+			(xemacpsif->num_rxqueues * XLWIP_CONFIG_N_RX_DESC)); index++) {
 		p = (struct pbuf *)rx_pbufs_storage[index];
 		pbuf_free(p);
 
@@ -917,6 +1097,11 @@ void reset_dma(struct xemac_s *xemac)
 
 	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.RxBdRing.BaseBdAddr, 0, XEMACPS_RECV);
 	XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->emacps.TxBdRing.BaseBdAddr, txqueuenum, XEMACPS_SEND);
+
+	if (xemacpsif->num_rxqueues > 1) {
+		XEmacPs_BdRingPtrReset(&xemacpsif->rxq1_ring, xemacpsif->rxq1_bdspace);
+		XEmacPs_SetQueuePtr(&(xemacpsif->emacps), xemacpsif->rxq1_ring.BaseBdAddr, 1, XEMACPS_RECV);
+	}
 }
 
 void emac_disable_intr(void)
@@ -196,6 +196,13 @@ void start_emacps (xemacpsif_s *xemacps)
 {
 	/* start the temac */
 	XEmacPs_Start(&xemacps->emacps);
+
+	/* XEmacPs_Start only enables the queue 1 transmit interrupts */
+	if (xemacps->num_rxqueues > 1) {
+		XEmacPs_WriteReg(xemacps->emacps.Config.BaseAddress,
+				XEMACPS_INTQ1_IER_OFFSET,
+				XEMACPS_INTQ1SR_RXCOMPL_MASK);
+	}
 }
 
 void restart_emacps_transmitter (xemacpsif_s *xemacps) {
@@ -31,12 +31,24 @@
 #include <stdlib.h>
 
 #include "netif/xpqueue.h"
+#include "xlwipconfig.h"
 #include "xil_printf.h"
 
 #define NUM_QUEUES	2
 
 pq_queue_t pq_queue[NUM_QUEUES];
 
+/* the lock free queues are only reserved for multi-queue GEM receive, one
+ * per receive queue of up to two interfaces
+ */
+#if defined(XLWIP_CONFIG_EMACPS_NUM_RX_QUEUES) && (XLWIP_CONFIG_EMACPS_NUM_RX_QUEUES > 1)
+#define NUM_LF_QUEUES	(2 * XLWIP_CONFIG_EMACPS_NUM_RX_QUEUES)
+
+pq_lf_queue_t pq_lf_queue[NUM_LF_QUEUES];
+#else
+#define NUM_LF_QUEUES	0
+#endif
+
 pq_queue_t *
 pq_create_queue()
 {
@@ -91,3 +103,64 @@ pq_qlength(pq_queue_t *q)
 {
 	return q->len;
 }
+
+pq_lf_queue_t *
+pq_lf_create_queue()
+{
+	pq_lf_queue_t *q = NULL;
+#if NUM_LF_QUEUES > 0
+	static int i;
+
+	if (i >= NUM_LF_QUEUES) {
+		xil_printf("ERR: Max lock free Queues allocated\n\r");
+		return q;
+	}
+
+	q = &pq_lf_queue[i++];
+	q->head = q->tail = 0;
+#else
+	xil_printf("ERR: Lock free Queues not configured\n\r");
+#endif
+
+	return q;
+}
+
+int
+pq_lf_enqueue(pq_lf_queue_t *q, void *p)
+{
+	unsigned int head = q->head;
+
+	if (head - q->tail == PQ_LF_QUEUE_SIZE)
+		return -1;
+
+	q->data[head & (PQ_LF_QUEUE_SIZE - 1)] = p;
+	/* publish the entry before the new head */
+	__sync_synchronize();
+	q->head = head + 1;
+
+	return 0;
+}
+
+void*
+pq_lf_dequeue(pq_lf_queue_t *q)
+{
+	unsigned int tail = q->tail;
+	void *p;
+
+	if (q->head == tail)
+		return NULL;
+
+	/* read the entry only after observing the head that published it */
+	__sync_synchronize();
+	p = q->data[tail & (PQ_LF_QUEUE_SIZE - 1)];
+	__sync_synchronize();
+	q->tail = tail + 1;
+
+	return p;
+}
+
+int
+pq_lf_qlength(pq_lf_queue_t *q)
+{
+	return (int)(q->head - q->tail);
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2022 Xilinx, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Loopback rpmsg link shared by the benchmarks, see bench-common.h.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <metal/sys.h>
+#include "bench-common.h"
+
+struct bench_end bench_master, bench_remote;
+uint32_t bench_features;
+
+static struct metal_io_region shm_io;
+static void *shm;
+static metal_phys_addr_t shm_pa;	/* Physical map of shm_io */
+static unsigned int vring_descs;
+static uint8_t vdev_status;
+
+static uint8_t bench_get_status(struct virtio_device *vdev)
+{
+	(void)vdev;
+	return vdev_status;
+}
+
+static void bench_set_status(struct virtio_device *vdev, uint8_t status)
+{
+	(void)vdev;
+	vdev_status = status;
+}
+
+static uint32_t bench_get_features(struct virtio_device *vdev)
+{
+	(void)vdev;
+	/* No name service, the endpoints are bound by address */
+	return bench_features;
+}
+
+static void bench_notify(struct virtqueue *vq)
+{
+	struct bench_end *end = metal_container_of(vq->vq_dev,
+						   struct bench_end, vdev);
+
+	/* Both ends use the same vring index for the same ring */
+	end->peer->pending[vq->vq_queue_index] = 1;
+	end->notified++;
+}
+
+static const struct virtio_dispatch bench_dispatch = {
+	.get_status = bench_get_status,
+	.set_status = bench_set_status,
+	.get_features = bench_get_features,
+	.notify = bench_notify,
+};
+
+void bench_pump(void)
+{
+	struct bench_end *ends[2] = { &bench_master, &bench_remote };
+	int busy = 1;
+	int e, i;
+
+	while (busy) {
+		busy = 0;
+		for (e = 0; e < 2; e++) {
+			for (i = 0; i < BENCH_NUM_VRINGS; i++) {
+				if (!ends[e]->pending[i])
+					continue;
+				ends[e]->pending[i] = 0;
+				busy = 1;
+				virtqueue_notification(ends[e]->vrings[i].vq);
+			}
+		}
+	}
+}
+
+/* Size of a vring, rounded up to keep the next one aligned */
+static size_t bench_vring_size(void)
+{
+	size_t size = vring_size(vring_descs, BENCH_VRING_ALIGN);
+
+	return (size + BENCH_VRING_ALIGN - 1) & ~(size_t)(BENCH_VRING_ALIGN - 1);
+}
+
+static int bench_init_end(struct bench_end *end, unsigned int role,
+			  struct rpmsg_virtio_shm_pool *shpool)
+{
+	unsigned int i;
+
+	end->vdev.role = role;
+	end->vdev.func = &bench_dispatch;
+	end->vdev.vrings_num = BENCH_NUM_VRINGS;
+	end->vdev.vrings_info = end->vrings;
+	for (i = 0; i < BENCH_NUM_VRINGS; i++) {
+		end->vrings[i].vq = virtqueue_allocate(vring_descs);
+		if (!end->vrings[i].vq)
+			return -1;
+		end->vrings[i].info.vaddr = (char *)shm +
+			i * bench_vring_size();
+		end->vrings[i].info.align = BENCH_VRING_ALIGN;
+		end->vrings[i].info.num_descs = vring_descs;
+		end->vrings[i].io = &shm_io;
+	}
+
+	return rpmsg_init_vdev(&end->rvdev, &end->vdev, NULL, &shm_io,
+			       role == RPMSG_MASTER ? shpool : NULL);
+}
+
+int bench_init(unsigned int num_descs, size_t pool_size, void **pool)
+{
+	struct metal_init_params init_param = METAL_INIT_DEFAULTS;
+	size_t vrings_size, shm_size;
+	int ret;
+
+	ret = metal_init(&init_param);
+	if (ret) {
+		fprintf(stderr, "failed to initialize libmetal: %d\n", ret);
+		return ret;
+	}
+
+	/* Shared memory: the two vrings then the buffer pool */
+	vring_descs = num_descs;
+	vrings_size = BENCH_NUM_VRINGS * bench_vring_size();
+	shm_size = vrings_size + pool_size;
+	shm = aligned_alloc(BENCH_VRING_ALIGN, shm_size);
+	if (!shm) {
+		metal_finish();
+		return -1;
+	}
+	memset(shm, 0, shm_size);
+	shm_pa = (metal_phys_addr_t)(uintptr_t)shm;
+	metal_io_init(&shm_io, shm, &shm_pa, shm_size, (unsigned int)(-1), 0,
+		      NULL);
+	*pool = (char *)shm + vrings_size;
+
+	return 0;
+}
+
+int bench_connect(struct rpmsg_virtio_shm_pool *shpool)
+{
+	int ret;
+
+	bench_master.peer = &bench_remote;
+	bench_remote.peer = &bench_master;
+	/* The master first, the remote waits for its DRIVER_OK status */
+	ret = bench_init_end(&bench_master, RPMSG_MASTER, shpool);
+	if (!ret)
+		ret = bench_init_end(&bench_remote, RPMSG_REMOTE, shpool);
+	if (ret)
+		fprintf(stderr, "failed to initialize the rpmsg devices: %d\n",
+			ret);
+
+	return ret;
+}
+
+double bench_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+void bench_finish(void)
+{
+	metal_finish();
+	free(shm);
+	shm = NULL;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2022 Xilinx, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Loopback rpmsg link shared by the benchmarks.
+ *
+ * Both ends of an rpmsg virtio link run in one process on the libmetal
+ * Linux system layer: the master and the remote share the vrings and the
+ * buffers in one memory block, and the notifications of each side are
+ * delivered to the other one by a polling loop (bench_pump).
+ */
+
+#ifndef BENCH_COMMON_H_
+#define BENCH_COMMON_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <metal/io.h>
+#include <openamp/rpmsg_virtio.h>
+#include <openamp/virtqueue.h>
+
+#define BENCH_NUM_VRINGS	2
+#define BENCH_VRING_ALIGN	4096
+
+/* One end of the link */
+struct bench_end {
+	struct virtio_device vdev;
+	struct virtio_vring_info vrings[BENCH_NUM_VRINGS];
+	struct rpmsg_virtio_device rvdev;
+	struct bench_end *peer;
+	int pending[BENCH_NUM_VRINGS];	/* Notifications to deliver */
+	unsigned long notified;		/* Notifications raised */
+};
+
+extern struct bench_end bench_master, bench_remote;
+
+/* Virtio features offered by both ends, none by default */
+extern uint32_t bench_features;
+
+/**
+ * bench_init - initialize libmetal and the shared memory of the link
+ *
+ * @num_descs: number of descriptors of each vring
+ * @pool_size: size of the buffer pool, placed after the vrings
+ * @pool: returns the address of the buffer pool
+ *
+ * Return: 0 on success, or a negative error code.
+ */
+int bench_init(unsigned int num_descs, size_t pool_size, void **pool);
+
+/**
+ * bench_connect - initialize both rpmsg devices of the link
+ *
+ * @shpool: buffer pool of the master, set up by the caller in the area
+ *	    returned by bench_init
+ *
+ * Return: 0 on success, or a negative error code.
+ */
+int bench_connect(struct rpmsg_virtio_shm_pool *shpool);
+
+/* Delivers the notifications until both ends are idle */
+void bench_pump(void);
+
+/* Monotonic time in seconds */
+double bench_now(void);
+
+/* Releases the shared memory and libmetal */
+void bench_finish(void);
+
+#endif /* BENCH_COMMON_H_ */
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2022 Xilinx, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * rpmsg batched send benchmark.
+ *
+ * Both ends of an rpmsg virtio link run in this process, on the loopback
+ * link of bench-common.c. The master streams small messages to the remote,
+ * one by one (rpmsg_trysend) or in batches (rpmsg_trysend_batch), and counts
+ * the notifications each side raises, which stand for the inter-processor
+ * interrupts of a real link. The VIRTIO_RING_F_EVENT_IDX feature can be
+ * offered to compare the event index with the ring flags for suppressing
+ * notifications.
+ *
+ * Usage: rpmsg-batch-bench [messages] [batch] [event index 0/1] [size]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench-common.h"
+
+#define BENCH_NUM_DESCS		256
+#define BENCH_POOL_SIZE		(2 * BENCH_NUM_DESCS * RPMSG_BUFFER_SIZE)
+#define BENCH_MAX_BATCH		BENCH_NUM_DESCS
+/* Payload of a default buffer, after the 16 bytes rpmsg header */
+#define BENCH_MAX_SIZE		(RPMSG_BUFFER_SIZE - 16)
+
+#define BENCH_DEF_MSGS		(4 * 1024 * 1024)
+#define BENCH_DEF_BATCH		16
+#define BENCH_DEF_SIZE		64
+
+static struct rpmsg_virtio_shm_pool shpool;
+static struct rpmsg_endpoint master_ept, remote_ept;
+
+/* Messages received by the remote, in sequence unless rx_errors */
+static unsigned long rx_msgs, rx_errors;
+
+static int bench_remote_cb(struct rpmsg_endpoint *ept, void *data,
+			   size_t len, uint32_t src, void *priv)
+{
+	(void)ept;
+	(void)src;
+	(void)priv;
+	if (len < sizeof(uint32_t) || *(uint32_t *)data != (uint32_t)rx_msgs)
+		rx_errors++;
+	rx_msgs++;
+	return RPMSG_SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+	static unsigned char payloads[BENCH_MAX_BATCH][BENCH_MAX_SIZE];
+	struct rpmsg_msg msgs[BENCH_MAX_BATCH];
+	unsigned long total = BENCH_DEF_MSGS;
+	unsigned long batch = BENCH_DEF_BATCH;
+	unsigned long size = BENCH_DEF_SIZE;
+	unsigned long sent = 0;
+	double start, elapsed;
+	unsigned long i, num;
+	void *pool;
+	int ret;
+
+	if (argc > 1)
+		total = strtoul(argv[1], NULL, 0);
+	if (argc > 2)
+		batch = strtoul(argv[2], NULL, 0);
+	if (argc > 3 && strtoul(argv[3], NULL, 0))
+		bench_features = VIRTIO_RING_F_EVENT_IDX;
+	if (argc > 4)
+		size = strtoul(argv[4], NULL, 0);
+	if (!total || !batch || batch > BENCH_MAX_BATCH ||
+	    size < sizeof(uint32_t) || size > BENCH_MAX_SIZE) {
+		fprintf(stderr, "messages > 0, batch 1-%d, size 4-%d\n",
+			BENCH_MAX_BATCH, BENCH_MAX_SIZE);
+		return -1;
+	}
+
+	ret = bench_init(BENCH_NUM_DESCS, BENCH_POOL_SIZE, &pool);
+	if (ret)
+		return ret;
+	rpmsg_virtio_init_shm_pool(&shpool, pool, BENCH_POOL_SIZE);
+	ret = bench_connect(&shpool);
+	if (ret)
+		goto out;
+	ret = rpmsg_create_ept(&remote_ept, &bench_remote.rvdev.rdev,
+			       "bench", RPMSG_ADDR_ANY, RPMSG_ADDR_ANY,
+			       bench_remote_cb, NULL);
+	if (!ret)
+		ret = rpmsg_create_ept(&master_ept, &bench_master.rvdev.rdev,
+				       "bench", RPMSG_ADDR_ANY,
+				       remote_ept.addr, NULL, NULL);
+	if (ret) {
+		fprintf(stderr, "failed to create the endpoints: %d\n", ret);
+		goto out;
+	}
+	bench_master.notified = 0;
+	bench_remote.notified = 0;
+
+	for (i = 0; i < batch; i++) {
+		msgs[i].data = payloads[i];
+		msgs[i].len = size;
+	}
+
+	start = bench_now();
+	while (sent < total) {
+		num = total - sent < batch ? total - sent : batch;
+		/* The sequence number of each message */
+		for (i = 0; i < num; i++)
+			*(uint32_t *)payloads[i] = (uint32_t)(sent + i);
+
+		if (batch == 1)
+			ret = rpmsg_trysend(&master_ept, payloads[0], size);
+		else
+			ret = rpmsg_trysend_batch(&master_ept, msgs, num);
+		if (ret == RPMSG_ERR_NO_BUFF) {
+			/* All the buffers are in flight, let them drain */
+			bench_pump();
+			continue;
+		}
+		if (ret < 0) {
+			fprintf(stderr, "send failed: %d\n", ret);
+			goto out;
+		}
+		sent += batch == 1 ? 1 : (unsigned long)ret;
+	}
+	bench_pump();
+	elapsed = bench_now() - start;
+	ret = 0;
+
+	printf("%lu messages of %lu bytes, batch %lu, %s: %.2f Mmsg/s\n",
+	       sent, size, batch, bench_features ? "event index" : "ring flags",
+	       sent / elapsed / 1e6);
+	printf("notifications: master %lu (%.4f/msg), remote %lu (%.4f/msg)\n",
+	       bench_master.notified, (double)bench_master.notified / sent,
+	       bench_remote.notified, (double)bench_remote.notified / sent);
+	if (rx_msgs != sent || rx_errors) {
+		fprintf(stderr, "received %lu messages, %lu out of sequence\n",
+			rx_msgs, rx_errors);
+		ret = -1;
+	}
+
+out:
+	bench_finish();
+	return ret;
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2022 Xilinx, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * rpmsg ping-pong benchmark.
+ *
+ * Both ends of an rpmsg virtio link run in this process, on the loopback
+ * link of bench-common.c. The master sends bursts of small messages round
+ * robin to many endpoints of the remote, which echoes each message back to
+ * its source endpoint. The message rate measures the cost of the rpmsg
+ * receive path: buffer handling, endpoint lookup and locking.
+ *
+ * Usage: rpmsg-ping-bench [endpoints] [rounds] [burst] [size]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench-common.h"
+
+#define BENCH_NUM_DESCS		256
+#define BENCH_POOL_SIZE		(2 * BENCH_NUM_DESCS * RPMSG_BUFFER_SIZE)
+
+#define BENCH_DEF_EPTS		RPMSG_ADDR_BMP_SIZE
+#define BENCH_DEF_ROUNDS	20000
+#define BENCH_DEF_BURST		64
+#define BENCH_DEF_SIZE		16
+
+static struct rpmsg_virtio_shm_pool shpool;
+static struct rpmsg_endpoint *master_epts, *remote_epts;
+static unsigned long master_rx, remote_rx;
+
+static int bench_master_cb(struct rpmsg_endpoint *ept, void *data,
+			   size_t len, uint32_t src, void *priv)
+{
+	(void)ept;
+	(void)data;
+	(void)len;
+	(void)src;
+	(void)priv;
+	master_rx++;
+	return RPMSG_SUCCESS;
+}
+
+static int bench_remote_cb(struct rpmsg_endpoint *ept, void *data,
+			   size_t len, uint32_t src, void *priv)
+{
+	(void)priv;
+	remote_rx++;
+	/* Echo back to the source endpoint */
+	if (rpmsg_trysend_offchannel(ept, ept->addr, src, data, len) < 0)
+		return RPMSG_ERR_NO_BUFF;
+	return RPMSG_SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long num_epts = BENCH_DEF_EPTS;
+	unsigned long rounds = BENCH_DEF_ROUNDS;
+	unsigned long burst = BENCH_DEF_BURST;
+	unsigned long size = BENCH_DEF_SIZE;
+	unsigned long r, i, sent = 0;
+	char msg[RPMSG_BUFFER_SIZE];
+	double start, elapsed;
+	void *pool;
+	int ret;
+
+	if (argc > 1)
+		num_epts = strtoul(argv[1], NULL, 0);
+	if (argc > 2)
+		rounds = strtoul(argv[2], NULL, 0);
+	if (argc > 3)
+		burst = strtoul(argv[3], NULL, 0);
+	if (argc > 4)
+		size = strtoul(argv[4], NULL, 0);
+	if (!num_epts || num_epts > RPMSG_ADDR_BMP_SIZE ||
+	    !burst || burst > BENCH_NUM_DESCS ||
+	    !size || size > RPMSG_BUFFER_SIZE - 16) {
+		fprintf(stderr, "endpoints 1-%d, burst 1-%d, size 1-%d\n",
+			RPMSG_ADDR_BMP_SIZE, BENCH_NUM_DESCS,
+			RPMSG_BUFFER_SIZE - 16);
+		return -1;
+	}
+
+	ret = bench_init(BENCH_NUM_DESCS, BENCH_POOL_SIZE, &pool);
+	if (ret)
+		return ret;
+	rpmsg_virtio_init_shm_pool(&shpool, pool, BENCH_POOL_SIZE);
+	ret = bench_connect(&shpool);
+	if (ret)
+		goto out;
+
+	master_epts = calloc(num_epts, sizeof(*master_epts));
+	remote_epts = calloc(num_epts, sizeof(*remote_epts));
+	if (!master_epts || !remote_epts) {
+		ret = -1;
+		goto out;
+	}
+	for (i = 0; i < num_epts && !ret; i++) {
+		ret = rpmsg_create_ept(&remote_epts[i],
+				       &bench_remote.rvdev.rdev, "bench",
+				       RPMSG_ADDR_ANY, RPMSG_ADDR_ANY,
+				       bench_remote_cb, NULL);
+		if (!ret)
+			ret = rpmsg_create_ept(&master_epts[i],
+					       &bench_master.rvdev.rdev, "bench",
+					       RPMSG_ADDR_ANY,
+					       remote_epts[i].addr,
+					       bench_master_cb, NULL);
+	}
+	if (ret) {
+		fprintf(stderr, "failed to create endpoint %lu: %d\n", i, ret);
+		goto out;
+	}
+
+	memset(msg, 0xa5, sizeof(msg));
+	start = bench_now();
+	for (r = 0; r < rounds; r++) {
+		for (i = 0; i < burst; i++) {
+			ret = rpmsg_trysend(&master_epts[sent % num_epts],
+					    msg, size);
+			if (ret < 0) {
+				fprintf(stderr, "send failed: %d\n", ret);
+				goto out;
+			}
+			sent++;
+		}
+		bench_pump();
+	}
+	elapsed = bench_now() - start;
+	ret = 0;
+
+	printf("endpoints %lu, burst %lu, size %lu, rx batch %d\n",
+	       num_epts, burst, size, RPMSG_RX_BATCH);
+	printf("sent %lu, echoed %lu, received %lu in %.3f s\n",
+	       sent, remote_rx, master_rx, elapsed);
+	printf("%.0f round trips/s, %.1f ns per message\n",
+	       master_rx / elapsed,
+	       elapsed * 1e9 / (remote_rx + master_rx));
+	if (master_rx != sent) {
+		fprintf(stderr, "lost %lu messages\n",
+			sent - master_rx);
+		ret = -1;
+	}
+
+out:
+	bench_finish();
+	return ret;
+}
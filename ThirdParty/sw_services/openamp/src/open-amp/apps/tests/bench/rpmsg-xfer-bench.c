@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2022 Xilinx, Inc. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * rpmsg zero-copy transfer benchmark.
+ *
+ * Both ends of an rpmsg virtio link run in this process, on the loopback
+ * link of bench-common.c. The master streams sample data to the remote in
+ * messages of random sizes, each one written in place into a tx buffer
+ * sized for it (rpmsg_get_sized_tx_payload_buffer), and the remote checks
+ * the data. The shared memory pool has buffer size classes and
+ * is much smaller than the data sent, so the transfer only completes if the
+ * buffers are recycled. The pool statistics are printed at the end.
+ *
+ * Usage: rpmsg-xfer-bench [megabytes] [max message size]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench-common.h"
+
+#define BENCH_NUM_DESCS		64
+#define BENCH_POOL_SIZE		(2 * 1024 * 1024)
+
+#define BENCH_DEF_MBYTES	1024
+/* Largest payload, the largest class minus the 16 byte rpmsg header */
+#define BENCH_MAX_SIZE		(64 * 1024 - 16)
+
+/* Buffer sizes of the pool classes, rpmsg header included */
+static const size_t bench_classes[] = {
+	RPMSG_BUFFER_SIZE, 4 * 1024, 16 * 1024, 64 * 1024,
+};
+
+static struct rpmsg_virtio_shm_pool shpool;
+static struct rpmsg_endpoint master_ept, remote_ept;
+
+/* Stream position of the remote and number of corrupted messages */
+static unsigned long long rx_bytes;
+static unsigned long rx_msgs, rx_errors;
+
+/* Sample data: each 32-bit word holds its byte offset in the stream */
+static void bench_fill(uint32_t *data, unsigned long long pos, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len / sizeof(*data); i++)
+		data[i] = (uint32_t)(pos + i * sizeof(*data));
+}
+
+static int bench_remote_cb(struct rpmsg_endpoint *ept, void *data,
+			   size_t len, uint32_t src, void *priv)
+{
+	const uint32_t *words = data;
+	size_t i;
+
+	(void)ept;
+	(void)src;
+	(void)priv;
+	for (i = 0; i < len / sizeof(*words); i++) {
+		if (words[i] != (uint32_t)(rx_bytes + i * sizeof(*words))) {
+			rx_errors++;
+			break;
+		}
+	}
+	rx_bytes += len;
+	rx_msgs++;
+	return RPMSG_SUCCESS;
+}
+
+static void bench_print_stats(void)
+{
+	struct rpmsg_virtio_shm_pool_stats stats;
+	unsigned int i;
+
+	if (rpmsg_virtio_get_shm_pool_stats(&bench_master.rvdev, &stats))
+		return;
+	printf("pool %zu bytes, %zu never carved, %zu in use, high-water mark %zu\n",
+	       stats.size, stats.avail, stats.used, stats.max_used);
+	for (i = 0; i < stats.num_classes; i++)
+		printf("  class %6zu: %4u buffers, %4u in use, max %4u, %u fails\n",
+		       stats.classes[i].size, stats.classes[i].num_bufs,
+		       stats.classes[i].num_used, stats.classes[i].max_used,
+		       stats.classes[i].num_fails);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long long total = BENCH_DEF_MBYTES;
+	unsigned long max_size = BENCH_MAX_SIZE;
+	unsigned long long pos = 0;
+	unsigned long sent = 0;
+	double start, elapsed;
+	uint32_t size, len;
+	void *pool, *buffer;
+	int ret;
+
+	if (argc > 1)
+		total = strtoull(argv[1], NULL, 0);
+	if (argc > 2)
+		max_size = strtoul(argv[2], NULL, 0);
+	if (!total || max_size < sizeof(uint32_t) ||
+	    max_size > BENCH_MAX_SIZE) {
+		fprintf(stderr, "megabytes > 0, max message size 4-%d\n",
+			BENCH_MAX_SIZE);
+		return -1;
+	}
+	total *= 1024 * 1024;
+
+	ret = bench_init(BENCH_NUM_DESCS, BENCH_POOL_SIZE, &pool);
+	if (ret)
+		return ret;
+	ret = rpmsg_virtio_init_shm_pool_classes(&shpool, pool,
+						 BENCH_POOL_SIZE,
+						 bench_classes,
+						 sizeof(bench_classes) /
+						 sizeof(bench_classes[0]));
+	if (ret) {
+		fprintf(stderr, "failed to initialize the pool: %d\n", ret);
+		goto out;
+	}
+	ret = bench_connect(&shpool);
+	if (ret)
+		goto out;
+	ret = rpmsg_create_ept(&remote_ept, &bench_remote.rvdev.rdev,
+			       "bench", RPMSG_ADDR_ANY, RPMSG_ADDR_ANY,
+			       bench_remote_cb, NULL);
+	if (!ret)
+		ret = rpmsg_create_ept(&master_ept, &bench_master.rvdev.rdev,
+				       "bench", RPMSG_ADDR_ANY,
+				       remote_ept.addr, NULL, NULL);
+	if (ret) {
+		fprintf(stderr, "failed to create the endpoints: %d\n", ret);
+		goto out;
+	}
+
+	srand(1);
+	start = bench_now();
+	while (pos < total) {
+		/* Random word multiple sizes, most of them small */
+		size = (uint32_t)(rand() % max_size) >> (rand() % 8);
+		size &= ~(uint32_t)(sizeof(uint32_t) - 1);
+		if (!size)
+			size = sizeof(uint32_t);
+		if (size > total - pos)
+			size = total - pos;
+
+		buffer = rpmsg_get_sized_tx_payload_buffer(&master_ept, size,
+							   &len, 0);
+		if (!buffer) {
+			/* All the descriptors are in flight, let them drain */
+			bench_pump();
+			continue;
+		}
+		bench_fill(buffer, pos, size);
+		ret = rpmsg_send_nocopy(&master_ept, buffer, size);
+		if (ret < 0) {
+			fprintf(stderr, "send failed: %d\n", ret);
+			goto out;
+		}
+		pos += size;
+		sent++;
+	}
+	bench_pump();
+	elapsed = bench_now() - start;
+	ret = 0;
+
+	printf("sent %lu messages, %llu bytes in %.3f s, %.1f MB/s\n",
+	       sent, pos, elapsed, pos / elapsed / (1024 * 1024));
+	bench_print_stats();
+	if (rx_msgs != sent || rx_bytes != pos || rx_errors) {
+		fprintf(stderr, "received %lu messages, %llu bytes, %lu bad\n",
+			rx_msgs, rx_bytes, rx_errors);
+		ret = -1;
+	}
+
+out:
+	bench_finish();
+	return ret;
+}
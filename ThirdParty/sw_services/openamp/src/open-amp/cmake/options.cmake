@@ -100,5 +100,15 @@ if (DEFINED RPMSG_BUFFER_SIZE)
   add_definitions( -DRPMSG_BUFFER_SIZE=${RPMSG_BUFFER_SIZE} )
 endif (DEFINED RPMSG_BUFFER_SIZE)
 
+# Number of allocatable endpoint addresses, it sizes struct rpmsg_device
+# so the applications must be built with the same value
+if (DEFINED RPMSG_ADDR_BMP_SIZE)
+  add_definitions( -DRPMSG_ADDR_BMP_SIZE=${RPMSG_ADDR_BMP_SIZE} )
+endif (DEFINED RPMSG_ADDR_BMP_SIZE)
+
+if (DEFINED RPMSG_RX_BATCH)
+  add_definitions( -DRPMSG_RX_BATCH=${RPMSG_RX_BATCH} )
+endif (DEFINED RPMSG_RX_BATCH)
+
 message ("-- C_FLAGS : ${CMAKE_C_FLAGS}")
 # vim: expandtab:ts=2:sw=2:smartindent
@@ -26,7 +26,9 @@ extern "C" {
 
 /* Configurable parameters */
 #define RPMSG_NAME_SIZE			(32)
+#ifndef RPMSG_ADDR_BMP_SIZE
 #define RPMSG_ADDR_BMP_SIZE		(128)
+#endif
 
 #define RPMSG_NS_EPT_ADDR		(0x35)
 #define RPMSG_RESERVED_ADDRESSES	(1024)
@@ -80,6 +82,16 @@ struct rpmsg_endpoint {
 	void *priv;
 };
 
+/**
+ * struct rpmsg_msg - message of a batch, see rpmsg_send_batch()
+ * @data: payload of the message
+ * @len: length of the payload
+ */
+struct rpmsg_msg {
+	const void *data;
+	int len;
+};
+
 /**
  * struct rpmsg_device_ops - RPMsg device operations
  * @send_offchannel_raw: send RPMsg data
@@ -87,6 +99,8 @@ struct rpmsg_endpoint {
  * @release_rx_buffer: release RPMsg RX buffer
  * @get_tx_payload_buffer: get RPMsg TX buffer
  * @send_offchannel_nocopy: send RPMsg data without copy
+ * @get_sized_tx_payload_buffer: get RPMsg TX buffer for a payload size
+ * @send_offchannel_batch: send several RPMsg messages at once
  */
 struct rpmsg_device_ops {
 	int (*send_offchannel_raw)(struct rpmsg_device *rdev,
@@ -99,6 +113,13 @@ struct rpmsg_device_ops {
 	int (*send_offchannel_nocopy)(struct rpmsg_device *rdev,
 				      uint32_t src, uint32_t dst,
 				       const void *data, int len);
+	void *(*get_sized_tx_payload_buffer)(struct rpmsg_device *rdev,
+					     uint32_t size, uint32_t *len,
+					     int wait);
+	int (*send_offchannel_batch)(struct rpmsg_device *rdev,
+				     uint32_t src, uint32_t dst,
+				     const struct rpmsg_msg *msgs, int num,
+				     int wait);
 };
 
 /**
@@ -106,6 +127,9 @@ struct rpmsg_device_ops {
  * @endpoints: list of endpoints
  * @ns_ept: name service endpoint
  * @bitmap: table endpoint address allocation.
+ * @ept_table: endpoints of the allocatable addresses, indexed by address
+ *             minus RPMSG_RESERVED_ADDRESSES
+ * @ept_gen: incremented each time an endpoint is unregistered
  * @lock: mutex lock for rpmsg management
  * @ns_bind_cb: callback handler for name service announcement without local
  *              endpoints waiting to bind.
@@ -116,6 +140,8 @@ struct rpmsg_device {
 	struct metal_list endpoints;
 	struct rpmsg_endpoint ns_ept;
 	unsigned long bitmap[metal_bitmap_longs(RPMSG_ADDR_BMP_SIZE)];
+	struct rpmsg_endpoint *ept_table[RPMSG_ADDR_BMP_SIZE];
+	unsigned int ept_gen;
 	metal_mutex_t lock;
 	rpmsg_ns_bind_cb ns_bind_cb;
 	struct rpmsg_device_ops ops;
@@ -230,6 +256,70 @@ static inline int rpmsg_trysend(struct rpmsg_endpoint *ept, const void *data,
 					 len, false);
 }
 
+/**
+ * rpmsg_send_offchannel_batch() - send several messages across to the remote
+ * processor, specifying source and destination address.
+ * @ept: the rpmsg endpoint
+ * @src: source address of the messages
+ * @dst: destination address of the messages
+ * @msgs: messages to send
+ * @num: number of messages
+ * @wait: boolean, wait or not for tx buffers to become available
+ *
+ * This function sends the @num messages of @msgs in order to the remote @dst
+ * address from the source @src address, as rpmsg_send_offchannel_raw() would
+ * for each of them. The device publishes the messages together and notifies
+ * the remote processor at most once for all of them, instead of once per
+ * message. Messages longer than a tx buffer are truncated.
+ *
+ * Returns number of messages it has sent, which is less than @num when the
+ * tx buffers run out and @wait is false, or negative error value when no
+ * message is sent.
+ */
+int rpmsg_send_offchannel_batch(struct rpmsg_endpoint *ept, uint32_t src,
+				uint32_t dst, const struct rpmsg_msg *msgs,
+				int num, int wait);
+
+/**
+ * rpmsg_send_batch() - send several messages across to the remote processor
+ * @ept: the rpmsg endpoint
+ * @msgs: messages to send
+ * @num: number of messages
+ *
+ * This function sends the @num messages of @msgs on the @ept channel, using
+ * @ept's source and destination addresses, with at most one notification of
+ * the remote processor. In case there are no TX buffers available, the
+ * function will block until one becomes available, or a timeout of 15
+ * seconds elapses.
+ *
+ * Returns number of messages it has sent or negative error value on failure.
+ */
+static inline int rpmsg_send_batch(struct rpmsg_endpoint *ept,
+				   const struct rpmsg_msg *msgs, int num)
+{
+	return rpmsg_send_offchannel_batch(ept, ept->addr, ept->dest_addr,
+					   msgs, num, true);
+}
+
+/**
+ * rpmsg_trysend_batch() - send several messages across to the remote
+ * processor
+ * @ept: the rpmsg endpoint
+ * @msgs: messages to send
+ * @num: number of messages
+ *
+ * Same as rpmsg_send_batch(), except that the function stops at the first
+ * message without an available TX buffer instead of waiting for one.
+ *
+ * Returns number of messages it has sent or negative error value on failure.
+ */
+static inline int rpmsg_trysend_batch(struct rpmsg_endpoint *ept,
+				      const struct rpmsg_msg *msgs, int num)
+{
+	return rpmsg_send_offchannel_batch(ept, ept->addr, ept->dest_addr,
+					   msgs, num, false);
+}
+
 /**
  * rpmsg_trysendto() - send a message across to the remote processor,
  * specify dst
@@ -331,6 +421,29 @@ void rpmsg_release_rx_buffer(struct rpmsg_endpoint *ept, void *rxbuf);
 void *rpmsg_get_tx_payload_buffer(struct rpmsg_endpoint *ept,
 				  uint32_t *len, int wait);
 
+/**
+ * @brief Gets a tx buffer that can hold a payload of a given size.
+ *
+ * Same as rpmsg_get_tx_payload_buffer(), except that the returned buffer
+ * holds at least size bytes of payload. When the device manages buffers of
+ * several sizes (see rpmsg_virtio_init_shm_pool_classes()), the smallest
+ * buffer that fits is returned, which allows zero-copy transfers of payloads
+ * larger than the default buffer. Otherwise the call fails when the next tx
+ * buffer is too small.
+ *
+ * @ept:  Pointer to rpmsg endpoint
+ * @size: Payload size
+ * @len:  Pointer to store tx buffer size
+ * @wait: Boolean, wait or not for buffer to become available
+ *
+ * @return The tx buffer address on success and NULL on failure
+ *
+ * @see rpmsg_get_tx_payload_buffer
+ */
+void *rpmsg_get_sized_tx_payload_buffer(struct rpmsg_endpoint *ept,
+					uint32_t size, uint32_t *len,
+					int wait);
+
 /**
  * rpmsg_send_offchannel_nocopy() - send a message in tx buffer reserved by
  * rpmsg_get_tx_payload_buffer() across to the remote processor.
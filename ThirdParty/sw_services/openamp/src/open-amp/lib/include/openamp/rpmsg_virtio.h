@@ -26,19 +26,83 @@ extern "C" {
 #define RPMSG_BUFFER_SIZE	(512)
 #endif
 
+/* Maximum number of received buffers drained under one lock */
+#ifndef RPMSG_RX_BATCH
+#define RPMSG_RX_BATCH		(16)
+#endif
+
+/* Maximum number of buffer size classes of a shared memory pool */
+#ifndef RPMSG_SHM_POOL_MAX_CLASSES
+#define RPMSG_SHM_POOL_MAX_CLASSES	(4)
+#endif
+
 /* The feature bitmap for virtio rpmsg */
 #define VIRTIO_RPMSG_F_NS	0 /* RP supports name service notifications */
 
+/**
+ * struct rpmsg_virtio_shm_class_stats - statistics of a buffer size class
+ * @size: size of the buffers of the class, rpmsg header included
+ * @num_bufs: number of buffers carved from the pool for the class
+ * @num_used: number of buffers in use
+ * @max_used: high-water mark of num_used
+ * @num_fails: number of allocations the class could not serve
+ */
+struct rpmsg_virtio_shm_class_stats {
+	size_t size;
+	unsigned int num_bufs;
+	unsigned int num_used;
+	unsigned int max_used;
+	unsigned int num_fails;
+};
+
+/**
+ * struct rpmsg_virtio_shm_class - buffer size class of a shared memory pool
+ * @stats: size and statistics of the class
+ * @free_list: first free buffer, each free buffer starts with a pointer to
+ *             the next one
+ */
+struct rpmsg_virtio_shm_class {
+	struct rpmsg_virtio_shm_class_stats stats;
+	void *free_list;
+};
+
 /**
  * struct rpmsg_virtio_shm_pool - shared memory pool used for rpmsg buffers
  * @base: base address of the memory pool
  * @avail: available memory size
  * @size: total pool size
+ * @used: size of the buffers in use
+ * @max_used: high-water mark of used
+ * @num_classes: number of buffer size classes, 0 for a pool of fixed size
+ *               buffers that are never freed
+ * @classes: buffer size classes, sorted by increasing size
  */
 struct rpmsg_virtio_shm_pool {
 	void *base;
 	size_t avail;
 	size_t size;
+	size_t used;
+	size_t max_used;
+	unsigned int num_classes;
+	struct rpmsg_virtio_shm_class classes[RPMSG_SHM_POOL_MAX_CLASSES];
+};
+
+/**
+ * struct rpmsg_virtio_shm_pool_stats - statistics of a shared memory pool
+ * @size: total pool size
+ * @avail: size of the memory not carved into buffers yet
+ * @used: size of the buffers in use
+ * @max_used: high-water mark of used
+ * @num_classes: number of buffer size classes
+ * @classes: statistics of each buffer size class
+ */
+struct rpmsg_virtio_shm_pool_stats {
+	size_t size;
+	size_t avail;
+	size_t used;
+	size_t max_used;
+	unsigned int num_classes;
+	struct rpmsg_virtio_shm_class_stats classes[RPMSG_SHM_POOL_MAX_CLASSES];
 };
 
 /**
@@ -167,6 +231,49 @@ void rpmsg_deinit_vdev(struct rpmsg_virtio_device *rvdev);
 void rpmsg_virtio_init_shm_pool(struct rpmsg_virtio_shm_pool *shpool,
 				void *shbuf, size_t size);
 
+/**
+ * rpmsg_virtio_init_shm_pool_classes - initialize a shared buffers pool with
+ * buffer size classes
+ *
+ * Same as rpmsg_virtio_init_shm_pool, except that the pool hands out buffers
+ * of several sizes and takes them back once the remote has consumed them:
+ * the master allocates each TX buffer from the smallest class that fits the
+ * message and recycles the buffers through a free list per class. The
+ * buffers are carved from the pool on first use, a class that cannot carve a
+ * new buffer borrows one from a larger class.
+ *
+ * @param shpool - pointer to the shared buffers pool structure
+ * @param shbuf - pointer to the beginning of shared buffers
+ * @param size - shared buffers total size
+ * @param sizes - buffer sizes of the classes, rpmsg header included, in
+ *                increasing order. One of them must be at least
+ *                RPMSG_BUFFER_SIZE, which is the size of the RX buffers.
+ *                The payload of a buffer, its size minus the rpmsg header,
+ *                is at most UINT16_MAX, the limit of the header length.
+ * @param num_sizes - number of classes, at most RPMSG_SHM_POOL_MAX_CLASSES
+ *
+ * @return - RPMSG_SUCCESS on success, RPMSG_ERR_PARAM for invalid classes
+ */
+int rpmsg_virtio_init_shm_pool_classes(struct rpmsg_virtio_shm_pool *shpool,
+				       void *shbuf, size_t size,
+				       const size_t *sizes,
+				       unsigned int num_sizes);
+
+/**
+ * rpmsg_virtio_get_shm_pool_stats - get the shared buffers pool statistics
+ *
+ * Buffers consumed by the remote are counted as used until the next TX
+ * buffer request of the master recycles them.
+ *
+ * @param rvdev - pointer to the rpmsg virtio device, master side
+ * @param stats - pointer to the statistics to fill
+ *
+ * @return - RPMSG_SUCCESS on success, RPMSG_ERR_PARAM if the device has no
+ *           shared buffers pool
+ */
+int rpmsg_virtio_get_shm_pool_stats(struct rpmsg_virtio_device *rvdev,
+				    struct rpmsg_virtio_shm_pool_stats *stats);
+
 /**
  * rpmsg_virtio_get_rpmsg_device - get RPMsg device from RPMsg virtio device
  *
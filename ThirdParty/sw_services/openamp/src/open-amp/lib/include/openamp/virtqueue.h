@@ -88,6 +88,13 @@ struct virtqueue {
 	 */
 	uint16_t vq_available_idx;
 
+	/*
+	 * Number of batches in progress, see virtqueue_batch_begin(), and
+	 * number of buffers added to the ring but not published yet.
+	 */
+	uint16_t vq_batch;
+	uint16_t vq_staged_cnt;
+
 #ifdef VQUEUE_DEBUG
 	bool vq_inuse;
 #endif
@@ -199,6 +206,10 @@ int virtqueue_enable_cb(struct virtqueue *vq);
 
 void virtqueue_kick(struct virtqueue *vq);
 
+void virtqueue_batch_begin(struct virtqueue *vq);
+
+void virtqueue_batch_end(struct virtqueue *vq);
+
 static inline struct virtqueue *virtqueue_allocate(unsigned int num_desc_extra)
 {
 	struct virtqueue *vqs;
@@ -127,6 +127,52 @@ int rpmsg_send_offchannel_raw(struct rpmsg_endpoint *ept, uint32_t src,
 	return RPMSG_ERR_PARAM;
 }
 
+/**
+ * rpmsg_send_offchannel_batch - send several messages to the remote device
+ *
+ * Devices without a batch operation send the messages one by one.
+ *
+ * @param ept     - pointer to end point
+ * @param src     - source address of channel
+ * @param dst     - destination address of channel
+ * @param msgs    - messages to transmit
+ * @param num     - number of messages
+ * @param wait    - boolean, wait or not for buffers to become
+ *                  available
+ *
+ * @return - number of messages sent or negative value for failure.
+ *
+ */
+int rpmsg_send_offchannel_batch(struct rpmsg_endpoint *ept, uint32_t src,
+				uint32_t dst, const struct rpmsg_msg *msgs,
+				int num, int wait)
+{
+	struct rpmsg_device *rdev;
+	int i, ret;
+
+	if (!ept || !ept->rdev || !msgs || num <= 0 ||
+	    dst == RPMSG_ADDR_ANY)
+		return RPMSG_ERR_PARAM;
+
+	rdev = ept->rdev;
+
+	if (rdev->ops.send_offchannel_batch)
+		return rdev->ops.send_offchannel_batch(rdev, src, dst, msgs,
+						       num, wait);
+
+	if (!rdev->ops.send_offchannel_raw)
+		return RPMSG_ERR_PARAM;
+	for (i = 0; i < num; i++) {
+		ret = rdev->ops.send_offchannel_raw(rdev, src, dst,
+						    msgs[i].data, msgs[i].len,
+						    wait);
+		if (ret < 0)
+			return i ? i : ret;
+	}
+
+	return num;
+}
+
 int rpmsg_send_ns_message(struct rpmsg_endpoint *ept, unsigned long flags)
 {
 	struct rpmsg_ns_msg ns_msg;
@@ -186,6 +232,24 @@ void *rpmsg_get_tx_payload_buffer(struct rpmsg_endpoint *ept,
 	return NULL;
 }
 
+void *rpmsg_get_sized_tx_payload_buffer(struct rpmsg_endpoint *ept,
+					uint32_t size, uint32_t *len,
+					int wait)
+{
+	struct rpmsg_device *rdev;
+
+	if (!ept || !ept->rdev || !len)
+		return NULL;
+
+	rdev = ept->rdev;
+
+	if (rdev->ops.get_sized_tx_payload_buffer)
+		return rdev->ops.get_sized_tx_payload_buffer(rdev, size, len,
+							     wait);
+
+	return NULL;
+}
+
 int rpmsg_send_offchannel_nocopy(struct rpmsg_endpoint *ept, uint32_t src,
 				 uint32_t dst, const void *data, int len)
 {
@@ -239,21 +303,30 @@ struct rpmsg_endpoint *rpmsg_get_endpoint(struct rpmsg_device *rdev,
 static void rpmsg_unregister_endpoint(struct rpmsg_endpoint *ept)
 {
 	struct rpmsg_device *rdev = ept->rdev;
+	uint32_t idx;
 
 	metal_mutex_acquire(&rdev->lock);
 	if (ept->addr != RPMSG_ADDR_ANY)
 		rpmsg_release_address(rdev->bitmap, RPMSG_ADDR_BMP_SIZE,
 				      ept->addr);
+	idx = ept->addr - RPMSG_RESERVED_ADDRESSES;
+	if (idx < RPMSG_ADDR_BMP_SIZE && rdev->ept_table[idx] == ept)
+		rdev->ept_table[idx] = NULL;
 	metal_list_del(&ept->node);
 	ept->rdev = NULL;
+	rdev->ept_gen++;
 	metal_mutex_release(&rdev->lock);
 }
 
 void rpmsg_register_endpoint(struct rpmsg_device *rdev,
 			     struct rpmsg_endpoint *ept)
 {
+	uint32_t idx = ept->addr - RPMSG_RESERVED_ADDRESSES;
+
 	ept->rdev = rdev;
 	metal_list_add_tail(&rdev->endpoints, &ept->node);
+	if (idx < RPMSG_ADDR_BMP_SIZE)
+		rdev->ept_table[idx] = ept;
 }
 
 int rpmsg_create_ept(struct rpmsg_endpoint *ept, struct rpmsg_device *rdev,
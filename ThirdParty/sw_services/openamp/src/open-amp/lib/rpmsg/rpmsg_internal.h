@@ -120,9 +120,22 @@ struct rpmsg_endpoint *rpmsg_get_endpoint(struct rpmsg_device *rvdev,
 void rpmsg_register_endpoint(struct rpmsg_device *rdev,
 			     struct rpmsg_endpoint *ept);
 
+/**
+ * rpmsg_get_ept_from_addr - get the endpoint of a local address
+ *
+ * Addresses in the allocatable range are looked up in the endpoint table,
+ * the others in the endpoint list. Must be called with the device lock held.
+ *
+ * @rdev: pointer to rpmsg device
+ * @addr: local address of the endpoint
+ */
 static inline struct rpmsg_endpoint *
 rpmsg_get_ept_from_addr(struct rpmsg_device *rdev, uint32_t addr)
 {
+	uint32_t idx = addr - RPMSG_RESERVED_ADDRESSES;
+
+	if (idx < RPMSG_ADDR_BMP_SIZE)
+		return rdev->ept_table[idx];
 	return rpmsg_get_endpoint(rdev, NULL, addr, RPMSG_ADDR_ANY);
 }
 
@@ -48,8 +48,145 @@ void rpmsg_virtio_init_shm_pool(struct rpmsg_virtio_shm_pool *shpool,
 	shpool->base = shb;
 	shpool->size = size;
 	shpool->avail = size;
+	shpool->used = 0;
+	shpool->max_used = 0;
+	shpool->num_classes = 0;
 }
 
+int rpmsg_virtio_init_shm_pool_classes(struct rpmsg_virtio_shm_pool *shpool,
+				       void *shb, size_t size,
+				       const size_t *sizes,
+				       unsigned int num_sizes)
+{
+	struct rpmsg_virtio_shm_class *cls;
+	unsigned int i;
+
+	if (!shpool || !sizes || !num_sizes ||
+	    num_sizes > RPMSG_SHM_POOL_MAX_CLASSES ||
+	    sizes[num_sizes - 1] < RPMSG_BUFFER_SIZE)
+		return RPMSG_ERR_PARAM;
+	for (i = 0; i < num_sizes; i++) {
+		/* The payload length must fit the 16-bit rpmsg_hdr len */
+		if (sizes[i] <= sizeof(struct rpmsg_hdr) ||
+		    metal_align_up(sizes[i], sizeof(void *)) -
+		    sizeof(struct rpmsg_hdr) > UINT16_MAX ||
+		    (i && sizes[i] <= sizes[i - 1]))
+			return RPMSG_ERR_PARAM;
+	}
+
+	rpmsg_virtio_init_shm_pool(shpool, shb, size);
+	for (i = 0; i < num_sizes; i++) {
+		cls = &shpool->classes[i];
+		memset(cls, 0, sizeof(*cls));
+		/* Keep the carved buffers aligned for the free list links */
+		cls->stats.size = metal_align_up(sizes[i], sizeof(void *));
+	}
+	shpool->num_classes = num_sizes;
+
+	return RPMSG_SUCCESS;
+}
+
+#ifndef VIRTIO_SLAVE_ONLY
+/**
+ * rpmsg_virtio_shm_pool_alloc
+ *
+ * Allocates a buffer from the shared memory pool. With buffer size classes,
+ * the buffer comes from the smallest class that fits, from its free list or
+ * newly carved, or else from a larger class.
+ *
+ * @param shpool - pointer to the shared buffers pool
+ * @param size   - minimum buffer size
+ * @param len    - size of the returned buffer
+ *
+ * @return - pointer to the buffer, NULL if the pool is exhausted
+ */
+static void *rpmsg_virtio_shm_pool_alloc(struct rpmsg_virtio_shm_pool *shpool,
+					 size_t size, uint32_t *len)
+{
+	struct rpmsg_virtio_shm_class *cls = NULL;
+	struct rpmsg_virtio_shm_class *fit = NULL;
+	void *buffer = NULL;
+	unsigned int i;
+
+	if (!shpool->num_classes) {
+		buffer = rpmsg_virtio_shm_pool_get_buffer(shpool, size);
+		if (buffer) {
+			*len = size;
+			shpool->used += size;
+			shpool->max_used = shpool->used;
+		}
+		return buffer;
+	}
+
+	for (i = 0; i < shpool->num_classes && !buffer; i++) {
+		cls = &shpool->classes[i];
+		if (cls->stats.size < size)
+			continue;
+		if (!fit)
+			fit = cls;
+		buffer = cls->free_list;
+		if (buffer) {
+			cls->free_list = *(void **)buffer;
+		} else {
+			buffer = rpmsg_virtio_shm_pool_get_buffer(shpool,
+							cls->stats.size);
+			if (buffer)
+				cls->stats.num_bufs++;
+		}
+	}
+	if (!buffer) {
+		if (fit)
+			fit->stats.num_fails++;
+		return NULL;
+	}
+
+	cls->stats.num_used++;
+	if (cls->stats.num_used > cls->stats.max_used)
+		cls->stats.max_used = cls->stats.num_used;
+	shpool->used += cls->stats.size;
+	if (shpool->used > shpool->max_used)
+		shpool->max_used = shpool->used;
+	*len = cls->stats.size;
+
+	return buffer;
+}
+
+/**
+ * rpmsg_virtio_shm_pool_free
+ *
+ * Gives back a buffer to the free list of its size class. Pools without
+ * classes never free their buffers.
+ *
+ * @param shpool - pointer to the shared buffers pool
+ * @param buffer - buffer pointer
+ * @param len    - buffer size, as returned by rpmsg_virtio_shm_pool_alloc
+ */
+static void rpmsg_virtio_shm_pool_free(struct rpmsg_virtio_shm_pool *shpool,
+				       void *buffer, uint32_t len)
+{
+	struct rpmsg_virtio_shm_class *cls;
+	unsigned int i;
+
+	for (i = 0; i < shpool->num_classes; i++) {
+		cls = &shpool->classes[i];
+		if (cls->stats.size != len)
+			continue;
+		*(void **)buffer = cls->free_list;
+		cls->free_list = buffer;
+		cls->stats.num_used--;
+		shpool->used -= len;
+		return;
+	}
+
+	/*
+	 * The remote returns the buffers with the length the master gave
+	 * them. Any other length means the buffer size is unknown, the
+	 * buffer cannot be reused safely and stays counted as used.
+	 */
+	RPMSG_ASSERT(!shpool->num_classes, "unknown TX buffer length\r\n");
+}
+#endif /*!VIRTIO_SLAVE_ONLY*/
+
 /**
  * rpmsg_virtio_return_buffer
  *
@@ -135,24 +272,40 @@ static int rpmsg_virtio_enqueue_buffer(struct rpmsg_virtio_device *rvdev,
  * Provides buffer to transmit messages.
  *
  * @param rvdev - pointer to rpmsg device
+ * @param size - minimum buffer size, rpmsg header included, 0 for the
+ *               default size
  * @param len  - length of returned buffer
  * @param idx  - buffer index
  *
  * return - pointer to buffer.
  */
 static void *rpmsg_virtio_get_tx_buffer(struct rpmsg_virtio_device *rvdev,
-					uint32_t *len, uint16_t *idx)
+					uint32_t size, uint32_t *len,
+					uint16_t *idx)
 {
 	unsigned int role = rpmsg_virtio_get_role(rvdev);
 	void *data = NULL;
 
 #ifndef VIRTIO_SLAVE_ONLY
 	if (role == RPMSG_MASTER) {
-		data = virtqueue_get_buffer(rvdev->svq, len, idx);
+		struct rpmsg_virtio_shm_pool *shpool = rvdev->shpool;
+
+		if (!size)
+			size = RPMSG_BUFFER_SIZE;
+		if (!shpool->num_classes) {
+			/* Fixed size buffers, reuse the consumed ones as is */
+			if (size > RPMSG_BUFFER_SIZE)
+				return NULL;
+			data = virtqueue_get_buffer(rvdev->svq, len, idx);
+			size = RPMSG_BUFFER_SIZE;
+		} else {
+			/* Recycle the consumed buffers, then pick one that fits */
+			while ((data = virtqueue_get_buffer(rvdev->svq, len,
+							    idx)))
+				rpmsg_virtio_shm_pool_free(shpool, data, *len);
+		}
 		if (!data && rvdev->svq->vq_free_cnt) {
-			data = rpmsg_virtio_shm_pool_get_buffer(rvdev->shpool,
-							RPMSG_BUFFER_SIZE);
-			*len = RPMSG_BUFFER_SIZE;
+			data = rpmsg_virtio_shm_pool_alloc(shpool, size, len);
 			*idx = 0;
 		}
 	}
@@ -160,6 +313,9 @@ static void *rpmsg_virtio_get_tx_buffer(struct rpmsg_virtio_device *rvdev,
 
 #ifndef VIRTIO_MASTER_ONLY
 	if (role == RPMSG_REMOTE) {
+		/* The master sizes the buffers, check the next one fits */
+		if (size && virtqueue_get_desc_size(rvdev->svq) < size)
+			return NULL;
 		data = virtqueue_get_available_buffer(rvdev->svq, idx, len);
 	}
 #endif /*!VIRTIO_MASTER_ONLY*/
@@ -304,8 +460,9 @@ static void rpmsg_virtio_release_rx_buffer(struct rpmsg_device *rdev,
 	metal_mutex_release(&rdev->lock);
 }
 
-static void *rpmsg_virtio_get_tx_payload_buffer(struct rpmsg_device *rdev,
-						uint32_t *len, int wait)
+static void *
+rpmsg_virtio_get_sized_tx_payload_buffer(struct rpmsg_device *rdev,
+					 uint32_t size, uint32_t *len, int wait)
 {
 	struct rpmsg_virtio_device *rvdev;
 	struct rpmsg_hdr *rp_hdr;
@@ -326,10 +483,14 @@ static void *rpmsg_virtio_get_tx_payload_buffer(struct rpmsg_device *rdev,
 	else
 		tick_count = 0;
 
+	/* The buffer also holds the header, no size means a default buffer */
+	if (size)
+		size += sizeof(struct rpmsg_hdr);
+
 	while (1) {
 		/* Lock the device to enable exclusive access to virtqueues */
 		metal_mutex_acquire(&rdev->lock);
-		rp_hdr = rpmsg_virtio_get_tx_buffer(rvdev, len, &idx);
+		rp_hdr = rpmsg_virtio_get_tx_buffer(rvdev, size, len, &idx);
 		metal_mutex_release(&rdev->lock);
 		if (rp_hdr || !tick_count)
 			break;
@@ -340,17 +501,45 @@ static void *rpmsg_virtio_get_tx_payload_buffer(struct rpmsg_device *rdev,
 	if (!rp_hdr)
 		return NULL;
 
-	/* Store the index into the reserved field to be used when sending */
-	rp_hdr->reserved = idx;
+	/*
+	 * Store the index into the reserved field to be used when sending,
+	 * the master which owns the buffers stores their length instead
+	 */
+#ifndef VIRTIO_SLAVE_ONLY
+	if (rpmsg_virtio_get_role(rvdev) == RPMSG_MASTER)
+		rp_hdr->reserved = *len;
+	else
+#endif /*!VIRTIO_SLAVE_ONLY*/
+		rp_hdr->reserved = idx;
 
 	/* Actual data buffer size is vring buffer size minus header length */
 	*len -= sizeof(struct rpmsg_hdr);
 	return RPMSG_LOCATE_DATA(rp_hdr);
 }
 
-static int rpmsg_virtio_send_offchannel_nocopy(struct rpmsg_device *rdev,
-					       uint32_t src, uint32_t dst,
-					       const void *data, int len)
+static void *rpmsg_virtio_get_tx_payload_buffer(struct rpmsg_device *rdev,
+						uint32_t *len, int wait)
+{
+	return rpmsg_virtio_get_sized_tx_payload_buffer(rdev, 0, len, wait);
+}
+
+/**
+ * rpmsg_virtio_queue_tx_buffer
+ *
+ * Writes the header of a tx payload buffer and enqueues the buffer on the
+ * send virtqueue.
+ *
+ * @param rdev    - pointer to rpmsg device
+ * @param src     - source address of channel
+ * @param dst     - destination address of channel
+ * @param data    - payload buffer
+ * @param len     - size of data
+ * @param kick    - boolean, notify the other side or leave it to the caller
+ *
+ */
+static void rpmsg_virtio_queue_tx_buffer(struct rpmsg_device *rdev,
+					 uint32_t src, uint32_t dst,
+					 const void *data, int len, int kick)
 {
 	struct rpmsg_virtio_device *rvdev;
 	struct metal_io_region *io;
@@ -364,8 +553,9 @@ static int rpmsg_virtio_send_offchannel_nocopy(struct rpmsg_device *rdev,
 	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
 
 	hdr = RPMSG_LOCATE_HDR(data);
-	/* The reserved field contains buffer index */
+	/* The reserved field contains buffer index, or length for the master */
 	idx = hdr->reserved;
+	buff_len = hdr->reserved;
 
 	/* Initialize RPMSG header. */
 	rp_hdr.dst = dst;
@@ -383,9 +573,7 @@ static int rpmsg_virtio_send_offchannel_nocopy(struct rpmsg_device *rdev,
 	metal_mutex_acquire(&rdev->lock);
 
 #ifndef VIRTIO_SLAVE_ONLY
-	if (rpmsg_virtio_get_role(rvdev) == RPMSG_MASTER)
-		buff_len = RPMSG_BUFFER_SIZE;
-	else
+	if (rpmsg_virtio_get_role(rvdev) != RPMSG_MASTER)
 #endif /*!VIRTIO_SLAVE_ONLY*/
 		buff_len = virtqueue_get_buffer_length(rvdev->svq, idx);
 
@@ -393,9 +581,88 @@ static int rpmsg_virtio_send_offchannel_nocopy(struct rpmsg_device *rdev,
 	status = rpmsg_virtio_enqueue_buffer(rvdev, hdr, buff_len, idx);
 	RPMSG_ASSERT(status == VQUEUE_SUCCESS, "failed to enqueue buffer\r\n");
 	/* Let the other side know that there is a job to process. */
-	virtqueue_kick(rvdev->svq);
+	if (kick)
+		virtqueue_kick(rvdev->svq);
 
 	metal_mutex_release(&rdev->lock);
+}
+
+static int rpmsg_virtio_send_offchannel_nocopy(struct rpmsg_device *rdev,
+					       uint32_t src, uint32_t dst,
+					       const void *data, int len)
+{
+	rpmsg_virtio_queue_tx_buffer(rdev, src, dst, data, len, 1);
+
+	return len;
+}
+
+/**
+ * rpmsg_virtio_get_msg_buffer
+ *
+ * Gets a tx payload buffer for a message. A master with buffer size classes
+ * picks one that fits the message, otherwise the message is truncated to the
+ * buffer size.
+ *
+ * @param rdev    - pointer to rpmsg device
+ * @param len     - size of the message
+ * @param buff_len - pointer to store the payload buffer size
+ * @param wait    - boolean, wait or not for buffer to become
+ *                  available
+ *
+ * @return - payload buffer, or NULL if no buffer is available.
+ *
+ */
+static void *rpmsg_virtio_get_msg_buffer(struct rpmsg_device *rdev, int len,
+					 uint32_t *buff_len, int wait)
+{
+	uint32_t size = 0;
+
+#ifndef VIRTIO_SLAVE_ONLY
+	struct rpmsg_virtio_device *rvdev;
+
+	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
+	if (rpmsg_virtio_get_role(rvdev) == RPMSG_MASTER &&
+	    rvdev->shpool->num_classes && len > 0) {
+		struct rpmsg_virtio_shm_pool *shpool = rvdev->shpool;
+
+		size = shpool->classes[shpool->num_classes - 1].stats.size -
+		       sizeof(struct rpmsg_hdr);
+		if ((uint32_t)len < size)
+			size = len;
+	}
+#else
+	(void)len;
+#endif /*!VIRTIO_SLAVE_ONLY*/
+	return rpmsg_virtio_get_sized_tx_payload_buffer(rdev, size, buff_len,
+							wait);
+}
+
+/**
+ * rpmsg_virtio_copy_msg
+ *
+ * Copies a message into a tx payload buffer.
+ *
+ * @param rvdev   - pointer to rpmsg virtio device
+ * @param buffer  - payload buffer
+ * @param buff_len - size of the payload buffer
+ * @param data    - data to transmit
+ * @param len     - size of data
+ *
+ * @return - size of data copied, truncated to the buffer size.
+ *
+ */
+static int rpmsg_virtio_copy_msg(struct rpmsg_virtio_device *rvdev,
+				 void *buffer, uint32_t buff_len,
+				 const void *data, int len)
+{
+	struct metal_io_region *io = rvdev->shbuf_io;
+	int status;
+
+	if (len > (int)buff_len)
+		len = buff_len;
+	status = metal_io_block_write(io, metal_io_virt_to_offset(io, buffer),
+				      data, len);
+	RPMSG_ASSERT(status == len, "failed to write buffer\r\n");
 
 	return len;
 }
@@ -420,30 +687,84 @@ static int rpmsg_virtio_send_offchannel_raw(struct rpmsg_device *rdev,
 					    int len, int wait)
 {
 	struct rpmsg_virtio_device *rvdev;
-	struct metal_io_region *io;
 	uint32_t buff_len;
 	void *buffer;
-	int status;
 
 	/* Get the associated remote device for channel. */
 	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
 
-	/* Get the payload buffer. */
-	buffer = rpmsg_virtio_get_tx_payload_buffer(rdev, &buff_len, wait);
+	buffer = rpmsg_virtio_get_msg_buffer(rdev, len, &buff_len, wait);
 	if (!buffer)
 		return RPMSG_ERR_NO_BUFF;
 
 	/* Copy data to rpmsg buffer. */
-	if (len > (int)buff_len)
-		len = buff_len;
-	io = rvdev->shbuf_io;
-	status = metal_io_block_write(io, metal_io_virt_to_offset(io, buffer),
-				      data, len);
-	RPMSG_ASSERT(status == len, "failed to write buffer\r\n");
+	len = rpmsg_virtio_copy_msg(rvdev, buffer, buff_len, data, len);
 
 	return rpmsg_virtio_send_offchannel_nocopy(rdev, src, dst, buffer, len);
 }
 
+/**
+ * This function sends several rpmsg messages to remote device.
+ *
+ * The buffers of the messages are published together on the send virtqueue
+ * and the remote is kicked once at the end, it is only notified if it asked
+ * for it. When the tx buffers run out, the buffers already queued are
+ * published and kicked before waiting for the remote to release some.
+ *
+ * @param rdev    - pointer to rpmsg device
+ * @param src     - source address of channel
+ * @param dst     - destination address of channel
+ * @param msgs    - messages to transmit
+ * @param num     - number of messages
+ * @param wait    - boolean, wait or not for buffers to become
+ *                  available
+ *
+ * @return - number of messages sent or negative value for failure.
+ *
+ */
+static int rpmsg_virtio_send_offchannel_batch(struct rpmsg_device *rdev,
+					      uint32_t src, uint32_t dst,
+					      const struct rpmsg_msg *msgs,
+					      int num, int wait)
+{
+	struct rpmsg_virtio_device *rvdev;
+	uint32_t buff_len;
+	void *buffer;
+	int i, len;
+
+	/* Get the associated remote device for channel. */
+	rvdev = metal_container_of(rdev, struct rpmsg_virtio_device, rdev);
+
+	metal_mutex_acquire(&rdev->lock);
+	virtqueue_batch_begin(rvdev->svq);
+	metal_mutex_release(&rdev->lock);
+
+	for (i = 0; i < num; i++) {
+		buffer = rpmsg_virtio_get_msg_buffer(rdev, msgs[i].len,
+						     &buff_len, 0);
+		if (!buffer && wait) {
+			/* Let the remote consume the queued buffers */
+			metal_mutex_acquire(&rdev->lock);
+			virtqueue_kick(rvdev->svq);
+			metal_mutex_release(&rdev->lock);
+			buffer = rpmsg_virtio_get_msg_buffer(rdev, msgs[i].len,
+							     &buff_len, wait);
+		}
+		if (!buffer)
+			break;
+
+		len = rpmsg_virtio_copy_msg(rvdev, buffer, buff_len,
+					    msgs[i].data, msgs[i].len);
+		rpmsg_virtio_queue_tx_buffer(rdev, src, dst, buffer, len, 0);
+	}
+
+	metal_mutex_acquire(&rdev->lock);
+	virtqueue_batch_end(rvdev->svq);
+	metal_mutex_release(&rdev->lock);
+
+	return i ? i : RPMSG_ERR_NO_BUFF;
+}
+
 /**
  * rpmsg_virtio_tx_callback
  *
@@ -463,6 +784,18 @@ static void rpmsg_virtio_tx_callback(struct virtqueue *vq)
  *
  * Rx callback function.
  *
+ * The received buffers are drained in batches of up to RPMSG_RX_BATCH: the
+ * buffers of a batch are pulled from the virtqueue and their endpoints are
+ * resolved under one lock, the endpoint callbacks run without the lock, and
+ * the buffers that are not held are returned under one lock. The peer is
+ * kicked once, after the virtqueue is empty.
+ *
+ * The notifications of the peer are disabled while the virtqueue is drained
+ * and enabled again once it is empty, so a peer that keeps sending while
+ * the callback runs raises no interrupt. With VIRTIO_RING_F_EVENT_IDX this
+ * also moves the event index past the consumed buffers, which the peer
+ * checks before notifying.
+ *
  * @param vq - pointer to virtqueue on which messages is received
  *
  */
@@ -471,28 +804,57 @@ static void rpmsg_virtio_rx_callback(struct virtqueue *vq)
 	struct virtio_device *vdev = vq->vq_dev;
 	struct rpmsg_virtio_device *rvdev = vdev->priv;
 	struct rpmsg_device *rdev = &rvdev->rdev;
+	struct {
+		struct rpmsg_hdr *hdr;
+		struct rpmsg_endpoint *ept;
+		uint32_t len;
+		uint16_t idx;
+	} rx[RPMSG_RX_BATCH];
 	struct rpmsg_endpoint *ept;
 	struct rpmsg_hdr *rp_hdr;
-	uint32_t len;
-	uint16_t idx;
-	int status;
+	unsigned int num, i, gen;
+	unsigned int returned = 0;
+	int status, more;
 
 	metal_mutex_acquire(&rdev->lock);
-
-	/* Process the received data from remote node */
-	rp_hdr = rpmsg_virtio_get_rx_buffer(rvdev, &len, &idx);
-
+	virtqueue_disable_cb(rvdev->rvq);
 	metal_mutex_release(&rdev->lock);
 
-	while (rp_hdr) {
-		rp_hdr->reserved = idx;
-
-		/* Get the channel node from the remote device channels list. */
+	do {
+		more = 0;
 		metal_mutex_acquire(&rdev->lock);
-		ept = rpmsg_get_ept_from_addr(rdev, rp_hdr->dst);
+
+		/* Process the received data from remote node */
+		for (num = 0; num < RPMSG_RX_BATCH; num++) {
+			rp_hdr = rpmsg_virtio_get_rx_buffer(rvdev,
+							    &rx[num].len,
+							    &rx[num].idx);
+			if (!rp_hdr)
+				break;
+			rp_hdr->reserved = rx[num].idx;
+			rx[num].hdr = rp_hdr;
+			rx[num].ept = rpmsg_get_ept_from_addr(rdev, rp_hdr->dst);
+		}
+		gen = rdev->ept_gen;
+
 		metal_mutex_release(&rdev->lock);
 
-		if (ept) {
+		for (i = 0; i < num; i++) {
+			rp_hdr = rx[i].hdr;
+			ept = rx[i].ept;
+			if (rdev->ept_gen != gen) {
+				/*
+				 * A callback of this batch destroyed an
+				 * endpoint, resolve the endpoint again.
+				 */
+				metal_mutex_acquire(&rdev->lock);
+				ept = rpmsg_get_ept_from_addr(rdev,
+							      rp_hdr->dst);
+				metal_mutex_release(&rdev->lock);
+			}
+			if (!ept)
+				continue;
+
 			if (ept->dest_addr == RPMSG_ADDR_ANY) {
 				/*
 				 * First message received from the remote side,
@@ -509,19 +871,32 @@ static void rpmsg_virtio_rx_callback(struct virtqueue *vq)
 
 		metal_mutex_acquire(&rdev->lock);
 
-		/* Check whether callback wants to hold buffer */
-		if (!(rp_hdr->reserved & RPMSG_BUF_HELD)) {
-			/* No, return used buffers. */
-			rpmsg_virtio_return_buffer(rvdev, rp_hdr, len, idx);
+		for (i = 0; i < num; i++) {
+			/* Check whether callback wants to hold buffer */
+			if (!(rx[i].hdr->reserved & RPMSG_BUF_HELD)) {
+				/* No, return used buffers. */
+				rpmsg_virtio_return_buffer(rvdev, rx[i].hdr,
+							   rx[i].len,
+							   rx[i].idx);
+				returned++;
+			}
 		}
 
-		rp_hdr = rpmsg_virtio_get_rx_buffer(rvdev, &len, &idx);
-		if (!rp_hdr) {
-			/* tell peer we return some rx buffer */
-			virtqueue_kick(rvdev->rvq);
+		if (num < RPMSG_RX_BATCH) {
+			if (returned) {
+				/* tell peer we return some rx buffer */
+				virtqueue_kick(rvdev->rvq);
+				returned = 0;
+			}
+
+			/* Drain what arrived before the notifications are on */
+			more = virtqueue_enable_cb(rvdev->rvq);
+			if (more)
+				virtqueue_disable_cb(rvdev->rvq);
 		}
+
 		metal_mutex_release(&rdev->lock);
-	}
+	} while (num == RPMSG_RX_BATCH || more);
 }
 
 /**
@@ -605,6 +980,29 @@ int rpmsg_virtio_get_buffer_size(struct rpmsg_device *rdev)
 	return size;
 }
 
+int rpmsg_virtio_get_shm_pool_stats(struct rpmsg_virtio_device *rvdev,
+				    struct rpmsg_virtio_shm_pool_stats *stats)
+{
+	struct rpmsg_virtio_shm_pool *shpool;
+	unsigned int i;
+
+	if (!rvdev || !rvdev->shpool || !stats)
+		return RPMSG_ERR_PARAM;
+
+	shpool = rvdev->shpool;
+	metal_mutex_acquire(&rvdev->rdev.lock);
+	stats->size = shpool->size;
+	stats->avail = shpool->avail;
+	stats->used = shpool->used;
+	stats->max_used = shpool->max_used;
+	stats->num_classes = shpool->num_classes;
+	for (i = 0; i < shpool->num_classes; i++)
+		stats->classes[i] = shpool->classes[i].stats;
+	metal_mutex_release(&rvdev->rdev.lock);
+
+	return RPMSG_SUCCESS;
+}
+
 int rpmsg_init_vdev(struct rpmsg_virtio_device *rvdev,
 		    struct virtio_device *vdev,
 		    rpmsg_ns_bind_cb ns_bind_cb,
@@ -628,6 +1026,9 @@ int rpmsg_init_vdev(struct rpmsg_virtio_device *rvdev,
 	rdev->ops.release_rx_buffer = rpmsg_virtio_release_rx_buffer;
 	rdev->ops.get_tx_payload_buffer = rpmsg_virtio_get_tx_payload_buffer;
 	rdev->ops.send_offchannel_nocopy = rpmsg_virtio_send_offchannel_nocopy;
+	rdev->ops.get_sized_tx_payload_buffer =
+		rpmsg_virtio_get_sized_tx_payload_buffer;
+	rdev->ops.send_offchannel_batch = rpmsg_virtio_send_offchannel_batch;
 	role = rpmsg_virtio_get_role(rvdev);
 
 #ifndef VIRTIO_MASTER_ONLY
@@ -697,24 +1098,26 @@ int rpmsg_init_vdev(struct rpmsg_virtio_device *rvdev,
 	if (role == RPMSG_MASTER) {
 		struct virtqueue_buf vqbuf;
 		unsigned int idx;
+		uint32_t len;
 		void *buffer;
 
-		vqbuf.len = RPMSG_BUFFER_SIZE;
 		for (idx = 0; idx < rvdev->rvq->vq_nentries; idx++) {
 			/* Initialize TX virtqueue buffers for remote device */
-			buffer = rpmsg_virtio_shm_pool_get_buffer(shpool,
-							RPMSG_BUFFER_SIZE);
+			buffer = rpmsg_virtio_shm_pool_alloc(shpool,
+							     RPMSG_BUFFER_SIZE,
+							     &len);
 
 			if (!buffer) {
 				return RPMSG_ERR_NO_BUFF;
 			}
 
 			vqbuf.buf = buffer;
+			vqbuf.len = len;
 
 			metal_io_block_set(shm_io,
 					   metal_io_virt_to_offset(shm_io,
 								   buffer),
-					   0x00, RPMSG_BUFFER_SIZE);
+					   0x00, len);
 			status =
 				virtqueue_add_buffer(rvdev->rvq, &vqbuf, 0, 1,
 						     buffer);
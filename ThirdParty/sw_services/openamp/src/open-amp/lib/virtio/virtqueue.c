@@ -90,6 +90,8 @@ int virtqueue_create(struct virtio_device *virt_dev, unsigned short id,
 		vq->vq_queue_index = id;
 		vq->vq_nentries = ring->num_descs;
 		vq->vq_free_cnt = vq->vq_nentries;
+		vq->vq_batch = 0;
+		vq->vq_staged_cnt = 0;
 		vq->callback = callback;
 		vq->notify = notify;
 
@@ -309,7 +311,8 @@ int virtqueue_add_consumed_buffer(struct virtqueue *vq, uint16_t head_idx,
 	VQUEUE_BUSY(vq);
 
 	/* CACHE: used is never written by master, so it's safe to directly access it */
-	used_idx = vq->vq_ring.used->idx & (vq->vq_nentries - 1);
+	used_idx = (vq->vq_ring.used->idx + vq->vq_staged_cnt) &
+		   (vq->vq_nentries - 1);
 	used_desc = &vq->vq_ring.used->ring[used_idx];
 	used_desc->id = head_idx;
 	used_desc->len = len;
@@ -317,12 +320,17 @@ int virtqueue_add_consumed_buffer(struct virtqueue *vq, uint16_t head_idx,
 	/* We still need to flush it because this is read by master */
 	VRING_FLUSH(vq->vq_ring.used->ring[used_idx]);
 
-	atomic_thread_fence(memory_order_seq_cst);
+	if (vq->vq_batch) {
+		/* Published by virtqueue_kick() */
+		vq->vq_staged_cnt++;
+	} else {
+		atomic_thread_fence(memory_order_seq_cst);
 
-	vq->vq_ring.used->idx++;
+		vq->vq_ring.used->idx++;
 
-	/* Used.idx is read by master, so we need to flush it */
-	VRING_FLUSH(vq->vq_ring.used->idx);
+		/* Used.idx is read by master, so we need to flush it */
+		VRING_FLUSH(vq->vq_ring.used->idx);
+	}
 
 	/* Keep pending count until virtqueue_notify(). */
 	vq->vq_queued_cnt++;
@@ -387,15 +395,51 @@ void virtqueue_disable_cb(struct virtqueue *vq)
 	VQUEUE_IDLE(vq);
 }
 
+/**
+ * vq_ring_publish - Makes the buffers staged by a batch visible to the other
+ *                   side with a single index update.
+ *
+ * @param vq      - Pointer to VirtIO queue control block
+ */
+static void vq_ring_publish(struct virtqueue *vq)
+{
+	if (!vq->vq_staged_cnt)
+		return;
+
+	/* The ring entries must be visible before the index */
+	atomic_thread_fence(memory_order_seq_cst);
+
+#ifndef VIRTIO_SLAVE_ONLY
+	if (vq->vq_dev->role == VIRTIO_DEV_MASTER) {
+		vq->vq_ring.avail->idx += vq->vq_staged_cnt;
+		VRING_FLUSH(vq->vq_ring.avail->idx);
+	}
+#endif /*VIRTIO_SLAVE_ONLY*/
+#ifndef VIRTIO_MASTER_ONLY
+	if (vq->vq_dev->role == VIRTIO_DEV_SLAVE) {
+		vq->vq_ring.used->idx += vq->vq_staged_cnt;
+		VRING_FLUSH(vq->vq_ring.used->idx);
+	}
+#endif /*VIRTIO_MASTER_ONLY*/
+
+	vq->vq_staged_cnt = 0;
+}
+
 /**
  * virtqueue_kick - Notifies other side that there is buffer available for it.
  *
+ * The buffers staged by a batch are published first. The other side is
+ * only notified if it asked for it, through its event index when
+ * VIRTIO_RING_F_EVENT_IDX is negotiated or its ring flags otherwise.
+ *
  * @param vq      - Pointer to VirtIO queue control block
  */
 void virtqueue_kick(struct virtqueue *vq)
 {
 	VQUEUE_BUSY(vq);
 
+	vq_ring_publish(vq);
+
 	/* Ensure updated avail->idx is visible to host. */
 	atomic_thread_fence(memory_order_seq_cst);
 
@@ -407,6 +451,34 @@ void virtqueue_kick(struct virtqueue *vq)
 	VQUEUE_IDLE(vq);
 }
 
+/**
+ * virtqueue_batch_begin - Starts a batch of buffers.
+ *
+ * Until virtqueue_batch_end(), the buffers added to the virtqueue are only
+ * written to the ring. They are published to the other side at once by the
+ * next virtqueue_kick(), which raises at most one notification for all of
+ * them. Batches may nest or overlap, the buffers added meanwhile are staged
+ * as well. The caller serializes the calls as for the other functions.
+ *
+ * @param vq      - Pointer to VirtIO queue control block
+ */
+void virtqueue_batch_begin(struct virtqueue *vq)
+{
+	vq->vq_batch++;
+}
+
+/**
+ * virtqueue_batch_end - Ends a batch of buffers and kicks the other side.
+ *
+ * @param vq      - Pointer to VirtIO queue control block
+ */
+void virtqueue_batch_end(struct virtqueue *vq)
+{
+	if (vq->vq_batch)
+		vq->vq_batch--;
+	virtqueue_kick(vq);
+}
+
 /**
  * virtqueue_dump Dumps important virtqueue fields , use for debugging purposes
  *
@@ -610,18 +682,24 @@ static void vq_ring_update_avail(struct virtqueue *vq, uint16_t desc_idx)
 	 *
 	 * CACHE: avail is never written by slave, so it is safe to not invalidate here
 	 */
-	avail_idx = vq->vq_ring.avail->idx & (vq->vq_nentries - 1);
+	avail_idx = (vq->vq_ring.avail->idx + vq->vq_staged_cnt) &
+		    (vq->vq_nentries - 1);
 	vq->vq_ring.avail->ring[avail_idx] = desc_idx;
 
 	/* We still need to flush the ring */
 	VRING_FLUSH(vq->vq_ring.avail->ring[avail_idx]);
 
-	atomic_thread_fence(memory_order_seq_cst);
+	if (vq->vq_batch) {
+		/* Published by virtqueue_kick() */
+		vq->vq_staged_cnt++;
+	} else {
+		atomic_thread_fence(memory_order_seq_cst);
 
-	vq->vq_ring.avail->idx++;
+		vq->vq_ring.avail->idx++;
 
-	/* And the index */
-	VRING_FLUSH(vq->vq_ring.avail->idx);
+		/* And the index */
+		VRING_FLUSH(vq->vq_ring.avail->idx);
+	}
 
 	/* Keep pending count until virtqueue_notify(). */
 	vq->vq_queued_cnt++;
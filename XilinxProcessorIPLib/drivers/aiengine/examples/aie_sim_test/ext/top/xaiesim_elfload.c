@@ -28,18 +28,26 @@
 * 1.8  Hyun    09/13/2019  Added XAieSim_LoadElfMem()
 * 1.9  Tejus   12/04/2019  Support for new .bss/.data section prefixes in elf
 * 2.0  Nishad  02/03/2020  Added support for non-standard ELF sections
+* 2.1  jb      10/18/2026  Added the parsed ELF image to load many tiles
 * </pre>
 *
 ******************************************************************************/
 
 /***************************** Include Files *********************************/
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "xaiesim.h"
 #include "xaiesim_elfload.h"
 
 /************************** Constant Definitions *****************************/
+/* Kinds of section other than XAIESIM_ELF_IMG_PRGMEM and _DATMEM */
+#define XAIESIM_ELF_IMG_BSS                      2U
+#define XAIESIM_ELF_IMG_NONE                     0xFFU
+
+#define XAIESIM_ELF_DMB_NUMWORDS                 \
+	((XAIESIM_ELF_TILEADDR_DMB_MASK + 1U) / 4U)
 
 /************************** Variable Definitions *****************************/
 extern XAieGbl_Config XAieGbl_ConfigTable[];
@@ -801,5 +809,274 @@ uint64_t XAieSim_GetTargetTileAddr(XAieSim_Tile *TileInstPtr, uint32 ShAddr)
 	return TgtTileAddr;
 }
 
-/** @} */
+/*****************************************************************************/
+/**
+*
+* This routine is used to find where a section of the ELF is to be loaded,
+* with the same rules as XAieSim_LoadElfMem().
+*
+* @param	SectPtr: Pointer to the section header.
+*
+* @return	XAIESIM_ELF_IMG_PRGMEM, XAIESIM_ELF_IMG_DATMEM,
+*		XAIESIM_ELF_IMG_BSS or XAIESIM_ELF_IMG_NONE if the section isn't
+*		loaded.
+*
+* @note		Used only in this file.
+*
+*******************************************************************************/
+static uint8 XAieSim_ElfImgSectKind(const Elf32_Shdr *SectPtr)
+{
+	if(SectPtr->sh_type == SHT_PROGBITS && SectPtr->sh_flags) {
+		if(SectPtr->sh_flags == SHF_ALLOC ||
+				SectPtr->sh_flags == (SHF_ALLOC | SHF_WRITE)) {
+			return XAIESIM_ELF_IMG_DATMEM;
+		}
+		if(SectPtr->sh_flags == (SHF_ALLOC | SHF_EXECINSTR)) {
+			return XAIESIM_ELF_IMG_PRGMEM;
+		}
+		XAieSim_print("ERROR: Invalid program section with flag value "
+				"of 0x%x at %p ELF offset\n",
+				SectPtr->sh_flags, SectPtr->sh_offset);
+	}
+
+	if(SectPtr->sh_type == SHT_NOBITS && SectPtr->sh_addr > 0x1FFFFU) {
+		return XAIESIM_ELF_IMG_BSS;
+	}
+
+	return XAIESIM_ELF_IMG_NONE;
+}
+
+/*****************************************************************************/
+/**
+*
+* This routine is used to split a section into the chunks of the image. The
+* data memory sections are split at the 32 KB boundaries, where the section
+* moves to the memory bank of the next cardinal direction.
+*
+* @param	Chunks: Chunk entries to fill, or XAIE_NULL to only count them.
+* @param	ShAddr: Section's loadable address.
+* @param	NumWords: Size of the section in 32-bit words.
+* @param	Kind: Kind of section from XAieSim_ElfImgSectKind().
+* @param	Data: Words of the section, XAIE_NULL for bss.
+*
+* @return	Number of chunks.
+*
+* @note		Used only in this file.
+*
+*******************************************************************************/
+static uint32 XAieSim_ElfImgSplit(XAieSim_ElfChunk *Chunks, uint32 ShAddr,
+		uint32 NumWords, uint8 Kind, const uint32 *Data)
+{
+	uint32 Num = 0U;
+	uint32 Len;
 
+	while(NumWords > 0U) {
+		if(Kind == XAIESIM_ELF_IMG_PRGMEM) {
+			Len = NumWords;
+		} else {
+			Len = XAIESIM_ELF_DMB_NUMWORDS - ((ShAddr &
+				XAIESIM_ELF_TILEADDR_DMB_MASK) / 4U);
+			if(Len > NumWords) {
+				Len = NumWords;
+			}
+		}
+
+		if(Chunks != XAIE_NULL) {
+			Chunks[Num].ShAddr = ShAddr;
+			Chunks[Num].NumWords = Len;
+			Chunks[Num].Mem = (Kind == XAIESIM_ELF_IMG_PRGMEM) ?
+				XAIESIM_ELF_IMG_PRGMEM : XAIESIM_ELF_IMG_DATMEM;
+			Chunks[Num].Data = Data;
+		}
+
+		if(Data != XAIE_NULL) {
+			Data += Len;
+		}
+		ShAddr += Len * 4U;
+		NumWords -= Len;
+		Num++;
+	}
+
+	return Num;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the API to parse the ELF in memory into an image, which can be
+* loaded into any number of tiles with XAieSim_ElfImgLoad() without parsing
+* the ELF again.
+*
+* @param	ElfPtr: Pointer to the ELF in memory.
+*
+* @return	Pointer to the image on success, else XAIE_NULL.
+*
+* @note		The image keeps its own copy of the section data, so the ELF
+*		buffer can be released once this returns. The image should be
+*		released with XAieSim_ElfImgFree().
+*
+*******************************************************************************/
+XAieSim_ElfImg *XAieSim_ElfImgCreate(uint8 *ElfPtr)
+{
+	Elf32_Ehdr *ElfHdr = (Elf32_Ehdr *)ElfPtr;
+	Elf32_Shdr *SectHdr;
+	XAieSim_ElfImg *ImgPtr;
+	uint32 *DataPtr;
+	uint32 NumWords;
+	uint32 TotalWords = 0U;
+	uint32 NumChunks = 0U;
+	uint32 Count;
+	uint8 Kind;
+	uint8 HasBss = 0U;
+
+	if(ElfPtr == XAIE_NULL ||
+			memcmp(ElfHdr->e_ident, ELFMAG, SELFMAG) != 0) {
+		XAieSim_print("ERROR: Invalid ELF buffer\n");
+		return XAIE_NULL;
+	}
+
+	SectHdr = (Elf32_Shdr *)(ElfPtr + ElfHdr->e_shoff);
+
+	/* Size the chunk table and the copy of the section data */
+	for(Count = 0U; Count < ElfHdr->e_shnum; Count++) {
+		Kind = XAieSim_ElfImgSectKind(&SectHdr[Count]);
+		if(Kind == XAIESIM_ELF_IMG_NONE) {
+			continue;
+		}
+
+		NumWords = (SectHdr[Count].sh_size + 3U) / 4U;
+		NumChunks += XAieSim_ElfImgSplit(XAIE_NULL,
+				SectHdr[Count].sh_addr, NumWords, Kind,
+				XAIE_NULL);
+		if(Kind == XAIESIM_ELF_IMG_BSS) {
+			HasBss = 1U;
+		} else {
+			TotalWords += NumWords;
+		}
+	}
+
+	ImgPtr = (XAieSim_ElfImg *)calloc(1U, sizeof(*ImgPtr));
+	if(ImgPtr == XAIE_NULL) {
+		return XAIE_NULL;
+	}
+
+	ImgPtr->Chunks = (XAieSim_ElfChunk *)calloc(NumChunks + 1U,
+			sizeof(*ImgPtr->Chunks));
+	ImgPtr->Data = (uint32 *)calloc(TotalWords + 1U, sizeof(uint32));
+	if(HasBss != 0U) {
+		ImgPtr->Zeros = (uint32 *)calloc(XAIESIM_ELF_DMB_NUMWORDS,
+				sizeof(uint32));
+	}
+	if(ImgPtr->Chunks == XAIE_NULL || ImgPtr->Data == XAIE_NULL ||
+			(HasBss != 0U && ImgPtr->Zeros == XAIE_NULL)) {
+		XAieSim_print("ERROR: Failed to allocate the ELF image\n");
+		XAieSim_ElfImgFree(ImgPtr);
+		return XAIE_NULL;
+	}
+
+	/* Copy the sections and fill the chunks */
+	DataPtr = ImgPtr->Data;
+	for(Count = 0U; Count < ElfHdr->e_shnum; Count++) {
+		Kind = XAieSim_ElfImgSectKind(&SectHdr[Count]);
+		if(Kind == XAIESIM_ELF_IMG_NONE) {
+			continue;
+		}
+
+		NumWords = (SectHdr[Count].sh_size + 3U) / 4U;
+		if(Kind == XAIESIM_ELF_IMG_BSS) {
+			ImgPtr->NumChunks += XAieSim_ElfImgSplit(
+					&ImgPtr->Chunks[ImgPtr->NumChunks],
+					SectHdr[Count].sh_addr, NumWords, Kind,
+					XAIE_NULL);
+			continue;
+		}
+
+		memcpy(DataPtr, ElfPtr + SectHdr[Count].sh_offset,
+				SectHdr[Count].sh_size);
+		ImgPtr->NumChunks += XAieSim_ElfImgSplit(
+				&ImgPtr->Chunks[ImgPtr->NumChunks],
+				SectHdr[Count].sh_addr, NumWords, Kind,
+				DataPtr);
+		DataPtr += NumWords;
+	}
+
+	XAieSim_print("ELF image of %d chunks, %d words\n", ImgPtr->NumChunks,
+			TotalWords);
+
+	return ImgPtr;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the API to load the parsed ELF image to the target AIE Tile program
+* and data memories, including clearing of the BSS sections. Each chunk of
+* the image is written with a single burst.
+*
+* @param	TileInstPtr - Pointer to the Tile instance structure.
+* @param	ImgPtr: Pointer to the image from XAieSim_ElfImgCreate().
+*
+* @return	XAIESIM_SUCCESS on success, else XAIESIM_FAILURE.
+*
+* @note		The image is only read, so it can be loaded into different
+*		tiles from multiple threads at the same time.
+*
+*******************************************************************************/
+uint32 XAieSim_ElfImgLoad(XAieSim_Tile *TileInstPtr,
+		const XAieSim_ElfImg *ImgPtr)
+{
+	const XAieSim_ElfChunk *Chunk;
+	const uint32 *Data;
+	uint64_t TgtAddr;
+	uint32 Idx;
+
+	if(TileInstPtr == XAIE_NULL || ImgPtr == XAIE_NULL ||
+			TileInstPtr->TileType != XAIEGBL_TILE_TYPE_AIETILE) {
+		return XAIESIM_FAILURE;
+	}
+
+	for(Idx = 0U; Idx < ImgPtr->NumChunks; Idx++) {
+		Chunk = &ImgPtr->Chunks[Idx];
+
+		if(Chunk->Mem == XAIESIM_ELF_IMG_PRGMEM) {
+			TgtAddr = TileInstPtr->TileAddr +
+				XAIESIM_ELF_TILECORE_PRGMEM + Chunk->ShAddr;
+		} else {
+			TgtAddr = XAieSim_GetTargetTileAddr(TileInstPtr,
+					Chunk->ShAddr) +
+				XAIESIM_ELF_TILECORE_DATMEM +
+				(Chunk->ShAddr & XAIESIM_ELF_TILEADDR_DMB_MASK);
+		}
+
+		Data = (Chunk->Data != XAIE_NULL) ? Chunk->Data : ImgPtr->Zeros;
+		XAieGbl_WriteBurst32(TgtAddr, Data, Chunk->NumWords);
+	}
+
+	return XAIESIM_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the API to release the image from XAieSim_ElfImgCreate().
+*
+* @param	ImgPtr: Pointer to the image.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+void XAieSim_ElfImgFree(XAieSim_ElfImg *ImgPtr)
+{
+	if(ImgPtr == XAIE_NULL) {
+		return;
+	}
+
+	free(ImgPtr->Chunks);
+	free(ImgPtr->Data);
+	free(ImgPtr->Zeros);
+	free(ImgPtr);
+}
+
+/** @} */
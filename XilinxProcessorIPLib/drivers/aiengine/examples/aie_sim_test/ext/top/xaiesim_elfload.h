@@ -23,6 +23,7 @@
 * 1.3  Naresh  07/11/2018  Updated copyright info
 * 1.4  Nishad  12/05/2018  Renamed ME attributes to AIE
 * 1.8  Hyun    09/13/2019  Added XAieSim_LoadElfMem()
+* 1.9  jb      10/18/2026  Added the parsed ELF image API
 * </pre>
 *
 ******************************************************************************/
@@ -50,6 +51,10 @@
 #define XAIESIM_ELF_TILECORE_DATMEM              XAIEGBL_MEM_DATMEM
 
 #define XAieSim_Tile                             XAieGbl_Tile
+#define XAieSim_ElfImg                           XAieLib_ElfImg
+
+#define XAIESIM_ELF_IMG_PRGMEM                   0U
+#define XAIESIM_ELF_IMG_DATMEM                   1U
 
 /**************************** Type Definitions *******************************/
 /**
@@ -60,6 +65,28 @@ typedef struct {
 	uint32 end;	/**< Stack end address */
 } XAieSim_StackSz;
 
+/**
+ * This typedef contains a contiguous piece of a loadable section. Data memory
+ * sections are split at the 32 KB bank boundaries, so each chunk lands in the
+ * memory of a single neighbouring tile.
+ */
+typedef struct {
+	uint32 ShAddr;		/**< Loadable address of the chunk */
+	uint32 NumWords;	/**< Size in 32-bit words */
+	uint8 Mem;		/**< XAIESIM_ELF_IMG_PRGMEM or _DATMEM */
+	const uint32 *Data;	/**< Words to write, zeros for bss */
+} XAieSim_ElfChunk;
+
+/**
+ * This typedef contains an ELF parsed once, to be loaded into many tiles.
+ */
+struct XAieLib_ElfImg {
+	XAieSim_ElfChunk *Chunks;	/**< Loadable chunks */
+	uint32 NumChunks;		/**< Number of chunks */
+	uint32 *Data;			/**< Word aligned copy of section data */
+	uint32 *Zeros;			/**< Zeroed words for the bss chunks */
+};
+
 /***************************** Macro Definitions *****************************/
 
 /************************** Function Prototypes  *****************************/
@@ -69,6 +96,10 @@ uint32 XAieSim_GetStackRange(uint8 *MapPtr, XAieSim_StackSz *StackSzPtr);
 void XAieSim_LoadSymbols(XAieGbl_Tile *TileInstPtr, uint8 *ElfPtr);
 void XAieSim_WriteSection(XAieGbl_Tile *TileInstPtr, uint8 *SectName, Elf32_Shdr *SectPtr, FILE *Fd);
 uint64_t XAieSim_GetTargetTileAddr(XAieGbl_Tile *TileInstPtr, uint32 ShAddr);
+XAieSim_ElfImg *XAieSim_ElfImgCreate(uint8 *ElfPtr);
+uint32 XAieSim_ElfImgLoad(XAieGbl_Tile *TileInstPtr,
+		const XAieSim_ElfImg *ImgPtr);
+void XAieSim_ElfImgFree(XAieSim_ElfImg *ImgPtr);
 
 #endif		/* end of protection macro */
 /** @} */
@@ -0,0 +1,141 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie-trace.c
+* @{
+*
+* This file contains the example of the AIE event trace. It traces the core
+* stalls of the first AIE tile of the columns with a NoC shim tile into a host
+* buffer through the shim DMA of the column, while the graph already loaded to
+* the array runs. The trace is routed down its own column, so the columns with
+* a PL shim tile, which has no DMA, are not traced.
+* The trace is written as a Chrome trace to xaie-trace.json, and the stall
+* histograms are printed.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0  jb      10/18/2026  Initial creation
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <xaiengine.h>
+
+/************************** Constant Definitions *****************************/
+#define XAIE_NUM_ROWS		8
+#define XAIE_NUM_COLS		50
+#define XAIE_ADDR_ARRAY_OFF	0x800
+
+#define TRACE_NUM_COLS		4
+/* Columns 2 and 3 of each group of 4 columns have a NoC shim tile */
+#define TRACE_COL(Idx)		(((Idx) / 2) * 4 + 2 + ((Idx) % 2))
+#define TRACE_ROW		1
+#define TRACE_BROADCAST_ID	15
+#define TRACE_STRM_PORT		3
+#define TRACE_BD		15
+#define TRACE_BUF_SIZE		(64 * 1024)
+#define TRACE_CLOCK_MHZ		1000
+#define TRACE_RUN_USECS		100000
+
+/************************** Variable Definitions *****************************/
+static XAieGbl_Config *AieConfigPtr;	/**< AIE configuration pointer */
+static XAieGbl AieInst;			/**< AIE global instance */
+static XAieGbl_HwCfg AieConfig;		/**< AIE HW configuration instance */
+
+static XAieGbl_Tile TileInst[XAIE_NUM_COLS][XAIE_NUM_ROWS+1];
+static XAieDma_Shim ShimDmaInst[TRACE_NUM_COLS];
+static XAieTileTrace_Decoder Decoder;
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This is the main entry point for the AIE trace example.
+*
+* @param	None.
+*
+* @return	0 for success, and negative value for failure.
+*
+* @note		None.
+*
+*******************************************************************************/
+int main(void)
+{
+	XAieGbl_MemInst *Mem[TRACE_NUM_COLS];
+	XAie_TraceEvents Events;
+	FILE *Json;
+	int Idx;
+	int Col;
+
+	printf("*************************************\n"
+	       " XAIE Trace Example.\n"
+	       "*************************************\n");
+
+	XAIEGBL_HWCFG_SET_CONFIG((&AieConfig), XAIE_NUM_ROWS, XAIE_NUM_COLS, XAIE_ADDR_ARRAY_OFF);
+	XAieGbl_HwInit(&AieConfig);
+
+	AieConfigPtr = XAieGbl_LookupConfig(XPAR_AIE_DEVICE_ID);
+	(void)XAieGbl_CfgInitialize(&AieInst, &TileInst[0][0], AieConfigPtr);
+
+	XAieTileTrace_CoreStallEvents(&Events);
+	for (Idx = 0; Idx < TRACE_NUM_COLS; Idx++) {
+		Col = TRACE_COL(Idx);
+		Mem[Idx] = XAieGbl_MemAllocate(TRACE_BUF_SIZE, 0);
+		if (Mem[Idx] == XAIE_NULL) {
+			printf("Failed to allocate the trace buffer\n");
+			return -1;
+		}
+		memset((void *)XAieGbl_MemGetVaddr(Mem[Idx]), 0, TRACE_BUF_SIZE);
+		XAieGbl_MemSyncForDev(Mem[Idx]);
+
+		XAieTileTrace_CoreConfig(&TileInst[Col][TRACE_ROW], &Events,
+				TRACE_BROADCAST_ID, Col);
+		XAieTileTrace_RouteColumn(&TileInst[Col][0], TRACE_ROW,
+				XAIEGBL_MODULE_CORE, TRACE_STRM_PORT,
+				XAIEDMA_SHIM_CHNUM_S2MM1);
+
+		XAieDma_ShimSoftInitialize(&TileInst[Col][0], &ShimDmaInst[Idx]);
+		XAieTileTrace_ShimDmaStart(&ShimDmaInst[Idx],
+				XAIEDMA_SHIM_CHNUM_S2MM1, TRACE_BD,
+				XAieGbl_MemGetPaddr(Mem[Idx]), TRACE_BUF_SIZE);
+	}
+
+	/* One broadcast starts the timers and traces of all tiles at once */
+	XAieTileTrace_Start(&TileInst[0][0], TRACE_BROADCAST_ID);
+	XAie_usleep(TRACE_RUN_USECS);
+
+	Json = fopen("xaie-trace.json", "w");
+	XAieTileTrace_DecoderInit(&Decoder, TRACE_CLOCK_MHZ, Json);
+	for (Idx = 0; Idx < TRACE_NUM_COLS; Idx++) {
+		XAieGbl_MemSyncForCPU(Mem[Idx]);
+		XAieTileTrace_Decode(&Decoder,
+				(const u32 *)XAieGbl_MemGetVaddr(Mem[Idx]),
+				TRACE_BUF_SIZE / sizeof(u32));
+		XAieGbl_MemFree(Mem[Idx]);
+	}
+	XAieTileTrace_DecoderFinish(&Decoder);
+	if (Json != NULL) {
+		fclose(Json);
+	}
+
+	XAieTileTrace_WriteHist(&Decoder, stdout);
+	printf("dropped %llu packets, %llu bad frames\n",
+	       (unsigned long long)Decoder.NumDropped,
+	       (unsigned long long)Decoder.NumBadFrames);
+
+	return 0;
+}
+
+/** @} */
@@ -0,0 +1,205 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie-txn-bench.c
+* @{
+*
+* This file contains the benchmark of the AIE transaction API. It configures
+* the tile DMA BDs and stream switches of the whole array, once with direct
+* register writes and once inside a transaction, and reports both times.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0  jb      10/18/2026  Initial creation
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <stddef.h>
+#include <stdio.h>
+#include <xaiengine.h>
+
+#ifdef __AIEBAREMTL__
+#include <xtime_l.h>
+#else
+#include <time.h>
+#include <unistd.h>
+#endif
+
+/************************** Constant Definitions *****************************/
+#define XAIE_NUM_ROWS		8
+#define XAIE_NUM_COLS		50
+#define XAIE_ADDR_ARRAY_OFF	0x800
+
+#define BENCH_NUM_ITERS		10
+
+/************************** Variable Definitions *****************************/
+static XAieGbl_Config *AieConfigPtr;	/**< AIE configuration pointer */
+static XAieGbl AieInst;			/**< AIE global instance */
+static XAieGbl_HwCfg AieConfig;		/**< AIE HW configuration instance */
+
+static XAieGbl_Tile TileInst[XAIE_NUM_COLS][XAIE_NUM_ROWS+1];
+static XAieDma_Tile TileDmaInst[XAIE_NUM_COLS][XAIE_NUM_ROWS+1];
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This returns a timestamp in nano seconds.
+*
+* @param	None.
+*
+* @return	Timestamp in nano seconds.
+*
+* @note		None.
+*
+*******************************************************************************/
+static u64 bench_time_ns(void)
+{
+#ifdef __AIEBAREMTL__
+	XTime Time;
+
+	XTime_GetTime(&Time);
+	return Time * 1000000000ULL / COUNTS_PER_SECOND;
+#else
+	struct timespec Ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &Ts);
+	return (u64)Ts.tv_sec * 1000000000ULL + Ts.tv_nsec;
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* This configures all 16 DMA BDs and a DMA to south stream route in every
+* AIE tile, and a south to north route in every shim tile.
+*
+* @param	None.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+static void bench_config_array(void)
+{
+	XAieGbl_Tile *TilePtr;
+	XAieDma_Tile *DmaPtr;
+	int Col, Row;
+	u8 Bd;
+
+	for (Col = 0; Col < XAIE_NUM_COLS; Col++) {
+		for (Row = 0; Row <= XAIE_NUM_ROWS; Row++) {
+			TilePtr = &TileInst[Col][Row];
+
+			if (TilePtr->TileType != XAIEGBL_TILE_TYPE_AIETILE) {
+				XAieTile_StrmConnectCct(TilePtr,
+					XAIETILE_STRSW_SPORT_SOUTH(TilePtr, 0),
+					XAIETILE_STRSW_MPORT_NORTH(TilePtr, 0),
+					XAIE_ENABLE);
+				continue;
+			}
+
+			DmaPtr = &TileDmaInst[Col][Row];
+			for (Bd = 0U; Bd < XAIEDMA_TILE_MAX_NUM_DESCRS; Bd++) {
+				XAieDma_TileBdSetLock(DmaPtr, Bd,
+						XAIEDMA_TILE_BD_ADDRA, Bd,
+						XAIE_ENABLE, 1, XAIE_ENABLE, 0);
+				XAieDma_TileBdSetAdrLenMod(DmaPtr, Bd,
+						Bd * 0x200U, 0U, 0x200U,
+						XAIE_DISABLE, XAIE_DISABLE);
+				XAieDma_TileBdSetNext(DmaPtr, Bd,
+					(Bd + 1U) % XAIEDMA_TILE_MAX_NUM_DESCRS);
+				XAieDma_TileBdWrite(DmaPtr, Bd);
+			}
+
+			XAieTile_StrmConnectCct(TilePtr,
+				XAIETILE_STRSW_SPORT_DMA(TilePtr, 0),
+				XAIETILE_STRSW_MPORT_SOUTH(TilePtr, 0),
+				XAIE_ENABLE);
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the main entry point for the AIE transaction benchmark.
+*
+* @param	None.
+*
+* @return	0 for success, and negative value for failure.
+*
+* @note		None.
+*
+*******************************************************************************/
+int main(void)
+{
+	XAieGbl_TxnStats Stats;
+	u64 Start, Direct, Batched;
+	int Col, Row, Iter;
+
+	printf("*************************************\n"
+	       " XAIE Transaction Benchmark.\n"
+	       "*************************************\n");
+
+	XAIEGBL_HWCFG_SET_CONFIG((&AieConfig), XAIE_NUM_ROWS, XAIE_NUM_COLS, XAIE_ADDR_ARRAY_OFF);
+	XAieGbl_HwInit(&AieConfig);
+
+	AieConfigPtr = XAieGbl_LookupConfig(XPAR_AIE_DEVICE_ID);
+	(void)XAieGbl_CfgInitialize(&AieInst, &TileInst[0][0], AieConfigPtr);
+
+	for (Col = 0; Col < XAIE_NUM_COLS; Col++) {
+		for (Row = 1; Row <= XAIE_NUM_ROWS; Row++) {
+			XAieDma_TileSoftInitialize(&TileInst[Col][Row],
+					&TileDmaInst[Col][Row]);
+		}
+	}
+
+	Direct = 0U;
+	Batched = 0U;
+	XAieGbl_TxnResetStats();
+	for (Iter = 0; Iter < BENCH_NUM_ITERS; Iter++) {
+		Start = bench_time_ns();
+		bench_config_array();
+		Direct += bench_time_ns() - Start;
+
+		Start = bench_time_ns();
+		if (XAieGbl_TxnBegin(0U) != XAIELIB_SUCCESS) {
+			printf("Failed to begin a transaction\n");
+			return -1;
+		}
+		bench_config_array();
+		(void)XAieGbl_TxnEnd();
+		Batched += bench_time_ns() - Start;
+	}
+	XAieGbl_TxnGetStats(&Stats);
+
+	printf("Array %dx%d, %d iterations\n", XAIE_NUM_COLS, XAIE_NUM_ROWS,
+	       BENCH_NUM_ITERS);
+	printf("direct:      %llu us per configuration\n",
+	       (unsigned long long)(Direct / BENCH_NUM_ITERS / 1000U));
+	printf("transaction: %llu us per configuration\n",
+	       (unsigned long long)(Batched / BENCH_NUM_ITERS / 1000U));
+	printf("recorded %llu, merged %llu, written %llu in %llu bursts, "
+	       "%llu flushes\n",
+	       (unsigned long long)Stats.NumRecorded,
+	       (unsigned long long)Stats.NumMerged,
+	       (unsigned long long)Stats.NumWrites,
+	       (unsigned long long)Stats.NumBursts,
+	       (unsigned long long)Stats.NumFlushes);
+
+	return 0;
+}
+
+/** @} */
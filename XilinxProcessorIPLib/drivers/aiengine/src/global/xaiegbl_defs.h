@@ -59,10 +59,29 @@
 #define XAieGbl_Write32                  XAieLib_Write32
 #define XAieGbl_MaskWrite32              XAieLib_MaskWrite32
 #define XAieGbl_Write128                 XAieLib_Write128
+#define XAieGbl_WriteBurst32             XAieLib_WriteBurst32
 #define XAieGbl_WriteCmd                 XAieLib_WriteCmd
 #define XAieGbl_MaskPoll                 XAieLib_MaskPoll
 #define XAieGbl_LoadElf                  XAieLib_LoadElf
 #define XAieGbl_LoadElfMem               XAieLib_LoadElfMem
+#define XAieGbl_ElfImg                   XAieLib_ElfImg
+#define XAieGbl_ElfImgCreate             XAieLib_ElfImgCreate
+#define XAieGbl_LoadElfImg               XAieLib_LoadElfImg
+#define XAieGbl_ElfImgFree               XAieLib_ElfImgFree
+
+#define XAieGbl_TxnStats                 XAieLib_TxnStats
+#define XAieGbl_TxnBegin                 XAieLib_TxnBegin
+#define XAieGbl_TxnFlush                 XAieLib_TxnFlush
+#define XAieGbl_TxnEnd                   XAieLib_TxnEnd
+#define XAieGbl_TxnGetStats              XAieLib_TxnGetStats
+#define XAieGbl_TxnResetStats            XAieLib_TxnResetStats
+
+#define XAieGbl_ShadowStats              XAieLib_ShadowStats
+#define XAieGbl_ShadowEnable             XAieLib_ShadowEnable
+#define XAieGbl_ShadowFlush              XAieLib_ShadowFlush
+#define XAieGbl_ShadowInvalidate         XAieLib_ShadowInvalidate
+#define XAieGbl_ShadowDisable            XAieLib_ShadowDisable
+#define XAieGbl_ShadowGetStats           XAieLib_ShadowGetStats
 
 #define XAieGbl_NPIRead32                XAieLib_NPIRead32
 #define XAieGbl_NPIWrite32               XAieLib_NPIWrite32
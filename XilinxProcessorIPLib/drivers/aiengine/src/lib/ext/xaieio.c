@@ -20,6 +20,7 @@
 * 1.0  Hyun    07/12/2018  Initial creation
 * 1.1  Hyun    10/11/2018  Initialize the IO device for mem instance
 * 1.2  Nishad  12/05/2018  Renamed ME attributes to AIE
+* 1.3  jb      10/18/2026  Add XAieIO_WriteBurst32()
 * </pre>
 *
 ******************************************************************************/
@@ -382,6 +383,50 @@ void XAieIO_Write128(u64 Addr, u32 *Data)
 	}
 }
 
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to write consecutive 32bit words to
+* sequential addresses.
+*
+* @param	Addr: Address of the first word.
+* @param	Data: Words to be written.
+* @param	Count: Number of words.
+*
+* @return	None.
+*
+* @note		The region is translated once for the whole run, instead of
+*		once per word. The stores stay 32 bit wide as the AIE registers
+*		don't accept wider accesses, so metal_io_block_write() isn't
+*		used.
+*
+*******************************************************************************/
+void XAieIO_WriteBurst32(u64 Addr, const u32 *Data, u32 Count)
+{
+	unsigned long Offset = Addr - IOInst.io_base;
+	volatile u32 *Ptr;
+	u32 Idx;
+
+	if (Count == 0U) {
+		return;
+	}
+
+	Ptr = metal_io_virt(IOInst.io, Offset);
+	if ((Ptr == NULL) ||
+	    (metal_io_virt(IOInst.io, Offset + Count * 4U - 1U) == NULL)) {
+		/* Let the single word accessor report the bad access */
+		for (Idx = 0U; Idx < Count; Idx++) {
+			XAieIO_Write32(Addr + Idx * 4U, Data[Idx]);
+		}
+		return;
+	}
+
+	for (Idx = 0U; Idx < Count; Idx++) {
+		Ptr[Idx] = Data[Idx];
+	}
+	atomic_thread_fence(memory_order_seq_cst);
+}
+
 /*****************************************************************************/
 /**
 *
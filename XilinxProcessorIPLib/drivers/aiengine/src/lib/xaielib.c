@@ -38,14 +38,23 @@
 * 2.6  Tejus   10/14/2019  Enable assertion for linux and simulation
 * 2.7  Wendy   02/25/2020  Add logging API
 * 2.8  Tejus   04/17/2020  Fix variable overflow issue.
+* 2.9  jb      10/18/2026  Add transaction mode to batch register writes
+* 3.0  jb      10/18/2026  Add per tile shadow register cache
+* 3.1  jb      10/18/2026  Add parsed ELF image loading to many tiles
+* 3.2  jb      10/18/2026  Don't merge transaction writes to trigger registers
+* 3.3  jb      10/18/2026  Don't shadow trigger registers, write back before
+*                          writing them
+* 3.4  jb      10/18/2026  Read 128 bits of a shadowed tile through the shadow
 * </pre>
 *
 ******************************************************************************/
 #include "xaiegbl_defs.h"
+#include "xaiegbl.h"
 #include "xaielib.h"
 #include "xaielib_npi.h"
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #ifdef __AIESIM__ /* AIE simulator */
@@ -65,12 +74,11 @@
 #include "xstatus.h"
 #include "sleep.h"
 
-#include <stdlib.h>
-
 #else /* Non-baremetal application, ex Linux */
 
 #include <assert.h>
 #include <errno.h>
+#include <pthread.h>
 #include <unistd.h>
 
 #include "xaieio.h"
@@ -95,6 +103,32 @@
 /* Address should be aligned at 128 bit / 16 bytes */
 #define XAIELIB_SHIM_MEM_ALIGN		16
 
+/* Default number of commands buffered by a transaction */
+#ifndef XAIELIB_TXN_DEF_NUM_CMDS
+#define XAIELIB_TXN_DEF_NUM_CMDS	(4096U)
+#endif
+
+#define XAIELIB_TXN_FULL_MASK		(0xFFFFFFFFU)
+
+/* Row of a tile in its address */
+#define XAIELIB_TILE_ROW_MASK		((1U << (XAIEGBL_TILE_ADDR_COL_SHIFT - \
+					XAIEGBL_TILE_ADDR_ROW_SHIFT)) - 1U)
+/* Size of the lock register space of a tile */
+#define XAIELIB_LOCK_SPACE_SIZE		(0x800U)
+
+/* Number of hash buckets to look up shadowed tiles */
+#define XAIELIB_SHADOW_NUM_BUCKETS	(64U)
+/* Initial number of registers cached per tile, power of 2 */
+#define XAIELIB_SHADOW_DEF_NUM_REGS	(256U)
+#define XAIELIB_SHADOW_TILE_MASK	((1U << XAIEGBL_TILE_ADDR_ROW_SHIFT) - 1U)
+/* Data memory of an AIE tile, including the neighbour aliases */
+#define XAIELIB_SHADOW_AIE_DMEM_END	(0x10000U)
+
+/* Maximum number of threads loading an ELF image */
+#ifndef XAIELIB_ELF_MAX_THREADS
+#define XAIELIB_ELF_MAX_THREADS		(16U)
+#endif
+
 /************************** Variable Definitions *****************************/
 typedef struct XAieLib_MemInst
 {
@@ -108,6 +142,115 @@ typedef struct XAieLib_MemInst
 static FILE *XAieLib_LogFPtr; /**< Pointer to Log file pointer. */
 #endif
 
+typedef struct XAieLib_TxnCmd
+{
+	u64 Addr;	/**< Register address */
+	u32 Mask;	/**< Write mask, XAIELIB_TXN_FULL_MASK for plain write */
+	u32 Data;	/**< Data to write */
+	u8 Trigger;	/**< Non 0 for a write with a side effect */
+} XAieLib_TxnCmd;
+
+typedef struct XAieLib_Txn
+{
+	XAieLib_TxnCmd *Cmds;	/**< Recorded commands */
+	u32 *Burst;		/**< Staging buffer for sequential writes */
+	u32 NumCmds;		/**< Number of commands recorded */
+	u32 MaxCmds;		/**< Capacity of Cmds and Burst */
+	u8 Active;		/**< Non 0 between begin and end */
+	XAieLib_TxnStats Stats;	/**< Accumulated statistics */
+} XAieLib_Txn;
+
+static XAieLib_Txn XAieLib_TxnInst; /**< Transaction of the calling process */
+
+typedef struct XAieLib_RegRange
+{
+	u32 Start;	/**< First register offset in the tile */
+	u32 End;	/**< Offset following the last register */
+} XAieLib_RegRange;
+
+/*
+ * Registers of AIE tiles whose writes have a side effect besides setting a
+ * value: event generation, broadcast block set / clear, write 1 to clear
+ * status, DMA start queues, locks, core and timer control.
+ */
+static const XAieLib_RegRange XAieLib_AieTrigRegs[] =
+{
+	{XAIEGBL_MEM_TIMCTRL, XAIEGBL_MEM_TIMCTRL + 4U},
+	{XAIEGBL_MEM_EVTGEN, XAIEGBL_MEM_EVTGEN + 4U},
+	{XAIEGBL_MEM_EVTBRDCASTBLKSOUSET, XAIEGBL_MEM_EVTBRDCASTBLKEASCLR + 4U},
+	{XAIEGBL_MEM_EVTSTA0, XAIEGBL_MEM_EVTSTA3 + 4U},
+	{XAIEGBL_MEM_DMAS2MM0STAQUE, XAIEGBL_MEM_DMAMM2S1STAQUE + 4U},
+	{XAIEGBL_TILE_ADDR_MEMLOCKOFF,
+	 XAIEGBL_TILE_ADDR_MEMLOCKOFF + XAIELIB_LOCK_SPACE_SIZE},
+	{XAIEGBL_CORE_CORECTRL, XAIEGBL_CORE_CORECTRL + 4U},
+	{XAIEGBL_CORE_TIMCTRL, XAIEGBL_CORE_TIMCTRL + 4U},
+	{XAIEGBL_CORE_EVTGEN, XAIEGBL_CORE_EVTGEN + 4U},
+	{XAIEGBL_CORE_EVTBRDCASTBLKSOUSET, XAIEGBL_CORE_EVTBRDCASTBLKEASCLR + 4U},
+	{XAIEGBL_CORE_EVTSTA0, XAIEGBL_CORE_EVTSTA3 + 4U},
+};
+
+/*
+ * Same for shim tiles, adding the interrupt controllers and the resets.
+ */
+static const XAieLib_RegRange XAieLib_ShimTrigRegs[] =
+{
+	{XAIEGBL_TILE_ADDR_NOCLOCKOFF,
+	 XAIEGBL_TILE_ADDR_NOCLOCKOFF + XAIELIB_LOCK_SPACE_SIZE},
+	{XAIEGBL_NOC_INTCON2NDLEVENA, XAIEGBL_NOC_INTCON2NDLEVINT + 4U},
+	{XAIEGBL_NOC_DMAS2MM0STAQUE, XAIEGBL_NOC_DMAMM2S1STABDQUE + 4U},
+	{XAIEGBL_PL_TIMCTRL, XAIEGBL_PL_TIMCTRL + 4U},
+	{XAIEGBL_PL_EVTGEN, XAIEGBL_PL_EVTGEN + 4U},
+	{XAIEGBL_PL_EVTBRDCASTABLKSOUSET, XAIEGBL_PL_EVTBRDCASTBBLKEASCLR + 4U},
+	{XAIEGBL_PL_EVTSTA0, XAIEGBL_PL_EVTSTA3 + 4U},
+	{XAIEGBL_PL_INTCON1STLEVENAA, XAIEGBL_PL_INTCON1STLEVSTAA + 4U},
+	{XAIEGBL_PL_INTCON1STLEVBLKNORINASET,
+	 XAIEGBL_PL_INTCON1STLEVBLKNORINACLR + 4U},
+	{XAIEGBL_PL_INTCON1STLEVENAB, XAIEGBL_PL_INTCON1STLEVSTAB + 4U},
+	{XAIEGBL_PL_INTCON1STLEVBLKNORINBSET,
+	 XAIEGBL_PL_INTCON1STLEVBLKNORINBCLR + 4U},
+	{XAIEGBL_PL_AIETILCOLRST, XAIEGBL_PL_AIESHIRSTENA + 4U},
+};
+
+typedef struct XAieLib_ShadowReg
+{
+	u32 Offset;	/**< Register offset in the tile */
+	u32 Value;	/**< Cached register value */
+	u8 Valid;	/**< Entry is in use */
+	u8 Dirty;	/**< Value not written to the device yet */
+} XAieLib_ShadowReg;
+
+typedef struct XAieLib_Shadow
+{
+	u64 TileAddr;			/**< Base address of the tile */
+	u8 TileType;			/**< Type of the tile */
+	u8 Mode;			/**< XAIELIB_SHADOW_WRTHROUGH/WRBACK */
+	XAieLib_ShadowReg *Regs;	/**< Open addressed register table */
+	u32 NumRegs;			/**< Number of cached registers */
+	u32 MaxRegs;			/**< Size of Regs, power of 2 */
+	u32 NumDirty;			/**< Number of dirty registers */
+	XAieLib_ShadowStats Stats;	/**< Statistics */
+	struct XAieLib_Shadow *Next;	/**< Next tile in the bucket */
+} XAieLib_Shadow;
+
+static XAieLib_Shadow *XAieLib_ShadowTbl[XAIELIB_SHADOW_NUM_BUCKETS];
+static XAieLib_Shadow *XAieLib_ShadowLast; /**< Last looked up tile */
+static u32 XAieLib_ShadowNumTiles; /**< Number of shadowed tiles */
+
+#if !defined __AIESIM__ && !defined __AIEBAREMTL__
+typedef struct XAieLib_ElfLoader
+{
+	XAieGbl_Tile **TileInstPtrs;	/**< Tiles to load */
+	u32 NumTiles;			/**< Number of tiles */
+	u32 First;			/**< First tile loaded by this loader */
+	u32 Stride;			/**< Distance to the next tile to load */
+	const XAieLib_ElfImg *ImgPtr;	/**< Image to load */
+	u32 Status;			/**< Result of the loader */
+} XAieLib_ElfLoader;
+#endif
+
+/************************** Function Prototypes  *****************************/
+static void XAieLib_TxnSync(void);
+
 /************************** Function Definitions *****************************/
 
 /*****************************************************************************/
@@ -235,6 +378,174 @@ u32 XAieLib_LoadElfMem(XAieGbl_Tile *TileInstPtr, u8 *ElfPtr, u8 LoadSym)
 #endif
 }
 
+/*****************************************************************************/
+/**
+*
+* This API parses the elf in memory once into an image, which can then be
+* loaded into many tiles with XAieLib_LoadElfImg().
+*
+* @param	ElfPtr: pointer to the elf in memory
+*
+* @return	Pointer to the image on success, otherwise XAIE_NULL
+*
+* @note		The image holds its own copy of the sections. It should be
+*		released with XAieLib_ElfImgFree().
+*
+*******************************************************************************/
+XAieLib_ElfImg *XAieLib_ElfImgCreate(u8 *ElfPtr)
+{
+#ifdef __AIESIM__
+	return XAIE_NULL;
+#elif defined __AIEBAREMTL__
+	return XAIE_NULL;
+#else
+	return XAieSim_ElfImgCreate(ElfPtr);
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* This API releases the image from XAieLib_ElfImgCreate().
+*
+* @param	ImgPtr: image to be released
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+void XAieLib_ElfImgFree(XAieLib_ElfImg *ImgPtr)
+{
+#if !defined __AIESIM__ && !defined __AIEBAREMTL__
+	XAieSim_ElfImgFree(ImgPtr);
+#endif
+}
+
+#if !defined __AIESIM__ && !defined __AIEBAREMTL__
+/*****************************************************************************/
+/**
+*
+* This is the internal function to load the image into every Stride'th tile
+* of the list, starting from the First.
+*
+* @param	Arg: Pointer to the XAieLib_ElfLoader.
+*
+* @return	XAIE_NULL. The result is stored in the loader.
+*
+* @note		Used only in this file. Runs as a thread.
+*
+*******************************************************************************/
+static void *XAieLib_ElfLoadWorker(void *Arg)
+{
+	XAieLib_ElfLoader *Loader = (XAieLib_ElfLoader *)Arg;
+	u32 Idx;
+
+	Loader->Status = XAIELIB_SUCCESS;
+	for (Idx = Loader->First; Idx < Loader->NumTiles;
+	     Idx += Loader->Stride) {
+		if (XAieSim_ElfImgLoad(Loader->TileInstPtrs[Idx],
+				       Loader->ImgPtr) != XAIESIM_SUCCESS) {
+			Loader->Status = XAIELIB_FAILURE;
+		}
+	}
+
+	return XAIE_NULL;
+}
+#endif
+
+/*****************************************************************************/
+/**
+*
+* This API loads the image of an elf to the list of tiles. The tiles are
+* spread over multiple threads, and each section is written with bursts.
+*
+* @param	TileInstPtrs: array of tile instances for the elf to be loaded
+* @param	NumTiles: number of tiles in the array
+* @param	ImgPtr: image from XAieLib_ElfImgCreate()
+* @param	NumThreads: number of threads to use, or 0 to use one per
+*		online CPU
+*
+* @return	XAIELIB_SUCCESS on success, otherwise XAIELIB_FAILURE
+*
+* @note		The number of threads is limited by the number of tiles and
+*		XAIELIB_ELF_MAX_THREADS. An active transaction is flushed first.
+*		The stack range and symbols are not set up as XAieLib_LoadElf()
+*		does for the simulation.
+*
+*******************************************************************************/
+u32 XAieLib_LoadElfImg(XAieGbl_Tile **TileInstPtrs, u32 NumTiles,
+		const XAieLib_ElfImg *ImgPtr, u32 NumThreads)
+{
+#ifdef __AIESIM__
+	return XAIELIB_FAILURE;
+#elif defined __AIEBAREMTL__
+	return XAIELIB_FAILURE;
+#else
+	XAieLib_ElfLoader Loaders[XAIELIB_ELF_MAX_THREADS];
+	pthread_t Threads[XAIELIB_ELF_MAX_THREADS];
+	u8 Started[XAIELIB_ELF_MAX_THREADS];
+	u32 Status = XAIELIB_SUCCESS;
+	long NumCpus;
+	u32 Idx;
+
+	if ((TileInstPtrs == XAIE_NULL) || (ImgPtr == XAIE_NULL)) {
+		return XAIELIB_FAILURE;
+	}
+
+	if (NumThreads == 0U) {
+		NumCpus = sysconf(_SC_NPROCESSORS_ONLN);
+		NumThreads = (NumCpus > 0) ? (u32)NumCpus : 1U;
+	}
+	if (NumThreads > XAIELIB_ELF_MAX_THREADS) {
+		NumThreads = XAIELIB_ELF_MAX_THREADS;
+	}
+	if (NumThreads > NumTiles) {
+		NumThreads = NumTiles;
+	}
+	if (NumThreads == 0U) {
+		return XAIELIB_SUCCESS;
+	}
+
+	/* Writes recorded before the load should reach the device first */
+	XAieLib_TxnSync();
+
+	for (Idx = 0U; Idx < NumThreads; Idx++) {
+		Loaders[Idx].TileInstPtrs = TileInstPtrs;
+		Loaders[Idx].NumTiles = NumTiles;
+		Loaders[Idx].First = Idx;
+		Loaders[Idx].Stride = NumThreads;
+		Loaders[Idx].ImgPtr = ImgPtr;
+		Started[Idx] = 0U;
+	}
+
+	/* The calling thread takes the first share */
+	for (Idx = 1U; Idx < NumThreads; Idx++) {
+		if (pthread_create(&Threads[Idx], XAIE_NULL,
+				   XAieLib_ElfLoadWorker, &Loaders[Idx]) == 0) {
+			Started[Idx] = 1U;
+		}
+	}
+
+	for (Idx = 0U; Idx < NumThreads; Idx++) {
+		if (Started[Idx] == 0U) {
+			(void)XAieLib_ElfLoadWorker(&Loaders[Idx]);
+		}
+	}
+
+	for (Idx = 0U; Idx < NumThreads; Idx++) {
+		if (Started[Idx] != 0U) {
+			(void)pthread_join(Threads[Idx], XAIE_NULL);
+		}
+		if (Loaders[Idx].Status != XAIELIB_SUCCESS) {
+			Status = XAIELIB_FAILURE;
+		}
+	}
+
+	return Status;
+#endif
+}
+
 /*****************************************************************************/
 /**
 *
@@ -882,21 +1193,21 @@ u32 XAieLib_MemRead32(XAieLib_MemInst *XAieLib_MemInstPtr, u64 Addr)
 /*****************************************************************************/
 /**
 *
-* This is the memory IO function to read 32bit data from the specified address.
+* This is the internal function to read 32bit data from the device.
 *
 * @param	Addr: Address to read from.
 *
 * @return	32-bit read value.
 *
-* @note		None.
+* @note		Used only in this file. Bypasses the transaction.
 *
 *******************************************************************************/
-u32 XAieLib_Read32(u64 Addr)
+static u32 XAieLib_IORead32(u64 Addr)
 {
 #ifdef __AIESIM__
 	return(XAieSim_Read32(Addr));
 #elif defined __AIEBAREMTL__
-        return(Xil_In32(Addr));
+	return(Xil_In32(Addr));
 #else
 	return(XAieIO_Read32(Addr));
 #endif
@@ -905,158 +1216,1138 @@ u32 XAieLib_Read32(u64 Addr)
 /*****************************************************************************/
 /**
 *
-* This is the memory IO function to read 128b data from the specified address.
+* This is the internal function to write 32bit data to the device.
 *
-* @param	Addr: Address to read from.
-* @param	Data: Pointer to the 128-bit buffer to store the read data.
+* @param	Addr: Address to write to.
+* @param	Data: 32-bit data to be written.
 *
 * @return	None.
 *
-* @note		None.
+* @note		Used only in this file. Bypasses the transaction.
 *
 *******************************************************************************/
-void XAieLib_Read128(u64 Addr, u32 *Data)
+static void XAieLib_IOWrite32(u64 Addr, u32 Data)
 {
-	u8 Idx;
-
-	for(Idx = 0U; Idx < 4U; Idx++) {
 #ifdef __AIESIM__
-		Data[Idx] = XAieSim_Read32(Addr + Idx*4U);
+	XAieSim_Write32(Addr, Data);
 #elif defined __AIEBAREMTL__
-		Data[Idx] = Xil_In32(Addr + Idx*4U);
+	Xil_Out32(Addr, Data);
 #else
-		Data[Idx] = XAieIO_Read32(Addr + Idx*4U);
+	XAieIO_Write32(Addr, Data);
 #endif
-	}
 }
 
 /*****************************************************************************/
 /**
 *
-* This is the memory IO function to write 32bit data to the specified address.
+* This is the internal function to write a masked 32bit data to the device.
 *
 * @param	Addr: Address to write to.
+* @param	Mask: Mask to be applied to Data.
 * @param	Data: 32-bit data to be written.
 *
 * @return	None.
 *
-* @note		None.
+* @note		Used only in this file. Bypasses the transaction.
 *
 *******************************************************************************/
-void XAieLib_Write32(u64 Addr, u32 Data)
+static void XAieLib_IOMaskWrite32(u64 Addr, u32 Mask, u32 Data)
 {
 #ifdef __AIESIM__
-	XAieSim_Write32(Addr, Data);
-#elif defined __AIEBAREMTL__
-        Xil_Out32(Addr, Data);
+	XAieSim_MaskWrite32(Addr, Mask, Data);
 #else
-	XAieIO_Write32(Addr, Data);
+	u32 RegVal;
+
+	RegVal = XAieLib_IORead32(Addr);
+	RegVal &= ~Mask;
+	RegVal |= Data;
+	XAieLib_IOWrite32(Addr, RegVal);
 #endif
 }
 
 /*****************************************************************************/
 /**
 *
-* This is the memory IO function to write a masked 32bit data to
-* the specified address.
+* This is the internal function to write consecutive 32bit words to
+* sequential addresses of the device.
 *
-* @param	Addr: Address to write to.
-* @param	Mask: Mask to be applied to Data.
-* @param	Data: 32-bit data to be written.
+* @param	Addr: Address of the first word.
+* @param	Data: Words to be written.
+* @param	Count: Number of words.
 *
 * @return	None.
 *
-* @note		None.
+* @note		Used only in this file. Bypasses the transaction.
 *
 *******************************************************************************/
-void XAieLib_MaskWrite32(u64 Addr, u32 Mask, u32 Data)
+static void XAieLib_IOWriteBurst32(u64 Addr, const u32 *Data, u32 Count)
 {
-	u32 RegVal;
+#if defined __AIESIM__ || defined __AIEBAREMTL__
+	u32 Idx;
 
-#ifdef __AIESIM__
-	XAieSim_MaskWrite32(Addr, Mask, Data);
-#elif defined __AIEBAREMTL__
-        RegVal = Xil_In32(Addr);
-	RegVal &= ~Mask;
-	RegVal |= Data;
-        Xil_Out32(Addr, RegVal);
+	for (Idx = 0U; Idx < Count; Idx++) {
+		XAieLib_IOWrite32(Addr + Idx * 4U, Data[Idx]);
+	}
 #else
-	RegVal = XAieIO_Read32(Addr);
-	RegVal &= ~Mask;
-	RegVal |= Data;
-	XAieIO_Write32(Addr, RegVal);
+	XAieIO_WriteBurst32(Addr, Data, Count);
 #endif
 }
 
 /*****************************************************************************/
 /**
 *
-* This is the memory IO function to write 128bit data to the specified address.
+* This is the internal function to check if a write to a register has a side
+* effect besides setting its value, ex generating an event, pushing a DMA
+* start queue or pulsing a reset. Such writes can't be merged or dropped.
 *
-* @param	Addr: Address to write to.
-* @param	Data: Pointer to the 128-bit data buffer.
+* @param	Addr: Register address.
 *
-* @return	None.
+* @return	1 for such a register, otherwise 0.
 *
-* @note		None.
+* @note		Row 0 holds the shim tiles. Used only in this file.
 *
 *******************************************************************************/
-void XAieLib_Write128(u64 Addr, u32 *Data)
+static u8 XAieLib_IsTriggerReg(u64 Addr)
 {
-#ifdef __AIESIM__
-	XAieSim_Write128(Addr, Data);
-#elif defined __AIEBAREMTL__
-	u8 Idx;
+	const XAieLib_RegRange *Ranges;
+	u32 Offset = (u32)(Addr & XAIELIB_SHADOW_TILE_MASK);
+	u32 NumRanges, Idx;
+
+	if (((Addr >> XAIEGBL_TILE_ADDR_ROW_SHIFT) & XAIELIB_TILE_ROW_MASK) ==
+	    0U) {
+		Ranges = XAieLib_ShimTrigRegs;
+		NumRanges = sizeof(XAieLib_ShimTrigRegs) /
+			sizeof(XAieLib_ShimTrigRegs[0U]);
+	} else {
+		Ranges = XAieLib_AieTrigRegs;
+		NumRanges = sizeof(XAieLib_AieTrigRegs) /
+			sizeof(XAieLib_AieTrigRegs[0U]);
+	}
 
-	for(Idx = 0U; Idx < 4U; Idx++) {
-		Xil_Out32((u32)Addr + Idx * 4U, Data[Idx]);
+	for (Idx = 0U; Idx < NumRanges; Idx++) {
+		if ((Offset >= Ranges[Idx].Start) &&
+		    (Offset < Ranges[Idx].End)) {
+			return 1U;
+		}
 	}
-#else
-	XAieIO_Write128(Addr, Data);
-#endif
+
+	return 0U;
 }
 
 /*****************************************************************************/
 /**
 *
-* This is the memory IO function to write 128bit data to the specified address.
+* This is the internal function to record a write into the transaction.
+* A masked write to the same configuration register as the previously recorded
+* one is merged into it, and the transaction is flushed when it is full.
+* Writes to trigger registers are never merged, so each of them reaches the
+* device, in order.
 *
 * @param	Addr: Address to write to.
-* @param	Data: Pointer to the 128-bit data buffer.
+* @param	Mask: Mask to be applied, XAIELIB_TXN_FULL_MASK for a plain write.
+* @param	Data: 32-bit data to be written.
 *
 * @return	None.
 *
-* @note		None.
+* @note		Used only in this file.
 *
 *******************************************************************************/
-void XAieLib_WriteCmd(u8 Command, u8 ColId, u8 RowId, u32 CmdWd0,
-						u32 CmdWd1, u8 *CmdStr)
+static void XAieLib_TxnRecord(u64 Addr, u32 Mask, u32 Data)
 {
-#ifdef __AIESIM__
-	XAieSim_WriteCmd(Command, ColId, RowId, CmdWd0, CmdWd1, CmdStr);
-#elif defined __AIEBAREMTL__
-#endif
+	XAieLib_Txn *Txn = &XAieLib_TxnInst;
+	XAieLib_TxnCmd *Cmd;
+	u8 Trigger = XAieLib_IsTriggerReg(Addr);
+
+	Txn->Stats.NumRecorded++;
+
+	if ((Txn->NumCmds > 0U) && (Trigger == 0U)) {
+		Cmd = &Txn->Cmds[Txn->NumCmds - 1U];
+		if (Cmd->Addr == Addr) {
+			/* Same result as applying both writes in order */
+			Cmd->Data = (Cmd->Data & ~Mask) | Data;
+			Cmd->Mask |= Mask;
+			Txn->Stats.NumMerged++;
+			return;
+		}
+	}
+
+	if (Txn->NumCmds == Txn->MaxCmds) {
+		(void)XAieLib_TxnFlush();
+	}
+
+	Cmd = &Txn->Cmds[Txn->NumCmds++];
+	Cmd->Addr = Addr;
+	Cmd->Mask = Mask;
+	Cmd->Data = Data;
+	Cmd->Trigger = Trigger;
 }
 
 /*****************************************************************************/
 /**
 *
-* This is the IO function to poll until the value at the address to be given
-* masked value.
+* This API starts a transaction. Until XAieLib_TxnEnd(), register writes and
+* mask writes issued through this layer are recorded into a command buffer
+* instead of being applied to the device, and are applied in order by
+* XAieLib_TxnFlush(). Writes to sequential addresses are applied as one burst.
+* Writes with a side effect, ex event generation, DMA start queue pushes or
+* resets, are neither merged nor part of a burst.
 *
-* @param	Addr: Address to write to.
-* @param	Mask: Mask to be applied to read data.
-* @param	Value: The expected value
-* @param	TimeOutUs: Minimum timeout in usec.
+* @param	NumCmds: Number of commands to buffer before an implicit flush.
+*		0 selects XAIELIB_TXN_DEF_NUM_CMDS.
 *
-* @return	XAIELIB_SUCCESS on success, otherwise XAIELIB_FAILURE
+* @return	XAIELIB_SUCCESS on success, otherwise XAIELIB_FAILURE.
+*
+* @note		Any read through this layer flushes the transaction first, so
+*		read-after-write ordering is preserved. Transactions can't be
+*		nested, and the transaction is not thread safe.
+*
+*******************************************************************************/
+u32 XAieLib_TxnBegin(u32 NumCmds)
+{
+	XAieLib_Txn *Txn = &XAieLib_TxnInst;
+
+	if (Txn->Active != 0U) {
+		XAieLib_print("Error: transaction already started\n");
+		return XAIELIB_FAILURE;
+	}
+
+	if (NumCmds == 0U) {
+		NumCmds = XAIELIB_TXN_DEF_NUM_CMDS;
+	}
+
+	Txn->Cmds = malloc(NumCmds * sizeof(*Txn->Cmds));
+	Txn->Burst = malloc(NumCmds * sizeof(*Txn->Burst));
+	if ((Txn->Cmds == XAIE_NULL) || (Txn->Burst == XAIE_NULL)) {
+		free(Txn->Cmds);
+		free(Txn->Burst);
+		Txn->Cmds = XAIE_NULL;
+		Txn->Burst = XAIE_NULL;
+		return XAIELIB_FAILURE;
+	}
+
+	Txn->NumCmds = 0U;
+	Txn->MaxCmds = NumCmds;
+	Txn->Active = 1U;
+
+	return XAIELIB_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API applies all commands recorded in the transaction to the device, in
+* order. Runs of plain writes to sequential addresses are written as one
+* burst, and mask writes are applied as read-modify-write.
+*
+* @param	None.
+*
+* @return	XAIELIB_SUCCESS on success, otherwise XAIELIB_FAILURE if there
+*		is no transaction.
+*
+* @note		The transaction stays active.
+*
+*******************************************************************************/
+u32 XAieLib_TxnFlush(void)
+{
+	XAieLib_Txn *Txn = &XAieLib_TxnInst;
+	XAieLib_TxnCmd *Cmd;
+	u32 Idx, Count;
+
+	if (Txn->Active == 0U) {
+		return XAIELIB_FAILURE;
+	}
+
+	Idx = 0U;
+	while (Idx < Txn->NumCmds) {
+		Cmd = &Txn->Cmds[Idx];
+
+		if (Cmd->Mask != XAIELIB_TXN_FULL_MASK) {
+			XAieLib_IOMaskWrite32(Cmd->Addr, Cmd->Mask, Cmd->Data);
+			Txn->Stats.NumWrites++;
+			Idx++;
+			continue;
+		}
+
+		/* Trigger registers are written one by one */
+		Count = 0U;
+		do {
+			Txn->Burst[Count++] = Txn->Cmds[Idx++].Data;
+		} while ((Cmd->Trigger == 0U) && (Idx < Txn->NumCmds) &&
+			 (Txn->Cmds[Idx].Mask == XAIELIB_TXN_FULL_MASK) &&
+			 (Txn->Cmds[Idx].Trigger == 0U) &&
+			 (Txn->Cmds[Idx].Addr == Cmd->Addr + Count * 4U));
+
+		if (Count == 1U) {
+			XAieLib_IOWrite32(Cmd->Addr, Txn->Burst[0U]);
+		} else {
+			XAieLib_IOWriteBurst32(Cmd->Addr, Txn->Burst, Count);
+			Txn->Stats.NumBursts++;
+		}
+		Txn->Stats.NumWrites += Count;
+	}
+
+	Txn->NumCmds = 0U;
+	Txn->Stats.NumFlushes++;
+
+	return XAIELIB_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API flushes and ends the transaction started by XAieLib_TxnBegin().
+* Register writes are applied directly again afterwards.
+*
+* @param	None.
+*
+* @return	XAIELIB_SUCCESS on success, otherwise XAIELIB_FAILURE if there
+*		is no transaction.
 *
 * @note		None.
 *
 *******************************************************************************/
-u32 XAieLib_MaskPoll(u64 Addr, u32 Mask, u32 Value, u32 TimeOutUs)
+u32 XAieLib_TxnEnd(void)
 {
-	u32 Ret = XAIELIB_FAILURE;
+	XAieLib_Txn *Txn = &XAieLib_TxnInst;
+
+	if (XAieLib_TxnFlush() != XAIELIB_SUCCESS) {
+		return XAIELIB_FAILURE;
+	}
+
+	free(Txn->Cmds);
+	free(Txn->Burst);
+	Txn->Cmds = XAIE_NULL;
+	Txn->Burst = XAIE_NULL;
+	Txn->MaxCmds = 0U;
+	Txn->Active = 0U;
+
+	return XAIELIB_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API returns the statistics accumulated by all transactions since the
+* last call to XAieLib_TxnResetStats().
+*
+* @param	Stats: Pointer to the statistics to fill.
+*
+* @return	None.
+*
+* @note		NumRecorded - NumMerged commands reached the flush, and were
+*		applied with NumWrites - NumBursts device accesses.
+*
+*******************************************************************************/
+void XAieLib_TxnGetStats(XAieLib_TxnStats *Stats)
+{
+	*Stats = XAieLib_TxnInst.Stats;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API clears the transaction statistics.
+*
+* @param	None.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+void XAieLib_TxnResetStats(void)
+{
+	memset(&XAieLib_TxnInst.Stats, 0, sizeof(XAieLib_TxnInst.Stats));
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the internal function to flush pending transaction commands before
+* an access which bypasses the transaction.
+*
+* @param	None.
+*
+* @return	None.
+*
+* @note		Used only in this file.
+*
+*******************************************************************************/
+static void XAieLib_TxnSync(void)
+{
+	if ((XAieLib_TxnInst.Active != 0U) && (XAieLib_TxnInst.NumCmds > 0U)) {
+		(void)XAieLib_TxnFlush();
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the internal function to send a write towards the device, through
+* the transaction if one is active.
+*
+* @param	Addr: Address to write to.
+* @param	Mask: Mask to be applied, XAIELIB_TXN_FULL_MASK for a plain write.
+* @param	Data: 32-bit data to be written.
+*
+* @return	None.
+*
+* @note		Used only in this file.
+*
+*******************************************************************************/
+static void XAieLib_Out32(u64 Addr, u32 Mask, u32 Data)
+{
+	if (XAieLib_TxnInst.Active != 0U) {
+		XAieLib_TxnRecord(Addr, Mask, Data);
+	} else if (Mask == XAIELIB_TXN_FULL_MASK) {
+		XAieLib_IOWrite32(Addr, Data);
+	} else {
+		XAieLib_IOMaskWrite32(Addr, Mask, Data);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the internal function to find the shadow of a tile.
+*
+* @param	TileAddr: Base address of the tile.
+*
+* @return	Pointer to the shadow, or XAIE_NULL if the tile isn't shadowed.
+*
+* @note		Used only in this file.
+*
+*******************************************************************************/
+static XAieLib_Shadow *XAieLib_ShadowGet(u64 TileAddr)
+{
+	XAieLib_Shadow *Shadow = XAieLib_ShadowLast;
+
+	if ((Shadow != XAIE_NULL) && (Shadow->TileAddr == TileAddr)) {
+		return Shadow;
+	}
+
+	Shadow = XAieLib_ShadowTbl[(TileAddr >> XAIEGBL_TILE_ADDR_ROW_SHIFT) %
+			XAIELIB_SHADOW_NUM_BUCKETS];
+	while ((Shadow != XAIE_NULL) && (Shadow->TileAddr != TileAddr)) {
+		Shadow = Shadow->Next;
+	}
+	if (Shadow != XAIE_NULL) {
+		XAieLib_ShadowLast = Shadow;
+	}
+
+	return Shadow;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the internal function to find the shadow of the tile containing the
+* given register.
+*
+* @param	Addr: Register address.
+*
+* @return	Pointer to the shadow, or XAIE_NULL if the register isn't
+*		shadowed.
+*
+* @note		Data and program memory of AIE tiles and trigger registers are
+*		never shadowed. Used only in this file.
+*
+*******************************************************************************/
+static XAieLib_Shadow *XAieLib_ShadowFind(u64 Addr)
+{
+	XAieLib_Shadow *Shadow;
+	u32 Offset;
+
+	if (XAieLib_ShadowNumTiles == 0U) {
+		return XAIE_NULL;
+	}
+
+	Shadow = XAieLib_ShadowGet(Addr & ~(u64)XAIELIB_SHADOW_TILE_MASK);
+	if (Shadow == XAIE_NULL) {
+		return XAIE_NULL;
+	}
+
+	Offset = (u32)(Addr & XAIELIB_SHADOW_TILE_MASK);
+	if ((Shadow->TileType == XAIEGBL_TILE_TYPE_AIETILE) &&
+	    ((Offset < XAIELIB_SHADOW_AIE_DMEM_END) ||
+	     ((Offset >= XAIEGBL_CORE_PRGMEM) &&
+	      (Offset < XAIEGBL_CORE_CORER0)))) {
+		return XAIE_NULL;
+	}
+	if (XAieLib_IsTriggerReg(Addr) != 0U) {
+		return XAIE_NULL;
+	}
+
+	return Shadow;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the internal function to look up a register in a tile shadow.
+*
+* @param	Shadow: Shadow of the tile.
+* @param	Offset: Register offset in the tile.
+* @param	Insert: Non 0 to add the register if it's not cached.
+*
+* @return	Pointer to the entry, or XAIE_NULL if the register isn't
+*		cached, or can't be added.
+*
+* @note		Used only in this file.
+*
+*******************************************************************************/
+static XAieLib_ShadowReg *XAieLib_ShadowLookup(XAieLib_Shadow *Shadow,
+		u32 Offset, u8 Insert)
+{
+	XAieLib_ShadowReg *Regs, *Reg;
+	u32 Idx, OldMax;
+
+	Idx = ((Offset >> 2U) * 2654435761U) & (Shadow->MaxRegs - 1U);
+	while (Shadow->Regs[Idx].Valid != 0U) {
+		if (Shadow->Regs[Idx].Offset == Offset) {
+			return &Shadow->Regs[Idx];
+		}
+		Idx = (Idx + 1U) & (Shadow->MaxRegs - 1U);
+	}
+
+	if (Insert == 0U) {
+		return XAIE_NULL;
+	}
+
+	/* Keep the table at most 3/4 full */
+	if ((Shadow->NumRegs + 1U) * 4U > Shadow->MaxRegs * 3U) {
+		Regs = calloc(Shadow->MaxRegs * 2U, sizeof(*Regs));
+		if (Regs == XAIE_NULL) {
+			return XAIE_NULL;
+		}
+		OldMax = Shadow->MaxRegs;
+		Reg = Shadow->Regs;
+		Shadow->Regs = Regs;
+		Shadow->MaxRegs = OldMax * 2U;
+		Shadow->NumRegs = 0U;
+		for (Idx = 0U; Idx < OldMax; Idx++) {
+			if (Reg[Idx].Valid != 0U) {
+				*XAieLib_ShadowLookup(Shadow, Reg[Idx].Offset,
+						      1U) = Reg[Idx];
+			}
+		}
+		free(Reg);
+		return XAieLib_ShadowLookup(Shadow, Offset, 1U);
+	}
+
+	Reg = &Shadow->Regs[Idx];
+	Reg->Offset = Offset;
+	Reg->Value = 0U;
+	Reg->Valid = 1U;
+	Reg->Dirty = 0U;
+	Shadow->NumRegs++;
+
+	return Reg;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the internal function to apply a write to a shadowed register.
+* A mask write to a cached register is served without reading the device.
+* In write-through mode the full register value is written out, in write-back
+* mode the register is only marked dirty if its value changes.
+*
+* @param	Shadow: Shadow of the tile.
+* @param	Addr: Register address.
+* @param	Mask: Mask to be applied, XAIELIB_TXN_FULL_MASK for a plain write.
+* @param	Data: 32-bit data to be written.
+*
+* @return	None.
+*
+* @note		Used only in this file.
+*
+*******************************************************************************/
+static void XAieLib_ShadowWrite(XAieLib_Shadow *Shadow, u64 Addr, u32 Mask,
+		u32 Data)
+{
+	XAieLib_ShadowReg *Reg;
+	u32 Offset = (u32)(Addr & XAIELIB_SHADOW_TILE_MASK);
+	u32 Value;
+	u8 Cached;
+
+	Cached = (XAieLib_ShadowLookup(Shadow, Offset, 0U) != XAIE_NULL);
+	Reg = XAieLib_ShadowLookup(Shadow, Offset, 1U);
+	if (Reg == XAIE_NULL) {
+		/* Out of memory, fall back to the device */
+		XAieLib_Out32(Addr, Mask, Data);
+		return;
+	}
+
+	if (Mask != XAIELIB_TXN_FULL_MASK) {
+		if (Cached != 0U) {
+			Shadow->Stats.NumHits++;
+		} else {
+			XAieLib_TxnSync();
+			Reg->Value = XAieLib_IORead32(Addr);
+			Shadow->Stats.NumMisses++;
+		}
+	}
+	Value = (Reg->Value & ~Mask) | Data;
+
+	if (Shadow->Mode == XAIELIB_SHADOW_WRBACK) {
+		if ((Cached != 0U) && (Reg->Dirty == 0U) &&
+		    (Reg->Value == Value)) {
+			Shadow->Stats.NumSkipped++;
+			return;
+		}
+		Reg->Value = Value;
+		if (Reg->Dirty == 0U) {
+			Reg->Dirty = 1U;
+			Shadow->NumDirty++;
+		}
+		return;
+	}
+
+	Reg->Value = Value;
+	XAieLib_Out32(Addr, XAIELIB_TXN_FULL_MASK, Value);
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the internal function to order dirty registers by offset.
+*
+* @param	A: First register.
+* @param	B: Second register.
+*
+* @return	Negative, 0 or positive as for qsort().
+*
+* @note		Used only in this file.
+*
+*******************************************************************************/
+static int XAieLib_ShadowCmp(const void *A, const void *B)
+{
+	u32 OffA = ((const XAieLib_ShadowReg *)A)->Offset;
+	u32 OffB = ((const XAieLib_ShadowReg *)B)->Offset;
+
+	return (OffA > OffB) - (OffA < OffB);
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the internal function to write back the dirty registers of a tile,
+* in ascending offset order.
+*
+* @param	Shadow: Shadow of the tile.
+*
+* @return	XAIELIB_SUCCESS on success, otherwise XAIELIB_FAILURE.
+*
+* @note		Used only in this file.
+*
+*******************************************************************************/
+static u32 XAieLib_ShadowWriteBack(XAieLib_Shadow *Shadow)
+{
+	XAieLib_ShadowReg *Dirty;
+	u32 Idx, Count = 0U;
+
+	if (Shadow->NumDirty == 0U) {
+		return XAIELIB_SUCCESS;
+	}
+
+	Dirty = malloc(Shadow->NumDirty * sizeof(*Dirty));
+	if (Dirty == XAIE_NULL) {
+		return XAIELIB_FAILURE;
+	}
+
+	for (Idx = 0U; Idx < Shadow->MaxRegs; Idx++) {
+		if ((Shadow->Regs[Idx].Valid != 0U) &&
+		    (Shadow->Regs[Idx].Dirty != 0U)) {
+			Shadow->Regs[Idx].Dirty = 0U;
+			Dirty[Count++] = Shadow->Regs[Idx];
+		}
+	}
+	qsort(Dirty, Count, sizeof(*Dirty), XAieLib_ShadowCmp);
+
+	for (Idx = 0U; Idx < Count; Idx++) {
+		XAieLib_Out32(Shadow->TileAddr + Dirty[Idx].Offset,
+			      XAIELIB_TXN_FULL_MASK, Dirty[Idx].Value);
+	}
+	Shadow->Stats.NumWrittenBack += Count;
+	Shadow->NumDirty = 0U;
+	free(Dirty);
+
+	return XAIELIB_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the internal function to write back the dirty registers of a tile
+* before a write to one of its trigger registers, so that ex a DMA start
+* queue push sees the BD configuration written before it.
+*
+* @param	Addr: Address of the register about to be written.
+*
+* @return	None.
+*
+* @note		Used only in this file.
+*
+*******************************************************************************/
+static void XAieLib_ShadowSync(u64 Addr)
+{
+	XAieLib_Shadow *Shadow;
+
+	if (XAieLib_ShadowNumTiles == 0U) {
+		return;
+	}
+
+	Shadow = XAieLib_ShadowGet(Addr & ~(u64)XAIELIB_SHADOW_TILE_MASK);
+	if ((Shadow == XAIE_NULL) || (Shadow->NumDirty == 0U) ||
+	    (XAieLib_IsTriggerReg(Addr) == 0U)) {
+		return;
+	}
+
+	(void)XAieLib_ShadowWriteBack(Shadow);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API enables the shadow register cache of a tile. Register values are
+* remembered as they are written, so later mask writes to the same register
+* don't need to read the device.
+*
+* @param	TileInstPtr: Tile instance.
+* @param	Mode: XAIELIB_SHADOW_WRTHROUGH to write every change to the
+*		device, or XAIELIB_SHADOW_WRBACK to hold changes until
+*		XAieLib_ShadowFlush().
+*
+* @return	XAIELIB_SUCCESS on success, otherwise XAIELIB_FAILURE.
+*
+* @note		The cache assumes the cached registers are only changed through
+*		this driver. Don't cache tiles whose configuration the hardware
+*		updates, or call XAieLib_ShadowInvalidate() after it did, ex
+*		after a reset. In write-back mode, writes which leave a register
+*		unchanged are dropped, and the write back doesn't keep the order
+*		between registers, so flush before anything relying on it, ex
+*		enabling a DMA channel. Data and program memory aren't cached.
+*		Trigger registers, ex event generation, DMA start queues or
+*		resets, aren't cached either: each write to them reaches the
+*		device, after the dirty registers of the tile are written back.
+*
+*******************************************************************************/
+u32 XAieLib_ShadowEnable(XAieGbl_Tile *TileInstPtr, u8 Mode)
+{
+	XAieLib_Shadow *Shadow;
+	u32 Bucket;
+
+	XAie_AssertNonvoid(TileInstPtr != XAIE_NULL);
+	XAie_AssertNonvoid((Mode == XAIELIB_SHADOW_WRTHROUGH) ||
+			   (Mode == XAIELIB_SHADOW_WRBACK));
+
+	Shadow = XAieLib_ShadowGet(TileInstPtr->TileAddr);
+	if (Shadow != XAIE_NULL) {
+		if ((Mode == XAIELIB_SHADOW_WRTHROUGH) &&
+		    (XAieLib_ShadowWriteBack(Shadow) != XAIELIB_SUCCESS)) {
+			return XAIELIB_FAILURE;
+		}
+		Shadow->Mode = Mode;
+		return XAIELIB_SUCCESS;
+	}
+
+	Shadow = calloc(1U, sizeof(*Shadow));
+	if (Shadow == XAIE_NULL) {
+		return XAIELIB_FAILURE;
+	}
+	Shadow->Regs = calloc(XAIELIB_SHADOW_DEF_NUM_REGS,
+			      sizeof(*Shadow->Regs));
+	if (Shadow->Regs == XAIE_NULL) {
+		free(Shadow);
+		return XAIELIB_FAILURE;
+	}
+	Shadow->TileAddr = TileInstPtr->TileAddr;
+	Shadow->TileType = TileInstPtr->TileType;
+	Shadow->Mode = Mode;
+	Shadow->MaxRegs = XAIELIB_SHADOW_DEF_NUM_REGS;
+
+	Bucket = (TileInstPtr->TileAddr >> XAIEGBL_TILE_ADDR_ROW_SHIFT) %
+		XAIELIB_SHADOW_NUM_BUCKETS;
+	Shadow->Next = XAieLib_ShadowTbl[Bucket];
+	XAieLib_ShadowTbl[Bucket] = Shadow;
+	XAieLib_ShadowNumTiles++;
+
+	return XAIELIB_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API writes back the dirty registers of a tile in write-back mode.
+* With a transaction active, registers at sequential offsets are written as
+* a burst at the transaction flush.
+*
+* @param	TileInstPtr: Tile instance, or XAIE_NULL for all shadowed tiles.
+*
+* @return	XAIELIB_SUCCESS on success, otherwise XAIELIB_FAILURE.
+*
+* @note		Only the registers changed since the last flush are written.
+*
+*******************************************************************************/
+u32 XAieLib_ShadowFlush(XAieGbl_Tile *TileInstPtr)
+{
+	XAieLib_Shadow *Shadow;
+	u32 Bucket, Ret = XAIELIB_SUCCESS;
+
+	if (TileInstPtr != XAIE_NULL) {
+		Shadow = XAieLib_ShadowGet(TileInstPtr->TileAddr);
+		if (Shadow == XAIE_NULL) {
+			return XAIELIB_FAILURE;
+		}
+		return XAieLib_ShadowWriteBack(Shadow);
+	}
+
+	for (Bucket = 0U; Bucket < XAIELIB_SHADOW_NUM_BUCKETS; Bucket++) {
+		for (Shadow = XAieLib_ShadowTbl[Bucket]; Shadow != XAIE_NULL;
+		     Shadow = Shadow->Next) {
+			Ret |= XAieLib_ShadowWriteBack(Shadow);
+		}
+	}
+
+	return Ret;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API drops all registers cached for a tile, including the dirty ones.
+* The next mask write to each register reads it from the device again.
+*
+* @param	TileInstPtr: Tile instance.
+*
+* @return	None.
+*
+* @note		Use this after the tile registers are changed behind the driver,
+*		ex by a reset.
+*
+*******************************************************************************/
+void XAieLib_ShadowInvalidate(XAieGbl_Tile *TileInstPtr)
+{
+	XAieLib_Shadow *Shadow;
+
+	XAie_AssertVoid(TileInstPtr != XAIE_NULL);
+
+	Shadow = XAieLib_ShadowGet(TileInstPtr->TileAddr);
+	if (Shadow == XAIE_NULL) {
+		return;
+	}
+
+	memset(Shadow->Regs, 0, Shadow->MaxRegs * sizeof(*Shadow->Regs));
+	Shadow->NumRegs = 0U;
+	Shadow->NumDirty = 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API writes back the dirty registers of a tile and disables its shadow.
+*
+* @param	TileInstPtr: Tile instance.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+void XAieLib_ShadowDisable(XAieGbl_Tile *TileInstPtr)
+{
+	XAieLib_Shadow **Link, *Shadow;
+
+	XAie_AssertVoid(TileInstPtr != XAIE_NULL);
+
+	Link = &XAieLib_ShadowTbl[(TileInstPtr->TileAddr >>
+			XAIEGBL_TILE_ADDR_ROW_SHIFT) %
+			XAIELIB_SHADOW_NUM_BUCKETS];
+	while ((*Link != XAIE_NULL) &&
+	       ((*Link)->TileAddr != TileInstPtr->TileAddr)) {
+		Link = &(*Link)->Next;
+	}
+	Shadow = *Link;
+	if (Shadow == XAIE_NULL) {
+		return;
+	}
+
+	(void)XAieLib_ShadowWriteBack(Shadow);
+	*Link = Shadow->Next;
+	if (XAieLib_ShadowLast == Shadow) {
+		XAieLib_ShadowLast = XAIE_NULL;
+	}
+	XAieLib_ShadowNumTiles--;
+	free(Shadow->Regs);
+	free(Shadow);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API returns the shadow statistics of a tile.
+*
+* @param	TileInstPtr: Tile instance.
+* @param	Stats: Pointer to the statistics to fill.
+*
+* @return	XAIELIB_SUCCESS on success, otherwise XAIELIB_FAILURE if the
+*		tile isn't shadowed.
+*
+* @note		None.
+*
+*******************************************************************************/
+u32 XAieLib_ShadowGetStats(XAieGbl_Tile *TileInstPtr,
+		XAieLib_ShadowStats *Stats)
+{
+	XAieLib_Shadow *Shadow;
+
+	XAie_AssertNonvoid(TileInstPtr != XAIE_NULL);
+	XAie_AssertNonvoid(Stats != XAIE_NULL);
+
+	Shadow = XAieLib_ShadowGet(TileInstPtr->TileAddr);
+	if (Shadow == XAIE_NULL) {
+		return XAIELIB_FAILURE;
+	}
+
+	*Stats = Shadow->Stats;
+	Stats->NumCached = Shadow->NumRegs;
+	Stats->NumDirty = Shadow->NumDirty;
+
+	return XAIELIB_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to read 32bit data from the specified address.
+*
+* @param	Addr: Address to read from.
+*
+* @return	32-bit read value.
+*
+* @note		None.
+*
+*******************************************************************************/
+u32 XAieLib_Read32(u64 Addr)
+{
+	XAieLib_Shadow *Shadow;
+	XAieLib_ShadowReg *Reg = XAIE_NULL;
+	u32 Value;
+
+	Shadow = XAieLib_ShadowFind(Addr);
+	if (Shadow != XAIE_NULL) {
+		Reg = XAieLib_ShadowLookup(Shadow,
+				(u32)(Addr & XAIELIB_SHADOW_TILE_MASK), 0U);
+		if ((Reg != XAIE_NULL) && (Reg->Dirty != 0U)) {
+			/* Not written to the device yet */
+			return Reg->Value;
+		}
+	}
+
+	XAieLib_TxnSync();
+	Value = XAieLib_IORead32(Addr);
+	if (Reg != XAIE_NULL) {
+		Reg->Value = Value;
+	}
+
+	return Value;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to read 128b data from the specified address.
+*
+* @param	Addr: Address to read from.
+* @param	Data: Pointer to the 128-bit buffer to store the read data.
+*
+* @return	None.
+*
+* @note		Reads through the shadow if the tile is shadowed, so that
+*		registers not written back yet return their cached value.
+*
+*******************************************************************************/
+void XAieLib_Read128(u64 Addr, u32 *Data)
+{
+	u8 Idx;
+
+	if (XAieLib_ShadowFind(Addr) != XAIE_NULL) {
+		for(Idx = 0U; Idx < 4U; Idx++) {
+			Data[Idx] = XAieLib_Read32(Addr + Idx * 4U);
+		}
+		return;
+	}
+
+	XAieLib_TxnSync();
+	for(Idx = 0U; Idx < 4U; Idx++) {
+		Data[Idx] = XAieLib_IORead32(Addr + Idx*4U);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to write 32bit data to the specified address.
+*
+* @param	Addr: Address to write to.
+* @param	Data: 32-bit data to be written.
+*
+* @return	None.
+*
+* @note		The write is recorded if a transaction is active, and goes
+*		through the shadow if the tile is shadowed.
+*
+*******************************************************************************/
+void XAieLib_Write32(u64 Addr, u32 Data)
+{
+	XAieLib_Shadow *Shadow = XAieLib_ShadowFind(Addr);
+
+	if (Shadow != XAIE_NULL) {
+		XAieLib_ShadowWrite(Shadow, Addr, XAIELIB_TXN_FULL_MASK, Data);
+		return;
+	}
+
+	XAieLib_ShadowSync(Addr);
+	XAieLib_Out32(Addr, XAIELIB_TXN_FULL_MASK, Data);
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to write a masked 32bit data to
+* the specified address.
+*
+* @param	Addr: Address to write to.
+* @param	Mask: Mask to be applied to Data.
+* @param	Data: 32-bit data to be written.
+*
+* @return	None.
+*
+* @note		The write is recorded if a transaction is active, and is served
+*		from the shadow without reading the device if the register is
+*		cached.
+*
+*******************************************************************************/
+void XAieLib_MaskWrite32(u64 Addr, u32 Mask, u32 Data)
+{
+	XAieLib_Shadow *Shadow = XAieLib_ShadowFind(Addr);
+
+	if (Shadow != XAIE_NULL) {
+		XAieLib_ShadowWrite(Shadow, Addr, Mask, Data);
+		return;
+	}
+
+	XAieLib_ShadowSync(Addr);
+	XAieLib_Out32(Addr, Mask, Data);
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to write consecutive 32bit words to
+* sequential addresses.
+*
+* @param	Addr: Address of the first word.
+* @param	Data: Words to be written.
+* @param	Count: Number of words.
+*
+* @return	None.
+*
+* @note		This is meant for the tile memories. The words are written
+*		directly after flushing an active transaction, and don't go
+*		through the shadow. Different threads may write to different
+*		tiles at once, as long as no other register access runs.
+*
+*******************************************************************************/
+void XAieLib_WriteBurst32(u64 Addr, const u32 *Data, u32 Count)
+{
+	XAieLib_TxnSync();
+	XAieLib_IOWriteBurst32(Addr, Data, Count);
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to write 128bit data to the specified address.
+*
+* @param	Addr: Address to write to.
+* @param	Data: Pointer to the 128-bit data buffer.
+*
+* @return	None.
+*
+* @note		The write is recorded if a transaction is active, and goes
+*		through the shadow if the tile is shadowed.
+*
+*******************************************************************************/
+void XAieLib_Write128(u64 Addr, u32 *Data)
+{
+	if ((XAieLib_TxnInst.Active != 0U) ||
+	    (XAieLib_ShadowFind(Addr) != XAIE_NULL)) {
+		u8 Idx;
+
+		for(Idx = 0U; Idx < 4U; Idx++) {
+			XAieLib_Write32(Addr + Idx * 4U, Data[Idx]);
+		}
+		return;
+	}
+
+#ifdef __AIESIM__
+	XAieSim_Write128(Addr, Data);
+#elif defined __AIEBAREMTL__
+	u8 Idx;
+
+	for(Idx = 0U; Idx < 4U; Idx++) {
+		Xil_Out32((u32)Addr + Idx * 4U, Data[Idx]);
+	}
+#else
+	XAieIO_Write128(Addr, Data);
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to write 128bit data to the specified address.
+*
+* @param	Addr: Address to write to.
+* @param	Data: Pointer to the 128-bit data buffer.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+void XAieLib_WriteCmd(u8 Command, u8 ColId, u8 RowId, u32 CmdWd0,
+						u32 CmdWd1, u8 *CmdStr)
+{
+#ifdef __AIESIM__
+	XAieSim_WriteCmd(Command, ColId, RowId, CmdWd0, CmdWd1, CmdStr);
+#elif defined __AIEBAREMTL__
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the IO function to poll until the value at the address to be given
+* masked value.
+*
+* @param	Addr: Address to write to.
+* @param	Mask: Mask to be applied to read data.
+* @param	Value: The expected value
+* @param	TimeOutUs: Minimum timeout in usec.
+*
+* @return	XAIELIB_SUCCESS on success, otherwise XAIELIB_FAILURE
+*
+* @note		None.
+*
+*******************************************************************************/
+u32 XAieLib_MaskPoll(u64 Addr, u32 Mask, u32 Value, u32 TimeOutUs)
+{
+	u32 Ret = XAIELIB_FAILURE;
+
+	XAieLib_TxnSync();
 
 #ifdef __AIESIM__
 	if (XAieSim_MaskPoll(Addr, Mask, Value, TimeOutUs) == XAIESIM_SUCCESS) {
@@ -1104,6 +2395,7 @@ u32 XAieLib_MaskPoll(u64 Addr, u32 Mask, u32 Value, u32 TimeOutUs)
 *******************************************************************************/
 u32 XAieLib_NPIRead32(u64 Addr)
 {
+	XAieLib_TxnSync();
 #ifdef __AIESIM__
 	return XAieSim_NPIRead32(Addr);
 #elif defined __AIEBAREMTL__
@@ -1160,6 +2452,7 @@ static void XAieLib_NPISetLock(u8 Lock)
 *******************************************************************************/
 void XAieLib_NPIWrite32(u64 Addr, u32 Data)
 {
+	XAieLib_TxnSync();
 	XAieLib_NPISetLock(0);
 #ifdef __AIESIM__
 	XAieSim_NPIWrite32(Addr, Data);
@@ -1190,6 +2483,7 @@ void XAieLib_NPIMaskWrite32(u64 Addr, u32 Mask, u32 Data)
 {
 	u32 RegVal;
 
+	XAieLib_TxnSync();
 	XAieLib_NPISetLock(0);
 #ifdef __AIESIM__
 	XAieSim_NPIMaskWrite32(Addr, Mask, Data);
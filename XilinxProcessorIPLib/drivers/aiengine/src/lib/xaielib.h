@@ -26,6 +26,9 @@
 * 1.7  Hyun    01/08/2019  Add XAieLib_MaskPoll()
 * 1.8  Tejus   10/14/2019  Enable assertion for linux and simulation
 * 1.9  Wendy   02/25/2020  Add Logging API
+* 2.0  jb      10/18/2026  Add transaction API
+* 2.1  jb      10/18/2026  Add shadow register cache API
+* 2.2  jb      10/18/2026  Add burst write and ELF image API
 * </pre>
 *
 ******************************************************************************/
@@ -54,11 +57,38 @@ typedef uint64_t		u64;
 /* Enable cache for memory mapping */
 #define XAIELIB_MEM_ATTR_CACHE		0x1U
 
+/* Shadow register cache modes */
+#define XAIELIB_SHADOW_WRTHROUGH	0U
+#define XAIELIB_SHADOW_WRBACK		1U
+
 typedef enum {
 	XAIELIB_LOGINFO,
 	XAIELIB_LOGERROR
 } XAieLib_LogLevel;
 
+/**
+ * This typedef contains the statistics of the transaction API.
+ */
+typedef struct {
+	u64 NumRecorded;	/**< Writes recorded into transactions */
+	u64 NumMerged;		/**< Writes merged into the previous write */
+	u64 NumWrites;		/**< Words written to the device by flushes */
+	u64 NumBursts;		/**< Sequential runs written as one burst */
+	u64 NumFlushes;		/**< Number of flushes */
+} XAieLib_TxnStats;
+
+/**
+ * This typedef contains the statistics of a tile shadow.
+ */
+typedef struct {
+	u64 NumHits;		/**< Mask writes served from the shadow */
+	u64 NumMisses;		/**< Mask writes which read the device */
+	u64 NumSkipped;		/**< Write-back writes leaving the value as is */
+	u64 NumWrittenBack;	/**< Registers written by flushes */
+	u32 NumCached;		/**< Registers currently cached */
+	u32 NumDirty;		/**< Registers currently dirty */
+} XAieLib_ShadowStats;
+
 /************************** Variable Definitions *****************************/
 
 /************************** Function Prototypes  *****************************/
@@ -67,9 +97,16 @@ void XAieLib_Read128(u64 Addr, u32 *Data);
 void XAieLib_Write32(u64 Addr, u32 Data);
 void XAieLib_MaskWrite32(u64 Addr, u32 Mask, u32 Data);
 void XAieLib_Write128(u64 Addr, u32 *Data);
+void XAieLib_WriteBurst32(u64 Addr, const u32 *Data, u32 Count);
 void XAieLib_WriteCmd(u8 Command, u8 ColId, u8 RowId, u32 CmdWd0, u32 CmdWd1, u8 *CmdStr);
 u32 XAieLib_MaskPoll(u64 Addr, u32 Mask, u32 Value, u32 TimeOutUs);
 
+u32 XAieLib_TxnBegin(u32 NumCmds);
+u32 XAieLib_TxnFlush(void);
+u32 XAieLib_TxnEnd(void);
+void XAieLib_TxnGetStats(XAieLib_TxnStats *Stats);
+void XAieLib_TxnResetStats(void);
+
 u32 XAieLib_NPIRead32(u64 Addr);
 void XAieLib_NPIWrite32(u64 Addr, u32 Data);
 u32 XAieLib_NPIMaskPoll(u64 Addr, u32 Mask, u32 Value, u32 TimeOutUs);
@@ -84,9 +121,24 @@ typedef struct XAieGbl_Tile XAieGbl_Tile;
 u32 XAieLib_LoadElf(XAieGbl_Tile *TileInstPtr, u8 *ElfPtr, u8 LoadSym);
 u32 XAieLib_LoadElfMem(XAieGbl_Tile *TileInstPtr, u8 *ElfPtr, u8 LoadSym);
 
+struct XAieLib_ElfImg;
+typedef struct XAieLib_ElfImg XAieLib_ElfImg;
+
+XAieLib_ElfImg *XAieLib_ElfImgCreate(u8 *ElfPtr);
+u32 XAieLib_LoadElfImg(XAieGbl_Tile **TileInstPtrs, u32 NumTiles,
+		const XAieLib_ElfImg *ImgPtr, u32 NumThreads);
+void XAieLib_ElfImgFree(XAieLib_ElfImg *ImgPtr);
+
 void XAieLib_InitDev(void);
 u32 XAieLib_InitTile(XAieGbl_Tile *TileInstPtr);
 
+u32 XAieLib_ShadowEnable(XAieGbl_Tile *TileInstPtr, u8 Mode);
+u32 XAieLib_ShadowFlush(XAieGbl_Tile *TileInstPtr);
+void XAieLib_ShadowInvalidate(XAieGbl_Tile *TileInstPtr);
+void XAieLib_ShadowDisable(XAieGbl_Tile *TileInstPtr);
+u32 XAieLib_ShadowGetStats(XAieGbl_Tile *TileInstPtr,
+		XAieLib_ShadowStats *Stats);
+
 void XAieLib_InterruptUnregisterIsr(int Offset);
 int XAieLib_InterruptRegisterIsr(int Offset, int (*Handler) (void *Data), void *Data);
 void XAieLib_InterruptEnable(void);
@@ -0,0 +1,993 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaietile_trace.c
+* @{
+*
+* This file contains routines to capture the event trace of tiles into host
+* memory through the shim DMA, and to decode the captured trace into Chrome
+* trace timelines and histograms of the active intervals of each event.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   jb      10/18/2026  Initial creation
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include <string.h>
+
+#include "xaiegbl.h"
+#include "xaiegbl_defs.h"
+#include "xaiegbl_reginit.h"
+#include "xaiedma_shim.h"
+#include "xaietile_event.h"
+#include "xaietile_strm.h"
+#include "xaietile_timer.h"
+#include "xaietile_trace.h"
+
+/***************************** Macro Definitions *****************************/
+#define XAIETILE_TRACE_MAX_BROADCAST		15U
+#define XAIETILE_TRACE_SHIM_DMA_BLEN		16U
+#define XAIETILE_TRACE_NAME_LEN			32U
+
+/************************** Variable Definitions *****************************/
+extern XAieGbl_Config XAieGbl_ConfigTable[];
+
+/**
+ * Names of the core events which are commonly traced
+ */
+static const struct {
+	u8 Event;
+	const char *Name;
+} XAieTileTrace_CoreNames[] = {
+	{XAIETILE_EVENT_CORE_TRUE, "true"},
+	{XAIETILE_EVENT_CORE_GROUP_CORE_STALL, "core_stall"},
+	{XAIETILE_EVENT_CORE_MEMORY_STALL, "memory_stall"},
+	{XAIETILE_EVENT_CORE_STREAM_STALL, "stream_stall"},
+	{XAIETILE_EVENT_CORE_CASCADE_STALL, "cascade_stall"},
+	{XAIETILE_EVENT_CORE_LOCK_STALL, "lock_stall"},
+	{XAIETILE_EVENT_CORE_ACTIVE, "active"},
+	{XAIETILE_EVENT_CORE_DISABLED, "disabled"},
+	{XAIETILE_EVENT_CORE_INSTR_EVENT_0, "instr_event_0"},
+	{XAIETILE_EVENT_CORE_INSTR_EVENT_1, "instr_event_1"},
+	{XAIETILE_EVENT_CORE_INSTR_VECTOR, "instr_vector"},
+	{XAIETILE_EVENT_CORE_INSTR_LOAD, "instr_load"},
+};
+
+/**
+ * Names of the memory events which are commonly traced
+ */
+static const struct {
+	u8 Event;
+	const char *Name;
+} XAieTileTrace_MemNames[] = {
+	{XAIETILE_EVENT_MEM_TRUE, "true"},
+	{XAIETILE_EVENT_MEM_DMA_S2MM_0_START_BD, "dma_s2mm_0_start_bd"},
+	{XAIETILE_EVENT_MEM_DMA_S2MM_1_START_BD, "dma_s2mm_1_start_bd"},
+	{XAIETILE_EVENT_MEM_DMA_MM2S_0_START_BD, "dma_mm2s_0_start_bd"},
+	{XAIETILE_EVENT_MEM_DMA_MM2S_1_START_BD, "dma_mm2s_1_start_bd"},
+	{XAIETILE_EVENT_MEM_DMA_S2MM_0_FINISHED_BD, "dma_s2mm_0_finished_bd"},
+	{XAIETILE_EVENT_MEM_DMA_S2MM_1_FINISHED_BD, "dma_s2mm_1_finished_bd"},
+	{XAIETILE_EVENT_MEM_DMA_MM2S_0_FINISHED_BD, "dma_mm2s_0_finished_bd"},
+	{XAIETILE_EVENT_MEM_DMA_MM2S_1_FINISHED_BD, "dma_mm2s_1_finished_bd"},
+	{XAIETILE_EVENT_MEM_DMA_S2MM_0_STALLED_LOCK_ACQUIRE,
+		"dma_s2mm_0_lock_stall"},
+	{XAIETILE_EVENT_MEM_DMA_S2MM_1_STALLED_LOCK_ACQUIRE,
+		"dma_s2mm_1_lock_stall"},
+	{XAIETILE_EVENT_MEM_DMA_MM2S_0_STALLED_LOCK_ACQUIRE,
+		"dma_mm2s_0_lock_stall"},
+	{XAIETILE_EVENT_MEM_DMA_MM2S_1_STALLED_LOCK_ACQUIRE,
+		"dma_mm2s_1_lock_stall"},
+};
+
+/************************** Function Definitions *****************************/
+/*
+ * Capture
+ */
+
+/*****************************************************************************/
+/**
+*
+* This API fills the trace slots with the core events that show where a
+* kernel spends its time: active, and the stalls on memory, streams, cascade
+* and locks.
+*
+* @param	TraceEvents - Pointer to the trace events to fill.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+void XAieTileTrace_CoreStallEvents(XAie_TraceEvents *TraceEvents)
+{
+	XAie_AssertVoid(TraceEvents != XAIE_NULL);
+
+	TraceEvents->TraceEvent[0] = XAIETILE_EVENT_CORE_ACTIVE;
+	TraceEvents->TraceEvent[1] = XAIETILE_EVENT_CORE_DISABLED;
+	TraceEvents->TraceEvent[2] = XAIETILE_EVENT_CORE_MEMORY_STALL;
+	TraceEvents->TraceEvent[3] = XAIETILE_EVENT_CORE_STREAM_STALL;
+	TraceEvents->TraceEvent[4] = XAIETILE_EVENT_CORE_CASCADE_STALL;
+	TraceEvents->TraceEvent[5] = XAIETILE_EVENT_CORE_LOCK_STALL;
+	TraceEvents->TraceEvent[6] = XAIETILE_EVENT_CORE_INSTR_EVENT_0;
+	TraceEvents->TraceEvent[7] = XAIETILE_EVENT_CORE_INSTR_EVENT_1;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API fills the trace slots with the memory events that show the DMA
+* activity: the BD starts of each channel, and the lock acquire stalls.
+*
+* @param	TraceEvents - Pointer to the trace events to fill.
+*
+* @return	None.
+*
+* @note		None.
+*
+*******************************************************************************/
+void XAieTileTrace_MemDmaEvents(XAie_TraceEvents *TraceEvents)
+{
+	XAie_AssertVoid(TraceEvents != XAIE_NULL);
+
+	TraceEvents->TraceEvent[0] = XAIETILE_EVENT_MEM_DMA_S2MM_0_START_BD;
+	TraceEvents->TraceEvent[1] = XAIETILE_EVENT_MEM_DMA_S2MM_1_START_BD;
+	TraceEvents->TraceEvent[2] = XAIETILE_EVENT_MEM_DMA_MM2S_0_START_BD;
+	TraceEvents->TraceEvent[3] = XAIETILE_EVENT_MEM_DMA_MM2S_1_START_BD;
+	TraceEvents->TraceEvent[4] =
+		XAIETILE_EVENT_MEM_DMA_S2MM_0_STALLED_LOCK_ACQUIRE;
+	TraceEvents->TraceEvent[5] =
+		XAIETILE_EVENT_MEM_DMA_S2MM_1_STALLED_LOCK_ACQUIRE;
+	TraceEvents->TraceEvent[6] =
+		XAIETILE_EVENT_MEM_DMA_MM2S_0_STALLED_LOCK_ACQUIRE;
+	TraceEvents->TraceEvent[7] =
+		XAIETILE_EVENT_MEM_DMA_MM2S_1_STALLED_LOCK_ACQUIRE;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API configures the core module trace of a tile. The trace and the
+* core timer both start on the given broadcast event, so all tiles configured
+* with the same broadcast share the time base.
+*
+* @param	TileInstPtr - Pointer to the Tile instance.
+* @param	TraceEvents - Events of the 8 trace slots.
+* @param	BroadcastId - Broadcast ID to start on. 0 to 15.
+* @param	PktId - Packet ID of the trace stream.
+*
+* @return	XAIE_SUCCESS on success, else XAIE_FAILURE.
+*
+* @note		The trace runs in event time mode with the packet type
+*		XAIETILE_TRACE_PKT_TYPE_CORE.
+*
+*******************************************************************************/
+u8 XAieTileTrace_CoreConfig(XAieGbl_Tile *TileInstPtr,
+		XAie_TraceEvents *TraceEvents, u8 BroadcastId, u8 PktId)
+{
+	u8 Event = XAIETILE_EVENT_CORE_BROADCAST_0 + BroadcastId;
+
+	XAie_AssertNonvoid(TileInstPtr != XAIE_NULL);
+	XAie_AssertNonvoid(TileInstPtr->TileType == XAIEGBL_TILE_TYPE_AIETILE);
+	XAie_AssertNonvoid(TraceEvents != XAIE_NULL);
+	XAie_AssertNonvoid(BroadcastId <= XAIETILE_TRACE_MAX_BROADCAST);
+
+	if (XAieTileCore_EventTraceEventWrite(TileInstPtr, TraceEvents) !=
+			XAIE_SUCCESS) {
+		return XAIE_FAILURE;
+	}
+
+	if (XAieTileCore_EventTraceControl(TileInstPtr,
+			XAIETILE_EVENT_MODE_EVENT_TIME, Event,
+			XAIETILE_EVENT_CORE_NONE, PktId,
+			XAIETILE_TRACE_PKT_TYPE_CORE) != XAIE_SUCCESS) {
+		return XAIE_FAILURE;
+	}
+
+	if (XAieTile_CoreSetTimerResetEvent(TileInstPtr, Event,
+			XAIE_RESETENABLE) != XAIE_SUCCESS) {
+		return XAIE_FAILURE;
+	}
+
+	return XAIE_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API configures the memory module trace of a tile. The trace and the
+* memory timer both start on the given broadcast event.
+*
+* @param	TileInstPtr - Pointer to the Tile instance.
+* @param	TraceEvents - Events of the 8 trace slots.
+* @param	BroadcastId - Broadcast ID to start on. 0 to 15.
+* @param	PktId - Packet ID of the trace stream.
+*
+* @return	XAIE_SUCCESS on success, else XAIE_FAILURE.
+*
+* @note		The trace uses the packet type XAIETILE_TRACE_PKT_TYPE_MEM.
+*
+*******************************************************************************/
+u8 XAieTileTrace_MemConfig(XAieGbl_Tile *TileInstPtr,
+		XAie_TraceEvents *TraceEvents, u8 BroadcastId, u8 PktId)
+{
+	u8 Event = XAIETILE_EVENT_MEM_BROADCAST_0 + BroadcastId;
+
+	XAie_AssertNonvoid(TileInstPtr != XAIE_NULL);
+	XAie_AssertNonvoid(TileInstPtr->TileType == XAIEGBL_TILE_TYPE_AIETILE);
+	XAie_AssertNonvoid(TraceEvents != XAIE_NULL);
+	XAie_AssertNonvoid(BroadcastId <= XAIETILE_TRACE_MAX_BROADCAST);
+
+	if (XAieTileMem_EventTraceEventWrite(TileInstPtr, TraceEvents) !=
+			XAIE_SUCCESS) {
+		return XAIE_FAILURE;
+	}
+
+	if (XAieTileMem_EventTraceControl(TileInstPtr, Event,
+			XAIETILE_EVENT_MEM_NONE, PktId,
+			XAIETILE_TRACE_PKT_TYPE_MEM) != XAIE_SUCCESS) {
+		return XAIE_FAILURE;
+	}
+
+	if (XAieTile_MemSetTimerResetEvent(TileInstPtr, Event,
+			XAIE_RESETENABLE) != XAIE_SUCCESS) {
+		return XAIE_FAILURE;
+	}
+
+	return XAIE_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API routes the trace stream of a tile down its column to a shim DMA
+* S2MM channel, with circuit switched connections.
+*
+* @param	TileInstPtr - Pointer to the Tile instance. This has to be
+*		the shim tile of the corresponding column.
+* @param	RowId - Row of the traced tile.
+* @param	Module - Traced module, XAIEGBL_MODULE_CORE or
+*		XAIEGBL_MODULE_MEM.
+* @param	Port - Index of the north / south ports to use on the way.
+* @param	ChNum - XAIEDMA_SHIM_CHNUM_S2MM0 or XAIEDMA_SHIM_CHNUM_S2MM1.
+*
+* @return	XAIE_SUCCESS on success, else XAIE_FAILURE.
+*
+* @note		The tiles of the column are expected to follow the shim tile
+*		in memory, as allocated for XAieGbl_CfgInitialize(). The ports
+*		used by the route shouldn't be used by the graph.
+*
+*******************************************************************************/
+u8 XAieTileTrace_RouteColumn(XAieGbl_Tile *TileInstPtr, u16 RowId, u8 Module,
+		u8 Port, u8 ChNum)
+{
+	XAieGbl_Tile *TilePtr;
+	u16 RowIdx;
+
+	XAie_AssertNonvoid(TileInstPtr != XAIE_NULL);
+	XAie_AssertNonvoid(TileInstPtr->TileType == XAIEGBL_TILE_TYPE_SHIMNOC);
+	XAie_AssertNonvoid(RowId >= 1U &&
+			RowId <= XAieGbl_ConfigTable->NumRows);
+	XAie_AssertNonvoid(Module == XAIEGBL_MODULE_CORE ||
+			Module == XAIEGBL_MODULE_MEM);
+	XAie_AssertNonvoid(ChNum == XAIEDMA_SHIM_CHNUM_S2MM0 ||
+			ChNum == XAIEDMA_SHIM_CHNUM_S2MM1);
+
+	/* Traced tile: trace port to south */
+	TilePtr = &TileInstPtr[RowId];
+	XAieTile_StrmConnectCct(TilePtr,
+			XAIETILE_STRSW_SPORT_TRACE(TilePtr,
+				(Module == XAIEGBL_MODULE_CORE) ? 0U : 1U),
+			XAIETILE_STRSW_MPORT_SOUTH(TilePtr, Port),
+			XAIE_ENABLE);
+
+	/* Tiles below: north to south */
+	for (RowIdx = RowId - 1U; RowIdx >= 1U; RowIdx--) {
+		TilePtr = &TileInstPtr[RowIdx];
+		XAieTile_StrmConnectCct(TilePtr,
+				XAIETILE_STRSW_SPORT_NORTH(TilePtr, Port),
+				XAIETILE_STRSW_MPORT_SOUTH(TilePtr, Port),
+				XAIE_ENABLE);
+	}
+
+	/* Shim: south 2 / 3 are demuxed to the S2MM channel 0 / 1 */
+	XAieTile_StrmConnectCct(TileInstPtr,
+			XAIETILE_STRSW_SPORT_NORTH(TileInstPtr, Port),
+			XAIETILE_STRSW_MPORT_SOUTH(TileInstPtr, 2U + ChNum),
+			XAIE_ENABLE);
+	XAieTile_ShimStrmDemuxConfig(TileInstPtr,
+			XAIETILE_SHIM_STRM_DEM_SOUTH2 + ChNum,
+			XAIETILE_SHIM_STRM_DEM_DMA);
+
+	return XAIE_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API starts a shim DMA S2MM channel to write the trace stream into
+* a host buffer.
+*
+* @param	DmaInstPtr - Pointer to the Shim DMA instance.
+* @param	ChNum - XAIEDMA_SHIM_CHNUM_S2MM0 or XAIEDMA_SHIM_CHNUM_S2MM1.
+* @param	BdNum - BD to use. 0 to 15.
+* @param	Addr - Device address of the buffer. 128-bit aligned.
+* @param	Length - Length of the buffer in bytes.
+*
+* @return	XAIE_SUCCESS on success, else XAIE_FAILURE.
+*
+* @note		The channel stops when the buffer is full. Use
+*		XAieDma_ShimWaitDone() or XAieDma_ShimPendingBdCount() to find
+*		when it has completed.
+*
+*******************************************************************************/
+u8 XAieTileTrace_ShimDmaStart(XAieDma_Shim *DmaInstPtr, u8 ChNum, u8 BdNum,
+		u64 Addr, u32 Length)
+{
+	XAie_AssertNonvoid(DmaInstPtr != XAIE_NULL);
+	XAie_AssertNonvoid(ChNum == XAIEDMA_SHIM_CHNUM_S2MM0 ||
+			ChNum == XAIEDMA_SHIM_CHNUM_S2MM1);
+	XAie_AssertNonvoid(BdNum < XAIEDMA_SHIM_MAX_NUM_DESCRS);
+
+	if ((Addr & XAIEDMA_SHIM_ADDRLOW_ALIGN_MASK) != 0U) {
+		XAie_print("Error: trace buffer isn't 128-bit aligned\n");
+		return XAIE_FAILURE;
+	}
+
+	XAieDma_ShimBdClear(DmaInstPtr, BdNum);
+	XAieDma_ShimBdSetAddr(DmaInstPtr, BdNum, (u16)(Addr >> 32U),
+			(u32)Addr, Length);
+	XAieDma_ShimBdSetAxi(DmaInstPtr, BdNum, 0U,
+			XAIETILE_TRACE_SHIM_DMA_BLEN, 0U, 0U, XAIE_DISABLE);
+	XAieDma_ShimBdWrite(DmaInstPtr, BdNum);
+
+	XAieDma_ShimSetStartBd(DmaInstPtr, ChNum, BdNum);
+	XAieDma_ShimChControl(DmaInstPtr, ChNum, XAIE_DISABLE, XAIE_DISABLE,
+			XAIE_ENABLE);
+
+	return XAIE_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API starts the traces configured with the given broadcast. A user
+* event of the shim tile is broadcast, which resets the timers and starts
+* the traces of the tiles.
+*
+* @param	TileInstPtr - Pointer to the shim Tile instance.
+* @param	BroadcastId - Broadcast ID the traces are configured with.
+*
+* @return	XAIE_SUCCESS on success, else XAIE_FAILURE.
+*
+* @note		The broadcast reaches the tiles through the default broadcast
+*		network. Broadcast blocks set in between should be cleared.
+*
+*******************************************************************************/
+u8 XAieTileTrace_Start(XAieGbl_Tile *TileInstPtr, u8 BroadcastId)
+{
+	XAie_AssertNonvoid(TileInstPtr != XAIE_NULL);
+	XAie_AssertNonvoid(TileInstPtr->TileType != XAIEGBL_TILE_TYPE_AIETILE);
+	XAie_AssertNonvoid(BroadcastId <= XAIETILE_TRACE_MAX_BROADCAST);
+
+	if (XAieTilePl_EventBroadcast(TileInstPtr, BroadcastId,
+			XAIETILE_EVENT_SHIM_USER_EVENT_0) != XAIE_SUCCESS) {
+		return XAIE_FAILURE;
+	}
+
+	return XAieTilePl_EventGenerate(TileInstPtr,
+			XAIETILE_EVENT_SHIM_USER_EVENT_0);
+}
+
+/*
+ * Decode
+ */
+
+/*****************************************************************************/
+/**
+*
+* This API finds the name of an event of the given module.
+*
+* @param	PktType - XAIETILE_TRACE_PKT_TYPE_CORE or _MEM.
+* @param	Event - Event ID.
+* @param	Buf - Buffer for the names not in the tables.
+*
+* @return	Name of the event.
+*
+* @note		Used only within this file.
+*
+*******************************************************************************/
+static const char *XAieTileTrace_EventName(u8 PktType, u8 Event, char *Buf)
+{
+	u32 Idx;
+
+	if (PktType == XAIETILE_TRACE_PKT_TYPE_CORE) {
+		for (Idx = 0U; Idx < sizeof(XAieTileTrace_CoreNames) /
+				sizeof(XAieTileTrace_CoreNames[0]); Idx++) {
+			if (XAieTileTrace_CoreNames[Idx].Event == Event) {
+				return XAieTileTrace_CoreNames[Idx].Name;
+			}
+		}
+		snprintf(Buf, XAIETILE_TRACE_NAME_LEN, "core_event_%u", Event);
+	} else {
+		for (Idx = 0U; Idx < sizeof(XAieTileTrace_MemNames) /
+				sizeof(XAieTileTrace_MemNames[0]); Idx++) {
+			if (XAieTileTrace_MemNames[Idx].Event == Event) {
+				return XAieTileTrace_MemNames[Idx].Name;
+			}
+		}
+		snprintf(Buf, XAIETILE_TRACE_NAME_LEN, "mem_event_%u", Event);
+	}
+
+	return Buf;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API initializes a trace decoder.
+*
+* @param	DecPtr - Pointer to the decoder.
+* @param	ClockMhz - AIE clock in MHz, to convert cycles to microseconds.
+* @param	Json - File to write the Chrome trace to, or XAIE_NULL.
+*
+* @return	None.
+*
+* @note		The Chrome trace can be opened with chrome://tracing or
+*		Perfetto. Each column is a process, and each traced module a
+*		thread.
+*
+*******************************************************************************/
+void XAieTileTrace_DecoderInit(XAieTileTrace_Decoder *DecPtr, u32 ClockMhz,
+		FILE *Json)
+{
+	XAie_AssertVoid(DecPtr != XAIE_NULL);
+	XAie_AssertVoid(ClockMhz != 0U);
+
+	memset(DecPtr, 0, sizeof(*DecPtr));
+	DecPtr->ClockMhz = ClockMhz;
+	DecPtr->Json = Json;
+
+	if (Json != XAIE_NULL) {
+		fprintf(Json, "{\"traceEvents\":[\n");
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This API finds the decode state of a stream, and adds it if it's new.
+*
+* @param	DecPtr - Pointer to the decoder.
+* @param	ColId - Column of the traced tile.
+* @param	RowId - Row of the traced tile.
+* @param	PktType - XAIETILE_TRACE_PKT_TYPE_CORE or _MEM.
+*
+* @return	Pointer to the stream, or XAIE_NULL if there's no free stream.
+*
+* @note		Used only within this file.
+*
+*******************************************************************************/
+static XAieTileTrace_Stream *XAieTileTrace_GetStream(
+		XAieTileTrace_Decoder *DecPtr, u16 ColId, u16 RowId,
+		u8 PktType)
+{
+	XAieTileTrace_Stream *StreamPtr;
+	u32 Idx;
+
+	for (Idx = 0U; Idx < DecPtr->NumStreams; Idx++) {
+		StreamPtr = &DecPtr->Streams[Idx];
+		if (StreamPtr->ColId == ColId && StreamPtr->RowId == RowId &&
+				StreamPtr->PktType == PktType) {
+			return StreamPtr;
+		}
+	}
+
+	if (DecPtr->NumStreams == XAIETILE_TRACE_MAX_STREAMS) {
+		return XAIE_NULL;
+	}
+
+	StreamPtr = &DecPtr->Streams[DecPtr->NumStreams++];
+	StreamPtr->ColId = ColId;
+	StreamPtr->RowId = RowId;
+	StreamPtr->PktType = PktType;
+	if (PktType == XAIETILE_TRACE_PKT_TYPE_CORE) {
+		XAieTileTrace_CoreStallEvents(&StreamPtr->Events);
+	} else {
+		XAieTileTrace_MemDmaEvents(&StreamPtr->Events);
+	}
+
+	if (DecPtr->Json != XAIE_NULL) {
+		fprintf(DecPtr->Json, "%s{\"name\":\"thread_name\",\"ph\":\"M\","
+				"\"pid\":%u,\"tid\":%u,\"args\":{\"name\":"
+				"\"tile(%u,%u) %s\"}}",
+				(DecPtr->NumJsonEvents != 0U) ? ",\n" : "",
+				ColId, RowId * 2U + PktType, ColId, RowId,
+				(PktType == XAIETILE_TRACE_PKT_TYPE_CORE) ?
+				"core" : "mem");
+		DecPtr->NumJsonEvents++;
+	}
+
+	return StreamPtr;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API sets the events the trace slots of a stream are configured with,
+* so the timelines and histograms are labeled with them. By default, the
+* events of XAieTileTrace_CoreStallEvents() and XAieTileTrace_MemDmaEvents()
+* are assumed.
+*
+* @param	DecPtr - Pointer to the decoder.
+* @param	ColId - Column of the traced tile.
+* @param	RowId - Row of the traced tile.
+* @param	PktType - XAIETILE_TRACE_PKT_TYPE_CORE or _MEM.
+* @param	TraceEvents - Events of the trace slots.
+*
+* @return	XAIE_SUCCESS on success, else XAIE_FAILURE.
+*
+* @note		None.
+*
+*******************************************************************************/
+u8 XAieTileTrace_DecoderSetEvents(XAieTileTrace_Decoder *DecPtr, u16 ColId,
+		u16 RowId, u8 PktType, XAie_TraceEvents *TraceEvents)
+{
+	XAieTileTrace_Stream *StreamPtr;
+
+	XAie_AssertNonvoid(DecPtr != XAIE_NULL);
+	XAie_AssertNonvoid(TraceEvents != XAIE_NULL);
+
+	StreamPtr = XAieTileTrace_GetStream(DecPtr, ColId, RowId, PktType);
+	if (StreamPtr == XAIE_NULL) {
+		return XAIE_FAILURE;
+	}
+
+	StreamPtr->Events = *TraceEvents;
+
+	return XAIE_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API closes the active interval of a trace slot.
+*
+* @param	DecPtr - Pointer to the decoder.
+* @param	StreamPtr - Pointer to the stream.
+* @param	Slot - Trace slot.
+*
+* @return	None.
+*
+* @note		Used only within this file.
+*
+*******************************************************************************/
+static void XAieTileTrace_EndInterval(XAieTileTrace_Decoder *DecPtr,
+		XAieTileTrace_Stream *StreamPtr, u8 Slot)
+{
+	XAieTileTrace_Hist *HistPtr = &StreamPtr->Hist[Slot];
+	char Buf[XAIETILE_TRACE_NAME_LEN];
+	u64 Cycles = StreamPtr->Time - StreamPtr->Begin[Slot];
+	u32 Bin = 0U;
+
+	while (Bin < XAIETILE_TRACE_HIST_NUM_BINS - 1U &&
+			(Cycles >> (Bin + 1U)) != 0U) {
+		Bin++;
+	}
+
+	HistPtr->NumIntervals++;
+	HistPtr->TotalCycles += Cycles;
+	HistPtr->Bins[Bin]++;
+	if (Cycles > HistPtr->MaxCycles) {
+		HistPtr->MaxCycles = Cycles;
+	}
+
+	if (DecPtr->Json != XAIE_NULL) {
+		fprintf(DecPtr->Json, "%s{\"name\":\"%s\",\"ph\":\"X\","
+				"\"pid\":%u,\"tid\":%u,\"ts\":%.3f,"
+				"\"dur\":%.3f}",
+				(DecPtr->NumJsonEvents != 0U) ? ",\n" : "",
+				XAieTileTrace_EventName(StreamPtr->PktType,
+					StreamPtr->Events.TraceEvent[Slot],
+					Buf),
+				StreamPtr->ColId,
+				StreamPtr->RowId * 2U + StreamPtr->PktType,
+				(double)StreamPtr->Begin[Slot] /
+				DecPtr->ClockMhz,
+				(double)Cycles / DecPtr->ClockMhz);
+		DecPtr->NumJsonEvents++;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This API moves the time of a stream forward and sets the active slots.
+*
+* @param	DecPtr - Pointer to the decoder.
+* @param	StreamPtr - Pointer to the stream.
+* @param	Cycles - Cycles since the previous frame.
+* @param	Active - Mask of the slots active from now.
+*
+* @return	None.
+*
+* @note		Used only within this file.
+*
+*******************************************************************************/
+static void XAieTileTrace_SetActive(XAieTileTrace_Decoder *DecPtr,
+		XAieTileTrace_Stream *StreamPtr, u64 Cycles, u8 Active)
+{
+	u8 Slot;
+
+	StreamPtr->Time += Cycles;
+
+	for (Slot = 0U; Slot < XAIETILE_EVENT_NUM_TRACE_EVENT; Slot++) {
+		if ((StreamPtr->Active & ~Active & (1U << Slot)) != 0U) {
+			XAieTileTrace_EndInterval(DecPtr, StreamPtr, Slot);
+		} else if ((~StreamPtr->Active & Active & (1U << Slot)) != 0U) {
+			StreamPtr->Begin[Slot] = StreamPtr->Time;
+		}
+	}
+
+	StreamPtr->Active = Active;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API returns the length of a frame from its first byte.
+*
+* @param	Byte - First byte of the frame.
+*
+* @return	Length of the frame in bytes.
+*
+* @note		Used only within this file.
+*
+*******************************************************************************/
+static u8 XAieTileTrace_FrameLen(u8 Byte)
+{
+	if ((Byte & 0x80U) == XAIETILE_TRACE_FRM_SINGLE0) {
+		return 1U;
+	} else if ((Byte & 0xC0U) == XAIETILE_TRACE_FRM_SINGLE1) {
+		return 2U;
+	} else if ((Byte & 0xE0U) == XAIETILE_TRACE_FRM_SINGLE2) {
+		return 4U;
+	} else if ((Byte & 0xF8U) == XAIETILE_TRACE_FRM_MULTI0) {
+		return 2U;
+	} else if ((Byte & 0xF8U) == XAIETILE_TRACE_FRM_MULTI1) {
+		return 3U;
+	}
+
+	switch (Byte) {
+	case XAIETILE_TRACE_FRM_START:
+		return 8U;
+	case XAIETILE_TRACE_FRM_MULTI2:
+		return 4U;
+	case XAIETILE_TRACE_FRM_REPEAT:
+		return 2U;
+	default:
+		return 1U;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This API decodes one frame of a stream.
+*
+* @param	DecPtr - Pointer to the decoder.
+* @param	StreamPtr - Pointer to the stream.
+* @param	Frm - Bytes of the frame.
+* @param	Len - Length of the frame.
+*
+* @return	None.
+*
+* @note		Used only within this file.
+*
+*******************************************************************************/
+static void XAieTileTrace_DecodeFrame(XAieTileTrace_Decoder *DecPtr,
+		XAieTileTrace_Stream *StreamPtr, const u8 *Frm, u8 Len)
+{
+	u64 Val = 0U;
+	u8 Byte = Frm[0];
+	u8 Idx;
+
+	for (Idx = 0U; Idx < Len; Idx++) {
+		Val = (Val << 8U) | Frm[Idx];
+	}
+
+	if (Byte == XAIETILE_TRACE_FRM_START) {
+		/* Absolute timer value, nothing active before the start */
+		XAieTileTrace_SetActive(DecPtr, StreamPtr, 0U, 0U);
+		StreamPtr->Time = Val & 0xFFFFFFFFFFFFFFULL;
+		if (StreamPtr->StartTime == 0U) {
+			StreamPtr->StartTime = StreamPtr->Time;
+		}
+		StreamPtr->Started = 1U;
+		StreamPtr->LastLen = 0U;
+		return;
+	}
+
+	if (Byte == XAIETILE_TRACE_FRM_FILLER) {
+		return;
+	}
+
+	if (StreamPtr->Started == 0U) {
+		/* Without the start, there's no time base yet */
+		return;
+	}
+
+	if (Byte == XAIETILE_TRACE_FRM_STOP) {
+		XAieTileTrace_SetActive(DecPtr, StreamPtr, 0U, 0U);
+		StreamPtr->Started = 0U;
+		return;
+	}
+
+	if (Byte == XAIETILE_TRACE_FRM_REPEAT) {
+		if (StreamPtr->LastLen == 0U) {
+			DecPtr->NumBadFrames++;
+			return;
+		}
+		for (Idx = 0U; Idx < Frm[1]; Idx++) {
+			XAieTileTrace_DecodeFrame(DecPtr, StreamPtr,
+					StreamPtr->LastFrame,
+					StreamPtr->LastLen);
+		}
+		return;
+	}
+
+	if ((Byte & 0x80U) == XAIETILE_TRACE_FRM_SINGLE0) {
+		XAieTileTrace_SetActive(DecPtr, StreamPtr, Val & 0xFU,
+				1U << ((Val >> 4U) & 0x7U));
+	} else if ((Byte & 0xC0U) == XAIETILE_TRACE_FRM_SINGLE1) {
+		XAieTileTrace_SetActive(DecPtr, StreamPtr, Val & 0x7FFU,
+				1U << ((Val >> 11U) & 0x7U));
+	} else if ((Byte & 0xE0U) == XAIETILE_TRACE_FRM_SINGLE2) {
+		XAieTileTrace_SetActive(DecPtr, StreamPtr, Val & 0x3FFFFFFU,
+				1U << ((Val >> 26U) & 0x7U));
+	} else if ((Byte & 0xF8U) == XAIETILE_TRACE_FRM_MULTI0) {
+		XAieTileTrace_SetActive(DecPtr, StreamPtr, Val & 0x7U,
+				(u8)(Val >> 3U));
+	} else if ((Byte & 0xF8U) == XAIETILE_TRACE_FRM_MULTI1) {
+		XAieTileTrace_SetActive(DecPtr, StreamPtr, Val & 0x7FFU,
+				(u8)(Val >> 11U));
+	} else if (Byte == XAIETILE_TRACE_FRM_MULTI2) {
+		XAieTileTrace_SetActive(DecPtr, StreamPtr, Val & 0xFFFFU,
+				(u8)(Val >> 16U));
+	} else {
+		DecPtr->NumBadFrames++;
+		return;
+	}
+
+	if (Frm != StreamPtr->LastFrame) {
+		memcpy(StreamPtr->LastFrame, Frm, Len);
+		StreamPtr->LastLen = Len;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This API decodes the trace captured in a buffer. It can be called as the
+* buffer fills, with the words written since the previous call.
+*
+* @param	DecPtr - Pointer to the decoder.
+* @param	Words - Captured words, each a packet header followed by
+*		XAIETILE_TRACE_PKT_NUM_WORDS - 1 payload words.
+* @param	NumWords - Number of words.
+*
+* @return	Number of words consumed. Words of an incomplete packet at
+*		the end are left for the next call.
+*
+* @note		Frames split over packets of a stream are joined. Packets
+*		with a zero header are skipped, so a buffer zeroed before the
+*		capture can be decoded whole.
+*
+*******************************************************************************/
+u32 XAieTileTrace_Decode(XAieTileTrace_Decoder *DecPtr, const u32 *Words,
+		u32 NumWords)
+{
+	XAieTileTrace_Stream *StreamPtr;
+	u8 Bytes[8U + (XAIETILE_TRACE_PKT_NUM_WORDS - 1U) * 4U];
+	u32 Done = 0U;
+	u32 Header;
+	u32 NumBytes;
+	u32 Pos;
+	u32 Idx;
+	u8 Len;
+
+	XAie_AssertNonvoid(DecPtr != XAIE_NULL);
+	XAie_AssertNonvoid(Words != XAIE_NULL);
+
+	while (NumWords - Done >= XAIETILE_TRACE_PKT_NUM_WORDS) {
+		Header = Words[Done];
+		if (Header == 0U) {
+			/* Not written yet. Traced tiles are never in row 0 */
+			Done += XAIETILE_TRACE_PKT_NUM_WORDS;
+			continue;
+		}
+
+		StreamPtr = XAieTileTrace_GetStream(DecPtr,
+				XAie_GetField(Header, XAIETILE_TRACE_PKT_COL_LSB,
+					XAIETILE_TRACE_PKT_COL_MASK),
+				XAie_GetField(Header, XAIETILE_TRACE_PKT_ROW_LSB,
+					XAIETILE_TRACE_PKT_ROW_MASK),
+				XAie_GetField(Header, XAIETILE_TRACE_PKT_TYPE_LSB,
+					XAIETILE_TRACE_PKT_TYPE_MASK));
+		if (StreamPtr == XAIE_NULL) {
+			DecPtr->NumDropped++;
+			Done += XAIETILE_TRACE_PKT_NUM_WORDS;
+			continue;
+		}
+
+		/* Bytes left over from the previous packet come first */
+		NumBytes = StreamPtr->NumPartial;
+		memcpy(Bytes, StreamPtr->Partial, NumBytes);
+		for (Idx = 1U; Idx < XAIETILE_TRACE_PKT_NUM_WORDS; Idx++) {
+			Bytes[NumBytes++] = (u8)(Words[Done + Idx] >> 24U);
+			Bytes[NumBytes++] = (u8)(Words[Done + Idx] >> 16U);
+			Bytes[NumBytes++] = (u8)(Words[Done + Idx] >> 8U);
+			Bytes[NumBytes++] = (u8)Words[Done + Idx];
+		}
+
+		Pos = 0U;
+		while (Pos < NumBytes) {
+			Len = XAieTileTrace_FrameLen(Bytes[Pos]);
+			if (Pos + Len > NumBytes) {
+				break;
+			}
+			XAieTileTrace_DecodeFrame(DecPtr, StreamPtr,
+					&Bytes[Pos], Len);
+			Pos += Len;
+		}
+
+		StreamPtr->NumPartial = NumBytes - Pos;
+		memcpy(StreamPtr->Partial, &Bytes[Pos], StreamPtr->NumPartial);
+		Done += XAIETILE_TRACE_PKT_NUM_WORDS;
+	}
+
+	return Done;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API finishes the decode. The intervals still active are closed at the
+* time of the last frame, and the Chrome trace is terminated.
+*
+* @param	DecPtr - Pointer to the decoder.
+*
+* @return	None.
+*
+* @note		The Json file isn't closed.
+*
+*******************************************************************************/
+void XAieTileTrace_DecoderFinish(XAieTileTrace_Decoder *DecPtr)
+{
+	u32 Idx;
+
+	XAie_AssertVoid(DecPtr != XAIE_NULL);
+
+	for (Idx = 0U; Idx < DecPtr->NumStreams; Idx++) {
+		XAieTileTrace_SetActive(DecPtr, &DecPtr->Streams[Idx], 0U, 0U);
+	}
+
+	if (DecPtr->Json != XAIE_NULL) {
+		fprintf(DecPtr->Json, "\n]}\n");
+		fflush(DecPtr->Json);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This API returns the statistics of a trace slot.
+*
+* @param	DecPtr - Pointer to the decoder.
+* @param	ColId - Column of the traced tile.
+* @param	RowId - Row of the traced tile.
+* @param	PktType - XAIETILE_TRACE_PKT_TYPE_CORE or _MEM.
+* @param	Slot - Trace slot. 0 to 7.
+*
+* @return	Pointer to the statistics, or XAIE_NULL if the stream isn't
+*		found.
+*
+* @note		None.
+*
+*******************************************************************************/
+XAieTileTrace_Hist *XAieTileTrace_GetHist(XAieTileTrace_Decoder *DecPtr,
+		u16 ColId, u16 RowId, u8 PktType, u8 Slot)
+{
+	u32 Idx;
+
+	XAie_AssertNonvoid(DecPtr != XAIE_NULL);
+	XAie_AssertNonvoid(Slot < XAIETILE_EVENT_NUM_TRACE_EVENT);
+
+	for (Idx = 0U; Idx < DecPtr->NumStreams; Idx++) {
+		if (DecPtr->Streams[Idx].ColId == ColId &&
+				DecPtr->Streams[Idx].RowId == RowId &&
+				DecPtr->Streams[Idx].PktType == PktType) {
+			return &DecPtr->Streams[Idx].Hist[Slot];
+		}
+	}
+
+	return XAIE_NULL;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API writes the statistics of all streams, with the share of the
+* traced time each event was active and the histogram of its intervals.
+*
+* @param	DecPtr - Pointer to the decoder.
+* @param	Out - File to write to.
+*
+* @return	None.
+*
+* @note		Events that never became active are skipped.
+*
+*******************************************************************************/
+void XAieTileTrace_WriteHist(XAieTileTrace_Decoder *DecPtr, FILE *Out)
+{
+	XAieTileTrace_Stream *StreamPtr;
+	XAieTileTrace_Hist *HistPtr;
+	char Buf[XAIETILE_TRACE_NAME_LEN];
+	u64 Cycles;
+	u32 Idx;
+	u32 Bin;
+	u8 Slot;
+
+	XAie_AssertVoid(DecPtr != XAIE_NULL);
+	XAie_AssertVoid(Out != XAIE_NULL);
+
+	for (Idx = 0U; Idx < DecPtr->NumStreams; Idx++) {
+		StreamPtr = &DecPtr->Streams[Idx];
+		Cycles = StreamPtr->Time - StreamPtr->StartTime;
+		fprintf(Out, "tile(%u,%u) %s, %llu cycles\n", StreamPtr->ColId,
+				StreamPtr->RowId,
+				(StreamPtr->PktType ==
+				 XAIETILE_TRACE_PKT_TYPE_CORE) ? "core" : "mem",
+				(unsigned long long)Cycles);
+
+		for (Slot = 0U; Slot < XAIETILE_EVENT_NUM_TRACE_EVENT; Slot++) {
+			HistPtr = &StreamPtr->Hist[Slot];
+			if (HistPtr->NumIntervals == 0U) {
+				continue;
+			}
+
+			fprintf(Out, "  %-24s %5.1f%% %llu times, max %llu:",
+					XAieTileTrace_EventName(
+						StreamPtr->PktType,
+						StreamPtr->Events.TraceEvent[Slot],
+						Buf),
+					(Cycles != 0U) ?
+					100.0 * HistPtr->TotalCycles / Cycles :
+					0.0,
+					(unsigned long long)HistPtr->NumIntervals,
+					(unsigned long long)HistPtr->MaxCycles);
+			for (Bin = 0U; Bin < XAIETILE_TRACE_HIST_NUM_BINS;
+					Bin++) {
+				if (HistPtr->Bins[Bin] != 0U) {
+					fprintf(Out, " <%llu:%llu",
+						1ULL << (Bin + 1U),
+						(unsigned long long)
+						HistPtr->Bins[Bin]);
+				}
+			}
+			fprintf(Out, "\n");
+		}
+	}
+}
+
+/** @} */
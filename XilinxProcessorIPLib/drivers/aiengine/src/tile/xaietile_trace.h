@@ -0,0 +1,145 @@
+/******************************************************************************
+* Copyright (C) 2020 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaietile_trace.h
+* @{
+*
+*  Header file for event trace capture and decode
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who     Date     Changes
+* ----- ------  -------- -----------------------------------------------------
+* 1.0   jb      10/18/2026  Initial creation
+* </pre>
+*
+******************************************************************************/
+#ifndef XAIETILE_TRACE_H
+#define XAIETILE_TRACE_H
+
+/***************************** Include Files *********************************/
+#include <stdio.h>
+
+#include "xaiedma_shim.h"
+#include "xaietile_event.h"
+
+/***************************** Constant Definitions **************************/
+/*
+ * Packet types of the trace streams of each module
+ */
+#define XAIETILE_TRACE_PKT_TYPE_CORE		0U
+#define XAIETILE_TRACE_PKT_TYPE_MEM		1U
+
+/*
+ * A trace packet is a header word followed by the payload words
+ */
+#define XAIETILE_TRACE_PKT_NUM_WORDS		8U
+#define XAIETILE_TRACE_PKT_ID_MASK		0x1FU
+#define XAIETILE_TRACE_PKT_TYPE_LSB		12U
+#define XAIETILE_TRACE_PKT_TYPE_MASK		0x7000U
+#define XAIETILE_TRACE_PKT_ROW_LSB		16U
+#define XAIETILE_TRACE_PKT_ROW_MASK		0x1F0000U
+#define XAIETILE_TRACE_PKT_COL_LSB		21U
+#define XAIETILE_TRACE_PKT_COL_MASK		0xFE00000U
+
+/*
+ * Frames in the payload, most significant byte of each word first. Each
+ * frame reports the trace slots active from its time until the next frame.
+ */
+#define XAIETILE_TRACE_FRM_SINGLE0		0x00U	/* 0sss cccc */
+#define XAIETILE_TRACE_FRM_SINGLE1		0x80U	/* 10ss sccc +1 byte */
+#define XAIETILE_TRACE_FRM_SINGLE2		0xC0U	/* 110s ssxx +3 bytes */
+#define XAIETILE_TRACE_FRM_MULTI0		0xE0U	/* 1110 0mmm +1 byte */
+#define XAIETILE_TRACE_FRM_MULTI1		0xE8U	/* 1110 1mmm +2 bytes */
+#define XAIETILE_TRACE_FRM_START		0xF0U	/* +7 bytes of timer */
+#define XAIETILE_TRACE_FRM_STOP			0xF1U
+#define XAIETILE_TRACE_FRM_MULTI2		0xF2U	/* +1 mask, +2 cycles */
+#define XAIETILE_TRACE_FRM_REPEAT		0xF4U	/* +1 byte of count */
+#define XAIETILE_TRACE_FRM_FILLER		0xFFU
+
+/*
+ * Number of streams a decoder tracks, and number of log2 bins of the
+ * histograms of the active interval lengths
+ */
+#ifndef XAIETILE_TRACE_MAX_STREAMS
+#define XAIETILE_TRACE_MAX_STREAMS		128U
+#endif
+#define XAIETILE_TRACE_HIST_NUM_BINS		32U
+
+/***************************** Type Definitions ******************************/
+/**
+ * This typedef contains the statistics of one trace slot of a stream.
+ */
+typedef struct {
+	u64 NumIntervals;	/**< Number of times the slot became active */
+	u64 TotalCycles;	/**< Cycles the slot was active */
+	u64 MaxCycles;		/**< Longest active interval */
+	u64 Bins[XAIETILE_TRACE_HIST_NUM_BINS]; /**< Intervals of 2^n cycles */
+} XAieTileTrace_Hist;
+
+/**
+ * This typedef contains the decode state of the trace of one module.
+ */
+typedef struct {
+	u16 ColId;		/**< Column of the traced tile */
+	u16 RowId;		/**< Row of the traced tile */
+	u8 PktType;		/**< XAIETILE_TRACE_PKT_TYPE_CORE or _MEM */
+	u8 Started;		/**< Start frame received */
+	u8 Active;		/**< Mask of the slots active since Time */
+	u8 LastFrame[4];	/**< Last frame for repeat frames */
+	u8 LastLen;		/**< Length of the last frame */
+	u8 Partial[8];		/**< Bytes of a frame split over packets */
+	u8 NumPartial;		/**< Number of bytes in Partial */
+	u64 StartTime;		/**< Timer value of the first start frame */
+	u64 Time;		/**< Timer value of the last frame */
+	u64 Begin[XAIETILE_EVENT_NUM_TRACE_EVENT]; /**< Start of active slots */
+	XAie_TraceEvents Events;	/**< Events of the trace slots */
+	XAieTileTrace_Hist Hist[XAIETILE_EVENT_NUM_TRACE_EVENT]; /**< Stats */
+} XAieTileTrace_Stream;
+
+/**
+ * This typedef contains a trace decoder.
+ */
+typedef struct {
+	XAieTileTrace_Stream Streams[XAIETILE_TRACE_MAX_STREAMS]; /**< Streams */
+	u32 NumStreams;		/**< Number of streams in use */
+	u32 ClockMhz;		/**< AIE clock to convert cycles to time */
+	FILE *Json;		/**< Chrome trace output, or XAIE_NULL */
+	u64 NumJsonEvents;	/**< Number of events written to Json */
+	u64 NumDropped;		/**< Packets dropped, no free stream */
+	u64 NumBadFrames;	/**< Undecodable frames */
+} XAieTileTrace_Decoder;
+
+/***************************** Macro Definitions *****************************/
+
+/************************** Function Prototypes  *****************************/
+/*
+ * Capture
+ */
+void XAieTileTrace_CoreStallEvents(XAie_TraceEvents *TraceEvents);
+void XAieTileTrace_MemDmaEvents(XAie_TraceEvents *TraceEvents);
+u8 XAieTileTrace_CoreConfig(XAieGbl_Tile *TileInstPtr, XAie_TraceEvents *TraceEvents, u8 BroadcastId, u8 PktId);
+u8 XAieTileTrace_MemConfig(XAieGbl_Tile *TileInstPtr, XAie_TraceEvents *TraceEvents, u8 BroadcastId, u8 PktId);
+u8 XAieTileTrace_RouteColumn(XAieGbl_Tile *TileInstPtr, u16 RowId, u8 Module, u8 Port, u8 ChNum);
+u8 XAieTileTrace_ShimDmaStart(XAieDma_Shim *DmaInstPtr, u8 ChNum, u8 BdNum, u64 Addr, u32 Length);
+u8 XAieTileTrace_Start(XAieGbl_Tile *TileInstPtr, u8 BroadcastId);
+
+/*
+ * Decode
+ */
+void XAieTileTrace_DecoderInit(XAieTileTrace_Decoder *DecPtr, u32 ClockMhz, FILE *Json);
+u8 XAieTileTrace_DecoderSetEvents(XAieTileTrace_Decoder *DecPtr, u16 ColId, u16 RowId, u8 PktType, XAie_TraceEvents *TraceEvents);
+u32 XAieTileTrace_Decode(XAieTileTrace_Decoder *DecPtr, const u32 *Words, u32 NumWords);
+void XAieTileTrace_DecoderFinish(XAieTileTrace_Decoder *DecPtr);
+XAieTileTrace_Hist *XAieTileTrace_GetHist(XAieTileTrace_Decoder *DecPtr, u16 ColId, u16 RowId, u8 PktType, u8 Slot);
+void XAieTileTrace_WriteHist(XAieTileTrace_Decoder *DecPtr, FILE *Out);
+
+#endif		/* end of protection macro */
+
+/** @} */
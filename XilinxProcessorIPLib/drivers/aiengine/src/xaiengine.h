@@ -29,6 +29,7 @@ extern "C" {
 #include <xaiengine/xaietile_shim.h>
 #include <xaiengine/xaietile_strm.h>
 #include <xaiengine/xaietile_timer.h>
+#include <xaiengine/xaietile_trace.h>
 #include <xaiengine/xparameters_aie.h>
 
 #ifdef __AIESIM__
@@ -176,6 +176,19 @@
 *   and no new packets to process. Note that the interrupt will only fire if
 *   at least one packet has been processed.
 *
+* <b> Concurrent Submission </b>
+*
+* The BD ring functions above must be serialized by the application. When
+* several tasks or interrupt handlers submit to the same channel, a started
+* ring with no BD allocated can be switched to the concurrent submission mode
+* with XAxiDma_BdRingMpInit(), on compilers with the GCC atomic builtins
+* (XAXIDMA_HAS_MP_RING). The producers then reserve BDs with
+* XAxiDma_BdRingMpAlloc() and submit them with XAxiDma_BdRingMpToHw() with no
+* lock. The producer that finds no commit in progress gives all the ready BDs
+* to hardware with one write of the tail descriptor register. A single
+* consumer retrieves the completed BDs in batches with
+* XAxiDma_BdRingMpFromHw() and releases them with XAxiDma_BdRingMpFree().
+*
 * <b> Interrupt </b>
 *
 * Interrupts are handled by the user application. Each DMA channel has its own
@@ -452,6 +465,7 @@
 *                     In XAxiDma_LookupConfigBaseAddr() use UINTPTR for Baseaddr.
 * 9.7  rsp   04/25/18 Add SgLengthWidth member in dma config structure. CR #1000474
 * 9.13 rsp   01/08/21 Fix compilation failure in XAxiDma_IntrGetEnabled().
+* 9.14 jb    10/18/26 Added the concurrent submission mode of the BD ring.
 * </pre>
 *
 ******************************************************************************/
@@ -44,6 +44,11 @@
 *       rsp  01/17/18  Use virtual address for register read/write.
 *                      In _BdRingCreate() assign VA to BdaRestart CR#976392
 * 9.9   rsp  02/05/19  Fix XAxiDma_BdRingFromHw implementation for cyclic mode.
+* 9.14  jb   10/18/26  Added the concurrent submission mode of the BD ring,
+*		       see XAxiDma_BdRingMpInit().
+*       jb   10/18/26  Commit the BDs submitted while halted on restart.
+*       jb   10/18/26  Release the concurrent submission flags when the ring
+*		       is re-created, size them to the ring.
 *
 * </pre>
 ******************************************************************************/
@@ -141,7 +146,42 @@
         (BdPtr) = (XAxiDma_Bd*)Addr;                                  \
     }
 
+#ifdef XAXIDMA_HAS_MP_RING
+/******************************************************************************
+ * Helpers of the concurrent submission mode. The BD indices run from 0 to
+ * twice the number of BDs, so that a full ring can be told from an empty
+ * one. The slot of an index is the position of its BD in the ring.
+ *
+ * @note	RingPtr is the ring the indices and BDs belong to
+ *
+ *****************************************************************************/
+#define XAXIDMA_MP_ADD(RingPtr, Index, NumBd)                              \
+	(((Index) + (u32)(NumBd) >= 2U * (u32)(RingPtr)->AllCnt) ?         \
+	 ((Index) + (u32)(NumBd) - 2U * (u32)(RingPtr)->AllCnt) :          \
+	 ((Index) + (u32)(NumBd)))
+
+#define XAXIDMA_MP_DIFF(RingPtr, Index1, Index2)                           \
+	(((Index1) >= (Index2)) ? ((Index1) - (Index2)) :                  \
+	 ((Index1) + 2U * (u32)(RingPtr)->AllCnt - (Index2)))
+
+#define XAXIDMA_MP_INDEX_SLOT(RingPtr, Index)                              \
+	(((Index) >= (u32)(RingPtr)->AllCnt) ?                             \
+	 ((Index) - (u32)(RingPtr)->AllCnt) : (Index))
+
+#define XAXIDMA_MP_BD(RingPtr, Index)                                      \
+	((XAxiDma_Bd *)(void *)((RingPtr)->FirstBdAddr +                   \
+		(RingPtr)->Separation *                                    \
+		XAXIDMA_MP_INDEX_SLOT(RingPtr, Index)))
+
+#define XAXIDMA_MP_SLOT(RingPtr, BdPtr)                                    \
+	((u32)(((UINTPTR)(BdPtr) - (RingPtr)->FirstBdAddr) /               \
+	       (RingPtr)->Separation))
+#endif
+
 /************************** Function Prototypes ******************************/
+#ifdef XAXIDMA_HAS_MP_RING
+static void XAxiDma_BdRingMpCommit(XAxiDma_BdRing * RingPtr);
+#endif
 
 /************************** Variable Definitions *****************************/
 
@@ -344,6 +384,17 @@ u32 XAxiDma_BdRingCreate(XAxiDma_BdRing *RingPtr, UINTPTR PhysAddr,
 	RingPtr->PostCnt = 0;
 	RingPtr->Cyclic = 0;
 
+#ifdef XAXIDMA_HAS_MP_RING
+	/* The ring is re-created for use without concurrent submission until
+	 * XAxiDma_BdRingMpInit() is called again
+	 */
+	if (RingPtr->MpReady != NULL) {
+		free(RingPtr->MpReady);
+		RingPtr->MpReady = NULL;
+	}
+	RingPtr->MpReadyCnt = 0;
+#endif
+
 	/* Make sure Alignment parameter meets minimum requirements */
 	if (Alignment < XAXIDMA_BD_MINIMUM_ALIGNMENT) {
 
@@ -662,6 +713,17 @@ int XAxiDma_BdRingStart(XAxiDma_BdRing * RingPtr)
 		return Status;
 	}
 
+#ifdef XAXIDMA_HAS_MP_RING
+	/* Give hardware the BDs submitted in concurrent submission mode while
+	 * the channel was halted. Either this commit or the producer holding
+	 * the commit lock sees the channel running.
+	 */
+	if (RingPtr->MpReady != NULL) {
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+		XAxiDma_BdRingMpCommit(RingPtr);
+	}
+#endif
+
 	return XST_SUCCESS;
 }
 
@@ -1379,6 +1441,452 @@ int XAxiDma_BdRingFree(XAxiDma_BdRing * RingPtr, int NumBd,
 
 	return XST_SUCCESS;
 }
+#ifdef XAXIDMA_HAS_MP_RING
+/*****************************************************************************/
+/**
+ * Set up the concurrent submission mode of a BD ring.
+ *
+ * In this mode, several producers, such as tasks and interrupt handlers,
+ * submit BDs to the same channel without any mutual exclusion:
+ *
+ * - A producer reserves a set of BDs with XAxiDma_BdRingMpAlloc(), which
+ *   moves the reservation index with an atomic compare and swap.
+ * - It sets the BDs up and hands them over with XAxiDma_BdRingMpToHw(),
+ *   which marks them ready and tries to take the commit lock. The holder of
+ *   the lock gives all the contiguous ready BDs to hardware with a single
+ *   write of the tail descriptor register. A producer that does not get the
+ *   lock returns at once, its BDs are committed by the holder.
+ * - A single consumer, typically the interrupt handler of the channel,
+ *   retrieves the completed BDs in batches with XAxiDma_BdRingMpFromHw(),
+ *   and releases them to the producers with XAxiDma_BdRingMpFree().
+ *
+ * No producer waits for another one, so the submission latency does not
+ * depend on the number of producers. BDs are given to hardware in the order
+ * of their reservations, so a set reserved and not submitted holds the sets
+ * reserved after it.
+ *
+ * The ring must be created and started with no BD allocated, and is then
+ * only used through the XAxiDma_BdRingMp* functions. The other BD ring
+ * functions do not track the BDs of this mode.
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ *
+ * @return
+ *		- XST_SUCCESS if the ring is ready for concurrent submission.
+ *		- XST_DMA_SG_NO_LIST if the ring has not been created.
+ *		- XST_DMA_SG_LIST_ERROR if some BDs are not in the free group
+ *		or the ring is in cyclic mode.
+ *		- XST_DMA_SG_IS_STOPPED if the channel is not started.
+ *		- XST_FAILURE if the BD flags could not be allocated.
+ *
+ * @note	This function can be used only when DMA is in SG mode
+ *
+ *****************************************************************************/
+int XAxiDma_BdRingMpInit(XAxiDma_BdRing * RingPtr)
+{
+	u32 Index;
+
+	if (RingPtr->AllCnt == 0) {
+		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingMpInit: no bds\r\n");
+		return XST_DMA_SG_NO_LIST;
+	}
+
+	if ((RingPtr->FreeCnt != RingPtr->AllCnt) || RingPtr->Cyclic) {
+		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingMpInit: BDs in use\r\n");
+		return XST_DMA_SG_LIST_ERROR;
+	}
+
+	if (RingPtr->RunState != AXIDMA_CHANNEL_NOT_HALTED) {
+		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingMpInit: channel not "
+			"started\r\n");
+		return XST_DMA_SG_IS_STOPPED;
+	}
+
+	if ((RingPtr->MpReady != NULL) &&
+	    (RingPtr->MpReadyCnt != (u32)RingPtr->AllCnt)) {
+		free(RingPtr->MpReady);
+		RingPtr->MpReady = NULL;
+		RingPtr->MpReadyCnt = 0;
+	}
+	if (RingPtr->MpReady == NULL) {
+		RingPtr->MpReady = (u8 *)malloc(RingPtr->AllCnt);
+		if (RingPtr->MpReady == NULL) {
+			return XST_FAILURE;
+		}
+		RingPtr->MpReadyCnt = RingPtr->AllCnt;
+	}
+	memset(RingPtr->MpReady, 0, RingPtr->MpReadyCnt);
+
+	/* Hardware resumes from the free head, see XAxiDma_BdRingStart() */
+	Index = XAXIDMA_MP_SLOT(RingPtr, RingPtr->FreeHead);
+	RingPtr->MpProdHead = Index;
+	RingPtr->MpCommitHead = Index;
+	RingPtr->MpDoneHead = Index;
+	RingPtr->MpFreeHead = Index;
+	RingPtr->MpCommitLock = 0;
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * Reserve a set of BDs in concurrent submission mode. This function may be
+ * called by several producers at once, including interrupt handlers.
+ *
+ * The BDs of the set are contiguous in the ring, they are traversed with
+ * XAxiDma_BdRingNext(). Once set up, they must be submitted with
+ * XAxiDma_BdRingMpToHw(). There is no way to return them to the free group
+ * otherwise.
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ * @param	NumBd is the number of BDs to reserve.
+ * @param	BdSetPtr is an output parameter, it points to the first BD
+ *		of the set.
+ *
+ * @return
+ *		- XST_SUCCESS if the requested number of BDs were reserved.
+ *		- XST_INVALID_PARAM if passed in NumBd is not positive.
+ *		- XST_FAILURE if there were not enough free BDs to satisfy
+ *		the request.
+ *
+ * @note	This function can be used only when DMA is in SG mode
+ *
+ *****************************************************************************/
+int XAxiDma_BdRingMpAlloc(XAxiDma_BdRing * RingPtr, int NumBd,
+	XAxiDma_Bd ** BdSetPtr)
+{
+	u32 Head;
+	u32 Cur;
+	int FreeCnt;
+
+	if (NumBd <= 0) {
+		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingMpAlloc: negative BD "
+				"number %d\r\n", NumBd);
+		return XST_INVALID_PARAM;
+	}
+
+	Head = __atomic_load_n(&RingPtr->MpProdHead, __ATOMIC_RELAXED);
+	for (;;) {
+		/* The consumer must be done with the BDs before they are
+		 * reused, hence the acquire
+		 */
+		FreeCnt = RingPtr->AllCnt - (int)XAXIDMA_MP_DIFF(RingPtr, Head,
+			__atomic_load_n(&RingPtr->MpFreeHead,
+					__ATOMIC_ACQUIRE));
+		if (FreeCnt < NumBd) {
+			/* The head may be stale rather than the ring full */
+			Cur = __atomic_load_n(&RingPtr->MpProdHead,
+					      __ATOMIC_RELAXED);
+			if (Cur == Head) {
+				return XST_FAILURE;
+			}
+			Head = Cur;
+			continue;
+		}
+
+		if (__atomic_compare_exchange_n(&RingPtr->MpProdHead, &Head,
+				XAXIDMA_MP_ADD(RingPtr, Head, NumBd), 1,
+				__ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+			break;
+		}
+	}
+
+	*BdSetPtr = XAXIDMA_MP_BD(RingPtr, Head);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * Give the ready BDs to hardware, if no other producer is doing it. The
+ * holder of the commit lock looks for ready BDs again after releasing it,
+ * so that the BDs marked ready while it held the lock are not left behind.
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XAxiDma_BdRingMpCommit(XAxiDma_BdRing * RingPtr)
+{
+	XAxiDma_Bd *TailBdPtr;
+	u32 TailOffset = XAXIDMA_TDESC_OFFSET;
+	u32 Index;
+	u32 Slot;
+	int NumBd;
+
+	if (RingPtr->IsRxChannel && RingPtr->RingIndex) {
+		TailOffset = XAXIDMA_RX_TDESC0_OFFSET +
+			(RingPtr->RingIndex - 1) * XAXIDMA_RX_NDESC_OFFSET;
+	}
+
+	do {
+		if (__atomic_exchange_n(&RingPtr->MpCommitLock, 1,
+					__ATOMIC_ACQUIRE)) {
+			return;
+		}
+
+		Index = RingPtr->MpCommitHead;
+		TailBdPtr = NULL;
+		/* While the channel is halted, the ready BDs are left for
+		 * XAxiDma_BdRingStart()
+		 */
+		for (NumBd = 0; (NumBd < RingPtr->AllCnt) &&
+		     (RingPtr->RunState == AXIDMA_CHANNEL_NOT_HALTED); NumBd++) {
+			Slot = XAXIDMA_MP_INDEX_SLOT(RingPtr, Index);
+			if (!__atomic_load_n(&RingPtr->MpReady[Slot],
+					     __ATOMIC_ACQUIRE)) {
+				break;
+			}
+			RingPtr->MpReady[Slot] = 0;
+			TailBdPtr = XAXIDMA_MP_BD(RingPtr, Index);
+			Index = XAXIDMA_MP_ADD(RingPtr, Index, 1);
+		}
+
+		if (TailBdPtr != NULL) {
+			/* The producers flushed their BDs before marking
+			 * them ready
+			 */
+			DATA_SYNC;
+			RingPtr->HwTail = TailBdPtr;
+			XAxiDma_WriteReg(RingPtr->ChanBase, TailOffset,
+				(XAXIDMA_VIRT_TO_PHYS(TailBdPtr) &
+				 XAXIDMA_DESC_LSB_MASK));
+			if (RingPtr->Addr_ext)
+				XAxiDma_WriteReg(RingPtr->ChanBase,
+					TailOffset + (XAXIDMA_TDESC_MSB_OFFSET -
+					XAXIDMA_TDESC_OFFSET),
+					UPPER_32_BITS(XAXIDMA_VIRT_TO_PHYS(
+						TailBdPtr)));
+			__atomic_store_n(&RingPtr->MpCommitHead, Index,
+					 __ATOMIC_RELEASE);
+		}
+
+		__atomic_store_n(&RingPtr->MpCommitLock, 0, __ATOMIC_RELEASE);
+		__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	} while ((__atomic_load_n(&RingPtr->RunState, __ATOMIC_RELAXED) ==
+		  AXIDMA_CHANNEL_NOT_HALTED) &&
+		 __atomic_load_n(&RingPtr->MpReady[XAXIDMA_MP_INDEX_SLOT(
+			RingPtr, Index)], __ATOMIC_RELAXED));
+}
+
+/*****************************************************************************/
+/**
+ * Submit a set of BDs reserved by XAxiDma_BdRingMpAlloc() in concurrent
+ * submission mode. This function may be called by several producers at once,
+ * including interrupt handlers.
+ *
+ * The set goes under hardware control once all the sets reserved before it
+ * are submitted too, and the channel is running. The sets submitted while the
+ * channel is halted are given to hardware by XAxiDma_BdRingStart(). For
+ * transmit, the first BD of the set must mark the start of a packet and the
+ * last BD its end.
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ * @param	NumBd is the number of BDs in the set.
+ * @param	BdSetPtr is the first BD of the set, as returned by
+ *		XAxiDma_BdRingMpAlloc().
+ *
+ * @return
+ *		- XST_SUCCESS if the set was submitted.
+ *		- XST_INVALID_PARAM if passed in NumBd is not positive.
+ *		- XST_FAILURE if the set was rejected because the first BD
+ *		does not have its start-of-packet bit set, or the last BD
+ *		does not have its end-of-packet bit set, or any one of the BDs
+ *		has 0 length. The set must be corrected and submitted again.
+ *
+ * @note	This function can be used only when DMA is in SG mode
+ *
+ *****************************************************************************/
+int XAxiDma_BdRingMpToHw(XAxiDma_BdRing * RingPtr, int NumBd,
+	XAxiDma_Bd * BdSetPtr)
+{
+	XAxiDma_Bd *CurBdPtr;
+	u32 BdCr;
+	u32 BdSts;
+	u32 Slot;
+	int i;
+
+	if (NumBd <= 0) {
+		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingMpToHw: negative BD "
+			"number %d\r\n", NumBd);
+		return XST_INVALID_PARAM;
+	}
+
+	/* Check the set before any BD goes to hardware */
+	CurBdPtr = BdSetPtr;
+	for (i = 0; i < NumBd; i++) {
+		BdCr = XAxiDma_BdGetCtrl(CurBdPtr);
+		if ((!(RingPtr->IsRxChannel) &&
+		     (((i == 0) && !(BdCr & XAXIDMA_BD_CTRL_TXSOF_MASK)) ||
+		      ((i == NumBd - 1) &&
+		       !(BdCr & XAXIDMA_BD_CTRL_TXEOF_MASK)))) ||
+		    (XAxiDma_BdGetLength(CurBdPtr,
+				RingPtr->MaxTransferLen) == 0)) {
+			xdbg_printf(XDBG_DEBUG_ERROR, "BdRingMpToHw: invalid "
+				"bd %d\r\n", i);
+			return XST_FAILURE;
+		}
+		CurBdPtr = (XAxiDma_Bd *)((void *)XAxiDma_BdRingNext(RingPtr,
+								CurBdPtr));
+	}
+
+	/* Clear the completed status bits and flush the BDs */
+	CurBdPtr = BdSetPtr;
+	for (i = 0; i < NumBd; i++) {
+		BdSts = XAxiDma_BdRead(CurBdPtr, XAXIDMA_BD_STS_OFFSET);
+		BdSts &= ~XAXIDMA_BD_STS_COMPLETE_MASK;
+		XAxiDma_BdWrite(CurBdPtr, XAXIDMA_BD_STS_OFFSET, BdSts);
+		XAXIDMA_CACHE_FLUSH(CurBdPtr);
+		CurBdPtr = (XAxiDma_Bd *)((void *)XAxiDma_BdRingNext(RingPtr,
+								CurBdPtr));
+	}
+	DATA_SYNC;
+
+	/* Mark the set ready, then commit it unless another producer is
+	 * committing
+	 */
+	Slot = XAXIDMA_MP_SLOT(RingPtr, BdSetPtr);
+	for (i = 0; i < NumBd; i++) {
+		__atomic_store_n(&RingPtr->MpReady[Slot], 1, __ATOMIC_RELEASE);
+		Slot = (Slot + 1 == (u32)RingPtr->AllCnt) ? 0 : Slot + 1;
+	}
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+	XAxiDma_BdRingMpCommit(RingPtr);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+ * Retrieve the BDs completed by hardware in concurrent submission mode. Only
+ * one consumer may call this function and XAxiDma_BdRingMpFree() for a ring.
+ *
+ * All the BDs completed since the last call are returned in one set, up to
+ * BdLimit, as for XAxiDma_BdRingFromHw(). The BDs of a partially completed
+ * packet are left for the next call.
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ * @param	BdLimit is the maximum number of BDs to return in the set.
+ * @param	BdSetPtr is an output parameter, it points to the first BD
+ *		of the set.
+ *
+ * @return	The number of BDs processed by hardware, 0 if none.
+ *
+ * @note	This function can be used only when DMA is in SG mode
+ *
+ *****************************************************************************/
+int XAxiDma_BdRingMpFromHw(XAxiDma_BdRing * RingPtr, int BdLimit,
+	XAxiDma_Bd ** BdSetPtr)
+{
+	XAxiDma_Bd *CurBdPtr;
+	u32 Head;
+	int BdCount = 0;
+	int BdPartialCount = 0;
+	int HwCnt;
+	u32 BdSts;
+	u32 BdCr;
+
+	Head = RingPtr->MpDoneHead;
+	HwCnt = (int)XAXIDMA_MP_DIFF(RingPtr,
+		__atomic_load_n(&RingPtr->MpCommitHead, __ATOMIC_ACQUIRE),
+		Head);
+	if (BdLimit > HwCnt) {
+		BdLimit = HwCnt;
+	}
+
+	CurBdPtr = XAXIDMA_MP_BD(RingPtr, Head);
+	while (BdCount < BdLimit) {
+		XAXIDMA_CACHE_INVALIDATE(CurBdPtr);
+		BdSts = XAxiDma_BdRead(CurBdPtr, XAXIDMA_BD_STS_OFFSET);
+		if (!(BdSts & XAXIDMA_BD_STS_COMPLETE_MASK)) {
+			break;
+		}
+		BdCr = XAxiDma_BdRead(CurBdPtr, XAXIDMA_BD_CTRL_LEN_OFFSET);
+		BdCount++;
+
+		/* Only return whole packets */
+		if ((!(RingPtr->IsRxChannel) &&
+		     (BdCr & XAXIDMA_BD_CTRL_TXEOF_MASK)) ||
+		    ((RingPtr->IsRxChannel) &&
+		     (BdSts & XAXIDMA_BD_STS_RXEOF_MASK))) {
+			BdPartialCount = 0;
+		}
+		else {
+			BdPartialCount++;
+		}
+
+		CurBdPtr = (XAxiDma_Bd *)((void *)XAxiDma_BdRingNext(RingPtr,
+								CurBdPtr));
+	}
+
+	BdCount -= BdPartialCount;
+	if (BdCount) {
+		*BdSetPtr = XAXIDMA_MP_BD(RingPtr, Head);
+		RingPtr->MpDoneHead = XAXIDMA_MP_ADD(RingPtr, Head, BdCount);
+	}
+
+	return BdCount;
+}
+
+/*****************************************************************************/
+/**
+ * Release BDs returned by XAxiDma_BdRingMpFromHw() to the producers, in
+ * concurrent submission mode. The BDs must be released in the order they
+ * were returned.
+ *
+ * @param	RingPtr is a pointer to the descriptor ring instance to be
+ *		worked on.
+ * @param	NumBd is the number of BDs to release.
+ * @param	BdSetPtr is the first BD to release.
+ *
+ * @return
+ *		- XST_SUCCESS if the set of BDs was released.
+ *		- XST_INVALID_PARAM if passed in NumBd is negative.
+ *		- XST_DMA_SG_LIST_ERROR if the BDs were not returned by
+ *		XAxiDma_BdRingMpFromHw(), or not in order.
+ *
+ * @note	This function can be used only when DMA is in SG mode
+ *
+ *****************************************************************************/
+int XAxiDma_BdRingMpFree(XAxiDma_BdRing * RingPtr, int NumBd,
+	XAxiDma_Bd * BdSetPtr)
+{
+	u32 Head = RingPtr->MpFreeHead;
+
+	if (NumBd < 0) {
+		xdbg_printf(XDBG_DEBUG_ERROR,
+		    "BdRingMpFree: negative BDs %d\r\n", NumBd);
+		return XST_INVALID_PARAM;
+	}
+
+	if (NumBd == 0) {
+		return XST_SUCCESS;
+	}
+
+	if (((int)XAXIDMA_MP_DIFF(RingPtr, RingPtr->MpDoneHead, Head) < NumBd)
+	    || (XAXIDMA_MP_BD(RingPtr, Head) != BdSetPtr)) {
+		xdbg_printf(XDBG_DEBUG_ERROR, "BdRingMpFree: Error free BDs: "
+			"to free %d, ptr %x\r\n", NumBd, (UINTPTR)BdSetPtr);
+		return XST_DMA_SG_LIST_ERROR;
+	}
+
+	/* Release the BDs to the producers once they are done with */
+	__atomic_store_n(&RingPtr->MpFreeHead,
+			 XAXIDMA_MP_ADD(RingPtr, Head, NumBd),
+			 __ATOMIC_RELEASE);
+
+	return XST_SUCCESS;
+}
+#endif /* XAXIDMA_HAS_MP_RING */
+
 /*****************************************************************************/
 /**
  * Check the internal data structures of the BD ring for the provided channel.
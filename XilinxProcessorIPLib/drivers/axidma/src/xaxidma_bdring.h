@@ -43,6 +43,18 @@
 *		       backward compatibility.
 * 9.2   vak  15/04/16  Fixed the compilation warnings in axidma driver
 * 9.7   rsp  01/11/18  Use UINTPTR instead of u32 for ChanBase CR#976392
+* 9.14  jb   10/18/26  Added the concurrent submission mode of the BD ring
+*		       for multiple producers.
+*		      - New APIs
+*			* XAxiDma_BdRingMpInit(XAxiDma_BdRing * RingPtr)
+*			* XAxiDma_BdRingMpAlloc(XAxiDma_BdRing * RingPtr,
+*				int NumBd, XAxiDma_Bd ** BdSetPtr)
+*			* XAxiDma_BdRingMpToHw(XAxiDma_BdRing * RingPtr,
+*				int NumBd, XAxiDma_Bd * BdSetPtr)
+*			* XAxiDma_BdRingMpFromHw(XAxiDma_BdRing * RingPtr,
+*				int BdLimit, XAxiDma_Bd ** BdSetPtr)
+*			* XAxiDma_BdRingMpFree(XAxiDma_BdRing * RingPtr,
+*				int NumBd, XAxiDma_Bd * BdSetPtr)
 *
 * </pre>
 *
@@ -72,6 +84,12 @@ extern "C" {
 #define XAXIDMA_NO_CHANGE		0xFFFFFFFF
 #define XAXIDMA_ALL_BDS			0x0FFFFFFF /* 268 Million */
 
+/* The concurrent submission mode needs the atomic builtins of the compiler
+ */
+#if defined (__GNUC__) || defined (__clang__)
+#define XAXIDMA_HAS_MP_RING		1
+#endif
+
 /**************************** Type Definitions *******************************/
 
 /** Container structure for descriptor storage control. If address translation
@@ -109,6 +127,19 @@ typedef struct {
 	int AllCnt;		/**< Total Number of BDs for channel */
 	int RingIndex;		/**< Ring Index */
 	int Cyclic;		/**< Check for cyclic DMA Mode */
+
+	/* Concurrent submission mode, see XAxiDma_BdRingMpInit(). The
+	 * indices run from 0 to twice the number of BDs, so that a full ring
+	 * can be told from an empty one.
+	 */
+	u8 *MpReady;		/**< Per BD flags, set by the producers once
+				  *  a BD is ready for hardware */
+	u32 MpReadyCnt;		/**< Number of flags in MpReady */
+	u32 MpProdHead;		/**< Next BD index reserved by a producer */
+	u32 MpCommitHead;	/**< Next BD index to give to hardware */
+	u32 MpDoneHead;		/**< Next BD index to check for completion */
+	u32 MpFreeHead;		/**< Next BD index to release */
+	u32 MpCommitLock;	/**< Held by the producer committing BDs */
 } XAxiDma_BdRing;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -504,6 +535,17 @@ int XAxiDma_BdRingFromHw(XAxiDma_BdRing * RingPtr, int BdLimit,
 int XAxiDma_BdRingFree(XAxiDma_BdRing * RingPtr, int NumBd,
 		XAxiDma_Bd * BdSetPtr);
 int XAxiDma_BdRingStart(XAxiDma_BdRing * RingPtr);
+#ifdef XAXIDMA_HAS_MP_RING
+int XAxiDma_BdRingMpInit(XAxiDma_BdRing * RingPtr);
+int XAxiDma_BdRingMpAlloc(XAxiDma_BdRing * RingPtr, int NumBd,
+		XAxiDma_Bd ** BdSetPtr);
+int XAxiDma_BdRingMpToHw(XAxiDma_BdRing * RingPtr, int NumBd,
+		XAxiDma_Bd * BdSetPtr);
+int XAxiDma_BdRingMpFromHw(XAxiDma_BdRing * RingPtr, int BdLimit,
+		XAxiDma_Bd ** BdSetPtr);
+int XAxiDma_BdRingMpFree(XAxiDma_BdRing * RingPtr, int NumBd,
+		XAxiDma_Bd * BdSetPtr);
+#endif
 int XAxiDma_BdRingSetCoalesce(XAxiDma_BdRing * RingPtr, u32 Counter, u32 Timer);
 void XAxiDma_BdRingGetCoalesce(XAxiDma_BdRing * RingPtr,
 		u32 *CounterPtr, u32 *TimerPtr);
@@ -32,6 +32,7 @@
 * 3.8  mus  11/05/18 Support 64 bit DMA addresses for Microblaze-X platform.
 * 3.10 hk   05/16/19 Clear status registers properly in reset
 * 3.11 sd   02/14/20 Add clock support
+* 3.16 jb   10/18/26 Support receive queue 1 in XEmacPs_SetQueuePtr
 *
 * </pre>
 ******************************************************************************/
@@ -466,9 +467,15 @@ void XEmacPs_SetQueuePtr(XEmacPs *InstancePtr, UINTPTR QPtr, u8 QueueNum,
 		}
 	}
 	 else {
-		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
-			XEMACPS_TXQ1BASE_OFFSET,
-			(QPtr & ULONG64_LO_MASK));
+		if (Direction == XEMACPS_SEND) {
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_TXQ1BASE_OFFSET,
+				(QPtr & ULONG64_LO_MASK));
+		} else {
+			XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				XEMACPS_RXQ1BASE_OFFSET,
+				(QPtr & ULONG64_LO_MASK));
+		}
 	}
 #ifdef __aarch64__
 	if (Direction == XEMACPS_SEND) {
@@ -309,6 +309,8 @@
  * 3.9   hk   01/23/19 Add RX watermark support
  * 3.11  sd   02/14/20 Add clock support
  * 3.13  nsk  12/14/20 Updated the tcl to not to use the instance names.
+ * 3.16  jb   10/18/26 Add interrupt moderation, receive queue 1 and
+ *                    screener support.
  *
  * </pre>
  *
@@ -550,6 +552,8 @@ typedef struct XEmacPs_Instance {
 	u32 MaxMtuSize;
 	u32 MaxFrameSize;
 	u32 MaxVlanFrameSize;
+	u32 RxQueueStatus;	/* Receive queues with a completed frame,
+				   valid inside the receive handler */
 
 } XEmacPs;
 
@@ -831,6 +835,12 @@ LONG XEmacPs_PhyRead(XEmacPs *InstancePtr, u32 PhyAddress,
 LONG XEmacPs_PhyWrite(XEmacPs *InstancePtr, u32 PhyAddress,
 		      u32 RegisterNum, u16 PhyData);
 LONG XEmacPs_SetTypeIdCheck(XEmacPs *InstancePtr, u32 Id_Check, u8 Index);
+LONG XEmacPs_SetScreenerT1(XEmacPs *InstancePtr, u8 Index, u8 Queue,
+			   u16 UdpPort);
+LONG XEmacPs_SetScreenerT2Compare(XEmacPs *InstancePtr, u8 Index, u16 Value,
+				  u16 Mask, u8 Base, u8 Offset);
+LONG XEmacPs_SetScreenerT2(XEmacPs *InstancePtr, u8 Index, u8 Queue,
+			   u8 EthTypeIndex, u16 EthType, u8 CompareIndex);
 
 LONG XEmacPs_SendPausePacket(XEmacPs *InstancePtr);
 void XEmacPs_DMABLengthUpdate(XEmacPs *InstancePtr, s32 BLength);
@@ -26,6 +26,7 @@
  * 3.0   kvn  02/13/15 Modified code for MISRA-C:2012 compliance.
  * 3.0   hk   02/20/15 Added support for jumbo frames.
  * 3.2   hk   02/22/16 Added SGMII support for Zynq Ultrascale+ MPSoC.
+ * 3.16  jb   10/18/26 Added screener APIs for receive queue steering.
  * </pre>
  *****************************************************************************/
 
@@ -1130,4 +1131,127 @@ void XEmacPs_DMABLengthUpdate(XEmacPs *InstancePtr, s32 BLength)
 	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress, XEMACPS_DMACR_OFFSET,
 																	Reg);
 }
+/*****************************************************************************/
+/**
+ * Program a type 1 screener to steer UDP frames with the given destination
+ * port to a receive queue. Screeners may be changed while the device is
+ * running. Available only on GEM versions with priority queues.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the screener to program (0 to XEMACPS_SCR_NUM - 1).
+ * @param Queue is the receive queue matching frames are steered to.
+ * @param UdpPort is the UDP destination port to match.
+ *
+ * @return
+ * - XST_SUCCESS if the screener was set successfully
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetScreenerT1(XEmacPs *InstancePtr, u8 Index, u8 Queue,
+			   u16 UdpPort)
+{
+	u32 Reg;
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(InstancePtr->Version > 2U);
+	Xil_AssertNonvoid(Index < (u8)XEMACPS_SCR_NUM);
+
+	Reg = ((u32)Queue & XEMACPS_SCR_QUEUE_MASK) |
+		(((u32)UdpPort << XEMACPS_SCRT1_UDPPORT_SHIFT) &
+		 XEMACPS_SCRT1_UDPPORT_MASK) |
+		XEMACPS_SCRT1_UDPEN_MASK;
+	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+		((u32)XEMACPS_SCRT1_OFFSET + ((u32)Index * (u32)4)), Reg);
+
+	return (LONG)(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+ * Program a type 2 screener compare register. The compare matches when the
+ * 16 bits found at Offset bytes from the selected base, masked with Mask,
+ * equal Value.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the compare register (0 to XEMACPS_SCRT2_CMP_NUM - 1).
+ * @param Value is the 16 bit value to compare against.
+ * @param Mask selects the bits of the frame data that are compared.
+ * @param Base is the offset base, one of XEMACPS_SCRT2_BASE_*.
+ * @param Offset is the byte offset from Base.
+ *
+ * @return
+ * - XST_SUCCESS if the compare register was set successfully
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetScreenerT2Compare(XEmacPs *InstancePtr, u8 Index, u16 Value,
+				  u16 Mask, u8 Base, u8 Offset)
+{
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(InstancePtr->Version > 2U);
+	Xil_AssertNonvoid(Index < (u8)XEMACPS_SCRT2_CMP_NUM);
+	Xil_AssertNonvoid(Base <= (u8)XEMACPS_SCRT2_BASE_TCPUDP);
+
+	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+		((u32)XEMACPS_SCRT2_CMPW0_OFFSET + ((u32)Index * (u32)8)),
+		(((u32)Value << XEMACPS_SCRT2_CMPW0_VAL_SHIFT) |
+		 ((u32)Mask & XEMACPS_SCRT2_CMPW0_MASK_MASK)));
+	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+		((u32)XEMACPS_SCRT2_CMPW1_OFFSET + ((u32)Index * (u32)8)),
+		(((u32)Base << XEMACPS_SCRT2_CMPW1_BASE_SHIFT) |
+		 ((u32)Offset & XEMACPS_SCRT2_CMPW1_OFST_MASK)));
+
+	return (LONG)(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+ * Program a type 2 screener to steer frames to a receive queue on an
+ * ethertype match and/or a compare register match. The ethertype is written
+ * to ethertype register EthTypeIndex.
+ *
+ * @param InstancePtr is a pointer to the instance to be worked on.
+ * @param Index is the screener to program (0 to XEMACPS_SCR_NUM - 1).
+ * @param Queue is the receive queue matching frames are steered to.
+ * @param EthTypeIndex is the ethertype register to use, or XEMACPS_SCR_NONE.
+ * @param EthType is the ethertype to match when EthTypeIndex is used.
+ * @param CompareIndex is a compare register programmed with
+ *        XEmacPs_SetScreenerT2Compare(), or XEMACPS_SCR_NONE.
+ *
+ * @return
+ * - XST_SUCCESS if the screener was set successfully
+ *
+ *****************************************************************************/
+LONG XEmacPs_SetScreenerT2(XEmacPs *InstancePtr, u8 Index, u8 Queue,
+			   u8 EthTypeIndex, u16 EthType, u8 CompareIndex)
+{
+	u32 Reg;
+	Xil_AssertNonvoid(InstancePtr != NULL);
+	Xil_AssertNonvoid(InstancePtr->IsReady == (u32)XIL_COMPONENT_IS_READY);
+	Xil_AssertNonvoid(InstancePtr->Version > 2U);
+	Xil_AssertNonvoid(Index < (u8)XEMACPS_SCR_NUM);
+	Xil_AssertNonvoid((EthTypeIndex < (u8)XEMACPS_SCRT2_ETHT_NUM) ||
+			  (EthTypeIndex == (u8)XEMACPS_SCR_NONE));
+	Xil_AssertNonvoid((CompareIndex < (u8)XEMACPS_SCRT2_CMP_NUM) ||
+			  (CompareIndex == (u8)XEMACPS_SCR_NONE));
+
+	Reg = (u32)Queue & XEMACPS_SCR_QUEUE_MASK;
+
+	if (EthTypeIndex != (u8)XEMACPS_SCR_NONE) {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+			((u32)XEMACPS_SCRT2_ETHT_OFFSET +
+			 ((u32)EthTypeIndex * (u32)4)), (u32)EthType);
+		Reg |= (((u32)EthTypeIndex << XEMACPS_SCRT2_ETHT_SHIFT) &
+			XEMACPS_SCRT2_ETHT_MASK) | XEMACPS_SCRT2_ETHTEN_MASK;
+	}
+
+	if (CompareIndex != (u8)XEMACPS_SCR_NONE) {
+		Reg |= (((u32)CompareIndex << XEMACPS_SCRT2_CMPA_SHIFT) &
+			XEMACPS_SCRT2_CMPA_MASK) | XEMACPS_SCRT2_CMPAEN_MASK;
+	}
+
+	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+		((u32)XEMACPS_SCRT2_OFFSET + ((u32)Index * (u32)4)), Reg);
+
+	return (LONG)(XST_SUCCESS);
+}
 /** @} */
@@ -38,6 +38,8 @@
 * 3.8  hk   09/17/18 Fix PTP interrupt masks.
 * 3.9  hk   01/23/19 Add RX watermark support
 * 3.10 hk   05/16/19 Clear status registers properly in reset
+* 3.16 jb   10/18/26 Add interrupt moderation register definitions
+*                    Add RX Q1 and screener register definitions
 * </pre>
 *
 ******************************************************************************/
@@ -131,6 +133,9 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 
 #define XEMACPS_JUMBOMAXLEN_OFFSET   0x00000048U /**< Jumbo max length reg */
 
+#define XEMACPS_INTMOD_OFFSET        0x0000005CU /**< Interrupt moderation reg,
+						      GEM version > 2 only */
+
 #define XEMACPS_RXWATERMARK_OFFSET   0x0000007CU /**< RX watermark reg */
 
 #define XEMACPS_HASHL_OFFSET         0x00000080U /**< Hash Low address reg */
@@ -281,6 +286,8 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 							reg */
 #define XEMACPS_RXQ1BASE_OFFSET	     0x00000480U /**< RX Q1 Base address
 							reg */
+#define XEMACPS_RXQ1BUFSIZE_OFFSET   0x000004A0U /**< RX Q1 buffer size
+							reg */
 #define XEMACPS_MSBBUF_TXQBASE_OFFSET  0x000004C8U /**< MSB Buffer TX Q Base
 							reg */
 #define XEMACPS_MSBBUF_RXQBASE_OFFSET  0x000004D4U /**< MSB Buffer RX Q Base
@@ -292,8 +299,61 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
 #define XEMACPS_INTQ1_IMR_OFFSET     0x00000640U /**< Interrupt Q1 Mask
 							reg */
 
+#define XEMACPS_SCRT1_OFFSET         0x00000500U /**< Screener type 1 regs */
+#define XEMACPS_SCRT2_OFFSET         0x00000540U /**< Screener type 2 regs */
+#define XEMACPS_SCRT2_ETHT_OFFSET    0x000006E0U /**< Screener type 2
+							ethertype regs */
+#define XEMACPS_SCRT2_CMPW0_OFFSET   0x00000700U /**< Screener type 2
+							compare word 0 regs */
+#define XEMACPS_SCRT2_CMPW1_OFFSET   0x00000704U /**< Screener type 2
+							compare word 1 regs */
+
 /* Define some bit positions for registers. */
 
+/** @name screener register bit definitions
+ *  Type 1 screeners steer frames on UDP port / DS field, type 2 screeners on
+ *  ethertype and up to three 16 bit compares at a fixed frame offset.
+ * @{
+ */
+#define XEMACPS_SCR_NUM			16U /**< Screeners of each type */
+#define XEMACPS_SCRT2_ETHT_NUM		8U  /**< Type 2 ethertype regs */
+#define XEMACPS_SCRT2_CMP_NUM		32U /**< Type 2 compare regs */
+#define XEMACPS_SCR_QUEUE_MASK		0x0000000FU /**< Destination queue */
+
+#define XEMACPS_SCRT1_UDPPORT_MASK	0x0FFFF000U /**< UDP port to match */
+#define XEMACPS_SCRT1_UDPPORT_SHIFT	12U
+#define XEMACPS_SCRT1_UDPEN_MASK	0x20000000U /**< UDP port match enable */
+
+#define XEMACPS_SCRT2_ETHT_MASK		0x00000E00U /**< Ethertype reg index */
+#define XEMACPS_SCRT2_ETHT_SHIFT	9U
+#define XEMACPS_SCRT2_ETHTEN_MASK	0x00001000U /**< Ethertype match enable */
+#define XEMACPS_SCRT2_CMPA_MASK		0x0003E000U /**< Compare A reg index */
+#define XEMACPS_SCRT2_CMPA_SHIFT	13U
+#define XEMACPS_SCRT2_CMPAEN_MASK	0x00040000U /**< Compare A enable */
+
+#define XEMACPS_SCRT2_CMPW0_VAL_SHIFT	16U /**< Compare value, word 0 */
+#define XEMACPS_SCRT2_CMPW0_MASK_MASK	0x0000FFFFU /**< Compare mask, word 0 */
+#define XEMACPS_SCRT2_CMPW1_OFST_MASK	0x0000007FU /**< Byte offset, word 1 */
+#define XEMACPS_SCRT2_CMPW1_BASE_SHIFT	7U /**< Offset base, word 1 */
+
+#define XEMACPS_SCRT2_BASE_FRAME	0U /**< Offset from start of frame */
+#define XEMACPS_SCRT2_BASE_ETHT		1U /**< Offset from after ethertype */
+#define XEMACPS_SCRT2_BASE_IP		2U /**< Offset from after IP header */
+#define XEMACPS_SCRT2_BASE_TCPUDP	3U /**< Offset from after TCP/UDP hdr */
+
+#define XEMACPS_SCR_NONE		0xFFU /**< No ethertype/compare check */
+/*@}*/
+
+/** @name interrupt moderation register bit definitions
+ *  Moderation times are in units of 800 ns, 0 disables moderation.
+ * @{
+ */
+#define XEMACPS_INTMOD_TX_MASK		0x00FF0000U /**< TX moderation time */
+#define XEMACPS_INTMOD_TX_SHIFT		16U
+#define XEMACPS_INTMOD_RX_MASK		0x000000FFU /**< RX moderation time */
+#define XEMACPS_INTMOD_RX_SHIFT		0U
+/*@}*/
+
 /** @name network control register bit definitions
  * @{
  */
@@ -445,10 +505,14 @@ typedef enum { MDC_DIV_8 = 0U, MDC_DIV_16, MDC_DIV_32, MDC_DIV_48,
  */
 #define XEMACPS_INTQ1SR_TXCOMPL_MASK	0x00000080U /**< Transmit completed OK */
 #define XEMACPS_INTQ1SR_TXERR_MASK	0x00000040U /**< Transmit AMBA Error */
+#define XEMACPS_INTQ1SR_RXCOMPL_MASK	0x00000002U /**< Receive completed OK */
 
 #define XEMACPS_INTQ1_IXR_ALL_MASK	((u32)XEMACPS_INTQ1SR_TXCOMPL_MASK | \
 					 (u32)XEMACPS_INTQ1SR_TXERR_MASK)
 
+#define XEMACPS_RXQ_STATUS(Queue)	((u32)1U << (Queue)) /**< Receive queue
+							bit in RxQueueStatus */
+
 /*@}*/
 
 /**
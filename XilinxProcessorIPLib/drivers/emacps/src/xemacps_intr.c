@@ -33,6 +33,8 @@
 * 3.0   kvn  02/13/15 Modified code for MISRA-C:2012 compliance.
 * 3.1   hk   07/27/15 Do not call error handler with '0' error code when
 *                     there is no error. CR# 869403
+* 3.16  jb   10/18/26 Handle the receive queue 1 complete interrupt, record
+*                     the interrupting receive queues in RxQueueStatus.
 * </pre>
 ******************************************************************************/
 
@@ -148,6 +150,8 @@ void XEmacPs_IntrHandler(void *XEmacPsPtr)
 	XEmacPs_WriteReg(InstancePtr->Config.BaseAddress, XEMACPS_ISR_OFFSET,
 			   RegISR);
 
+	InstancePtr->RxQueueStatus = 0U;
+
 	/* Receive complete interrupt */
 	if ((RegISR & XEMACPS_IXR_FRAMERX_MASK) != 0x00000000U) {
 		/* Clear RX status register RX complete indication but preserve
@@ -156,6 +160,21 @@ void XEmacPs_IntrHandler(void *XEmacPsPtr)
 				   XEMACPS_RXSR_OFFSET,
 				   ((u32)XEMACPS_RXSR_FRAMERX_MASK |
 				   (u32)XEMACPS_RXSR_BUFFNA_MASK));
+		InstancePtr->RxQueueStatus |= XEMACPS_RXQ_STATUS(0U);
+	}
+
+	/* Receive Q1 complete interrupt */
+	if ((InstancePtr->Version > 2) &&
+			((RegQ1ISR & XEMACPS_INTQ1SR_RXCOMPL_MASK) != 0x00000000U)) {
+		XEmacPs_WriteReg(InstancePtr->Config.BaseAddress,
+				   XEMACPS_INTQ1_STS_OFFSET,
+				   XEMACPS_INTQ1SR_RXCOMPL_MASK);
+		InstancePtr->RxQueueStatus |= XEMACPS_RXQ_STATUS(1U);
+	}
+
+	/* The receive handler services every queue, RxQueueStatus tells it
+	 * which of them interrupted */
+	if (InstancePtr->RxQueueStatus != 0x00000000U) {
 		InstancePtr->RecvHandler(InstancePtr->RecvRef);
 	}
 
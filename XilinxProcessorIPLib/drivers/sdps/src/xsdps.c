@@ -86,6 +86,7 @@
 * 3.14  sk     10/22/21 Add support for Erase feature.
 *       mn     11/28/21 Fix MISRA-C violations.
 *       sk     01/10/22 Add support to read slot_type parameter.
+* 3.15  jb     10/18/26 Initialize the interrupt mode transfer state.
 *
 * </pre>
 *
@@ -171,6 +172,14 @@ s32 XSdPs_CfgInitialize(XSdPs *InstancePtr, XSdPs_Config *ConfigPtr,
 	InstancePtr->SlcrBaseAddr = XPS_SYS_CTRL_BASEADDR;
 	InstancePtr->IsBusy = FALSE;
 	InstancePtr->BlkSize = 0U;
+	InstancePtr->Cmd23Supported = 0U;
+	InstancePtr->XferBuff = NULL;
+	InstancePtr->XferLen = 0U;
+	InstancePtr->XferArg = 0U;
+	InstancePtr->XferMode = 0U;
+	InstancePtr->Cmd23Pending = 0U;
+	InstancePtr->Handler = NULL;
+	InstancePtr->CallBackRef = NULL;
 
 	/* Host Controller version is read. */
 	InstancePtr->HC_Version =
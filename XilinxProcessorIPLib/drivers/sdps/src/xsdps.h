@@ -152,6 +152,8 @@
 * 3.14  sk     10/22/21 Add support for Erase feature.
 *       sk     11/29/21 Fix compilation warnings reported with "-Wundef" flag.
 *       sk     01/10/22 Add support to read slot_type parameter.
+* 3.15  jb     10/18/26 Add interrupt mode transfers with completion callback
+*                       and CMD23 pre-defined multi-block writes.
 *
 * </pre>
 *
@@ -226,8 +228,25 @@ extern "C" {
 
 /** @} */
 
+/** @name Interrupt mode events
+ *
+ * Events passed to the callback of an interrupt mode transfer.
+ * @{
+ */
+
+#define XSDPS_EVENT_XFER_DONE	1U	/**< Transfer completed */
+#define XSDPS_EVENT_XFER_ERROR	2U	/**< Transfer failed */
+
+/** @} */
+
 /**************************** Type Definitions *******************************/
 
+/**
+ * Callback invoked from XSdPs_IntrHandler() when an interrupt mode transfer
+ * completes. StatusEvent is XSDPS_EVENT_XFER_DONE or XSDPS_EVENT_XFER_ERROR.
+ */
+typedef void (*XSdPs_Handler) (void *CallBackRef, u32 StatusEvent);
+
 /**
  * This typedef contains configuration information for the device.
  */
@@ -305,6 +324,15 @@ typedef struct {
 	u32 SlcrBaseAddr;	/**< SLCR base address*/
 	u8  IsBusy;			/**< Busy Flag*/
 	u32 BlkSize;		/**< Block Size*/
+	u8  Cmd23Supported;	/**< Card supports CMD23 (SET_BLOCK_COUNT) */
+	u8  IsReadXfer;		/**< Interrupt mode transfer is a read */
+	u8  *XferBuff;		/**< Buffer of the interrupt mode transfer */
+	u32 XferLen;		/**< Length of the interrupt mode transfer */
+	u32 XferArg;		/**< Address of the write that follows CMD23 */
+	u16 XferMode;		/**< Transfer Mode of the write that follows CMD23 */
+	u8  Cmd23Pending;	/**< Interrupt mode write waits for CMD23 */
+	XSdPs_Handler Handler;	/**< Interrupt mode completion callback */
+	void *CallBackRef;	/**< Argument of the completion callback */
 } XSdPs;
 
 /***************** Macros (Inline Functions) Definitions *********************/
@@ -349,6 +377,9 @@ s32 XSdPs_CheckReadTransfer(XSdPs *InstancePtr);
 s32 XSdPs_StartWriteTransfer(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff);
 s32 XSdPs_CheckWriteTransfer(XSdPs *InstancePtr);
 s32 XSdPs_Erase(XSdPs *InstancePtr, u32 StartAddr, u32 EndAddr);
+void XSdPs_SetCallback(XSdPs *InstancePtr, XSdPs_Handler FuncPtr,
+		void *CallBackRef);
+void XSdPs_IntrHandler(void *InstancePtr);
 
 #ifdef __cplusplus
 }
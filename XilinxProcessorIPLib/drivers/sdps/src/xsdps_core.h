@@ -24,6 +24,7 @@
 * 3.12  sk     01/28/21 Added support for non-blocking write.
 * 3.14  sk     10/22/21 Add support for Erase feature.
 *       mn     11/28/21 Fix MISRA-C violations.
+* 3.15  jb     10/18/26 Add interrupt mode transfer functions.
 *
 * </pre>
 *
@@ -50,6 +51,8 @@ s32 XSdPs_SetupTransfer(XSdPs *InstancePtr);
 s32 XSdPs_Read(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff);
 s32 XSdPs_Write(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, const u8 *Buff);
 s32 XSdPs_CheckTransferComplete(XSdPs *InstancePtr);
+s32 XSdPs_ReadIntr(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff);
+s32 XSdPs_WriteIntr(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, const u8 *Buff);
 void XSdPs_Identify_UhsMode(XSdPs *InstancePtr, u8 *ReadBuff);
 s32 XSdPs_DllReset(XSdPs *InstancePtr);
 s32 XSdPs_Switch_Voltage(XSdPs *InstancePtr);
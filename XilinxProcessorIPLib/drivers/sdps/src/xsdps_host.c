@@ -30,6 +30,8 @@
 * 3.14  sk     10/22/21 Add support for Erase feature.
 *       mn     11/28/21 Fix MISRA-C violations.
 *       sk     01/10/22 Add support to read slot_type parameter.
+* 3.15  jb     10/18/26 Record CMD23 support of the card and frame CMD23 as a
+*                       command without data.
 *
 * </pre>
 *
@@ -225,6 +227,11 @@ s32 XSdPs_SdModeInit(XSdPs *InstancePtr)
 		goto RETURN_PATH;
 	}
 
+	/* CMD_SUPPORT field of the SCR */
+	if ((SCR[3] & XSDPS_SCR_CMD23_SUPP) != 0U) {
+		InstancePtr->Cmd23Supported = 1U;
+	}
+
 	if ((SCR[1] & WIDTH_4_BIT_SUPPORT) != 0U) {
 		InstancePtr->BusWidth = XSDPS_4_BIT_WIDTH;
 		Status = XSdPs_Change_BusWidth(InstancePtr);
@@ -396,6 +403,9 @@ s32 XSdPs_EmmcModeInit(XSdPs *InstancePtr)
 	static u8 ExtCsd[512] __attribute__ ((aligned(32)));
 #endif
 
+	/* CMD23 is mandatory for eMMC */
+	InstancePtr->Cmd23Supported = 1U;
+
 	if ((InstancePtr->HC_Version == XSDPS_HC_SPEC_V3) &&
 			(InstancePtr->Config.BusWidth == XSDPS_WIDTH_8)) {
 		/* in case of eMMC data width 8-bit */
@@ -1690,6 +1700,8 @@ u32 XSdPs_FrameCmd(XSdPs *InstancePtr, u32 Cmd)
 		break;
 	case CMD23:
 	case ACMD23:
+		RetVal |= RESP_R1;
+		break;
 	case CMD24:
 	case CMD25:
 		RetVal |= RESP_R1 | (u32)XSDPS_DAT_PRESENT_SEL_MASK;
@@ -0,0 +1,339 @@
+/******************************************************************************
+* Copyright (C) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xsdps_intr.c
+* @addtogroup Overview
+* @{
+*
+* Contains the interrupt mode transfer functions of the XSdPs driver.
+* Once a callback is registered with XSdPs_SetCallback(),
+* XSdPs_StartReadTransfer() and XSdPs_StartWriteTransfer() return as soon
+* as the command is issued. The controller interrupts drive the transfer:
+* XSdPs_IntrHandler() sends the data command after a CMD23 and checks for
+* the transfer complete with XSdPs_CheckTransferComplete() before invoking
+* the callback. No command is polled from the interrupt handler.
+* See xsdps.h for a detailed description of the device and driver.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ---    -------- -----------------------------------------------
+* 3.15  jb     10/18/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#include "xsdps_core.h"
+
+/************************** Constant Definitions *****************************/
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+static void XSdPs_DisableXferIntr(XSdPs *InstancePtr);
+static s32 XSdPs_IssueCmd(XSdPs *InstancePtr, u32 Cmd, u32 Arg, u32 BlkCnt,
+		u16 IntrMask);
+
+/*****************************************************************************/
+/**
+* @brief
+* This function disables all the interrupt signals.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+*
+* @return	None
+*
+******************************************************************************/
+static void XSdPs_DisableXferIntr(XSdPs *InstancePtr)
+{
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_NORM_INTR_SIG_EN_OFFSET, 0x0U);
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_ERR_INTR_SIG_EN_OFFSET, 0x0U);
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function issues a command without waiting for its response. The
+* error interrupt signals and the normal interrupt signals in IntrMask are
+* enabled before the command is sent, the interrupt status register bits
+* are already enabled by XSdPs_ConfigInterrupt().
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	Cmd is the command to be sent.
+* @param	Arg is the argument to be sent along with the command.
+* @param	BlkCnt - Block count passed by the user.
+* @param	IntrMask is the mask of the normal interrupts that end this
+* 		step of the transfer.
+*
+* @return
+* 		- XST_SUCCESS if the command was issued
+* 		- XST_FAILURE if failure - could be because command or data
+* 		inhibit is set
+*
+******************************************************************************/
+static s32 XSdPs_IssueCmd(XSdPs *InstancePtr, u32 Cmd, u32 Arg, u32 BlkCnt,
+		u16 IntrMask)
+{
+	s32 Status;
+
+	/* Clears the interrupt status of the previous command */
+	Status = XSdPs_SetupCmd(InstancePtr, Arg, BlkCnt);
+	if (Status != XST_SUCCESS) {
+		Status = XST_FAILURE;
+		goto RETURN_PATH;
+	}
+
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_ERR_INTR_SIG_EN_OFFSET,
+			(u16)XSDPS_ERROR_INTR_ALL_MASK);
+	XSdPs_WriteReg16(InstancePtr->Config.BaseAddress,
+			XSDPS_NORM_INTR_SIG_EN_OFFSET, IntrMask);
+
+	Status = XSdPs_SendCmd(InstancePtr, Cmd);
+	if (Status != XST_SUCCESS) {
+		XSdPs_DisableXferIntr(InstancePtr);
+		Status = XST_FAILURE;
+	}
+
+RETURN_PATH:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function sets the callback invoked when an interrupt mode transfer
+* completes. With a callback set, XSdPs_StartReadTransfer() and
+* XSdPs_StartWriteTransfer() run in interrupt mode and the transfer is
+* completed by XSdPs_IntrHandler() instead of XSdPs_CheckReadTransfer() or
+* XSdPs_CheckWriteTransfer(). Passing NULL returns to the polled mode.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	FuncPtr is the callback, it is called from XSdPs_IntrHandler().
+* @param	CallBackRef is the argument passed back to the callback.
+*
+* @return	None
+*
+* @note		The callback must not be changed while a transfer is busy.
+*
+******************************************************************************/
+void XSdPs_SetCallback(XSdPs *InstancePtr, XSdPs_Handler FuncPtr,
+		void *CallBackRef)
+{
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(InstancePtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	InstancePtr->Handler = FuncPtr;
+	InstancePtr->CallBackRef = CallBackRef;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function starts an SD read in interrupt mode. It is called by
+* XSdPs_StartReadTransfer() after the transfer is set up.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	Arg is the address passed by the user that is to be sent as
+* 		argument along with the command.
+* @param	BlkCnt - Block count passed by the user.
+* @param	Buff - Pointer to the data buffer for a DMA transfer.
+*
+* @return
+* 		- XST_SUCCESS if the transfer was started
+* 		- XST_FAILURE if failure - could be because command or data
+* 		inhibit is set
+*
+******************************************************************************/
+s32 XSdPs_ReadIntr(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff)
+{
+	s32 Status;
+	u32 Cmd;
+
+	InstancePtr->IsReadXfer = 1U;
+	InstancePtr->Cmd23Pending = 0U;
+	InstancePtr->XferBuff = Buff;
+	InstancePtr->XferLen = BlkCnt * InstancePtr->BlkSize;
+
+	XSdPs_SetupReadDma(InstancePtr, (u16)BlkCnt, (u16)InstancePtr->BlkSize,
+			Buff);
+
+	if (BlkCnt == 1U) {
+		Cmd = CMD17;
+	} else {
+		Cmd = CMD18;
+	}
+
+	/* The interrupt may complete the transfer before this returns */
+	InstancePtr->IsBusy = TRUE;
+	Status = XSdPs_IssueCmd(InstancePtr, Cmd, Arg, BlkCnt,
+			(u16)XSDPS_INTR_TC_MASK);
+	if (Status != XST_SUCCESS) {
+		InstancePtr->IsBusy = FALSE;
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function starts an SD write in interrupt mode. It is called by
+* XSdPs_StartWriteTransfer() after the transfer is set up. Multiple block
+* writes are preceded by CMD23 when the card supports it, instead of being
+* stopped by an auto CMD12. Only CMD23 is issued here, XSdPs_IntrHandler()
+* issues CMD25 on its command complete interrupt.
+*
+* @param	InstancePtr is a pointer to the instance to be worked on.
+* @param	Arg is the address passed by the user that is to be sent as
+* 		argument along with the command.
+* @param	BlkCnt - Block count passed by the user.
+* @param	Buff - Pointer to the data buffer for a DMA transfer.
+*
+* @return
+* 		- XST_SUCCESS if the transfer was started
+* 		- XST_FAILURE if failure - could be because command or data
+* 		inhibit is set
+*
+******************************************************************************/
+s32 XSdPs_WriteIntr(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, const u8 *Buff)
+{
+	s32 Status;
+
+	InstancePtr->IsReadXfer = 0U;
+	InstancePtr->Cmd23Pending = 0U;
+	InstancePtr->XferBuff = NULL;
+	InstancePtr->XferLen = BlkCnt * InstancePtr->BlkSize;
+
+	XSdPs_SetupWriteDma(InstancePtr, (u16)BlkCnt, (u16)InstancePtr->BlkSize,
+			Buff);
+
+	/* The interrupt may complete the transfer before this returns */
+	InstancePtr->IsBusy = TRUE;
+	if ((BlkCnt > 1U) && (InstancePtr->Cmd23Supported != 0U)) {
+		/* Kept for the CMD25 issued by XSdPs_IntrHandler() */
+		InstancePtr->XferMode = InstancePtr->TransferMode &
+				(u16)~XSDPS_TM_AUTO_CMD12_EN_MASK;
+		InstancePtr->XferArg = Arg;
+		InstancePtr->Cmd23Pending = 1U;
+
+		/* CMD23 has no data phase */
+		InstancePtr->TransferMode = 0U;
+		Status = XSdPs_IssueCmd(InstancePtr, CMD23, BlkCnt, 0U,
+				(u16)XSDPS_INTR_CC_MASK);
+	} else if (BlkCnt == 1U) {
+		Status = XSdPs_IssueCmd(InstancePtr, CMD24, Arg, BlkCnt,
+				(u16)XSDPS_INTR_TC_MASK);
+	} else {
+		Status = XSdPs_IssueCmd(InstancePtr, CMD25, Arg, BlkCnt,
+				(u16)XSDPS_INTR_TC_MASK);
+	}
+	if (Status != XST_SUCCESS) {
+		InstancePtr->Cmd23Pending = 0U;
+		InstancePtr->IsBusy = FALSE;
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* @brief
+* This function is the interrupt handler of the SD controller. It advances
+* the interrupt mode transfer in progress and invokes the callback when it
+* completes. A failed transfer resets the CMD and DAT lines so that the
+* next command can be issued. It can also be called from task context to
+* poll for completion when the interrupt is not connected, it does nothing
+* while the transfer is busy.
+*
+* @param	InstancePtr is a pointer to the XSdPs instance.
+*
+* @return	None
+*
+******************************************************************************/
+void XSdPs_IntrHandler(void *InstancePtr)
+{
+	XSdPs *SdPsPtr = (XSdPs *)InstancePtr;
+	u16 StatusReg;
+	u32 Event;
+	s32 Status;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+
+	if (SdPsPtr->IsBusy == FALSE) {
+		goto RETURN_PATH;
+	}
+
+	if (SdPsPtr->Cmd23Pending != 0U) {
+		StatusReg = XSdPs_ReadReg16(SdPsPtr->Config.BaseAddress,
+					XSDPS_NORM_INTR_STS_OFFSET);
+		if ((StatusReg & XSDPS_INTR_ERR_MASK) != 0U) {
+			Status = XST_FAILURE;
+			goto XFER_DONE;
+		}
+		if ((StatusReg & XSDPS_INTR_CC_MASK) == 0U) {
+			goto RETURN_PATH;
+		}
+
+		/* CMD23 accepted, send the pre-defined multiple blocks write */
+		SdPsPtr->Cmd23Pending = 0U;
+		SdPsPtr->TransferMode = SdPsPtr->XferMode;
+		Status = XSdPs_IssueCmd(SdPsPtr, CMD25, SdPsPtr->XferArg,
+				SdPsPtr->XferLen / SdPsPtr->BlkSize,
+				(u16)XSDPS_INTR_TC_MASK);
+		if (Status == XST_SUCCESS) {
+			goto RETURN_PATH;
+		}
+		goto XFER_DONE;
+	}
+
+	Status = XSdPs_CheckTransferComplete(SdPsPtr);
+	if (Status == XST_DEVICE_BUSY) {
+		goto RETURN_PATH;
+	}
+
+XFER_DONE:
+	XSdPs_DisableXferIntr(SdPsPtr);
+
+	if (Status != XST_SUCCESS) {
+		/* Write to clear error bits */
+		XSdPs_WriteReg16(SdPsPtr->Config.BaseAddress,
+				XSDPS_ERR_INTR_STS_OFFSET,
+				XSDPS_ERROR_INTR_ALL_MASK);
+		/* Abort the command and the data transfer in progress */
+		(void)XSdPs_Reset(SdPsPtr, (u8)(XSDPS_SWRST_CMD_LINE_MASK |
+				XSDPS_SWRST_DAT_LINE_MASK));
+		Event = XSDPS_EVENT_XFER_ERROR;
+	} else {
+		if ((SdPsPtr->IsReadXfer != 0U) &&
+				(SdPsPtr->Config.IsCacheCoherent == 0U)) {
+			Xil_DCacheInvalidateRange((INTPTR)SdPsPtr->XferBuff,
+					(INTPTR)SdPsPtr->XferLen);
+		}
+		Event = XSDPS_EVENT_XFER_DONE;
+	}
+
+	SdPsPtr->Cmd23Pending = 0U;
+	SdPsPtr->IsBusy = FALSE;
+
+	if (SdPsPtr->Handler != NULL) {
+		SdPsPtr->Handler(SdPsPtr->CallBackRef, Event);
+	}
+
+RETURN_PATH:
+	return;
+}
+
+/** @} */
@@ -61,6 +61,7 @@
 * 3.10  mn     06/05/20 Modified code for SD Non-Blocking Read support
 * 3.12  sk     01/28/21 Added support for non-blocking write.
 * 3.14  mn     11/28/21 Fix MISRA-C violations.
+* 3.15  jb     10/18/26 Start interrupt mode transfers when a callback is set.
 *
 * </pre>
 *
@@ -721,6 +722,10 @@ s32 XSdPs_Select_Card (XSdPs *InstancePtr)
 * 		- XST_FAILURE if failure - could be because another transfer
 * 		is in progress or command or data inhibit is set
 *
+* @note		When a callback is set with XSdPs_SetCallback(), the transfer
+* 		completes in XSdPs_IntrHandler() which invokes the callback.
+* 		XSdPs_CheckReadTransfer() must not be used in that case.
+*
 ******************************************************************************/
 s32 XSdPs_StartReadTransfer(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff)
 {
@@ -741,6 +746,12 @@ s32 XSdPs_StartReadTransfer(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff)
 		goto RETURN_PATH;
 	}
 
+	if (InstancePtr->Handler != NULL) {
+		/* Completed by XSdPs_IntrHandler() */
+		Status = XSdPs_ReadIntr(InstancePtr, Arg, BlkCnt, Buff);
+		goto RETURN_PATH;
+	}
+
 	/* Read from the card */
 	Status = XSdPs_Read(InstancePtr, Arg, BlkCnt, Buff);
 	if (Status != XST_SUCCESS) {
@@ -769,6 +780,10 @@ RETURN_PATH:
 * 		- XST_FAILURE if failure - could be because another transfer
 * 		is in progress or command or data inhibit is set
 *
+* @note		When a callback is set with XSdPs_SetCallback(), the transfer
+* 		completes in XSdPs_IntrHandler() which invokes the callback.
+* 		XSdPs_CheckWriteTransfer() must not be used in that case.
+*
 ******************************************************************************/
 s32 XSdPs_StartWriteTransfer(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff)
 {
@@ -789,6 +804,12 @@ s32 XSdPs_StartWriteTransfer(XSdPs *InstancePtr, u32 Arg, u32 BlkCnt, u8 *Buff)
 		goto RETURN_PATH;
 	}
 
+	if (InstancePtr->Handler != NULL) {
+		/* Completed by XSdPs_IntrHandler() */
+		Status = XSdPs_WriteIntr(InstancePtr, Arg, BlkCnt, Buff);
+		goto RETURN_PATH;
+	}
+
 	/* write to the card */
 	Status = XSdPs_Write(InstancePtr, Arg, BlkCnt, Buff);
 	if (Status != XST_SUCCESS) {
@@ -98,6 +98,9 @@
 * 4.10  vv    02/05/19   Added new pixel formats with 12 and 16 bpc.
 * 4.50  kp    13/07/21   Added new 3 planar video format Y_U_V8
 * 4.60  kp    12/03/21   Added new 3 planar video format Y_U_V10
+* 4.60  jb    10/18/26   Added XVFrmbufRd_SetFrame for the frames of the video
+*                        common buffer pool. Added
+*                        XVFrmbufRd_PipeSetFrame as its pipeline port.
 * </pre>
 *
 ******************************************************************************/
@@ -109,6 +112,7 @@ extern "C" {
 #endif
 
 #include "xvidc.h"
+#include "xvidc_bufpool.h"
 #include "xv_frmbufrd.h"
 
 /************************** Constant Definitions *****************************/
@@ -672,6 +676,9 @@ UINTPTR XVFrmbufRd_GetChromaBufferAddr(XV_FrmbufRd_l2 *InstancePtr);
 int XVFrmbufRd_SetVChromaBufferAddr(XV_FrmbufRd_l2 *InstancePtr,
                               UINTPTR Addr);
 UINTPTR XVFrmbufRd_GetVChromaBufferAddr(XV_FrmbufRd_l2 *InstancePtr);
+int XVFrmbufRd_SetFrame(XV_FrmbufRd_l2 *InstancePtr,
+                        const XVidC_Frame *FramePtr);
+void XVFrmbufRd_PipeSetFrame(void *CallbackRef, const XVidC_Frame *FramePtr);
 int XVFrmbufRd_SetFieldID(XV_FrmbufRd_l2 *InstancePtr,
                           u32 FieldID);
 u32 XVFrmbufRd_GetFieldID(XV_FrmbufRd_l2 *InstancePtr);
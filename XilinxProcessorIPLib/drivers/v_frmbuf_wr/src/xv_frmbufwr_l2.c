@@ -34,6 +34,9 @@
 * 4.10  vv    02/05/19   Added new pixel formats with 12 and 16 bpc.
 * 4.50  kp    12/07/21   Added new 3 planar video format Y_U_V8.
 * 4.60  kp    10/27/21   Added new 3 planar video format Y_U_V10.
+* 4.60  jb    10/18/26   Added XVFrmbufWr_SetFrame for the frames of the video
+*                        common buffer pool. Added
+*                        XVFrmbufWr_PipeSetFrame as its pipeline port.
 * </pre>
 *
 ******************************************************************************/
@@ -736,6 +739,59 @@ UINTPTR XVFrmbufWr_GetVChromaBufferAddr(XV_FrmbufWr_l2 *InstancePtr)
   return(ReadVal);
 }
 
+/*****************************************************************************/
+/**
+* This function sets the buffer addresses of all the planes of a frame of the
+* video common buffer pool, see xvidc_bufpool.h
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  FramePtr is a pointer to the frame
+*
+* @return XST_SUCCESS or the error of the first plane address rejected
+*
+******************************************************************************/
+int XVFrmbufWr_SetFrame(XV_FrmbufWr_l2 *InstancePtr,
+                        const XVidC_Frame *FramePtr)
+{
+  int Status;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(FramePtr != NULL);
+
+  Status = XVFrmbufWr_SetBufferAddr(InstancePtr, FramePtr->LumaAddr);
+  if ((Status == XST_SUCCESS) && (FramePtr->ChromaAddr != 0)) {
+    Status = XVFrmbufWr_SetChromaBufferAddr(InstancePtr,
+          FramePtr->ChromaAddr);
+  }
+  if ((Status == XST_SUCCESS) && (FramePtr->VChromaAddr != 0)) {
+    Status = XVFrmbufWr_SetVChromaBufferAddr(InstancePtr,
+          FramePtr->VChromaAddr);
+  }
+
+  return(Status);
+}
+
+/*****************************************************************************/
+/**
+* This function is the port callback of a video common buffer pool pipeline,
+* see XVidC_PipeSetPort. It programs the frame with XVFrmbufWr_SetFrame.
+*
+* @param  CallbackRef is a pointer to the XV_FrmbufWr_l2 instance
+* @param  FramePtr is a pointer to the frame
+*
+* @return None
+*
+******************************************************************************/
+void XVFrmbufWr_PipeSetFrame(void *CallbackRef, const XVidC_Frame *FramePtr)
+{
+  XV_FrmbufWr_l2 *InstancePtr = (XV_FrmbufWr_l2 *)CallbackRef;
+
+  Xil_AssertVoid(InstancePtr != NULL);
+  Xil_AssertVoid(FramePtr != NULL);
+
+  (void)XVFrmbufWr_SetFrame(InstancePtr, FramePtr);
+}
+
 /*****************************************************************************/
 /**
 * This function reads the field ID
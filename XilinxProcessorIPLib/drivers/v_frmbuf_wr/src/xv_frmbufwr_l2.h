@@ -98,6 +98,9 @@
 * 4.10  vv    02/05/19   Added new pixel formats with 12 and 16 bpc.
 * 4.50  kp    12/07/21   Added new 3 planar video format Y_U_V8.
 * 4.60  kp    10/27/21   Added new 3 planar video format Y_U_V10.
+* 4.60  jb    10/18/26   Added XVFrmbufWr_SetFrame for the frames of the video
+*                        common buffer pool. Added
+*                        XVFrmbufWr_PipeSetFrame as its pipeline port.
 * </pre>
 *
 ******************************************************************************/
@@ -109,6 +112,7 @@ extern "C" {
 #endif
 
 #include "xvidc.h"
+#include "xvidc_bufpool.h"
 #include "xv_frmbufwr.h"
 
 /************************** Constant Definitions *****************************/
@@ -627,6 +631,9 @@ UINTPTR XVFrmbufWr_GetChromaBufferAddr(XV_FrmbufWr_l2 *InstancePtr);
 int XVFrmbufWr_SetVChromaBufferAddr(XV_FrmbufWr_l2 *InstancePtr,
                               UINTPTR Addr);
 UINTPTR XVFrmbufWr_GetVChromaBufferAddr(XV_FrmbufWr_l2 *InstancePtr);
+int XVFrmbufWr_SetFrame(XV_FrmbufWr_l2 *InstancePtr,
+                        const XVidC_Frame *FramePtr);
+void XVFrmbufWr_PipeSetFrame(void *CallbackRef, const XVidC_Frame *FramePtr);
 u32 XVFrmbufWr_GetFieldID(XV_FrmbufWr_l2 *InstancePtr);
 void XVFrmbufWr_DbgReportStatus(XV_FrmbufWr_l2 *InstancePtr);
 
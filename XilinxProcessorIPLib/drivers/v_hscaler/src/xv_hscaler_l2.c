@@ -30,6 +30,8 @@
 *       rco   02/09/17   Fix c++ compilation warnings
 *	jsr   09/07/18 Fix for 64-bit driver support
 * 3.3   vsa   04/07/20   Improve quality with better coefficient tables
+* 3.4   jb    10/18/26   Added the plan cache of the phase and coefficient
+*                        banks
 * </pre>
 *
 ******************************************************************************/
@@ -49,6 +51,14 @@
 
 /**************************** Type Definitions *******************************/
 
+/************************** Macros Definitions *******************************/
+/* Writes a word of the phase bank, or stores it in the words of a plan */
+#define XHSC_PUT_PHASE(Words, BaseAddr, Offset, Val) \
+  do { \
+    if(Words) (Words)[(Offset)] = (Val); \
+    else Xil_Out32((BaseAddr)+((Offset)*4), (Val)); \
+  } while(0)
+
 /**************************** Local Global *******************************/
 static const int STEP_PRECISION_SHIFT = 16;
 static const u64 XHSC_MASK_LOW_32BITS = ((u64)1<<32)-1;
@@ -66,6 +76,10 @@ extern const short XV_hscaler_fixedcoeff_taps10_ScalingRatio4[XV_HSCALER_MAX_H_P
 extern const short XV_hscaler_fixedcoeff_taps12_ScalingRatio4[XV_HSCALER_MAX_H_PHASES][XV_HSCALER_TAPS_12];
 
 /************************** Function Prototypes ******************************/
+static const short *XV_HScalerGetCoeff(XV_Hscaler_l2 *InstancePtr,
+                                       u32 WidthIn,
+                                       u32 WidthOut,
+                                       u16 *NumTapsPtr);
 static void XV_HScalerSelectCoeff(XV_Hscaler_l2 *InstancePtr,
                                   u32 WidthIn,
                                   u32 WidthOut);
@@ -75,7 +89,13 @@ static void CalculatePhases(XV_Hscaler_l2 *HscPtr,
                             u32 PixelRate);
 
 static void XV_HScalerSetCoeff(XV_Hscaler_l2 *HscPtr);
-static void XV_HScalerSetPhase(XV_Hscaler_l2 *HscPtr);
+static void XV_HScalerSetPhase(XV_Hscaler_l2 *HscPtr, u32 *Words);
+static u32 XV_HScalerNumPhaseWords(XV_Hscaler_l2 *HscPtr);
+static XV_HScalerPlan *XV_HScalerGetPlan(XV_Hscaler_l2 *InstancePtr,
+                                         u32 WidthIn,
+                                         u32 WidthOut);
+static void XV_HScalerSetupBanks(XV_Hscaler_l2 *InstancePtr,
+                                 XV_HScalerPlan *PlanPtr);
 
 /*****************************************************************************/
 /**
@@ -136,32 +156,26 @@ void XV_HScalerStop(XV_Hscaler_l2 *InstancePtr)
 /*****************************************************************************/
 /**
 * This function determines the internal coeffiecient table to be used based on
-* scaling ratio and loads the filter coefficients in the scaler coefficient
-* storage.
+* scaling ratio
 *
 * @param  InstancePtr is a pointer to the core instance to be worked on.
 * @param  WidthIn is the input stream width
 * @param  Widthout is the output stream width
+* @param  NumTapsPtr is the number of taps of the table, set on return
 *
-* @return None
+* @return The coefficient table, NULL if the taps of the core are not supported
 *
 ******************************************************************************/
-static void XV_HScalerSelectCoeff(XV_Hscaler_l2 *InstancePtr,
-                                  u32 WidthIn,
-                                  u32 WidthOut)
+static const short *XV_HScalerGetCoeff(XV_Hscaler_l2 *InstancePtr,
+                                       u32 WidthIn,
+                                       u32 WidthOut,
+                                       u16 *NumTapsPtr)
 {
   const short *coeff;
-  u16 numTaps, numPhases;
+  u16 numTaps;
   u16 ScalingRatio;
   u16 IsScaleDown;
 
-  /*
-   * validate input arguments
-   */
-  Xil_AssertVoid(InstancePtr != NULL);
-
-  numPhases = (1<<InstancePtr->Hsc.Config.PhaseShift);
-
   IsScaleDown = (WidthOut < WidthIn);
 
   /* Scale Down Mode will use dynamic filter selection logic
@@ -238,7 +252,7 @@ static void XV_HScalerSelectCoeff(XV_Hscaler_l2 *InstancePtr,
            break;
 
       default:
-          return;
+          return NULL;
     }
   }
   else //Scale Up
@@ -247,6 +261,43 @@ static void XV_HScalerSelectCoeff(XV_Hscaler_l2 *InstancePtr,
 	numTaps = XV_HSCALER_TAPS_6;
   }
 
+  *NumTapsPtr = numTaps;
+  return coeff;
+}
+
+/*****************************************************************************/
+/**
+* This function determines the internal coeffiecient table to be used based on
+* scaling ratio and loads the filter coefficients in the scaler coefficient
+* storage.
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+* @param  WidthIn is the input stream width
+* @param  Widthout is the output stream width
+*
+* @return None
+*
+******************************************************************************/
+static void XV_HScalerSelectCoeff(XV_Hscaler_l2 *InstancePtr,
+                                  u32 WidthIn,
+                                  u32 WidthOut)
+{
+  const short *coeff;
+  u16 numTaps, numPhases;
+
+  /*
+   * validate input arguments
+   */
+  Xil_AssertVoid(InstancePtr != NULL);
+
+  numPhases = (1<<InstancePtr->Hsc.Config.PhaseShift);
+
+  coeff = XV_HScalerGetCoeff(InstancePtr, WidthIn, WidthOut, &numTaps);
+  if(coeff == NULL)
+  {
+    return;
+  }
+
   XV_HScalerLoadExtCoeff(InstancePtr,
                          numPhases,
                          numTaps,
@@ -296,6 +347,9 @@ void XV_HScalerLoadExtCoeff(XV_Hscaler_l2 *InstancePtr,
          return;
   }
 
+  /* The coefficient bank no longer matches the coefficient storage */
+  InstancePtr->CoeffBank = NULL;
+
   //determine if coefficient needs padding (effective vs. max taps)
   pad = XV_HSCALER_MAX_H_TAPS - num_taps;
   offset = ((pad) ? (pad>>1) : 0);
@@ -432,6 +486,8 @@ static void CalculatePhases(XV_Hscaler_l2 *HscPtr,
 * This function programs the phase data into core registers
 *
 * @param  HscPtr is a pointer to the core instance to be worked on.
+* @param  Words is the array that receives the register words instead of the
+*         core, NULL to program the core
 *
 * @return None
 *
@@ -439,7 +495,7 @@ static void CalculatePhases(XV_Hscaler_l2 *HscPtr,
 *        User must load the coefficients, using the provided API, before
 *        scaler can be used
 ******************************************************************************/
-static void XV_HScalerSetPhase(XV_Hscaler_l2 *HscPtr)
+static void XV_HScalerSetPhase(XV_Hscaler_l2 *HscPtr, u32 *Words)
 {
   u32 loopWidth;
   UINTPTR baseAddr;
@@ -463,7 +519,7 @@ static void XV_HScalerSetPhase(XV_Hscaler_l2 *HscPtr)
                 lsb = (u32)(HscPtr->phasesH[i]   & (u64)XHSC_MASK_LOW_16BITS);
                 msb = (u32)(HscPtr->phasesH[i+1] & (u64)XHSC_MASK_LOW_16BITS);
                 val = (msb<<16 | lsb);
-                Xil_Out32(baseAddr+(index*4), val);
+                XHSC_PUT_PHASE(Words, baseAddr, index, val);
                 ++index;
               }
             }
@@ -479,7 +535,7 @@ static void XV_HScalerSetPhase(XV_Hscaler_l2 *HscPtr)
               for(i=0; i < loopWidth; ++i)
               {
                 val = (u32)(HscPtr->phasesH[i] & XHSC_MASK_LOW_32BITS);
-                Xil_Out32(baseAddr+(i*4), val);
+                XHSC_PUT_PHASE(Words, baseAddr, i, val);
               }
             }
             break;
@@ -500,8 +556,8 @@ static void XV_HScalerSetPhase(XV_Hscaler_l2 *HscPtr)
                 phaseHData = HscPtr->phasesH[index];
                 lsb = (u32)(phaseHData & XHSC_MASK_LOW_32BITS);
                 msb = (u32)((phaseHData>>32) & XHSC_MASK_LOW_32BITS);
-                Xil_Out32(baseAddr+(offset*4), lsb);
-                Xil_Out32(baseAddr+((offset+1)*4), msb);
+                XHSC_PUT_PHASE(Words, baseAddr, offset, lsb);
+                XHSC_PUT_PHASE(Words, baseAddr, offset+1, msb);
                 ++index;
                 offset += 2;
               }
@@ -533,9 +589,10 @@ static void XV_HScalerSetPhase(XV_Hscaler_l2 *HscPtr)
 			bits_32_63 |= ((u32)((phaseHData_H & XHSC_MASK_LOW_20BITS)) << 12);
 			bits_64_95 = (((u32)(phaseHData_H & XHSC_MASK_LOW_32BITS)) >> 20);
 			bits_64_95 |= (((u32)(phaseHData_H>>32) & XHSC_MASK_LOW_12BITS) << 12);
-			Xil_Out32(baseAddr+(offset*4), bits_0_31);
-			Xil_Out32(baseAddr+((offset+1)*4), bits_32_63);
-			Xil_Out32(baseAddr+((offset+2)*4), bits_64_95);
+			XHSC_PUT_PHASE(Words, baseAddr, offset, bits_0_31);
+			XHSC_PUT_PHASE(Words, baseAddr, offset+1, bits_32_63);
+			XHSC_PUT_PHASE(Words, baseAddr, offset+2, bits_64_95);
+			if(Words) Words[offset+3] = 0;
 			/*(offset+3)*4 register is reserved,so increment offset by 4*/
 			offset += 4;
 			index++;
@@ -549,6 +606,29 @@ static void XV_HScalerSetPhase(XV_Hscaler_l2 *HscPtr)
   }
 }
 
+/*****************************************************************************/
+/**
+* This function returns the number of register words of the phase bank, as
+* programmed by XV_HScalerSetPhase
+*
+* @param  HscPtr is a pointer to the core instance to be worked on.
+*
+* @return Number of 32 bit words, including the reserved ones
+*
+******************************************************************************/
+static u32 XV_HScalerNumPhaseWords(XV_Hscaler_l2 *HscPtr)
+{
+  u32 loopWidth = HscPtr->Hsc.Config.MaxWidth/HscPtr->Hsc.Config.PixPerClk;
+
+  switch(HscPtr->Hsc.Config.PixPerClk)
+  {
+    case XVIDC_PPC_1: return((loopWidth+1)/2);
+    case XVIDC_PPC_2: return(loopWidth);
+    case XVIDC_PPC_4: return(loopWidth*2);
+    case XVIDC_PPC_8: return(loopWidth*4);
+    default:          return(0);
+  }
+}
 
 /*****************************************************************************/
 /**
@@ -625,22 +705,31 @@ int XV_HScalerSetup(XV_Hscaler_l2  *InstancePtr,
 
   PixelRate = (WidthIn * STEP_PRECISION)/WidthOut;
 
-  if(InstancePtr->Hsc.Config.ScalerType == XV_HSCALER_POLYPHASE)
+  if(InstancePtr->Plans)
   {
-    if(!InstancePtr->UseExtCoeff)  //No user defined coefficients
+    /* Program the banks from the plan, if they changed */
+    XV_HScalerSetupBanks(InstancePtr,
+                         XV_HScalerGetPlan(InstancePtr, WidthIn, WidthOut));
+  }
+  else
+  {
+    if(InstancePtr->Hsc.Config.ScalerType == XV_HSCALER_POLYPHASE)
     {
-      /* Determine coefficient table to use */
-      XV_HScalerSelectCoeff(InstancePtr, WidthIn, WidthOut);
+      if(!InstancePtr->UseExtCoeff)  //No user defined coefficients
+      {
+        /* Determine coefficient table to use */
+        XV_HScalerSelectCoeff(InstancePtr, WidthIn, WidthOut);
+      }
+      /* Program generated coefficients into the IP register bank */
+      XV_HScalerSetCoeff(InstancePtr);
     }
-    /* Program generated coefficients into the IP register bank */
-    XV_HScalerSetCoeff(InstancePtr);
-  }
 
-  /* Compute Phase for 1 line */
-  CalculatePhases(InstancePtr, WidthIn, WidthOut, PixelRate);
+    /* Compute Phase for 1 line */
+    CalculatePhases(InstancePtr, WidthIn, WidthOut, PixelRate);
 
-  /* Program computed Phase into the IP register bank */
-  XV_HScalerSetPhase(InstancePtr);
+    /* Program computed Phase into the IP register bank */
+    XV_HScalerSetPhase(InstancePtr, NULL);
+  }
 
   XV_hscaler_Set_HwReg_Height(&InstancePtr->Hsc,        HeightIn);
   XV_hscaler_Set_HwReg_WidthIn(&InstancePtr->Hsc,       WidthIn);
@@ -651,7 +740,208 @@ int XV_HScalerSetup(XV_Hscaler_l2  *InstancePtr,
 
   return XST_SUCCESS;
 }
+/*****************************************************************************/
+/**
+* This function enables the plan cache of the instance, see xv_hscaler_l2.h.
+* Once enabled, the coefficient and phase banks of the core are only written
+* when they change.
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+* @param  Plans is the storage of the plans, NULL to disable the cache
+* @param  NumPlans is the number of plans in the storage
+*
+* @return None
+*
+* @note   The storage must remain valid until the cache is disabled. When the
+*         cache is full, the plans are replaced in turn, so it should hold at
+*         least the plans of the modes switched between.
+*
+******************************************************************************/
+void XV_HScalerSetPlanCache(XV_Hscaler_l2 *InstancePtr,
+                            XV_HScalerPlan *Plans,
+                            u16 NumPlans)
+{
+  u16 i;
+
+  Xil_AssertVoid(InstancePtr != NULL);
+  Xil_AssertVoid((Plans == NULL) || (NumPlans > 0));
+
+  for(i = 0; i < NumPlans; i++)
+  {
+    Plans[i].IsValid = FALSE;
+  }
+  InstancePtr->Plans     = Plans;
+  InstancePtr->NumPlans  = ((Plans) ? NumPlans : 0);
+  InstancePtr->NextPlan  = 0;
+  XV_HScalerInvalidateBanks(InstancePtr);
+}
 
+/*****************************************************************************/
+/**
+* This function computes the plan of a scaling ratio ahead of its use by
+* XV_HScalerSetup
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+* @param  WidthIn is the input stream width
+* @param  WidthOut is the output stream width
+*
+* @return XST_SUCCESS if the plan is in the cache
+*         XST_FAILURE if the plan cache is not enabled
+*
+******************************************************************************/
+int XV_HScalerAddPlan(XV_Hscaler_l2 *InstancePtr,
+                      u32 WidthIn,
+                      u32 WidthOut)
+{
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid((WidthIn>0) && (WidthIn<=InstancePtr->Hsc.Config.MaxWidth));
+  Xil_AssertNonvoid((WidthOut>0) && (WidthOut<=InstancePtr->Hsc.Config.MaxWidth));
+
+  if(!InstancePtr->Plans)
+  {
+    return XST_FAILURE;
+  }
+
+  (void)XV_HScalerGetPlan(InstancePtr, WidthIn, WidthOut);
+
+  return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* This function forgets the content of the coefficient and phase banks of the
+* core, so that the next setup writes them again
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+*
+* @return None
+*
+******************************************************************************/
+void XV_HScalerInvalidateBanks(XV_Hscaler_l2 *InstancePtr)
+{
+  Xil_AssertVoid(InstancePtr != NULL);
+
+  InstancePtr->CoeffBank = NULL;
+  InstancePtr->PhaseBank = NULL;
+}
+
+/*****************************************************************************/
+/**
+* This function looks up the plan of a scaling ratio in the cache, and
+* computes it in place of the oldest plan if not found
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+* @param  WidthIn is the input stream width
+* @param  WidthOut is the output stream width
+*
+* @return The plan
+*
+******************************************************************************/
+static XV_HScalerPlan *XV_HScalerGetPlan(XV_Hscaler_l2 *InstancePtr,
+                                         u32 WidthIn,
+                                         u32 WidthOut)
+{
+  XV_HScalerPlan *PlanPtr;
+  u16 i;
+
+  for(i = 0; i < InstancePtr->NumPlans; i++)
+  {
+    PlanPtr = &InstancePtr->Plans[i];
+    if(PlanPtr->IsValid &&
+       (PlanPtr->WidthIn == WidthIn) && (PlanPtr->WidthOut == WidthOut))
+    {
+      return PlanPtr;
+    }
+  }
+
+  PlanPtr = &InstancePtr->Plans[InstancePtr->NextPlan];
+  InstancePtr->NextPlan = (InstancePtr->NextPlan + 1) % InstancePtr->NumPlans;
+  if(InstancePtr->PhaseBank == PlanPtr)
+  {
+    InstancePtr->PhaseBank = NULL;
+  }
+
+  PlanPtr->WidthIn  = WidthIn;
+  PlanPtr->WidthOut = WidthOut;
+  PlanPtr->NumTaps  = 0;
+  PlanPtr->Coeff    = NULL;
+  if(InstancePtr->Hsc.Config.ScalerType == XV_HSCALER_POLYPHASE)
+  {
+    PlanPtr->Coeff = XV_HScalerGetCoeff(InstancePtr, WidthIn, WidthOut,
+                                        &PlanPtr->NumTaps);
+  }
+
+  /* Compute Phase for 1 line, and keep the register words */
+  CalculatePhases(InstancePtr, WidthIn, WidthOut,
+                  (WidthIn * STEP_PRECISION)/WidthOut);
+  XV_HScalerSetPhase(InstancePtr, PlanPtr->PhaseWords);
+  PlanPtr->IsValid = TRUE;
+
+  return PlanPtr;
+}
+
+/*****************************************************************************/
+/**
+* This function programs the coefficient and phase banks of a plan into the
+* core registers, skipping the banks that are already loaded
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+* @param  PlanPtr is the plan to program
+*
+* @return None
+*
+******************************************************************************/
+static void XV_HScalerSetupBanks(XV_Hscaler_l2 *InstancePtr,
+                                 XV_HScalerPlan *PlanPtr)
+{
+  const short *coeff;
+  UINTPTR baseAddr;
+  u32 numWords, i;
+
+  if(InstancePtr->Hsc.Config.ScalerType == XV_HSCALER_POLYPHASE)
+  {
+    if(InstancePtr->UseExtCoeff)  //User defined coefficients
+    {
+      coeff = &InstancePtr->coeff[0][0];
+    }
+    else
+    {
+      coeff = PlanPtr->Coeff;
+      if(coeff && (coeff != InstancePtr->CoeffBank))
+      {
+        XV_HScalerLoadExtCoeff(InstancePtr,
+                               (1<<InstancePtr->Hsc.Config.PhaseShift),
+                               PlanPtr->NumTaps,
+                               coeff);
+        InstancePtr->UseExtCoeff = FALSE;
+      }
+    }
+
+    if(!coeff || (coeff != InstancePtr->CoeffBank))
+    {
+      /* Program coefficients into the IP register bank */
+      XV_HScalerSetCoeff(InstancePtr);
+      InstancePtr->CoeffBank = coeff;
+    }
+  }
+
+  if(PlanPtr != InstancePtr->PhaseBank)
+  {
+    /* Program the phases of the plan into the IP register bank */
+    baseAddr = XV_hscaler_Get_HwReg_phasesH_V_BaseAddress(&InstancePtr->Hsc);
+    numWords = XV_HScalerNumPhaseWords(InstancePtr);
+    for(i = 0; i < numWords; i++)
+    {
+      /* With 8 pixels per clock, 1 register out of 4 is reserved */
+      if((InstancePtr->Hsc.Config.PixPerClk == XVIDC_PPC_8) && ((i&3) == 3))
+      {
+        continue;
+      }
+      Xil_Out32(baseAddr+(i*4), PlanPtr->PhaseWords[i]);
+    }
+    InstancePtr->PhaseBank = PlanPtr;
+  }
+}
 
 /*****************************************************************************/
 /**
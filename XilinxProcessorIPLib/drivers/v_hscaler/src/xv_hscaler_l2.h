@@ -53,6 +53,22 @@
 * This driver supports Virtual Memory. The RTOS is responsible for calculating
 * the correct device base address in Virtual Memory space.
 *
+* <b> Plan Cache </b>
+*
+* XV_HScalerSetup() computes the phases of a line and selects the filter
+* coefficients for the scaling ratio, then writes both register banks. When
+* an application switches between a few resolutions, it can give the driver
+* storage for plans with XV_HScalerSetPlanCache(). A plan holds the phase bank
+* and the coefficient table of a (WidthIn, WidthOut) pair, the other inputs of
+* the computation being fixed by the core configuration. XV_HScalerSetup()
+* then computes a plan only once, and writes a bank only when it differs from
+* the one already loaded in the core. Plans for the modes known in advance
+* can be computed at initialization with XV_HScalerAddPlan().
+*
+* The banks are not cleared by a reset of the core. If the core lost its
+* configuration, XV_HScalerInvalidateBanks() forces the next setup to write
+* them again.
+*
 * <b> Threads </b>
 *
 * This driver is not thread safe. Any needs for threads or thread mutual
@@ -70,6 +86,8 @@
 *       dmc   12/17/15   Add macro to query the Is422Enabled flag that was
 *                        added to the XV_hscaler_Config structure
 * 3.0   mpe   04/28/16   Added optional color format conversion handling
+* 3.4   jb    10/18/26   Added the plan cache of the phase and coefficient
+*                        banks
 * </pre>
 *
 ******************************************************************************/
@@ -91,6 +109,7 @@ extern "C" {
 #define XV_HSCALER_MAX_H_TAPS           (12)
 #define XV_HSCALER_MAX_H_PHASES         (64)
 #define XV_HSCALER_MAX_LINE_WIDTH       (8192)
+#define XV_HSCALER_MAX_PHASE_WORDS      (XV_HSCALER_MAX_LINE_WIDTH/2)
 
 /**************************** Type Definitions *******************************/
 /**
@@ -114,6 +133,20 @@ typedef enum
   XV_HSCALER_TAPS_12 = 12
 }XV_HSCALER_TAPS;
 
+/**
+ * Precomputed setup of the phase and coefficient banks for a scaling ratio,
+ * see XV_HScalerSetPlanCache()
+ */
+typedef struct
+{
+  u32 WidthIn;        /**< Input stream width */
+  u32 WidthOut;       /**< Output stream width */
+  const short *Coeff; /**< Internal coefficient table, NULL if none */
+  u16 NumTaps;        /**< Taps of the coefficient table */
+  u16 IsValid;        /**< Plan has been computed */
+  u32 PhaseWords[XV_HSCALER_MAX_PHASE_WORDS]; /**< Phase bank registers */
+}XV_HScalerPlan;
+
 /**
  * H Scaler Layer 2 data. The user is required to allocate a variable
  * of this type for every H Scaler device in the system. A pointer to a
@@ -126,6 +159,13 @@ typedef struct
   short coeff[XV_HSCALER_MAX_H_PHASES][XV_HSCALER_MAX_H_TAPS];
   u64 phasesH[XV_HSCALER_MAX_LINE_WIDTH];
   u64 phasesH_H[XV_HSCALER_MAX_LINE_WIDTH];
+  XV_HScalerPlan *Plans;   /**< Plan cache, NULL if disabled */
+  u16 NumPlans;            /**< Number of plans in the cache */
+  u16 NextPlan;            /**< Next plan to replace on a miss */
+  const short *CoeffBank;  /**< Coefficients loaded in the core, NULL if
+                                unknown */
+  const XV_HScalerPlan *PhaseBank; /**< Plan of the phases loaded in the
+                                        core, NULL if unknown */
 }XV_Hscaler_l2;
 
 /************************** Macros Definitions *******************************/
@@ -184,6 +224,13 @@ int XV_HScalerValidateConfig(XV_Hscaler_l2 *InstancePtr,
                              u32 ColorFormatIn,
                              u32 ColorFormatOut);
 void XV_HScalerDbgReportStatus(XV_Hscaler_l2 *InstancePtr);
+void XV_HScalerSetPlanCache(XV_Hscaler_l2 *InstancePtr,
+                            XV_HScalerPlan *Plans,
+                            u16 NumPlans);
+int XV_HScalerAddPlan(XV_Hscaler_l2 *InstancePtr,
+                      u32 WidthIn,
+                      u32 WidthOut);
+void XV_HScalerInvalidateBanks(XV_Hscaler_l2 *InstancePtr);
 
 #ifdef __cplusplus
 }
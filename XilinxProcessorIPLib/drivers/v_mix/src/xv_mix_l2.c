@@ -48,6 +48,9 @@
 * 6.00  pg    01/10/20   Add Colorimetry feature.
 *                        Program Mixer CSC registers to do color conversion
 *                        from YUV to RGB and RGB to YUV.
+* 6.30  jb    10/18/26   Add transactional layer updates: staged layer settings
+*                        are committed at frame done, writing only the
+*                        registers that changed.
 * </pre>
 *
 ******************************************************************************/
@@ -67,6 +70,24 @@
 #define XVMIX_MIN_LOGO_HEIGHT           (32u)
 #define XV_WAIT_FOR_FLUSH_DONE		    (25)
 #define XV_WAIT_FOR_FLUSH_DONE_TIMEOUT	(2000)
+#define XVMIX_TXN_ENABLE_SLOT           (0)
+#define XVMIX_TXN_LAYER_REGS            (7)
+
+/*
+ * Orders the accesses to the submitted state against the Pending flag, which
+ * hands the submitted state over between XVMix_TxnSubmit and XVMix_TxnCommit
+ */
+#ifdef __linux__
+#define XVMIX_TXN_SYNC                  __sync_synchronize()
+#else
+#define XVMIX_TXN_SYNC                  DATA_SYNC
+#endif
+
+/* Transaction state slot of a layer, and layer of a slot */
+#define XVMIX_TXN_SLOT(LayerId)  (((LayerId) == XVMIX_LAYER_LOGO) ? \
+                                  XVMIX_TXN_LOGO_SLOT : (u32)(LayerId))
+#define XVMIX_TXN_LAYER_ID(Slot) (((Slot) == XVMIX_TXN_LOGO_SLOT) ? \
+                                  XVMIX_LAYER_LOGO : (XVMix_LayerId)(Slot))
 
 /* Pixel values in 8 bit resolution in YUV color space*/
 static const u8 bkgndColorYUV[XVMIX_BKGND_LAST][3] =
@@ -93,6 +114,14 @@ static void SetPowerOnDefaultState(XV_Mix_l2 *InstancePtr);
 static int IsWindowValid(XVidC_VideoStream *Strm,
                          XVidC_VideoWindow *Win,
                          XVMix_Scalefactor ScaleFactor);
+static int TxnIsLayerValid(XV_Mix_l2 *InstancePtr, XVMix_LayerId LayerId);
+static void TxnReadLayer(XV_Mix_l2 *InstancePtr,
+                         XVMix_LayerId LayerId,
+                         XVMix_TxnLayer *LayerPtr);
+static u32 TxnWriteLayer(XV_Mix_l2 *InstancePtr,
+                         XVMix_LayerId LayerId,
+                         const XVMix_TxnLayer *NewPtr,
+                         XVMix_TxnLayer *CurPtr);
 
 /*****************************************************************************/
 /**
@@ -1770,4 +1799,742 @@ u32 XVMix_SetCscCoeffs(XV_Mix_l2 *InstancePtr,
 	return XST_SUCCESS;
 
 }
+
+/*****************************************************************************/
+/**
+* This function checks if the specified layer exists in the core, for the
+* transactional layer updates
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  LayerId is the layer to be checked
+*
+* @return TRUE if the layer exists else FALSE
+*
+******************************************************************************/
+static int TxnIsLayerValid(XV_Mix_l2 *InstancePtr, XVMix_LayerId LayerId)
+{
+  if(LayerId == XVMIX_LAYER_LOGO) {
+    return(XVMix_IsLogoEnabled(InstancePtr) ? TRUE : FALSE);
+  }
+  return(((LayerId > XVMIX_LAYER_MASTER) &&
+          (LayerId < XVMix_GetNumLayers(InstancePtr))) ? TRUE : FALSE);
+}
+
+/*****************************************************************************/
+/**
+* This function reads the settings of the specified layer from the registers
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  LayerId is the layer to be read
+* @param  LayerPtr is the pointer to return the settings
+*
+* @return None
+*
+******************************************************************************/
+static void TxnReadLayer(XV_Mix_l2 *InstancePtr,
+                         XVMix_LayerId LayerId,
+                         XVMix_TxnLayer *LayerPtr)
+{
+  memset(LayerPtr, 0, sizeof(XVMix_TxnLayer));
+
+  XVMix_GetLayerWindow(InstancePtr, LayerId, &LayerPtr->Win);
+  LayerPtr->Scale = XVMix_GetLayerScaleFactor(InstancePtr, LayerId);
+  LayerPtr->Alpha = XVMix_GetLayerAlpha(InstancePtr, LayerId);
+
+  if(LayerId != XVMIX_LAYER_LOGO) {
+    LayerPtr->Stride = XV_mix_ReadReg(InstancePtr->Mix.Config.BaseAddress,
+                            (XV_MIX_CTRL_ADDR_HWREG_LAYERSTRIDE_0_DATA +
+                             (LayerId*XVMIX_REG_OFFSET)));
+    LayerPtr->BufAddr = XVMix_GetLayerBufferAddr(InstancePtr, LayerId);
+    LayerPtr->ChromaBufAddr = XVMix_GetLayerChromaBufferAddr(InstancePtr,
+                                                             LayerId);
+  }
+}
+
+/*****************************************************************************/
+/**
+* This function writes the registers of the specified layer that differ from
+* the settings committed before
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  LayerId is the layer to be written
+* @param  NewPtr is the pointer to the settings to commit
+* @param  CurPtr is the pointer to the committed settings, updated on return
+*
+* @return Number of registers written
+*
+******************************************************************************/
+static u32 TxnWriteLayer(XV_Mix_l2 *InstancePtr,
+                         XVMix_LayerId LayerId,
+                         const XVMix_TxnLayer *NewPtr,
+                         XVMix_TxnLayer *CurPtr)
+{
+  UINTPTR BaseAddr = InstancePtr->Mix.Config.BaseAddress;
+  XVMix_TxnStats *Stats = &InstancePtr->Txn->Stats;
+  const u32 *NewVal[XVMIX_TXN_LAYER_REGS] = {
+    &NewPtr->Win.StartX, &NewPtr->Win.StartY, &NewPtr->Win.Width,
+    &NewPtr->Win.Height, &NewPtr->Stride, &NewPtr->Scale, &NewPtr->Alpha
+  };
+  u32 *CurVal[XVMIX_TXN_LAYER_REGS] = {
+    &CurPtr->Win.StartX, &CurPtr->Win.StartY, &CurPtr->Win.Width,
+    &CurPtr->Win.Height, &CurPtr->Stride, &CurPtr->Scale, &CurPtr->Alpha
+  };
+  u32 Offset[XVMIX_TXN_LAYER_REGS];
+  u32 IsMemory = FALSE;
+  u32 Writes = 0;
+  u32 Index;
+
+  /* Offset 0 marks a register the layer does not have */
+  if(LayerId == XVMIX_LAYER_LOGO) {
+    Offset[0] = XV_MIX_CTRL_ADDR_HWREG_LOGOSTARTX_DATA;
+    Offset[1] = XV_MIX_CTRL_ADDR_HWREG_LOGOSTARTY_DATA;
+    Offset[2] = XV_MIX_CTRL_ADDR_HWREG_LOGOWIDTH_DATA;
+    Offset[3] = XV_MIX_CTRL_ADDR_HWREG_LOGOHEIGHT_DATA;
+    Offset[4] = 0;
+    Offset[5] = XV_MIX_CTRL_ADDR_HWREG_LOGOSCALEFACTOR_DATA;
+    Offset[6] = XV_MIX_CTRL_ADDR_HWREG_LOGOALPHA_DATA;
+  } else {
+    u32 LayerOffset = LayerId*XVMIX_REG_OFFSET;
+
+    IsMemory = !XVMix_IsLayerInterfaceStream(InstancePtr, LayerId);
+    Offset[0] = XV_MIX_CTRL_ADDR_HWREG_LAYERSTARTX_0_DATA + LayerOffset;
+    Offset[1] = XV_MIX_CTRL_ADDR_HWREG_LAYERSTARTY_0_DATA + LayerOffset;
+    Offset[2] = XV_MIX_CTRL_ADDR_HWREG_LAYERWIDTH_0_DATA + LayerOffset;
+    Offset[3] = XV_MIX_CTRL_ADDR_HWREG_LAYERHEIGHT_0_DATA + LayerOffset;
+    Offset[4] = IsMemory ?
+                (XV_MIX_CTRL_ADDR_HWREG_LAYERSTRIDE_0_DATA + LayerOffset) : 0;
+    Offset[5] = XVMix_IsScalingEnabled(InstancePtr, LayerId) ?
+                (XV_MIX_CTRL_ADDR_HWREG_LAYERSCALEFACTOR_0_DATA + LayerOffset) :
+                0;
+    Offset[6] = XVMix_IsAlphaEnabled(InstancePtr, LayerId) ?
+                (XV_MIX_CTRL_ADDR_HWREG_LAYERALPHA_0_DATA + LayerOffset) : 0;
+  }
+
+  for(Index = 0; Index < XVMIX_TXN_LAYER_REGS; Index++) {
+    if(Offset[Index] == 0) {
+      continue;
+    }
+    if(*NewVal[Index] != *CurVal[Index]) {
+      XV_mix_WriteReg(BaseAddr, Offset[Index], *NewVal[Index]);
+      *CurVal[Index] = *NewVal[Index];
+      Writes++;
+    } else {
+      Stats->RegSkips++;
+    }
+  }
+
+  if(IsMemory) {
+    u32 BufOffset = (LayerId-1)*XVMIX_REG_OFFSET;
+
+    if(NewPtr->BufAddr != CurPtr->BufAddr) {
+      XV_mix_WriteReg(BaseAddr,
+                      (XV_MIX_CTRL_ADDR_HWREG_LAYER1_BUF1_V_DATA + BufOffset),
+                      NewPtr->BufAddr);
+      CurPtr->BufAddr = NewPtr->BufAddr;
+      Writes++;
+    } else {
+      Stats->RegSkips++;
+    }
+    if(NewPtr->ChromaBufAddr != CurPtr->ChromaBufAddr) {
+      XV_mix_WriteReg(BaseAddr,
+                      (XV_MIX_CTRL_ADDR_HWREG_LAYER1_BUF2_V_DATA + BufOffset),
+                      NewPtr->ChromaBufAddr);
+      CurPtr->ChromaBufAddr = NewPtr->ChromaBufAddr;
+      Writes++;
+    } else {
+      Stats->RegSkips++;
+    }
+  }
+
+  return(Writes);
+}
+
+/*****************************************************************************/
+/**
+* This function attaches a transaction state to the core instance, and reads
+* the current layer settings from the registers into it. The staged state
+* starts equal to the register state.
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  TxnPtr is a pointer to the transaction state, which must stay valid
+*         while attached, or NULL to detach the current one
+* @param  GetTime is the time source for the commit durations, or NULL
+*
+* @return XST_SUCCESS
+*
+* @note   The core interrupt must be disabled while attaching or detaching.
+*         The immediate layer API's must not be used while a state is
+*         attached, see xv_mix_l2.h
+*
+******************************************************************************/
+int XVMix_TxnInit(XV_Mix_l2 *InstancePtr, XVMix_Txn *TxnPtr,
+                  XVMix_TimeFn GetTime)
+{
+  XVMix_LayerId LayerId;
+  u32 Slot;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+
+  InstancePtr->Txn = NULL;
+  if(TxnPtr == NULL) {
+    return(XST_SUCCESS);
+  }
+
+  memset(TxnPtr, 0, sizeof(XVMix_Txn));
+  TxnPtr->GetTime = GetTime;
+  TxnPtr->ActiveEnable = XV_mix_Get_HwReg_layerEnable(&InstancePtr->Mix);
+
+  for(Slot = 1; Slot < XVMIX_TXN_NUM_SLOTS; Slot++) {
+    LayerId = XVMIX_TXN_LAYER_ID(Slot);
+    if(TxnIsLayerValid(InstancePtr, LayerId)) {
+      TxnReadLayer(InstancePtr, LayerId, &TxnPtr->Active[Slot]);
+    }
+  }
+
+  memcpy(TxnPtr->Staged, TxnPtr->Active, sizeof(TxnPtr->Active));
+  memcpy(TxnPtr->Submitted, TxnPtr->Active, sizeof(TxnPtr->Active));
+  TxnPtr->StagedEnable = TxnPtr->ActiveEnable;
+  TxnPtr->SubmittedEnable = TxnPtr->ActiveEnable;
+
+  InstancePtr->Txn = TxnPtr;
+  return(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+* This function stages the enable of the specified layer
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  LayerId is layer number to be enabled
+*
+* @return XST_SUCCESS or XST_FAILURE
+*
+* @note   To enable all layers use layer id  XVMIX_LAYER_ALL
+*
+******************************************************************************/
+int XVMix_TxnLayerEnable(XV_Mix_l2 *InstancePtr, XVMix_LayerId LayerId)
+{
+  XVMix_Txn *TxnPtr;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(InstancePtr->Txn != NULL);
+  Xil_AssertNonvoid((LayerId >= XVMIX_LAYER_MASTER) &&
+                    (LayerId < XVMIX_LAYER_LAST));
+
+  TxnPtr = InstancePtr->Txn;
+
+  if(LayerId == XVMIX_LAYER_ALL) {
+    TxnPtr->StagedEnable = XVMIX_MASK_ENABLE_ALL_LAYERS;
+  } else if((LayerId == XVMIX_LAYER_MASTER) ||
+            TxnIsLayerValid(InstancePtr, LayerId)) {
+    TxnPtr->StagedEnable |= (1<<LayerId);
+  } else {
+    return(XST_FAILURE);
+  }
+
+  TxnPtr->StagedMask |= (1<<XVMIX_TXN_ENABLE_SLOT);
+  return(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+* This function stages the disable of the specified layer
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  LayerId is layer number to be disabled
+*
+* @return XST_SUCCESS or XST_FAILURE
+*
+* @note   To disable all layers use layer id  XVMIX_LAYER_ALL
+*
+******************************************************************************/
+int XVMix_TxnLayerDisable(XV_Mix_l2 *InstancePtr, XVMix_LayerId LayerId)
+{
+  XVMix_Txn *TxnPtr;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(InstancePtr->Txn != NULL);
+  Xil_AssertNonvoid((LayerId >= XVMIX_LAYER_MASTER) &&
+                    (LayerId < XVMIX_LAYER_LAST));
+
+  TxnPtr = InstancePtr->Txn;
+
+  if(LayerId == XVMIX_LAYER_ALL) {
+    TxnPtr->StagedEnable = XVMIX_MASK_DISABLE_ALL_LAYERS;
+  } else if((LayerId == XVMIX_LAYER_MASTER) ||
+            TxnIsLayerValid(InstancePtr, LayerId)) {
+    TxnPtr->StagedEnable &= ~(1<<LayerId);
+  } else {
+    return(XST_FAILURE);
+  }
+
+  TxnPtr->StagedMask |= (1<<XVMIX_TXN_ENABLE_SLOT);
+  return(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+* This function stages the window coordinates of the specified layer, see
+* XVMix_SetLayerWindow
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  LayerId is the layer for which window coordinates are to be set
+* @param  Win is the pointer to window coordinates to be set
+* @param  StrideInBytes is the stride of the requested window, applicable only
+*         when layer type is Memory
+*
+* @return XST_SUCCESS if command is successful else error code with reason
+*
+* @note   The window is validated against the staged scale factor
+*
+******************************************************************************/
+int XVMix_TxnSetLayerWindow(XV_Mix_l2 *InstancePtr,
+                            XVMix_LayerId LayerId,
+                            XVidC_VideoWindow *Win,
+                            u32 StrideInBytes)
+{
+  XV_mix *MixPtr;
+  XVMix_TxnLayer *LayerPtr;
+  u32 Align, WinResInRange;
+  u32 Slot;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(InstancePtr->Txn != NULL);
+  Xil_AssertNonvoid((LayerId > XVMIX_LAYER_MASTER) &&
+                    (LayerId <= XVMIX_LAYER_LOGO));
+  Xil_AssertNonvoid(Win != NULL);
+  Xil_AssertNonvoid((Win->StartX % InstancePtr->Mix.Config.PixPerClk) == 0);
+  Xil_AssertNonvoid((Win->Width  % InstancePtr->Mix.Config.PixPerClk) == 0);
+
+  if(!TxnIsLayerValid(InstancePtr, LayerId)) {
+    return(XVMIX_ERR_DISABLED_IN_HW);
+  }
+
+  MixPtr = &InstancePtr->Mix;
+  Slot = XVMIX_TXN_SLOT(LayerId);
+  LayerPtr = &InstancePtr->Txn->Staged[Slot];
+
+  if(!IsWindowValid(&InstancePtr->Stream, Win,
+                    (XVMix_Scalefactor)LayerPtr->Scale)) {
+    return(XVMIX_ERR_LAYER_WINDOW_INVALID);
+  }
+
+  if(LayerId == XVMIX_LAYER_LOGO) {
+    WinResInRange = ((Win->Width  > (XVMIX_MIN_LOGO_WIDTH-1))  &&
+                     (Win->Height > (XVMIX_MIN_LOGO_HEIGHT-1)) &&
+                     (Win->Width  <= MixPtr->Config.MaxLogoWidth) &&
+                     (Win->Height <= MixPtr->Config.MaxLogoHeight));
+  } else {
+    WinResInRange = ((Win->Width  > (XVMIX_MIN_STRM_WIDTH-1))  &&
+                     (Win->Height > (XVMIX_MIN_STRM_HEIGHT-1)) &&
+                     (Win->Width  < MixPtr->Config.LayerMaxWidth[LayerId-1]) &&
+                     (Win->Height <= MixPtr->Config.MaxHeight));
+  }
+  if(!WinResInRange) {
+    return(XVMIX_ERR_LAYER_WINDOW_INVALID);
+  }
+
+  if((LayerId != XVMIX_LAYER_LOGO) &&
+     !XVMix_IsLayerInterfaceStream(InstancePtr, LayerId)) {
+    /* Check if stride is aligned to aximm width (2*PPC*32-bits) */
+    Align = 2 * MixPtr->Config.PixPerClk * 4;
+    if((StrideInBytes % Align) != 0) {
+      return(XVMIX_ERR_WIN_STRIDE_MISALIGNED);
+    }
+    LayerPtr->Stride = StrideInBytes;
+  }
+
+  LayerPtr->Win = *Win;
+  InstancePtr->Txn->StagedMask |= (1<<Slot);
+  return(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+* This function stages a new window position of the specified layer, see
+* XVMix_MoveLayerWindow
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  LayerId is the layer for which window position is to be set
+* @param  StartX is the new X position
+* @param  StartY is the new Y position
+*
+* @return XST_SUCCESS if command is successful else error code with reason
+*
+******************************************************************************/
+int XVMix_TxnMoveLayerWindow(XV_Mix_l2 *InstancePtr,
+                             XVMix_LayerId LayerId,
+                             u16 StartX,
+                             u16 StartY)
+{
+  XVMix_TxnLayer *LayerPtr;
+  XVidC_VideoWindow NewWin;
+  u32 Slot;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(InstancePtr->Txn != NULL);
+  Xil_AssertNonvoid((LayerId > XVMIX_LAYER_MASTER) &&
+                    (LayerId <= XVMIX_LAYER_LOGO));
+  Xil_AssertNonvoid((StartX % InstancePtr->Mix.Config.PixPerClk) == 0);
+
+  if(!TxnIsLayerValid(InstancePtr, LayerId)) {
+    return(XVMIX_ERR_DISABLED_IN_HW);
+  }
+
+  Slot = XVMIX_TXN_SLOT(LayerId);
+  LayerPtr = &InstancePtr->Txn->Staged[Slot];
+
+  NewWin = LayerPtr->Win;
+  NewWin.StartX = StartX;
+  NewWin.StartY = StartY;
+  if(!IsWindowValid(&InstancePtr->Stream, &NewWin,
+                    (XVMix_Scalefactor)LayerPtr->Scale)) {
+    return(XVMIX_ERR_LAYER_WINDOW_INVALID);
+  }
+
+  LayerPtr->Win = NewWin;
+  InstancePtr->Txn->StagedMask |= (1<<Slot);
+  return(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+* This function stages the scaling factor of the specified layer, see
+* XVMix_SetLayerScaleFactor
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  LayerId is the layer to be updated
+* @param  Scale is the scale factor
+*
+* @return XST_SUCCESS if command is successful else error code with reason
+*
+******************************************************************************/
+int XVMix_TxnSetLayerScaleFactor(XV_Mix_l2 *InstancePtr,
+                                 XVMix_LayerId LayerId,
+                                 XVMix_Scalefactor Scale)
+{
+  XVMix_TxnLayer *LayerPtr;
+  u32 Slot;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(InstancePtr->Txn != NULL);
+  Xil_AssertNonvoid((LayerId > XVMIX_LAYER_MASTER) &&
+                    (LayerId <= XVMIX_LAYER_LOGO));
+  Xil_AssertNonvoid((Scale >= XVMIX_SCALE_FACTOR_1X) &&
+                    (Scale <= XVMIX_SCALE_FACTOR_4X));
+
+  if(!TxnIsLayerValid(InstancePtr, LayerId) ||
+     ((LayerId != XVMIX_LAYER_LOGO) &&
+      !XVMix_IsScalingEnabled(InstancePtr, LayerId))) {
+    return(XST_FAILURE);
+  }
+
+  Slot = XVMIX_TXN_SLOT(LayerId);
+  LayerPtr = &InstancePtr->Txn->Staged[Slot];
+
+  /* Validate if scaling will cause the layer window to go out of scope */
+  if(!IsWindowValid(&InstancePtr->Stream, &LayerPtr->Win, Scale)) {
+    return(XVMIX_ERR_LAYER_WINDOW_INVALID);
+  }
+
+  LayerPtr->Scale = Scale;
+  InstancePtr->Txn->StagedMask |= (1<<Slot);
+  return(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+* This function stages the Alpha level of the specified layer, see
+* XVMix_SetLayerAlpha
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  LayerId is the layer to be updated
+* @param  Alpha is the new value
+*
+* @return XST_SUCCESS if command is successful else error code with reason
+*
+******************************************************************************/
+int XVMix_TxnSetLayerAlpha(XV_Mix_l2 *InstancePtr,
+                           XVMix_LayerId LayerId,
+                           u16 Alpha)
+{
+  u32 Slot;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(InstancePtr->Txn != NULL);
+  Xil_AssertNonvoid((LayerId > XVMIX_LAYER_MASTER) &&
+                    (LayerId <= XVMIX_LAYER_LOGO));
+  Xil_AssertNonvoid(Alpha <= XVMIX_ALPHA_MAX);
+
+  if(!TxnIsLayerValid(InstancePtr, LayerId) ||
+     ((LayerId != XVMIX_LAYER_LOGO) &&
+      !XVMix_IsAlphaEnabled(InstancePtr, LayerId))) {
+    return(XVMIX_ERR_DISABLED_IN_HW);
+  }
+
+  Slot = XVMIX_TXN_SLOT(LayerId);
+  InstancePtr->Txn->Staged[Slot].Alpha = Alpha;
+  InstancePtr->Txn->StagedMask |= (1<<Slot);
+  return(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+* This function stages the buffer address of the specified layer, see
+* XVMix_SetLayerBufferAddr
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  LayerId is the layer to be updated
+* @param  Addr is the absolute address of buffer in memory
+*
+* @return XST_SUCCESS or error code with reason
+*
+* @note   Applicable only for Layer1-16
+*
+******************************************************************************/
+int XVMix_TxnSetLayerBufferAddr(XV_Mix_l2 *InstancePtr,
+                                XVMix_LayerId LayerId,
+                                UINTPTR Addr)
+{
+  UINTPTR Align;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(InstancePtr->Txn != NULL);
+  Xil_AssertNonvoid((LayerId > XVMIX_LAYER_MASTER) &&
+                    (LayerId < XVMIX_LAYER_LOGO));
+  Xil_AssertNonvoid(Addr != 0);
+
+  if(!TxnIsLayerValid(InstancePtr, LayerId)) {
+    return(XST_FAILURE);
+  }
+
+  /* Check if addr is aligned to aximm width (2*PPC*32-bits (4Bytes)) */
+  Align = 2 * InstancePtr->Mix.Config.PixPerClk * 4;
+  if((Addr % Align) != 0) {
+    return(XVMIX_ERR_MEM_ADDR_MISALIGNED);
+  }
+
+  InstancePtr->Txn->Staged[LayerId].BufAddr = Addr;
+  InstancePtr->Txn->StagedMask |= (1<<LayerId);
+  return(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+* This function stages the buffer address of the specified layer for the UV
+* plane for semi-planar formats, see XVMix_SetLayerChromaBufferAddr
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  LayerId is the layer to be updated
+* @param  Addr is the absolute address of second buffer in memory
+*
+* @return XST_SUCCESS or error code with reason
+*
+* @note   Applicable only for Layer1-16
+*
+******************************************************************************/
+int XVMix_TxnSetLayerChromaBufferAddr(XV_Mix_l2 *InstancePtr,
+                                      XVMix_LayerId LayerId,
+                                      UINTPTR Addr)
+{
+  UINTPTR Align;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(InstancePtr->Txn != NULL);
+  Xil_AssertNonvoid((LayerId > XVMIX_LAYER_MASTER) &&
+                    (LayerId < XVMIX_LAYER_LOGO));
+  Xil_AssertNonvoid(Addr != 0);
+
+  if(!TxnIsLayerValid(InstancePtr, LayerId)) {
+    return(XST_FAILURE);
+  }
+
+  /* Check if addr is aligned to aximm width (2*PPC*32-bits (4Bytes)) */
+  Align = 2 * InstancePtr->Mix.Config.PixPerClk * 4;
+  if((Addr % Align) != 0) {
+    return(XVMIX_ERR_MEM_ADDR_MISALIGNED);
+  }
+
+  InstancePtr->Txn->Staged[LayerId].ChromaBufAddr = Addr;
+  InstancePtr->Txn->StagedMask |= (1<<LayerId);
+  return(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+* This function submits the staged layer changes, to be committed at the next
+* frame done by the interrupt handler, or by XVMix_TxnCommit
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+*
+* @return XST_SUCCESS if the changes were submitted or nothing was staged,
+*         XST_DEVICE_BUSY if the previous submission is not committed yet.
+*         The staged changes are then kept for the next submission.
+*
+* @note   May be called from the frame done callback, the changes are then
+*         committed before the next frame is started
+*
+******************************************************************************/
+int XVMix_TxnSubmit(XV_Mix_l2 *InstancePtr)
+{
+  XVMix_Txn *TxnPtr;
+  u32 Slot;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(InstancePtr->Txn != NULL);
+
+  TxnPtr = InstancePtr->Txn;
+
+  if(TxnPtr->Pending) {
+    TxnPtr->Stats.Busy++;
+    return(XST_DEVICE_BUSY);
+  }
+  if(TxnPtr->StagedMask == 0) {
+    return(XST_SUCCESS);
+  }
+  XVMIX_TXN_SYNC;
+
+  /* The handler does not read the submitted state until Pending is set */
+  for(Slot = 1; Slot < XVMIX_TXN_NUM_SLOTS; Slot++) {
+    if(TxnPtr->StagedMask & (1<<Slot)) {
+      TxnPtr->Submitted[Slot] = TxnPtr->Staged[Slot];
+    }
+  }
+  TxnPtr->SubmittedEnable = TxnPtr->StagedEnable;
+  TxnPtr->SubmittedMask = TxnPtr->StagedMask;
+  TxnPtr->StagedMask = 0;
+  TxnPtr->SubmitTime = (TxnPtr->GetTime != NULL) ? TxnPtr->GetTime() : 0;
+  XVMIX_TXN_SYNC;
+  TxnPtr->Pending = TRUE;
+
+  return(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+* This function commits the submitted layer changes to the registers, writing
+* only the registers that changed. It is called by the interrupt handler at
+* frame done, when the core is idle.
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+*
+* @return XST_SUCCESS if a submission was committed, else XST_NO_DATA
+*
+* @note   In polling mode the core restarts on its own, the application then
+*         commits between two frames, e.g. from a vertical sync interrupt
+*
+******************************************************************************/
+int XVMix_TxnCommit(XV_Mix_l2 *InstancePtr)
+{
+  XVMix_Txn *TxnPtr;
+  XVMix_TxnStats *Stats;
+  XVMix_LayerId LayerId;
+  u64 Start = 0;
+  u64 Elapsed;
+  u32 Writes;
+  u32 Slot;
+
+  Xil_AssertNonvoid(InstancePtr != NULL);
+  Xil_AssertNonvoid(InstancePtr->Txn != NULL);
+
+  TxnPtr = InstancePtr->Txn;
+  Stats = &TxnPtr->Stats;
+
+  if(!TxnPtr->Pending) {
+    return(XST_NO_DATA);
+  }
+  XVMIX_TXN_SYNC;
+  if(TxnPtr->GetTime != NULL) {
+    Start = TxnPtr->GetTime();
+  }
+
+  Stats->LastLayers = 0;
+  Stats->LastRegWrites = 0;
+
+  if((TxnPtr->SubmittedMask & (1<<XVMIX_TXN_ENABLE_SLOT)) &&
+     (TxnPtr->SubmittedEnable != TxnPtr->ActiveEnable)) {
+    XV_mix_Set_HwReg_layerEnable(&InstancePtr->Mix, TxnPtr->SubmittedEnable);
+    TxnPtr->ActiveEnable = TxnPtr->SubmittedEnable;
+    Stats->LastRegWrites++;
+  }
+
+  for(Slot = 1; Slot < XVMIX_TXN_NUM_SLOTS; Slot++) {
+    if(!(TxnPtr->SubmittedMask & (1<<Slot))) {
+      continue;
+    }
+
+    LayerId = XVMIX_TXN_LAYER_ID(Slot);
+    Writes = TxnWriteLayer(InstancePtr, LayerId, &TxnPtr->Submitted[Slot],
+                           &TxnPtr->Active[Slot]);
+    if(Writes != 0) {
+      Stats->LastLayers++;
+      Stats->LastRegWrites += Writes;
+    }
+
+    if(LayerId < XVMIX_MAX_SUPPORTED_LAYERS) {
+      InstancePtr->Layer[LayerId].Win = TxnPtr->Active[Slot].Win;
+      InstancePtr->Layer[LayerId].BufAddr = TxnPtr->Active[Slot].BufAddr;
+    }
+  }
+
+  TxnPtr->SubmittedMask = 0;
+  XVMIX_TXN_SYNC;
+  TxnPtr->Pending = FALSE;
+
+  Stats->Commits++;
+  Stats->RegWrites += Stats->LastRegWrites;
+  if(TxnPtr->GetTime != NULL) {
+    Elapsed = TxnPtr->GetTime();
+    Stats->LastLatency = Elapsed - TxnPtr->SubmitTime;
+    Elapsed -= Start;
+    Stats->LastTime = Elapsed;
+    Stats->TotalTime += Elapsed;
+    if(Elapsed > Stats->MaxTime) {
+      Stats->MaxTime = Elapsed;
+    }
+    if(Stats->LastLatency > Stats->MaxLatency) {
+      Stats->MaxLatency = Stats->LastLatency;
+    }
+  }
+
+  return(XST_SUCCESS);
+}
+
+/*****************************************************************************/
+/**
+* This function returns the counters of the transactional layer updates
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  StatsPtr is a pointer to the counters, filled on return
+*
+* @return None
+*
+* @note   The mean commit duration is TotalTime / Commits
+*
+******************************************************************************/
+void XVMix_TxnGetStats(XV_Mix_l2 *InstancePtr, XVMix_TxnStats *StatsPtr)
+{
+  Xil_AssertVoid(InstancePtr != NULL);
+  Xil_AssertVoid(InstancePtr->Txn != NULL);
+  Xil_AssertVoid(StatsPtr != NULL);
+
+  *StatsPtr = InstancePtr->Txn->Stats;
+}
+
+/*****************************************************************************/
+/**
+* This function clears the counters of the transactional layer updates
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+*
+* @return None
+*
+******************************************************************************/
+void XVMix_TxnResetStats(XV_Mix_l2 *InstancePtr)
+{
+  Xil_AssertVoid(InstancePtr != NULL);
+  Xil_AssertVoid(InstancePtr->Txn != NULL);
+
+  memset(&InstancePtr->Txn->Stats, 0, sizeof(XVMix_TxnStats));
+}
 /** @} */
@@ -79,6 +79,32 @@
 *     will configure the IP to keep processing frames without sw intervention.
 *   - Polling mode is the default configuration set during driver initialization
 *
+* <b> Transactional Layer Updates </b>
+*
+* The layer API's above write the registers immediately, so that a set of
+* updates issued while a frame is processed takes effect over two frames. To
+* update many layers at once without tearing, the application can attach a
+* XVMix_Txn state with XVMix_TxnInit, stage the layer changes with the
+* XVMix_Txn* API's, and submit them with XVMix_TxnSubmit. The interrupt handler
+* commits the submitted changes at the next frame done, before the next frame
+* is started, writing only the registers of the layers that changed.
+*   - Staging validates the changes as the immediate API's do, and only
+*     updates the staged state in memory
+*   - A submission is refused with XST_DEVICE_BUSY until the previous one is
+*     committed, the staged changes are kept for the next submission
+*   - In polling mode, the application commits with XVMix_TxnCommit
+*   - XVMix_TxnGetStats reports the duration of the commits, the submit to
+*     commit latency and the registers written, to budget the updates
+* The state tracks the register values of the layers to skip the unchanged
+* registers, and the immediate layer API's do not update it. While the state
+* is attached, the layers must only be updated through the XVMix_Txn* API's:
+* XVMix_LayerEnable, XVMix_LayerDisable, XVMix_SetLayerWindow,
+* XVMix_MoveLayerWindow, XVMix_SetLayerScaleFactor, XVMix_SetLayerAlpha,
+* XVMix_SetLayerBufferAddr and XVMix_SetLayerChromaBufferAddr must not be
+* used, else a later commit skips registers it takes as unchanged. To go back
+* to the immediate API's, detach the state with XVMix_TxnInit(InstancePtr,
+* NULL, NULL), and attach it again afterwards to read back the registers.
+*
 * <b> Virtual Memory </b>
 *
 * This driver supports Virtual Memory. The RTOS is responsible for calculating
@@ -106,6 +132,7 @@
 * 4.00  vyc   04/04/18   Add 8th overlayer
 *                        Move logo layer enable from bit 8 to bit 15
 * 6.00  pg    01/10/20   Add Colorimetry Feature
+* 6.30  jb    10/18/26   Add transactional layer updates committed at frame done
 * </pre>
 *
 ******************************************************************************/
@@ -134,6 +161,9 @@ extern "C" {
 #define XVMIX_CSC_MATRIX_SIZE	(XVMIX_CSC_MAX_ROWS * XVMIX_CSC_MAX_COLS)
 #define XVMIX_CSC_COEFF_SIZE		(12)
 
+#define XVMIX_TXN_LOGO_SLOT              (XVMIX_MAX_SUPPORTED_LAYERS + 1)
+#define XVMIX_TXN_NUM_SLOTS              (XVMIX_MAX_SUPPORTED_LAYERS + 2)
+
 /**************************** Type Definitions *******************************/
 /**
  * This typedef enumerates supported background colors
@@ -280,6 +310,63 @@ typedef struct {
     };
 }XVMix_Layer;
 
+/**
+ * This typedef contains the settings of a layer in a transaction state. The
+ * fields a layer does not support keep the value read at XVMix_TxnInit.
+ */
+typedef struct {
+    XVidC_VideoWindow Win;   /**< Window coordinates */
+    u32 Stride;              /**< Stride in bytes, memory layers */
+    u32 Scale;               /**< Scale factor */
+    u32 Alpha;               /**< Alpha level */
+    UINTPTR BufAddr;         /**< Buffer address, memory layers */
+    UINTPTR ChromaBufAddr;   /**< UV plane address, memory layers */
+}XVMix_TxnLayer;
+
+/**
+ * Callback type which returns the current time, in any unit. The durations
+ * of the commits are reported in this unit.
+ */
+typedef u64 (*XVMix_TimeFn)(void);
+
+/**
+ * This typedef contains the counters of the transactional layer updates
+ */
+typedef struct {
+    u32 Commits;             /**< Committed submissions */
+    u32 Busy;                /**< Submissions refused, previous pending */
+    u32 LastLayers;          /**< Layers written by the last commit */
+    u32 LastRegWrites;       /**< Registers written by the last commit */
+    u32 RegWrites;           /**< Registers written by all the commits */
+    u32 RegSkips;            /**< Unchanged registers of the changed layers */
+    u64 LastTime;            /**< Duration of the last commit */
+    u64 MaxTime;             /**< Longest commit */
+    u64 TotalTime;           /**< Sum of the commit durations */
+    u64 LastLatency;         /**< Submit to commit time of the last commit */
+    u64 MaxLatency;          /**< Longest submit to commit time */
+}XVMix_TxnStats;
+
+/**
+ * This typedef contains the transaction state of a mixer. Slot 0 holds the
+ * layer enable mask, slots 1-16 the overlay layers and slot
+ * XVMIX_TXN_LOGO_SLOT the logo layer.
+ */
+typedef struct {
+    XVMix_TxnLayer Staged[XVMIX_TXN_NUM_SLOTS];    /**< Being prepared */
+    XVMix_TxnLayer Submitted[XVMIX_TXN_NUM_SLOTS]; /**< To be committed */
+    XVMix_TxnLayer Active[XVMIX_TXN_NUM_SLOTS];    /**< In the registers */
+    u32 StagedEnable;        /**< Layer enable mask being prepared */
+    u32 SubmittedEnable;     /**< Layer enable mask to be committed */
+    u32 ActiveEnable;        /**< Layer enable mask in the register */
+    u32 StagedMask;          /**< Slots staged since the last submission */
+    u32 SubmittedMask;       /**< Slots of the pending submission */
+    volatile u32 Pending;    /**< Submission waiting for the commit, hands
+                                  the submitted state over */
+    u64 SubmitTime;          /**< Time of the pending submission */
+    XVMix_TimeFn GetTime;    /**< Time source, may be NULL */
+    XVMix_TxnStats Stats;    /**< Counters */
+}XVMix_Txn;
+
 /**
 * Callback type for interrupt.
 *
@@ -312,6 +399,8 @@ typedef struct {
     XVMix_BackgroundId BkgndColor;
 
     XVidC_VideoStream Stream;    /**< Input AXIS */
+
+    XVMix_Txn *Txn;        /**< Transaction state, NULL if not attached */
 }XV_Mix_l2;
 
 /************************** Macros Definitions *******************************/
@@ -533,6 +622,36 @@ int XVMix_LoadLogoPixelAlpha(XV_Mix_l2 *InstancePtr,
                              XVidC_VideoWindow *Win,
                              u8 *ABuffer);
 
+/* Transactional layer updates */
+int XVMix_TxnInit(XV_Mix_l2 *InstancePtr, XVMix_Txn *TxnPtr,
+                  XVMix_TimeFn GetTime);
+int XVMix_TxnLayerEnable(XV_Mix_l2 *InstancePtr, XVMix_LayerId LayerId);
+int XVMix_TxnLayerDisable(XV_Mix_l2 *InstancePtr, XVMix_LayerId LayerId);
+int XVMix_TxnSetLayerWindow(XV_Mix_l2 *InstancePtr,
+                            XVMix_LayerId LayerId,
+                            XVidC_VideoWindow *Win,
+                            u32 StrideInBytes);
+int XVMix_TxnMoveLayerWindow(XV_Mix_l2 *InstancePtr,
+                             XVMix_LayerId LayerId,
+                             u16 StartX,
+                             u16 StartY);
+int XVMix_TxnSetLayerScaleFactor(XV_Mix_l2 *InstancePtr,
+                                 XVMix_LayerId LayerId,
+                                 XVMix_Scalefactor Scale);
+int XVMix_TxnSetLayerAlpha(XV_Mix_l2 *InstancePtr,
+                           XVMix_LayerId LayerId,
+                           u16 Alpha);
+int XVMix_TxnSetLayerBufferAddr(XV_Mix_l2 *InstancePtr,
+                                XVMix_LayerId LayerId,
+                                UINTPTR Addr);
+int XVMix_TxnSetLayerChromaBufferAddr(XV_Mix_l2 *InstancePtr,
+                                      XVMix_LayerId LayerId,
+                                      UINTPTR Addr);
+int XVMix_TxnSubmit(XV_Mix_l2 *InstancePtr);
+int XVMix_TxnCommit(XV_Mix_l2 *InstancePtr);
+void XVMix_TxnGetStats(XV_Mix_l2 *InstancePtr, XVMix_TxnStats *StatsPtr);
+void XVMix_TxnResetStats(XV_Mix_l2 *InstancePtr);
+
 void XVMix_DbgReportStatus(XV_Mix_l2 *InstancePtr);
 void XVMix_DbgLayerInfo(XV_Mix_l2 *InstancePtr, XVMix_LayerId LayerId);
 
@@ -20,6 +20,8 @@
 * ----- ---- -------- -------------------------------------------------------
 * 1.00  rco   12/14/15   Initial Release
 *             02/12/16   Move user call back before frame start trigger
+* 6.30  jb    10/18/26   Commit the submitted layer transaction before the
+*                        frame start trigger
 *
 * </pre>
 *
@@ -65,8 +67,8 @@ int XVMix_SetCallback(XV_Mix_l2 *InstancePtr, void *CallbackFunc, void *Callback
 * This function is the interrupt handler for the mixer core driver.
 *
 * This handler clears the pending interrupt and determined if the source is
-* frame done signal. If yes, starts the next frame processing and calls the
-* registered callback function
+* frame done signal. If yes, calls the registered callback function, commits
+* the submitted layer transaction, if any, and starts the next frame processing
 *
 * The application is responsible for connecting this function to the interrupt
 * system. Application beyond this driver is also responsible for providing
@@ -102,6 +104,10 @@ void XVMix_InterruptHandler(void *InstancePtr)
     if(MixPtr->FrameDoneCallback) {
 	      MixPtr->FrameDoneCallback(MixPtr->CallbackRef);
     }
+    /* Apply the staged layer changes while the core is idle */
+    if(MixPtr->Txn) {
+      XVMix_TxnCommit(MixPtr);
+    }
     XV_mix_Start(&MixPtr->Mix);
   }
 }
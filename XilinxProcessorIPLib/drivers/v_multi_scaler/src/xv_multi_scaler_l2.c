@@ -19,9 +19,43 @@
 
 /***************************** Include Files *********************************/
 #include "xv_multi_scaler_l2.h"
+#include <string.h>
 #include "xvidc.h"
 
 /************************** Constant Definitions *****************************/
+#define XV_MS_VFLTCOEFF_OFFSET(Chan) \
+	(XV_MULTI_SCALER_CTRL_ADDR_HWREG_MM_VFLTCOEFF_0_BASE + \
+	 (Chan) * XV_MULTI_SCALER_CTRL_ADDR_HWREG_MM_FLTCOEFF_OFFSET)
+#define XV_MS_HFLTCOEFF_OFFSET(Chan) \
+	(XV_MULTI_SCALER_CTRL_ADDR_HWREG_MM_HFLTCOEFF_0_BASE + \
+	 (Chan) * XV_MULTI_SCALER_CTRL_ADDR_HWREG_MM_FLTCOEFF_OFFSET)
+
+/*
+ * Orders the stores to a submitted job and its ring entry before the store to
+ * the queue head, and the interrupt handler reads of the head before its reads
+ * of the ring
+ */
+#ifdef __linux__
+#define XV_MS_QUEUE_SYNC __sync_synchronize()
+#else
+#define XV_MS_QUEUE_SYNC DATA_SYNC
+#endif
+
+/* Registers of a channel in XV_multi_scaler_Channel_Regs */
+#define XV_MS_CHANNEL_REGS 14
+
+/*
+ * Writes a channel register through its setter table, when the queue does not
+ * know its value or the value changes
+ */
+#define XV_MS_UPDATE_REG(Field, SetTable) \
+	do { \
+		if (!Known || (Shadow->Field != New->Field)) { \
+			SetTable[Chan](MscPtr, New->Field); \
+			Shadow->Field = New->Field; \
+			Writes++; \
+		} \
+	} while (0)
 
 /**************************** Type Definitions *******************************/
 
@@ -264,6 +298,16 @@ static const void (*XV_MS_Set_DstImgBuf1[XV_MAX_OUTS])(XV_multi_scaler
 /************************** Function Prototypes ******************************/
 static void XV_MultiScalerSetCoeff(XV_multi_scaler *MscPtr,
 				   XV_multi_scaler_Video_Config *MS_cfg);
+static const short *XV_MultiScalerGetCoeff(XV_multi_scaler *MscPtr,
+		u32 SizeIn, u32 SizeOut);
+static void XV_MultiScalerLoadCoeff(XV_multi_scaler *MscPtr,
+		u32 fltcoef_offset, const short *coeff);
+static void XV_MultiScalerCalcChannelRegs(XV_multi_scaler *InstancePtr,
+		XV_multi_scaler_Video_Config *MS_cfg,
+		XV_multi_scaler_Channel_Regs *RegsPtr);
+static u32 XV_MultiScalerQueueLoad(XV_multi_scaler_Queue *QueuePtr,
+		XV_multi_scaler_Job *JobPtr, u32 CoeffWritable);
+static void XV_MultiScalerQueueKick(XV_multi_scaler_Queue *QueuePtr);
 
 /*****************************************************************************/
 /**
@@ -344,30 +388,23 @@ void XV_MultiScalerSetNumOutputs(XV_multi_scaler *InstancePtr, u32 NumOuts)
 
 /*****************************************************************************/
 /**
-* This function programs the computed filter coefficients and phase data into
-* core registers
+* This function selects the fixed filter coefficients for a scaling ratio
 *
 * @param	MscPtr is a pointer to the core instance to be worked on.
-* @param	NumOut is the output channel number.
+* @param	SizeIn is the input width or height.
+* @param	SizeOut is the output width or height.
 *
-* @return None
+* @return The coefficients, XV_MULTISCALER_MAX_V_PHASES rows of
+*		XV_MULTISCALER_TAPS_12 taps
 *
 ******************************************************************************/
-static void XV_MultiScalerSetCoeff(XV_multi_scaler *MscPtr,
-		XV_multi_scaler_Video_Config *MS_cfg)
+static const short *XV_MultiScalerGetCoeff(XV_multi_scaler *MscPtr,
+		u32 SizeIn, u32 SizeOut)
 {
-	u32 num_phases = 1<<MscPtr->PhaseShift;
-	u32 num_taps	= MscPtr->NumTaps/2;
-	u32 val;
-	u32 i;
-	u32 j;
-	u32 baseAddr;
-	short *coeff;
-	u32 vfltcoef_offset;
-	u32 hfltcoef_offset;
+	const short *coeff;
 	float scale;
 
-	scale = (float)MS_cfg->HeightIn / MS_cfg->HeightOut;
+	scale = (float)SizeIn / SizeOut;
 	if ((scale >= 2) && (scale < 2.5))
 	{
 		if(MscPtr->NumTaps == 6)
@@ -415,73 +452,32 @@ static void XV_MultiScalerSetCoeff(XV_multi_scaler *MscPtr,
 	if(scale < 1)
 		coeff = &XV_multiscaler_fixedcoeff_taps6_12C[0][0];
 
-	vfltcoef_offset = XV_MULTI_SCALER_CTRL_ADDR_HWREG_MM_VFLTCOEFF_0_BASE +
-		MS_cfg->ChannelId *
-		XV_MULTI_SCALER_CTRL_ADDR_HWREG_MM_FLTCOEFF_OFFSET;
-
-	baseAddr = MscPtr->Ctrl_BaseAddress + vfltcoef_offset;
-	for (i = 0; i < num_phases; i++) {
-		for (j = 0; j < XV_MULTISCALER_TAPS_12; j = j + 2) {
-			val = (coeff[i * XV_MULTISCALER_TAPS_12 + (j + 1)] << 16) |
-				(coeff[i * XV_MULTISCALER_TAPS_12 + j] & 0x0000FFFF);
-			XV_multi_scaler_WriteReg(baseAddr,
-					((i * num_taps + j / 2) * 4), val);
-		}
-	}
-
-	scale = (float)MS_cfg->WidthIn / MS_cfg->WidthOut;
-	if ((scale >= 2) && (scale < 2.5))
-	{
-		if(MscPtr->NumTaps == 6)
-			coeff = &XV_multiscaler_fixedcoeff_taps6_6C[0][0];
-		else
-			coeff = &XV_multiscaler_fixedcoeff_taps8_12C[0][0];
-	}
-	if ((scale >= 2.5) && (scale < 3))
-	{
-		if(MscPtr->NumTaps >= 10)
-			coeff = &XV_multiscaler_fixedcoeff_taps10_12C[0][0];
-		else
-		{
-			if(MscPtr->NumTaps == 6)
-				coeff = &XV_multiscaler_fixedcoeff_taps6_6C[0][0];
-			else
-				coeff = &XV_multiscaler_fixedcoeff_taps8_8C[0][0];
-		}
-	}
-
-	if ((scale >= 3) && (scale < 3.5))
-		if(MscPtr->NumTaps == 12)
-			coeff = &XV_multiscaler_fixedcoeff_taps12_12C[0][0];
-		else
-		{
-			if(MscPtr->NumTaps == 6)
-				coeff = &XV_multiscaler_fixedcoeff_taps6_6C[0][0];
-			if(MscPtr->NumTaps == 8)
-				coeff = &XV_multiscaler_fixedcoeff_taps8_8C[0][0];
-			if(MscPtr->NumTaps == 10)
-				coeff = &XV_multiscaler_fixedcoeff_taps10_10C[0][0];
-		}
-
-	if ((scale >= 3.5) || (scale < 2 && scale >= 1))
-	{
-		if(MscPtr->NumTaps == 6)
-			coeff = &XV_multiscaler_fixedcoeff_taps6_6C[0][0];
-		if(MscPtr->NumTaps == 8)
-			coeff = &XV_multiscaler_fixedcoeff_taps8_8C[0][0];
-		if(MscPtr->NumTaps == 10)
-			coeff = &XV_multiscaler_fixedcoeff_taps10_10C[0][0];
-		if(MscPtr->NumTaps == 12)
-			coeff = &XV_multiscaler_fixedcoeff_taps12_12C[0][0];
-	}
-	if(scale < 1)
-		coeff = &XV_multiscaler_fixedcoeff_taps6_12C[0][0];
+	return coeff;
+}
 
-	hfltcoef_offset = XV_MULTI_SCALER_CTRL_ADDR_HWREG_MM_HFLTCOEFF_0_BASE +
-		MS_cfg->ChannelId *
-		XV_MULTI_SCALER_CTRL_ADDR_HWREG_MM_FLTCOEFF_OFFSET;
+/*****************************************************************************/
+/**
+* This function programs filter coefficients into a coefficient memory of the
+* core
+*
+* @param	MscPtr is a pointer to the core instance to be worked on.
+* @param	fltcoef_offset is the offset of the coefficient memory.
+* @param	coeff is the coefficients from XV_MultiScalerGetCoeff.
+*
+* @return None
+*
+******************************************************************************/
+static void XV_MultiScalerLoadCoeff(XV_multi_scaler *MscPtr,
+		u32 fltcoef_offset, const short *coeff)
+{
+	u32 num_phases = 1<<MscPtr->PhaseShift;
+	u32 num_taps	= MscPtr->NumTaps/2;
+	u32 val;
+	u32 i;
+	u32 j;
+	u32 baseAddr;
 
-	baseAddr = MscPtr->Ctrl_BaseAddress + hfltcoef_offset;
+	baseAddr = MscPtr->Ctrl_BaseAddress + fltcoef_offset;
 	for (i = 0; i < num_phases; i++) {
 		for (j = 0; j < XV_MULTISCALER_TAPS_12; j = j + 2) {
 			val = (coeff[i * XV_MULTISCALER_TAPS_12 + (j + 1)] << 16) |
@@ -492,6 +488,28 @@ static void XV_MultiScalerSetCoeff(XV_multi_scaler *MscPtr,
 	}
 }
 
+/*****************************************************************************/
+/**
+* This function programs the computed filter coefficients and phase data into
+* core registers
+*
+* @param	MscPtr is a pointer to the core instance to be worked on.
+* @param	NumOut is the output channel number.
+*
+* @return None
+*
+******************************************************************************/
+static void XV_MultiScalerSetCoeff(XV_multi_scaler *MscPtr,
+		XV_multi_scaler_Video_Config *MS_cfg)
+{
+	XV_MultiScalerLoadCoeff(MscPtr, XV_MS_VFLTCOEFF_OFFSET(MS_cfg->ChannelId),
+		XV_MultiScalerGetCoeff(MscPtr, MS_cfg->HeightIn,
+		MS_cfg->HeightOut));
+	XV_MultiScalerLoadCoeff(MscPtr, XV_MS_HFLTCOEFF_OFFSET(MS_cfg->ChannelId),
+		XV_MultiScalerGetCoeff(MscPtr, MS_cfg->WidthIn,
+		MS_cfg->WidthOut));
+}
+
 /*****************************************************************************/
 /**
 * This function reads the channel configuration. The ChannelId of the channel
@@ -535,20 +553,20 @@ void XV_MultiScalerGetChannelConfig(XV_multi_scaler *InstancePtr,
 
 /*****************************************************************************/
 /**
-* This function configures the scaler core registers with the specified
+* This function computes the register values of a channel from its
 * configuration parameters
 *
 * @param	InstancePtr is a pointer to the core instance to be worked on.
 * @param	MS_cfg is a pointer to the multi scaler config structure.
+* @param	RegsPtr is a pointer to the register values, filled on return.
 *
 * @return None
 *
 ******************************************************************************/
-void XV_MultiScalerSetChannelConfig(XV_multi_scaler *InstancePtr,
-	XV_multi_scaler_Video_Config *MS_cfg)
+static void XV_MultiScalerCalcChannelRegs(XV_multi_scaler *InstancePtr,
+		XV_multi_scaler_Video_Config *MS_cfg,
+		XV_multi_scaler_Channel_Regs *RegsPtr)
 {
-	u32 PixelRate;
-	u32 LineRate;
 	u32 i;
 	u16 Cfmt;
 	UINTPTR SrcImgBuf0;
@@ -590,7 +608,6 @@ void XV_MultiScalerSetChannelConfig(XV_multi_scaler *InstancePtr,
 		Xil_AssertVoid(MS_cfg->SrcImgBuf1 > (MS_cfg->DstImgBuf1 +
 			(MS_cfg->HeightOut * MS_cfg->OutStride)));
 	}
-	InstancePtr->OutBitMask |= 0x1 << i;
 	if (MS_cfg->CropWin.Crop) {
 		Xil_AssertVoid(MS_cfg->CropWin.StartY <= MS_cfg->HeightIn);
 		Xil_AssertVoid(MS_cfg->CropWin.StartX <= MS_cfg->WidthIn);
@@ -660,34 +677,424 @@ void XV_MultiScalerSetChannelConfig(XV_multi_scaler *InstancePtr,
 			+ ((MS_cfg->CropWin.StartX * buf0_numerator) / buf0_denominator);
 		SrcImgBuf1 += (MS_cfg->CropWin.StartY * MS_cfg->InStride)
 			+ ((MS_cfg->CropWin.StartX * buf1_numerator) / buf1_denominator);
-		XV_MS_Set_SrcImgBuf0[i](InstancePtr, SrcImgBuf0);
-		XV_MS_Set_SrcImgBuf1[i](InstancePtr, SrcImgBuf1);
-		PixelRate = (u32) ((float)(MS_cfg->CropWin.Width * STEP_PRECISION +
-			MS_cfg->WidthOut / 2) / MS_cfg->WidthOut);
-		LineRate = (u32) ((float)(MS_cfg->CropWin.Height * STEP_PRECISION +
-			MS_cfg->HeightOut / 2) / MS_cfg->HeightOut);
-		XV_MS_Set_HeightIn[i](InstancePtr, MS_cfg->CropWin.Height);
-		XV_MS_Set_WidthIn[i](InstancePtr, MS_cfg->CropWin.Width);
+		RegsPtr->SrcImgBuf0 = SrcImgBuf0;
+		RegsPtr->SrcImgBuf1 = SrcImgBuf1;
+		RegsPtr->PixelRate = (u32) ((float)(MS_cfg->CropWin.Width *
+			STEP_PRECISION + MS_cfg->WidthOut / 2) / MS_cfg->WidthOut);
+		RegsPtr->LineRate = (u32) ((float)(MS_cfg->CropWin.Height *
+			STEP_PRECISION + MS_cfg->HeightOut / 2) / MS_cfg->HeightOut);
+		RegsPtr->HeightIn = MS_cfg->CropWin.Height;
+		RegsPtr->WidthIn = MS_cfg->CropWin.Width;
 	} else {
-		XV_MS_Set_SrcImgBuf0[i](InstancePtr, MS_cfg->SrcImgBuf0);
-		XV_MS_Set_SrcImgBuf1[i](InstancePtr, MS_cfg->SrcImgBuf1);
-		PixelRate = (u32) ((float)(MS_cfg->WidthIn * STEP_PRECISION +
-			MS_cfg->WidthOut / 2) / MS_cfg->WidthOut);
-		LineRate = (u32) ((float)(MS_cfg->HeightIn * STEP_PRECISION +
-			MS_cfg->HeightOut / 2) / MS_cfg->HeightOut);
-		XV_MS_Set_HeightIn[i](InstancePtr, MS_cfg->HeightIn);
-		XV_MS_Set_WidthIn[i](InstancePtr, MS_cfg->WidthIn);
+		RegsPtr->SrcImgBuf0 = MS_cfg->SrcImgBuf0;
+		RegsPtr->SrcImgBuf1 = MS_cfg->SrcImgBuf1;
+		RegsPtr->PixelRate = (u32) ((float)(MS_cfg->WidthIn *
+			STEP_PRECISION + MS_cfg->WidthOut / 2) / MS_cfg->WidthOut);
+		RegsPtr->LineRate = (u32) ((float)(MS_cfg->HeightIn *
+			STEP_PRECISION + MS_cfg->HeightOut / 2) / MS_cfg->HeightOut);
+		RegsPtr->HeightIn = MS_cfg->HeightIn;
+		RegsPtr->WidthIn = MS_cfg->WidthIn;
 	}
+	RegsPtr->VCoeff = XV_MultiScalerGetCoeff(InstancePtr, MS_cfg->HeightIn,
+		MS_cfg->HeightOut);
+	RegsPtr->HCoeff = XV_MultiScalerGetCoeff(InstancePtr, MS_cfg->WidthIn,
+		MS_cfg->WidthOut);
+	RegsPtr->WidthOut = MS_cfg->WidthOut;
+	RegsPtr->HeightOut = MS_cfg->HeightOut;
+	RegsPtr->ColorFormatIn = MS_cfg->ColorFormatIn;
+	RegsPtr->ColorFormatOut = MS_cfg->ColorFormatOut;
+	RegsPtr->InStride = MS_cfg->InStride;
+	RegsPtr->OutStride = MS_cfg->OutStride;
+	RegsPtr->DstImgBuf0 = MS_cfg->DstImgBuf0;
+	RegsPtr->DstImgBuf1 = MS_cfg->DstImgBuf1;
+}
+
+
+/*****************************************************************************/
+/**
+* This function configures the scaler core registers with the specified
+* configuration parameters
+*
+* @param	InstancePtr is a pointer to the core instance to be worked on.
+* @param	MS_cfg is a pointer to the multi scaler config structure.
+*
+* @return None
+*
+******************************************************************************/
+void XV_MultiScalerSetChannelConfig(XV_multi_scaler *InstancePtr,
+	XV_multi_scaler_Video_Config *MS_cfg)
+{
+	XV_multi_scaler_Channel_Regs Regs;
+	u32 i;
+
+	/*
+	* Assert validates the input arguments
+	*/
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(MS_cfg != NULL);
+
+	XV_MultiScalerCalcChannelRegs(InstancePtr, MS_cfg, &Regs);
+
+	i = MS_cfg->ChannelId;
+	InstancePtr->OutBitMask |= 0x1 << i;
+	XV_MS_Set_SrcImgBuf0[i](InstancePtr, Regs.SrcImgBuf0);
+	XV_MS_Set_SrcImgBuf1[i](InstancePtr, Regs.SrcImgBuf1);
+	XV_MS_Set_HeightIn[i](InstancePtr, Regs.HeightIn);
+	XV_MS_Set_WidthIn[i](InstancePtr, Regs.WidthIn);
 	XV_MultiScalerSetCoeff(InstancePtr, MS_cfg);
-	XV_MS_Set_WidthOut[i](InstancePtr, MS_cfg->WidthOut);
-	XV_MS_Set_HeightOut[i](InstancePtr, MS_cfg->HeightOut);
-	XV_MS_Set_LineRate[i](InstancePtr, LineRate);
-	XV_MS_Set_PixelRate[i](InstancePtr, PixelRate);
-	XV_MS_Set_ColorFormatIn[i](InstancePtr, MS_cfg->ColorFormatIn);
-	XV_MS_Set_ColorFormatOut[i](InstancePtr, MS_cfg->ColorFormatOut);
-	XV_MS_Set_InStride[i](InstancePtr, MS_cfg->InStride);
-	XV_MS_Set_OutStride[i](InstancePtr, MS_cfg->OutStride);
-	XV_MS_Set_DstImgBuf0[i](InstancePtr, MS_cfg->DstImgBuf0);
-	XV_MS_Set_DstImgBuf1[i](InstancePtr, MS_cfg->DstImgBuf1);
+	XV_MS_Set_WidthOut[i](InstancePtr, Regs.WidthOut);
+	XV_MS_Set_HeightOut[i](InstancePtr, Regs.HeightOut);
+	XV_MS_Set_LineRate[i](InstancePtr, Regs.LineRate);
+	XV_MS_Set_PixelRate[i](InstancePtr, Regs.PixelRate);
+	XV_MS_Set_ColorFormatIn[i](InstancePtr, Regs.ColorFormatIn);
+	XV_MS_Set_ColorFormatOut[i](InstancePtr, Regs.ColorFormatOut);
+	XV_MS_Set_InStride[i](InstancePtr, Regs.InStride);
+	XV_MS_Set_OutStride[i](InstancePtr, Regs.OutStride);
+	XV_MS_Set_DstImgBuf0[i](InstancePtr, Regs.DstImgBuf0);
+	XV_MS_Set_DstImgBuf1[i](InstancePtr, Regs.DstImgBuf1);
+}
+
+/*****************************************************************************/
+/**
+* This function prepares a job from the configurations of its channels. The
+* register values are computed here, so that the job can be loaded quickly
+* and submitted again.
+*
+* @param	InstancePtr is a pointer to the core instance to be worked on.
+* @param	JobPtr is a pointer to the job to prepare.
+* @param	MS_cfg is an array of NumOuts channel configurations, covering
+*		the channels 0 to NumOuts - 1.
+* @param	NumOuts is the number of outputs of the batch.
+*
+* @return None
+*
+******************************************************************************/
+void XV_MultiScalerPrepareJob(XV_multi_scaler *InstancePtr,
+	XV_multi_scaler_Job *JobPtr, XV_multi_scaler_Video_Config *MS_cfg,
+	u32 NumOuts)
+{
+	u32 Mask = 0;
+	u32 i;
+
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(JobPtr != NULL);
+	Xil_AssertVoid(MS_cfg != NULL);
+	Xil_AssertVoid((NumOuts > 0) && (NumOuts <= InstancePtr->MaxOuts));
+
+	for (i = 0; i < NumOuts; i++) {
+		Xil_AssertVoid(MS_cfg[i].ChannelId < NumOuts);
+		XV_MultiScalerCalcChannelRegs(InstancePtr, &MS_cfg[i],
+			&JobPtr->Chan[MS_cfg[i].ChannelId]);
+		Mask |= 0x1 << MS_cfg[i].ChannelId;
+	}
+	Xil_AssertVoid(Mask ==
+		((u32)XV_MULTISCALER_OUTPUT_MASK >> (XV_MAX_OUTS - NumOuts)));
+
+	JobPtr->NumOuts = NumOuts;
+}
+
+/*****************************************************************************/
+/**
+* This function initializes a job queue. The registers of the channels are
+* unknown to the queue, so the first job writes all of them. The queue must
+* be initialized again if the channels are programmed outside of it.
+*
+* @param	QueuePtr is a pointer to the queue.
+* @param	InstancePtr is a pointer to the core instance to be worked on.
+* @param	Ring is an array of RingSize job pointers.
+* @param	RingSize is the maximum number of jobs in the queue, a power of
+*		two.
+* @param	GetTime is the time source of the job timestamps, or NULL.
+*
+* @return None
+*
+******************************************************************************/
+void XV_MultiScalerQueueInit(XV_multi_scaler_Queue *QueuePtr,
+	XV_multi_scaler *InstancePtr, XV_multi_scaler_Job **Ring,
+	u32 RingSize, XVMultiScaler_TimeFn GetTime)
+{
+	Xil_AssertVoid(QueuePtr != NULL);
+	Xil_AssertVoid(InstancePtr != NULL);
+	Xil_AssertVoid(Ring != NULL);
+	Xil_AssertVoid((RingSize != 0) && !(RingSize & (RingSize - 1)));
+
+	memset(QueuePtr, 0, sizeof(XV_multi_scaler_Queue));
+	QueuePtr->MscPtr = InstancePtr;
+	QueuePtr->Ring = Ring;
+	QueuePtr->RingSize = RingSize;
+	QueuePtr->GetTime = GetTime;
+
+	XV_multi_scaler_InterruptEnable(InstancePtr,
+		XV_MULTI_SCALER_ISR_DONE_BIT_MASK |
+		XV_MULTI_SCALER_ISR_READY_BIT_MASK);
+	XV_multi_scaler_InterruptGlobalEnable(InstancePtr);
+}
+
+/*****************************************************************************/
+/**
+* This function installs the callback called when a job of the queue is
+* done, from the interrupt handler.
+*
+* @param	QueuePtr is a pointer to the queue.
+* @param	CallbackFunc is the callback function.
+* @param	CallbackRef is passed to the callback function.
+*
+* @return None
+*
+******************************************************************************/
+void XV_MultiScalerQueueSetCallback(XV_multi_scaler_Queue *QueuePtr,
+	XVMultiScaler_JobCallback CallbackFunc, void *CallbackRef)
+{
+	Xil_AssertVoid(QueuePtr != NULL);
+	Xil_AssertVoid(CallbackFunc != NULL);
+
+	QueuePtr->JobDoneCallback = CallbackFunc;
+	QueuePtr->CallbackRef = CallbackRef;
+}
+
+/*****************************************************************************/
+/**
+* This function writes the registers of a job that differ from the ones the
+* queue wrote before.
+*
+* @param	QueuePtr is a pointer to the queue.
+* @param	JobPtr is a pointer to the job to load.
+* @param	CoeffWritable is TRUE when the core is idle, so that the
+*		coefficient memories can be written.
+*
+* @return TRUE if the job is loaded, FALSE if it needs other coefficients
+*	  while the core is running.
+*
+******************************************************************************/
+static u32 XV_MultiScalerQueueLoad(XV_multi_scaler_Queue *QueuePtr,
+		XV_multi_scaler_Job *JobPtr, u32 CoeffWritable)
+{
+	XV_multi_scaler *MscPtr = QueuePtr->MscPtr;
+	XV_multi_scaler_Channel_Regs *Shadow;
+	XV_multi_scaler_Channel_Regs *New;
+	u32 Known;
+	u32 Writes = 0;
+	u32 Loads = 0;
+	u32 Chan;
+
+	if (!CoeffWritable) {
+		for (Chan = 0; Chan < JobPtr->NumOuts; Chan++) {
+			Shadow = &QueuePtr->Shadow[Chan];
+			New = &JobPtr->Chan[Chan];
+			if (!(QueuePtr->KnownMask & (0x1 << Chan)) ||
+			    (Shadow->VCoeff != New->VCoeff) ||
+			    (Shadow->HCoeff != New->HCoeff))
+				return FALSE;
+		}
+	}
+
+	if (JobPtr->NumOuts != QueuePtr->NumOuts) {
+		XV_multi_scaler_Set_HwReg_num_outs(MscPtr, JobPtr->NumOuts);
+		QueuePtr->NumOuts = JobPtr->NumOuts;
+	}
+
+	for (Chan = 0; Chan < JobPtr->NumOuts; Chan++) {
+		Known = QueuePtr->KnownMask & (0x1 << Chan);
+		Shadow = &QueuePtr->Shadow[Chan];
+		New = &JobPtr->Chan[Chan];
+
+		XV_MS_UPDATE_REG(SrcImgBuf0, XV_MS_Set_SrcImgBuf0);
+		XV_MS_UPDATE_REG(SrcImgBuf1, XV_MS_Set_SrcImgBuf1);
+		XV_MS_UPDATE_REG(HeightIn, XV_MS_Set_HeightIn);
+		XV_MS_UPDATE_REG(WidthIn, XV_MS_Set_WidthIn);
+		XV_MS_UPDATE_REG(WidthOut, XV_MS_Set_WidthOut);
+		XV_MS_UPDATE_REG(HeightOut, XV_MS_Set_HeightOut);
+		XV_MS_UPDATE_REG(LineRate, XV_MS_Set_LineRate);
+		XV_MS_UPDATE_REG(PixelRate, XV_MS_Set_PixelRate);
+		XV_MS_UPDATE_REG(ColorFormatIn, XV_MS_Set_ColorFormatIn);
+		XV_MS_UPDATE_REG(ColorFormatOut, XV_MS_Set_ColorFormatOut);
+		XV_MS_UPDATE_REG(InStride, XV_MS_Set_InStride);
+		XV_MS_UPDATE_REG(OutStride, XV_MS_Set_OutStride);
+		XV_MS_UPDATE_REG(DstImgBuf0, XV_MS_Set_DstImgBuf0);
+		XV_MS_UPDATE_REG(DstImgBuf1, XV_MS_Set_DstImgBuf1);
+
+		if (!Known || (Shadow->VCoeff != New->VCoeff)) {
+			XV_MultiScalerLoadCoeff(MscPtr,
+				XV_MS_VFLTCOEFF_OFFSET(Chan), New->VCoeff);
+			Shadow->VCoeff = New->VCoeff;
+			Loads++;
+		}
+		if (!Known || (Shadow->HCoeff != New->HCoeff)) {
+			XV_MultiScalerLoadCoeff(MscPtr,
+				XV_MS_HFLTCOEFF_OFFSET(Chan), New->HCoeff);
+			Shadow->HCoeff = New->HCoeff;
+			Loads++;
+		}
+		QueuePtr->KnownMask |= 0x1 << Chan;
+	}
+
+	JobPtr->RegWrites = Writes;
+	JobPtr->CoeffLoads = Loads;
+	QueuePtr->Stats.RegWrites += Writes;
+	QueuePtr->Stats.RegSkips += JobPtr->NumOuts * XV_MS_CHANNEL_REGS - Writes;
+	QueuePtr->Stats.CoeffLoads += Loads;
+
+	return TRUE;
+}
+
+/*****************************************************************************/
+/**
+* This function loads the next waiting job while the core is idle, and starts
+* the core in auto restart.
+*
+* @param	QueuePtr is a pointer to the queue.
+*
+* @return None
+*
+******************************************************************************/
+static void XV_MultiScalerQueueKick(XV_multi_scaler_Queue *QueuePtr)
+{
+	XV_multi_scaler_Job *JobPtr;
+
+	JobPtr = QueuePtr->Ring[QueuePtr->Loaded & (QueuePtr->RingSize - 1)];
+	(void)XV_MultiScalerQueueLoad(QueuePtr, JobPtr, TRUE);
+	QueuePtr->Loaded++;
+	QueuePtr->Active = TRUE;
+
+	XV_multi_scaler_EnableAutoRestart(QueuePtr->MscPtr);
+	XV_multi_scaler_Start(QueuePtr->MscPtr);
+}
+
+/*****************************************************************************/
+/**
+* This function submits a prepared job to the queue. The core is started if it
+* is idle, else the job is chained after the jobs already submitted.
+*
+* @param	QueuePtr is a pointer to the queue.
+* @param	JobPtr is a pointer to the job, prepared with
+*		XV_MultiScalerPrepareJob.
+*
+* @return XST_SUCCESS if the job is queued, XST_FAILURE if the queue is full.
+*
+******************************************************************************/
+int XV_MultiScalerQueueSubmit(XV_multi_scaler_Queue *QueuePtr,
+	XV_multi_scaler_Job *JobPtr)
+{
+	Xil_AssertNonvoid(QueuePtr != NULL);
+	Xil_AssertNonvoid(JobPtr != NULL);
+	Xil_AssertNonvoid(JobPtr->NumOuts != 0);
+
+	if ((QueuePtr->Head - QueuePtr->Done) == QueuePtr->RingSize)
+		return XST_FAILURE;
+
+	JobPtr->SubmitTime = QueuePtr->GetTime ? QueuePtr->GetTime() : 0;
+	JobPtr->StartTime = 0;
+	JobPtr->DoneTime = 0;
+	QueuePtr->Ring[QueuePtr->Head & (QueuePtr->RingSize - 1)] = JobPtr;
+	/* The interrupt handler may load the job as soon as Head moves */
+	XV_MS_QUEUE_SYNC;
+	QueuePtr->Head++;
+
+	if (!QueuePtr->Active)
+		XV_MultiScalerQueueKick(QueuePtr);
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* This function is the interrupt handler of the multi scaler core when it runs
+* a job queue, in place of XV_MultiScalerIntrHandler.
+*
+* On ready, the core has read the registers of the last loaded job, so the
+* next waiting job is loaded for the auto restart, or the auto restart is
+* disabled if there is none or it needs other coefficients. On done, the
+* oldest job is completed, and the core is started again if it stopped with
+* jobs waiting.
+*
+* @param	QueuePtr is a pointer to the queue.
+*
+* @return None
+*
+******************************************************************************/
+void *XV_MultiScalerQueueIntrHandler(void *QueuePtr)
+{
+	XV_multi_scaler_Queue *Queue = (XV_multi_scaler_Queue *)QueuePtr;
+	XV_multi_scaler_Job *JobPtr;
+	u32 Mask = Queue->RingSize - 1;
+	u64 Now;
+	u64 Latency;
+	u32 Status;
+
+	/* Verify arguments */
+	Xil_AssertNonvoid(Queue != NULL);
+	Xil_AssertNonvoid(Queue->MscPtr->IsReady == XIL_COMPONENT_IS_READY);
+
+	Status = XV_multi_scaler_InterruptGetStatus(Queue->MscPtr);
+	if (!Status)
+		return NULL;
+	XV_multi_scaler_InterruptClear(Queue->MscPtr, Status &
+		(XV_MULTI_SCALER_ISR_DONE_BIT_MASK |
+		 XV_MULTI_SCALER_ISR_READY_BIT_MASK));
+	Now = Queue->GetTime ? Queue->GetTime() : 0;
+	XV_MS_QUEUE_SYNC;
+
+	/* A batch done with the next one ready is handled in start order */
+	if ((Status & XV_MULTI_SCALER_ISR_READY_BIT_MASK) &&
+	    (Queue->Started != Queue->Loaded)) {
+		Queue->Ring[Queue->Started & Mask]->StartTime = Now;
+		Queue->Started++;
+
+		if ((Queue->Loaded != Queue->Head) &&
+		    XV_MultiScalerQueueLoad(Queue,
+			Queue->Ring[Queue->Loaded & Mask], FALSE)) {
+			Queue->Loaded++;
+			Queue->Stats.Chained++;
+		} else {
+			XV_multi_scaler_DisableAutoRestart(Queue->MscPtr);
+		}
+	}
+
+	if ((Status & XV_MULTI_SCALER_ISR_DONE_BIT_MASK) &&
+	    (Queue->Done != Queue->Started)) {
+		JobPtr = Queue->Ring[Queue->Done & Mask];
+		JobPtr->DoneTime = Now;
+		Queue->Done++;
+
+		Latency = Now - JobPtr->SubmitTime;
+		Queue->Stats.Jobs++;
+		Queue->Stats.LastLatency = Latency;
+		Queue->Stats.TotalLatency += Latency;
+		if (Latency > Queue->Stats.MaxLatency)
+			Queue->Stats.MaxLatency = Latency;
+
+		/* The core stops when no job was loaded for the restart */
+		if (Queue->Done == Queue->Loaded) {
+			if (Queue->Loaded != Queue->Head)
+				XV_MultiScalerQueueKick(Queue);
+			else
+				Queue->Active = FALSE;
+		}
+
+		if (Queue->JobDoneCallback)
+			Queue->JobDoneCallback(Queue->CallbackRef, JobPtr);
+	}
+
+	return NULL;
+}
+
+/*****************************************************************************/
+/**
+* This function returns the counters of a job queue. The latencies are in the
+* unit of the time function of the queue.
+*
+* @param	QueuePtr is a pointer to the queue.
+* @param	StatsPtr is a pointer to the counters, filled on return.
+*
+* @return None
+*
+******************************************************************************/
+void XV_MultiScalerQueueGetStats(XV_multi_scaler_Queue *QueuePtr,
+	XV_multi_scaler_Queue_Stats *StatsPtr)
+{
+	Xil_AssertVoid(QueuePtr != NULL);
+	Xil_AssertVoid(StatsPtr != NULL);
+
+	*StatsPtr = QueuePtr->Stats;
 }
 /** @} */
@@ -26,10 +26,32 @@
 * This driver supports Virtual Memory. The RTOS is responsible for calculating
 * the correct device base address in Virtual Memory space.
 *
+* <b> Job Queue </b>
+*
+* XV_MultiScalerPrepareJob computes the register values of a batch of channel
+* configurations once, including the selection of the fixed coefficients of
+* xv_multi_scaler_coeff.c. The prepared jobs are submitted to a queue with
+* XV_MultiScalerQueueSubmit, and XV_MultiScalerQueueIntrHandler is connected to
+* the interrupt system instead of XV_MultiScalerIntrHandler.
+*
+* The queue keeps a copy of the channel registers it wrote, and only writes
+* the registers a job changes. The core reads its scalar registers when it
+* starts a batch and then signals ready, so on the ready interrupt the next
+* job is written and the core, left in auto restart, chains to it when the
+* current batch is done. The coefficient memories are read during the whole
+* batch, so a job that changes coefficients waits for the done interrupt and
+* is started once the core is idle. The ready interrupt must be serviced
+* before the running batch completes.
+*
+* Each job records when it was submitted, started and done, using the time
+* function given to XV_MultiScalerQueueInit, and XV_MultiScalerQueueGetStats
+* reports the queue counters and the submit to done latency.
+*
 * <b> Threads </b>
 *
 * This driver is not thread safe. Any needs for threads or thread mutual
-* exclusion must be satisfied by the layer above this driver.
+* exclusion must be satisfied by the layer above this driver. Jobs may be
+* submitted from the job done callback.
 *
 * <b>Limitations</b>
 *
@@ -123,6 +145,84 @@ typedef struct {
 	XV_multi_scaler_Crop_Window CropWin;
 } XV_multi_scaler_Video_Config;
 
+/**
+ * Register values of a channel, as written by XV_MultiScalerSetChannelConfig
+ */
+typedef struct {
+	u32 WidthIn;
+	u32 WidthOut;
+	u32 HeightIn;
+	u32 HeightOut;
+	u32 LineRate;
+	u32 PixelRate;
+	u32 ColorFormatIn;
+	u32 ColorFormatOut;
+	u32 InStride;
+	u32 OutStride;
+	u64 SrcImgBuf0;
+	u64 SrcImgBuf1;
+	u64 DstImgBuf0;
+	u64 DstImgBuf1;
+	const short *VCoeff;	/**< Vertical fixed coefficients */
+	const short *HCoeff;	/**< Horizontal fixed coefficients */
+} XV_multi_scaler_Channel_Regs;
+
+/**
+ * Prepared batch of channel configurations. The job belongs to the queue from
+ * its submission until its done callback.
+ */
+typedef struct {
+	u32 NumOuts;		/**< Number of outputs of the batch */
+	XV_multi_scaler_Channel_Regs Chan[XV_MAX_OUTS];
+	u32 RegWrites;		/**< Registers written to load the job */
+	u32 CoeffLoads;		/**< Coefficient memories written */
+	u64 SubmitTime;		/**< Time of the submission */
+	u64 StartTime;		/**< Time the core took the job */
+	u64 DoneTime;		/**< Time the core completed the job */
+	void *UserData;		/**< For the application */
+} XV_multi_scaler_Job;
+
+typedef u64 (*XVMultiScaler_TimeFn)(void);
+typedef void (*XVMultiScaler_JobCallback)(void *CallbackRef,
+	XV_multi_scaler_Job *JobPtr);
+
+/**
+ * Counters of a job queue
+ */
+typedef struct {
+	u32 Jobs;		/**< Completed jobs */
+	u32 Chained;		/**< Jobs started by the auto restart */
+	u32 RegWrites;		/**< Channel registers written */
+	u32 RegSkips;		/**< Channel registers left unchanged */
+	u32 CoeffLoads;		/**< Coefficient memories written */
+	u64 LastLatency;	/**< Submit to done time of the last job */
+	u64 MaxLatency;		/**< Worst submit to done time */
+	u64 TotalLatency;	/**< Sum of the submit to done times */
+} XV_multi_scaler_Queue_Stats;
+
+/**
+ * Job queue of a multi scaler core. Free running counters index the ring:
+ * the jobs from Done to Started are in the core, from Started to Loaded are
+ * written to the registers, and from Loaded to Head wait.
+ */
+typedef struct {
+	XV_multi_scaler *MscPtr;	/**< Core instance */
+	XV_multi_scaler_Job **Ring;	/**< Jobs, RingSize entries */
+	u32 RingSize;			/**< Power of two */
+	volatile u32 Head;		/**< Submitted jobs */
+	volatile u32 Loaded;		/**< Jobs written to the registers */
+	volatile u32 Started;		/**< Jobs taken by the core */
+	volatile u32 Done;		/**< Completed jobs */
+	volatile u32 Active;		/**< Core running for the queue */
+	u32 NumOuts;			/**< Written number of outputs */
+	u8 KnownMask;			/**< Channels with known registers */
+	XV_multi_scaler_Channel_Regs Shadow[XV_MAX_OUTS];
+	XVMultiScaler_TimeFn GetTime;	/**< Time source, may be NULL */
+	XVMultiScaler_JobCallback JobDoneCallback;
+	void *CallbackRef;
+	XV_multi_scaler_Queue_Stats Stats;
+} XV_multi_scaler_Queue;
+
 /*extern const short XV_multiscaler_fixedcoeff_taps6[XV_MULTISCALER_MAX_V_PHASES]
 	[XV_MULTISCALER_TAPS_12];
 extern const short XV_multiscaler_fixedcoeff_taps8[XV_MULTISCALER_MAX_V_PHASES]
@@ -155,6 +255,19 @@ void XV_MultiScalerGetChannelConfig(XV_multi_scaler  *InstancePtr,
 	XV_multi_scaler_Video_Config *multi_scaler_cfg);
 void XV_MultiScalerSetChannelConfig(XV_multi_scaler  *InstancePtr,
 	XV_multi_scaler_Video_Config *multi_scaler_cfg);
+void XV_MultiScalerPrepareJob(XV_multi_scaler *InstancePtr,
+	XV_multi_scaler_Job *JobPtr, XV_multi_scaler_Video_Config *MS_cfg,
+	u32 NumOuts);
+void XV_MultiScalerQueueInit(XV_multi_scaler_Queue *QueuePtr,
+	XV_multi_scaler *InstancePtr, XV_multi_scaler_Job **Ring,
+	u32 RingSize, XVMultiScaler_TimeFn GetTime);
+void XV_MultiScalerQueueSetCallback(XV_multi_scaler_Queue *QueuePtr,
+	XVMultiScaler_JobCallback CallbackFunc, void *CallbackRef);
+int XV_MultiScalerQueueSubmit(XV_multi_scaler_Queue *QueuePtr,
+	XV_multi_scaler_Job *JobPtr);
+void *XV_MultiScalerQueueIntrHandler(void *QueuePtr);
+void XV_MultiScalerQueueGetStats(XV_multi_scaler_Queue *QueuePtr,
+	XV_multi_scaler_Queue_Stats *StatsPtr);
 
 #ifdef __cplusplus
 }
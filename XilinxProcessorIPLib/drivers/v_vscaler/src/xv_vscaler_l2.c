@@ -27,6 +27,7 @@
 *       rco   02/09/17   Fix c++ compilation warnings
 *	jsr   09/07/18 Fix for 64-bit driver support
 * 3.1   vsa   04/07/20   Improve quality with new coefficients
+* 3.2   jb    10/18/26   Added the bank cache of the coefficients
 *
 * </pre>
 *
@@ -59,6 +60,10 @@ extern const short XV_vscaler_fixedcoeff_taps10_ScalingRatio4[XV_VSCALER_MAX_V_P
 extern const short XV_vscaler_fixedcoeff_taps12_ScalingRatio4[XV_VSCALER_MAX_V_PHASES][XV_VSCALER_TAPS_12];
 
 /************************** Function Prototypes ******************************/
+static const short *XV_VScalerGetCoeff(XV_Vscaler_l2 *InstancePtr,
+                                       u32 HeightIn,
+                                       u32 HeightOut,
+                                       u16 *NumTapsPtr);
 static void XV_VScalerSelectCoeff(XV_Vscaler_l2 *InstancePtr,
 		                          u32 HeightIn,
 		                          u32 HeightOut);
@@ -123,32 +128,27 @@ void XV_VScalerStop(XV_Vscaler_l2 *InstancePtr)
 
 /*****************************************************************************/
 /**
-* This function loads default filter coefficients in the scaler coefficient
-* storage based on the selected TAP configuration
+* This function determines the default filter coefficient table based on the
+* selected TAP configuration
 *
 * @param  InstancePtr is a pointer to the core instance to be worked on.
-* @param  WidthIn is the input stream height
-* @param  Widthout is the output stream height
-
-* @return None
+* @param  HeightIn is the input stream height
+* @param  HeightOut is the output stream height
+* @param  NumTapsPtr is the number of taps of the table, set on return
+*
+* @return The coefficient table, NULL if the taps of the core are not supported
 *
 ******************************************************************************/
-static void XV_VScalerSelectCoeff(XV_Vscaler_l2 *InstancePtr,
-		                          u32 HeightIn,
-		                          u32 HeightOut)
+static const short *XV_VScalerGetCoeff(XV_Vscaler_l2 *InstancePtr,
+                                       u32 HeightIn,
+                                       u32 HeightOut,
+                                       u16 *NumTapsPtr)
 {
   const short *coeff;
-  u16 numTaps, numPhases;
+  u16 numTaps;
   u16 ScalingRatio;
   u16 IsScaleDown;
 
-  /*
-   * validates input arguments
-   */
-  Xil_AssertVoid(InstancePtr != NULL);
-
-  numPhases = (1<<InstancePtr->Vsc.Config.PhaseShift);
-
   IsScaleDown = (HeightOut < HeightIn);
   /* Scale Down Mode will use dynamic filter selection logic
    * Scale Up Mode (including 1:1) will always use 6 tap filter
@@ -224,7 +224,7 @@ static void XV_VScalerSelectCoeff(XV_Vscaler_l2 *InstancePtr,
 	break;
 
 	default:
-		return;
+		return NULL;
 	}
   }
   else //Scale Up
@@ -233,6 +233,42 @@ static void XV_VScalerSelectCoeff(XV_Vscaler_l2 *InstancePtr,
 	numTaps = XV_VSCALER_TAPS_6;
   }
 
+  *NumTapsPtr = numTaps;
+  return coeff;
+}
+
+/*****************************************************************************/
+/**
+* This function loads default filter coefficients in the scaler coefficient
+* storage based on the selected TAP configuration
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+* @param  WidthIn is the input stream height
+* @param  Widthout is the output stream height
+
+* @return None
+*
+******************************************************************************/
+static void XV_VScalerSelectCoeff(XV_Vscaler_l2 *InstancePtr,
+		                          u32 HeightIn,
+		                          u32 HeightOut)
+{
+  const short *coeff;
+  u16 numTaps, numPhases;
+
+  /*
+   * validates input arguments
+   */
+  Xil_AssertVoid(InstancePtr != NULL);
+
+  numPhases = (1<<InstancePtr->Vsc.Config.PhaseShift);
+
+  coeff = XV_VScalerGetCoeff(InstancePtr, HeightIn, HeightOut, &numTaps);
+  if(coeff == NULL)
+  {
+    return;
+  }
+
   XV_VScalerLoadExtCoeff(InstancePtr,
 		                 numPhases,
 		                 numTaps,
@@ -282,6 +318,9 @@ void XV_VScalerLoadExtCoeff(XV_Vscaler_l2 *InstancePtr,
 	     return;
   }
 
+  /* The coefficient bank no longer matches the coefficient storage */
+  InstancePtr->CoeffBank = NULL;
+
   //determine if coefficient needs padding (effective vs. max taps)
   pad = XV_VSCALER_MAX_V_TAPS - num_taps;
   offset = ((pad) ? (pad>>1) : 0);
@@ -374,6 +413,8 @@ int XV_VScalerSetup(XV_Vscaler_l2  *InstancePtr,
                     u32            ColorFormat)
 {
   u32 LineRate;
+  const short *coeff;
+  u16 numTaps;
 
   /*
    * Assert validates the input arguments
@@ -389,7 +430,35 @@ int XV_VScalerSetup(XV_Vscaler_l2  *InstancePtr,
     return(XST_FAILURE);
   }
 
-  if(InstancePtr->Vsc.Config.ScalerType == XV_VSCALER_POLYPHASE)
+  if((InstancePtr->Vsc.Config.ScalerType == XV_VSCALER_POLYPHASE) &&
+     InstancePtr->UseBankCache)
+  {
+    if(InstancePtr->UseExtCoeff) //User defined coefficients
+    {
+      coeff = &InstancePtr->coeff[0][0];
+    }
+    else
+    {
+      /* Load the coefficient table only if it changed */
+      coeff = XV_VScalerGetCoeff(InstancePtr, HeightIn, HeightOut, &numTaps);
+      if(coeff && (coeff != InstancePtr->CoeffBank))
+      {
+        XV_VScalerLoadExtCoeff(InstancePtr,
+                               (1<<InstancePtr->Vsc.Config.PhaseShift),
+                               numTaps,
+                               coeff);
+        InstancePtr->UseExtCoeff = FALSE;
+      }
+    }
+
+    if(!coeff || (coeff != InstancePtr->CoeffBank))
+    {
+      /* Program coefficients into the IP register bank */
+      XV_VScalerSetCoeff(InstancePtr);
+      InstancePtr->CoeffBank = coeff;
+    }
+  }
+  else if(InstancePtr->Vsc.Config.ScalerType == XV_VSCALER_POLYPHASE)
   {
     if(!InstancePtr->UseExtCoeff) //No user defined coefficients
     {
@@ -412,6 +481,43 @@ int XV_VScalerSetup(XV_Vscaler_l2  *InstancePtr,
   return XST_SUCCESS;
 }
 
+/*****************************************************************************/
+/**
+* This function enables or disables the bank cache of the instance. When
+* enabled, XV_VScalerSetup writes the coefficient bank of the core only when
+* the coefficients change.
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+* @param  Enable is TRUE to enable the cache, FALSE to disable it
+*
+* @return None
+*
+******************************************************************************/
+void XV_VScalerSetBankCache(XV_Vscaler_l2 *InstancePtr, u8 Enable)
+{
+  Xil_AssertVoid(InstancePtr != NULL);
+
+  InstancePtr->UseBankCache = Enable;
+  XV_VScalerInvalidateBanks(InstancePtr);
+}
+
+/*****************************************************************************/
+/**
+* This function forgets the content of the coefficient bank of the core, so
+* that the next setup writes it again
+*
+* @param  InstancePtr is a pointer to the core instance to be worked on.
+*
+* @return None
+*
+******************************************************************************/
+void XV_VScalerInvalidateBanks(XV_Vscaler_l2 *InstancePtr)
+{
+  Xil_AssertVoid(InstancePtr != NULL);
+
+  InstancePtr->CoeffBank = NULL;
+}
+
 /*****************************************************************************/
 /**
 *
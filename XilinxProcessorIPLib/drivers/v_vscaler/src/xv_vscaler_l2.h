@@ -53,6 +53,16 @@
 * This driver supports Virtual Memory. The RTOS is responsible for calculating
 * the correct device base address in Virtual Memory space.
 *
+* <b> Bank Cache </b>
+*
+* XV_VScalerSetup() selects the filter coefficients for the scaling ratio and
+* writes the coefficient bank of the core. With XV_VScalerSetBankCache(), the
+* bank is only written when the selected coefficients differ from the ones
+* already loaded, which saves the register writes of a resolution switch
+* between modes of the same scaling ratio class. The bank is not cleared by a
+* reset of the core. If the core lost its configuration,
+* XV_VScalerInvalidateBanks() forces the next setup to write it again.
+*
 * <b> Threads </b>
 *
 * This driver is not thread safe. Any needs for threads or thread mutual
@@ -69,6 +79,7 @@
 * 2.00  rco   11/05/15   Integrate layer-1 with layer-2
 * 3.0   mpe   04/28/16   Added optional color format conversion handling
 * 3.1   vsa   04/07/20   Improve quality with new coefficients
+* 3.2   jb    10/18/26   Added the bank cache of the coefficients
 *
 * </pre>
 *
@@ -124,6 +135,9 @@ typedef struct
   XV_vscaler Vsc; /*<< Layer 1 instance */
   u8 UseExtCoeff;
   short coeff[XV_VSCALER_MAX_V_PHASES][XV_VSCALER_MAX_V_TAPS];
+  u8 UseBankCache;         /**< Write the banks only when they change */
+  const short *CoeffBank;  /**< Coefficients loaded in the core, NULL if
+                                unknown */
 }XV_Vscaler_l2;
 
 /************************** Macros Definitions *******************************/
@@ -154,6 +168,8 @@ int XV_VScalerSetup(XV_Vscaler_l2  *InstancePtr,
                     u32 HeightOut,
                     u32 ColorFormat);
 void XV_VScalerDbgReportStatus(XV_Vscaler_l2 *InstancePtr);
+void XV_VScalerSetBankCache(XV_Vscaler_l2 *InstancePtr, u8 Enable);
+void XV_VScalerInvalidateBanks(XV_Vscaler_l2 *InstancePtr);
 
 #ifdef __cplusplus
 }
@@ -18,6 +18,8 @@ int XV_warp_init_CfgInitialize(XV_warp_init *InstancePtr, XV_warp_init_Config *C
 
     InstancePtr->RemapVectorDesc_BaseAddr = 0;
     InstancePtr->NumDescriptors = 0;
+    InstancePtr->DescTable = NULL;
+    InstancePtr->ArbParams = NULL;
 
     return XST_SUCCESS;
 }
@@ -57,6 +57,8 @@ typedef struct {
     void *CallbackRef;
     UINTPTR RemapVectorDesc_BaseAddr;
     u32 NumDescriptors;
+    UINTPTR *DescTable;     /* Descriptor addresses, by descriptor number */
+    void *ArbParams;        /* Arbitrary warp buffers, by descriptor number */
 } XV_warp_init;
 
 typedef u32 word_type;
@@ -30,10 +30,17 @@ static void XVWarpInit_aligned_free(void * ptr);
 static void XVWarpInit_OneTimeCalcs(XVWarpInitVector_Hw *initvector_hw, int *h);
 static void XVWarpInit_OnetimeCalcsArbt(XVWarpInit_ArbParam *arbitrary_param,
 					unsigned short fr_width, unsigned short fr_height);
+static void XVWarpInit_ArbtColSpline(XVWarpInit_ArbParam *arbitrary_param,
+		u32 col, unsigned short fr_height);
+static void XVWarpInit_ArbtRowSpline(XVWarpInit_ArbParam *arbitrary_param,
+		u32 row, unsigned short fr_width);
 static void XVWarpInit_SetDescriptor(XVWarpInitVector_Hw_Aligned *descptr,
 		XVWarpInitVector_Hw *initvector_hw);
-static void XVWarpInit_AllocArbMem(XVWarpInit_ArbParam *arbitrary_param,
+static int XVWarpInit_AllocArbMem(XVWarpInit_ArbParam *arbitrary_param,
 		int grid_size, u16 fr_width, u16 fr_height);
+static void XVWarpInit_FreeArbMem(XVWarpInit_ArbParam *arbitrary_param);
+static int XVWarpInit_CheckMeshPoint(XVWarpInit_ArbParam_MeshInfo *ctrl_pt,
+		short seg_w, short seg_h);
 static int XVWarpInit_ParseMeshInfo(XVWarpInit_ArbParam *arbitrary_param,
 		XVWarpInit_ArbParam_MeshInfo *ctrl_pts,
 		short fr_width, short fr_height);
@@ -62,13 +69,15 @@ void XVWarpInit_EnableInterrupts(XV_warp_init *InstancePtr,
 
 /*****************************************************************************/
 /**
-* This function creates the descriptors.
+* This function creates the descriptors. The descriptors created by a
+* previous call are freed first.
 *
 * @param  InstancePtr is a pointer to core instance to be worked upon
 * @param  num_desc is the number of descriptors to be created
 *
 * @return XST_SUCCESS if Descriptors created successfully
-*         XST_FAILURE if Descriptors creation failed
+*         XST_FAILURE if Descriptors creation failed, no descriptor is left
+*         allocated in that case
 *
 ******************************************************************************/
 int XVWarpInit_SetNumOfDescriptors(XV_warp_init *InstancePtr,
@@ -79,13 +88,40 @@ int XVWarpInit_SetNumOfDescriptors(XV_warp_init *InstancePtr,
 
 	Xil_AssertNonvoid(InstancePtr);
 
+	if (InstancePtr->NumDescriptors != 0)
+		XVWarpInit_ClearNumOfDescriptors(InstancePtr);
+
+	if (num_desc == 0)
+		return XST_FAILURE;
+
+	InstancePtr->DescTable = (UINTPTR *)malloc(sizeof(UINTPTR) * num_desc);
+	InstancePtr->ArbParams = calloc(num_desc, sizeof(XVWarpInit_ArbParam));
+	if (InstancePtr->DescTable == NULL || InstancePtr->ArbParams == NULL) {
+		free(InstancePtr->DescTable);
+		free(InstancePtr->ArbParams);
+		InstancePtr->DescTable = NULL;
+		InstancePtr->ArbParams = NULL;
+		return XST_FAILURE;
+	}
+
 	for (descnum = 0; descnum < num_desc; descnum++)
 	{
 		currptr = XVWarpInit_aligned_malloc(InstancePtr->config->axi_mm_data_width/8,
 				sizeof(XVWarpInitVector_Hw_Aligned));
-		if (currptr == NULL)
+		if (currptr == NULL) {
+			while (descnum > 0) {
+				descnum--;
+				XVWarpInit_aligned_free(
+					(void *)InstancePtr->DescTable[descnum]);
+			}
+			free(InstancePtr->DescTable);
+			free(InstancePtr->ArbParams);
+			InstancePtr->DescTable = NULL;
+			InstancePtr->ArbParams = NULL;
 			return XST_FAILURE;
+		}
 		memset((u32 *)currptr, 0, sizeof(XVWarpInitVector_Hw_Aligned));
+		InstancePtr->DescTable[descnum] = (UINTPTR)currptr;
 
 		if (descnum == 0)
 			descptr = currptr;
@@ -115,10 +151,22 @@ int XVWarpInit_SetNumOfDescriptors(XV_warp_init *InstancePtr,
 void XVWarpInit_ClearNumOfDescriptors(XV_warp_init *InstancePtr)
 {
 	XVWarpInitVector_Hw_Aligned *head, *tmpptr;
+	XVWarpInit_ArbParam *arbit_param;
 
 	Xil_AssertVoid(InstancePtr);
 
+	arbit_param = (XVWarpInit_ArbParam *)InstancePtr->ArbParams;
+	for (u32 i = 0; i < InstancePtr->NumDescriptors; i++) {
+		XVWarpInit_FreeArbMem(&arbit_param[i]);
+	}
+	free(InstancePtr->ArbParams);
+	free(InstancePtr->DescTable);
+	InstancePtr->ArbParams = NULL;
+	InstancePtr->DescTable = NULL;
+
 	head = (XVWarpInitVector_Hw_Aligned *)InstancePtr->RemapVectorDesc_BaseAddr;
+	if (head == NULL)
+		return;
 
 	while(head->remap_nextaddr) {
 		tmpptr = (XVWarpInitVector_Hw_Aligned *)head->remap_nextaddr;
@@ -141,14 +189,17 @@ void XVWarpInit_ClearNumOfDescriptors(XV_warp_init *InstancePtr)
 * 					into the descriptor
 *
 * @return XST_SUCCESS if programming descriptor is successful
-*         XST_FAILURE if input configurations are not valid.
+*         XST_FAILURE if input configurations are not valid. If the mesh
+*         			information is not valid, the arbitary distortion
+*         			buffers of the descriptor are released and it must be
+*         			programmed again before use.
 *
 ******************************************************************************/
 int XVWarpInit_ProgramDescriptor(XV_warp_init *InstancePtr,
 		u32 Descnum, XVWarpInit_InputConfigs *ConfigPtr)
 {
 	XVWarpInitVector_Hw desc;
-	XVWarpInit_ArbParam arbit_param;
+	XVWarpInit_ArbParam *arbit_param;
 	XVWarpInitVector_Hw_Aligned *descptr;
 
 	Xil_AssertNonvoid(InstancePtr);
@@ -161,11 +212,10 @@ int XVWarpInit_ProgramDescriptor(XV_warp_init *InstancePtr,
 	if (XVWarpInit_ValidateInputConfigs(InstancePtr, ConfigPtr) != XST_SUCCESS)
 		return XST_FAILURE;
 
-	descptr = (XVWarpInitVector_Hw_Aligned *)InstancePtr->RemapVectorDesc_BaseAddr;
-	for (u32 i = 0; i < Descnum; i++) {
-		descptr = (XVWarpInitVector_Hw_Aligned *)descptr->remap_nextaddr;
-	}
+	descptr = (XVWarpInitVector_Hw_Aligned *)InstancePtr->DescTable[Descnum];
 
+	/* The fields of the other warp type are programmed as zero */
+	memset(&desc, 0, sizeof(desc));
 	desc.width	= ConfigPtr->width;
 	desc.height	= ConfigPtr->height;
 	desc.bytes_per_pixel = ConfigPtr->bytes_per_pixel;
@@ -176,21 +226,30 @@ int XVWarpInit_ProgramDescriptor(XV_warp_init *InstancePtr,
 	desc.height_Q4 = desc.height << REMAP_FIX_ACC;
 
 	if (desc.warp_type == DISTORTION_ARBITARY) {
-		XVWarpInit_AllocArbMem(&arbit_param, ConfigPtr->num_ctrl_pts,
-				desc.width, desc.height);
-		XVWarpInit_ParseMeshInfo(&arbit_param, ConfigPtr->ctr_pts,
-				desc.width, desc.height);
-		desc.src_ctrl_x_pts	= ((u64)arbit_param.src_ctrl_x_pts)/4;
-		desc.src_ctrl_y_pts	= ((u64)arbit_param.src_ctrl_y_pts)/4;
-		desc.src_tangents_x	= ((u64)arbit_param.src_tangents_x)/4;
-		desc.src_tangents_y	= ((u64)arbit_param.src_tangents_y)/4;
-		desc.interm_x			= ((u64)arbit_param.interm_x)/4;
-		desc.interm_y 		= ((u64)arbit_param.interm_y)/4;
+		/* Buffers of the previous programming are reused when they fit */
+		arbit_param = &((XVWarpInit_ArbParam *)InstancePtr->ArbParams)[Descnum];
+		if (XVWarpInit_AllocArbMem(arbit_param, ConfigPtr->num_ctrl_pts,
+				desc.width, desc.height) != XST_SUCCESS)
+			return XST_FAILURE;
+		if (XVWarpInit_ParseMeshInfo(arbit_param, ConfigPtr->ctr_pts,
+				desc.width, desc.height) != XST_SUCCESS) {
+			/* The buffers no longer match the descriptor */
+			XVWarpInit_FreeArbMem(arbit_param);
+			return XST_FAILURE;
+		}
+		desc.src_ctrl_x_pts	= ((u64)arbit_param->src_ctrl_x_pts)/4;
+		desc.src_ctrl_y_pts	= ((u64)arbit_param->src_ctrl_y_pts)/4;
+		desc.src_tangents_x	= ((u64)arbit_param->src_tangents_x)/4;
+		desc.src_tangents_y	= ((u64)arbit_param->src_tangents_y)/4;
+		desc.interm_x			= ((u64)arbit_param->interm_x)/4;
+		desc.interm_y 		= ((u64)arbit_param->interm_y)/4;
 		desc.num_ctrl_pts 	= ConfigPtr->num_ctrl_pts;
 
-		XVWarpInit_OnetimeCalcsArbt(&arbit_param,
+		XVWarpInit_OnetimeCalcsArbt(arbit_param,
 				desc.width, desc.height);
 	} else {
+		XVWarpInit_FreeArbMem(
+			&((XVWarpInit_ArbParam *)InstancePtr->ArbParams)[Descnum]);
 		desc.k_pre	= ConfigPtr->k_pre;
 		desc.k_post	= ConfigPtr->k_post;
 		XVWarpInit_OneTimeCalcs(&desc, ConfigPtr->h);
@@ -201,6 +260,81 @@ int XVWarpInit_ProgramDescriptor(XV_warp_init *InstancePtr,
 	return XST_SUCCESS;
 }
 
+/*****************************************************************************/
+/**
+* This function updates the mesh of a descriptor programmed for arbitary
+* distortion. Only the splines of the grid rows and columns holding a moved
+* control point are recalculated, in the buffers the descriptor already
+* points to, so the result is the same as programming the whole descriptor
+* again with the new mesh. The descriptor must not be in use by the IP
+* while it is updated.
+*
+* @param  InstancePtr is a pointer to core instance to be worked upon
+* @param  Descnum is the descriptor number which to be updated
+* @param  ctr_pts is the new mesh information, in the layout given to
+* 					XVWarpInit_ProgramDescriptor
+*
+* @return XST_SUCCESS if the mesh is updated
+*         XST_FAILURE if the descriptor is not programmed for arbitary
+*         			distortion or a control point is not valid. The mesh is
+*         			left unchanged in that case.
+*
+******************************************************************************/
+int XVWarpInit_UpdateMeshInfo(XV_warp_init *InstancePtr,
+		u32 Descnum, XVWarpInit_ArbParam_MeshInfo *ctr_pts)
+{
+	XVWarpInit_ArbParam *arbit_param;
+	u64 rows = 0, cols = 0;
+	u32 i, num_pts;
+	short seg_w, seg_h;
+
+	Xil_AssertNonvoid(InstancePtr);
+	Xil_AssertNonvoid(ctr_pts);
+
+	if (Descnum >= InstancePtr->NumDescriptors) {
+		xil_printf("Wrong descriptor\n\r");
+		return XST_FAILURE;
+	}
+
+	arbit_param = &((XVWarpInit_ArbParam *)InstancePtr->ArbParams)[Descnum];
+	if (arbit_param->interm_x == NULL) {
+		xil_printf("Descriptor not programmed for arbitary distortion\n\r");
+		return XST_FAILURE;
+	}
+
+	num_pts = arbit_param->grid_size + 1;
+	seg_w = arbit_param->fr_width / arbit_param->grid_size;
+	seg_h = arbit_param->fr_height / arbit_param->grid_size;
+
+	/* Check the whole mesh first, and find the rows and columns to redo */
+	for (i = 0; i < arbit_param->num_ctrl_pts; i++) {
+		if (XVWarpInit_CheckMeshPoint(&ctr_pts[i], seg_w, seg_h) !=
+				XST_SUCCESS)
+			return XST_FAILURE;
+
+		if (arbit_param->dst_ctrl_x_pts[i] != (u16)ctr_pts[i].d_x ||
+				arbit_param->dst_ctrl_y_pts[i] != (u16)ctr_pts[i].d_y) {
+			rows |= (u64)1 << (i / num_pts);
+			cols |= (u64)1 << (i % num_pts);
+		}
+	}
+
+	for (i = 0; i < arbit_param->num_ctrl_pts; i++) {
+		arbit_param->dst_ctrl_x_pts[i] = ctr_pts[i].d_x;
+		arbit_param->dst_ctrl_y_pts[i] = ctr_pts[i].d_y;
+	}
+
+	/* The source tangents only depend on the frame and grid sizes */
+	for (i = 0; i < num_pts; i++) {
+		if (cols & ((u64)1 << i))
+			XVWarpInit_ArbtColSpline(arbit_param, i, arbit_param->fr_height);
+		if (rows & ((u64)1 << i))
+			XVWarpInit_ArbtRowSpline(arbit_param, i, arbit_param->fr_width);
+	}
+
+	return XST_SUCCESS;
+}
+
 /*****************************************************************************/
 /**
 * This function starts the IP core with a selected descriptor configuration.
@@ -221,17 +355,12 @@ int XVWarpInit_start_with_desc(XV_warp_init *InstancePtr,
 
 	Xil_AssertNonvoid(InstancePtr);
 
-	descptr = (XVWarpInitVector_Hw_Aligned *)InstancePtr->RemapVectorDesc_BaseAddr;
-
 	if (descnum >= InstancePtr->NumDescriptors) {
 		xil_printf("Wrong descriptor\n\r");
 		return XST_FAILURE;
 	}
 
-	for (u32 i = 0; i < descnum; i++) {
-		descptr = (XVWarpInitVector_Hw_Aligned *)descptr->remap_nextaddr;
-	}
-
+	descptr = (XVWarpInitVector_Hw_Aligned *)InstancePtr->DescTable[descnum];
 	remapvectoroffset = ((u64)descptr)/4;
 
 	XV_warp_init_Set_maxi_read_write(InstancePtr, 0);
@@ -827,82 +956,129 @@ static void creat_src_tangents(unsigned short *src_ctrl_pts, int *src_tangents,
 
 /*****************************************************************************/
 /**
-* This function does all the ontime calculation for Arbitary distortion which
-* to be done for each input configs change.
+* This function applies the spline of a grid column, giving its column of the
+* interm_y vectors.
 *
 * @param	arbitrary_param is the pointer to input Arbitary parameters.
-* @param	fr_width is the frame width.
+* @param	col is the grid column.
 * @param	fr_height is the frame height.
 *
 * @return	None
 *
 ******************************************************************************/
-static void XVWarpInit_OnetimeCalcsArbt(XVWarpInit_ArbParam *arbitrary_param,
-	unsigned short fr_width, unsigned short fr_height) {
-	u32 i, j, l;
+static void XVWarpInit_ArbtColSpline(XVWarpInit_ArbParam *arbitrary_param,
+		u32 col, unsigned short fr_height)
+{
+	u32 i, l;
 	short *knots_x, *knots_y;
 	int *t_data, *int_ptr;
-	u32 grid_size;
 	unsigned short *sh_ptr_x, *sh_ptr_y, num_pts;
 
-	grid_size = arbitrary_param->grid_size;
+	num_pts = arbitrary_param->grid_size + 1;
+	knots_x = arbitrary_param->knots_x;
+	knots_y = arbitrary_param->knots_y;
+
+	sh_ptr_x = arbitrary_param->dst_ctrl_x_pts + col;
+	sh_ptr_y = arbitrary_param->dst_ctrl_y_pts + col;
+	l = 1;
+	for (i = 0; i < arbitrary_param->num_ctrl_pts; i += num_pts) {
+		knots_x[l] = sh_ptr_x[i];
+		knots_y[l++] = sh_ptr_y[i];
+	}
+
+	knots_x[0] = knots_x[1];
+	knots_y[0] = knots_y[1];
+	knots_x[l] = knots_x[l - 1];
+	knots_y[l] = knots_y[l - 1];
+
+	apply_arbt_warp_line(knots_y, knots_x, arbitrary_param->grid_size,
+			fr_height, arbitrary_param->temp_row);
 
-	num_pts = grid_size + 1;
+	t_data = arbitrary_param->interm_y + col;
+	int_ptr = arbitrary_param->temp_row;
+	for (i = 0; i < fr_height; i++) {
+		*t_data = *int_ptr;
+		t_data += num_pts;
+		int_ptr++;
+	}
+}
+
+/*****************************************************************************/
+/**
+* This function applies the spline of a grid row, giving its column of the
+* interm_x vectors.
+*
+* @param	arbitrary_param is the pointer to input Arbitary parameters.
+* @param	row is the grid row.
+* @param	fr_width is the frame width.
+*
+* @return	None
+*
+******************************************************************************/
+static void XVWarpInit_ArbtRowSpline(XVWarpInit_ArbParam *arbitrary_param,
+		u32 row, unsigned short fr_width)
+{
+	u32 i, l;
+	short *knots_x, *knots_y;
+	int *t_data, *int_ptr;
+	unsigned short *sh_ptr_x, *sh_ptr_y, num_pts;
+
+	num_pts = arbitrary_param->grid_size + 1;
 	knots_x = arbitrary_param->knots_x;
 	knots_y = arbitrary_param->knots_y;
 
-	//Col wise applying splines
-	for (j = 0; j <= grid_size; j++) {
-		sh_ptr_x = arbitrary_param->dst_ctrl_x_pts + j;
-		sh_ptr_y = arbitrary_param->dst_ctrl_y_pts + j;
-		l = 1;
-		for (i = 0; i < arbitrary_param->num_ctrl_pts; i += num_pts) {
-			knots_x[l] = sh_ptr_x[i];
-			knots_y[l++] = sh_ptr_y[i];
-		}
+	sh_ptr_x = arbitrary_param->dst_ctrl_x_pts + row * num_pts;
+	sh_ptr_y = arbitrary_param->dst_ctrl_y_pts + row * num_pts;
+	l = 1;
+	for (i = 0; i < num_pts; i++) {
+		knots_x[l] = sh_ptr_x[i];
+		knots_y[l++] = sh_ptr_y[i];
+	}
 
-		knots_x[0] = knots_x[1];
-		knots_y[0] = knots_y[1];
-		knots_x[l] = knots_x[l - 1];
-		knots_y[l] = knots_y[l - 1];
+	knots_x[0] = knots_x[1];
+	knots_y[0] = knots_y[1];
+	knots_x[l] = knots_x[l - 1];
+	knots_y[l] = knots_y[l - 1];
 
-		apply_arbt_warp_line(knots_y, knots_x, grid_size,
-				fr_height, arbitrary_param->temp_row);
+	apply_arbt_warp_line(knots_x, knots_y, arbitrary_param->grid_size,
+			fr_width, arbitrary_param->temp_row);
 
-		t_data = arbitrary_param->interm_y + j;
-		int_ptr = arbitrary_param->temp_row;
-		for (i = 0; i < fr_height; i++) {
-			*t_data = *int_ptr;
-			t_data += num_pts;
-			int_ptr++;
-		}
+	t_data = arbitrary_param->interm_x + row;
+	int_ptr = arbitrary_param->temp_row;
+	for (i = 0; i < fr_width; i++) {
+		*t_data = *int_ptr;
+		t_data += num_pts;
+		int_ptr++;
 	}
+}
 
-	//Row wise applying splines
-	for (j = 0; j <= grid_size; j++) {
-		sh_ptr_x = arbitrary_param->dst_ctrl_x_pts + j * num_pts;
-		sh_ptr_y = arbitrary_param->dst_ctrl_y_pts + j * num_pts;
-		l = 1;
-		for (i = 0; i < num_pts; i++) {
-			knots_x[l] = sh_ptr_x[i];
-			knots_y[l++] = sh_ptr_y[i];
-		}
+/*****************************************************************************/
+/**
+* This function does all the ontime calculation for Arbitary distortion which
+* to be done for each input configs change.
+*
+* @param	arbitrary_param is the pointer to input Arbitary parameters.
+* @param	fr_width is the frame width.
+* @param	fr_height is the frame height.
+*
+* @return	None
+*
+******************************************************************************/
+static void XVWarpInit_OnetimeCalcsArbt(XVWarpInit_ArbParam *arbitrary_param,
+	unsigned short fr_width, unsigned short fr_height) {
+	u32 j;
+	u32 grid_size;
 
-		knots_x[0] = knots_x[1];
-		knots_y[0] = knots_y[1];
-		knots_x[l] = knots_x[l - 1];
-		knots_y[l] = knots_y[l - 1];
+	grid_size = arbitrary_param->grid_size;
 
-		apply_arbt_warp_line(knots_x, knots_y, grid_size,
-				fr_width, arbitrary_param->temp_row);
+	//Col wise applying splines
+	for (j = 0; j <= grid_size; j++) {
+		XVWarpInit_ArbtColSpline(arbitrary_param, j, fr_height);
+	}
 
-		t_data = arbitrary_param->interm_x + j;
-		int_ptr = arbitrary_param->temp_row;
-		for (i = 0; i < fr_width; i++) {
-			*t_data = *int_ptr;
-			t_data += num_pts;
-			int_ptr++;
-		}
+	//Row wise applying splines
+	for (j = 0; j <= grid_size; j++) {
+		XVWarpInit_ArbtRowSpline(arbitrary_param, j, fr_width);
 	}
 
 	creat_src_tangents(arbitrary_param->src_ctrl_x_pts,
@@ -915,22 +1091,32 @@ static void XVWarpInit_OnetimeCalcsArbt(XVWarpInit_ArbParam *arbitrary_param,
 /*****************************************************************************/
 /**
 * This function allocates the required memory for intermediate arbitary
-* variables/calculation.
+* variables/calculation. The memory already allocated is kept when the grid
+* and frame sizes are unchanged.
 *
 * @param	arbitrary_param is the pointer to input Arbitary parameters.
 * @param	grid_size is the grid size for the arbitary distortion.
 * @param	fr_width is the frame width.
 * @param	fr_height is the frame height.
 *
-* @return	None
+* @return	XST_SUCCESS if the memory is allocated
+* 			XST_FAILURE if the memory allocation failed
 *
 ******************************************************************************/
-static void XVWarpInit_AllocArbMem(XVWarpInit_ArbParam *arbitrary_param,
+static int XVWarpInit_AllocArbMem(XVWarpInit_ArbParam *arbitrary_param,
 		int grid_size, u16 fr_width, u16 fr_height)
 {
 	int n_pts;
 	int num_ctrl_pts;
 
+	if (arbitrary_param->interm_x != NULL &&
+			arbitrary_param->grid_size == (u32)grid_size &&
+			arbitrary_param->fr_width == fr_width &&
+			arbitrary_param->fr_height == fr_height)
+		return XST_SUCCESS;
+
+	XVWarpInit_FreeArbMem(arbitrary_param);
+
 	n_pts = grid_size + 1;
 	num_ctrl_pts = n_pts * n_pts;
 
@@ -948,7 +1134,79 @@ static void XVWarpInit_AllocArbMem(XVWarpInit_ArbParam *arbitrary_param,
 	arbitrary_param->knots_y = (short *)malloc(sizeof(short) * (n_pts+2));
 	arbitrary_param->interm_x = (int *)malloc(sizeof(int) * fr_width * n_pts);
 	arbitrary_param->interm_y = (int *)malloc(sizeof(int) * fr_height * n_pts);
-	arbitrary_param->temp_row = (int *)malloc(sizeof(int) * fr_width);
+	/* Holds a row for the row splines and a column for the column ones */
+	arbitrary_param->temp_row = (int *)malloc(sizeof(int) *
+			(fr_width > fr_height ? fr_width : fr_height));
+
+	if (arbitrary_param->dst_ctrl_x_pts == NULL ||
+			arbitrary_param->dst_ctrl_y_pts == NULL ||
+			arbitrary_param->src_ctrl_x_pts == NULL ||
+			arbitrary_param->src_ctrl_y_pts == NULL ||
+			arbitrary_param->src_tangents_x == NULL ||
+			arbitrary_param->src_tangents_y == NULL ||
+			arbitrary_param->knots_x == NULL ||
+			arbitrary_param->knots_y == NULL ||
+			arbitrary_param->interm_x == NULL ||
+			arbitrary_param->interm_y == NULL ||
+			arbitrary_param->temp_row == NULL) {
+		XVWarpInit_FreeArbMem(arbitrary_param);
+		return XST_FAILURE;
+	}
+
+	arbitrary_param->fr_width = fr_width;
+	arbitrary_param->fr_height = fr_height;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* This function frees the memory of intermediate arbitary variables.
+*
+* @param	arbitrary_param is the pointer to input Arbitary parameters.
+*
+* @return	None
+*
+******************************************************************************/
+static void XVWarpInit_FreeArbMem(XVWarpInit_ArbParam *arbitrary_param)
+{
+	free(arbitrary_param->dst_ctrl_x_pts);
+	free(arbitrary_param->dst_ctrl_y_pts);
+	free(arbitrary_param->src_ctrl_x_pts);
+	free(arbitrary_param->src_ctrl_y_pts);
+	free(arbitrary_param->src_tangents_x);
+	free(arbitrary_param->src_tangents_y);
+	free(arbitrary_param->knots_x);
+	free(arbitrary_param->knots_y);
+	free(arbitrary_param->interm_x);
+	free(arbitrary_param->interm_y);
+	free(arbitrary_param->temp_row);
+	memset(arbitrary_param, 0, sizeof(XVWarpInit_ArbParam));
+}
+
+/*****************************************************************************/
+/**
+* This function checks a control point of the input mesh information.
+*
+* @param	ctrl_pt is the pointer to the control point.
+* @param	seg_w is the distance between the grid columns.
+* @param	seg_h is the distance between the grid rows.
+*
+* @return	XST_SUCCESS if the control point is valid
+* 			XST_FAILURE if the control point moves too far
+*
+******************************************************************************/
+static int XVWarpInit_CheckMeshPoint(XVWarpInit_ArbParam_MeshInfo *ctrl_pt,
+		short seg_w, short seg_h)
+{
+	if (abs(ctrl_pt->s_x - ctrl_pt->d_x) > seg_w ||
+			abs(ctrl_pt->s_y - ctrl_pt->d_y) > seg_h) {
+		xil_printf("Maximum point movement should be half "
+				"of distance between control points\n");
+		return XST_FAILURE;
+	}
+
+	return XST_SUCCESS;
 }
 
 /*****************************************************************************/
@@ -971,7 +1229,6 @@ static int XVWarpInit_ParseMeshInfo(XVWarpInit_ArbParam *arbitrary_param,
 {
 	u32 n=arbitrary_param->grid_size, i;
 	short seg_w, seg_h;
-	int s_x, s_y, d_x, d_y;
 
 	if (n < 2 || n > 32) {
 		xil_printf("Wrong number of control points\n");
@@ -982,18 +1239,14 @@ static int XVWarpInit_ParseMeshInfo(XVWarpInit_ArbParam *arbitrary_param,
 	seg_h = fr_height / n;
 
 	for (i = 0; i < arbitrary_param->num_ctrl_pts; i++) {
-		s_x = ctrl_pts[i].s_x;
-		s_y = ctrl_pts[i].s_y;
-		d_x = ctrl_pts[i].d_x;
-		d_y = ctrl_pts[i].d_y;
-		if (abs(s_x - d_x) > seg_w || abs(s_y - d_y) > seg_h) {
-			xil_printf("Maximum point movement should be half "
-					"of distance between control points\n");
+		if (XVWarpInit_CheckMeshPoint(&ctrl_pts[i], seg_w, seg_h) !=
+				XST_SUCCESS)
 			return XST_FAILURE;
-		}
+	}
 
-		arbitrary_param->dst_ctrl_x_pts[i] = d_x;
-		arbitrary_param->dst_ctrl_y_pts[i] = d_y;
+	for (i = 0; i < arbitrary_param->num_ctrl_pts; i++) {
+		arbitrary_param->dst_ctrl_x_pts[i] = ctrl_pts[i].d_x;
+		arbitrary_param->dst_ctrl_y_pts[i] = ctrl_pts[i].d_y;
 	}
 	return XST_SUCCESS;
 }
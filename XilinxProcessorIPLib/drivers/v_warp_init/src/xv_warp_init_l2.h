@@ -111,9 +111,16 @@ typedef volatile struct {
 	u64 remap_nextaddr;
 } XVWarpInitVector_Hw_Aligned;
 
+/*
+ * This structure holds the arbitary warp buffers of a descriptor. They are
+ * kept across XVWarpInit_ProgramDescriptor calls with the same grid and frame
+ * size, and updated in place by XVWarpInit_UpdateMeshInfo.
+ */
 typedef struct {
 	u32 grid_size;
 	u32 num_ctrl_pts;
+	u16 fr_width;
+	u16 fr_height;
 	u16 *dst_ctrl_x_pts;
 	u16 *dst_ctrl_y_pts;
 	u16 *src_ctrl_x_pts;
@@ -152,6 +159,8 @@ int XVWarpInit_SetNumOfDescriptors(XV_warp_init *InstancePtr,
 void XVWarpInit_ClearNumOfDescriptors(XV_warp_init *InstancePtr);
 int XVWarpInit_ProgramDescriptor(XV_warp_init *InstancePtr,
 		u32 Descnum, XVWarpInit_InputConfigs *ConfigPtr);
+int XVWarpInit_UpdateMeshInfo(XV_warp_init *InstancePtr,
+		u32 Descnum, XVWarpInit_ArbParam_MeshInfo *ctr_pts);
 int XVWarpInit_start_with_desc(XV_warp_init *InstancePtr,
 		u32 descnum);
 void XVWarpInit_Stop(XV_warp_init *InstancePtr);
@@ -0,0 +1,732 @@
+/*******************************************************************************
+* Copyright (C) 2021 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+*******************************************************************************/
+
+/******************************************************************************/
+/**
+ *
+ * @file xvidc_bufpool.c
+ * @addtogroup video_common_v4_13
+ * @{
+ *
+ * Contains the frame buffer pool and the writer to reader pipeline. See
+ * xvidc_bufpool.h for a description of the frames, fences and ports.
+ *
+ * @note	None.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date     Changes
+ * ----- ---- -------- -----------------------------------------------
+ * 4.13  jb   10/18/26 Initial release.
+ * </pre>
+ *
+*******************************************************************************/
+
+/******************************* Include Files ********************************/
+
+#include <string.h>
+#include "xil_assert.h"
+#include "xvidc_bufpool.h"
+
+/**************************** Function Prototypes *****************************/
+
+static u32 XVidC_GetNumPlanes(XVidC_ColorFormat ColorFormat);
+static u32 XVidC_GetChromaHeight(const XVidC_FrameFormat *FormatPtr);
+static u64 XVidC_PipeGetTime(const XVidC_Pipe *PipePtr);
+
+/**************************** Function Definitions ****************************/
+
+/******************************************************************************/
+/**
+ * This function returns the number of planes of a memory color format.
+ *
+ * @param	ColorFormat is the memory color format.
+ *
+ * @return	1 for packed formats, 2 for semi-planar formats and 3 for the 3
+ *		planar formats.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+static u32 XVidC_GetNumPlanes(XVidC_ColorFormat ColorFormat)
+{
+	u32 NumPlanes;
+
+	switch (ColorFormat) {
+	case XVIDC_CSF_MEM_Y_UV8:
+	case XVIDC_CSF_MEM_Y_UV8_420:
+	case XVIDC_CSF_MEM_Y_UV10:
+	case XVIDC_CSF_MEM_Y_UV10_420:
+	case XVIDC_CSF_MEM_Y_UV12:
+	case XVIDC_CSF_MEM_Y_UV12_420:
+	case XVIDC_CSF_MEM_Y_UV16:
+	case XVIDC_CSF_MEM_Y_UV16_420:
+		NumPlanes = 2;
+		break;
+
+	case XVIDC_CSF_MEM_R_G_B8:
+	case XVIDC_CSF_MEM_Y_U_V8_420:
+	case XVIDC_CSF_MEM_Y_U_V8:
+	case XVIDC_CSF_MEM_Y_U_V10:
+		NumPlanes = 3;
+		break;
+
+	default:
+		NumPlanes = 1;
+		break;
+	}
+
+	return NumPlanes;
+}
+
+/******************************************************************************/
+/**
+ * This function returns the number of lines of the chroma planes of a frame.
+ *
+ * @param	FormatPtr is a pointer to the frame layout.
+ *
+ * @return	Half the height, rounded up, for the 4:2:0 formats, else the
+ *		height.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+static u32 XVidC_GetChromaHeight(const XVidC_FrameFormat *FormatPtr)
+{
+	switch (FormatPtr->ColorFormat) {
+	case XVIDC_CSF_MEM_Y_UV8_420:
+	case XVIDC_CSF_MEM_Y_UV10_420:
+	case XVIDC_CSF_MEM_Y_UV12_420:
+	case XVIDC_CSF_MEM_Y_UV16_420:
+	case XVIDC_CSF_MEM_Y_U_V8_420:
+		return (FormatPtr->Height + 1) / 2;
+
+	default:
+		return FormatPtr->Height;
+	}
+}
+
+/******************************************************************************/
+/**
+ * This function returns the size of a frame, all planes included.
+ *
+ * @param	FormatPtr is a pointer to the frame layout.
+ *
+ * @return	Size of the frame in bytes.
+ *
+ * @note	All the planes use the stride of the layout.
+ *
+*******************************************************************************/
+u32 XVidC_GetFrameSize(const XVidC_FrameFormat *FormatPtr)
+{
+	u32 NumPlanes;
+
+	Xil_AssertNonvoid(FormatPtr != NULL);
+
+	NumPlanes = XVidC_GetNumPlanes(FormatPtr->ColorFormat);
+
+	return (FormatPtr->Stride * FormatPtr->Height) +
+		((NumPlanes - 1) * FormatPtr->Stride *
+		 XVidC_GetChromaHeight(FormatPtr));
+}
+
+/******************************************************************************/
+/**
+ * This function initializes a pool, carving the frames out of a memory region.
+ * Frame i starts at BaseAddr + i * XVidC_GetFrameSize(FormatPtr), and its
+ * chroma planes follow its luma plane. All the frames are free on return.
+ *
+ * @param	PoolPtr is a pointer to the pool.
+ * @param	Frames is an array of NumFrames frames, which must stay valid
+ *		as long as the pool is in use.
+ * @param	NumFrames is the number of frames, up to
+ *		XVIDC_BUFPOOL_MAX_FRAMES.
+ * @param	FormatPtr is a pointer to the layout of the frames.
+ * @param	BaseAddr is the address of the memory region.
+ * @param	MemSize is the size in bytes of the memory region.
+ *
+ * @return
+ *		- XST_SUCCESS if the pool was initialized.
+ *		- XST_INVALID_PARAM if NumFrames or the layout is invalid.
+ *		- XST_BUFFER_TOO_SMALL if the region cannot hold the frames.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+int XVidC_BufPoolInit(XVidC_BufPool *PoolPtr, XVidC_Frame *Frames,
+		u32 NumFrames, const XVidC_FrameFormat *FormatPtr,
+		UINTPTR BaseAddr, u32 MemSize)
+{
+	XVidC_Frame *FramePtr;
+	UINTPTR PlaneSize;
+	UINTPTR ChromaSize;
+	u32 NumPlanes;
+	u32 Index;
+
+	/* Verify arguments. */
+	Xil_AssertNonvoid(PoolPtr != NULL);
+	Xil_AssertNonvoid(Frames != NULL);
+	Xil_AssertNonvoid(FormatPtr != NULL);
+
+	if ((NumFrames == 0) || (NumFrames > XVIDC_BUFPOOL_MAX_FRAMES) ||
+	    (FormatPtr->Width == 0) || (FormatPtr->Height == 0) ||
+	    (FormatPtr->Stride == 0)) {
+		return XST_INVALID_PARAM;
+	}
+
+	PoolPtr->FrameSize = XVidC_GetFrameSize(FormatPtr);
+	if (((u64)PoolPtr->FrameSize * NumFrames) > MemSize) {
+		return XST_BUFFER_TOO_SMALL;
+	}
+
+	NumPlanes = XVidC_GetNumPlanes(FormatPtr->ColorFormat);
+	PlaneSize = (UINTPTR)FormatPtr->Stride * FormatPtr->Height;
+	ChromaSize = (UINTPTR)FormatPtr->Stride *
+		XVidC_GetChromaHeight(FormatPtr);
+
+	(void)memset(Frames, 0, NumFrames * sizeof(XVidC_Frame));
+	for (Index = 0; Index < NumFrames; Index++) {
+		FramePtr = &Frames[Index];
+		FramePtr->LumaAddr = BaseAddr +
+			((UINTPTR)Index * PoolPtr->FrameSize);
+		if (NumPlanes > 1) {
+			FramePtr->ChromaAddr = FramePtr->LumaAddr + PlaneSize;
+		}
+		if (NumPlanes > 2) {
+			FramePtr->VChromaAddr = FramePtr->ChromaAddr +
+				ChromaSize;
+		}
+		FramePtr->Format = *FormatPtr;
+		FramePtr->Index = Index;
+	}
+
+	PoolPtr->Frames = Frames;
+	PoolPtr->NumFrames = NumFrames;
+	PoolPtr->Format = *FormatPtr;
+	PoolPtr->FreeMask = (NumFrames == 32) ?
+		0xFFFFFFFF : ((1U << NumFrames) - 1);
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+ * This function takes a free frame from a pool. The frame holds one reference
+ * and its fence is idle.
+ *
+ * @param	PoolPtr is a pointer to the pool.
+ *
+ * @return	The frame, or NULL if no frame is free.
+ *
+ * @note	The frame of the lowest index is returned first.
+ *
+*******************************************************************************/
+XVidC_Frame *XVidC_BufPoolGet(XVidC_BufPool *PoolPtr)
+{
+	XVidC_Frame *FramePtr;
+	u32 Index;
+
+	Xil_AssertNonvoid(PoolPtr != NULL);
+
+	if (PoolPtr->FreeMask == 0) {
+		return NULL;
+	}
+
+	for (Index = 0; (PoolPtr->FreeMask & (1U << Index)) == 0; Index++) {
+		;
+	}
+	PoolPtr->FreeMask &= ~(1U << Index);
+
+	FramePtr = &PoolPtr->Frames[Index];
+	FramePtr->RefCount = 1;
+	FramePtr->Seq = 0;
+	FramePtr->Fence.State = XVIDC_FENCE_IDLE;
+
+	return FramePtr;
+}
+
+/******************************************************************************/
+/**
+ * This function adds a reference to a frame in use.
+ *
+ * @param	PoolPtr is a pointer to the pool of the frame.
+ * @param	FramePtr is a pointer to the frame.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+void XVidC_BufPoolRef(XVidC_BufPool *PoolPtr, XVidC_Frame *FramePtr)
+{
+	Xil_AssertVoid(PoolPtr != NULL);
+	Xil_AssertVoid(FramePtr != NULL);
+	Xil_AssertVoid(FramePtr->RefCount != 0);
+
+	FramePtr->RefCount++;
+}
+
+/******************************************************************************/
+/**
+ * This function drops a reference to a frame, and returns the frame to its
+ * pool if this was the last one.
+ *
+ * @param	PoolPtr is a pointer to the pool of the frame.
+ * @param	FramePtr is a pointer to the frame.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+void XVidC_BufPoolPut(XVidC_BufPool *PoolPtr, XVidC_Frame *FramePtr)
+{
+	Xil_AssertVoid(PoolPtr != NULL);
+	Xil_AssertVoid(FramePtr != NULL);
+	Xil_AssertVoid(FramePtr == &PoolPtr->Frames[FramePtr->Index]);
+	Xil_AssertVoid(FramePtr->RefCount != 0);
+
+	FramePtr->RefCount--;
+	if (FramePtr->RefCount == 0) {
+		FramePtr->Fence.State = XVIDC_FENCE_IDLE;
+		PoolPtr->FreeMask |= (1U << FramePtr->Index);
+	}
+}
+
+/******************************************************************************/
+/**
+ * This function returns the number of free frames of a pool.
+ *
+ * @param	PoolPtr is a pointer to the pool.
+ *
+ * @return	Number of free frames.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+u32 XVidC_BufPoolNumFree(const XVidC_BufPool *PoolPtr)
+{
+	u32 Mask;
+	u32 NumFree = 0;
+
+	Xil_AssertNonvoid(PoolPtr != NULL);
+
+	for (Mask = PoolPtr->FreeMask; Mask != 0; Mask &= Mask - 1) {
+		NumFree++;
+	}
+
+	return NumFree;
+}
+
+/******************************************************************************/
+/**
+ * This function arms a fence, when its frame is handed to a writer.
+ *
+ * @param	FencePtr is a pointer to the fence.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+void XVidC_FenceArm(XVidC_Fence *FencePtr)
+{
+	Xil_AssertVoid(FencePtr != NULL);
+
+	FencePtr->Time = 0;
+	FencePtr->State = XVIDC_FENCE_PENDING;
+}
+
+/******************************************************************************/
+/**
+ * This function signals a fence, from the done interrupt of the writer of its
+ * frame.
+ *
+ * @param	FencePtr is a pointer to the fence.
+ * @param	Time is the time of the completion.
+ *
+ * @return	None.
+ *
+ * @note	The time is written before the state, so that a fence seen
+ *		signaled has its time set.
+ *
+*******************************************************************************/
+void XVidC_FenceSignal(XVidC_Fence *FencePtr, u64 Time)
+{
+	Xil_AssertVoid(FencePtr != NULL);
+
+	FencePtr->Time = Time;
+	FencePtr->State = XVIDC_FENCE_SIGNALED;
+}
+
+/******************************************************************************/
+/**
+ * This function returns the time of a pipeline.
+ *
+ * @param	PipePtr is a pointer to the pipeline.
+ *
+ * @return	The time, or 0 if the pipeline has no time source.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+static u64 XVidC_PipeGetTime(const XVidC_Pipe *PipePtr)
+{
+	return (PipePtr->GetTime != NULL) ? PipePtr->GetTime() : 0;
+}
+
+/******************************************************************************/
+/**
+ * This function initializes a pipeline over a pool. The ports must be set with
+ * XVidC_PipeSetPort before the pipeline is started.
+ *
+ * @param	PipePtr is a pointer to the pipeline.
+ * @param	PoolPtr is a pointer to an initialized pool, of at least
+ *		XVIDC_PIPE_MIN_FRAMES frames.
+ * @param	GetTime is the time source of the fences and of the latencies,
+ *		or NULL for none.
+ *
+ * @return
+ *		- XST_SUCCESS if the pipeline was initialized.
+ *		- XST_INVALID_PARAM if the pool is too small.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+int XVidC_PipeInit(XVidC_Pipe *PipePtr, XVidC_BufPool *PoolPtr,
+		XVidC_TimeFn GetTime)
+{
+	Xil_AssertNonvoid(PipePtr != NULL);
+	Xil_AssertNonvoid(PoolPtr != NULL);
+
+	if (PoolPtr->NumFrames < XVIDC_PIPE_MIN_FRAMES) {
+		return XST_INVALID_PARAM;
+	}
+
+	(void)memset(PipePtr, 0, sizeof(XVidC_Pipe));
+	PipePtr->Pool = PoolPtr;
+	PipePtr->GetTime = GetTime;
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+ * This function sets the callback of a port of a pipeline.
+ *
+ * @param	PipePtr is a pointer to the pipeline.
+ * @param	PortId is the port.
+ * @param	SetFrame is the function which programs the buffer addresses of
+ *		a frame into the core of the port.
+ * @param	CallbackRef is the reference passed to SetFrame, usually the
+ *		instance of the core.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+void XVidC_PipeSetPort(XVidC_Pipe *PipePtr, XVidC_PipePortId PortId,
+		XVidC_PipeSetFrameFn SetFrame, void *CallbackRef)
+{
+	Xil_AssertVoid(PipePtr != NULL);
+	Xil_AssertVoid(PortId <= XVIDC_PIPE_READER);
+	Xil_AssertVoid(SetFrame != NULL);
+
+	PipePtr->Port[PortId].SetFrame = SetFrame;
+	PipePtr->Port[PortId].CallbackRef = CallbackRef;
+}
+
+/******************************************************************************/
+/**
+ * This function starts a pipeline: it programs a free frame into each port.
+ * The frame of the reader is displayed until the first frame is captured, its
+ * contents are left to the application. The cores can be started on return.
+ *
+ * @param	PipePtr is a pointer to the pipeline.
+ *
+ * @return
+ *		- XST_SUCCESS if both ports were programmed.
+ *		- XST_FAILURE if the pool has fewer than two free frames.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+int XVidC_PipeStart(XVidC_Pipe *PipePtr)
+{
+	XVidC_PipePort *Writer;
+	XVidC_PipePort *Reader;
+
+	Xil_AssertNonvoid(PipePtr != NULL);
+	Writer = &PipePtr->Port[XVIDC_PIPE_WRITER];
+	Reader = &PipePtr->Port[XVIDC_PIPE_READER];
+	Xil_AssertNonvoid(Writer->SetFrame != NULL);
+	Xil_AssertNonvoid(Reader->SetFrame != NULL);
+	Xil_AssertNonvoid(Writer->Frame == NULL);
+	Xil_AssertNonvoid(Reader->Frame == NULL);
+
+	if (XVidC_BufPoolNumFree(PipePtr->Pool) < 2) {
+		return XST_FAILURE;
+	}
+
+	Writer->Frame = XVidC_BufPoolGet(PipePtr->Pool);
+	XVidC_FenceArm(&Writer->Frame->Fence);
+	Writer->SetFrame(Writer->CallbackRef, Writer->Frame);
+
+	Reader->Frame = XVidC_BufPoolGet(PipePtr->Pool);
+	XVidC_FenceSignal(&Reader->Frame->Fence,
+			XVidC_PipeGetTime(PipePtr));
+	Reader->SetFrame(Reader->CallbackRef, Reader->Frame);
+
+	return XST_SUCCESS;
+}
+
+/******************************************************************************/
+/**
+ * This function stops a pipeline and releases its frames. It must be called
+ * once both cores are stopped. The frames acquired by the application stay
+ * valid until they are released.
+ *
+ * @param	PipePtr is a pointer to the pipeline.
+ *
+ * @return	None.
+ *
+ * @note	The counters are kept, see XVidC_PipeResetStats.
+ *
+*******************************************************************************/
+void XVidC_PipeStop(XVidC_Pipe *PipePtr)
+{
+	XVidC_PipePort *Port;
+	u32 Index;
+
+	Xil_AssertVoid(PipePtr != NULL);
+
+	for (Index = 0; Index < 2; Index++) {
+		Port = &PipePtr->Port[Index];
+		if (Port->Frame != NULL) {
+			XVidC_BufPoolPut(PipePtr->Pool, Port->Frame);
+			Port->Frame = NULL;
+		}
+	}
+
+	if (PipePtr->Published != NULL) {
+		XVidC_BufPoolPut(PipePtr->Pool, PipePtr->Published);
+		PipePtr->Published = NULL;
+	}
+}
+
+/******************************************************************************/
+/**
+ * This function is called from the done callback of the writer. It signals
+ * the fence of the frame just written, publishes the frame, and programs the
+ * next frame into the writer.
+ *
+ * The next frame is a free frame of the pool. If there is none, the writer
+ * takes back the published frame if the reader has not picked it and the
+ * application holds no reference to it, and this frame is dropped. Else the
+ * writer overwrites the frame it just wrote, which is dropped and not
+ * published.
+ *
+ * @param	PipePtr is a pointer to the pipeline.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+void XVidC_PipeWriterDone(XVidC_Pipe *PipePtr)
+{
+	XVidC_PipePort *Writer;
+	XVidC_Frame *DonePtr;
+	XVidC_Frame *NextPtr;
+
+	Xil_AssertVoid(PipePtr != NULL);
+	Writer = &PipePtr->Port[XVIDC_PIPE_WRITER];
+
+	DonePtr = Writer->Frame;
+	if (DonePtr == NULL) {
+		/* Not started */
+		return;
+	}
+
+	NextPtr = XVidC_BufPoolGet(PipePtr->Pool);
+	if ((NextPtr == NULL) && (PipePtr->Published != NULL) &&
+	    (PipePtr->Published->RefCount == 1)) {
+		/* Recycle the unread frame, the new one supersedes it */
+		NextPtr = PipePtr->Published;
+		PipePtr->Published = NULL;
+		PipePtr->Stats.ReaderDrops++;
+	}
+
+	if (NextPtr == NULL) {
+		/* Keep writing into the same frame, its address is programmed */
+		PipePtr->Stats.WriterDrops++;
+		XVidC_FenceArm(&DonePtr->Fence);
+		return;
+	}
+
+	DonePtr->Seq = ++PipePtr->Seq;
+	XVidC_FenceSignal(&DonePtr->Fence, XVidC_PipeGetTime(PipePtr));
+	PipePtr->Stats.Captured++;
+
+	if (PipePtr->Published != NULL) {
+		XVidC_BufPoolPut(PipePtr->Pool, PipePtr->Published);
+		PipePtr->Stats.ReaderDrops++;
+	}
+	PipePtr->Published = DonePtr;
+
+	XVidC_FenceArm(&NextPtr->Fence);
+	Writer->Frame = NextPtr;
+	Writer->SetFrame(Writer->CallbackRef, NextPtr);
+}
+
+/******************************************************************************/
+/**
+ * This function is called from the done callback of the reader. It programs
+ * the newest published frame into the reader and releases the frame read
+ * until now. If no frame was published, the reader repeats its frame.
+ *
+ * @param	PipePtr is a pointer to the pipeline.
+ *
+ * @return	None.
+ *
+ * @note	The latency of a frame is measured from the signal of its fence
+ *		to the done of the reader frame before it, i.e. to the start of
+ *		its display.
+ *
+*******************************************************************************/
+void XVidC_PipeReaderDone(XVidC_Pipe *PipePtr)
+{
+	XVidC_PipePort *Reader;
+	XVidC_PipeStats *Stats;
+	XVidC_Frame *PrevPtr;
+	XVidC_Frame *NextPtr;
+	u64 Latency;
+
+	Xil_AssertVoid(PipePtr != NULL);
+	Reader = &PipePtr->Port[XVIDC_PIPE_READER];
+	Stats = &PipePtr->Stats;
+
+	PrevPtr = Reader->Frame;
+	if (PrevPtr == NULL) {
+		/* Not started */
+		return;
+	}
+
+	NextPtr = PipePtr->Published;
+	if (NextPtr == NULL) {
+		Stats->Repeats++;
+		return;
+	}
+
+	Xil_AssertVoid(XVidC_FrameIsDone(NextPtr));
+
+	PipePtr->Published = NULL;
+	Reader->Frame = NextPtr;
+	Reader->SetFrame(Reader->CallbackRef, NextPtr);
+	XVidC_BufPoolPut(PipePtr->Pool, PrevPtr);
+
+	Latency = XVidC_PipeGetTime(PipePtr) - NextPtr->Fence.Time;
+	Stats->Displayed++;
+	Stats->LastLatency = Latency;
+	Stats->TotalLatency += Latency;
+	if ((Stats->Displayed == 1) || (Latency < Stats->MinLatency)) {
+		Stats->MinLatency = Latency;
+	}
+	if (Latency > Stats->MaxLatency) {
+		Stats->MaxLatency = Latency;
+	}
+}
+
+/******************************************************************************/
+/**
+ * This function acquires the newest written frame, for the application to
+ * read without copying it. The frame is not recycled before it is released
+ * with XVidC_PipeRelease.
+ *
+ * @param	PipePtr is a pointer to the pipeline.
+ *
+ * @return	The published frame if any, else the frame of the reader, or
+ *		NULL if the pipeline is not started.
+ *
+ * @note	Holding the published frame makes the writer drop frames if the
+ *		pool runs out of free frames.
+ *
+*******************************************************************************/
+XVidC_Frame *XVidC_PipeAcquire(XVidC_Pipe *PipePtr)
+{
+	XVidC_Frame *FramePtr;
+
+	Xil_AssertNonvoid(PipePtr != NULL);
+
+	FramePtr = PipePtr->Published;
+	if (FramePtr == NULL) {
+		FramePtr = PipePtr->Port[XVIDC_PIPE_READER].Frame;
+	}
+	if (FramePtr != NULL) {
+		XVidC_BufPoolRef(PipePtr->Pool, FramePtr);
+	}
+
+	return FramePtr;
+}
+
+/******************************************************************************/
+/**
+ * This function releases a frame acquired with XVidC_PipeAcquire.
+ *
+ * @param	PipePtr is a pointer to the pipeline.
+ * @param	FramePtr is a pointer to the frame.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+void XVidC_PipeRelease(XVidC_Pipe *PipePtr, XVidC_Frame *FramePtr)
+{
+	Xil_AssertVoid(PipePtr != NULL);
+
+	XVidC_BufPoolPut(PipePtr->Pool, FramePtr);
+}
+
+/******************************************************************************/
+/**
+ * This function returns the counters of a pipeline.
+ *
+ * @param	PipePtr is a pointer to the pipeline.
+ * @param	StatsPtr is a pointer to the counters, filled on return.
+ *
+ * @return	None.
+ *
+ * @note	The mean latency is TotalLatency / Displayed.
+ *
+*******************************************************************************/
+void XVidC_PipeGetStats(const XVidC_Pipe *PipePtr, XVidC_PipeStats *StatsPtr)
+{
+	Xil_AssertVoid(PipePtr != NULL);
+	Xil_AssertVoid(StatsPtr != NULL);
+
+	*StatsPtr = PipePtr->Stats;
+}
+
+/******************************************************************************/
+/**
+ * This function clears the counters of a pipeline.
+ *
+ * @param	PipePtr is a pointer to the pipeline.
+ *
+ * @return	None.
+ *
+ * @note	None.
+ *
+*******************************************************************************/
+void XVidC_PipeResetStats(XVidC_Pipe *PipePtr)
+{
+	Xil_AssertVoid(PipePtr != NULL);
+
+	(void)memset(&PipePtr->Stats, 0, sizeof(XVidC_PipeStats));
+}
+/** @} */
@@ -0,0 +1,264 @@
+/*******************************************************************************
+* Copyright (C) 2021 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+*******************************************************************************/
+
+/******************************************************************************/
+/**
+ *
+ * @file xvidc_bufpool.h
+ * @addtogroup video_common_v4_13
+ * @{
+ * @details
+ *
+ * Contains the frame buffer pool shared by the video DMA drivers (frame buffer
+ * write/read, VDMA) and the pipeline that hands the frames of a writer to a
+ * reader without copying them.
+ *
+ * <b>Frames and pool</b>
+ *
+ * XVidC_BufPoolInit carves a memory region into NumFrames frames of the same
+ * format. Each XVidC_Frame carries the plane addresses, the stride and the
+ * memory color format of its buffer, a reference count and a completion fence.
+ * XVidC_BufPoolGet returns a free frame holding one reference,
+ * XVidC_BufPoolRef adds one, and XVidC_BufPoolPut drops one and returns the
+ * frame to the pool when the last reference is dropped.
+ *
+ * <b>Fences</b>
+ *
+ * The fence of a frame is armed when the frame is handed to a writer, and
+ * signaled from the done interrupt of the writer, with the time of completion.
+ * Only frames with a signaled fence are handed to a reader or to the
+ * application, see XVidC_PipeAcquire.
+ *
+ * <b>Pipeline</b>
+ *
+ * XVidC_Pipe connects one writer port to one reader port. A port is a callback
+ * that programs the buffer addresses of a frame into the core, e.g.
+ * XVFrmbufWr_PipeSetFrame/XVFrmbufRd_PipeSetFrame with the frame buffer
+ * instance as callback reference. For a VDMA channel in park mode the
+ * application provides a small callback which passes the luma address of the
+ * frame to XAxiVdma_DmaSetBufferAddr. The done callbacks of the cores call
+ * XVidC_PipeWriterDone and XVidC_PipeReaderDone, which follow the model of the
+ * frame buffer drivers: a frame programmed from a done callback is used by the
+ * next frame the core processes.
+ *
+ *   - On writer done, the frame just written is published to the reader, and
+ *     a free frame is programmed into the writer. If no frame is free the
+ *     writer takes back the published frame the reader has not picked, or
+ *     overwrites the frame it just wrote, and the frame is dropped.
+ *   - On reader done, the newest published frame is programmed into the
+ *     reader and the frame read until now is released. If no frame was
+ *     published the reader repeats its frame.
+ *
+ * Three frames keep both cores busy, and a fourth lets the writer run ahead
+ * of a slower reader without dropping. The pipeline counts the captured,
+ * displayed, dropped and repeated frames, and measures the capture to display
+ * latency from the fence time to the start of the display, see
+ * XVidC_PipeGetStats.
+ *
+ * The pool and the pipeline do not access any register, and can be run on a
+ * host.
+ *
+ * @note	The pool and the pipeline are not thread safe. The done callbacks
+ *		must not preempt each other, and the other functions must be
+ *		called with the interrupts of both cores masked.
+ *
+ * <pre>
+ * MODIFICATION HISTORY:
+ *
+ * Ver   Who  Date     Changes
+ * ----- ---- -------- -----------------------------------------------
+ * 4.13  jb   10/18/26 Initial release.
+ * </pre>
+ *
+*******************************************************************************/
+
+#ifndef XVIDC_BUFPOOL_H_
+/* Prevent circular inclusions by using protection macros. */
+#define XVIDC_BUFPOOL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************* Include Files ********************************/
+
+#include "xstatus.h"
+#include "xvidc.h"
+
+/************************** Constant Definitions ******************************/
+
+/** Maximum number of frames of a pool. */
+#define XVIDC_BUFPOOL_MAX_FRAMES	32
+
+/** Fewest frames a pipeline runs with: one per core and one published. */
+#define XVIDC_PIPE_MIN_FRAMES		3
+
+/**
+ * This typedef enumerates the states of a frame completion fence.
+ */
+typedef enum {
+	XVIDC_FENCE_IDLE = 0,	/**< Not handed to a writer. */
+	XVIDC_FENCE_PENDING,	/**< Being written. */
+	XVIDC_FENCE_SIGNALED	/**< Written, the contents are valid. */
+} XVidC_FenceState;
+
+/****************************** Type Definitions ******************************/
+
+/**
+ * This typedef contains the memory layout of the frames of a pool.
+ */
+typedef struct {
+	u32 Width;			/**< Active pixels per line. */
+	u32 Height;			/**< Active lines. */
+	u32 Stride;			/**< Bytes per line, of every plane. */
+	XVidC_ColorFormat ColorFormat;	/**< Memory color format. */
+} XVidC_FrameFormat;
+
+/**
+ * This typedef contains a completion fence.
+ */
+typedef struct {
+	volatile u32 State;	/**< XVidC_FenceState. */
+	u64 Time;		/**< Time of the signal. */
+} XVidC_Fence;
+
+/**
+ * This typedef contains a frame of a pool.
+ */
+typedef struct {
+	UINTPTR LumaAddr;	/**< Luma or packed plane. */
+	UINTPTR ChromaAddr;	/**< UV or U plane, 0 for packed formats. */
+	UINTPTR VChromaAddr;	/**< V plane of 3 planar formats, else 0. */
+	XVidC_FrameFormat Format; /**< Layout of the planes. */
+	u32 Index;		/**< Index of the frame in its pool. */
+	u32 RefCount;		/**< References, 0 when free. */
+	u32 Seq;		/**< Capture sequence number, from 1. */
+	XVidC_Fence Fence;	/**< Signaled when the frame was written. */
+} XVidC_Frame;
+
+/**
+ * This typedef contains a pool of frames.
+ */
+typedef struct {
+	XVidC_Frame *Frames;	/**< Frames of the pool. */
+	u32 NumFrames;		/**< Number of frames. */
+	u32 FreeMask;		/**< Bit per free frame. */
+	u32 FrameSize;		/**< Bytes per frame, all planes. */
+	XVidC_FrameFormat Format; /**< Layout of the frames. */
+} XVidC_BufPool;
+
+/**
+ * Callback type which programs the buffer addresses of a frame into a core.
+ *
+ * @param	CallbackRef is the reference passed to XVidC_PipeSetPort.
+ * @param	FramePtr is the frame to program.
+ */
+typedef void (*XVidC_PipeSetFrameFn)(void *CallbackRef,
+		const XVidC_Frame *FramePtr);
+
+/**
+ * Callback type which returns the current time, in any unit. The latencies
+ * are reported in this unit.
+ */
+typedef u64 (*XVidC_TimeFn)(void);
+
+/**
+ * This typedef enumerates the ports of a pipeline.
+ */
+typedef enum {
+	XVIDC_PIPE_WRITER = 0,	/**< Writes the frames, e.g. capture. */
+	XVIDC_PIPE_READER	/**< Reads the frames, e.g. display. */
+} XVidC_PipePortId;
+
+/**
+ * This typedef contains a port of a pipeline.
+ */
+typedef struct {
+	XVidC_PipeSetFrameFn SetFrame;	/**< Programs a frame. */
+	void *CallbackRef;		/**< Reference of SetFrame. */
+	XVidC_Frame *Frame;		/**< Frame in use by the core. */
+} XVidC_PipePort;
+
+/**
+ * This typedef contains the counters of a pipeline.
+ */
+typedef struct {
+	u32 Captured;		/**< Frames written and published. */
+	u32 Displayed;		/**< Published frames handed to the reader. */
+	u32 WriterDrops;	/**< Written frames overwritten, no free frame. */
+	u32 ReaderDrops;	/**< Published frames superseded unread. */
+	u32 Repeats;		/**< Reader frames repeated, nothing published. */
+	u64 LastLatency;	/**< Capture to display latency of the last. */
+	u64 MinLatency;		/**< Smallest latency. */
+	u64 MaxLatency;		/**< Largest latency. */
+	u64 TotalLatency;	/**< Sum of the latencies, of Displayed frames. */
+} XVidC_PipeStats;
+
+/**
+ * This typedef contains a writer to reader pipeline.
+ */
+typedef struct {
+	XVidC_BufPool *Pool;		/**< Pool of the frames. */
+	XVidC_TimeFn GetTime;		/**< Time source, NULL for none. */
+	XVidC_PipePort Port[2];		/**< Writer and reader ports. */
+	XVidC_Frame *Published;		/**< Newest written frame, unread. */
+	u32 Seq;			/**< Sequence number of the last frame. */
+	XVidC_PipeStats Stats;		/**< Counters. */
+} XVidC_Pipe;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/******************************************************************************/
+/**
+ * This macro checks whether the fence of a frame is signaled, i.e. whether the
+ * writer completed the frame.
+ *
+ * @param	FramePtr is a pointer to the frame.
+ *
+ * @return	TRUE if signaled, else FALSE.
+ *
+ * @note	C-style signature:
+ *		u32 XVidC_FrameIsDone(const XVidC_Frame *FramePtr)
+ *
+*******************************************************************************/
+#define XVidC_FrameIsDone(FramePtr) \
+	((FramePtr)->Fence.State == XVIDC_FENCE_SIGNALED)
+
+/**************************** Function Prototypes *****************************/
+
+/* Pool. */
+u32 XVidC_GetFrameSize(const XVidC_FrameFormat *FormatPtr);
+int XVidC_BufPoolInit(XVidC_BufPool *PoolPtr, XVidC_Frame *Frames,
+		u32 NumFrames, const XVidC_FrameFormat *FormatPtr,
+		UINTPTR BaseAddr, u32 MemSize);
+XVidC_Frame *XVidC_BufPoolGet(XVidC_BufPool *PoolPtr);
+void XVidC_BufPoolRef(XVidC_BufPool *PoolPtr, XVidC_Frame *FramePtr);
+void XVidC_BufPoolPut(XVidC_BufPool *PoolPtr, XVidC_Frame *FramePtr);
+u32 XVidC_BufPoolNumFree(const XVidC_BufPool *PoolPtr);
+
+/* Fences. */
+void XVidC_FenceArm(XVidC_Fence *FencePtr);
+void XVidC_FenceSignal(XVidC_Fence *FencePtr, u64 Time);
+
+/* Pipeline. */
+int XVidC_PipeInit(XVidC_Pipe *PipePtr, XVidC_BufPool *PoolPtr,
+		XVidC_TimeFn GetTime);
+void XVidC_PipeSetPort(XVidC_Pipe *PipePtr, XVidC_PipePortId PortId,
+		XVidC_PipeSetFrameFn SetFrame, void *CallbackRef);
+int XVidC_PipeStart(XVidC_Pipe *PipePtr);
+void XVidC_PipeStop(XVidC_Pipe *PipePtr);
+void XVidC_PipeWriterDone(XVidC_Pipe *PipePtr);
+void XVidC_PipeReaderDone(XVidC_Pipe *PipePtr);
+XVidC_Frame *XVidC_PipeAcquire(XVidC_Pipe *PipePtr);
+void XVidC_PipeRelease(XVidC_Pipe *PipePtr, XVidC_Frame *FramePtr);
+void XVidC_PipeGetStats(const XVidC_Pipe *PipePtr, XVidC_PipeStats *StatsPtr);
+void XVidC_PipeResetStats(XVidC_Pipe *PipePtr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XVIDC_BUFPOOL_H_ */
+/** @} */
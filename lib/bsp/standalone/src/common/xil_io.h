@@ -32,6 +32,8 @@
 * 7.50  dp       02/12/21 Fix compilation error in Xil_EndianSwap32() that occur
 *                         when -Werror=conversion compiler flag is enabled
 * 7.5   mus      05/17/21 Update the functions with comments. It fixes CR#1067739.
+* 7.7   jb       10/18/26 Added XIL_IO_SIM flag to route the register accesses
+*                         to the host register models of src/sim.
 *
 * </pre>
 ******************************************************************************/
@@ -55,6 +57,10 @@ extern "C" {
 #include "xpseudo_asm.h"
 #endif
 
+#ifdef XIL_IO_SIM
+#include "xil_io_sim.h"
+#endif
+
 /************************** Function Prototypes ******************************/
 #ifdef ENABLE_SAFETY
 extern u32 XStl_RegUpdate(u32 RegAddr, u32 RegVal);
@@ -99,7 +105,11 @@ extern u32 XStl_RegUpdate(u32 RegAddr, u32 RegVal);
 ******************************************************************************/
 static INLINE u8 Xil_In8(UINTPTR Addr)
 {
+#ifdef XIL_IO_SIM
+	return (u8)Xil_SimIn(Addr, 8U);
+#else
 	return *(volatile u8 *) Addr;
+#endif
 }
 
 /*****************************************************************************/
@@ -116,7 +126,11 @@ static INLINE u8 Xil_In8(UINTPTR Addr)
 ******************************************************************************/
 static INLINE u16 Xil_In16(UINTPTR Addr)
 {
+#ifdef XIL_IO_SIM
+	return (u16)Xil_SimIn(Addr, 16U);
+#else
 	return *(volatile u16 *) Addr;
+#endif
 }
 
 /*****************************************************************************/
@@ -133,7 +147,11 @@ static INLINE u16 Xil_In16(UINTPTR Addr)
 ******************************************************************************/
 static INLINE u32 Xil_In32(UINTPTR Addr)
 {
+#ifdef XIL_IO_SIM
+	return (u32)Xil_SimIn(Addr, 32U);
+#else
 	return *(volatile u32 *) Addr;
+#endif
 }
 
 /*****************************************************************************/
@@ -150,7 +168,11 @@ static INLINE u32 Xil_In32(UINTPTR Addr)
 ******************************************************************************/
 static INLINE u64 Xil_In64(UINTPTR Addr)
 {
+#ifdef XIL_IO_SIM
+	return Xil_SimIn(Addr, 64U);
+#else
 	return *(volatile u64 *) Addr;
+#endif
 }
 
 /*****************************************************************************/
@@ -169,8 +191,12 @@ static INLINE u64 Xil_In64(UINTPTR Addr)
 static INLINE void Xil_Out8(UINTPTR Addr, u8 Value)
 {
 	/* write 8 bit value to specified address */
+#ifdef XIL_IO_SIM
+	Xil_SimOut(Addr, Value, 8U);
+#else
 	volatile u8 *LocalAddr = (volatile u8 *)Addr;
 	*LocalAddr = Value;
+#endif
 }
 
 /*****************************************************************************/
@@ -188,8 +214,12 @@ static INLINE void Xil_Out8(UINTPTR Addr, u8 Value)
 static INLINE void Xil_Out16(UINTPTR Addr, u16 Value)
 {
 	/* write 16 bit value to specified address */
+#ifdef XIL_IO_SIM
+	Xil_SimOut(Addr, Value, 16U);
+#else
 	volatile u16 *LocalAddr = (volatile u16 *)Addr;
 	*LocalAddr = Value;
+#endif
 }
 
 /*****************************************************************************/
@@ -208,7 +238,9 @@ static INLINE void Xil_Out16(UINTPTR Addr, u16 Value)
 static INLINE void Xil_Out32(UINTPTR Addr, u32 Value)
 {
 	/* write 32 bit value to specified address */
-#ifndef ENABLE_SAFETY
+#if defined (XIL_IO_SIM)
+	Xil_SimOut(Addr, Value, 32U);
+#elif !defined (ENABLE_SAFETY)
 	volatile u32 *LocalAddr = (volatile u32 *)Addr;
 	*LocalAddr = Value;
 #else
@@ -231,8 +263,12 @@ static INLINE void Xil_Out32(UINTPTR Addr, u32 Value)
 static INLINE void Xil_Out64(UINTPTR Addr, u64 Value)
 {
 	/* write 64 bit value to specified address */
+#ifdef XIL_IO_SIM
+	Xil_SimOut(Addr, Value, 64U);
+#else
 	volatile u64 *LocalAddr = (volatile u64 *)Addr;
 	*LocalAddr = Value;
+#endif
 }
 
 /*****************************************************************************/
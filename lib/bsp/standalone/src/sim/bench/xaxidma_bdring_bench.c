@@ -0,0 +1,340 @@
+/******************************************************************************
+* Copyright (c) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xaxidma_bdring_bench.c
+*
+* Host benchmark of the buffer descriptor ring management of the AXI DMA
+* driver, against the register model of xaxidma_sim.c.
+*
+* Both channels run in scatter gather mode. For a few batch sizes, the
+* benchmark cycles the descriptors of each ring through XAxiDma_BdRingAlloc,
+* XAxiDma_BdRingToHw, XAxiDma_BdRingFromHw and XAxiDma_BdRingFree, checks
+* the status written back by the model, and reports the time per descriptor
+* of each step with the register accesses, the cache maintenance operations
+* and the barriers issued per descriptor.
+*
+* Usage: xaxidma_bdring_bench [descriptors per measure] [ring size]
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 7.7   jb   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "xaxidma.h"
+#include "xtime_l.h"
+#include "xaxidma_sim.h"
+#include "xaxidma_bench.h"
+
+/************************** Constant Definitions *****************************/
+
+#define BENCH_BUF_SIZE		2048U
+#define BENCH_DEF_BDS		(1024U * 1024U)
+#define BENCH_DEF_RING		1024U
+
+/* Steps of a descriptor through the ring */
+#define BENCH_ALLOC		0U
+#define BENCH_TOHW		1U
+#define BENCH_FROMHW		2U
+#define BENCH_FREE		3U
+#define BENCH_NUM_STEPS		4U
+
+/**************************** Type Definitions *******************************/
+
+typedef struct {
+	XTime Time;
+	Xil_SimStats Stats;
+} Bench_Step;
+
+/************************** Variable Definitions *****************************/
+
+static const char8 *Bench_StepNames[BENCH_NUM_STEPS] = {
+	"alloc", "to-hw", "from-hw", "free"
+};
+
+static XAxiDma Bench_Dma;
+static XAxiDma_Sim Bench_Sim;
+
+/*****************************************************************************/
+/**
+* Accumulates the time and the backend counters of a step.
+*
+* @param	StepPtr is a pointer to the step.
+* @param	Start is the time at the start of the step.
+* @param	StartStats is a pointer to the counters at the start of the step.
+*
+* @return	None.
+*
+******************************************************************************/
+static void Bench_EndStep(Bench_Step *StepPtr, XTime Start,
+			  const Xil_SimStats *StartStats)
+{
+	Xil_SimStats Stats;
+	XTime End;
+
+	XTime_GetTime(&End);
+	Xil_SimGetStats(&Stats);
+	StepPtr->Time += End - Start;
+	StepPtr->Stats.RegReads += Stats.RegReads - StartStats->RegReads;
+	StepPtr->Stats.RegWrites += Stats.RegWrites - StartStats->RegWrites;
+	StepPtr->Stats.DCacheFlushes +=
+		Stats.DCacheFlushes - StartStats->DCacheFlushes;
+	StepPtr->Stats.DCacheInvalidates +=
+		Stats.DCacheInvalidates - StartStats->DCacheInvalidates;
+	StepPtr->Stats.Barriers += Stats.Barriers - StartStats->Barriers;
+}
+
+/*****************************************************************************/
+/**
+* Sets up a ring over a block of descriptors and starts its channel.
+*
+* @param	RingPtr is a pointer to the ring.
+* @param	NumBds is the number of descriptors of the ring.
+*
+* @return	XST_SUCCESS, or an error of the driver.
+*
+******************************************************************************/
+static int Bench_SetupRing(XAxiDma_BdRing *RingPtr, u32 NumBds)
+{
+	UINTPTR BdSpace;
+
+	BdSpace = (UINTPTR)Bench_Alloc(XAxiDma_BdRingMemCalc(
+				XAXIDMA_BD_MINIMUM_ALIGNMENT, NumBds));
+	if (BdSpace == 0U) {
+		return XST_FAILURE;
+	}
+
+	return Bench_StartRing(RingPtr, BdSpace, NumBds);
+}
+
+/*****************************************************************************/
+/**
+* Cycles descriptors through a ring, in batches of a given size.
+*
+* @param	RingPtr is a pointer to the ring.
+* @param	Buffers is the block of buffers of the ring.
+* @param	Batch is the number of descriptors per batch.
+* @param	NumBds is the number of descriptors to cycle.
+* @param	Steps is the array of the steps, updated on return.
+*
+* @return	XST_SUCCESS, or XST_FAILURE if a step failed.
+*
+******************************************************************************/
+static int Bench_RunRing(XAxiDma_BdRing *RingPtr, u8 *Buffers, u32 Batch,
+			 u32 NumBds, Bench_Step *Steps)
+{
+	XAxiDma_Bd *BdPtr;
+	XAxiDma_Bd *CurBdPtr;
+	Xil_SimStats Stats;
+	XTime Start;
+	u32 Done;
+	u32 Index;
+	u32 Len;
+	u32 Ctrl;
+	int Num;
+	int Status;
+
+	for (Done = 0U; Done < NumBds; Done += Batch) {
+		Xil_SimGetStats(&Stats);
+		XTime_GetTime(&Start);
+		Status = XAxiDma_BdRingAlloc(RingPtr, (int)Batch, &BdPtr);
+		Bench_EndStep(&Steps[BENCH_ALLOC], Start, &Stats);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+
+		/* Prepare the descriptors, one packet per batch */
+		CurBdPtr = BdPtr;
+		for (Index = 0U; Index < Batch; Index++) {
+			Len = 64U + ((Done + Index) % (BENCH_BUF_SIZE - 64U));
+			/* Each descriptor has its own buffer */
+			(void)XAxiDma_BdSetBufAddr(CurBdPtr, (UINTPTR)Buffers +
+				(((UINTPTR)CurBdPtr - RingPtr->FirstBdAddr) /
+				 RingPtr->Separation) * BENCH_BUF_SIZE);
+			(void)XAxiDma_BdSetLength(CurBdPtr, Len,
+						  RingPtr->MaxTransferLen);
+			Ctrl = 0U;
+			if (Index == 0U) {
+				Ctrl |= XAXIDMA_BD_CTRL_TXSOF_MASK;
+			}
+			if (Index == (Batch - 1U)) {
+				Ctrl |= XAXIDMA_BD_CTRL_TXEOF_MASK;
+			}
+			XAxiDma_BdSetCtrl(CurBdPtr,
+					  RingPtr->IsRxChannel ? 0U : Ctrl);
+			XAxiDma_BdSetId(CurBdPtr, Len);
+			CurBdPtr = (XAxiDma_Bd *)
+				XAxiDma_BdRingNext(RingPtr, CurBdPtr);
+		}
+
+		Xil_SimGetStats(&Stats);
+		XTime_GetTime(&Start);
+		Status = XAxiDma_BdRingToHw(RingPtr, (int)Batch, BdPtr);
+		Bench_EndStep(&Steps[BENCH_TOHW], Start, &Stats);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+
+		Xil_SimGetStats(&Stats);
+		XTime_GetTime(&Start);
+		Num = XAxiDma_BdRingFromHw(RingPtr, XAXIDMA_ALL_BDS, &BdPtr);
+		Bench_EndStep(&Steps[BENCH_FROMHW], Start, &Stats);
+		if (Num != (int)Batch) {
+			return XST_FAILURE;
+		}
+
+		/* Check the status written back by the model */
+		CurBdPtr = BdPtr;
+		for (Index = 0U; Index < Batch; Index++) {
+			if (((XAxiDma_BdGetSts(CurBdPtr) &
+			      XAXIDMA_BD_STS_COMPLETE_MASK) == 0U) ||
+			    (XAxiDma_BdGetActualLength(CurBdPtr,
+					RingPtr->MaxTransferLen) !=
+			     (u32)XAxiDma_BdGetId(CurBdPtr))) {
+				return XST_FAILURE;
+			}
+			CurBdPtr = (XAxiDma_Bd *)
+				XAxiDma_BdRingNext(RingPtr, CurBdPtr);
+		}
+
+		Xil_SimGetStats(&Stats);
+		XTime_GetTime(&Start);
+		Status = XAxiDma_BdRingFree(RingPtr, Num, BdPtr);
+		Bench_EndStep(&Steps[BENCH_FREE], Start, &Stats);
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Prints the time and the operations per descriptor of each step.
+*
+* @param	Name is the name of the ring.
+* @param	Batch is the number of descriptors per batch.
+* @param	NumBds is the number of descriptors cycled.
+* @param	Steps is the array of the steps.
+*
+* @return	None.
+*
+******************************************************************************/
+static void Bench_Report(const char8 *Name, u32 Batch, u32 NumBds,
+			 const Bench_Step *Steps)
+{
+	double Bds = (double)NumBds;
+	u32 Index;
+
+	for (Index = 0U; Index < BENCH_NUM_STEPS; Index++) {
+		printf("%s batch %3u %-7s %7.1f ns/bd  reg rd %.3f wr %.3f  "
+		       "flush %.3f inval %.3f  barrier %.3f\n",
+		       Name, Batch, Bench_StepNames[Index],
+		       (double)Steps[Index].Time * 1e9 / COUNTS_PER_SECOND / Bds,
+		       (double)Steps[Index].Stats.RegReads / Bds,
+		       (double)Steps[Index].Stats.RegWrites / Bds,
+		       (double)Steps[Index].Stats.DCacheFlushes / Bds,
+		       (double)Steps[Index].Stats.DCacheInvalidates / Bds,
+		       (double)Steps[Index].Stats.Barriers / Bds);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	static const u32 Batches[] = { 1U, 8U, 64U };
+	XAxiDma_BdRing *Rings[2];
+	const char8 *Names[2] = { "tx", "rx" };
+	Bench_Step Steps[BENCH_NUM_STEPS];
+	u8 *Buffers;
+	u32 NumBds = BENCH_DEF_BDS;
+	u32 RingSize = BENCH_DEF_RING;
+	u32 Batch;
+	u32 Index;
+	u32 Ring;
+	int Status;
+
+	if (argc > 1) {
+		NumBds = (u32)strtoul(argv[1], NULL, 0);
+	}
+	if (argc > 2) {
+		RingSize = (u32)strtoul(argv[2], NULL, 0);
+	}
+	if ((NumBds == 0U) ||
+	    (RingSize < Batches[(sizeof(Batches) / sizeof(Batches[0])) - 1U])) {
+		fprintf(stderr, "descriptors > 0, ring size >= %u\n",
+			Batches[(sizeof(Batches) / sizeof(Batches[0])) - 1U]);
+		return 1;
+	}
+
+	Status = XAxiDma_SimInit(&Bench_Sim, Bench_Config.BaseAddr, TRUE);
+	if (Status != XST_SUCCESS) {
+		fprintf(stderr, "failed to register the DMA model\n");
+		return 1;
+	}
+
+	Status = XAxiDma_CfgInitialize(&Bench_Dma, &Bench_Config);
+	Rings[0] = XAxiDma_GetTxRing(&Bench_Dma);
+	Rings[1] = XAxiDma_GetRxRing(&Bench_Dma);
+	Buffers = Bench_Alloc((size_t)RingSize * BENCH_BUF_SIZE);
+	if ((Status != XST_SUCCESS) || (Buffers == NULL)) {
+		fprintf(stderr, "failed to initialize the DMA: %d\n", Status);
+		goto END;
+	}
+
+	for (Ring = 0U; Ring < 2U; Ring++) {
+		Status = Bench_SetupRing(Rings[Ring], RingSize);
+		if (Status != XST_SUCCESS) {
+			fprintf(stderr, "failed to set up the %s ring: %d\n",
+				Names[Ring], Status);
+			goto END;
+		}
+	}
+
+	for (Index = 0U; Index < (sizeof(Batches) / sizeof(Batches[0]));
+	     Index++) {
+		Batch = Batches[Index];
+		for (Ring = 0U; Ring < 2U; Ring++) {
+			(void)memset(Steps, 0, sizeof(Steps));
+			Status = Bench_RunRing(Rings[Ring], Buffers, Batch,
+					       NumBds - (NumBds % Batch), Steps);
+			if (Status != XST_SUCCESS) {
+				fprintf(stderr, "%s ring failed, batch %u\n",
+					Names[Ring], Batch);
+				goto END;
+			}
+			Bench_Report(Names[Ring], Batch,
+				     NumBds - (NumBds % Batch), Steps);
+		}
+	}
+
+	/* All the descriptors went back to the free group, the rings can
+	 * only be checked once the engine is halted */
+	XAxiDma_Reset(&Bench_Dma);
+	while (!XAxiDma_ResetIsDone(&Bench_Dma)) {
+	}
+	for (Ring = 0U; Ring < 2U; Ring++) {
+		if ((XAxiDma_BdRingGetFreeCnt(Rings[Ring]) != (int)RingSize) ||
+		    (XAxiDma_BdRingCheck(Rings[Ring]) != XST_SUCCESS)) {
+			fprintf(stderr, "%s ring inconsistent\n", Names[Ring]);
+			Status = XST_FAILURE;
+		}
+	}
+
+END:
+	XAxiDma_SimRemove(&Bench_Sim);
+	return (Status == XST_SUCCESS) ? 0 : 1;
+}
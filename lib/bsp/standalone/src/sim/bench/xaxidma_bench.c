@@ -0,0 +1,110 @@
+/******************************************************************************
+* Copyright (c) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xaxidma_bench.c
+*
+* Setup shared by the host benchmarks of the AXI DMA driver, see
+* xaxidma_bench.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 7.7   jb   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <sys/mman.h>
+#include "xaxidma_bench.h"
+
+/************************** Variable Definitions *****************************/
+
+/* Both channels in scatter gather mode, with a 32 bit address width */
+XAxiDma_Config Bench_Config = {
+	.DeviceId = 0U,
+	.BaseAddr = BENCH_DMA_BASEADDR,
+	.HasStsCntrlStrm = 0,
+	.HasMm2S = 1,
+	.HasMm2SDRE = 0,
+	.Mm2SDataWidth = 32,
+	.HasS2Mm = 1,
+	.HasS2MmDRE = 0,
+	.S2MmDataWidth = 32,
+	.HasSg = 1,
+	.Mm2sNumChannels = 1,
+	.S2MmNumChannels = 1,
+	.Mm2SBurstSize = 16,
+	.S2MmBurstSize = 16,
+	.MicroDmaMode = 0,
+	.AddrWidth = 32,
+	.SgLengthWidth = 23,
+};
+
+/*****************************************************************************/
+/**
+* Allocates memory that the driver can address, in the low 4GB of the host
+* address space as the driver is built for a 32 bit address width.
+*
+* @param	Size is the size to allocate.
+*
+* @return	The memory, or NULL on failure.
+*
+******************************************************************************/
+void *Bench_Alloc(size_t Size)
+{
+	void *Ptr;
+	int Flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+#ifdef MAP_32BIT
+	if (sizeof(UINTPTR) > 4U) {
+		Flags |= MAP_32BIT;
+	}
+#endif
+	Ptr = mmap(NULL, Size, PROT_READ | PROT_WRITE, Flags, -1, 0);
+	if ((Ptr == MAP_FAILED) ||
+	    ((((u64)(UINTPTR)Ptr + Size) >> 32U) != 0U)) {
+		return NULL;
+	}
+
+	return Ptr;
+}
+
+/*****************************************************************************/
+/**
+* Sets up a ring over a block of descriptors and starts its channel.
+*
+* @param	RingPtr is a pointer to the ring.
+* @param	BdSpace is the block of descriptors, from Bench_Alloc().
+* @param	NumBds is the number of descriptors of the ring.
+*
+* @return	XST_SUCCESS, or an error of the driver.
+*
+******************************************************************************/
+int Bench_StartRing(XAxiDma_BdRing *RingPtr, UINTPTR BdSpace, u32 NumBds)
+{
+	XAxiDma_Bd BdTemplate;
+	int Status;
+
+	Status = XAxiDma_BdRingCreate(RingPtr, BdSpace, BdSpace,
+				      XAXIDMA_BD_MINIMUM_ALIGNMENT, NumBds);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	XAxiDma_BdClear(&BdTemplate);
+	Status = XAxiDma_BdRingClone(RingPtr, &BdTemplate);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+
+	return XAxiDma_BdRingStart(RingPtr);
+}
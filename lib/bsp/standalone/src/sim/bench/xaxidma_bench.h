@@ -0,0 +1,53 @@
+/******************************************************************************
+* Copyright (c) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xaxidma_bench.h
+*
+* Setup shared by the host benchmarks of the AXI DMA driver: the
+* configuration of the DMA against the register model of xaxidma_sim.c, the
+* allocation of memory the driver can address, and the setup of a ring.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 7.7   jb   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+#ifndef XAXIDMA_BENCH_H_
+#define XAXIDMA_BENCH_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+
+#include <stddef.h>
+#include "xaxidma.h"
+
+/************************** Constant Definitions *****************************/
+
+#define BENCH_DMA_BASEADDR	0x40400000U	/* Not mapped on the host */
+
+/************************** Variable Definitions *****************************/
+
+extern XAxiDma_Config Bench_Config;
+
+/************************** Function Prototypes ******************************/
+
+void *Bench_Alloc(size_t Size);
+int Bench_StartRing(XAxiDma_BdRing *RingPtr, UINTPTR BdSpace, u32 NumBds);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XAXIDMA_BENCH_H_ */
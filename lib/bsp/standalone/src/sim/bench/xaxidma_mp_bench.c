@@ -0,0 +1,398 @@
+/******************************************************************************
+* Copyright (c) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xaxidma_mp_bench.c
+*
+* Host benchmark of the submission of packets to one AXI DMA channel by
+* several threads, against the register model of xaxidma_sim.c.
+*
+* Each producer thread submits packets to the MM2S ring while a consumer
+* thread retrieves and releases the completed descriptors, as the interrupt
+* handler of the channel would. The benchmark compares the BD ring functions
+* serialized by a mutex with the concurrent submission mode of
+* XAxiDma_BdRingMpInit(), for 1, 2 and 4 producers. It reports the packet
+* rate, the mean and the worst submission latency of a producer, and the
+* tail descriptor writes per packet.
+*
+* Usage: xaxidma_mp_bench [packets per producer] [ring size] [bds per packet]
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 7.7   jb   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include "xaxidma.h"
+#include "xtime_l.h"
+#include "xaxidma_sim.h"
+#include "xaxidma_bench.h"
+
+/************************** Constant Definitions *****************************/
+
+#define BENCH_BUF_SIZE		2048U
+#define BENCH_DEF_PKTS		(256U * 1024U)
+#define BENCH_DEF_RING		1024U
+#define BENCH_DEF_PKT_BDS	2U
+#define BENCH_MAX_PRODUCERS	4U
+
+/**************************** Type Definitions *******************************/
+
+/* State of a producer thread */
+typedef struct {
+	pthread_t Thread;
+	XTime Time;		/* Total submission time */
+	XTime MaxTime;		/* Worst submission time of a packet */
+	int Status;
+} Bench_Producer;
+
+/************************** Variable Definitions *****************************/
+
+static XAxiDma Bench_Dma;
+static XAxiDma_Sim Bench_Sim;
+static UINTPTR Bench_BdSpace;
+static u8 *Bench_Buffer;
+
+/* Parameters of the current run */
+static XAxiDma_BdRing *Bench_Ring;
+static int Bench_Concurrent;
+static u32 Bench_Pkts;
+static u32 Bench_PktBds;
+static u32 Bench_NumProducers;
+
+/* Serializes the BD ring functions when not in concurrent mode */
+static pthread_mutex_t Bench_Lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*****************************************************************************/
+/**
+* Reserves the descriptors of a packet, waiting for the consumer to release
+* some if the ring is full.
+*
+* @param	BdPtrPtr is an output parameter, the first descriptor.
+*
+* @return	XST_SUCCESS, or an error of the driver.
+*
+******************************************************************************/
+static int Bench_AllocPkt(XAxiDma_Bd **BdPtrPtr)
+{
+	int Status;
+
+	for (;;) {
+		if (Bench_Concurrent != 0) {
+			Status = XAxiDma_BdRingMpAlloc(Bench_Ring,
+						       (int)Bench_PktBds,
+						       BdPtrPtr);
+		} else {
+			(void)pthread_mutex_lock(&Bench_Lock);
+			Status = XAxiDma_BdRingAlloc(Bench_Ring,
+						     (int)Bench_PktBds,
+						     BdPtrPtr);
+			(void)pthread_mutex_unlock(&Bench_Lock);
+		}
+		if (Status != XST_FAILURE) {
+			return Status;
+		}
+		(void)sched_yield();
+	}
+}
+
+/*****************************************************************************/
+/**
+* Producer thread, submits its packets one by one.
+*
+* @param	Arg is a pointer to the state of the producer.
+*
+* @return	NULL.
+*
+******************************************************************************/
+static void *Bench_ProducerThread(void *Arg)
+{
+	Bench_Producer *ProdPtr = (Bench_Producer *)Arg;
+	XAxiDma_Bd *BdPtr;
+	XAxiDma_Bd *CurBdPtr;
+	XTime Start;
+	XTime End;
+	u32 Ctrl;
+	u32 Pkt;
+	u32 Index;
+
+	for (Pkt = 0U; Pkt < Bench_Pkts; Pkt++) {
+		ProdPtr->Status = Bench_AllocPkt(&BdPtr);
+		if (ProdPtr->Status != XST_SUCCESS) {
+			break;
+		}
+
+		CurBdPtr = BdPtr;
+		for (Index = 0U; Index < Bench_PktBds; Index++) {
+			(void)XAxiDma_BdSetBufAddr(CurBdPtr,
+						   (UINTPTR)Bench_Buffer);
+			(void)XAxiDma_BdSetLength(CurBdPtr, 64U + Index,
+						  Bench_Ring->MaxTransferLen);
+			Ctrl = 0U;
+			if (Index == 0U) {
+				Ctrl |= XAXIDMA_BD_CTRL_TXSOF_MASK;
+			}
+			if (Index == (Bench_PktBds - 1U)) {
+				Ctrl |= XAXIDMA_BD_CTRL_TXEOF_MASK;
+			}
+			XAxiDma_BdSetCtrl(CurBdPtr, Ctrl);
+			CurBdPtr = (XAxiDma_Bd *)
+				XAxiDma_BdRingNext(Bench_Ring, CurBdPtr);
+		}
+
+		XTime_GetTime(&Start);
+		if (Bench_Concurrent != 0) {
+			ProdPtr->Status = XAxiDma_BdRingMpToHw(Bench_Ring,
+						(int)Bench_PktBds, BdPtr);
+		} else {
+			(void)pthread_mutex_lock(&Bench_Lock);
+			ProdPtr->Status = XAxiDma_BdRingToHw(Bench_Ring,
+						(int)Bench_PktBds, BdPtr);
+			(void)pthread_mutex_unlock(&Bench_Lock);
+		}
+		XTime_GetTime(&End);
+		if (ProdPtr->Status != XST_SUCCESS) {
+			break;
+		}
+
+		ProdPtr->Time += End - Start;
+		if ((End - Start) > ProdPtr->MaxTime) {
+			ProdPtr->MaxTime = End - Start;
+		}
+	}
+
+	return NULL;
+}
+
+/*****************************************************************************/
+/**
+* Retrieves and releases the completed descriptors of all the producers.
+*
+* @return	XST_SUCCESS, or XST_FAILURE if a descriptor is not complete or
+*		could not be released.
+*
+******************************************************************************/
+static int Bench_Consume(void)
+{
+	u64 Total = (u64)Bench_Pkts * Bench_PktBds * Bench_NumProducers;
+	u64 Done = 0U;
+	XAxiDma_Bd *BdPtr;
+	XAxiDma_Bd *CurBdPtr;
+	int Num;
+	int Index;
+	int Status;
+
+	while (Done < Total) {
+		if (Bench_Concurrent != 0) {
+			Num = XAxiDma_BdRingMpFromHw(Bench_Ring,
+						     XAXIDMA_ALL_BDS, &BdPtr);
+		} else {
+			(void)pthread_mutex_lock(&Bench_Lock);
+			Num = XAxiDma_BdRingFromHw(Bench_Ring,
+						   XAXIDMA_ALL_BDS, &BdPtr);
+			(void)pthread_mutex_unlock(&Bench_Lock);
+		}
+		if (Num == 0) {
+			(void)sched_yield();
+			continue;
+		}
+
+		CurBdPtr = BdPtr;
+		for (Index = 0; Index < Num; Index++) {
+			if ((XAxiDma_BdGetSts(CurBdPtr) &
+			     XAXIDMA_BD_STS_COMPLETE_MASK) == 0U) {
+				return XST_FAILURE;
+			}
+			CurBdPtr = (XAxiDma_Bd *)
+				XAxiDma_BdRingNext(Bench_Ring, CurBdPtr);
+		}
+
+		if (Bench_Concurrent != 0) {
+			Status = XAxiDma_BdRingMpFree(Bench_Ring, Num, BdPtr);
+		} else {
+			(void)pthread_mutex_lock(&Bench_Lock);
+			Status = XAxiDma_BdRingFree(Bench_Ring, Num, BdPtr);
+			(void)pthread_mutex_unlock(&Bench_Lock);
+		}
+		if (Status != XST_SUCCESS) {
+			return XST_FAILURE;
+		}
+		Done += (u64)Num;
+	}
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+* Sets up the MM2S ring over the descriptor block and starts its channel,
+* after a reset of the DMA.
+*
+* @param	RingSize is the number of descriptors of the ring.
+*
+* @return	XST_SUCCESS, or an error of the driver.
+*
+******************************************************************************/
+static int Bench_SetupRing(u32 RingSize)
+{
+	int Status;
+
+	Status = XAxiDma_CfgInitialize(&Bench_Dma, &Bench_Config);
+	if (Status != XST_SUCCESS) {
+		return Status;
+	}
+	Bench_Ring = XAxiDma_GetTxRing(&Bench_Dma);
+
+	Status = Bench_StartRing(Bench_Ring, Bench_BdSpace, RingSize);
+	if ((Status != XST_SUCCESS) || (Bench_Concurrent == 0)) {
+		return Status;
+	}
+
+	return XAxiDma_BdRingMpInit(Bench_Ring);
+}
+
+/*****************************************************************************/
+/**
+* Runs the producers and the consumer, and prints the results of the run.
+*
+* @param	RingSize is the number of descriptors of the ring.
+*
+* @return	XST_SUCCESS, or XST_FAILURE if the run failed.
+*
+******************************************************************************/
+static int Bench_Run(u32 RingSize)
+{
+	Bench_Producer Producers[BENCH_MAX_PRODUCERS];
+	u64 TotalPkts = (u64)Bench_Pkts * Bench_NumProducers;
+	XTime Start;
+	XTime End;
+	XTime Time = 0U;
+	XTime MaxTime = 0U;
+	u32 Index;
+	int Status;
+
+	Status = Bench_SetupRing(RingSize);
+	if (Status != XST_SUCCESS) {
+		fprintf(stderr, "failed to set up the ring: %d\n", Status);
+		return XST_FAILURE;
+	}
+	Bench_Sim.Chan[XAXIDMA_DMA_TO_DEVICE].TailWrites = 0U;
+	Bench_Sim.Chan[XAXIDMA_DMA_TO_DEVICE].BdCount = 0U;
+
+	(void)memset(Producers, 0, sizeof(Producers));
+	XTime_GetTime(&Start);
+	for (Index = 0U; Index < Bench_NumProducers; Index++) {
+		if (pthread_create(&Producers[Index].Thread, NULL,
+				   Bench_ProducerThread,
+				   &Producers[Index]) != 0) {
+			fprintf(stderr, "failed to start a producer\n");
+			exit(1);
+		}
+	}
+	Status = Bench_Consume();
+	for (Index = 0U; Index < Bench_NumProducers; Index++) {
+		(void)pthread_join(Producers[Index].Thread, NULL);
+		if (Producers[Index].Status != XST_SUCCESS) {
+			Status = XST_FAILURE;
+		}
+		Time += Producers[Index].Time;
+		if (Producers[Index].MaxTime > MaxTime) {
+			MaxTime = Producers[Index].MaxTime;
+		}
+	}
+	XTime_GetTime(&End);
+
+	if ((Status != XST_SUCCESS) ||
+	    (Bench_Sim.Chan[XAXIDMA_DMA_TO_DEVICE].BdCount !=
+	     TotalPkts * Bench_PktBds)) {
+		fprintf(stderr, "%s run failed, %u producers\n",
+			(Bench_Concurrent != 0) ? "lock-free" : "locked",
+			Bench_NumProducers);
+		return XST_FAILURE;
+	}
+
+	printf("%-9s producers %u  %6.2f Mpkt/s  submit %7.1f ns  "
+	       "max %9.1f ns  tail writes/pkt %.3f\n",
+	       (Bench_Concurrent != 0) ? "lock-free" : "locked",
+	       Bench_NumProducers,
+	       (double)TotalPkts * COUNTS_PER_SECOND / (double)(End - Start) /
+	       1e6,
+	       (double)Time * 1e9 / COUNTS_PER_SECOND / (double)TotalPkts,
+	       (double)MaxTime * 1e9 / COUNTS_PER_SECOND,
+	       (double)Bench_Sim.Chan[XAXIDMA_DMA_TO_DEVICE].TailWrites /
+	       (double)TotalPkts);
+
+	return XST_SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+	static const u32 NumProducers[] = { 1U, 2U, 4U };
+	u32 RingSize = BENCH_DEF_RING;
+	u32 Index;
+	int Status;
+
+	Bench_Pkts = BENCH_DEF_PKTS;
+	Bench_PktBds = BENCH_DEF_PKT_BDS;
+	if (argc > 1) {
+		Bench_Pkts = (u32)strtoul(argv[1], NULL, 0);
+	}
+	if (argc > 2) {
+		RingSize = (u32)strtoul(argv[2], NULL, 0);
+	}
+	if (argc > 3) {
+		Bench_PktBds = (u32)strtoul(argv[3], NULL, 0);
+	}
+	if ((Bench_Pkts == 0U) || (Bench_PktBds == 0U) ||
+	    (RingSize < Bench_PktBds * BENCH_MAX_PRODUCERS)) {
+		fprintf(stderr, "packets > 0, bds per packet > 0, "
+			"ring size >= %u bds per packet\n",
+			BENCH_MAX_PRODUCERS);
+		return 1;
+	}
+
+	Bench_BdSpace = (UINTPTR)Bench_Alloc(XAxiDma_BdRingMemCalc(
+				XAXIDMA_BD_MINIMUM_ALIGNMENT, RingSize));
+	Bench_Buffer = Bench_Alloc(BENCH_BUF_SIZE);
+	if ((Bench_BdSpace == 0U) || (Bench_Buffer == NULL)) {
+		fprintf(stderr, "failed to allocate the descriptors\n");
+		return 1;
+	}
+
+	Status = XAxiDma_SimInit(&Bench_Sim, Bench_Config.BaseAddr, TRUE);
+	if (Status != XST_SUCCESS) {
+		fprintf(stderr, "failed to register the DMA model\n");
+		return 1;
+	}
+
+	for (Bench_Concurrent = 0; Bench_Concurrent < 2;
+	     Bench_Concurrent++) {
+		for (Index = 0U;
+		     Index < (sizeof(NumProducers) / sizeof(NumProducers[0]));
+		     Index++) {
+			Bench_NumProducers = NumProducers[Index];
+			Status = Bench_Run(RingSize);
+			if (Status != XST_SUCCESS) {
+				goto END;
+			}
+		}
+	}
+
+END:
+	XAxiDma_SimRemove(&Bench_Sim);
+	return (Status == XST_SUCCESS) ? 0 : 1;
+}
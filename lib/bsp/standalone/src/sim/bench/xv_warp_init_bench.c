@@ -0,0 +1,361 @@
+/******************************************************************************
+* Copyright (c) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xv_warp_init_bench.c
+*
+* Host check and benchmark of the mesh updates of the warp init driver.
+*
+* For a few frame and grid sizes, the benchmark moves a few control points of
+* an arbitrary warp mesh at a time. It applies each new mesh to a descriptor
+* with XVWarpInit_UpdateMeshInfo, which only recalculates the grid lines of
+* the moved points, and programs it to a second descriptor from scratch with
+* XVWarpInit_ProgramDescriptor. The two descriptors and all the buffers they
+* point to must be bit-exact. It then checks that a mesh with a point moved
+* too far is rejected by both functions, and that the rejected descriptor is
+* not updated until it is programmed again. It reports the time of a full
+* programming and of an update.
+*
+* Usage: xv_warp_init_bench [updates per size]
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 7.7   jb   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "xv_warp_init_l2.h"
+#include "xtime_l.h"
+
+/************************** Constant Definitions *****************************/
+
+#define BENCH_DEF_UPDATES	64U
+#define BENCH_MAX_GRID		32U
+#define BENCH_MAX_PTS		((BENCH_MAX_GRID + 1U) * (BENCH_MAX_GRID + 1U))
+#define BENCH_MOVED_PTS		2U	/* Control points moved per update */
+#define BENCH_MAX_MOVE		4	/* Pixels, well below a grid cell */
+
+/**************************** Type Definitions *******************************/
+
+typedef struct {
+	u16 Width;
+	u16 Height;
+	u32 Grid;
+} Bench_Size;
+
+/************************** Variable Definitions *****************************/
+
+static const Bench_Size Bench_Sizes[] = {
+	{ 256U, 256U, 2U },
+	{ 800U, 600U, 5U },
+	{ 640U, 480U, 8U },
+	{ 1920U, 1080U, 16U },
+	{ 1280U, 720U, 32U },
+};
+
+static XV_warp_init_Config Bench_Config = {
+	.DeviceId = 0U,
+	.Ctrl_BaseAddress = 0U,
+	.max_width = 4096U,
+	.max_height = 4096U,
+	.warp_type = DISTORTION_ARBITARY,
+	.axi_mm_data_width = 128U,
+	.bpc = 8U,
+	.max_control_pts = BENCH_MAX_PTS,
+};
+
+static XVWarpInit_ArbParam_MeshInfo Bench_Mesh[BENCH_MAX_PTS];
+
+/*****************************************************************************/
+/**
+*
+* @brief    Stops the test on an assertion of the driver.
+*
+******************************************************************************/
+static void Bench_AssertCallback(const char8 *File, s32 Line)
+{
+	fprintf(stderr, "assertion at %s:%d\n", File, (int)Line);
+	exit(1);
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Sets up a mesh of (Grid + 1)^2 control points, none moved.
+*
+******************************************************************************/
+static void Bench_InitMesh(const Bench_Size *SizePtr)
+{
+	u32 NumPts = SizePtr->Grid + 1U;
+	u32 Row;
+	u32 Col;
+	XVWarpInit_ArbParam_MeshInfo *PtPtr = Bench_Mesh;
+
+	for (Row = 0U; Row < NumPts; Row++) {
+		for (Col = 0U; Col < NumPts; Col++, PtPtr++) {
+			PtPtr->s_x = (s32)(Col * SizePtr->Width /
+					   SizePtr->Grid);
+			PtPtr->s_y = (s32)(Row * SizePtr->Height /
+					   SizePtr->Grid);
+			PtPtr->d_x = PtPtr->s_x;
+			PtPtr->d_y = PtPtr->s_y;
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Moves a control point of the mesh by a few pixels, within the
+*           frame.
+*
+******************************************************************************/
+static void Bench_MovePoint(XVWarpInit_ArbParam_MeshInfo *PtPtr)
+{
+	PtPtr->d_x = PtPtr->s_x + (rand() % (2 * BENCH_MAX_MOVE + 1)) -
+		BENCH_MAX_MOVE;
+	PtPtr->d_y = PtPtr->s_y + (rand() % (2 * BENCH_MAX_MOVE + 1)) -
+		BENCH_MAX_MOVE;
+	if (PtPtr->d_x < 0) {
+		PtPtr->d_x = 0;
+	}
+	if (PtPtr->d_y < 0) {
+		PtPtr->d_y = 0;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Compares the buffers a descriptor points to, addresses stored in
+*           units of 4 bytes.
+*
+******************************************************************************/
+static int Bench_CompareBuf(u64 Addr0, u64 Addr1, size_t Size)
+{
+	return memcmp((const void *)(UINTPTR)(Addr0 * 4U),
+		      (const void *)(UINTPTR)(Addr1 * 4U), Size);
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Checks that two descriptors programmed for the same mesh are
+*           bit-exact, except for the addresses of their buffers.
+*
+******************************************************************************/
+static int Bench_Compare(XV_warp_init *InstancePtr, const Bench_Size *SizePtr)
+{
+	XVWarpInitVector_Hw_Aligned *Desc0 =
+		(XVWarpInitVector_Hw_Aligned *)InstancePtr->DescTable[0];
+	XVWarpInitVector_Hw_Aligned *Desc1 =
+		(XVWarpInitVector_Hw_Aligned *)InstancePtr->DescTable[1];
+	XVWarpInitVector_Hw_Aligned Copy[2];
+	u32 NumPts = SizePtr->Grid + 1U;
+	u32 Index;
+
+	if ((Bench_CompareBuf(Desc0->src_ctrl_x_pts, Desc1->src_ctrl_x_pts,
+			      sizeof(u16) * NumPts) != 0) ||
+	    (Bench_CompareBuf(Desc0->src_ctrl_y_pts, Desc1->src_ctrl_y_pts,
+			      sizeof(u16) * NumPts) != 0) ||
+	    (Bench_CompareBuf(Desc0->src_tangents_x, Desc1->src_tangents_x,
+			      sizeof(s32) * SizePtr->Grid * 3U) != 0) ||
+	    (Bench_CompareBuf(Desc0->src_tangents_y, Desc1->src_tangents_y,
+			      sizeof(s32) * SizePtr->Grid * 3U) != 0) ||
+	    (Bench_CompareBuf(Desc0->interm_x, Desc1->interm_x,
+			      sizeof(s32) * SizePtr->Width * NumPts) != 0) ||
+	    (Bench_CompareBuf(Desc0->interm_y, Desc1->interm_y,
+			      sizeof(s32) * SizePtr->Height * NumPts) != 0)) {
+		return XST_FAILURE;
+	}
+
+	/* The checksum covers the addresses */
+	for (Index = 0U; Index < 2U; Index++) {
+		memcpy((void *)&Copy[Index],
+		       (const void *)InstancePtr->DescTable[Index],
+		       sizeof(Copy[Index]));
+		Copy[Index].src_ctrl_x_pts = 0U;
+		Copy[Index].src_ctrl_y_pts = 0U;
+		Copy[Index].src_tangents_x = 0U;
+		Copy[Index].src_tangents_y = 0U;
+		Copy[Index].interm_x = 0U;
+		Copy[Index].interm_y = 0U;
+		Copy[Index].driver_checksum = 0U;
+		Copy[Index].remap_nextaddr = 0U;
+	}
+
+	return (memcmp((const void *)&Copy[0], (const void *)&Copy[1],
+		       sizeof(Copy[0])) == 0) ? XST_SUCCESS : XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Checks that a mesh with a point moved too far is rejected, and
+*           leaves no buffers behind on the rejected descriptor.
+*
+******************************************************************************/
+static int Bench_CheckReject(XV_warp_init *InstancePtr,
+			     XVWarpInit_InputConfigs *ConfigPtr,
+			     const Bench_Size *SizePtr)
+{
+	XVWarpInit_ArbParam_MeshInfo *PtPtr = &Bench_Mesh[SizePtr->Grid + 2U];
+	s32 Saved = PtPtr->d_x;
+	int Status = XST_SUCCESS;
+
+	PtPtr->d_x = PtPtr->s_x + SizePtr->Width / SizePtr->Grid + 1;
+	if ((XVWarpInit_UpdateMeshInfo(InstancePtr, 0U, Bench_Mesh) !=
+	     XST_FAILURE) ||
+	    (XVWarpInit_ProgramDescriptor(InstancePtr, 1U, ConfigPtr) !=
+	     XST_FAILURE)) {
+		Status = XST_FAILURE;
+	}
+	PtPtr->d_x = Saved;
+
+	/* The rejected descriptor must be programmed again */
+	if ((Status == XST_SUCCESS) &&
+	    (XVWarpInit_UpdateMeshInfo(InstancePtr, 1U, Bench_Mesh) !=
+	     XST_FAILURE)) {
+		Status = XST_FAILURE;
+	}
+	if ((Status == XST_SUCCESS) &&
+	    ((XVWarpInit_ProgramDescriptor(InstancePtr, 1U, ConfigPtr) !=
+	      XST_SUCCESS) ||
+	     (Bench_Compare(InstancePtr, SizePtr) != XST_SUCCESS))) {
+		Status = XST_FAILURE;
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Runs the updates of a frame and grid size.
+*
+******************************************************************************/
+static int Bench_Run(XV_warp_init *InstancePtr, const Bench_Size *SizePtr,
+		     u32 NumUpdates)
+{
+	XVWarpInit_InputConfigs Config;
+	u32 NumPts = (SizePtr->Grid + 1U) * (SizePtr->Grid + 1U);
+	XTime Start;
+	XTime End;
+	XTime UpdateTime = 0U;
+	XTime ProgramTime = 0U;
+	u32 Update;
+	u32 Index;
+
+	(void)memset(&Config, 0, sizeof(Config));
+	Config.width = SizePtr->Width;
+	Config.height = SizePtr->Height;
+	Config.bytes_per_pixel = 3U;
+	Config.warp_type = DISTORTION_ARBITARY;
+	Config.num_ctrl_pts = SizePtr->Grid;
+	Config.ctr_pts = Bench_Mesh;
+
+	Bench_InitMesh(SizePtr);
+	for (Index = 0U; Index < 2U; Index++) {
+		if (XVWarpInit_ProgramDescriptor(InstancePtr, Index,
+						 &Config) != XST_SUCCESS) {
+			fprintf(stderr, "%ux%u grid %u: failed to program\n",
+				SizePtr->Width, SizePtr->Height,
+				SizePtr->Grid);
+			return XST_FAILURE;
+		}
+	}
+
+	for (Update = 0U; Update < NumUpdates; Update++) {
+		for (Index = 0U; Index < BENCH_MOVED_PTS; Index++) {
+			Bench_MovePoint(&Bench_Mesh[(u32)rand() % NumPts]);
+		}
+
+		XTime_GetTime(&Start);
+		if (XVWarpInit_UpdateMeshInfo(InstancePtr, 0U, Bench_Mesh) !=
+		    XST_SUCCESS) {
+			fprintf(stderr, "%ux%u grid %u: update failed\n",
+				SizePtr->Width, SizePtr->Height,
+				SizePtr->Grid);
+			return XST_FAILURE;
+		}
+		XTime_GetTime(&End);
+		UpdateTime += End - Start;
+
+		XTime_GetTime(&Start);
+		(void)XVWarpInit_ProgramDescriptor(InstancePtr, 1U, &Config);
+		XTime_GetTime(&End);
+		ProgramTime += End - Start;
+
+		if (Bench_Compare(InstancePtr, SizePtr) != XST_SUCCESS) {
+			fprintf(stderr, "%ux%u grid %u: update %u differs "
+				"from programming\n", SizePtr->Width,
+				SizePtr->Height, SizePtr->Grid, Update);
+			return XST_FAILURE;
+		}
+	}
+
+	if (Bench_CheckReject(InstancePtr, &Config, SizePtr) != XST_SUCCESS) {
+		fprintf(stderr, "%ux%u grid %u: invalid mesh not rejected\n",
+			SizePtr->Width, SizePtr->Height, SizePtr->Grid);
+		return XST_FAILURE;
+	}
+
+	printf("%4ux%-4u grid %2u  program %9.1f us  update %8.1f us  "
+	       "bit-exact\n", SizePtr->Width, SizePtr->Height, SizePtr->Grid,
+	       (double)ProgramTime * 1e6 / COUNTS_PER_SECOND / NumUpdates,
+	       (double)UpdateTime * 1e6 / COUNTS_PER_SECOND / NumUpdates);
+
+	return XST_SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+	XV_warp_init Instance;
+	u32 NumUpdates = BENCH_DEF_UPDATES;
+	u32 Index;
+	int Status;
+
+	if (argc > 1) {
+		NumUpdates = (u32)strtoul(argv[1], NULL, 0);
+	}
+	if (NumUpdates == 0U) {
+		fprintf(stderr, "updates > 0\n");
+		return 1;
+	}
+
+	Xil_AssertSetCallback(Bench_AssertCallback);
+	srand(1U);
+
+	(void)memset(&Instance, 0, sizeof(Instance));
+	Instance.config = &Bench_Config;
+	Status = XVWarpInit_SetNumOfDescriptors(&Instance, 2U);
+	if (Status != XST_SUCCESS) {
+		fprintf(stderr, "failed to allocate the descriptors\n");
+		return 1;
+	}
+
+	for (Index = 0U; Index < (sizeof(Bench_Sizes) / sizeof(Bench_Sizes[0]));
+	     Index++) {
+		if (Bench_Run(&Instance, &Bench_Sizes[Index], NumUpdates) !=
+		    XST_SUCCESS) {
+			Status = XST_FAILURE;
+		}
+	}
+
+	XVWarpInit_ClearNumOfDescriptors(&Instance);
+
+	return (Status == XST_SUCCESS) ? 0 : 1;
+}
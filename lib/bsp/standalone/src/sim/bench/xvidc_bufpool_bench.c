@@ -0,0 +1,404 @@
+/******************************************************************************
+* Copyright (c) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xvidc_bufpool_bench.c
+*
+* Host test of the frame buffer pool and of the writer to reader pipeline of
+* the video common driver.
+*
+* For a few capture and display rates, the test runs the done interrupts of a
+* writer and of a reader on a simulated clock, with a jitter on the writer
+* period, and optionally holds frames acquired by the application. The writer
+* stamps each frame it writes, and the test checks on every interrupt that
+* no frame is written while it is read or held, that the displayed frames
+* come in capture order, that the reference counts match the holders of each
+* frame, and that all the frames are back in the pool once the pipeline is
+* stopped. It reports the capture to display latency, the drop and repeat
+* counters, and the host time per done call.
+*
+* Usage: xvidc_bufpool_bench [reader frames per scenario]
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 7.7   jb   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "xvidc_bufpool.h"
+#include "xtime_l.h"
+
+/************************** Constant Definitions *****************************/
+
+#define BENCH_DEF_FRAMES	100000U
+#define BENCH_MAX_FRAMES	8U
+#define BENCH_WIDTH		64U
+#define BENCH_HEIGHT		8U
+#define BENCH_STRIDE		64U
+#define BENCH_HOLD_PERIOD	13U	/* Interrupts between two holds */
+#define BENCH_HOLD_TIME		5U	/* Interrupts a hold lasts */
+
+/**************************** Type Definitions *******************************/
+
+typedef struct {
+	const char8 *Name;
+	u64 WriterPeriod;	/* ns */
+	u64 ReaderPeriod;	/* ns */
+	u32 NumFrames;
+	u32 Hold;		/* Application holds frames */
+} Bench_Scenario;
+
+typedef struct {
+	XVidC_BufPool Pool;
+	XVidC_Frame Frames[BENCH_MAX_FRAMES];
+	XVidC_Pipe Pipe;
+	u32 *Mem;
+	u32 Expected[BENCH_MAX_FRAMES];	/* Stamp of the published frames */
+	u32 Stamp;			/* Stamp of the next write */
+	u32 LastSeq;			/* Seq of the last displayed frame */
+	const XVidC_Frame *Programmed[2]; /* Last frame set on each port */
+	XVidC_Frame *Held;
+	u32 HeldStamp;
+	XTime CallTime;
+	u32 Calls;
+	u32 Errors;
+} Bench_Ctx;
+
+/************************** Variable Definitions *****************************/
+
+static const Bench_Scenario Bench_Scenarios[] = {
+	{ "60 -> 60",      16666667U, 16666667U, 3U, 0U },
+	{ "60 -> 50",      16666667U, 20000000U, 3U, 0U },
+	{ "50 -> 60",      20000000U, 16666667U, 3U, 0U },
+	{ "60 -> 60 hold", 16666667U, 16666667U, 3U, 1U },
+	{ "60 -> 60 hold", 16666667U, 16666667U, 4U, 1U },
+	{ "60 -> 50 hold", 16666667U, 20000000U, 3U, 1U },
+	{ "60 -> 50 hold", 16666667U, 20000000U, 4U, 1U },
+};
+
+/* Simulated clock of the pipeline, in ns */
+static u64 Bench_Now;
+
+/*****************************************************************************/
+/**
+*
+* @brief    Time source of the pipeline.
+*
+******************************************************************************/
+static u64 Bench_GetTime(void)
+{
+	return Bench_Now;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Stops the test on an assertion of the driver.
+*
+******************************************************************************/
+static void Bench_AssertCallback(const char8 *File, s32 Line)
+{
+	fprintf(stderr, "assertion at %s:%d\n", File, (int)Line);
+	exit(1);
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Port callbacks, in place of XVFrmbufWr_SetFrame and
+*           XVFrmbufRd_SetFrame.
+*
+******************************************************************************/
+static void Bench_SetWriterFrame(void *CallbackRef, const XVidC_Frame *FramePtr)
+{
+	((Bench_Ctx *)CallbackRef)->Programmed[XVIDC_PIPE_WRITER] = FramePtr;
+}
+
+static void Bench_SetReaderFrame(void *CallbackRef, const XVidC_Frame *FramePtr)
+{
+	((Bench_Ctx *)CallbackRef)->Programmed[XVIDC_PIPE_READER] = FramePtr;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Returns the stamp written in a frame.
+*
+******************************************************************************/
+static u32 Bench_ReadStamp(const XVidC_Frame *FramePtr)
+{
+	return *(const u32 *)FramePtr->ChromaAddr;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Checks that the reference count of each frame matches its holders,
+*           and that the ports hold the frames they were programmed with.
+*
+******************************************************************************/
+static void Bench_CheckRefs(Bench_Ctx *Ctx)
+{
+	XVidC_Pipe *Pipe = &Ctx->Pipe;
+	u32 Holders[BENCH_MAX_FRAMES];
+	u32 Index;
+
+	(void)memset(Holders, 0, sizeof(Holders));
+	for (Index = 0U; Index < 2U; Index++) {
+		if (Pipe->Port[Index].Frame != NULL) {
+			Holders[Pipe->Port[Index].Frame->Index]++;
+			if (Pipe->Port[Index].Frame != Ctx->Programmed[Index]) {
+				Ctx->Errors++;
+			}
+		}
+	}
+	if (Pipe->Published != NULL) {
+		Holders[Pipe->Published->Index]++;
+	}
+	if (Ctx->Held != NULL) {
+		Holders[Ctx->Held->Index]++;
+	}
+
+	for (Index = 0U; Index < Ctx->Pool.NumFrames; Index++) {
+		if ((Ctx->Frames[Index].RefCount != Holders[Index]) ||
+		    (((Ctx->Pool.FreeMask >> Index) & 1U) !=
+		     (Holders[Index] == 0U))) {
+			Ctx->Errors++;
+		}
+	}
+
+	/* The writer never shares its frame */
+	if ((Pipe->Port[XVIDC_PIPE_WRITER].Frame != NULL) &&
+	    (Holders[Pipe->Port[XVIDC_PIPE_WRITER].Frame->Index] != 1U)) {
+		Ctx->Errors++;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Writer done interrupt: the frame of the writer is written, stamp
+*           it and hand it to the pipeline.
+*
+******************************************************************************/
+static void Bench_WriterDone(Bench_Ctx *Ctx)
+{
+	XVidC_Frame *FramePtr = Ctx->Pipe.Port[XVIDC_PIPE_WRITER].Frame;
+	u32 Seq = Ctx->Pipe.Seq;
+	XTime Start;
+	XTime End;
+
+	Ctx->Stamp++;
+	*(u32 *)FramePtr->LumaAddr = Ctx->Stamp;
+	*(u32 *)FramePtr->ChromaAddr = Ctx->Stamp;
+
+	XTime_GetTime(&Start);
+	XVidC_PipeWriterDone(&Ctx->Pipe);
+	XTime_GetTime(&End);
+	Ctx->CallTime += End - Start;
+	Ctx->Calls++;
+
+	if (Ctx->Pipe.Seq != Seq) {
+		if ((Ctx->Pipe.Published != FramePtr) ||
+		    !XVidC_FrameIsDone(FramePtr)) {
+			Ctx->Errors++;
+		}
+		Ctx->Expected[FramePtr->Index] = Ctx->Stamp;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Reader done interrupt: the frame of the reader was displayed
+*           untouched, hand over to the pipeline.
+*
+******************************************************************************/
+static void Bench_ReaderDone(Bench_Ctx *Ctx)
+{
+	XVidC_Frame *FramePtr = Ctx->Pipe.Port[XVIDC_PIPE_READER].Frame;
+	XTime Start;
+	XTime End;
+
+	if ((FramePtr->Seq != 0U) &&
+	    (Bench_ReadStamp(FramePtr) != Ctx->Expected[FramePtr->Index])) {
+		Ctx->Errors++;
+	}
+
+	XTime_GetTime(&Start);
+	XVidC_PipeReaderDone(&Ctx->Pipe);
+	XTime_GetTime(&End);
+	Ctx->CallTime += End - Start;
+	Ctx->Calls++;
+
+	FramePtr = Ctx->Pipe.Port[XVIDC_PIPE_READER].Frame;
+	if (FramePtr->Seq < Ctx->LastSeq) {
+		Ctx->Errors++;
+	}
+	Ctx->LastSeq = FramePtr->Seq;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Runs a scenario for NumReads reader frames.
+*
+* @return	XST_SUCCESS, or XST_FAILURE if a check failed.
+*
+******************************************************************************/
+static int Bench_Run(const Bench_Scenario *Scenario, u32 NumReads)
+{
+	XVidC_FrameFormat Format = {
+		.Width = BENCH_WIDTH,
+		.Height = BENCH_HEIGHT,
+		.Stride = BENCH_STRIDE,
+		.ColorFormat = XVIDC_CSF_MEM_Y_UV8_420,
+	};
+	static Bench_Ctx Ctx;
+	XVidC_PipeStats Stats;
+	u64 NextWrite;
+	u64 NextRead;
+	u32 Writes = 0U;
+	u32 Reads = 0U;
+	u32 Events = 0U;
+	u32 HoldUntil = 0U;
+	u32 Random = 1U;
+	u32 MemSize;
+	int Status;
+
+	(void)memset(&Ctx, 0, sizeof(Ctx));
+	MemSize = XVidC_GetFrameSize(&Format) * Scenario->NumFrames;
+	Ctx.Mem = malloc(MemSize);
+	if (Ctx.Mem == NULL) {
+		return XST_FAILURE;
+	}
+
+	Status = XVidC_BufPoolInit(&Ctx.Pool, Ctx.Frames, Scenario->NumFrames,
+				   &Format, (UINTPTR)Ctx.Mem, MemSize);
+	if (Status == XST_SUCCESS) {
+		Status = XVidC_PipeInit(&Ctx.Pipe, &Ctx.Pool, Bench_GetTime);
+	}
+	if (Status != XST_SUCCESS) {
+		free(Ctx.Mem);
+		return Status;
+	}
+	XVidC_PipeSetPort(&Ctx.Pipe, XVIDC_PIPE_WRITER, Bench_SetWriterFrame,
+			  &Ctx);
+	XVidC_PipeSetPort(&Ctx.Pipe, XVIDC_PIPE_READER, Bench_SetReaderFrame,
+			  &Ctx);
+
+	Bench_Now = 0U;
+	(void)XVidC_PipeStart(&Ctx.Pipe);
+	Bench_CheckRefs(&Ctx);
+
+	/* The reader starts half a frame after the writer */
+	NextWrite = Scenario->WriterPeriod;
+	NextRead = Scenario->ReaderPeriod + (Scenario->ReaderPeriod / 2U);
+	while (Reads < NumReads) {
+		if (NextWrite <= NextRead) {
+			Bench_Now = NextWrite;
+			Bench_WriterDone(&Ctx);
+			Writes++;
+			/* Up to 1% of jitter on the source */
+			Random = (Random * 1103515245U) + 12345U;
+			NextWrite += Scenario->WriterPeriod -
+				(Scenario->WriterPeriod / 200U) +
+				((Random >> 8) % (Scenario->WriterPeriod / 100U));
+		} else {
+			Bench_Now = NextRead;
+			Bench_ReaderDone(&Ctx);
+			Reads++;
+			NextRead += Scenario->ReaderPeriod;
+		}
+		Events++;
+
+		/* Holds start after either interrupt, to hold published and
+		 * displayed frames */
+		if ((Ctx.Held != NULL) && (Events >= HoldUntil)) {
+			if (Bench_ReadStamp(Ctx.Held) != Ctx.HeldStamp) {
+				Ctx.Errors++;
+			}
+			XVidC_PipeRelease(&Ctx.Pipe, Ctx.Held);
+			Ctx.Held = NULL;
+		} else if ((Scenario->Hold != 0U) && (Ctx.Held == NULL) &&
+			   ((Events % BENCH_HOLD_PERIOD) == 0U)) {
+			Ctx.Held = XVidC_PipeAcquire(&Ctx.Pipe);
+			Ctx.HeldStamp = Bench_ReadStamp(Ctx.Held);
+			HoldUntil = Events + BENCH_HOLD_TIME;
+		}
+		Bench_CheckRefs(&Ctx);
+	}
+
+	XVidC_PipeGetStats(&Ctx.Pipe, &Stats);
+	if ((Stats.Captured + Stats.WriterDrops != Writes) ||
+	    (Stats.Displayed + Stats.Repeats != Reads) ||
+	    (Stats.Captured != Stats.Displayed + Stats.ReaderDrops +
+	     ((Ctx.Pipe.Published != NULL) ? 1U : 0U))) {
+		Ctx.Errors++;
+	}
+
+	if (Ctx.Held != NULL) {
+		XVidC_PipeRelease(&Ctx.Pipe, Ctx.Held);
+		Ctx.Held = NULL;
+	}
+	XVidC_PipeStop(&Ctx.Pipe);
+	if (XVidC_BufPoolNumFree(&Ctx.Pool) != Scenario->NumFrames) {
+		Ctx.Errors++;
+	}
+
+	printf("%-14s %u frames  captured %7u displayed %7u  drops wr %6u "
+	       "rd %6u  repeats %6u  latency ms min %.2f avg %.2f max %.2f  "
+	       "%.1f ns/call  %s\n",
+	       Scenario->Name, Scenario->NumFrames, Stats.Captured,
+	       Stats.Displayed, Stats.WriterDrops, Stats.ReaderDrops,
+	       Stats.Repeats, (double)Stats.MinLatency / 1e6,
+	       (Stats.Displayed != 0U) ?
+	       (double)Stats.TotalLatency / 1e6 / Stats.Displayed : 0.0,
+	       (double)Stats.MaxLatency / 1e6,
+	       (double)Ctx.CallTime * 1e9 / COUNTS_PER_SECOND / Ctx.Calls,
+	       (Ctx.Errors == 0U) ? "ok" : "FAILED");
+
+	free(Ctx.Mem);
+	return (Ctx.Errors == 0U) ? XST_SUCCESS : XST_FAILURE;
+}
+
+int main(int argc, char *argv[])
+{
+	u32 NumReads = BENCH_DEF_FRAMES;
+	u32 Index;
+	int Status = XST_SUCCESS;
+
+	if (argc > 1) {
+		NumReads = (u32)strtoul(argv[1], NULL, 0);
+	}
+	if (NumReads == 0U) {
+		fprintf(stderr, "reader frames > 0\n");
+		return 1;
+	}
+
+	Xil_AssertSetCallback(Bench_AssertCallback);
+
+	for (Index = 0U;
+	     Index < (sizeof(Bench_Scenarios) / sizeof(Bench_Scenarios[0]));
+	     Index++) {
+		if (Bench_Run(&Bench_Scenarios[Index], NumReads) !=
+		    XST_SUCCESS) {
+			Status = XST_FAILURE;
+		}
+	}
+
+	return (Status == XST_SUCCESS) ? 0 : 1;
+}
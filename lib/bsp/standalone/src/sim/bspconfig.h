@@ -0,0 +1,14 @@
+/******************************************************************************
+* Copyright (c) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*
+ * bspconfig.h of the host simulation backend.
+ */
+
+#ifndef BSPCONFIG_H	/* prevent circular inclusions */
+#define BSPCONFIG_H	/* by using protection macros */
+
+
+#endif	/* end of protection macro */
@@ -0,0 +1,343 @@
+/******************************************************************************
+* Copyright (c) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xaxidma_sim.c
+*
+* Register model of the AXI DMA engine, see xaxidma_sim.h.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 7.7   jb   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <string.h>
+#include "xstatus.h"
+#include "xaxidma_sim.h"
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define XAxiDma_SimReg(SimPtr, ChanPtr, Offset) \
+	((SimPtr)->Regs[((ChanPtr)->RegOffset + (Offset)) / 4U])
+
+/* Reads a 32 bit word of a buffer descriptor in the host memory */
+#define XAxiDma_SimBdRead(BdAddr, Offset) \
+	__atomic_load_n((u32 *)((BdAddr) + (Offset)), __ATOMIC_ACQUIRE)
+
+/************************** Function Prototypes ******************************/
+
+static u64 XAxiDma_SimRead(Xil_SimModel *ModelPtr, UINTPTR Offset, u32 Width);
+static void XAxiDma_SimWrite(Xil_SimModel *ModelPtr, UINTPTR Offset,
+			     u64 Value, u32 Width);
+
+/*****************************************************************************/
+/**
+* Puts a channel in its reset state, halted with no descriptor.
+*
+* @param	SimPtr is a pointer to the model.
+* @param	ChanPtr is a pointer to the channel.
+*
+* @return	None.
+*
+******************************************************************************/
+static void XAxiDma_SimResetChan(XAxiDma_Sim *SimPtr, XAxiDma_SimChan *ChanPtr)
+{
+	u32 Offset;
+
+	for (Offset = 0U; Offset < XAXIDMA_RX_OFFSET; Offset += 4U) {
+		XAxiDma_SimReg(SimPtr, ChanPtr, Offset) = 0U;
+	}
+	XAxiDma_SimReg(SimPtr, ChanPtr, XAXIDMA_SR_OFFSET) = XAXIDMA_HALTED_MASK;
+	ChanPtr->NextBd = 0U;
+}
+
+/*****************************************************************************/
+/**
+* Returns the address held by a pair of descriptor pointer registers.
+*
+* @param	SimPtr is a pointer to the model.
+* @param	ChanPtr is a pointer to the channel.
+* @param	Offset is the offset of the low register of the pair.
+*
+* @return	The address of the descriptor.
+*
+******************************************************************************/
+static UINTPTR XAxiDma_SimDescReg(XAxiDma_Sim *SimPtr,
+				  XAxiDma_SimChan *ChanPtr, u32 Offset)
+{
+	u64 Addr = XAxiDma_SimReg(SimPtr, ChanPtr, Offset) &
+		   XAXIDMA_DESC_LSB_MASK;
+
+	Addr |= (u64)XAxiDma_SimReg(SimPtr, ChanPtr, Offset + 4U) << 32U;
+
+	return (UINTPTR)Addr;
+}
+
+/*****************************************************************************/
+/**
+* Completes the descriptors of a channel, from the next one to process up to
+* the tail descriptor. The lock of the model is held.
+*
+* @param	SimPtr is a pointer to the model.
+* @param	ChanPtr is a pointer to the channel.
+* @param	MaxBds is the maximum number of descriptors to complete.
+*
+* @return	The number of descriptors completed.
+*
+******************************************************************************/
+static u32 XAxiDma_SimRun(XAxiDma_Sim *SimPtr, XAxiDma_SimChan *ChanPtr,
+			  u32 MaxBds)
+{
+	u32 *SrPtr = &XAxiDma_SimReg(SimPtr, ChanPtr, XAXIDMA_SR_OFFSET);
+	UINTPTR Tail;
+	UINTPTR Bd;
+	u32 Sts;
+	u32 Count = 0U;
+
+	if ((*SrPtr & (XAXIDMA_HALTED_MASK | XAXIDMA_IDLE_MASK)) != 0U) {
+		return 0U;
+	}
+
+	Tail = XAxiDma_SimDescReg(SimPtr, ChanPtr, XAXIDMA_TDESC_OFFSET);
+	while ((Count < MaxBds) && (ChanPtr->NextBd != 0U)) {
+		Bd = ChanPtr->NextBd;
+
+		Sts = XAxiDma_SimBdRead(Bd, XAXIDMA_BD_CTRL_LEN_OFFSET) &
+		      ~XAXIDMA_BD_CTRL_ALL_MASK;
+		Sts |= XAXIDMA_BD_STS_COMPLETE_MASK;
+		if (ChanPtr->RegOffset == XAXIDMA_RX_OFFSET) {
+			Sts |= XAXIDMA_BD_STS_RXSOF_MASK |
+			       XAXIDMA_BD_STS_RXEOF_MASK;
+		}
+		/* Publish the status once the descriptor is done with */
+		__atomic_store_n((u32 *)(Bd + XAXIDMA_BD_STS_OFFSET), Sts,
+				 __ATOMIC_RELEASE);
+		Count++;
+
+		XAxiDma_SimReg(SimPtr, ChanPtr, XAXIDMA_CDESC_OFFSET) =
+			(u32)Bd;
+		XAxiDma_SimReg(SimPtr, ChanPtr, XAXIDMA_CDESC_MSB_OFFSET) =
+			(u32)((u64)Bd >> 32U);
+		ChanPtr->NextBd = (UINTPTR)
+			(XAxiDma_SimBdRead(Bd, XAXIDMA_BD_NDESC_OFFSET) |
+			 ((u64)XAxiDma_SimBdRead(Bd,
+				XAXIDMA_BD_NDESC_MSB_OFFSET) << 32U));
+		*SrPtr |= XAXIDMA_IRQ_IOC_MASK;
+
+		if (Bd == Tail) {
+			*SrPtr |= XAXIDMA_IDLE_MASK;
+			break;
+		}
+	}
+	ChanPtr->BdCount += Count;
+
+	return Count;
+}
+
+/*****************************************************************************/
+/**
+* Register read handler of the model.
+*
+* @param	ModelPtr is a pointer to the model of the backend.
+* @param	Offset is the offset of the register.
+* @param	Width is the width of the access in bits.
+*
+* @return	The value of the register.
+*
+******************************************************************************/
+static u64 XAxiDma_SimRead(Xil_SimModel *ModelPtr, UINTPTR Offset, u32 Width)
+{
+	XAxiDma_Sim *SimPtr = ModelPtr->Data;
+	u32 Value = 0U;
+
+	(void)Width;
+	if (Offset < (XAXIDMA_SIM_NUM_REGS * 4U)) {
+		(void)pthread_mutex_lock(&SimPtr->Lock);
+		Value = SimPtr->Regs[Offset / 4U];
+		(void)pthread_mutex_unlock(&SimPtr->Lock);
+	}
+
+	return Value;
+}
+
+/*****************************************************************************/
+/**
+* Register write handler of the model.
+*
+* @param	ModelPtr is a pointer to the model of the backend.
+* @param	Offset is the offset of the register.
+* @param	Value is the value written.
+* @param	Width is the width of the access in bits.
+*
+* @return	None.
+*
+******************************************************************************/
+static void XAxiDma_SimWrite(Xil_SimModel *ModelPtr, UINTPTR Offset,
+			     u64 Value, u32 Width)
+{
+	XAxiDma_Sim *SimPtr = ModelPtr->Data;
+	XAxiDma_SimChan *ChanPtr;
+	u32 *SrPtr;
+	u32 Reg;
+
+	(void)Width;
+	if (Offset >= (XAXIDMA_SIM_NUM_REGS * 4U)) {
+		return;
+	}
+
+	(void)pthread_mutex_lock(&SimPtr->Lock);
+	if (Offset < XAXIDMA_RX_OFFSET) {
+		ChanPtr = &SimPtr->Chan[XAXIDMA_DMA_TO_DEVICE];
+	} else if (Offset < (XAXIDMA_RX_OFFSET * 2U)) {
+		ChanPtr = &SimPtr->Chan[XAXIDMA_DEVICE_TO_DMA];
+	} else {
+		SimPtr->Regs[Offset / 4U] = (u32)Value;
+		goto END;
+	}
+	Reg = (u32)(Offset - ChanPtr->RegOffset);
+	SrPtr = &XAxiDma_SimReg(SimPtr, ChanPtr, XAXIDMA_SR_OFFSET);
+
+	switch (Reg) {
+	case XAXIDMA_CR_OFFSET:
+		if ((Value & XAXIDMA_CR_RESET_MASK) != 0U) {
+			/* The reset of either channel resets the engine,
+			 * and completes at once */
+			XAxiDma_SimResetChan(SimPtr,
+				&SimPtr->Chan[XAXIDMA_DMA_TO_DEVICE]);
+			XAxiDma_SimResetChan(SimPtr,
+				&SimPtr->Chan[XAXIDMA_DEVICE_TO_DMA]);
+			break;
+		}
+		XAxiDma_SimReg(SimPtr, ChanPtr, Reg) = (u32)Value;
+		if ((Value & XAXIDMA_CR_RUNSTOP_MASK) == 0U) {
+			*SrPtr |= XAXIDMA_HALTED_MASK;
+		} else if ((*SrPtr & XAXIDMA_HALTED_MASK) != 0U) {
+			/* Idle on the current descriptor until the tail
+			 * descriptor is written */
+			*SrPtr = (*SrPtr & ~XAXIDMA_HALTED_MASK) |
+				 XAXIDMA_IDLE_MASK;
+			ChanPtr->NextBd = XAxiDma_SimDescReg(SimPtr, ChanPtr,
+							XAXIDMA_CDESC_OFFSET);
+		}
+		break;
+	case XAXIDMA_SR_OFFSET:
+		/* Only the interrupt bits are writable, write 1 to clear */
+		*SrPtr &= ~((u32)Value & XAXIDMA_IRQ_ALL_MASK);
+		break;
+	case XAXIDMA_CDESC_OFFSET:
+	case XAXIDMA_CDESC_MSB_OFFSET:
+		/* The current descriptor is read only while running */
+		if ((*SrPtr & XAXIDMA_HALTED_MASK) != 0U) {
+			XAxiDma_SimReg(SimPtr, ChanPtr, Reg) = (u32)Value;
+		}
+		break;
+	case XAXIDMA_TDESC_OFFSET:
+		XAxiDma_SimReg(SimPtr, ChanPtr, Reg) = (u32)Value;
+		ChanPtr->TailWrites++;
+		if ((*SrPtr & XAXIDMA_HALTED_MASK) == 0U) {
+			*SrPtr &= ~XAXIDMA_IDLE_MASK;
+			if (SimPtr->AutoComplete != 0) {
+				(void)XAxiDma_SimRun(SimPtr, ChanPtr,
+						     (u32)-1);
+			}
+		}
+		break;
+	default:
+		XAxiDma_SimReg(SimPtr, ChanPtr, Reg) = (u32)Value;
+		break;
+	}
+
+END:
+	(void)pthread_mutex_unlock(&SimPtr->Lock);
+}
+
+/*****************************************************************************/
+/**
+* Initializes an AXI DMA model and registers it to the simulation backend.
+* Both channels are halted, as after a reset.
+*
+* @param	SimPtr is a pointer to the model.
+* @param	BaseAddr is the base address of the engine, as in the
+*		configuration of the driver.
+* @param	AutoComplete completes the descriptors when the driver writes
+*		the tail descriptor if set, otherwise on XAxiDma_SimProcess().
+*
+* @return	XST_SUCCESS, or XST_INVALID_PARAM if the model overlaps a
+*		registered one.
+*
+******************************************************************************/
+s32 XAxiDma_SimInit(XAxiDma_Sim *SimPtr, UINTPTR BaseAddr, int AutoComplete)
+{
+	s32 Status;
+
+	(void)memset(SimPtr, 0, sizeof(*SimPtr));
+	(void)pthread_mutex_init(&SimPtr->Lock, NULL);
+	SimPtr->AutoComplete = AutoComplete;
+	SimPtr->Chan[XAXIDMA_DMA_TO_DEVICE].RegOffset = XAXIDMA_TX_OFFSET;
+	SimPtr->Chan[XAXIDMA_DEVICE_TO_DMA].RegOffset = XAXIDMA_RX_OFFSET;
+	XAxiDma_SimResetChan(SimPtr, &SimPtr->Chan[XAXIDMA_DMA_TO_DEVICE]);
+	XAxiDma_SimResetChan(SimPtr, &SimPtr->Chan[XAXIDMA_DEVICE_TO_DMA]);
+
+	SimPtr->Model.Name = "axidma";
+	SimPtr->Model.BaseAddr = BaseAddr;
+	SimPtr->Model.Size = XAXIDMA_SIM_REG_SPACE;
+	SimPtr->Model.Read = XAxiDma_SimRead;
+	SimPtr->Model.Write = XAxiDma_SimWrite;
+	SimPtr->Model.Data = SimPtr;
+
+	Status = Xil_SimRegisterModel(&SimPtr->Model);
+	if (Status != XST_SUCCESS) {
+		(void)pthread_mutex_destroy(&SimPtr->Lock);
+	}
+
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+* Unregisters an AXI DMA model from the simulation backend.
+*
+* @param	SimPtr is a pointer to the model.
+*
+* @return	None.
+*
+******************************************************************************/
+void XAxiDma_SimRemove(XAxiDma_Sim *SimPtr)
+{
+	Xil_SimUnregisterModel(&SimPtr->Model);
+	(void)pthread_mutex_destroy(&SimPtr->Lock);
+}
+
+/*****************************************************************************/
+/**
+* Completes the pending descriptors of a channel, as the engine would
+* between two tail descriptor updates.
+*
+* @param	SimPtr is a pointer to the model.
+* @param	Direction is XAXIDMA_DMA_TO_DEVICE or XAXIDMA_DEVICE_TO_DMA.
+* @param	MaxBds is the maximum number of descriptors to complete.
+*
+* @return	The number of descriptors completed.
+*
+******************************************************************************/
+u32 XAxiDma_SimProcess(XAxiDma_Sim *SimPtr, int Direction, u32 MaxBds)
+{
+	u32 Count;
+
+	(void)pthread_mutex_lock(&SimPtr->Lock);
+	Count = XAxiDma_SimRun(SimPtr, &SimPtr->Chan[Direction], MaxBds);
+	(void)pthread_mutex_unlock(&SimPtr->Lock);
+
+	return Count;
+}
@@ -0,0 +1,90 @@
+/******************************************************************************
+* Copyright (c) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xaxidma_sim.h
+*
+* Register model of the AXI DMA engine in scatter gather mode, for the host
+* simulation backend (see xil_io_sim.h).
+*
+* The model implements the control, status, current and tail descriptor
+* registers of the MM2S and S2MM channels. It walks the buffer descriptors in
+* the host memory from the current descriptor to the tail one, and completes
+* them with the status the engine would write back: the length of the buffer
+* and the complete bit, plus the start and end of frame bits for S2MM, as if
+* each buffer received a whole packet. No data is moved.
+*
+* The descriptors complete as soon as the driver writes the tail descriptor
+* when AutoComplete is set, otherwise only when XAxiDma_SimProcess() is
+* called, from the test or from a thread playing the engine.
+*
+* Only the first S2MM channel of the multichannel mode is modeled, and the
+* descriptors must be in the low 4GB when the driver is built for a 32 bit
+* address width.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -------------------------------------------------------
+* 7.7   jb   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+#ifndef XAXIDMA_SIM_H_
+#define XAXIDMA_SIM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+
+#include <pthread.h>
+#include "xil_io_sim.h"
+#include "xaxidma_hw.h"
+
+/************************** Constant Definitions *****************************/
+
+#define XAXIDMA_SIM_REG_SPACE	0x10000U /**< Register space of the model */
+#define XAXIDMA_SIM_NUM_REGS	0x20U	 /**< Modeled registers, 0x0-0x7C */
+
+/**************************** Type Definitions *******************************/
+
+/**
+ * State of one channel of the model
+ */
+typedef struct {
+	UINTPTR RegOffset;	/**< XAXIDMA_TX_OFFSET or XAXIDMA_RX_OFFSET */
+	UINTPTR NextBd;		/**< Next descriptor to process, 0 if none */
+	u64 BdCount;		/**< Descriptors completed */
+	u64 TailWrites;		/**< Writes of the tail descriptor */
+} XAxiDma_SimChan;
+
+/**
+ * AXI DMA register model
+ */
+typedef struct {
+	Xil_SimModel Model;	/**< Model registered to the backend */
+	u32 Regs[XAXIDMA_SIM_NUM_REGS];	/**< Register file */
+	XAxiDma_SimChan Chan[2];	/**< Indexed by XAXIDMA_DMA_TO_DEVICE
+					  *  and XAXIDMA_DEVICE_TO_DMA */
+	int AutoComplete;	/**< Complete the BDs on the tail writes */
+	pthread_mutex_t Lock;	/**< Serializes the driver and the engine */
+} XAxiDma_Sim;
+
+/************************** Function Prototypes ******************************/
+
+s32 XAxiDma_SimInit(XAxiDma_Sim *SimPtr, UINTPTR BaseAddr, int AutoComplete);
+void XAxiDma_SimRemove(XAxiDma_Sim *SimPtr);
+u32 XAxiDma_SimProcess(XAxiDma_Sim *SimPtr, int Direction, u32 MaxBds);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of protection macro */
@@ -0,0 +1,34 @@
+/******************************************************************************
+* Copyright (c) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file outbyte.c
+*
+* Console of the host simulation backend, on the standard streams.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ------ -------- ---------------------------------------------------
+* 7.7   jb     10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+#include <stdio.h>
+#include "xil_printf.h"
+
+void outbyte(char c)
+{
+	(void)putchar(c);
+}
+
+char inbyte(void)
+{
+	return (char)getchar();
+}
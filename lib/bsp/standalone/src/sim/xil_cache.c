@@ -0,0 +1,203 @@
+/******************************************************************************
+* Copyright (c) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xil_cache.c
+*
+* Cache functions of the host simulation backend. Only the data cache
+* maintenance of the drivers is counted, the other operations do nothing.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 7.7   jb   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include "xil_cache.h"
+#include "xil_io_sim.h"
+
+/****************************************************************************/
+/**
+* @brief	Enable the data cache, nothing to do on the host.
+*
+* @return	None.
+*
+****************************************************************************/
+void Xil_DCacheEnable(void)
+{
+}
+
+/****************************************************************************/
+/**
+* @brief	Disable the data cache, nothing to do on the host.
+*
+* @return	None.
+*
+****************************************************************************/
+void Xil_DCacheDisable(void)
+{
+}
+
+/****************************************************************************/
+/**
+* @brief	Invalidate the entire data cache.
+*
+* @return	None.
+*
+****************************************************************************/
+void Xil_DCacheInvalidate(void)
+{
+	XIL_SIM_COUNT(DCacheInvalidates);
+}
+
+/****************************************************************************/
+/**
+* @brief	Invalidate the data cache for the given address range.
+*
+* @param	adr: 32bit start address of the range to be invalidated.
+* @param	len: Length of the range to be invalidated in bytes.
+*
+* @return	None.
+*
+****************************************************************************/
+void Xil_DCacheInvalidateRange(INTPTR adr, INTPTR len)
+{
+	(void)adr;
+	(void)len;
+	XIL_SIM_COUNT(DCacheInvalidates);
+}
+
+/****************************************************************************/
+/**
+* @brief	Invalidate a data cache line.
+*
+* @param	adr: Address in the cache line to be invalidated.
+*
+* @return	None.
+*
+****************************************************************************/
+void Xil_DCacheInvalidateLine(INTPTR adr)
+{
+	(void)adr;
+	XIL_SIM_COUNT(DCacheInvalidates);
+}
+
+/****************************************************************************/
+/**
+* @brief	Flush the entire data cache.
+*
+* @return	None.
+*
+****************************************************************************/
+void Xil_DCacheFlush(void)
+{
+	XIL_SIM_COUNT(DCacheFlushes);
+}
+
+/****************************************************************************/
+/**
+* @brief	Flush the data cache for the given address range.
+*
+* @param	adr: 32bit start address of the range to be flushed.
+* @param	len: Length of the range to be flushed in bytes.
+*
+* @return	None.
+*
+****************************************************************************/
+void Xil_DCacheFlushRange(INTPTR adr, INTPTR len)
+{
+	(void)adr;
+	(void)len;
+	XIL_SIM_COUNT(DCacheFlushes);
+}
+
+/****************************************************************************/
+/**
+* @brief	Flush a data cache line.
+*
+* @param	adr: Address in the cache line to be flushed.
+*
+* @return	None.
+*
+****************************************************************************/
+void Xil_DCacheFlushLine(INTPTR adr)
+{
+	(void)adr;
+	XIL_SIM_COUNT(DCacheFlushes);
+}
+
+/****************************************************************************/
+/**
+* @brief	Enable the instruction cache, nothing to do on the host.
+*
+* @return	None.
+*
+****************************************************************************/
+void Xil_ICacheEnable(void)
+{
+}
+
+/****************************************************************************/
+/**
+* @brief	Disable the instruction cache, nothing to do on the host.
+*
+* @return	None.
+*
+****************************************************************************/
+void Xil_ICacheDisable(void)
+{
+}
+
+/****************************************************************************/
+/**
+* @brief	Invalidate the entire instruction cache, nothing to do on the
+*		host.
+*
+* @return	None.
+*
+****************************************************************************/
+void Xil_ICacheInvalidate(void)
+{
+}
+
+/****************************************************************************/
+/**
+* @brief	Invalidate the instruction cache for the given address range,
+*		nothing to do on the host.
+*
+* @param	adr: 32bit start address of the range to be invalidated.
+* @param	len: Length of the range to be invalidated in bytes.
+*
+* @return	None.
+*
+****************************************************************************/
+void Xil_ICacheInvalidateRange(INTPTR adr, INTPTR len)
+{
+	(void)adr;
+	(void)len;
+}
+
+/****************************************************************************/
+/**
+* @brief	Invalidate an instruction cache line, nothing to do on the
+*		host.
+*
+* @param	adr: Address in the cache line to be invalidated.
+*
+* @return	None.
+*
+****************************************************************************/
+void Xil_ICacheInvalidateLine(INTPTR adr)
+{
+	(void)adr;
+}
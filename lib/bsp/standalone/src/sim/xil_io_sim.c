@@ -0,0 +1,289 @@
+/******************************************************************************
+* Copyright (c) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xil_io_sim.c
+*
+* Register model registry and I/O dispatch of the host simulation backend.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 7.7   jb       10/18/26 First release
+*
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <pthread.h>
+#include <string.h>
+#include "xil_io_sim.h"
+#include "xstatus.h"
+
+/************************** Variable Definitions *****************************/
+
+Xil_SimStats Xil_SimCounters;
+
+/* Registered models, only modified under Xil_SimLock */
+static Xil_SimModel *Xil_SimModels;
+/* Model of the last access, as drivers mostly hit one device in a row */
+static Xil_SimModel *Xil_SimLastModel;
+static pthread_mutex_t Xil_SimLock = PTHREAD_MUTEX_INITIALIZER;
+
+/*****************************************************************************/
+/**
+*
+* @brief    Registers a register model. The model must not overlap another
+*           registered one, and must stay valid until it is unregistered.
+*
+* @param	ModelPtr: the model to register
+*
+* @return	XST_SUCCESS, or XST_INVALID_PARAM if the model is empty or
+*		overlaps another one.
+*
+******************************************************************************/
+s32 Xil_SimRegisterModel(Xil_SimModel *ModelPtr)
+{
+	Xil_SimModel *Cur;
+	s32 Status = XST_INVALID_PARAM;
+
+	if ((ModelPtr == NULL) || (ModelPtr->Size == 0U) ||
+	    ((ModelPtr->Regs == NULL) &&
+	     ((ModelPtr->Read == NULL) || (ModelPtr->Write == NULL)))) {
+		return Status;
+	}
+
+	(void)pthread_mutex_lock(&Xil_SimLock);
+	for (Cur = Xil_SimModels; Cur != NULL; Cur = Cur->Next) {
+		if ((ModelPtr->BaseAddr < (Cur->BaseAddr + Cur->Size)) &&
+		    (Cur->BaseAddr < (ModelPtr->BaseAddr + ModelPtr->Size))) {
+			goto END;
+		}
+	}
+	ModelPtr->ReadCount = 0U;
+	ModelPtr->WriteCount = 0U;
+	ModelPtr->Next = Xil_SimModels;
+	__atomic_store_n(&Xil_SimModels, ModelPtr, __ATOMIC_RELEASE);
+	Status = XST_SUCCESS;
+
+END:
+	(void)pthread_mutex_unlock(&Xil_SimLock);
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Unregisters a register model. No access to its registers may be
+*           in progress.
+*
+* @param	ModelPtr: the model to unregister
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_SimUnregisterModel(Xil_SimModel *ModelPtr)
+{
+	Xil_SimModel **Link;
+
+	(void)pthread_mutex_lock(&Xil_SimLock);
+	for (Link = &Xil_SimModels; *Link != NULL; Link = &(*Link)->Next) {
+		if (*Link == ModelPtr) {
+			__atomic_store_n(Link, ModelPtr->Next,
+					 __ATOMIC_RELEASE);
+			break;
+		}
+	}
+	__atomic_store_n(&Xil_SimLastModel, NULL, __ATOMIC_RELAXED);
+	(void)pthread_mutex_unlock(&Xil_SimLock);
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Finds the register model of an address.
+*
+* @param	Addr: the address to look up
+*
+* @return	The model holding the address, or NULL for the host memory.
+*
+******************************************************************************/
+Xil_SimModel *Xil_SimLookupModel(UINTPTR Addr)
+{
+	Xil_SimModel *Cur;
+
+	Cur = __atomic_load_n(&Xil_SimLastModel, __ATOMIC_RELAXED);
+	if ((Cur != NULL) && ((Addr - Cur->BaseAddr) < Cur->Size)) {
+		return Cur;
+	}
+
+	for (Cur = __atomic_load_n(&Xil_SimModels, __ATOMIC_ACQUIRE);
+	     Cur != NULL; Cur = Cur->Next) {
+		if ((Addr - Cur->BaseAddr) < Cur->Size) {
+			__atomic_store_n(&Xil_SimLastModel, Cur,
+					 __ATOMIC_RELAXED);
+			break;
+		}
+	}
+
+	return Cur;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Performs an input operation, from the register model of the
+*           address or from the host memory.
+*
+* @param	Addr: the address to read
+* @param	Width: the access width in bits, 8, 16, 32 or 64
+*
+* @return	The value read, zero extended.
+*
+******************************************************************************/
+u64 Xil_SimIn(UINTPTR Addr, u32 Width)
+{
+	Xil_SimModel *ModelPtr = Xil_SimLookupModel(Addr);
+	const volatile void *Ptr;
+	u64 Value = 0U;
+
+	if (ModelPtr == NULL) {
+		XIL_SIM_COUNT(MemReads);
+		Ptr = (const volatile void *)Addr;
+	} else {
+		XIL_SIM_COUNT(RegReads);
+		(void)__atomic_fetch_add(&ModelPtr->ReadCount, 1U,
+					 __ATOMIC_RELAXED);
+		if (ModelPtr->Read != NULL) {
+			return ModelPtr->Read(ModelPtr, Addr - ModelPtr->BaseAddr,
+					      Width);
+		}
+		Ptr = (const u8 *)ModelPtr->Regs + (Addr - ModelPtr->BaseAddr);
+	}
+
+	switch (Width) {
+	case 8U:
+		Value = *(const volatile u8 *)Ptr;
+		break;
+	case 16U:
+		Value = *(const volatile u16 *)Ptr;
+		break;
+	case 32U:
+		Value = *(const volatile u32 *)Ptr;
+		break;
+	default:
+		Value = *(const volatile u64 *)Ptr;
+		break;
+	}
+
+	return Value;
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Performs an output operation, to the register model of the
+*           address or to the host memory.
+*
+* @param	Addr: the address to write
+* @param	Value: the value to write, in its low Width bits
+* @param	Width: the access width in bits, 8, 16, 32 or 64
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_SimOut(UINTPTR Addr, u64 Value, u32 Width)
+{
+	Xil_SimModel *ModelPtr = Xil_SimLookupModel(Addr);
+	volatile void *Ptr;
+
+	if (ModelPtr == NULL) {
+		XIL_SIM_COUNT(MemWrites);
+		Ptr = (volatile void *)Addr;
+	} else {
+		XIL_SIM_COUNT(RegWrites);
+		(void)__atomic_fetch_add(&ModelPtr->WriteCount, 1U,
+					 __ATOMIC_RELAXED);
+		if (ModelPtr->Write != NULL) {
+			ModelPtr->Write(ModelPtr, Addr - ModelPtr->BaseAddr,
+					Value, Width);
+			return;
+		}
+		Ptr = (u8 *)ModelPtr->Regs + (Addr - ModelPtr->BaseAddr);
+	}
+
+	switch (Width) {
+	case 8U:
+		*(volatile u8 *)Ptr = (u8)Value;
+		break;
+	case 16U:
+		*(volatile u16 *)Ptr = (u16)Value;
+		break;
+	case 32U:
+		*(volatile u32 *)Ptr = (u32)Value;
+		break;
+	default:
+		*(volatile u64 *)Ptr = Value;
+		break;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Gets the counters of the simulation backend.
+*
+* @param	StatsPtr: the counters, filled on return
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_SimGetStats(Xil_SimStats *StatsPtr)
+{
+	StatsPtr->RegReads = __atomic_load_n(&Xil_SimCounters.RegReads,
+					     __ATOMIC_RELAXED);
+	StatsPtr->RegWrites = __atomic_load_n(&Xil_SimCounters.RegWrites,
+					      __ATOMIC_RELAXED);
+	StatsPtr->MemReads = __atomic_load_n(&Xil_SimCounters.MemReads,
+					     __ATOMIC_RELAXED);
+	StatsPtr->MemWrites = __atomic_load_n(&Xil_SimCounters.MemWrites,
+					      __ATOMIC_RELAXED);
+	StatsPtr->DCacheFlushes =
+		__atomic_load_n(&Xil_SimCounters.DCacheFlushes,
+				__ATOMIC_RELAXED);
+	StatsPtr->DCacheInvalidates =
+		__atomic_load_n(&Xil_SimCounters.DCacheInvalidates,
+				__ATOMIC_RELAXED);
+	StatsPtr->Barriers = __atomic_load_n(&Xil_SimCounters.Barriers,
+					     __ATOMIC_RELAXED);
+}
+
+/*****************************************************************************/
+/**
+*
+* @brief    Clears the counters of the simulation backend and of the
+*           registered models.
+*
+* @return	None.
+*
+******************************************************************************/
+void Xil_SimResetStats(void)
+{
+	Xil_SimModel *Cur;
+
+	(void)pthread_mutex_lock(&Xil_SimLock);
+	(void)memset(&Xil_SimCounters, 0, sizeof(Xil_SimCounters));
+	for (Cur = Xil_SimModels; Cur != NULL; Cur = Cur->Next) {
+		Cur->ReadCount = 0U;
+		Cur->WriteCount = 0U;
+	}
+	(void)pthread_mutex_unlock(&Xil_SimLock);
+}
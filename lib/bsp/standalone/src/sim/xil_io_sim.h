@@ -0,0 +1,123 @@
+/******************************************************************************
+* Copyright (c) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xil_io_sim.h
+*
+* @addtogroup common_io_sim_apis Host Register Model APIs
+*
+* The xil_io_sim.h file contains the interface of the host simulation backend
+* of the standalone BSP. When the BSP and the drivers are built with the
+* XIL_IO_SIM flag, Xil_In8/16/32/64 and Xil_Out8/16/32/64 call Xil_SimIn and
+* Xil_SimOut instead of accessing the memory directly. These look up the
+* register model registered for the address, so that the driver code runs
+* unmodified on a Linux host against models of its device.
+*
+* Accesses outside of any model go to the host memory, as the buffer
+* descriptors and the buffers of the DMA drivers live in the normal memory.
+* The backend counts the register accesses, the cache maintenance operations
+* and the barriers, see Xil_SimGetStats.
+*
+* @{
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who      Date     Changes
+* ----- -------- -------- -----------------------------------------------
+* 7.7   jb       10/18/26 First release
+*
+* </pre>
+******************************************************************************/
+
+#ifndef XIL_IO_SIM_H		/* prevent circular inclusions */
+#define XIL_IO_SIM_H		/* by using protection macros */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************** Include Files *********************************/
+
+#include "xil_types.h"
+
+/**************************** Type Definitions *******************************/
+
+typedef struct Xil_SimModel Xil_SimModel;
+
+/**
+ * Read handler of a register model. Offset is relative to the base address
+ * of the model and Width is the access width in bits: 8, 16, 32 or 64.
+ */
+typedef u64 (*Xil_SimReadFn)(Xil_SimModel *ModelPtr, UINTPTR Offset,
+			     u32 Width);
+
+/**
+ * Write handler of a register model, see Xil_SimReadFn.
+ */
+typedef void (*Xil_SimWriteFn)(Xil_SimModel *ModelPtr, UINTPTR Offset,
+			       u64 Value, u32 Width);
+
+/**
+ * Register model of a device. A model without handlers behaves as a plain
+ * register file backed by Regs.
+ */
+struct Xil_SimModel {
+	const char8 *Name;	/**< Name of the model, for the reports */
+	UINTPTR BaseAddr;	/**< Base address of the register space */
+	UINTPTR Size;		/**< Size in bytes of the register space */
+	Xil_SimReadFn Read;	/**< Read handler, NULL for a register file */
+	Xil_SimWriteFn Write;	/**< Write handler, NULL for a register file */
+	void *Regs;		/**< Register file of Size bytes */
+	void *Data;		/**< Private data of the model */
+	u64 ReadCount;		/**< Reads of the model registers */
+	u64 WriteCount;		/**< Writes of the model registers */
+	Xil_SimModel *Next;	/**< Next registered model */
+};
+
+/**
+ * Counters of the simulation backend, since the last Xil_SimResetStats.
+ */
+typedef struct {
+	u64 RegReads;		/**< Reads of the model registers */
+	u64 RegWrites;		/**< Writes of the model registers */
+	u64 MemReads;		/**< Xil_In* outside of any model */
+	u64 MemWrites;		/**< Xil_Out* outside of any model */
+	u64 DCacheFlushes;	/**< Data cache flush operations */
+	u64 DCacheInvalidates;	/**< Data cache invalidate operations */
+	u64 Barriers;		/**< dmb/dsb/isb barriers */
+} Xil_SimStats;
+
+/**
+ *@cond nocomments
+ */
+/** Counters updated by the cache and barrier operations of the backend */
+extern Xil_SimStats Xil_SimCounters;
+
+#define XIL_SIM_COUNT(Counter) \
+	(void)__atomic_fetch_add(&Xil_SimCounters.Counter, 1U, __ATOMIC_RELAXED)
+/**
+ *@endcond
+ */
+
+/************************** Function Prototypes ******************************/
+
+s32 Xil_SimRegisterModel(Xil_SimModel *ModelPtr);
+void Xil_SimUnregisterModel(Xil_SimModel *ModelPtr);
+Xil_SimModel *Xil_SimLookupModel(UINTPTR Addr);
+u64 Xil_SimIn(UINTPTR Addr, u32 Width);
+void Xil_SimOut(UINTPTR Addr, u64 Value, u32 Width);
+void Xil_SimGetStats(Xil_SimStats *StatsPtr);
+void Xil_SimResetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of protection macro */
+/**
+* @} End of "addtogroup common_io_sim_apis".
+*/
@@ -0,0 +1,18 @@
+/******************************************************************************
+* Copyright (c) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*
+ * xparameters.h of the host simulation backend. There is no hardware design,
+ * the tests describe the devices they model in the configuration structures
+ * of the drivers.
+ */
+
+#ifndef XPARAMETERS_H	/* prevent circular inclusions */
+#define XPARAMETERS_H	/* by using protection macros */
+
+/* Enables the console of xil_printf, see outbyte.c */
+#define STDOUT_BASEADDRESS 0U
+
+#endif	/* end of protection macro */
@@ -0,0 +1,58 @@
+/******************************************************************************
+* Copyright (c) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xpseudo_asm.h
+*
+* @addtogroup common_io_sim_apis Host Register Model APIs
+*
+* Barriers of the host simulation backend. They map to compiler fences of
+* the host, as the register models run in the same address space, and are
+* counted in the backend counters.
+*
+* @{
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who  Date     Changes
+* ----- ---- -------- -----------------------------------------------
+* 7.7   jb   10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+#ifndef XPSEUDO_ASM_H
+#define XPSEUDO_ASM_H
+
+#include "xil_io_sim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+#define XIL_SIM_BARRIER() \
+	do { \
+		XIL_SIM_COUNT(Barriers); \
+		__atomic_thread_fence(__ATOMIC_SEQ_CST); \
+	} while (0)
+
+/* Data Memory Barrier */
+#define dmb()	XIL_SIM_BARRIER()
+/* Data Synchronization Barrier */
+#define dsb()	XIL_SIM_BARRIER()
+/* Instruction Synchronization Barrier */
+#define isb()	XIL_SIM_BARRIER()
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XPSEUDO_ASM_H */
+/**
+* @} End of "addtogroup common_io_sim_apis".
+*/
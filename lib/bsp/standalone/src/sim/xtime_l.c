@@ -0,0 +1,59 @@
+/******************************************************************************
+* Copyright (c) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xtime_l.c
+*
+* Time functions of the host simulation backend.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who    Date     Changes
+* ----- ------ -------- ---------------------------------------------------
+* 7.7   jb     10/18/26 First release
+* </pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <time.h>
+#include "xtime_l.h"
+
+/****************************************************************************/
+/**
+* @brief	The host clock can not be set, this function does nothing.
+*
+* @param	Xtime_Global: 64 bit value to be written, ignored.
+*
+* @return	None.
+*
+****************************************************************************/
+void XTime_SetTime(XTime Xtime_Global)
+{
+	(void)Xtime_Global;
+}
+
+/****************************************************************************/
+/**
+* @brief	Get the time from the monotonic clock of the host.
+*
+* @param	Xtime_Global: Pointer to the 64 bit location to be updated with
+*		the time in nanoseconds.
+*
+* @return	None.
+*
+****************************************************************************/
+void XTime_GetTime(XTime *Xtime_Global)
+{
+	struct timespec Ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &Ts);
+	*Xtime_Global = ((XTime)Ts.tv_sec * COUNTS_PER_SECOND) +
+			(XTime)Ts.tv_nsec;
+}
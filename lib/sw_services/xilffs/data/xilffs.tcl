@@ -9,6 +9,10 @@
 # 1.00a hk/sg 10/17/13 First release
 # 2.0   hk    12/13/13 Modified to use new TCL API's
 # 4.1   hk    11/21/18 Use additional LFN options
+# 4.7   jb    10/18/26 Add sd_async_io and use_fastseek options
+#       jb    10/18/26 Add sector cache options
+#       jb    10/18/26 Add fs_reentrant and fs_timeout options
+#       jb    10/18/26 Reject a negative read_ahead option
 #
 ##############################################################################
 
@@ -94,6 +98,13 @@ proc xgen_opts_file {libhandle} {
 	set set_fs_rpath [common::get_property CONFIG.set_fs_rpath $libhandle]
 	set word_access [common::get_property CONFIG.word_access $libhandle]
 	set use_chmod [common::get_property CONFIG.use_chmod $libhandle]
+	set use_fastseek [common::get_property CONFIG.use_fastseek $libhandle]
+	set sd_async_io [common::get_property CONFIG.sd_async_io $libhandle]
+	set cache_ways [common::get_property CONFIG.cache_ways $libhandle]
+	set cache_sets [common::get_property CONFIG.cache_sets $libhandle]
+	set read_ahead [common::get_property CONFIG.read_ahead $libhandle]
+	set fs_reentrant [common::get_property CONFIG.fs_reentrant $libhandle]
+	set fs_timeout [common::get_property CONFIG.fs_timeout $libhandle]
 
 	# do processor specific checks
 	set proc  [hsi::get_sw_processor];
@@ -144,6 +155,18 @@ proc xgen_opts_file {libhandle} {
 			puts $file_handle "\#define FILE_SYSTEM_FS_EXFAT"
 			set use_lfn 1
 		}
+		if {$fs_reentrant == true} {
+			set os [lindex [hsi::get_os] 0]
+			if {$os != "freertos10_xilinx"} {
+				puts "WARNING : fs_reentrant is valid only with \
+						freertos10_xilinx"
+				set fs_reentrant false
+			} elseif {$use_lfn == 1} {
+				puts "WARNING : Static LFN buffer is not thread safe, \
+						setting use_lfn to 2\n"
+				set use_lfn 2
+			}
+		}
 		if {$use_lfn > 0 && $use_lfn < 4} {
 			puts $file_handle "\#define FILE_SYSTEM_USE_LFN $use_lfn"
 		}
@@ -164,6 +187,36 @@ proc xgen_opts_file {libhandle} {
 		if {$use_trim == true} {
 			puts $file_handle "\#define FILE_SYSTEM_USE_TRIM"
 		}
+		if {$use_fastseek == true} {
+			puts $file_handle "\#define FILE_SYSTEM_USE_FASTSEEK"
+		}
+		if {$sd_async_io == true} {
+			if {$fs_interface == 1 && $read_only == false} {
+				puts $file_handle "\#define FILE_SYSTEM_SD_ASYNC_IO"
+			} else {
+				puts "WARNING : sd_async_io is valid only with \
+						SD interface in read write mode"
+			}
+		}
+		if {$cache_ways > 0} {
+			if {$cache_sets < 1} {
+				puts "WARNING : Invalid cache_sets option, setting \
+						back to 16\n"
+				set cache_sets 16
+			}
+			if {$read_ahead < 0} {
+				puts "WARNING : Invalid read_ahead option, setting \
+						back to 0\n"
+				set read_ahead 0
+			}
+			puts $file_handle "\#define FILE_SYSTEM_CACHE_WAYS $cache_ways"
+			puts $file_handle "\#define FILE_SYSTEM_CACHE_SETS $cache_sets"
+			puts $file_handle "\#define FILE_SYSTEM_READ_AHEAD $read_ahead"
+		}
+		if {$fs_reentrant == true} {
+			puts $file_handle "\#define FILE_SYSTEM_FS_REENTRANT"
+			puts $file_handle "\#define FILE_SYSTEM_FS_TIMEOUT $fs_timeout"
+		}
 		if {$num_logical_vol > 10} {
 			puts "WARNING : File System supports only up to 10 logical drives\
 					Setting back the num of vol to 10\n"
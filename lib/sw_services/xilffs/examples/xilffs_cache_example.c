@@ -0,0 +1,229 @@
+/******************************************************************************
+* Copyright (c) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xilffs_cache_example.c
+*
+*
+* @note This example exercises the sector cache of the file system. It
+* formats the drive, writes a set of files in small chunks, reads them back
+* twice and compares the data, then prints the transfer and cache counters
+* of the drive. Running it with cache_ways set to 0 and then to a non-zero
+* value compares the number of medium accesses with and without the cache.
+* To test this example File System should not be in Read Only mode.
+* To test this example USE_MKFS option should be true.
+*
+* The example works with both the SD and the RAM interfaces. With the RAM
+* interface and no RAMFS_START_ADDR, the RAM disk is a static buffer and the
+* example can be built and run on a host.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 4.7   jb  10/18/26 First release
+*
+*</pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "xparameters.h"	/* SDK generated parameters */
+#include "xstatus.h"
+#include "xil_printf.h"
+#include "ff.h"
+#include "diskio.h"
+
+/************************** Constant Definitions *****************************/
+#define NUM_FILES	40U		/* Number of files written */
+#define FILE_SIZE	20000U		/* Size of each file */
+#define WRITE_CHUNK	700U		/* Bytes per f_write */
+#define READ_CHUNK	300U		/* Bytes per f_read */
+#define NUM_PASSES	2U		/* Number of times the files are read */
+
+/**************************** Type Definitions *******************************/
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+int FfsCacheExample(void);
+static void FillPattern(u32 FileNum);
+
+/************************** Variable Definitions *****************************/
+static FIL fil;		/* File object */
+static FATFS fatfs;
+static TCHAR *Path = "0:/";
+
+#ifdef __ICCARM__
+#pragma data_alignment = 32
+u8 WorkBuff[FF_MAX_SS * 4];
+#pragma data_alignment = 32
+u8 SourceAddress[FILE_SIZE];
+#pragma data_alignment = 32
+u8 DestinationAddress[FILE_SIZE];
+#else
+u8 WorkBuff[FF_MAX_SS * 4] __attribute__ ((aligned(32)));
+u8 SourceAddress[FILE_SIZE] __attribute__ ((aligned(32)));
+u8 DestinationAddress[FILE_SIZE] __attribute__ ((aligned(32)));
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Main function to call the cache example.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int main(void)
+{
+	int Status;
+
+	xil_printf("File System Sector Cache Example Test \r\n");
+
+	Status = FfsCacheExample();
+	if (Status != XST_SUCCESS) {
+		xil_printf("File System Sector Cache Example Test failed \r\n");
+		return XST_FAILURE;
+	}
+
+	xil_printf("Successfully ran File System Sector Cache Example Test \r\n");
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Fills the source buffer with the data of a file.
+*
+* @param	FileNum is the number of the file.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void FillPattern(u32 FileNum)
+{
+	u32 Index;
+
+	for (Index = 0U; Index < FILE_SIZE; Index++) {
+		SourceAddress[Index] = (u8)((FileNum * 7U) + (Index * 13U) +
+				(Index >> 9U));
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes and reads back the files in small chunks and prints the counters of
+* the drive.
+*
+* @param	None
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+int FfsCacheExample(void)
+{
+	FRESULT Res;
+	UINT NumBytes;
+	UINT Len;
+	u32 FileNum;
+	u32 Pass;
+	u32 Offset;
+	char FileName[16];
+	DISK_STATS Stats;
+
+	Res = f_mount(&fatfs, Path, 0U);
+	if (Res != FR_OK) {
+		return XST_FAILURE;
+	}
+
+	Res = f_mkfs(Path, FM_FAT, 0U, WorkBuff, sizeof(WorkBuff));
+	if (Res != FR_OK) {
+		return XST_FAILURE;
+	}
+
+	disk_reset_stats(0U);
+
+	for (FileNum = 0U; FileNum < NUM_FILES; FileNum++) {
+		FillPattern(FileNum);
+		(void)sprintf(FileName, "0:/f%lu.bin", (unsigned long)FileNum);
+
+		Res = f_open(&fil, FileName, FA_CREATE_ALWAYS | FA_WRITE);
+		if (Res != FR_OK) {
+			return XST_FAILURE;
+		}
+		for (Offset = 0U; Offset < FILE_SIZE; Offset += WRITE_CHUNK) {
+			Len = (UINT)(((FILE_SIZE - Offset) < WRITE_CHUNK) ?
+					(FILE_SIZE - Offset) : WRITE_CHUNK);
+			Res = f_write(&fil, &SourceAddress[Offset], Len,
+					&NumBytes);
+			if ((Res != FR_OK) || (NumBytes != Len)) {
+				return XST_FAILURE;
+			}
+		}
+		Res = f_close(&fil);
+		if (Res != FR_OK) {
+			return XST_FAILURE;
+		}
+	}
+
+	for (Pass = 0U; Pass < NUM_PASSES; Pass++) {
+		for (FileNum = 0U; FileNum < NUM_FILES; FileNum++) {
+			FillPattern(FileNum);
+			(void)sprintf(FileName, "0:/f%lu.bin",
+					(unsigned long)FileNum);
+
+			Res = f_open(&fil, FileName, FA_READ);
+			if (Res != FR_OK) {
+				return XST_FAILURE;
+			}
+			(void)memset(DestinationAddress, 0, FILE_SIZE);
+			for (Offset = 0U; Offset < FILE_SIZE;
+					Offset += READ_CHUNK) {
+				Len = (UINT)(((FILE_SIZE - Offset) < READ_CHUNK) ?
+						(FILE_SIZE - Offset) : READ_CHUNK);
+				Res = f_read(&fil, &DestinationAddress[Offset],
+						Len, &NumBytes);
+				if ((Res != FR_OK) || (NumBytes != Len)) {
+					return XST_FAILURE;
+				}
+			}
+			Res = f_close(&fil);
+			if (Res != FR_OK) {
+				return XST_FAILURE;
+			}
+
+			if (memcmp(SourceAddress, DestinationAddress,
+					FILE_SIZE) != 0) {
+				return XST_FAILURE;
+			}
+		}
+	}
+
+	disk_get_stats(0U, &Stats);
+	xil_printf("Medium reads %d writes %d\r\n", Stats.NumReads,
+			Stats.NumWrites);
+	xil_printf("Cache hits %d misses %d prefetched %d write backs %d\r\n",
+			Stats.CacheHits, Stats.CacheMisses,
+			Stats.NumPrefetched, Stats.NumWriteBacks);
+
+	return XST_SUCCESS;
+}
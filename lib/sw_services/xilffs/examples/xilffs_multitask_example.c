@@ -0,0 +1,312 @@
+/******************************************************************************
+* Copyright (c) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+/*****************************************************************************/
+/**
+*
+* @file xilffs_multitask_example.c
+*
+*
+* @note This example measures the file system throughput of FreeRTOS tasks
+* writing to independent volumes. Each task writes and reads back a file on
+* its own volume, first one task after the other, then all tasks at the same
+* time. With fs_reentrant set to true each volume has its own lock, so the
+* parallel run overlaps the transfers of the volumes instead of serializing
+* them.
+* To test this example File System should not be in Read Only mode.
+* To test this example USE_MKFS option should be true.
+* To test this example fs_reentrant option should be true.
+*
+* By default the volumes are "0:/" and "1:/", the two SD controllers of the
+* device, each volume is formatted by the example.
+*
+* <pre>
+* MODIFICATION HISTORY:
+*
+* Ver   Who Date     Changes
+* ----- --- -------- -----------------------------------------------
+* 4.7   jb  10/18/26 First release
+*
+*</pre>
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "xparameters.h"	/* SDK generated parameters */
+#include "xstatus.h"
+#include "xil_printf.h"
+#include "ff.h"
+
+/************************** Constant Definitions *****************************/
+#define NUM_VOLUMES	2U		/* Volumes written in parallel */
+#define FILE_SIZE	(8U * 1024U * 1024U)	/* Bytes per file */
+#define CHUNK_SIZE	(64U * 1024U)	/* Bytes per f_write and f_read */
+#define TASK_STACK	1024U		/* Words */
+#define TASK_PRIORITY	(tskIDLE_PRIORITY + 1U)
+
+/**************************** Type Definitions *******************************/
+/*
+ * State of the task of a volume
+ */
+typedef struct {
+	char Path[4];			/* Volume, "N:/" */
+	u32 Status;			/* XST_SUCCESS or XST_FAILURE */
+	TickType_t WriteTicks;		/* Time of the last write */
+	TickType_t ReadTicks;		/* Time of the last read */
+} VolumeTask;
+
+/***************** Macros (Inline Functions) Definitions *********************/
+
+/************************** Function Prototypes ******************************/
+static void MainTask(void *Arg);
+static void VolumeWorker(void *Arg);
+static u32 WriteReadVolume(VolumeTask *Vol);
+static void PrintRun(const char *Name, TickType_t Elapsed);
+
+/************************** Variable Definitions *****************************/
+static FATFS fatfs[NUM_VOLUMES];
+static VolumeTask Volumes[NUM_VOLUMES];
+static SemaphoreHandle_t DoneSem;	/* Given by each worker when done */
+
+#ifdef __ICCARM__
+#pragma data_alignment = 32
+u8 WorkBuff[FF_MAX_SS * 4];
+#pragma data_alignment = 32
+u8 ChunkBuff[NUM_VOLUMES][CHUNK_SIZE];
+#else
+u8 WorkBuff[FF_MAX_SS * 4] __attribute__ ((aligned(32)));
+u8 ChunkBuff[NUM_VOLUMES][CHUNK_SIZE] __attribute__ ((aligned(32)));
+#endif
+
+/*****************************************************************************/
+/**
+*
+* Main function to start the multi task example.
+*
+* @param	None
+*
+* @return	XST_FAILURE if the scheduler could not be started.
+*
+* @note		None
+*
+******************************************************************************/
+int main(void)
+{
+	xil_printf("Multi Task File System Example Test \r\n");
+
+	DoneSem = xSemaphoreCreateCounting(NUM_VOLUMES, 0U);
+	if (DoneSem == NULL) {
+		return XST_FAILURE;
+	}
+
+	(void)xTaskCreate(MainTask, "ffs_main", TASK_STACK, NULL,
+			TASK_PRIORITY + 1U, NULL);
+	vTaskStartScheduler();
+
+	/* Only reached if there is not enough heap for the idle task */
+	return XST_FAILURE;
+}
+
+/*****************************************************************************/
+/**
+*
+* Formats the volumes, then runs the volume workers one after the other and
+* all together and prints the throughput of each run.
+*
+* @param	Arg is unused.
+*
+* @return	None
+*
+* @note		f_mount() and f_mkfs() are not re-entrant, they are only called
+*		from this task before the workers start.
+*
+******************************************************************************/
+static void MainTask(void *Arg)
+{
+	TickType_t Start;
+	TickType_t Sequential;
+	TickType_t Parallel;
+	u32 Index;
+	u32 Status = XST_SUCCESS;
+
+	(void)Arg;
+
+	for (Index = 0U; Index < NUM_VOLUMES; Index++) {
+		(void)sprintf(Volumes[Index].Path, "%lu:/", (unsigned long)Index);
+		if ((f_mount(&fatfs[Index], Volumes[Index].Path, 0U) != FR_OK) ||
+				(f_mkfs(Volumes[Index].Path, FM_FAT32, 0U, WorkBuff,
+					sizeof(WorkBuff)) != FR_OK)) {
+			xil_printf("Failed to format %s\r\n", Volumes[Index].Path);
+			Status = XST_FAILURE;
+			goto END;
+		}
+	}
+
+	/* One volume at a time */
+	Start = xTaskGetTickCount();
+	for (Index = 0U; Index < NUM_VOLUMES; Index++) {
+		if (WriteReadVolume(&Volumes[Index]) != XST_SUCCESS) {
+			Status = XST_FAILURE;
+			goto END;
+		}
+	}
+	Sequential = xTaskGetTickCount() - Start;
+
+	/* All volumes at once */
+	Start = xTaskGetTickCount();
+	for (Index = 0U; Index < NUM_VOLUMES; Index++) {
+		if (xTaskCreate(VolumeWorker, "ffs_vol", TASK_STACK,
+				&Volumes[Index], TASK_PRIORITY, NULL) != pdPASS) {
+			Status = XST_FAILURE;
+			goto END;
+		}
+	}
+	for (Index = 0U; Index < NUM_VOLUMES; Index++) {
+		(void)xSemaphoreTake(DoneSem, portMAX_DELAY);
+	}
+	Parallel = xTaskGetTickCount() - Start;
+
+	for (Index = 0U; Index < NUM_VOLUMES; Index++) {
+		if (Volumes[Index].Status != XST_SUCCESS) {
+			Status = XST_FAILURE;
+			goto END;
+		}
+		xil_printf("%s write %d ms read %d ms\r\n", Volumes[Index].Path,
+				(int)(Volumes[Index].WriteTicks * portTICK_PERIOD_MS),
+				(int)(Volumes[Index].ReadTicks * portTICK_PERIOD_MS));
+	}
+
+	PrintRun("Sequential", Sequential);
+	PrintRun("Parallel", Parallel);
+
+END:
+	if (Status != XST_SUCCESS) {
+		xil_printf("Multi Task File System Example Test failed \r\n");
+	} else {
+		xil_printf("Successfully ran Multi Task File System Example Test \r\n");
+	}
+	vTaskDelete(NULL);
+}
+
+/*****************************************************************************/
+/**
+*
+* Task writing and reading back the file of a volume.
+*
+* @param	Arg is the VolumeTask of the volume.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void VolumeWorker(void *Arg)
+{
+	VolumeTask *Vol = (VolumeTask *)Arg;
+
+	Vol->Status = WriteReadVolume(Vol);
+	(void)xSemaphoreGive(DoneSem);
+	vTaskDelete(NULL);
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes a file of FILE_SIZE bytes to a volume in CHUNK_SIZE chunks, then
+* reads it back and checks the data.
+*
+* @param	Vol is the VolumeTask of the volume.
+*
+* @return	XST_SUCCESS if successful, otherwise XST_FAILURE.
+*
+* @note		None
+*
+******************************************************************************/
+static u32 WriteReadVolume(VolumeTask *Vol)
+{
+	u8 *Buff = ChunkBuff[Vol - Volumes];
+	u8 Pattern = (u8)(Vol->Path[0]);
+	char FileName[16];
+	TickType_t Start;
+	FIL fil;
+	UINT NumBytes;
+	u32 Offset;
+	u32 Index;
+
+	(void)sprintf(FileName, "%sTest.bin", Vol->Path);
+
+	Start = xTaskGetTickCount();
+	if (f_open(&fil, FileName, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK) {
+		return XST_FAILURE;
+	}
+	for (Offset = 0U; Offset < FILE_SIZE; Offset += CHUNK_SIZE) {
+		(void)memset(Buff, (int)(Pattern + (Offset / CHUNK_SIZE)),
+				CHUNK_SIZE);
+		if ((f_write(&fil, Buff, CHUNK_SIZE, &NumBytes) != FR_OK) ||
+				(NumBytes != CHUNK_SIZE)) {
+			(void)f_close(&fil);
+			return XST_FAILURE;
+		}
+	}
+	if (f_close(&fil) != FR_OK) {
+		return XST_FAILURE;
+	}
+	Vol->WriteTicks = xTaskGetTickCount() - Start;
+
+	Start = xTaskGetTickCount();
+	if (f_open(&fil, FileName, FA_READ) != FR_OK) {
+		return XST_FAILURE;
+	}
+	for (Offset = 0U; Offset < FILE_SIZE; Offset += CHUNK_SIZE) {
+		if ((f_read(&fil, Buff, CHUNK_SIZE, &NumBytes) != FR_OK) ||
+				(NumBytes != CHUNK_SIZE)) {
+			(void)f_close(&fil);
+			return XST_FAILURE;
+		}
+		for (Index = 0U; Index < CHUNK_SIZE; Index++) {
+			if (Buff[Index] != (u8)(Pattern + (Offset / CHUNK_SIZE))) {
+				(void)f_close(&fil);
+				return XST_FAILURE;
+			}
+		}
+	}
+	if (f_close(&fil) != FR_OK) {
+		return XST_FAILURE;
+	}
+	Vol->ReadTicks = xTaskGetTickCount() - Start;
+
+	return XST_SUCCESS;
+}
+
+/*****************************************************************************/
+/**
+*
+* Prints the aggregate throughput of a run over all the volumes.
+*
+* @param	Name is the name of the run.
+* @param	Elapsed is the duration of the run in ticks.
+*
+* @return	None
+*
+* @note		None
+*
+******************************************************************************/
+static void PrintRun(const char *Name, TickType_t Elapsed)
+{
+	u32 Ms = (u32)(Elapsed * portTICK_PERIOD_MS);
+	u32 KBytes = (NUM_VOLUMES * FILE_SIZE * 2U) / 1024U;
+
+	if (Ms == 0U) {
+		Ms = 1U;
+	}
+	xil_printf("%s: %d ms, %d KB/s\r\n", Name, (int)Ms,
+			(int)((KBytes * 1000U) / Ms));
+}
@@ -27,6 +27,24 @@
 *		The default block size is 512 bytes.
 *		disk_read and disk_write functions are used to read and
 *		write files using ADMA2 in polled mode.
+*		When "sd_async_io" is set, disk_write copies the data into
+*		one of SD_ASYNC_NUM_REQS request buffers and returns while
+*		the card is written in interrupt mode. Contiguous writes are
+*		merged into the last request that is not started yet and the
+*		SD interrupt, connected to disk_sd_intr_handler, starts the
+*		next request. disk_read waits for the bus and for the queued
+*		writes it overlaps, CTRL_SYNC waits for all queued writes.
+*		disk_get_stats returns the transfer counters of a drive.
+*
+*		Description related to the sector cache:
+*		When "cache_ways" is non-zero, requests shorter than
+*		DISK_CACHE_BYPASS sectors go through a cache of
+*		"cache_sets" x "cache_ways" sectors per drive, replaced in
+*		LRU order within a set. A miss that follows the previous read
+*		also reads the next "read_ahead" sectors. Writes only update
+*		the cache, dirty sectors are written back when they are
+*		replaced or on CTRL_SYNC, together with the dirty sectors
+*		next to them. Longer requests bypass the cache.
 *		The file system can be used to read from and write to an
 *		SD card that is already formatted as FATFS.
 *
@@ -65,53 +83,982 @@
 *       mn   04/08/20 Set IsReady to '0' before calling XSdPs_CfgInitialize
 * 4.5   sk   03/31/21 Maintain discrete global variables for each controller.
 * 4.6   sk   07/20/21 Fixed compilation warning in RAM interface.
+* 4.7   jb   10/18/26 Added queued interrupt mode SD writes and transfer
+*                     counters.
+*       jb   10/18/26 Added set associative sector cache with read-ahead
+*                     and write-back.
+*
+* </pre>
+*
+* @note
+*
+******************************************************************************/
+#include "diskio.h"
+#include "ff.h"
+#include "xil_types.h"
+
+#ifdef FILE_SYSTEM_INTERFACE_SD
+#include "xsdps.h"		/* SD device driver */
+#endif
+#include "sleep.h"
+#include "xil_printf.h"
+
+#if defined (__arm__) || defined (__aarch64__)
+#include "xtime_l.h"
+#endif
+
+#if defined (FILE_SYSTEM_SD_ASYNC_IO) && !defined (FILE_SYSTEM_INTERFACE_SD)
+#undef FILE_SYSTEM_SD_ASYNC_IO
+#endif
+
+#define SD_CD_DELAY		10000U
+#define XSDPS_NUM_INSTANCES	2
+
+#ifdef FILE_SYSTEM_SD_ASYNC_IO
+#ifndef SD_ASYNC_NUM_REQS
+#define SD_ASYNC_NUM_REQS	4U	/* Queued write requests per drive */
+#endif
+#ifndef SD_ASYNC_REQ_SECTORS
+#define SD_ASYNC_REQ_SECTORS	64U	/* Sectors per request buffer */
+#endif
+#define SD_ASYNC_REQ_BYTES	(SD_ASYNC_REQ_SECTORS * XSDPS_BLK_SIZE_512_MASK)
+#endif
+
+#if defined (FILE_SYSTEM_CACHE_WAYS) && (FILE_SYSTEM_CACHE_WAYS > 0)
+#define DISK_CACHE
+#ifndef FILE_SYSTEM_CACHE_SETS
+#define FILE_SYSTEM_CACHE_SETS	16
+#endif
+#ifndef FILE_SYSTEM_READ_AHEAD
+#define FILE_SYSTEM_READ_AHEAD	8
+#endif
+#if FILE_SYSTEM_READ_AHEAD < 0
+#error "FILE_SYSTEM_READ_AHEAD must not be negative"
+#endif
+#ifndef DISK_CACHE_BYPASS
+#define DISK_CACHE_BYPASS	8	/* Requests of this many sectors bypass the cache */
+#endif
+#define CACHE_SECTOR_SIZE	512U
+#define CACHE_NUM_LINES		(FILE_SYSTEM_CACHE_SETS * FILE_SYSTEM_CACHE_WAYS)
+#define CACHE_FILL_SECTORS	(FILE_SYSTEM_READ_AHEAD + 1)
+#define CACHE_WB_SECTORS	DISK_CACHE_BYPASS
+#define CACHE_NONE		0xFFFFFFFFU
+#endif
+
+#ifdef FILE_SYSTEM_INTERFACE_RAM
+#include "xparameters.h"
+
+static char *dataramfs = NULL;
+#ifndef RAMFS_START_ADDR
+static char RamFs[RAMFS_SIZE];	/* Host builds */
+#endif
+
+#define BLOCKSIZE       1U
+#define SECTORSIZE      512U
+#define SECTORCNT       (RAMFS_SIZE / SECTORSIZE)
+#endif
+
+/*--------------------------------------------------------------------------
+
+	Public Functions
+
+---------------------------------------------------------------------------*/
+
+/*
+ * Global variables
+ */
+static DSTATUS Stat[XSDPS_NUM_INSTANCES] = {STA_NOINIT, STA_NOINIT};	/* Disk status */
+
+#ifdef FILE_SYSTEM_INTERFACE_SD
+static XSdPs SdInstance[XSDPS_NUM_INSTANCES];
+static u32 BaseAddress[XSDPS_NUM_INSTANCES];
+static u32 CardDetect[XSDPS_NUM_INSTANCES];
+static u32 WriteProtect[XSDPS_NUM_INSTANCES];
+static u32 SlotType[XSDPS_NUM_INSTANCES];
+static u8 HostCntrlrVer[XSDPS_NUM_INSTANCES];
+#endif
+
+static DISK_STATS Stats[XSDPS_NUM_INSTANCES];	/* Transfer counters */
+
+static DRESULT disk_read_dev (BYTE pdrv, BYTE *buff, DWORD sector, UINT count);
+static DRESULT disk_write_dev (BYTE pdrv, const BYTE *buff, DWORD sector,
+		UINT count);
+
+#ifdef DISK_CACHE
+/*
+ * Cache line, holds one sector
+ */
+typedef struct {
+	DWORD Sector;		/* Cached sector number (LBA) */
+	u32 LastUse;		/* LRU stamp */
+	u8 Valid;		/* Line holds Sector */
+	u8 Dirty;		/* Line is newer than the medium */
+} CacheLine;
+
+/*
+ * Sector cache of a drive. Sector n is cached in one of the
+ * FILE_SYSTEM_CACHE_WAYS lines of set n % FILE_SYSTEM_CACHE_SETS.
+ */
+typedef struct {
+	CacheLine Line[CACHE_NUM_LINES];
+	u32 Clock;		/* Last LRU stamp */
+	DWORD NextSector;	/* Sector after the last read */
+} DiskCache;
+
+static DiskCache Cache[XSDPS_NUM_INSTANCES];
+#ifdef __ICCARM__
+#pragma data_alignment = 64
+static BYTE CacheData[XSDPS_NUM_INSTANCES][CACHE_NUM_LINES][CACHE_SECTOR_SIZE];
+#pragma data_alignment = 64
+static BYTE CacheFill[XSDPS_NUM_INSTANCES][CACHE_FILL_SECTORS][CACHE_SECTOR_SIZE];
+#pragma data_alignment = 64
+static BYTE CacheWb[XSDPS_NUM_INSTANCES][CACHE_WB_SECTORS][CACHE_SECTOR_SIZE];
+#else
+static BYTE CacheData[XSDPS_NUM_INSTANCES][CACHE_NUM_LINES][CACHE_SECTOR_SIZE]
+	__attribute__ ((aligned(64)));
+static BYTE CacheFill[XSDPS_NUM_INSTANCES][CACHE_FILL_SECTORS][CACHE_SECTOR_SIZE]
+	__attribute__ ((aligned(64)));
+static BYTE CacheWb[XSDPS_NUM_INSTANCES][CACHE_WB_SECTORS][CACHE_SECTOR_SIZE]
+	__attribute__ ((aligned(64)));
+#endif
+#endif
+
+#ifdef FILE_SYSTEM_SD_ASYNC_IO
+/*
+ * Queued write request
+ */
+typedef struct {
+	BYTE *Buff;		/* Copy of the data, SD_ASYNC_REQ_BYTES */
+	DWORD Sector;		/* Start sector number (LBA) */
+	UINT Count;		/* Sector count */
+} SdAsyncReq;
+
+/*
+ * Ring of the queued write requests of a drive. Req[Head] is the oldest
+ * one and is on the bus when Active is set. The SD interrupt only updates
+ * the queue when Locked is clear, otherwise it masks itself and the task
+ * completes the transfer when it unlocks.
+ */
+typedef struct {
+	SdAsyncReq Req[SD_ASYNC_NUM_REQS];
+	u64 StartTicks;		/* Start of the active request */
+	volatile u32 Head;	/* Oldest request */
+	volatile u32 NumQueued;	/* Queued requests, including the active one */
+	volatile u8 Active;	/* Req[Head] is on the bus */
+	volatile u8 Paused;	/* Bus is held for a polled command */
+	volatile u8 Error;	/* A queued write failed */
+	volatile u8 Locked;	/* Queue is updated by the task */
+	volatile u8 Deferred;	/* Completion arrived while Locked */
+} SdAsyncQueue;
+
+static SdAsyncQueue AsyncQ[XSDPS_NUM_INSTANCES];
+#ifdef __ICCARM__
+#pragma data_alignment = 64
+static BYTE AsyncBuff[XSDPS_NUM_INSTANCES][SD_ASYNC_NUM_REQS][SD_ASYNC_REQ_BYTES];
+#else
+static BYTE AsyncBuff[XSDPS_NUM_INSTANCES][SD_ASYNC_NUM_REQS][SD_ASYNC_REQ_BYTES]
+	__attribute__ ((aligned(64)));
+#endif
+#endif
+
+/*-----------------------------------------------------------------------*/
+/* Transfer counters							*/
+/*-----------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+*
+* Reads the time base of the transfer counters.
+*
+* @return	Ticks of DISK_TICKS_PER_SEC, or 0 if there is no time base.
+*
+******************************************************************************/
+static u64 disk_ticks (void)
+{
+#if defined (__arm__) || defined (__aarch64__)
+	XTime Now;
+
+	XTime_GetTime(&Now);
+	return (u64)Now;
+#else
+	return 0U;
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* Gets the transfer counters of a drive. The read and write throughputs are
+* ReadBytes * TicksPerSec / ReadTicks and WriteBytes * TicksPerSec /
+* WriteTicks. For queued writes WriteTicks only counts the time a request
+* is on the bus, not the time it waits in the queue.
+*
+* @param	pdrv - Drive number
+* @param	*stats - Pointer to the counters to fill
+*
+* @return	None
+*
+******************************************************************************/
+void disk_get_stats (
+		BYTE pdrv,		/* Physical drive number (0) */
+		DISK_STATS *stats	/* Pointer to the counters to fill */
+)
+{
+	*stats = Stats[pdrv];
+#if defined (__arm__) || defined (__aarch64__)
+	stats->TicksPerSec = (u32)COUNTS_PER_SECOND;
+#else
+	stats->TicksPerSec = 0U;
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* Clears the transfer counters of a drive.
+*
+* @param	pdrv - Drive number
+*
+* @return	None
+*
+******************************************************************************/
+void disk_reset_stats (
+		BYTE pdrv		/* Physical drive number (0) */
+)
+{
+	(void)memset(&Stats[pdrv], 0, sizeof(DISK_STATS));
+}
+
+#ifdef FILE_SYSTEM_SD_ASYNC_IO
+/*-----------------------------------------------------------------------*/
+/* Queued SD writes							*/
+/*-----------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+*
+* Starts the oldest queued write if the bus is free. Called with the queue
+* locked or from the completion callback.
+*
+* @param	pdrv - Drive number
+*
+* @return	None
+*
+******************************************************************************/
+static void sd_async_start (BYTE pdrv)
+{
+	SdAsyncQueue *Q = &AsyncQ[pdrv];
+	SdAsyncReq *Req;
+	DWORD Arg;
+	s32 Status;
+
+	if ((Q->Active != 0U) || (Q->Paused != 0U) || (Q->NumQueued == 0U)) {
+		return;
+	}
+
+	Req = &Q->Req[Q->Head];
+	Arg = Req->Sector;
+	/* Convert LBA to byte address if needed */
+	if ((SdInstance[pdrv].HCS) == 0U) {
+		Arg *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
+	}
+
+	/* The interrupt may complete the request before the call returns */
+	Q->Active = 1U;
+	Q->StartTicks = disk_ticks();
+	Status = XSdPs_StartWriteTransfer(&SdInstance[pdrv], (u32)Arg,
+			Req->Count, Req->Buff);
+	if (Status != XST_SUCCESS) {
+		/* Drop the queue, the error is returned by the next call */
+		Q->Active = 0U;
+		Q->NumQueued = 0U;
+		Q->Error = 1U;
+		return;
+	}
+
+	Stats[pdrv].NumWrites++;
+}
+
+/*****************************************************************************/
+/**
+*
+* Completion callback of the SD driver. Retires the active request and
+* starts the next one.
+*
+* @param	CallBackRef - Drive number
+* @param	StatusEvent - XSDPS_EVENT_XFER_DONE or XSDPS_EVENT_XFER_ERROR
+*
+* @return	None
+*
+******************************************************************************/
+static void sd_async_done (void *CallBackRef, u32 StatusEvent)
+{
+	BYTE pdrv = (BYTE)(UINTPTR)CallBackRef;
+	SdAsyncQueue *Q = &AsyncQ[pdrv];
+	SdAsyncReq *Req = &Q->Req[Q->Head];
+
+	if (StatusEvent == XSDPS_EVENT_XFER_DONE) {
+		Stats[pdrv].WriteBytes += (u64)Req->Count * XSDPS_BLK_SIZE_512_MASK;
+		Stats[pdrv].WriteTicks += disk_ticks() - Q->StartTicks;
+	} else {
+		Q->Error = 1U;
+	}
+
+	Q->Head = (Q->Head + 1U) % SD_ASYNC_NUM_REQS;
+	Q->NumQueued--;
+	Q->Active = 0U;
+
+	sd_async_start(pdrv);
+}
+
+/*****************************************************************************/
+/**
+*
+* Locks the queue against the SD interrupt.
+*
+* @param	pdrv - Drive number
+*
+* @return	None
+*
+******************************************************************************/
+static void sd_async_lock (BYTE pdrv)
+{
+	AsyncQ[pdrv].Locked = 1U;
+}
+
+/*****************************************************************************/
+/**
+*
+* Unlocks the queue and completes the transfer if the SD interrupt arrived
+* while it was locked. The interrupt masked itself in that case, so it
+* cannot preempt the completion.
+*
+* @param	pdrv - Drive number
+*
+* @return	None
+*
+******************************************************************************/
+static void sd_async_unlock (BYTE pdrv)
+{
+	AsyncQ[pdrv].Locked = 0U;
+	if (AsyncQ[pdrv].Deferred != 0U) {
+		AsyncQ[pdrv].Deferred = 0U;
+		XSdPs_IntrHandler(&SdInstance[pdrv]);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* Waits until at most Depth writes are queued and, if the bus is held,
+* until the active write is done. The transfer is also polled so that
+* the queue drains when the SD interrupt is not connected.
+*
+* @param	pdrv - Drive number
+* @param	Depth - Number of queued writes to wait for
+*
+* @return	None
+*
+******************************************************************************/
+static void sd_async_wait (BYTE pdrv, u32 Depth)
+{
+	SdAsyncQueue *Q = &AsyncQ[pdrv];
+	u8 Done;
+
+	do {
+		sd_async_lock(pdrv);
+		XSdPs_IntrHandler(&SdInstance[pdrv]);
+		Done = (u8)((Q->NumQueued <= Depth) &&
+				((Q->Paused == 0U) || (Q->Active == 0U)));
+		sd_async_unlock(pdrv);
+	} while (Done == 0U);
+}
+
+/*****************************************************************************/
+/**
+*
+* Returns and clears the error of the queued writes.
+*
+* @param	pdrv - Drive number
+*
+* @return	RES_OK or RES_ERROR
+*
+******************************************************************************/
+static DRESULT sd_async_error (BYTE pdrv)
+{
+	DRESULT res = RES_OK;
+
+	sd_async_lock(pdrv);
+	if (AsyncQ[pdrv].Error != 0U) {
+		AsyncQ[pdrv].Error = 0U;
+		res = RES_ERROR;
+	}
+	sd_async_unlock(pdrv);
+
+	return res;
+}
+
+/*****************************************************************************/
+/**
+*
+* Holds the bus for a polled command on sectors sector to sector+count-1.
+* The queued writes to these sectors complete first, the others stay
+* queued until sd_async_release.
+*
+* @param	pdrv - Drive number
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return	None
+*
+******************************************************************************/
+static void sd_async_hold (BYTE pdrv, DWORD sector, UINT count)
+{
+	SdAsyncQueue *Q = &AsyncQ[pdrv];
+	SdAsyncReq *Req;
+	u8 Overlap = 0U;
+	u32 Index;
+
+	sd_async_lock(pdrv);
+	for (Index = 0U; Index < Q->NumQueued; Index++) {
+		Req = &Q->Req[(Q->Head + Index) % SD_ASYNC_NUM_REQS];
+		if ((sector < (Req->Sector + Req->Count)) &&
+				(Req->Sector < (sector + count))) {
+			Overlap = 1U;
+		}
+	}
+	sd_async_unlock(pdrv);
+
+	if (Overlap != 0U) {
+		sd_async_wait(pdrv, 0U);
+	}
+
+	sd_async_lock(pdrv);
+	Q->Paused = 1U;
+	sd_async_unlock(pdrv);
+	sd_async_wait(pdrv, SD_ASYNC_NUM_REQS);
+}
+
+/*****************************************************************************/
+/**
+*
+* Releases the bus held by sd_async_hold and restarts the queue.
+*
+* @param	pdrv - Drive number
+*
+* @return	None
+*
+******************************************************************************/
+static void sd_async_release (BYTE pdrv)
+{
+	sd_async_lock(pdrv);
+	AsyncQ[pdrv].Paused = 0U;
+	sd_async_start(pdrv);
+	sd_async_unlock(pdrv);
+}
+
+/*****************************************************************************/
+/**
+*
+* Queues a write. The data is copied, appended to the last request if it is
+* contiguous and not started yet, or into a free request. The call only
+* waits when all requests are queued.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data to be written
+* @param	sector - Sector address
+* @param	count - Sector count
+*
+* @return
+*		RES_OK		Write queued
+*		RES_ERROR	A queued write failed
+*
+******************************************************************************/
+static DRESULT sd_async_write (BYTE pdrv, const BYTE *buff, DWORD sector,
+		UINT count)
+{
+	SdAsyncQueue *Q = &AsyncQ[pdrv];
+	SdAsyncReq *Req;
+	const BYTE *LocBuff = buff;
+	DWORD LocSector = sector;
+	UINT LocCount = count;
+	UINT Num;
+	u8 Stalled = 0U;
+
+	while (LocCount > 0U) {
+		sd_async_lock(pdrv);
+		XSdPs_IntrHandler(&SdInstance[pdrv]);
+		if (Q->Error != 0U) {
+			Q->Error = 0U;
+			sd_async_unlock(pdrv);
+			return RES_ERROR;
+		}
+
+		Num = 0U;
+		Req = &Q->Req[(Q->Head + Q->NumQueued + SD_ASYNC_NUM_REQS - 1U) %
+				SD_ASYNC_NUM_REQS];
+		if ((Q->NumQueued > (u32)Q->Active) &&
+				((Req->Sector + Req->Count) == LocSector) &&
+				(Req->Count < SD_ASYNC_REQ_SECTORS)) {
+			Num = SD_ASYNC_REQ_SECTORS - Req->Count;
+			Stats[pdrv].NumMerged++;
+		} else if (Q->NumQueued < SD_ASYNC_NUM_REQS) {
+			Req = &Q->Req[(Q->Head + Q->NumQueued) % SD_ASYNC_NUM_REQS];
+			Req->Sector = LocSector;
+			Req->Count = 0U;
+			Q->NumQueued++;
+			Num = SD_ASYNC_REQ_SECTORS;
+		} else if (Stalled == 0U) {
+			Stalled = 1U;
+			Stats[pdrv].NumStalls++;
+		} else {
+			/* Wait for a free request */
+		}
+
+		if (Num > 0U) {
+			if (Num > LocCount) {
+				Num = LocCount;
+			}
+			(void)memcpy(&Req->Buff[Req->Count * XSDPS_BLK_SIZE_512_MASK],
+					LocBuff, Num * XSDPS_BLK_SIZE_512_MASK);
+			Req->Count += Num;
+			LocBuff += Num * XSDPS_BLK_SIZE_512_MASK;
+			LocSector += Num;
+			LocCount -= Num;
+			sd_async_start(pdrv);
+		}
+		sd_async_unlock(pdrv);
+	}
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Resets the write queue of a drive and sets the SD driver callback.
+*
+* @param	pdrv - Drive number
+*
+* @return	None
+*
+******************************************************************************/
+static void sd_async_init (BYTE pdrv)
+{
+	SdAsyncQueue *Q = &AsyncQ[pdrv];
+	u32 Index;
+
+	(void)memset(Q, 0, sizeof(SdAsyncQueue));
+	for (Index = 0U; Index < SD_ASYNC_NUM_REQS; Index++) {
+		Q->Req[Index].Buff = AsyncBuff[pdrv][Index];
+	}
+
+	XSdPs_SetCallback(&SdInstance[pdrv], sd_async_done,
+			(void *)(UINTPTR)pdrv);
+}
+#endif
+
+#ifdef DISK_CACHE
+/*-----------------------------------------------------------------------*/
+/* Sector cache								*/
+/*-----------------------------------------------------------------------*/
+
+/*****************************************************************************/
+/**
+*
+* Gets the number of sectors of the medium, to keep the read-ahead in it.
+*
+* @param	pdrv - Drive number
+*
+* @return	Sector count, or 0 if unknown
+*
+******************************************************************************/
+static DWORD cache_medium_sectors (BYTE pdrv)
+{
+#if defined (FILE_SYSTEM_INTERFACE_SD)
+	return (DWORD)SdInstance[pdrv].SectorCount;
+#elif defined (FILE_SYSTEM_INTERFACE_RAM)
+	(void)pdrv;
+	return (DWORD)SECTORCNT;
+#else
+	(void)pdrv;
+	return 0U;
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* Looks up a sector in its set.
+*
+* @param	pdrv - Drive number
+* @param	sector - Sector number
+*
+* @return	Index of the line holding the sector, or CACHE_NONE
+*
+******************************************************************************/
+static u32 cache_find (BYTE pdrv, DWORD sector)
+{
+	DiskCache *C = &Cache[pdrv];
+	u32 Index = (u32)(sector % (DWORD)FILE_SYSTEM_CACHE_SETS) *
+			(u32)FILE_SYSTEM_CACHE_WAYS;
+	u32 Way;
+
+	for (Way = 0U; Way < (u32)FILE_SYSTEM_CACHE_WAYS; Way++) {
+		if ((C->Line[Index + Way].Valid != 0U) &&
+				(C->Line[Index + Way].Sector == sector)) {
+			return Index + Way;
+		}
+	}
+
+	return CACHE_NONE;
+}
+
+/*****************************************************************************/
+/**
+*
+* Marks a line as the most recently used of its set.
+*
+* @param	pdrv - Drive number
+* @param	Index - Line index
+*
+* @return	None
+*
+******************************************************************************/
+static void cache_touch (BYTE pdrv, u32 Index)
+{
+	Cache[pdrv].Clock++;
+	Cache[pdrv].Line[Index].LastUse = Cache[pdrv].Clock;
+}
+
+/*****************************************************************************/
+/**
+*
+* Writes back a dirty line in one request with the dirty lines of the
+* sectors before and after it, up to CACHE_WB_SECTORS sectors.
+*
+* @param	pdrv - Drive number
+* @param	Index - Index of the dirty line
+*
+* @return	RES_OK or the error of the write
+*
+******************************************************************************/
+static DRESULT cache_write_back (BYTE pdrv, u32 Index)
+{
+	DiskCache *C = &Cache[pdrv];
+	DWORD First = C->Line[Index].Sector;
+	UINT Count = 1U;
+	UINT Num;
+	u32 Other;
+	DRESULT res;
+
+	while ((First > 0U) && (Count < (UINT)CACHE_WB_SECTORS)) {
+		Other = cache_find(pdrv, First - 1U);
+		if ((Other == CACHE_NONE) || (C->Line[Other].Dirty == 0U)) {
+			break;
+		}
+		First--;
+		Count++;
+	}
+	while (Count < (UINT)CACHE_WB_SECTORS) {
+		Other = cache_find(pdrv, First + Count);
+		if ((Other == CACHE_NONE) || (C->Line[Other].Dirty == 0U)) {
+			break;
+		}
+		Count++;
+	}
+
+	for (Num = 0U; Num < Count; Num++) {
+		Other = cache_find(pdrv, First + Num);
+		(void)memcpy(CacheWb[pdrv][Num], CacheData[pdrv][Other],
+				CACHE_SECTOR_SIZE);
+	}
+
+	res = disk_write_dev(pdrv, CacheWb[pdrv][0], First, Count);
+	if (res != RES_OK) {
+		return res;
+	}
+
+	for (Num = 0U; Num < Count; Num++) {
+		C->Line[cache_find(pdrv, First + Num)].Dirty = 0U;
+	}
+	Stats[pdrv].NumWriteBacks++;
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* Allocates a line for a sector that is not cached. The least recently used
+* line of the set is replaced, and written back first if it is dirty.
+*
+* @param	pdrv - Drive number
+* @param	sector - Sector number
+* @param	*Index - Index of the allocated line
+*
+* @return	RES_OK or the error of the write back
+*
+******************************************************************************/
+static DRESULT cache_alloc (BYTE pdrv, DWORD sector, u32 *Index)
+{
+	DiskCache *C = &Cache[pdrv];
+	u32 Base = (u32)(sector % (DWORD)FILE_SYSTEM_CACHE_SETS) *
+			(u32)FILE_SYSTEM_CACHE_WAYS;
+	u32 Victim = Base;
+	u32 Way;
+	DRESULT res;
+
+	for (Way = 0U; Way < (u32)FILE_SYSTEM_CACHE_WAYS; Way++) {
+		if (C->Line[Base + Way].Valid == 0U) {
+			Victim = Base + Way;
+			break;
+		}
+		if (C->Line[Base + Way].LastUse < C->Line[Victim].LastUse) {
+			Victim = Base + Way;
+		}
+	}
+
+	if ((C->Line[Victim].Valid != 0U) && (C->Line[Victim].Dirty != 0U)) {
+		res = cache_write_back(pdrv, Victim);
+		if (res != RES_OK) {
+			return res;
+		}
+	}
+
+	C->Line[Victim].Sector = sector;
+	C->Line[Victim].Valid = 1U;
+	C->Line[Victim].Dirty = 0U;
+	cache_touch(pdrv, Victim);
+	*Index = Victim;
+
+	return RES_OK;
+}
+
+/*****************************************************************************/
+/**
 *
-* </pre>
+* Reads through the cache. A miss reads the sector and, if the read follows
+* the previous one, the next FILE_SYSTEM_READ_AHEAD sectors that are not
+* cached yet.
 *
-* @note
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data buffer to store read data
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return	RES_OK or the error of the medium
 *
 ******************************************************************************/
-#include "diskio.h"
-#include "ff.h"
-#include "xil_types.h"
+static DRESULT cache_read (BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
+{
+	DiskCache *C = &Cache[pdrv];
+	DWORD Total = cache_medium_sectors(pdrv);
+	DWORD Sector;
+	UINT Num;
+	UINT Fill;
+	u32 Index;
+	DRESULT res;
+
+	if (count >= (UINT)DISK_CACHE_BYPASS) {
+		/* The medium must hold the dirty sectors read around the cache */
+		for (Num = 0U; Num < count; Num++) {
+			Index = cache_find(pdrv, sector + Num);
+			if ((Index != CACHE_NONE) && (C->Line[Index].Dirty != 0U)) {
+				res = cache_write_back(pdrv, Index);
+				if (res != RES_OK) {
+					return res;
+				}
+			}
+		}
+		C->NextSector = sector + count;
+		return disk_read_dev(pdrv, buff, sector, count);
+	}
 
-#ifdef FILE_SYSTEM_INTERFACE_SD
-#include "xsdps.h"		/* SD device driver */
-#endif
-#include "sleep.h"
-#include "xil_printf.h"
+	for (Num = 0U; Num < count; Num++) {
+		Sector = sector + Num;
+		Index = cache_find(pdrv, Sector);
+		if (Index != CACHE_NONE) {
+			Stats[pdrv].CacheHits++;
+		} else {
+			Stats[pdrv].CacheMisses++;
+
+			Fill = 1U;
+			if ((Num > 0U) || (Sector == C->NextSector)) {
+				while ((Fill < (UINT)CACHE_FILL_SECTORS) &&
+						((Total == 0U) || ((Sector + Fill) < Total)) &&
+						(cache_find(pdrv, Sector + Fill) == CACHE_NONE)) {
+					Fill++;
+				}
+			}
 
-#define SD_CD_DELAY		10000U
-#define XSDPS_NUM_INSTANCES	2
+			res = disk_read_dev(pdrv, CacheFill[pdrv][0], Sector, Fill);
+			if (res != RES_OK) {
+				return res;
+			}
+			Stats[pdrv].NumPrefetched += Fill - 1U;
+
+			/* The requested sector last, so that it is the most recent */
+			do {
+				Fill--;
+				res = cache_alloc(pdrv, Sector + Fill, &Index);
+				if (res != RES_OK) {
+					return res;
+				}
+				(void)memcpy(CacheData[pdrv][Index], CacheFill[pdrv][Fill],
+						CACHE_SECTOR_SIZE);
+			} while (Fill > 0U);
+		}
 
-#ifdef FILE_SYSTEM_INTERFACE_RAM
-#include "xparameters.h"
+		(void)memcpy(&buff[Num * CACHE_SECTOR_SIZE], CacheData[pdrv][Index],
+				CACHE_SECTOR_SIZE);
+		cache_touch(pdrv, Index);
+	}
+	C->NextSector = sector + count;
 
-static char *dataramfs = NULL;
+	return RES_OK;
+}
 
-#define BLOCKSIZE       1U
-#define SECTORSIZE      512U
-#define SECTORCNT       (RAMFS_SIZE / SECTORSIZE)
-#endif
+/*****************************************************************************/
+/**
+*
+* Writes into the cache. The sectors are written back to the medium when
+* they are replaced or on CTRL_SYNC.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data to be written
+* @param	sector - Sector address
+* @param	count - Sector count
+*
+* @return	RES_OK or the error of the medium
+*
+******************************************************************************/
+static DRESULT cache_write (BYTE pdrv, const BYTE *buff, DWORD sector,
+		UINT count)
+{
+	DiskCache *C = &Cache[pdrv];
+	UINT Num;
+	u32 Index;
+	DRESULT res;
+
+	if (count >= (UINT)DISK_CACHE_BYPASS) {
+		/* The cached copies are overwritten on the medium */
+		for (Num = 0U; Num < count; Num++) {
+			Index = cache_find(pdrv, sector + Num);
+			if (Index != CACHE_NONE) {
+				C->Line[Index].Valid = 0U;
+				C->Line[Index].Dirty = 0U;
+			}
+		}
+		return disk_write_dev(pdrv, buff, sector, count);
+	}
 
-/*--------------------------------------------------------------------------
+	for (Num = 0U; Num < count; Num++) {
+		Index = cache_find(pdrv, sector + Num);
+		if (Index == CACHE_NONE) {
+			res = cache_alloc(pdrv, sector + Num, &Index);
+			if (res != RES_OK) {
+				return res;
+			}
+		}
+		(void)memcpy(CacheData[pdrv][Index], &buff[Num * CACHE_SECTOR_SIZE],
+				CACHE_SECTOR_SIZE);
+		C->Line[Index].Dirty = 1U;
+		cache_touch(pdrv, Index);
+	}
 
-	Public Functions
+	return RES_OK;
+}
 
----------------------------------------------------------------------------*/
+/*****************************************************************************/
+/**
+*
+* Writes back all the dirty lines of a drive.
+*
+* @param	pdrv - Drive number
+*
+* @return	RES_OK or the error of the medium
+*
+******************************************************************************/
+static DRESULT cache_flush (BYTE pdrv)
+{
+	DiskCache *C = &Cache[pdrv];
+	u32 Index;
+	DRESULT res;
+
+	for (Index = 0U; Index < (u32)CACHE_NUM_LINES; Index++) {
+		if ((C->Line[Index].Valid != 0U) && (C->Line[Index].Dirty != 0U)) {
+			res = cache_write_back(pdrv, Index);
+			if (res != RES_OK) {
+				return res;
+			}
+		}
+	}
 
-/*
- * Global variables
- */
-static DSTATUS Stat[XSDPS_NUM_INSTANCES] = {STA_NOINIT, STA_NOINIT};	/* Disk status */
+	return RES_OK;
+}
 
 #ifdef FILE_SYSTEM_INTERFACE_SD
-static XSdPs SdInstance[XSDPS_NUM_INSTANCES];
-static u32 BaseAddress[XSDPS_NUM_INSTANCES];
-static u32 CardDetect[XSDPS_NUM_INSTANCES];
-static u32 WriteProtect[XSDPS_NUM_INSTANCES];
-static u32 SlotType[XSDPS_NUM_INSTANCES];
-static u8 HostCntrlrVer[XSDPS_NUM_INSTANCES];
+/*****************************************************************************/
+/**
+*
+* Drops the lines of the sectors start to end, dirty or not.
+*
+* @param	pdrv - Drive number
+* @param	start - First sector
+* @param	end - Last sector
+*
+* @return	None
+*
+******************************************************************************/
+static void cache_trim (BYTE pdrv, DWORD start, DWORD end)
+{
+	DiskCache *C = &Cache[pdrv];
+	u32 Index;
+
+	for (Index = 0U; Index < (u32)CACHE_NUM_LINES; Index++) {
+		if ((C->Line[Index].Sector >= start) &&
+				(C->Line[Index].Sector <= end)) {
+			C->Line[Index].Valid = 0U;
+			C->Line[Index].Dirty = 0U;
+		}
+	}
+}
+#endif
+#endif
+
+#ifdef FILE_SYSTEM_INTERFACE_SD
+/*****************************************************************************/
+/**
+*
+* Interrupt handler of an SD controller. Connect it to the interrupt of the
+* controller with the drive number as the callback reference to complete
+* queued writes in the background. Without it the queue only progresses
+* when the file system calls the disk functions.
+*
+* @param	CallBackRef - Drive number
+*
+* @return	None
+*
+******************************************************************************/
+void disk_sd_intr_handler (void *CallBackRef)
+{
+	BYTE pdrv = (BYTE)(UINTPTR)CallBackRef;
+
+#ifdef FILE_SYSTEM_SD_ASYNC_IO
+	if (AsyncQ[pdrv].Locked != 0U) {
+		/* Mask the interrupt, the task completes the transfer */
+		XSdPs_WriteReg16(SdInstance[pdrv].Config.BaseAddress,
+				XSDPS_NORM_INTR_SIG_EN_OFFSET, 0x0U);
+		XSdPs_WriteReg16(SdInstance[pdrv].Config.BaseAddress,
+				XSDPS_ERR_INTR_SIG_EN_OFFSET, 0x0U);
+		AsyncQ[pdrv].Deferred = 1U;
+		return;
+	}
+#endif
+
+	XSdPs_IntrHandler(&SdInstance[pdrv]);
+}
 #endif
 
 /*-----------------------------------------------------------------------*/
@@ -290,6 +1237,13 @@ DSTATUS disk_initialize (
 		return s;
 	}
 
+#ifdef FILE_SYSTEM_SD_ASYNC_IO
+	sd_async_init(pdrv);
+#endif
+#ifdef DISK_CACHE
+	(void)memset(&Cache[pdrv], 0, sizeof(DiskCache));
+#endif
+
 
 	/*
 	 * Disk is initialized.
@@ -302,7 +1256,15 @@ DSTATUS disk_initialize (
 
 #ifdef FILE_SYSTEM_INTERFACE_RAM
 	/* Assign RAMFS address value from xparameters.h */
+#ifdef RAMFS_START_ADDR
 	dataramfs = (char *)RAMFS_START_ADDR;
+#else
+	dataramfs = RamFs;
+#endif
+
+#ifdef DISK_CACHE
+	(void)memset(&Cache[pdrv], 0, sizeof(DiskCache));
+#endif
 
 	/* Clearing No init Status for RAM */
 	s &= (~STA_NOINIT);
@@ -319,7 +1281,7 @@ DSTATUS disk_initialize (
 /*****************************************************************************/
 /**
 *
-* Reads the drive
+* Reads the medium, bypassing the sector cache.
 * In case of SD, it reads the SD card using ADMA2 in polled mode.
 *
 * @param	pdrv - Drive number
@@ -329,33 +1291,16 @@ DSTATUS disk_initialize (
 *
 * @return
 *		RES_OK		Read successful
-*		STA_NOINIT	Drive not initialized
 *		RES_ERROR	Read not successful
 *
-* @note
-*
 ******************************************************************************/
-DRESULT disk_read (
-		BYTE pdrv,	/* Physical drive number (0) */
-		BYTE *buff,	/* Pointer to the data buffer to store read data */
-		DWORD sector,	/* Start sector number (LBA) */
-		UINT count	/* Sector count (1..128) */
-)
+static DRESULT disk_read_dev (BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
 {
-	DSTATUS s;
 #ifdef FILE_SYSTEM_INTERFACE_SD
 	s32 Status = XST_FAILURE;
 	DWORD LocSector = sector;
 #endif
-
-	s = disk_status(pdrv);
-
-	if ((s & STA_NOINIT) != 0U) {
-		return RES_NOTRDY;
-	}
-	if (count == 0U) {
-		return RES_PARERR;
-	}
+	u64 Start;
 
 #ifdef FILE_SYSTEM_INTERFACE_SD
 	/* Convert LBA to byte address if needed */
@@ -363,24 +1308,87 @@ DRESULT disk_read (
 		LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
 	}
 
+#ifdef FILE_SYSTEM_SD_ASYNC_IO
+	sd_async_hold(pdrv, sector, count);
+#endif
+	Start = disk_ticks();
 	Status  = XSdPs_ReadPolled(&SdInstance[pdrv], (u32)LocSector, count, buff);
+	Stats[pdrv].ReadTicks += disk_ticks() - Start;
+#ifdef FILE_SYSTEM_SD_ASYNC_IO
+	sd_async_release(pdrv);
+#endif
 	if (Status != XST_SUCCESS) {
 		return RES_ERROR;
 	}
+	Stats[pdrv].ReadBytes += (u64)count * XSDPS_BLK_SIZE_512_MASK;
+	Stats[pdrv].NumReads++;
 #endif
 
 #ifdef FILE_SYSTEM_INTERFACE_RAM
+	Start = disk_ticks();
 	memcpy(buff, dataramfs + (sector * SECTORSIZE), count * SECTORSIZE);
+	Stats[pdrv].ReadTicks += disk_ticks() - Start;
+	Stats[pdrv].ReadBytes += (u64)count * SECTORSIZE;
+	Stats[pdrv].NumReads++;
 #endif
 
 #if !defined(FILE_SYSTEM_INTERFACE_SD) && !defined(FILE_SYSTEM_INTERFACE_RAM)
+	(void)pdrv;
 	(void)buff;
 	(void)sector;
+	(void)count;
+	(void)Start;
 #endif
 
     return RES_OK;
 }
 
+/*****************************************************************************/
+/**
+*
+* Reads the drive
+* In case of SD, it reads the SD card using ADMA2 in polled mode.
+* Requests shorter than DISK_CACHE_BYPASS sectors go through the sector
+* cache when "cache_ways" is set.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data buffer to store read data
+* @param	sector - Start sector number
+* @param	count - Sector count
+*
+* @return
+*		RES_OK		Read successful
+*		STA_NOINIT	Drive not initialized
+*		RES_ERROR	Read not successful
+*
+* @note
+*
+******************************************************************************/
+DRESULT disk_read (
+		BYTE pdrv,	/* Physical drive number (0) */
+		BYTE *buff,	/* Pointer to the data buffer to store read data */
+		DWORD sector,	/* Start sector number (LBA) */
+		UINT count	/* Sector count (1..128) */
+)
+{
+	DSTATUS s;
+
+	s = disk_status(pdrv);
+
+	if ((s & STA_NOINIT) != 0U) {
+		return RES_NOTRDY;
+	}
+	if (count == 0U) {
+		return RES_PARERR;
+	}
+
+#ifdef DISK_CACHE
+	return cache_read(pdrv, buff, sector, count);
+#else
+	return disk_read_dev(pdrv, buff, sector, count);
+#endif
+}
+
 /*-----------------------------------------------------------------------*/
 /* Miscellaneous Functions						*/
 /*-----------------------------------------------------------------------*/
@@ -402,7 +1410,18 @@ DRESULT disk_ioctl (
 
 	switch (cmd) {
 		case (BYTE)CTRL_SYNC :	/* Make sure that no pending write process */
+#ifdef DISK_CACHE
+			res = cache_flush(pdrv);
+			if (res != RES_OK) {
+				break;
+			}
+#endif
+#ifdef FILE_SYSTEM_SD_ASYNC_IO
+			sd_async_wait(pdrv, 0U);
+			res = sd_async_error(pdrv);
+#else
 			res = RES_OK;
+#endif
 			break;
 
 		case (BYTE)GET_SECTOR_COUNT : /* Get number of sectors on the disk (DWORD) */
@@ -416,11 +1435,21 @@ DRESULT disk_ioctl (
 			break;
 
 		case (BYTE)CTRL_TRIM :	/* Erase the data */
+#ifdef DISK_CACHE
+			cache_trim(pdrv, SendBuff[0], SendBuff[1]);
+#endif
+#ifdef FILE_SYSTEM_SD_ASYNC_IO
+			sd_async_hold(pdrv, SendBuff[0],
+					(UINT)(SendBuff[1] - SendBuff[0] + 1U));
+#endif
 			if ((SdInstance[pdrv].HCS) == 0U) {
 				SendBuff[0] *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
 				SendBuff[1] *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
 			}
 			(void)XSdPs_Erase(&SdInstance[pdrv], SendBuff[0], SendBuff[1]);
+#ifdef FILE_SYSTEM_SD_ASYNC_IO
+			sd_async_release(pdrv);
+#endif
 			res = RES_OK;
 			break;
 
@@ -433,7 +1462,11 @@ DRESULT disk_ioctl (
 #ifdef FILE_SYSTEM_INTERFACE_RAM
 	switch (cmd) {
 	case (BYTE)CTRL_SYNC:
+#ifdef DISK_CACHE
+		res = cache_flush(pdrv);
+#else
 		res = RES_OK;
+#endif
 		break;
 	case (BYTE)GET_BLOCK_SIZE:
 		*(WORD *)buff = BLOCKSIZE;
@@ -488,8 +1521,9 @@ DWORD get_fattime (void)
 /*****************************************************************************/
 /**
 *
-* Reads the drive
-* In case of SD, it reads the SD card using ADMA2 in polled mode.
+* Writes the medium, bypassing the sector cache.
+* In case of SD, it writes the SD card using ADMA2 in polled mode, or
+* queues the write when "sd_async_io" is set.
 *
 * @param	pdrv - Drive number
 * @param	*buff - Pointer to the data to be written
@@ -497,55 +1531,102 @@ DWORD get_fattime (void)
 * @param	count - Sector count
 *
 * @return
-*		RES_OK		Read successful
-*		STA_NOINIT	Drive not initialized
-*		RES_ERROR	Read not successful
-*
-* @note
+*		RES_OK		Write successful
+*		RES_ERROR	Write not successful
 *
 ******************************************************************************/
-DRESULT disk_write (
-	BYTE pdrv,			/* Physical drive nmuber (0..) */
-	const BYTE *buff,	/* Data to be written */
-	DWORD sector,		/* Sector address (LBA) */
-	UINT count			/* Number of sectors to write (1..128) */
-)
+static DRESULT disk_write_dev (BYTE pdrv, const BYTE *buff, DWORD sector,
+		UINT count)
 {
-	DSTATUS s;
-#ifdef FILE_SYSTEM_INTERFACE_SD
+#if defined (FILE_SYSTEM_INTERFACE_SD) && !defined (FILE_SYSTEM_SD_ASYNC_IO)
 	s32 Status = XST_FAILURE;
 	DWORD LocSector = sector;
 #endif
-
-	s = disk_status(pdrv);
-	if ((s & STA_NOINIT) != 0U) {
-		return RES_NOTRDY;
-	}
-	if (count == 0U) {
-		return RES_PARERR;
-	}
+#if !defined (FILE_SYSTEM_SD_ASYNC_IO)
+	u64 Start;
+#endif
 
 #ifdef FILE_SYSTEM_INTERFACE_SD
+#ifdef FILE_SYSTEM_SD_ASYNC_IO
+	return sd_async_write(pdrv, buff, sector, count);
+#else
 	/* Convert LBA to byte address if needed */
 	if ((SdInstance[pdrv].HCS) == 0U) {
 		LocSector *= (DWORD)XSDPS_BLK_SIZE_512_MASK;
 	}
 
+	Start = disk_ticks();
 	Status  = XSdPs_WritePolled(&SdInstance[pdrv], (u32)LocSector, count, buff);
 	if (Status != XST_SUCCESS) {
 		return RES_ERROR;
 	}
-
+	Stats[pdrv].WriteTicks += disk_ticks() - Start;
+	Stats[pdrv].WriteBytes += (u64)count * XSDPS_BLK_SIZE_512_MASK;
+	Stats[pdrv].NumWrites++;
+#endif
 #endif
 
 #ifdef FILE_SYSTEM_INTERFACE_RAM
+	Start = disk_ticks();
 	memcpy(dataramfs + (sector * SECTORSIZE), buff, count * SECTORSIZE);
+	Stats[pdrv].WriteTicks += disk_ticks() - Start;
+	Stats[pdrv].WriteBytes += (u64)count * SECTORSIZE;
+	Stats[pdrv].NumWrites++;
 #endif
 
 #if !defined(FILE_SYSTEM_INTERFACE_SD) && !defined(FILE_SYSTEM_INTERFACE_RAM)
+	(void)pdrv;
 	(void)buff;
 	(void)sector;
+	(void)count;
+	(void)Start;
 #endif
 
 	return RES_OK;
 }
+
+/*****************************************************************************/
+/**
+*
+* Writes the drive
+* In case of SD, it writes the SD card using ADMA2 in polled mode, or
+* queues the write when "sd_async_io" is set. Requests shorter than
+* DISK_CACHE_BYPASS sectors are written back from the sector cache when
+* "cache_ways" is set.
+*
+* @param	pdrv - Drive number
+* @param	*buff - Pointer to the data to be written
+* @param	sector - Sector address
+* @param	count - Sector count
+*
+* @return
+*		RES_OK		Write successful
+*		STA_NOINIT	Drive not initialized
+*		RES_ERROR	Write not successful
+*
+* @note
+*
+******************************************************************************/
+DRESULT disk_write (
+	BYTE pdrv,			/* Physical drive nmuber (0..) */
+	const BYTE *buff,	/* Data to be written */
+	DWORD sector,		/* Sector address (LBA) */
+	UINT count			/* Number of sectors to write (1..128) */
+)
+{
+	DSTATUS s;
+
+	s = disk_status(pdrv);
+	if ((s & STA_NOINIT) != 0U) {
+		return RES_NOTRDY;
+	}
+	if (count == 0U) {
+		return RES_PARERR;
+	}
+
+#ifdef DISK_CACHE
+	return cache_write(pdrv, buff, sector, count);
+#else
+	return disk_write_dev(pdrv, buff, sector, count);
+#endif
+}
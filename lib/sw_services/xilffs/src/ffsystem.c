@@ -39,6 +39,24 @@ void ff_memfree (
 
 #if FF_FS_REENTRANT	/* Mutal exclusion */
 
+/* One FreeRTOS mutex per physical drive. The volumes are locked independently
+/  unless they are partitions of the same drive, these share the mutex of the
+/  drive since they share its state in diskio.c.
+*/
+
+#if FF_MULTI_PARTITION
+#define SYNC_DRV(vol)	(VolToPart[vol].pd)
+#else
+#define SYNC_DRV(vol)	(vol)
+#endif
+
+static SemaphoreHandle_t DrvMutex[FF_VOLUMES];	/* Mutex of each drive */
+static UINT DrvRefs[FF_VOLUMES];		/* Volumes using the mutex */
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+static StaticSemaphore_t DrvMutexBuf[FF_VOLUMES];
+#endif
+
+
 /*------------------------------------------------------------------------*/
 /* Create a Synchronization Object                                        */
 /*------------------------------------------------------------------------*/
@@ -47,35 +65,28 @@ void ff_memfree (
 /  When a 0 is returned, the f_mount() function fails with FR_INT_ERR.
 */
 
-//const osMutexDef_t Mutex[FF_VOLUMES];	/* CMSIS-RTOS */
-
-
 int ff_cre_syncobj (	/* 1:Function succeeded, 0:Could not create the sync object */
 	BYTE vol,			/* Corresponding volume (logical drive number) */
 	FF_SYNC_t* sobj		/* Pointer to return the created sync object */
 )
 {
-	/* Win32 */
-	*sobj = CreateMutex(NULL, FALSE, NULL);
-	return (int)(*sobj != INVALID_HANDLE_VALUE);
-
-	/* uITRON */
-//	T_CSEM csem = {TA_TPRI,1,1};
-//	*sobj = acre_sem(&csem);
-//	return (int)(*sobj > 0);
-
-	/* uC/OS-II */
-//	OS_ERR err;
-//	*sobj = OSMutexCreate(0, &err);
-//	return (int)(err == OS_NO_ERR);
-
-	/* FreeRTOS */
-//	*sobj = xSemaphoreCreateMutex();
-//	return (int)(*sobj != NULL);
-
-	/* CMSIS-RTOS */
-//	*sobj = osMutexCreate(Mutex + vol);
-//	return (int)(*sobj != NULL);
+	BYTE drv = SYNC_DRV(vol);
+
+	if (drv >= FF_VOLUMES) return 0;
+
+	/* f_mount() is not re-entrant, no lock is needed here */
+	if (DrvRefs[drv] == 0U) {
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+		DrvMutex[drv] = xSemaphoreCreateMutexStatic(&DrvMutexBuf[drv]);
+#else
+		DrvMutex[drv] = xSemaphoreCreateMutex();
+#endif
+		if (DrvMutex[drv] == NULL) return 0;
+	}
+	DrvRefs[drv]++;
+	*sobj = DrvMutex[drv];
+
+	return 1;
 }
 
 
@@ -91,23 +102,20 @@ int ff_del_syncobj (	/* 1:Function succeeded, 0:Could not delete due to an error
 	FF_SYNC_t sobj		/* Sync object tied to the logical drive to be deleted */
 )
 {
-	/* Win32 */
-	return (int)CloseHandle(sobj);
-
-	/* uITRON */
-//	return (int)(del_sem(sobj) == E_OK);
-
-	/* uC/OS-II */
-//	OS_ERR err;
-//	OSMutexDel(sobj, OS_DEL_ALWAYS, &err);
-//	return (int)(err == OS_NO_ERR);
-
-	/* FreeRTOS */
-//  vSemaphoreDelete(sobj);
-//	return 1;
-
-	/* CMSIS-RTOS */
-//	return (int)(osMutexDelete(sobj) == osOK);
+	BYTE drv;
+
+	for (drv = 0U; drv < FF_VOLUMES; drv++) {
+		if (DrvRefs[drv] != 0U && DrvMutex[drv] == sobj) {
+			DrvRefs[drv]--;
+			if (DrvRefs[drv] == 0U) {
+				vSemaphoreDelete(sobj);
+				DrvMutex[drv] = NULL;
+			}
+			return 1;
+		}
+	}
+
+	return 0;
 }
 
 
@@ -122,22 +130,7 @@ int ff_req_grant (	/* 1:Got a grant to access the volume, 0:Could not get a gran
 	FF_SYNC_t sobj	/* Sync object to wait */
 )
 {
-	/* Win32 */
-	return (int)(WaitForSingleObject(sobj, FF_FS_TIMEOUT) == WAIT_OBJECT_0);
-
-	/* uITRON */
-//	return (int)(wai_sem(sobj) == E_OK);
-
-	/* uC/OS-II */
-//	OS_ERR err;
-//	OSMutexPend(sobj, FF_FS_TIMEOUT, &err));
-//	return (int)(err == OS_NO_ERR);
-
-	/* FreeRTOS */
-//	return (int)(xSemaphoreTake(sobj, FF_FS_TIMEOUT) == pdTRUE);
-
-	/* CMSIS-RTOS */
-//	return (int)(osMutexWait(sobj, FF_FS_TIMEOUT) == osOK);
+	return (int)(xSemaphoreTake(sobj, FF_FS_TIMEOUT) == pdTRUE);
 }
 
 
@@ -151,21 +144,7 @@ void ff_rel_grant (
 	FF_SYNC_t sobj	/* Sync object to be signaled */
 )
 {
-	/* Win32 */
-	ReleaseMutex(sobj);
-
-	/* uITRON */
-//	sig_sem(sobj);
-
-	/* uC/OS-II */
-//	OSMutexPost(sobj);
-
-	/* FreeRTOS */
-//	xSemaphoreGive(sobj);
-
-	/* CMSIS-RTOS */
-//	osMutexRelease(sobj);
+	(void)xSemaphoreGive(sobj);
 }
 
 #endif
-
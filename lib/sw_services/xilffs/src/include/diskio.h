@@ -28,6 +28,24 @@ typedef enum {
 } DRESULT;
 
 
+/* Transfer counters of a drive */
+typedef struct {
+	u64 ReadBytes;		/* Bytes read from the medium */
+	u64 WriteBytes;		/* Bytes written to the medium */
+	u64 ReadTicks;		/* Time spent reading */
+	u64 WriteTicks;		/* Time the writes were on the bus */
+	u32 TicksPerSec;	/* Tick frequency, 0 if time is not counted */
+	u32 NumReads;		/* Read commands */
+	u32 NumWrites;		/* Write commands */
+	u32 NumMerged;		/* Writes appended to a queued write */
+	u32 NumStalls;		/* Writes that waited for a free request */
+	u32 CacheHits;		/* Sectors read from the sector cache */
+	u32 CacheMisses;	/* Sectors the sector cache read from the medium */
+	u32 NumPrefetched;	/* Sectors read ahead on misses */
+	u32 NumWriteBacks;	/* Write backs of dirty sectors */
+} DISK_STATS;
+
+
 /*---------------------------------------*/
 /* Prototypes for disk control functions */
 
@@ -36,6 +54,9 @@ DSTATUS disk_status (BYTE pdrv);
 DRESULT disk_read (BYTE pdrv, BYTE* buff, DWORD sector, UINT count);
 DRESULT disk_write (BYTE pdrv, const BYTE* buff, DWORD sector, UINT count);
 DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff);
+void disk_get_stats (BYTE pdrv, DISK_STATS* stats);
+void disk_reset_stats (BYTE pdrv);
+void disk_sd_intr_handler (void* CallBackRef);
 
 
 /* Disk Status Bits (DSTATUS) */
@@ -22,14 +22,14 @@
 #ifndef FF_DEFINED
 #define FF_DEFINED	63463	/* Revision ID */
 
-#ifdef __cplusplus
-extern "C" {
-#endif
-
 #include "xil_types.h"
 #include "integer.h"	/* Basic integer types */
 #include "ffconf.h"		/* FatFs configuration options */
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #if FF_DEFINED != FFCONF_DEF
 #error Wrong configuration file (ffconf.h).
 #endif
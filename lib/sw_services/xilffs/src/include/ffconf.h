@@ -5,12 +5,16 @@
 
 #define FFCONF_DEF 63463	/* Revision ID */
 
+#include "xparameters.h"
+#ifdef FILE_SYSTEM_FS_REENTRANT
+#include "FreeRTOS.h"
+#include "semphr.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-#include "xparameters.h"
-
 /*---------------------------------------------------------------------------/
 / Function Configurations
 /---------------------------------------------------------------------------*/
@@ -62,7 +66,11 @@ extern "C" {
 /* This option switches f_mkfs() function. (0:Disable or 1:Enable) */
 
 
-#define FF_USE_FASTSEEK	0
+#ifdef FILE_SYSTEM_USE_FASTSEEK
+#define FF_USE_FASTSEEK	1	/* 1:Enable */
+#else
+#define FF_USE_FASTSEEK	0	/* 0:Disable */
+#endif
 /* This option switches fast seek function. (0:Disable or 1:Enable) */
 
 
@@ -328,9 +336,18 @@ extern "C" {
 /      lock control is independent of re-entrancy. */
 
 
-#define FF_FS_REENTRANT	0
+#ifdef FILE_SYSTEM_FS_REENTRANT
+#ifndef FILE_SYSTEM_FS_TIMEOUT
+#define FILE_SYSTEM_FS_TIMEOUT	1000	/* Milliseconds */
+#endif
+#define FF_FS_REENTRANT	1	/* 1:Enable, one FreeRTOS mutex per volume */
+#define FF_FS_TIMEOUT	pdMS_TO_TICKS(FILE_SYSTEM_FS_TIMEOUT)
+#define FF_SYNC_t		SemaphoreHandle_t
+#else
+#define FF_FS_REENTRANT	0	/* 0:Disable */
 #define FF_FS_TIMEOUT	1000
 #define FF_SYNC_t		HANDLE
+#endif
 /* The option FF_FS_REENTRANT switches the re-entrancy (thread safe) of the FatFs
 /  module itself. Note that regardless of this option, file access to different
 /  volume is always re-entrant and volume control functions, f_mount(), f_mkfs()
@@ -44,6 +44,7 @@
 *       har  02/17/22 Added macro XLOADER_AUTH_JTAG_LOCK_DIS_MASK and removed
 *                     macro XLOADER_AUTH_FAIL_COUNTER_RST_VALUE
 *       bsv  03/18/22 Fix build issues when PLM_SECURE_EXCLUDE is enabled
+* 1.03  jb   10/18/26 Added FetchTime in XLoader_SecureParams
 *
 * </pre>
 *
@@ -460,6 +461,9 @@ typedef struct XLoader_SecureParams {
 				u32 BlockSize, u8 Last); /**< Function pointer to process
 				                          * partition chunk */
 	u16 DmaFlags;    /**< Flags indicate mode of copying */
+#ifdef PLM_PRINT_PERF_CDO_PROCESS
+	u64 FetchTime;	/**< Time spent waiting for chunk copies */
+#endif
 #ifndef PLM_SECURE_EXCLUDE
 	XLoader_AuthType SigType;	/**< Signature type */
 	XLoader_AuthCertificate *AcPtr;/**< Authentication certificate pointer */
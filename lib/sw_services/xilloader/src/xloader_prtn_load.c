@@ -85,6 +85,9 @@
 *       bsv  03/17/2022 Add support for A72 elfs to run from TCM
 *       bsv  03/23/2022 Minor change in loading of A72 elfs to TCM
 *       bsv  03/29/2022 Dump Ddrmc registers only when PLM DEBUG MODE is enabled
+* 1.09  jb   10/18/2026 Overlap the second chunk copy of secure CDOs with the
+*                       first chunk execution, and added fetch and secure
+*                       stage times in XLoader_ProcessCdo
 *
 * </pre>
 *
@@ -151,6 +154,9 @@ static int XLoader_ProcessElf(XilPdi* PdiPtr, const XilPdi_PrtnHdr* PrtnHdr,
 static int XLoader_DumpDdrmcRegisters(void);
 #endif
 static int XLoader_RequestTCM(u8 TcmId);
+#ifdef PLM_PRINT_PERF_CDO_PROCESS
+static void XLoader_PrintCdoStageTime(u64 StageTime, const char *Stage);
+#endif
 
 /************************** Variable Definitions *****************************/
 
@@ -653,7 +659,9 @@ static int XLoader_ProcessCdo(const XilPdi* PdiPtr, XLoader_DeviceCopy* DeviceCo
 	u64 CdoProcessTimeStart;
 	u64 CdoProcessTimeEnd;
 	u64 CdoProcessTime = 0U;
-	XPlmi_PerfTime PerfTime;
+	u64 CdoFetchTime = 0U;
+	u64 CdoSecureTime = 0U;
+	u64 SecureFetchTime;
 #endif
 
 	XPlmi_Printf(DEBUG_INFO, "Processing CDO partition \n\r");
@@ -698,8 +706,14 @@ static int XLoader_ProcessCdo(const XilPdi* PdiPtr, XLoader_DeviceCopy* DeviceCo
 			else {
 				Flags = XPLMI_DEVICE_COPY_STATE_BLK;
 			}
+#ifdef PLM_PRINT_PERF_CDO_PROCESS
+			CdoProcessTimeStart = XPlmi_GetTimerValue();
+#endif
 			Status = PdiPtr->MetaHdr.DeviceCopy(DeviceCopy->SrcAddr,
 				ChunkAddr, ChunkLen, (DeviceCopy->Flags | Flags));
+#ifdef PLM_PRINT_PERF_CDO_PROCESS
+			CdoFetchTime += (CdoProcessTimeStart - XPlmi_GetTimerValue());
+#endif
 			if (Status != XST_SUCCESS) {
 					goto END;
 			}
@@ -741,9 +755,29 @@ static int XLoader_ProcessCdo(const XilPdi* PdiPtr, XLoader_DeviceCopy* DeviceCo
 		}
 		else {
 			SecureParams->RemainingDataLen = DeviceCopy->Len;
+#ifdef PLM_PRINT_PERF_CDO_PROCESS
+			CdoProcessTimeStart = XPlmi_GetTimerValue();
+			SecureFetchTime = SecureParams->FetchTime;
+#endif
 
 			Status = SecureParams->ProcessPrtn(SecureParams,
 					SecureParams->SecureData, ChunkLen, LastChunk);
+#ifdef PLM_PRINT_PERF_CDO_PROCESS
+			SecureFetchTime = SecureParams->FetchTime - SecureFetchTime;
+			CdoFetchTime += SecureFetchTime;
+			CdoSecureTime += (CdoProcessTimeStart - XPlmi_GetTimerValue()) -
+				SecureFetchTime;
+#endif
+			if (Status != XST_SUCCESS) {
+				goto END;
+			}
+
+			/*
+			 * Copy of the second chunk is started only now, so
+			 * that it overlaps the execution of the first chunk
+			 */
+			Status = XLoader_SecureStartDeferredCopy(SecureParams,
+					ChunkLen);
 			if (Status != XST_SUCCESS) {
 				goto END;
 			}
@@ -823,15 +857,35 @@ static int XLoader_ProcessCdo(const XilPdi* PdiPtr, XLoader_DeviceCopy* DeviceCo
 
 END:
 #ifdef PLM_PRINT_PERF_CDO_PROCESS
-	XPlmi_MeasurePerfTime((XPlmi_GetTimerValue() + CdoProcessTime),
-				&PerfTime);
-	XPlmi_Printf(DEBUG_PRINT_PERF,
-			"%u.%03u ms Cdo Processing time\n\r",
-			(u32)PerfTime.TPerfMs, (u32)PerfTime.TPerfMsFrac);
+	XLoader_PrintCdoStageTime(CdoFetchTime, "Fetch wait");
+	XLoader_PrintCdoStageTime(CdoSecureTime, "Secure");
+	XLoader_PrintCdoStageTime(CdoProcessTime, "Processing");
 #endif
 	return Status;
 }
 
+#ifdef PLM_PRINT_PERF_CDO_PROCESS
+/****************************************************************************/
+/**
+ * @brief	This function prints the time spent in one stage of CDO
+ * partition processing.
+ *
+ * @param	StageTime is the accumulated timer ticks of the stage
+ * @param	Stage is the name of the stage
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XLoader_PrintCdoStageTime(u64 StageTime, const char *Stage)
+{
+	XPlmi_PerfTime PerfTime;
+
+	XPlmi_MeasurePerfTime((XPlmi_GetTimerValue() + StageTime), &PerfTime);
+	XPlmi_Printf(DEBUG_PRINT_PERF, "%u.%03u ms Cdo %s time\n\r",
+			(u32)PerfTime.TPerfMs, (u32)PerfTime.TPerfMsFrac, Stage);
+}
+#endif
+
 /****************************************************************************/
 /**
  * @brief	This function is used to process the partition.
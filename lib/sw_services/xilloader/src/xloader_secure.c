@@ -112,6 +112,8 @@
 *       bsv  02/10/22 Code clean up by removing unwanted initializations
 *       bsv  02/14/22 Added comments for better readability
 *       kpt  02/18/22 Fixed copy to memory issue
+* 1.09  jb   10/18/26 Start the copy of the second chunk once the first chunk
+*                     is processed, and measure the chunk copy wait time
 *
 * </pre>
 *
@@ -658,6 +660,9 @@ int XLoader_SecureChunkCopy(XLoader_SecureParams *SecurePtr, u64 SrcAddr,
 {
 	int Status = XST_FAILURE;
 	u8 Flags = XPLMI_DEVICE_COPY_STATE_BLK;
+#ifdef PLM_PRINT_PERF_CDO_PROCESS
+	u64 FetchTimeStart = XPlmi_GetTimerValue();
+#endif
 
 	if (SecurePtr->IsNextChunkCopyStarted == (u8)TRUE) {
 		SecurePtr->IsNextChunkCopyStarted = (u8)FALSE;
@@ -667,6 +672,9 @@ int XLoader_SecureChunkCopy(XLoader_SecureParams *SecurePtr, u64 SrcAddr,
 	/* Wait for copy to get completed */
 	Status = SecurePtr->PdiPtr->MetaHdr.DeviceCopy(SrcAddr,
 		SecurePtr->ChunkAddr, TotalSize, (u32)(Flags | SecurePtr->DmaFlags));
+#ifdef PLM_PRINT_PERF_CDO_PROCESS
+	SecurePtr->FetchTime += (FetchTimeStart - XPlmi_GetTimerValue());
+#endif
 	if (Status != XST_SUCCESS) {
 		Status = XPlmi_UpdateStatus(
 				XLOADER_ERR_DATA_COPY_FAIL, Status);
@@ -694,6 +702,42 @@ END:
 	return Status;
 }
 
+/*****************************************************************************/
+/**
+* @brief	This function starts the copy of the second chunk of a partition,
+* which XLoader_SecureChunkCopy defers while the first chunk is processed.
+* Authentication certificate and Puf data are used only while processing the
+* first chunk, so the second 32K chunk of PMC RAM is free once it is
+* processed and the copy can overlap the rest of the first chunk's handling.
+*
+* @param	SecurePtr is pointer to the XLoader_SecureParams instance
+* @param	BlockSize is size of the data block to be processed
+*		which doesn't include padding lengths and hash.
+*
+* @return	XST_SUCCESS on success and error code on failure
+*
+******************************************************************************/
+int XLoader_SecureStartDeferredCopy(XLoader_SecureParams *SecurePtr,
+			u32 BlockSize)
+{
+	int Status = XST_FAILURE;
+
+	if ((SecurePtr->BlockNum != 1U) ||
+		(SecurePtr->IsNextChunkCopyStarted == (u8)TRUE) ||
+		(SecurePtr->RemainingDataLen <= SecurePtr->ProcessedLen) ||
+		((SecurePtr->DmaFlags & XPLMI_PMCDMA_0) == XPLMI_PMCDMA_0)) {
+		Status = XST_SUCCESS;
+		goto END;
+	}
+
+	Status = XLoader_StartNextChunkCopy(SecurePtr,
+			(SecurePtr->RemainingDataLen - SecurePtr->ProcessedLen),
+			SecurePtr->NextBlkAddr, BlockSize);
+
+END:
+	return Status;
+}
+
 /*****************************************************************************/
 /**
 * @brief	This function checks if PPK is programmed.
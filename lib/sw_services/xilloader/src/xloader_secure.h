@@ -57,6 +57,7 @@
 *       bsv  02/09/22 Code clean up
 *       bsv  02/11/22 Code optimization to reduce text size
 *       kpt  02/18/22 Removed Flags param from XLoader_SecureInit function prototype
+* 1.08  jb   10/18/26 Added XLoader_SecureStartDeferredCopy
 *
 * </pre>
 *
@@ -127,6 +128,8 @@ int XLoader_SecureCopy(XLoader_SecureParams *SecurePtr, u64 DestAddr, u32 Size);
 int XLoader_SecureClear(void);
 int XLoader_SecureChunkCopy(XLoader_SecureParams *SecurePtr, u64 SrcAddr,
 			u8 Last, u32 BlockSize, u32 TotalSize);
+int XLoader_SecureStartDeferredCopy(XLoader_SecureParams *SecurePtr,
+			u32 BlockSize);
 u32 XLoader_GetAHWRoT(const u32* AHWRoTPtr);
 u32 XLoader_GetSHWRoT(const u32* SHWRoTPtr);
 int XLoader_SetSecureState(void);
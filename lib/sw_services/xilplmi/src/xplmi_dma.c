@@ -42,6 +42,7 @@
 *       ma   01/17/2022 Enable SLVERR for PMC DMA
 *       bm   01/20/2022 Fix compilation warnings in Xil_SMemCpy
 *       skd  03/03/2022 Minor bug fix in XPlmi_MemCpy64
+* 1.07  jb   10/18/2026 Added DMA descriptor list APIs
 *
 * </pre>
 *
@@ -61,6 +62,11 @@
 
 /************************** Constant Definitions *****************************/
 #define XPLMI_XCSUDMA_DEST_CTRL_OFFSET		(0x80CU)
+#define XPLMI_DMA_DESC_MAX_LEN			(0x7FFFFFFU)
+#define XPLMI_DMA_DESC_SBI_MASK		(XPLMI_DMA_DESC_SBI_SRC | \
+						XPLMI_DMA_DESC_SBI_DST)
+#define XPLMI_DMA_DESC_CH_MASK		(XPLMI_PMCDMA_0 | XPLMI_PMCDMA_1)
+#define XPLMI_DMA_STATS_FRAC			(1000U)
 
 /**************************** Type Definitions *******************************/
 
@@ -76,6 +82,9 @@ static int XPlmi_DmaChXfer(u64 Addr, u32 Len, XPmcDma_Channel Channel, u32 Flags
 static int XPlmi_StartDma(u64 SrcAddr, u64 DestAddr, u32 Len, u32 Flags,
                 XPmcDma** DmaPtrAddr);
 static int XPlmi_SsitWaitForDmaDone(XPmcDma *DmaPtr, XPmcDma_Channel Channel);
+static u32 XPlmi_DmaDescSssCfg(u32 SssCfg, u32 Ch, u32 Flags);
+static void XPlmi_DmaDescStart(XPmcDma *DmaPtr, const XPlmi_DmaDesc *Desc);
+static int XPlmi_DmaDescWait(XPmcDma *DmaPtr, const XPlmi_DmaDesc *Desc);
 
 /************************** Variable Definitions *****************************/
 static XPmcDma PmcDma0;		/**<Instance of the Pmc_Dma Device */
@@ -1011,3 +1020,362 @@ int XPlmi_MemCpy64(u64 DestAddr, u64 SrcAddr, u32 Len)
 END:
 	return Status;
 }
+
+/*****************************************************************************/
+/**
+ * @brief	This function initializes a DMA descriptor list on the
+ * descriptors provided by the caller.
+ *
+ * @param	DescList is pointer to the descriptor list
+ * @param	Desc is the array of descriptors used by the list
+ * @param	MaxDesc is the number of descriptors in Desc
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void XPlmi_DmaDescListInit(XPlmi_DmaDescList *DescList, XPlmi_DmaDesc *Desc,
+	u32 MaxDesc)
+{
+	DescList->Desc = Desc;
+	DescList->MaxDesc = MaxDesc;
+	DescList->NumDesc = 0U;
+	DescList->NumXfers = 0U;
+	DescList->NumBytes = 0U;
+	DescList->NumCycles = 0U;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function queues a transfer to the DMA descriptor list. A
+ * transfer which continues the last queued transfer with the same flags is
+ * merged into its descriptor.
+ *
+ * @param	DescList is pointer to the descriptor list
+ * @param	SrcAddr for SRC channel to fetch data from
+ * @param	DestAddr for DST channel to store the data
+ * @param	Len of the data in words
+ * @param	Flags to select the DMA Burst type, XPLMI_DMA_DESC_SBI_SRC or
+ *		XPLMI_DMA_DESC_SBI_DST for SBI transfers and XPLMI_DMA_DESC_FENCE
+ *		to wait for all earlier transfers before starting. XPLMI_PMCDMA_0
+ *		or XPLMI_PMCDMA_1 pins the transfer to a PMC DMA, else it runs
+ *		on the next free one.
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+int XPlmi_DmaDescListAdd(XPlmi_DmaDescList *DescList, u64 SrcAddr,
+	u64 DestAddr, u32 Len, u32 Flags)
+{
+	int Status = XST_FAILURE;
+	XPlmi_DmaDesc *Desc;
+	u64 XfrLen = (u64)Len * XPLMI_WORD_LEN;
+
+	if (Len == 0U) {
+		Status = XST_SUCCESS;
+		goto END;
+	}
+
+	if (DescList->NumDesc > 0U) {
+		Desc = &DescList->Desc[DescList->NumDesc - 1U];
+		if ((Desc->Flags == Flags) &&
+			((Flags & (XPLMI_SRC_CH_AXI_FIXED |
+			XPLMI_DST_CH_AXI_FIXED)) == 0U) &&
+			((Flags & XPLMI_DMA_DESC_FENCE) == 0U) &&
+			(Len <= (XPLMI_DMA_DESC_MAX_LEN - Desc->Len)) &&
+			(((Flags & XPLMI_DMA_DESC_SBI_SRC) != 0U) ||
+			(SrcAddr == (Desc->SrcAddr +
+				((u64)Desc->Len * XPLMI_WORD_LEN)))) &&
+			(((Flags & XPLMI_DMA_DESC_SBI_DST) != 0U) ||
+			(DestAddr == (Desc->DestAddr +
+				((u64)Desc->Len * XPLMI_WORD_LEN))))) {
+			Desc->Len += Len;
+			Status = XST_SUCCESS;
+			goto END;
+		}
+	}
+
+	if ((DescList->NumDesc >= DescList->MaxDesc) ||
+		(Len > XPLMI_DMA_DESC_MAX_LEN)) {
+		Status = XPlmi_UpdateStatus(XPLMI_ERR_DMA_DESC_LIST_FULL, 0);
+		goto END;
+	}
+
+	Desc = &DescList->Desc[DescList->NumDesc];
+	Desc->SrcAddr = SrcAddr;
+	Desc->DestAddr = DestAddr;
+	Desc->Len = Len;
+	Desc->Flags = Flags;
+	++DescList->NumDesc;
+	Status = XST_SUCCESS;
+
+END:
+	XPlmi_Printf(DEBUG_DETAILED, "DMA Desc Src 0x%0x%08x, Dest 0x%0x%08x, "
+		"Len 0x%0x Bytes, Flags 0x%0x\n\r", (u32)(SrcAddr >> 32U),
+		(u32)SrcAddr, (u32)(DestAddr >> 32U), (u32)DestAddr,
+		(u32)XfrLen, Flags);
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function returns the SSS configuration for a descriptor
+ * on a PMC DMA.
+ *
+ * @param	SssCfg is the current SSS configuration
+ * @param	Ch is 0 for PMCDMA_0 and 1 for PMCDMA_1
+ * @param	Flags of the descriptor
+ *
+ * @return	SSS configuration
+ *
+ *****************************************************************************/
+static u32 XPlmi_DmaDescSssCfg(u32 SssCfg, u32 Ch, u32 Flags)
+{
+	u32 Cfg = SssCfg;
+
+	if ((Flags & XPLMI_DMA_DESC_SBI_MASK) != 0U) {
+		/* SBI to DMA and DMA to SBI use the same configuration */
+		if (Ch == 0U) {
+			Cfg = (Cfg & ~(XPLMI_SSSCFG_DMA0_MASK |
+				XPLMI_SSSCFG_SBI_MASK)) |
+				XPLMI_SSS_DMA0_SBI | XPLMI_SSS_SBI_DMA0;
+		} else {
+			Cfg = (Cfg & ~(XPLMI_SSSCFG_DMA1_MASK |
+				XPLMI_SSSCFG_SBI_MASK)) |
+				XPLMI_SSS_DMA1_SBI | XPLMI_SSS_SBI_DMA1;
+		}
+	} else if (Ch == 0U) {
+		Cfg = (Cfg & ~XPLMI_SSSCFG_DMA0_MASK) | XPLMI_SSS_DMA0_DMA0;
+	} else {
+		Cfg = (Cfg & ~XPLMI_SSSCFG_DMA1_MASK) | XPLMI_SSS_DMA1_DMA1;
+	}
+
+	return Cfg;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function starts the transfer of a descriptor without
+ * waiting for it.
+ *
+ * @param	DmaPtr is pointer to the PMC DMA instance
+ * @param	Desc is pointer to the descriptor
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+static void XPlmi_DmaDescStart(XPmcDma *DmaPtr, const XPlmi_DmaDesc *Desc)
+{
+	/* Setting PMC_DMA in AXI Burst mode */
+	if ((Desc->Flags & XPLMI_SRC_CH_AXI_FIXED) == XPLMI_SRC_CH_AXI_FIXED) {
+		DmaCtrl.AxiBurstType = 1U;
+		XPmcDma_SetConfig(DmaPtr, XPMCDMA_SRC_CHANNEL, &DmaCtrl);
+	}
+	if ((Desc->Flags & XPLMI_DST_CH_AXI_FIXED) == XPLMI_DST_CH_AXI_FIXED) {
+		DmaCtrl.AxiBurstType = 1U;
+		XPmcDma_SetConfig(DmaPtr, XPMCDMA_DST_CHANNEL, &DmaCtrl);
+	}
+
+	if ((Desc->Flags & XPLMI_DMA_DESC_SBI_DST) == 0U) {
+		XPmcDma_64BitTransfer(DmaPtr, XPMCDMA_DST_CHANNEL,
+			(u32)(Desc->DestAddr), (u32)(Desc->DestAddr >> 32U),
+			Desc->Len, 0U);
+	}
+	if ((Desc->Flags & XPLMI_DMA_DESC_SBI_SRC) == 0U) {
+		XPmcDma_64BitTransfer(DmaPtr, XPMCDMA_SRC_CHANNEL,
+			(u32)(Desc->SrcAddr), (u32)(Desc->SrcAddr >> 32U),
+			Desc->Len, 0U);
+	}
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function waits for the transfer of a descriptor and
+ * reverts its PMC DMA settings.
+ *
+ * @param	DmaPtr is pointer to the PMC DMA instance
+ * @param	Desc is pointer to the descriptor
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+static int XPlmi_DmaDescWait(XPmcDma *DmaPtr, const XPlmi_DmaDesc *Desc)
+{
+	int Status = XST_FAILURE;
+	int (*XPlmi_WaitForDmaDone)(XPmcDma *DmaPtr, XPmcDma_Channel Channel);
+	u64 Addr = Desc->DestAddr;
+
+	if ((Desc->Flags & XPLMI_DMA_DESC_SBI_DST) != 0U) {
+		Addr = Desc->SrcAddr;
+	}
+	if ((Addr >= XPLMI_PMC_ALIAS1_BASEADDR) &&
+		(Addr < XPLMI_PMC_ALIAS_MAX_ADDR)) {
+		XPlmi_WaitForDmaDone = XPlmi_SsitWaitForDmaDone;
+	} else {
+		XPlmi_WaitForDmaDone = XPmcDma_WaitForDone;
+	}
+
+	if ((Desc->Flags & XPLMI_DMA_DESC_SBI_SRC) == 0U) {
+		Status = XPlmi_WaitForDmaDone(DmaPtr, XPMCDMA_SRC_CHANNEL);
+		if (Status != XST_SUCCESS) {
+			Status = XPlmi_UpdateStatus(XPLMI_ERR_DMA_XFER_WAIT_SRC,
+				Status);
+			goto END;
+		}
+		XPmcDma_IntrClear(DmaPtr, XPMCDMA_SRC_CHANNEL,
+			XPMCDMA_IXR_DONE_MASK);
+	}
+	if ((Desc->Flags & XPLMI_DMA_DESC_SBI_DST) == 0U) {
+		Status = XPlmi_WaitForDmaDone(DmaPtr, XPMCDMA_DST_CHANNEL);
+		if (Status != XST_SUCCESS) {
+			Status = XPlmi_UpdateStatus(XPLMI_ERR_DMA_XFER_WAIT_DEST,
+				Status);
+			goto END;
+		}
+		XPmcDma_IntrClear(DmaPtr, XPMCDMA_DST_CHANNEL,
+			XPMCDMA_IXR_DONE_MASK);
+	}
+
+	/* Reverting the AXI Burst setting of PMC_DMA */
+	if ((Desc->Flags & XPLMI_SRC_CH_AXI_FIXED) == XPLMI_SRC_CH_AXI_FIXED) {
+		DmaCtrl.AxiBurstType = 0U;
+		XPmcDma_SetConfig(DmaPtr, XPMCDMA_SRC_CHANNEL, &DmaCtrl);
+	}
+	if ((Desc->Flags & XPLMI_DST_CH_AXI_FIXED) == XPLMI_DST_CH_AXI_FIXED) {
+		DmaCtrl.AxiBurstType = 0U;
+		XPmcDma_SetConfig(DmaPtr, XPMCDMA_DST_CHANNEL, &DmaCtrl);
+	}
+
+END:
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function transfers all queued descriptors of the list and
+ * empties it. The transfers are pipelined over PMCDMA_0 and PMCDMA_1, and the
+ * SSS of one PMC DMA is configured while the other one is transferring.
+ * Transfers on different PMC DMAs may complete out of order, unless they
+ * are SBI transfers or use XPLMI_DMA_DESC_FENCE.
+ *
+ * @param	DescList is pointer to the descriptor list
+ *
+ * @return	XST_SUCCESS on success and error code on failure
+ *
+ *****************************************************************************/
+int XPlmi_DmaDescListXfer(XPlmi_DmaDescList *DescList)
+{
+	int Status = XST_FAILURE;
+	XPmcDma *DmaPtrs[XPLMI_DMA_NUM_CHANNELS] = {&PmcDma0, &PmcDma1};
+	const XPlmi_DmaDesc *InFlight[XPLMI_DMA_NUM_CHANNELS] = {NULL, NULL};
+	const XPlmi_DmaDesc *Desc;
+	u32 SssCfg = XPlmi_In32(PMC_GLOBAL_PMC_SSS_CFG);
+	u32 NewSssCfg;
+	u32 Index;
+	u32 Ch;
+	u32 NextCh = 0U;
+	u32 NumXfers = 0U;
+	u64 NumBytes = 0U;
+	u64 XfrTime = XPlmi_GetTimerValue();
+
+	for (Index = 0U; Index < DescList->NumDesc; ++Index) {
+		Desc = &DescList->Desc[Index];
+
+		/* Pinned PMC DMA, else the free one or the least recently used */
+		if ((Desc->Flags & XPLMI_DMA_DESC_CH_MASK) == XPLMI_PMCDMA_0) {
+			Ch = 0U;
+		} else if ((Desc->Flags & XPLMI_DMA_DESC_CH_MASK) ==
+			XPLMI_PMCDMA_1) {
+			Ch = 1U;
+		} else if ((InFlight[NextCh] != NULL) &&
+			(InFlight[NextCh ^ 1U] == NULL)) {
+			Ch = NextCh ^ 1U;
+		} else {
+			Ch = NextCh;
+		}
+
+		/*
+		 * The other PMC DMA keeps transferring unless this descriptor
+		 * needs the earlier transfers done, or both use the SBI
+		 */
+		if ((InFlight[Ch ^ 1U] != NULL) &&
+			(((Desc->Flags & XPLMI_DMA_DESC_FENCE) != 0U) ||
+			(((Desc->Flags & XPLMI_DMA_DESC_SBI_MASK) != 0U) &&
+			((InFlight[Ch ^ 1U]->Flags &
+			XPLMI_DMA_DESC_SBI_MASK) != 0U)))) {
+			Status = XPlmi_DmaDescWait(DmaPtrs[Ch ^ 1U],
+				InFlight[Ch ^ 1U]);
+			if (Status != XST_SUCCESS) {
+				goto END;
+			}
+			InFlight[Ch ^ 1U] = NULL;
+		}
+
+		NewSssCfg = XPlmi_DmaDescSssCfg(SssCfg, Ch, Desc->Flags);
+
+		if (InFlight[Ch] != NULL) {
+			Status = XPlmi_DmaDescWait(DmaPtrs[Ch], InFlight[Ch]);
+			if (Status != XST_SUCCESS) {
+				goto END;
+			}
+			InFlight[Ch] = NULL;
+		}
+
+		/* Configure the secure stream switch while the other DMA runs */
+		if (NewSssCfg != SssCfg) {
+			XPlmi_Out32(PMC_GLOBAL_PMC_SSS_CFG, NewSssCfg);
+			SssCfg = NewSssCfg;
+		}
+
+		XPlmi_DmaDescStart(DmaPtrs[Ch], Desc);
+		InFlight[Ch] = Desc;
+		NumBytes += (u64)Desc->Len * XPLMI_WORD_LEN;
+		++NumXfers;
+		NextCh = Ch ^ 1U;
+	}
+
+	for (Ch = 0U; Ch < XPLMI_DMA_NUM_CHANNELS; ++Ch) {
+		if (InFlight[Ch] != NULL) {
+			Status = XPlmi_DmaDescWait(DmaPtrs[Ch], InFlight[Ch]);
+			if (Status != XST_SUCCESS) {
+				goto END;
+			}
+		}
+	}
+	Status = XST_SUCCESS;
+
+END:
+	DescList->NumCycles += XfrTime - XPlmi_GetTimerValue();
+	DescList->NumBytes += NumBytes;
+	DescList->NumXfers += NumXfers;
+	DescList->NumDesc = 0U;
+#ifdef PLM_PRINT_PERF_DMA
+	XPlmi_DmaDescListPrintStats(DescList);
+#endif
+	return Status;
+}
+
+/*****************************************************************************/
+/**
+ * @brief	This function prints the aggregate transfer statistics of a DMA
+ * descriptor list.
+ *
+ * @param	DescList is pointer to the descriptor list
+ *
+ * @return	None
+ *
+ *****************************************************************************/
+void XPlmi_DmaDescListPrintStats(const XPlmi_DmaDescList *DescList)
+{
+	u64 BytesPerCycle = 0U;
+
+	if (DescList->NumCycles != 0U) {
+		BytesPerCycle = (DescList->NumBytes * XPLMI_DMA_STATS_FRAC) /
+			DescList->NumCycles;
+	}
+
+	XPlmi_Printf(DEBUG_PRINT_PERF, "DMA Desc List: %u Xfers, %u Bytes, "
+		"%u Cycles, %u.%03u Bytes/Cycle\n\r", DescList->NumXfers,
+		(u32)DescList->NumBytes, (u32)DescList->NumCycles,
+		(u32)(BytesPerCycle / XPLMI_DMA_STATS_FRAC),
+		(u32)(BytesPerCycle % XPLMI_DMA_STATS_FRAC));
+}
@@ -27,6 +27,7 @@
 * 1.04  bsv  07/16/2021 Fix doxygen warnings
 *       bsv  08/13/2021 Code clean up to reduce elf size
 * 1.05  bm   01/20/2022 Fix compilation warnings in Xil_SMemCpy
+* 1.06  jb   10/18/2026 Added DMA descriptor list APIs
 *
 * </pre>
 *
@@ -60,6 +61,11 @@ extern "C" {
 #define XPLMI_PMCDMA_1			(0x200U)
 #define XPLMI_DMA_SRC_NPI		(0x4U)
 
+/** DMA descriptor list flags */
+#define XPLMI_DMA_DESC_SBI_SRC		((u32)0x1U << 24U)
+#define XPLMI_DMA_DESC_SBI_DST		((u32)0x1U << 25U)
+#define XPLMI_DMA_DESC_FENCE		((u32)0x1U << 26U)
+
 /* SSS configurations and masks */
 #define XPLMI_SSSCFG_DMA0_MASK		(0x0000000FU)
 #define XPLMI_SSSCFG_DMA1_MASK		(0x000000F0U)
@@ -81,6 +87,32 @@ extern "C" {
 #define XPLMI_SET_CHUNK_SIZE			(128U)
 #define XPLMI_WORD_LEN_MASK			(0x3U)
 #define XPLMI_WORD_LEN_SHIFT			(0x2U)
+#define XPLMI_DMA_NUM_CHANNELS			(2U)
+
+/**
+ * DMA descriptor, one queued transfer of a descriptor list. SrcAddr is
+ * unused for XPLMI_DMA_DESC_SBI_SRC and DestAddr is unused for
+ * XPLMI_DMA_DESC_SBI_DST transfers.
+ */
+typedef struct {
+	u64 SrcAddr;	/**< Address for SRC channel to fetch data from */
+	u64 DestAddr;	/**< Address for DST channel to store the data */
+	u32 Len;	/**< Length of the data in words */
+	u32 Flags;	/**< DMA XFER flags and DMA descriptor list flags */
+} XPlmi_DmaDesc;
+
+/**
+ * DMA descriptor list, transfers queued by XPlmi_DmaDescListAdd and
+ * pipelined over both PMC DMAs by XPlmi_DmaDescListXfer
+ */
+typedef struct {
+	XPlmi_DmaDesc *Desc;	/**< Descriptors provided by the caller */
+	u32 MaxDesc;		/**< Number of descriptors in Desc */
+	u32 NumDesc;		/**< Number of queued descriptors */
+	u32 NumXfers;		/**< Transfers completed by the list */
+	u64 NumBytes;		/**< Bytes transferred by the list */
+	u64 NumCycles;		/**< PMC timer cycles spent in the transfers */
+} XPlmi_DmaDescList;
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
@@ -99,6 +131,12 @@ void XPlmi_SetMaxOutCmds(u8 Val);
 int XPlmi_MemSet(u64 DestAddr, u32 Val, u32 Len);
 int XPlmi_MemSetBytes(void *const DestPtr, u32 DestLen, u8 Val, u32 Len);
 int XPlmi_MemCpy64(u64 DestAddr, u64 SrcAddr, u32 Len);
+void XPlmi_DmaDescListInit(XPlmi_DmaDescList *DescList, XPlmi_DmaDesc *Desc,
+	u32 MaxDesc);
+int XPlmi_DmaDescListAdd(XPlmi_DmaDescList *DescList, u64 SrcAddr,
+	u64 DestAddr, u32 Len, u32 Flags);
+int XPlmi_DmaDescListXfer(XPlmi_DmaDescList *DescList);
+void XPlmi_DmaDescListPrintStats(const XPlmi_DmaDescList *DescList);
 
 /**
  * @}
@@ -91,6 +91,7 @@
 *       kpt  09/09/2021 Added error code XLOADER_ERR_SECURE_CLEAR_FAIL
 * 1.07  ma   11/25/2021 Added error code XPLMI_ERR_PROC_INVALID_ADDRESS_RANGE
 *       bsv  03/17/2022 Add support for A72 elfs to run from TCM
+* 1.08  jb   10/18/2026 Added error code for DMA descriptor list overflow
 *
 * </pre>
 *
@@ -268,6 +269,8 @@ typedef enum {
 	XPLMI_ERR_FROM_SSIT_SLAVE, /**< 0x13B - Error received from SSIT Slave SLR */
 	XPLMI_ERR_PROC_INVALID_ADDRESS_RANGE, /**< 0x13C - Error when the given address
 	                    range for storing Proc commands is invalid */
+	XPLMI_ERR_DMA_DESC_LIST_FULL, /**< 0x13D - Error when a transfer is
+						queued to a full DMA descriptor list */
 
 	/** Status codes used in PLM */
 	XPLM_ERR_TASK_CREATE = 0x200,	/**< 0x200 - Error when task create
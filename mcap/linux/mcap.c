@@ -32,7 +32,7 @@
 
 #include "mcap_lib.h"
 
-static const char options[] = "x:pC:rmfdvHhDa::";
+static const char options[] = "x:p:C:rmfdvsHhDa::";
 static char help_msg[] =
 "Usage: mcap [options]\n"
 "\n"
@@ -44,6 +44,7 @@ static char help_msg[] =
 "\t-m\t\tPerforms Module Reset\n"
 "\t-f\t\tPerforms Full Reset\n"
 "\t-D\t\tRead Data Registers\n"
+"\t-s\t\tUse the legacy word-by-word bitstream write path\n"
 "\t-d\t\tDump all the MCAP Registers\n"
 "\t-v\t\tVerbose information of MCAP Device\n"
 "\t-h/H\t\tHelp\n"
@@ -60,7 +61,8 @@ int main(int argc, char **argv)
 	int i, modreset = 0, fullreset = 0, reset = 0;
 	int program = 0, verbose = 0, device_id = 0;
 	int data_regs = 0, dump_regs = 0, access_config = 0;
-	int programconfigfile = 0;
+	int programconfigfile = 0, slowpath = 0;
+	char *program_file = NULL, *clear_file = NULL;
 
 	while ((i = getopt(argc, argv, options)) != -1) {
 		switch (i) {
@@ -88,15 +90,20 @@ int main(int argc, char **argv)
 			return 1;
 		case 'C':
 			programconfigfile = 1;
+			clear_file = optarg;
 			break;
 		case 'p':
 			program = 1;
+			program_file = optarg;
+			break;
+		case 's':
+			slowpath = 1;
 			break;
 		case 'v':
 			verbose++;
 			break;
 		case 'x':
-			device_id = (int) strtol(argv[2], NULL, 16);
+			device_id = (int) strtol(optarg, NULL, 16);
 			break;
 		default:
 			printf("%s", help_msg);
@@ -114,6 +121,8 @@ int main(int argc, char **argv)
 	if (!mdev)
 		return 1;
 
+	mdev->is_slowpath = slowpath;
+
 	if (verbose) {
 		MCapShowDevice(mdev, verbose);
 		goto free;
@@ -145,20 +154,17 @@ int main(int argc, char **argv)
 	}
 
 	if (programconfigfile) {
-		if (argc > 6)
+		if (program)
 			mdev->is_multiplebit = 1;
 
-		MCapConfigureFPGA(mdev, argv[4], EMCAP_PARTIALCONFIG_FILE);
+		MCapConfigureFPGA(mdev, clear_file, EMCAP_PARTIALCONFIG_FILE);
 
 		if(!mdev->is_multiplebit)
 			goto free;
 	}
 
 	if (program) {
-		if (argc > 6)
-			MCapConfigureFPGA(mdev, argv[6], EMCAP_CONFIG_FILE);
-		else
-			MCapConfigureFPGA(mdev, argv[4], EMCAP_CONFIG_FILE);
+		MCapConfigureFPGA(mdev, program_file, EMCAP_CONFIG_FILE);
 		goto free;
 	}
 
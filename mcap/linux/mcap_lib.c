@@ -47,6 +47,8 @@
 #define MCAP_BIT_FILE	".bit"
 #define MCAP_BIN_FILE	".bin"
 
+#define MCAP_SYSFS_CONFIG	"/sys/bus/pci/devices/%04x:%02x:%02x.%d/config"
+
 static char *MCapFindTypeofFile(const char *s1, const char *s2)
 {
 	size_t l1, l2;
@@ -167,6 +169,126 @@ static int MCapDoBusWalk(struct mcap_dev *mdev)
 	return 0;
 }
 
+static int MCapOpenConfigFile(struct mcap_dev *mdev)
+{
+	char path[64];
+
+	snprintf(path, sizeof(path), MCAP_SYSFS_CONFIG, mdev->pdev->domain,
+		 mdev->pdev->bus, mdev->pdev->dev, mdev->pdev->func);
+
+	mdev->cfg_fd = open(path, O_WRONLY);
+	if (mdev->cfg_fd < 0) {
+		pr_dbg("Unable to open %s, using slow write path\n", path);
+		return -EMCAPCFGACC;
+	}
+
+	return 0;
+}
+
+static double MCapGetTime(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void MCapSwapBatch(u32 *buf, int len, u8 bswap)
+{
+	int i;
+
+	/*
+	 * Kept as a flat loop with no calls so that the compiler can
+	 * vectorize the swap for the whole batch.
+	 */
+	if (bswap) {
+		for (i = 0; i < len; i++)
+			buf[i] = htole32(__bswap_32(buf[i]));
+	} else {
+		for (i = 0; i < len; i++)
+			buf[i] = htole32(buf[i]);
+	}
+}
+
+static int MCapWriteDataSlow(struct mcap_dev *mdev, u32 *data,
+			     int len, u8 bswap)
+{
+	int count;
+
+	if (!bswap) {
+		for (count = 0; count < len; count++)
+			MCapRegWrite(mdev, MCAP_DATA, data[count]);
+	} else {
+		for (count = 0; count < len; count++)
+			MCapRegWrite(mdev, MCAP_DATA, __bswap_32(data[count]));
+	}
+
+	return 0;
+}
+
+static int MCapWriteDataBurst(struct mcap_dev *mdev, const u8 *data,
+			      int len, u8 bswap)
+{
+	u32 *batch;
+	off_t offset = mdev->reg_base + MCAP_DATA;
+	int count, num, i;
+	int err = 0;
+
+	batch = malloc(MCAP_BURST_WORDS * sizeof(u32));
+	if (!batch)
+		return -EMCAPWRITE;
+
+	/*
+	 * The data register is a single dword in config space, so every
+	 * word still needs its own 4-byte access. Bypass libpci and write
+	 * pre-swapped batches straight to the sysfs config file instead.
+	 */
+	for (count = 0; count < len; count += num) {
+		num = len - count;
+		if (num > MCAP_BURST_WORDS)
+			num = MCAP_BURST_WORDS;
+
+		memcpy(batch, data + count * sizeof(u32), num * sizeof(u32));
+		MCapSwapBatch(batch, num, bswap);
+
+		for (i = 0; i < num; i++) {
+			if (pwrite(mdev->cfg_fd, &batch[i], sizeof(u32),
+				   offset) != sizeof(u32)) {
+				pr_err("Failed to write config space\n");
+				err = -EMCAPWRITE;
+				goto free_batch;
+			}
+		}
+	}
+
+free_batch:
+	free(batch);
+
+	return err;
+}
+
+static int MCapWriteData(struct mcap_dev *mdev, void *data,
+			 int len, u8 bswap)
+{
+	double start, elapsed;
+	int err;
+
+	start = MCapGetTime();
+
+	if (mdev->is_slowpath || mdev->cfg_fd < 0)
+		err = MCapWriteDataSlow(mdev, data, len, bswap);
+	else
+		err = MCapWriteDataBurst(mdev, data, len, bswap);
+
+	elapsed = MCapGetTime() - start;
+	if (!err && elapsed > 0)
+		pr_info("Info: %d bytes written in %.3f s (%.2f MB/s)\n",
+			len * 4, elapsed, len * 4 / elapsed / (1024 * 1024));
+
+	return err;
+}
+
 static int MCapClearRequestByConfigure(struct mcap_dev *mdev, u32 *restore)
 {
 	u32 set;
@@ -220,11 +342,11 @@ static int Checkforcompletion(struct mcap_dev *mdev)
 	return 0;
 }
 
-static int MCapWritePartialBitStream(struct mcap_dev *mdev, u32 *data,
+static int MCapWritePartialBitStream(struct mcap_dev *mdev, void *data,
 					int len, u8 bswap)
 {
 	u32 set, restore;
-	int err, count = 0, i;
+	int err, i;
 
 	if (!data || !len) {
 		pr_err("Invalid Arguments\n");
@@ -254,12 +376,10 @@ static int MCapWritePartialBitStream(struct mcap_dev *mdev, u32 *data,
 	MCapRegWrite(mdev, MCAP_CONTROL, set);
 
 	/* Write Data */
-	if (!bswap) {
-		for (count = 0; count < len; count++)
-			MCapRegWrite(mdev, MCAP_DATA, data[count]);
-	} else {
-		for (count = 0; count < len; count++)
-			MCapRegWrite(mdev, MCAP_DATA, __bswap_32(data[count]));
+	err = MCapWriteData(mdev, data, len, bswap);
+	if (err) {
+		MCapRegWrite(mdev, MCAP_CONTROL, restore);
+		return err;
 	}
 
 	for (i = 0 ; i < EMCAP_EOS_LOOP_COUNT; i++) {
@@ -283,11 +403,11 @@ static int MCapWritePartialBitStream(struct mcap_dev *mdev, u32 *data,
 	return 0;
 }
 
-static int MCapWriteBitStream(struct mcap_dev *mdev, u32 *data,
+static int MCapWriteBitStream(struct mcap_dev *mdev, void *data,
 			      int len, u8 bswap)
 {
 	u32 set, restore;
-	int err, count = 0;
+	int err;
 
 	if (!data || !len) {
 		pr_err("Invalid Arguments\n");
@@ -319,12 +439,10 @@ static int MCapWriteBitStream(struct mcap_dev *mdev, u32 *data,
 	}
 
 	/* Write Data */
-	if (!bswap) {
-		for (count = 0; count < len; count++)
-			MCapRegWrite(mdev, MCAP_DATA, data[count]);
-	} else {
-		for (count = 0; count < len; count++)
-			MCapRegWrite(mdev, MCAP_DATA, __bswap_32(data[count]));
+	err = MCapWriteData(mdev, data, len, bswap);
+	if (err) {
+		MCapRegWrite(mdev, MCAP_CONTROL, restore);
+		return err;
 	}
 
 	/* Check for Completion */
@@ -350,6 +468,8 @@ static int MCapWriteBitStream(struct mcap_dev *mdev, u32 *data,
 void MCapLibFree(struct mcap_dev *mdev)
 {
 	if (mdev) {
+		if (mdev->cfg_fd >= 0)
+			close(mdev->cfg_fd);
 		pci_cleanup(mdev->pacc);
 		free(mdev);
 	}
@@ -368,7 +488,10 @@ struct mcap_dev *MCapLibInit(int device_id)
 	/* Get the pci_access structure */
 	mdev->pacc = pci_alloc();
 
+	mdev->pdev = NULL;
 	mdev->is_multiplebit = 0;
+	mdev->is_slowpath = 0;
+	mdev->cfg_fd = -1;
 
 	/* Initialize the PCI library */
 	pci_init(mdev->pacc);
@@ -401,6 +524,9 @@ struct mcap_dev *MCapLibInit(int device_id)
 		goto free_resources;
 	}
 
+	/* Config space file for the burst write path */
+	MCapOpenConfigFile(mdev);
+
 	return mdev;
 
 free_resources:
@@ -589,6 +715,82 @@ void MCapDumpRegs(struct mcap_dev *mdev)
 	MCapDumpReadRegs(mdev);
 }
 
+static int MCapProgramFPGA(struct mcap_dev *mdev, void *data, u32 len,
+			   u8 bswap, u32 bitfile_type)
+{
+	int err = 0;
+
+	if (bitfile_type == EMCAP_PARTIALCONFIG_FILE) {
+		err = MCapWritePartialBitStream(mdev, data, len, bswap);
+		if (err)
+			return -EMCAPCFG;
+		pr_info("FPGA Partial Configuration Done!!\n");
+	} else if (bitfile_type == EMCAP_CONFIG_FILE) {
+		err = MCapWriteBitStream(mdev, data, len, bswap);
+		if (err)
+			return -EMCAPCFG;
+		pr_info("FPGA Configuration Done!!\n");
+	}
+
+	return err;
+}
+
+static int MCapConfigureFPGAMapped(struct mcap_dev *mdev, char *file_path,
+				   u32 bitfile_type)
+{
+	struct stat st;
+	u8 *map, *data;
+	u32 binsz, pos = 0;
+	int fd, err;
+
+	fd = open(file_path, O_RDONLY);
+	if (fd < 0)
+		return -EMCAPCFG;
+
+	if (fstat(fd, &st) || !st.st_size) {
+		close(fd);
+		return -EMCAPCFG;
+	}
+	binsz = st.st_size;
+
+	map = mmap(NULL, binsz, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return -EMCAPCFG;
+
+	madvise(map, binsz, MADV_SEQUENTIAL);
+
+	if (MCapFindTypeofFile(file_path, MCAP_BIT_FILE)) {
+		/*
+		 * .bit files are not guaranteed to be aligned with
+		 * the bitstream sync word on a 32-bit boundary, the
+		 * burst writer copies out of the mapping so the data
+		 * can start at any byte offset.
+		 */
+		while (pos + 4 <= binsz) {
+			if (map[pos] == MCAP_SYNC_BYTE0 &&
+			    map[pos + 1] == MCAP_SYNC_BYTE1 &&
+			    map[pos + 2] == MCAP_SYNC_BYTE2 &&
+			    map[pos + 3] == MCAP_SYNC_BYTE3)
+				break;
+			pos++;
+		}
+
+		if (pos + 4 > binsz) {
+			pr_err("Failed to find SYNC Word in BIT file\n");
+			munmap(map, binsz);
+			return -EMCAPCFG;
+		}
+	}
+
+	data = map + pos;
+	err = MCapProgramFPGA(mdev, data, (binsz - pos) / 4, 1, bitfile_type);
+
+	munmap(map, binsz);
+
+	return err;
+}
+
 int MCapConfigureFPGA(struct mcap_dev *mdev, char *file_path, u32 bitfile_type)
 {
 	FILE *fptr;
@@ -597,6 +799,12 @@ int MCapConfigureFPGA(struct mcap_dev *mdev, char *file_path, u32 bitfile_type)
 	int err = 0;
 	u8 bswap = 0;
 
+	/* Stream .bit/.bin files straight from a mapping on the fast path */
+	if (!mdev->is_slowpath && mdev->cfg_fd >= 0 &&
+	    (MCapFindTypeofFile(file_path, MCAP_BIT_FILE) ||
+	     MCapFindTypeofFile(file_path, MCAP_BIN_FILE)))
+		return MCapConfigureFPGAMapped(mdev, file_path, bitfile_type);
+
 	/* Get the size */
 	fptr = fopen(file_path, "rb");
 	if (fptr == NULL)
@@ -637,17 +845,7 @@ int MCapConfigureFPGA(struct mcap_dev *mdev, char *file_path, u32 bitfile_type)
 	}
 
 	/* Program FPGA */
-	if (bitfile_type == EMCAP_PARTIALCONFIG_FILE) {
-		err = MCapWritePartialBitStream(mdev, data, wrdatasz, bswap);
-		if (err)
-			return -EMCAPCFG;
-		pr_info("FPGA Partial Configuration Done!!\n");
-	} else if (bitfile_type == EMCAP_CONFIG_FILE) {
-		err = MCapWriteBitStream(mdev, data, wrdatasz, bswap);
-		if (err)
-			return -EMCAPCFG;
-		pr_info("FPGA Configuration Done!!\n");
-	}
+	err = MCapProgramFPGA(mdev, data, wrdatasz, bswap, bitfile_type);
 
 free_resources:
 	if (data)
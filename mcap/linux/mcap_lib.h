@@ -35,6 +35,12 @@
 #include <string.h>
 #include <ctype.h>
 #include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <endian.h>
+#include <time.h>
 
 #include "pci.h"
 #include "lspci.h"
@@ -72,6 +78,9 @@
 /* Maximum FIFO Depth */
 #define MCAP_FIFO_DEPTH		16
 
+/* Number of bitstream words staged and swapped per burst */
+#define MCAP_BURST_WORDS	4096
+
 /* PCIe Extended Capability Id */
 #define MCAP_EXT_CAP_ID		0xB
 
@@ -110,6 +119,8 @@ struct mcap_dev {
 	struct pci_access *pacc;
 	unsigned int reg_base;
 	u32 is_multiplebit;
+	u32 is_slowpath;
+	int cfg_fd;
 };
 
 #define MCapRegWrite(mdev, offset, value) \